@@ -24,6 +24,9 @@
 #include "FreeRTOS.h"
 #include "task.h"
 
+#include "boot_port.h"
+#include "comx_fmc_port.h"
+
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -126,6 +129,8 @@ int main(void)
   MX_QUADSPI1_Init();
   MX_TIM3_Init();
   /* USER CODE BEGIN 2 */
+  /* Поэтапный старт: проверка safe outputs + первого kick сейчас, COMX/NVM — параллельно в task (boot_port). */
+  (void)boot_port_start();
   (void)xTaskCreate(AppMainTask, "app", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, NULL);
 
   vTaskStartScheduler();
@@ -465,7 +470,8 @@ static void MX_TIM1_Init(void)
     Error_Handler();
   }
   /* USER CODE BEGIN TIM1_Init 2 */
-
+  /* Safe outputs (MOE OFF) до перевода выводов TIM1 в AF (HAL_TIM_MspPostInit). */
+  boot_port_early_safe_outputs();
   /* USER CODE END TIM1_Init 2 */
   HAL_TIM_MspPostInit(&htim1);
 
@@ -744,8 +750,13 @@ static void MX_GPIO_Init(void)
   GPIO_InitStruct.Pull = GPIO_NOPULL;
   HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
 
-  /* USER CODE BEGIN MX_GPIO_Init_2 */
+  /* EXTI interrupt init*/
+  HAL_NVIC_SetPriority(EXTI0_IRQn, 5, 0);
+  HAL_NVIC_EnableIRQ(EXTI0_IRQn);
 
+  /* USER CODE BEGIN MX_GPIO_Init_2 */
+  /* Первый kick внешнего watchdog — сразу после настройки EXTWDG_OUT. */
+  boot_port_early_watchdog();
   /* USER CODE END MX_GPIO_Init_2 */
 }
 
@@ -756,10 +767,16 @@ static void AppMainTask(void *argument)
 
   for (;;)
   {
-    vTaskDelay(pdMS_TO_TICKS(1000));
+    boot_port_alive(BOOT_PORT_ALIVE_APP);
+    vTaskDelay(pdMS_TO_TICKS(10));
   }
 }
 
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+  comx_fmc_port_exti_isr(GPIO_Pin);
+}
+
 /* USER CODE END 4 */
 
 /**
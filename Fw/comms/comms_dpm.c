@@ -0,0 +1,297 @@
+#include "comms_dpm.h"
+
+#include <stddef.h>
+
+#define COMMS_DPM_LINK_MASK (COMMS_DPM_NETX_READY | COMMS_DPM_NETX_COMM_RUN) /**< Условие OPERATIONAL, [битовая маска]. */
+
+/**
+ * @brief Прочитать слово флагов netX.
+ * @param dpm Указатель на контекст.
+ * @return Флаги comms_dpm_netx_flag_t, [битовая маска].
+ */
+static uint32_t comms_dpm_netx(const comms_dpm_t *dpm)
+{
+  return *dpm->io.netx_flags;
+}
+
+/**
+ * @brief Записать теневую копию host-флагов в DPM.
+ * @param dpm Указатель на контекст.
+ * @param flags Новые флаги comms_dpm_host_flag_t, [битовая маска].
+ * @return None.
+ */
+static void comms_dpm_set_host(comms_dpm_t *dpm, uint32_t flags)
+{
+  dpm->host_flags_shadow = flags;
+  *dpm->io.host_flags = flags;
+}
+
+/**
+ * @brief Перейти в новое состояние handshake.
+ * @param dpm Указатель на контекст.
+ * @param state Новое состояние.
+ * @param now_us Текущее время, [мкс].
+ * @return None.
+ */
+static void comms_dpm_enter(comms_dpm_t *dpm, comms_dpm_state_t state, uint32_t now_us)
+{
+  dpm->state = state;
+  dpm->state_enter_us = now_us;
+}
+
+/**
+ * @brief Признак нового входного образа от COMX.
+ * @param dpm Указатель на контекст.
+ * @param netx Флаги netX, [битовая маска].
+ * @return true, если PD_IN_TOGGLE != PD_IN_ACK.
+ */
+static bool comms_dpm_rx_ready(const comms_dpm_t *dpm, uint32_t netx)
+{
+  return ((netx & COMMS_DPM_NETX_PD_IN_TOGGLE) != 0u) != ((dpm->host_flags_shadow & COMMS_DPM_HOST_PD_IN_ACK) != 0u);
+}
+
+/**
+ * @brief Учесть латентность `IRQ → publish` (только если цикл был запущен IRQ).
+ * @param dpm Указатель на контекст.
+ * @param now_us Момент публикации, [мкс].
+ * @return None.
+ */
+static void comms_dpm_account_latency(comms_dpm_t *dpm, uint32_t now_us)
+{
+  if (!atomic_exchange_explicit(&dpm->irq_pending, false, memory_order_acquire))
+  {
+    return;
+  }
+
+  const uint32_t irq_us = (uint32_t)atomic_load_explicit(&dpm->irq_time_us, memory_order_relaxed);
+  const uint32_t latency_us = now_us - irq_us;
+  dpm->stats.last_latency_us = latency_us;
+  dpm->stats.max_latency_us = (latency_us > dpm->stats.max_latency_us) ? latency_us : dpm->stats.max_latency_us;
+  dpm->stats.cnt_budget_overrun += (uint32_t)(latency_us > dpm->cfg.latency_budget_us);
+}
+
+void comms_dpm_copy_in(uint32_t *dst, const volatile uint32_t *src, uint32_t words)
+{
+  uint32_t i = 0u;
+  for (; (i + 4u) <= words; i += 4u)
+  {
+    const uint32_t w0 = src[i + 0u];
+    const uint32_t w1 = src[i + 1u];
+    const uint32_t w2 = src[i + 2u];
+    const uint32_t w3 = src[i + 3u];
+    dst[i + 0u] = w0;
+    dst[i + 1u] = w1;
+    dst[i + 2u] = w2;
+    dst[i + 3u] = w3;
+  }
+  for (; i < words; ++i)
+  {
+    dst[i] = src[i];
+  }
+}
+
+void comms_dpm_copy_out(volatile uint32_t *dst, const uint32_t *src, uint32_t words)
+{
+  uint32_t i = 0u;
+  for (; (i + 4u) <= words; i += 4u)
+  {
+    dst[i + 0u] = src[i + 0u];
+    dst[i + 1u] = src[i + 1u];
+    dst[i + 2u] = src[i + 2u];
+    dst[i + 3u] = src[i + 3u];
+  }
+  for (; i < words; ++i)
+  {
+    dst[i] = src[i];
+  }
+}
+
+bool comms_dpm_init(comms_dpm_t *dpm, const comms_dpm_io_t *io, const comms_dpm_cfg_t *cfg)
+{
+  const comms_dpm_stats_t stats_zero = {0};
+
+  dpm->io = *io;
+  dpm->cfg = *cfg;
+  dpm->stats = stats_zero;
+  dpm->rx_time_us = 0u;
+  for (uint32_t i = 0u; i < COMMS_DPM_IMAGE_MAX_WORDS; ++i)
+  {
+    dpm->rx_img[0][i] = 0u;
+    dpm->rx_img[1][i] = 0u;
+  }
+  atomic_init(&dpm->irq_time_us, 0u);
+  atomic_init(&dpm->irq_pending, false);
+  atomic_init(&dpm->rx_front, 0u);
+  atomic_init(&dpm->rx_gen, 0u);
+
+  const bool valid = (io->rx_area != NULL) && (io->tx_area != NULL) && (io->netx_flags != NULL) &&
+                     (io->host_flags != NULL) && (io->now_us != NULL) &&
+                     (cfg->rx_words <= COMMS_DPM_IMAGE_MAX_WORDS) && (cfg->tx_words <= COMMS_DPM_IMAGE_MAX_WORDS);
+  if (!valid)
+  {
+    dpm->state = COMMS_DPM_STATE_ERROR;
+    dpm->host_flags_shadow = 0u;
+    dpm->state_enter_us = 0u;
+    return false;
+  }
+
+  comms_dpm_restart(dpm);
+  return true;
+}
+
+void comms_dpm_restart(comms_dpm_t *dpm)
+{
+  // SAFETY: после рестарта опубликованный образ не обновляется до нового LINK_UP;
+  // SAFETY: решение "нет свежих команд" принимает watchdog команд по отсутствию RX_NEW.
+  comms_dpm_set_host(dpm, 0u);
+  atomic_store_explicit(&dpm->irq_pending, false, memory_order_relaxed);
+  comms_dpm_enter(dpm, COMMS_DPM_STATE_OFFLINE, dpm->io.now_us(dpm->io.user));
+}
+
+void comms_dpm_irq_mark(comms_dpm_t *dpm, uint32_t now_us)
+{
+  atomic_store_explicit(&dpm->irq_time_us, now_us, memory_order_relaxed);
+  atomic_store_explicit(&dpm->irq_pending, true, memory_order_release);
+}
+
+comms_dpm_event_t comms_dpm_service(comms_dpm_t *dpm)
+{
+  const uint32_t now_us = dpm->io.now_us(dpm->io.user);
+
+  // Шаг 1: Handshake готовности (не в OPERATIONAL — только флаги, без доступа к образам).
+  if (dpm->state == COMMS_DPM_STATE_ERROR)
+  {
+    return COMMS_DPM_EVT_NONE;
+  }
+
+  if (dpm->state == COMMS_DPM_STATE_OFFLINE)
+  {
+    comms_dpm_set_host(dpm, COMMS_DPM_HOST_READY);
+    comms_dpm_enter(dpm, COMMS_DPM_STATE_WAIT_READY, now_us);
+  }
+
+  const uint32_t netx = comms_dpm_netx(dpm);
+  const bool link = ((netx & COMMS_DPM_LINK_MASK) == COMMS_DPM_LINK_MASK);
+
+  if (dpm->state == COMMS_DPM_STATE_WAIT_READY)
+  {
+    if (!link)
+    {
+      // netX жив (READY), мастер EtherCAT ещё не в OP: ждать без таймаута — время до OP задаёт мастер.
+      // Таймаут (⇒ ERROR и сброс COMX в порте) считается только от последнего NETX_READY.
+      if ((netx & COMMS_DPM_NETX_READY) != 0u)
+      {
+        dpm->state_enter_us = now_us;
+        return COMMS_DPM_EVT_NONE;
+      }
+      if ((now_us - dpm->state_enter_us) >= dpm->cfg.ready_timeout_us)
+      {
+        comms_dpm_enter(dpm, COMMS_DPM_STATE_ERROR, now_us);
+        return COMMS_DPM_EVT_ERROR;
+      }
+      return COMMS_DPM_EVT_NONE;
+    }
+
+    // Синхронизировать ACK-биты с текущими toggle COMX: старые образы до LINK_UP не потребляются,
+    // выходной буфер считается свободным.
+    uint32_t host = COMMS_DPM_HOST_READY;
+    host |= ((netx & COMMS_DPM_NETX_PD_IN_TOGGLE) != 0u) ? COMMS_DPM_HOST_PD_IN_ACK : 0u;
+    host |= ((netx & COMMS_DPM_NETX_PD_OUT_ACK) != 0u) ? COMMS_DPM_HOST_PD_OUT_TOGGLE : 0u;
+    comms_dpm_set_host(dpm, host);
+    atomic_store_explicit(&dpm->irq_pending, false, memory_order_relaxed);
+    comms_dpm_enter(dpm, COMMS_DPM_STATE_OPERATIONAL, now_us);
+    return COMMS_DPM_EVT_LINK_UP;
+  }
+
+  // Шаг 2: OPERATIONAL — контроль связи.
+  if (!link)
+  {
+    dpm->stats.cnt_link_down++;
+    comms_dpm_set_host(dpm, COMMS_DPM_HOST_READY);
+    comms_dpm_enter(dpm, COMMS_DPM_STATE_WAIT_READY, now_us);
+    return COMMS_DPM_EVT_LINK_DOWN;
+  }
+
+  if (!comms_dpm_rx_ready(dpm, netx))
+  {
+    dpm->stats.cnt_no_update++;
+    atomic_store_explicit(&dpm->irq_pending, false, memory_order_relaxed);
+    return COMMS_DPM_EVT_NONE;
+  }
+
+  // Шаг 3: Burst-копия входного образа в задний буфер.
+  const uint32_t front = (uint32_t)atomic_load_explicit(&dpm->rx_front, memory_order_relaxed) & 1u;
+  const uint32_t back = front ^ 1u;
+  comms_dpm_copy_in(dpm->rx_img[back], dpm->io.rx_area, dpm->cfg.rx_words);
+  const uint32_t copied_us = dpm->io.now_us(dpm->io.user);
+
+  const uint32_t copy_us = copied_us - now_us;
+  dpm->stats.last_copy_us = copy_us;
+  dpm->stats.max_copy_us = (copy_us > dpm->stats.max_copy_us) ? copy_us : dpm->stats.max_copy_us;
+
+  // Шаг 4: Повторная проверка toggle: если COMX успел записать новый образ, копия могла быть смешанной.
+  // SAFETY: смешанный кадр не публикуется; ACK не выставляется, следующий service прочитает свежий образ.
+  const uint32_t netx_after = comms_dpm_netx(dpm);
+  if (((netx_after ^ netx) & COMMS_DPM_NETX_PD_IN_TOGGLE) != 0u)
+  {
+    dpm->stats.cnt_rx_torn++;
+    return COMMS_DPM_EVT_RX_TORN;
+  }
+
+  // Шаг 5: ACK и публикация.
+  comms_dpm_set_host(dpm, dpm->host_flags_shadow ^ COMMS_DPM_HOST_PD_IN_ACK);
+  atomic_store_explicit(&dpm->rx_front, back, memory_order_release);
+  atomic_fetch_add_explicit(&dpm->rx_gen, 1u, memory_order_release);
+  dpm->rx_time_us = copied_us;
+  dpm->stats.cnt_rx_new++;
+  comms_dpm_account_latency(dpm, copied_us);
+  return COMMS_DPM_EVT_RX_NEW;
+}
+
+const uint32_t *comms_dpm_rx_image(const comms_dpm_t *dpm, uint32_t *gen)
+{
+  if (gen != NULL)
+  {
+    *gen = (uint32_t)atomic_load_explicit(&dpm->rx_gen, memory_order_acquire);
+  }
+  const uint32_t front = (uint32_t)atomic_load_explicit(&dpm->rx_front, memory_order_acquire) & 1u;
+  return dpm->rx_img[front];
+}
+
+uint32_t comms_dpm_rx_age_us(const comms_dpm_t *dpm, uint32_t now_us)
+{
+  if (atomic_load_explicit(&dpm->rx_gen, memory_order_acquire) == 0u)
+  {
+    return UINT32_MAX;
+  }
+  return now_us - dpm->rx_time_us;
+}
+
+bool comms_dpm_tx_write(comms_dpm_t *dpm, const uint32_t *words)
+{
+  if (dpm->state != COMMS_DPM_STATE_OPERATIONAL)
+  {
+    return false;
+  }
+
+  // COMX ещё не забрал предыдущий выход — не трогать область (её читает netX).
+  const uint32_t netx = comms_dpm_netx(dpm);
+  const bool out_free = ((netx & COMMS_DPM_NETX_PD_OUT_ACK) != 0u) ==
+                        ((dpm->host_flags_shadow & COMMS_DPM_HOST_PD_OUT_TOGGLE) != 0u);
+  if (!out_free)
+  {
+    dpm->stats.cnt_tx_busy++;
+    return false;
+  }
+
+  comms_dpm_copy_out(dpm->io.tx_area, words, dpm->cfg.tx_words);
+  comms_dpm_set_host(dpm, dpm->host_flags_shadow ^ COMMS_DPM_HOST_PD_OUT_TOGGLE);
+  dpm->stats.cnt_tx_written++;
+  return true;
+}
+
+void comms_dpm_reset_stats(comms_dpm_t *dpm)
+{
+  const comms_dpm_stats_t stats_zero = {0};
+  dpm->stats = stats_zero;
+}
@@ -0,0 +1,229 @@
+#ifndef COMMS_DPM_H
+#define COMMS_DPM_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file comms_dpm.h
+ * @brief Платформо-независимое ядро `comms_hal`: обмен process image с COMX 100CA-RE через DPM (FMC).
+ * @details
+ * Контракт RT (ARCHITECTURE §3.2, DN-007):
+ * - ISR COMX_IRQ/EXTI вызывает только comms_dpm_irq_mark() (атомарная запись метки времени) и будит task;
+ * - чтение/запись окна DPM по FMC, handshake и копирование образов — только comms_dpm_service() в task-контексте.
+ *
+ * Handshake (модель toggle-битов в стиле netX DPM):
+ * - новый вход от COMX доступен, если `netx.PD_IN_TOGGLE != host.PD_IN_ACK`; после копирования host отражает бит;
+ * - выходной буфер свободен, если `netx.PD_OUT_ACK == host.PD_OUT_TOGGLE`; после записи host инвертирует бит.
+ * Пока бит "принадлежит" host, COMX не пишет в область, поэтому копия консистентна; повторное чтение флагов
+ * после копирования ловит нарушение протокола (torn snapshot) и кадр отбрасывается.
+ *
+ * RxPDO копируется в двойной буфер образов: потребители читают последний опубликованный образ без блокировок,
+ * пока следующий копируется во второй буфер.
+ *
+ * Конкретные смещения областей DPM задаются в порте (`Fw/port/comx_fmc_port.c`) по DPM-описанию COMX/ESI.
+ */
+
+#define COMMS_DPM_IMAGE_MAX_WORDS (16u) /**< Максимальный размер образа PDO, [слова 32 бит]. */
+
+/**
+ * @brief Биты флагов netX → host (handshake cell COMX).
+ */
+typedef enum {
+  COMMS_DPM_NETX_READY = (1u << 0),         /**< Firmware COMX запущена, DPM валидна. */
+  COMMS_DPM_NETX_COMM_RUN = (1u << 1),      /**< EtherCAT в OP, process data обновляются. */
+  COMMS_DPM_NETX_PD_IN_TOGGLE = (1u << 2),  /**< Инвертируется COMX при записи нового входного образа. */
+  COMMS_DPM_NETX_PD_OUT_ACK = (1u << 3)     /**< Отражает PD_OUT_TOGGLE host после забора выходного образа. */
+} comms_dpm_netx_flag_t;
+
+/**
+ * @brief Биты флагов host → netX.
+ */
+typedef enum {
+  COMMS_DPM_HOST_READY = (1u << 0),         /**< Приложение MCU готово к обмену. */
+  COMMS_DPM_HOST_PD_IN_ACK = (1u << 2),     /**< Отражение PD_IN_TOGGLE: входной образ прочитан. */
+  COMMS_DPM_HOST_PD_OUT_TOGGLE = (1u << 3)  /**< Инвертируется host после записи выходного образа. */
+} comms_dpm_host_flag_t;
+
+/**
+ * @brief Состояние handshake-автомата DPM.
+ */
+typedef enum {
+  COMMS_DPM_STATE_OFFLINE = 0u,     /**< После init/restart: host ещё не объявил готовность. */
+  COMMS_DPM_STATE_WAIT_READY = 1u,  /**< Ожидание NETX_READY + COMM_RUN (таймаут — только по отсутствию NETX_READY). */
+  COMMS_DPM_STATE_OPERATIONAL = 2u, /**< Циклический обмен process data. */
+  COMMS_DPM_STATE_ERROR = 3u        /**< netX не READY дольше таймаута: нужен сброс COMX (порт) + comms_dpm_restart(). */
+} comms_dpm_state_t;
+
+/**
+ * @brief Результат одного вызова comms_dpm_service().
+ */
+typedef enum {
+  COMMS_DPM_EVT_NONE = 0u,      /**< Нет новых данных. */
+  COMMS_DPM_EVT_RX_NEW = 1u,    /**< Опубликован новый входной образ. */
+  COMMS_DPM_EVT_RX_TORN = 2u,   /**< Копия отброшена: COMX изменил образ во время чтения. */
+  COMMS_DPM_EVT_LINK_UP = 3u,   /**< Переход в OPERATIONAL. */
+  COMMS_DPM_EVT_LINK_DOWN = 4u, /**< Потеря COMM_RUN/READY: обмен остановлен (для watchdog команд = "нет команд"). */
+  COMMS_DPM_EVT_ERROR = 5u      /**< Таймаут готовности COMX (firmware netX не поднялась/пропала). */
+} comms_dpm_event_t;
+
+/**
+ * @brief Доступ к DPM (инжектируется портом; на host — fake DPM).
+ */
+typedef struct {
+  const volatile uint32_t *rx_area; /**< Окно входного образа (RxPDO), выровнено на 4 байта. */
+  volatile uint32_t *tx_area; /**< Окно выходного образа (TxPDO), выровнено на 4 байта. */
+  const volatile uint32_t *netx_flags; /**< Слово флагов netX → host (comms_dpm_netx_flag_t). */
+  volatile uint32_t *host_flags; /**< Слово флагов host → netX (comms_dpm_host_flag_t). */
+  uint32_t (*now_us)(void *user); /**< Монотонный timebase, [мкс] (wrap по модулю 2^32). */
+  void *user; /**< Контекст для now_us. */
+} comms_dpm_io_t;
+
+/**
+ * @brief Конфигурация обмена.
+ */
+typedef struct {
+  uint32_t rx_words; /**< Размер входного образа, [слова 32 бит] (<= COMMS_DPM_IMAGE_MAX_WORDS). */
+  uint32_t tx_words; /**< Размер выходного образа, [слова 32 бит] (<= COMMS_DPM_IMAGE_MAX_WORDS). */
+  uint32_t ready_timeout_us; /**< Таймаут отсутствия NETX_READY в WAIT_READY, [мкс]. */
+  uint32_t latency_budget_us; /**< Бюджет `IRQ → образ опубликован`, [мкс]. */
+} comms_dpm_cfg_t;
+
+/**
+ * @brief Метрики обмена (для diag/`TkPdo.Emu.Stats`).
+ */
+typedef struct {
+  uint32_t cnt_rx_new; /**< Опубликованных входных образов, [шт]. */
+  uint32_t cnt_rx_torn; /**< Отброшенных неконсистентных копий, [шт]. */
+  uint32_t cnt_no_update; /**< Вызовов service без нового образа (spurious/повторный notify), [шт]. */
+  uint32_t cnt_tx_written; /**< Записанных выходных образов, [шт]. */
+  uint32_t cnt_tx_busy; /**< Пропусков записи: COMX ещё не забрал прошлый выход, [шт]. */
+  uint32_t cnt_budget_overrun; /**< Циклов с латентностью выше бюджета, [шт]. */
+  uint32_t cnt_link_down; /**< Потерь COMM_RUN/READY в OPERATIONAL, [шт]. */
+  uint32_t last_latency_us; /**< Латентность последнего цикла `IRQ → publish`, [мкс]. */
+  uint32_t max_latency_us; /**< Максимальная латентность с init/сброса метрик, [мкс]. */
+  uint32_t last_copy_us; /**< Длительность последнего копирования образа по FMC, [мкс]. */
+  uint32_t max_copy_us; /**< Максимальная длительность копирования, [мкс]. */
+} comms_dpm_stats_t;
+
+/**
+ * @brief Контекст ядра DPM.
+ */
+typedef struct {
+  comms_dpm_io_t io; /**< Доступ к DPM. */
+  comms_dpm_cfg_t cfg; /**< Конфигурация. */
+  comms_dpm_state_t state; /**< Состояние handshake-автомата. */
+  uint32_t host_flags_shadow; /**< Теневая копия host_flags (DPM только пишется), [битовая маска]. */
+  uint32_t state_enter_us; /**< Момент входа в текущее состояние (WAIT_READY: последний NETX_READY), [мкс]. */
+  atomic_uint_fast32_t irq_time_us; /**< Метка времени последнего COMX_IRQ (пишет ISR), [мкс]. */
+  atomic_bool irq_pending; /**< Есть необработанный IRQ (для учёта латентности). */
+  uint32_t rx_img[2][COMMS_DPM_IMAGE_MAX_WORDS]; /**< Двойной буфер входного образа, [слова]. */
+  atomic_uint_fast32_t rx_front; /**< Индекс опубликованного буфера, [индекс]. */
+  atomic_uint_fast32_t rx_gen; /**< Номер поколения опубликованного образа, [шт]. */
+  uint32_t rx_time_us; /**< Момент публикации последнего образа, [мкс]. */
+  comms_dpm_stats_t stats; /**< Метрики. */
+} comms_dpm_t;
+
+/**
+ * @brief Инициализировать ядро DPM.
+ * @param dpm Указатель на контекст.
+ * @param io Доступ к DPM (копируется).
+ * @param cfg Конфигурация (копируется).
+ * @return true, если конфигурация валидна (размеры образов в пределах, now_us задан).
+ * @pre dpm != NULL, io != NULL, cfg != NULL.
+ * @post Состояние OFFLINE, host_flags = 0.
+ */
+bool comms_dpm_init(comms_dpm_t *dpm, const comms_dpm_io_t *io, const comms_dpm_cfg_t *cfg);
+
+/**
+ * @brief Перезапустить handshake (после аппаратного сброса COMX в порте).
+ * @param dpm Указатель на контекст.
+ * @return None.
+ */
+void comms_dpm_restart(comms_dpm_t *dpm);
+
+/**
+ * @brief Отметить COMX_IRQ (вызывается из ISR).
+ * @param dpm Указатель на контекст.
+ * @param now_us Текущее время, [мкс].
+ * @return None.
+ * @warning ISR-safe: только атомарные записи, без доступа к FMC/DPM.
+ */
+void comms_dpm_irq_mark(comms_dpm_t *dpm, uint32_t now_us);
+
+/**
+ * @brief Обслужить DPM в task-контексте (после notify от ISR или по опросу).
+ * @param dpm Указатель на контекст.
+ * @return Событие (comms_dpm_event_t).
+ * @details
+ * Шаги: OFFLINE → выставить HOST_READY; WAIT_READY → ждать READY+COMM_RUN (нет NETX_READY дольше таймаута ⇒ ERROR;
+ * READY без COMM_RUN — мастер не в OP — ожидание без таймаута, в т.ч. после LINK_DOWN);
+ * OPERATIONAL → при новом входе burst-копия во второй буфер, проверка torn, ACK, публикация,
+ * учёт латентности `IRQ → publish` против бюджета.
+ * Время выполнения ограничено: одна копия образа за вызов, без ожиданий.
+ */
+comms_dpm_event_t comms_dpm_service(comms_dpm_t *dpm);
+
+/**
+ * @brief Получить последний опубликованный входной образ.
+ * @param dpm Указатель на контекст.
+ * @param gen Указатель на номер поколения образа (может быть NULL), [шт].
+ * @return Указатель на образ (`rx_words` слов); валиден до следующей публикации + 1.
+ */
+const uint32_t *comms_dpm_rx_image(const comms_dpm_t *dpm, uint32_t *gen);
+
+/**
+ * @brief Возраст последнего опубликованного входного образа.
+ * @param dpm Указатель на контекст.
+ * @param now_us Текущее время, [мкс].
+ * @return `now_us - rx_time_us`, [мкс]; UINT32_MAX, если образ ещё не публиковался.
+ * @note Признак stale-данных для watchdog команд (COMX в OP, но toggle не меняется).
+ */
+uint32_t comms_dpm_rx_age_us(const comms_dpm_t *dpm, uint32_t now_us);
+
+/**
+ * @brief Записать выходной образ в DPM и передать его COMX.
+ * @param dpm Указатель на контекст.
+ * @param words Образ (`tx_words` слов).
+ * @return true, если записан; false, если не OPERATIONAL или COMX ещё не забрал предыдущий.
+ * @note Вызывается из того же task, что и comms_dpm_service().
+ */
+bool comms_dpm_tx_write(comms_dpm_t *dpm, const uint32_t *words);
+
+/**
+ * @brief Сбросить метрики латентности/счётчики (начало отчётного окна).
+ * @param dpm Указатель на контекст.
+ * @return None.
+ */
+void comms_dpm_reset_stats(comms_dpm_t *dpm);
+
+/**
+ * @brief Burst-копия слов из окна FMC в RAM.
+ * @param dst Приёмник (RAM).
+ * @param src Источник (окно DPM).
+ * @param words Количество слов, [слова 32 бит].
+ * @return None.
+ * @note Развёрнута по 4 слова: последовательные адреса без промежуточных операций
+ *       дают FMC непрерывную серию транзакций (каждое 32-бит слово = 2 такта 16-бит шины).
+ */
+void comms_dpm_copy_in(uint32_t *dst, const volatile uint32_t *src, uint32_t words);
+
+/**
+ * @brief Burst-копия слов из RAM в окно FMC.
+ * @param dst Приёмник (окно DPM).
+ * @param src Источник (RAM).
+ * @param words Количество слов, [слова 32 бит].
+ * @return None.
+ */
+void comms_dpm_copy_out(volatile uint32_t *dst, const uint32_t *src, uint32_t words);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COMMS_DPM_H */
@@ -0,0 +1,214 @@
+#include "control_adapt.h"
+
+#include <math.h>
+#include <stddef.h>
+
+/**
+ * @brief Ограничить значение диапазоном [lo, hi].
+ * @param value Значение.
+ * @param lo Нижняя граница.
+ * @param hi Верхняя граница.
+ * @return Ограниченное значение.
+ */
+static float control_adapt_clamp(float value, float lo, float hi)
+{
+  value = (value > lo) ? value : lo;
+  return (value < hi) ? value : hi;
+}
+
+/**
+ * @brief Проверить конфигурацию.
+ * @param cfg Конфигурация.
+ * @return true, если конфигурация валидна.
+ */
+static bool control_adapt_cfg_valid(const control_adapt_cfg_t *cfg)
+{
+  if ((cfg == NULL) || !isfinite(cfg->dt) || !isfinite(cfg->lambda) || !isfinite(cfg->p0) ||
+      !isfinite(cfg->i_scale) || !isfinite(cfg->i_min) || !isfinite(cfg->r_init) || !isfinite(cfg->l_init) ||
+      !isfinite(cfg->r_min) || !isfinite(cfg->r_max) || !isfinite(cfg->l_min) || !isfinite(cfg->l_max))
+  {
+    return false;
+  }
+  if ((cfg->dt <= 0.0f) || (cfg->lambda <= 0.0f) || (cfg->lambda > 1.0f) || (cfg->p0 <= 0.0f) ||
+      (cfg->i_scale <= 0.0f) || (cfg->i_min < 0.0f) || (cfg->r_min <= 0.0f) || (cfg->r_max < cfg->r_min) ||
+      (cfg->l_min < 0.0f) || (cfg->l_max < cfg->l_min))
+  {
+    return false;
+  }
+  if ((cfg->sched_count == 0u) || (cfg->sched_count > CONTROL_ADAPT_SCHED_MAX))
+  {
+    return false;
+  }
+  for (uint32_t i = 0u; i < cfg->sched_count; ++i)
+  {
+    const control_adapt_point_t *pt = &cfg->sched[i];
+    if (!isfinite(pt->r_ohm) || !isfinite(pt->kp) || !isfinite(pt->ki) || (pt->kp < 0.0f) || (pt->ki < 0.0f))
+    {
+      return false;
+    }
+    if ((i > 0u) && (pt->r_ohm <= cfg->sched[i - 1u].r_ohm))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Установить ковариацию P = p0 · E.
+ * @param est Состояние.
+ * @return None.
+ */
+static void control_adapt_reset_p(control_adapt_t *est)
+{
+  est->p[0][0] = est->cfg.p0;
+  est->p[0][1] = 0.0f;
+  est->p[1][0] = 0.0f;
+  est->p[1][1] = est->cfg.p0;
+}
+
+bool control_adapt_init(control_adapt_t *est, const control_adapt_cfg_t *cfg)
+{
+  const control_adapt_cfg_t cfg_zero = {0};
+  est->cfg_valid = control_adapt_cfg_valid(cfg);
+  est->cfg = est->cfg_valid ? *cfg : cfg_zero;
+  est->cnt_updates = 0u;
+  est->cnt_skipped = 0u;
+  est->cnt_p_resets = 0u;
+  est->cnt_warm_starts = 0u;
+  control_adapt_reset(est);
+  return est->cfg_valid;
+}
+
+void control_adapt_reset(control_adapt_t *est)
+{
+  est->theta[0] = est->cfg.r_init * est->cfg.i_scale;
+  est->theta[1] = (est->cfg_valid) ? ((est->cfg.l_init * est->cfg.i_scale) / est->cfg.dt) : 0.0f;
+  control_adapt_reset_p(est);
+  est->i_prev = 0.0f;
+  est->have_prev = false;
+  est->excited_prev = false;
+}
+
+control_gains_t control_adapt_schedule(const control_adapt_cfg_t *cfg, float r_ohm)
+{
+  control_gains_t gains = {0};
+  if ((cfg == NULL) || (cfg->sched_count == 0u) || (cfg->sched_count > CONTROL_ADAPT_SCHED_MAX) || !isfinite(r_ohm))
+  {
+    return gains;
+  }
+
+  const uint32_t last = cfg->sched_count - 1u;
+  if (r_ohm <= cfg->sched[0].r_ohm)
+  {
+    gains.kp = cfg->sched[0].kp;
+    gains.ki = cfg->sched[0].ki;
+  }
+  else if (r_ohm >= cfg->sched[last].r_ohm)
+  {
+    gains.kp = cfg->sched[last].kp;
+    gains.ki = cfg->sched[last].ki;
+  }
+  else
+  {
+    /* Не более CONTROL_ADAPT_SCHED_MAX итераций — ограничено по тактам. */
+    uint32_t seg = 0u;
+    while ((seg < (last - 1u)) && (r_ohm > cfg->sched[seg + 1u].r_ohm))
+    {
+      ++seg;
+    }
+    const control_adapt_point_t *a = &cfg->sched[seg];
+    const control_adapt_point_t *b = &cfg->sched[seg + 1u];
+    const float w = (r_ohm - a->r_ohm) / (b->r_ohm - a->r_ohm); /* [-] */
+    gains.kp = a->kp + (w * (b->kp - a->kp));
+    gains.ki = a->ki + (w * (b->ki - a->ki));
+  }
+  gains.valid = true;
+  return gains;
+}
+
+void control_adapt_step(control_adapt_t *est, float i_meas, float u_meas, control_adapt_out_t *out)
+{
+  const control_adapt_out_t out_zero = {0};
+  *out = out_zero;
+  if (!est->cfg_valid)
+  {
+    return;
+  }
+
+  const float inv_scale = 1.0f / est->cfg.i_scale; /* [1/A] */
+  const bool in_valid = isfinite(i_meas) && isfinite(u_meas);
+
+  // Шаг 1: Регрессоры и условие возбуждения.
+  const bool excited = in_valid && est->have_prev && (fabsf(i_meas) >= est->cfg.i_min);
+  if (excited && !est->excited_prev && (est->cnt_updates > 0u))
+  {
+    // Шаг 1a: Новый импульс после паузы — warm start (θ сохраняется, P = p0·E).
+    control_adapt_reset_p(est);
+    ++est->cnt_warm_starts;
+  }
+  est->excited_prev = excited;
+  if (excited)
+  {
+    const float phi0 = i_meas * inv_scale; /* [-] */
+    const float phi1 = (i_meas - est->i_prev) * inv_scale; /* [-] */
+
+    // Шаг 2: Априорная ошибка и коэффициент усиления K = Pφ / (λ + φᵀPφ).
+    const float pphi0 = (est->p[0][0] * phi0) + (est->p[0][1] * phi1);
+    const float pphi1 = (est->p[1][0] * phi0) + (est->p[1][1] * phi1);
+    const float denom = est->cfg.lambda + (phi0 * pphi0) + (phi1 * pphi1); /* >= λ > 0 при P >= 0 */
+    const float k0 = pphi0 / denom;
+    const float k1 = pphi1 / denom;
+    const float err = u_meas - ((est->theta[0] * phi0) + (est->theta[1] * phi1)); /* [В] */
+    out->residual_v = err;
+
+    // Шаг 3: Обновление θ с ограничением физически допустимым диапазоном.
+    const float r_lo = est->cfg.r_min * est->cfg.i_scale;
+    const float r_hi = est->cfg.r_max * est->cfg.i_scale;
+    const float l_lo = (est->cfg.l_min * est->cfg.i_scale) / est->cfg.dt;
+    const float l_hi = (est->cfg.l_max * est->cfg.i_scale) / est->cfg.dt;
+    est->theta[0] = control_adapt_clamp(est->theta[0] + (k0 * err), r_lo, r_hi);
+    est->theta[1] = control_adapt_clamp(est->theta[1] + (k1 * err), l_lo, l_hi);
+
+    // Шаг 4: P = (P - K·(Pφ)ᵀ) / λ, симметризация, ограничение следа.
+    const float inv_lambda = 1.0f / est->cfg.lambda;
+    const float p00 = (est->p[0][0] - (k0 * pphi0)) * inv_lambda;
+    const float p01 = (0.5f * ((est->p[0][1] - (k0 * pphi1)) + (est->p[1][0] - (k1 * pphi0)))) * inv_lambda;
+    const float p11 = (est->p[1][1] - (k1 * pphi1)) * inv_lambda;
+    est->p[0][0] = p00;
+    est->p[0][1] = p01;
+    est->p[1][0] = p01;
+    est->p[1][1] = p11;
+
+    const float trace = p00 + p11;
+    const float trace_max = 2.0f * est->cfg.p0;
+    if (!isfinite(trace) || !isfinite(p01) || (p00 < 0.0f) || (p11 < 0.0f))
+    {
+      // SAFETY: нечисловая/неположительная ковариация — перезапуск с текущей оценкой θ.
+      control_adapt_reset_p(est);
+      ++est->cnt_p_resets;
+    }
+    else if (trace > trace_max)
+    {
+      const float scale = trace_max / trace;
+      est->p[0][0] *= scale;
+      est->p[0][1] *= scale;
+      est->p[1][0] *= scale;
+      est->p[1][1] *= scale;
+    }
+    ++est->cnt_updates;
+    out->updated = true;
+  }
+  else
+  {
+    ++est->cnt_skipped;
+  }
+  est->i_prev = in_valid ? i_meas : 0.0f;
+  est->have_prev = in_valid;
+
+  // Шаг 5: Оценки в физических единицах и коэффициенты по расписанию.
+  out->r_est = est->theta[0] * inv_scale;
+  out->l_est = (est->theta[1] * est->cfg.dt) * inv_scale;
+  out->gains = control_adapt_schedule(&est->cfg, out->r_est);
+  out->gains.r_load = out->r_est;
+}
@@ -0,0 +1,130 @@
+#ifndef CONTROL_ADAPT_H
+#define CONTROL_ADAPT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "control_core.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file control_adapt.h
+ * @brief Онлайн-оценка R/L нагрузки (RLS) и gain scheduling PI по оценке R.
+ * @details
+ * Домен: fast (PWM) или slow (по `I_per`/`U_per` завершившегося периода), один шаг на период, O(1),
+ * фиксированный размер состояния (2 параметра, матрица 2x2), без делений на неконтролируемые величины.
+ *
+ * Модель вторичного контура за период: `U_k = R · I_k + L · (I_k - I_{k-1}) / T`.
+ * Регрессоры нормируются на `i_scale`, чтобы матрица ковариации float оставалась обусловленной:
+ * `φ = [I_k/i_scale, (I_k - I_{k-1})/i_scale]`, `θ = [R·i_scale, L·i_scale/T]` (оба в [В]).
+ * RLS с коэффициентом забывания λ; обновление пропускается при `|I_k| < i_min` (нет возбуждения),
+ * след P ограничивается `p0` (без "взрыва" ковариации при λ < 1), оценки ограничиваются [r_min..r_max],
+ * [l_min..l_max]. При возобновлении возбуждения после паузы (новый импульс) P сбрасывается в `p0` при
+ * сохранённой θ (warm start): нагрузка между импульсами могла смениться, а за длительное плато P "сжимается"
+ * по направлению R и переобучение без сброса затягивается на десятки периодов.
+ *
+ * Расписание коэффициентов — таблица `{r, kp, ki}` по возрастанию R с линейной интерполяцией и насыщением
+ * на краях. Результат публикуется в control_core через control_set_gains(): пара kp/ki и оценка R
+ * (`gains.r_load`) меняются атомарно; эта оценка R — единственная для feedforward control_core.
+ */
+
+#define CONTROL_ADAPT_SCHED_MAX (8u) /**< Максимум точек таблицы gain schedule, [шт]. */
+
+/**
+ * @brief Точка таблицы gain schedule.
+ */
+typedef struct {
+  float r_ohm; /**< Сопротивление нагрузки, [Ом]. */
+  float kp; /**< Коэффициент P, [отн. ед./A]. */
+  float ki; /**< Коэффициент I, [отн. ед./(A*с)]. */
+} control_adapt_point_t;
+
+/**
+ * @brief Конфигурация оценщика и расписания.
+ */
+typedef struct {
+  float dt; /**< Период обновления (период PWM), [с]. */
+  float lambda; /**< Коэффициент забывания RLS, (0..1], [-]. */
+  float p0; /**< Начальная (и предельная) диагональ ковариации P, [-]. */
+  float i_scale; /**< Масштаб нормировки тока, [A]. */
+  float i_min; /**< Минимальный |I| для обновления (возбуждение), [A]. */
+  float r_init; /**< Начальная оценка R, [Ом]. */
+  float l_init; /**< Начальная оценка L, [Гн]. */
+  float r_min; /**< Нижняя граница оценки R, [Ом]. */
+  float r_max; /**< Верхняя граница оценки R, [Ом]. */
+  float l_min; /**< Нижняя граница оценки L, [Гн]. */
+  float l_max; /**< Верхняя граница оценки L, [Гн]. */
+  control_adapt_point_t sched[CONTROL_ADAPT_SCHED_MAX]; /**< Таблица gain schedule (r по возрастанию). */
+  uint32_t sched_count; /**< Количество точек таблицы, [шт]. */
+} control_adapt_cfg_t;
+
+/**
+ * @brief Выход шага.
+ */
+typedef struct {
+  float r_est; /**< Оценка R, [Ом]. */
+  float l_est; /**< Оценка L, [Гн]. */
+  float residual_v; /**< Априорная ошибка предсказания U, [В]. */
+  control_gains_t gains; /**< PI по расписанию + r_load = r_est (valid=false, r_load=0 при невалидной конфигурации). */
+  bool updated; /**< Обновление RLS выполнено на этом шаге. */
+} control_adapt_out_t;
+
+/**
+ * @brief Состояние оценщика (фиксированного размера).
+ */
+typedef struct {
+  control_adapt_cfg_t cfg; /**< Конфигурация. */
+  bool cfg_valid; /**< Признак валидности конфигурации. */
+  float theta[2]; /**< Нормированные параметры [R·i_scale, L·i_scale/T], [В]. */
+  float p[2][2]; /**< Ковариация RLS, [-]. */
+  float i_prev; /**< Ток предыдущего периода, [A]. */
+  bool have_prev; /**< Признак валидного i_prev. */
+  bool excited_prev; /**< На прошлом периоде выполнено обновление (нет паузы). */
+  uint32_t cnt_updates; /**< Выполненных обновлений RLS, [шт]. */
+  uint32_t cnt_skipped; /**< Пропущенных периодов (нет возбуждения/невалидный вход), [шт]. */
+  uint32_t cnt_p_resets; /**< Сбросов ковариации (нечисловое состояние), [шт]. */
+  uint32_t cnt_warm_starts; /**< Сбросов P в начале импульса (warm start), [шт]. */
+} control_adapt_t;
+
+/**
+ * @brief Инициализировать оценщик.
+ * @param est Состояние.
+ * @param cfg Конфигурация.
+ * @return false при невалидной конфигурации (тогда gains.valid=false — действуют коэффициенты control_cfg_t).
+ */
+bool control_adapt_init(control_adapt_t *est, const control_adapt_cfg_t *cfg);
+
+/**
+ * @brief Сбросить оценку к начальным r_init/l_init (смена электродов/детали).
+ * @param est Состояние.
+ * @return None.
+ */
+void control_adapt_reset(control_adapt_t *est);
+
+/**
+ * @brief Шаг оценщика по измерениям завершившегося периода.
+ * @param est Состояние.
+ * @param i_meas Ток вторички за период (`I_per`), [A].
+ * @param u_meas Напряжение вторички за период (`U_per`), [В].
+ * @param out Выход (оценки и коэффициенты по расписанию).
+ * @return None.
+ * @note Невалидные (NaN/Inf) измерения пропускаются и разрывают пару I_{k-1}/I_k.
+ */
+void control_adapt_step(control_adapt_t *est, float i_meas, float u_meas, control_adapt_out_t *out);
+
+/**
+ * @brief Коэффициенты PI по таблице расписания для заданного R.
+ * @param cfg Конфигурация (таблица).
+ * @param r_ohm Сопротивление, [Ом].
+ * @return Коэффициенты (valid=false при пустой таблице или NaN).
+ */
+control_gains_t control_adapt_schedule(const control_adapt_cfg_t *cfg, float r_ohm);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONTROL_ADAPT_H */
@@ -20,7 +20,13 @@ static bool control_cfg_is_valid(const control_cfg_t *cfg)
       !isfinite(cfg->u_max) ||
       !isfinite(cfg->i_ref_min) ||
       !isfinite(cfg->i_ref_max) ||
-      !isfinite(cfg->di_dt_max))
+      !isfinite(cfg->di_dt_max) ||
+      !isfinite(cfg->ff_n_tr) ||
+      !isfinite(cfg->ff_udc_min) ||
+      !isfinite(cfg->ff_u_max) ||
+      !isfinite(cfg->outer_gain) ||
+      !isfinite(cfg->outer_i_start) ||
+      !isfinite(cfg->outer_i_min))
   {
     return false;
   }
@@ -48,6 +54,15 @@ static bool control_cfg_is_valid(const control_cfg_t *cfg)
   {
     return false;
   }
+  if ((cfg->ff_n_tr < 0.0f) || (cfg->ff_udc_min < 0.0f) || (cfg->ff_u_max < 0.0f))
+  {
+    return false;
+  }
+  if ((cfg->outer_gain < 0.0f) || (cfg->outer_gain > 1.0f) || (cfg->outer_i_start < 0.0f) ||
+      (cfg->outer_i_min < 0.0f))
+  {
+    return false;
+  }
   return true;
 }
 
@@ -114,6 +129,157 @@ static float control_apply_slew(float target,
   return result;
 }
 
+/**
+ * @brief Вычислить вклад feedforward по оценке R нагрузки (DN-001 §4.2).
+ * @param cfg Указатель на конфигурацию.
+ * @param r_load Оценка R нагрузки (control_adapt через control_set_gains()), [Ом].
+ * @param meas Указатель на измерения.
+ * @param i_ref_used Уставка после conditioning, [A].
+ * @param u_min Эффективный нижний предел u, [отн. ед.].
+ * @param u_max Эффективный верхний предел u, [отн. ед.].
+ * @param flags Указатель на флаги шага.
+ * @return Вклад feedforward, [отн. ед.].
+ */
+static float control_feedforward(const control_cfg_t *cfg,
+                                 float r_load,
+                                 const control_meas_t *meas,
+                                 float i_ref_used,
+                                 float u_min,
+                                 float u_max,
+                                 uint32_t *flags)
+{
+  if ((cfg->ff_n_tr <= 0.0f) || (r_load <= 0.0f))
+  {
+    return 0.0f;
+  }
+
+  // SAFETY: при Udc < Udc_crit (или невалидном Udc) feedforward не пытается компенсировать невозможный режим.
+  if (!isfinite(meas->udc) || (meas->udc <= 0.0f) || (meas->udc < cfg->ff_udc_min))
+  {
+    *flags |= CONTROL_FLAG_FF_LIMITED;
+    return 0.0f;
+  }
+
+  const float u_ff_raw = (i_ref_used * r_load * cfg->ff_n_tr) / meas->udc; /* [отн. ед.] */
+  const float ff_hi = (cfg->ff_u_max < u_max) ? cfg->ff_u_max : u_max; /* [отн. ед.] */
+  float ff_lo = (-cfg->ff_u_max > u_min) ? -cfg->ff_u_max : u_min; /* [отн. ед.] */
+  ff_lo = (ff_lo < ff_hi) ? ff_lo : ff_hi;
+  const float u_ff = control_clamp_f(u_ff_raw, ff_lo, ff_hi); /* [отн. ед.] */
+  if (u_ff != u_ff_raw)
+  {
+    *flags |= CONTROL_FLAG_FF_LIMITED;
+  }
+  if (u_ff != 0.0f)
+  {
+    *flags |= CONTROL_FLAG_FF_ACTIVE;
+  }
+  return u_ff;
+}
+
+/**
+ * @brief Сессия сварки внешнего контура: фронт enable_cmd, энергия, отсечка CE, валидация режима.
+ * @param cfg Указатель на конфигурацию.
+ * @param state Указатель на состояние.
+ * @param cmd Снимок команды.
+ * @param meas Указатель на измерения.
+ * @param flags Указатель на флаги шага.
+ * @return None.
+ */
+static void control_outer_session(const control_cfg_t *cfg,
+                                  control_state_t *state,
+                                  const control_cmd_t *cmd,
+                                  const control_meas_t *meas,
+                                  uint32_t *flags)
+{
+  const control_reg_mode_t mode = cmd->reg_mode;
+  const bool outer = (mode == CONTROL_REG_CP) || (mode == CONTROL_REG_CV);
+  const bool uses_p = (mode == CONTROL_REG_CP) || (mode == CONTROL_REG_CE);
+
+  if ((mode >= CONTROL_REG_COUNT) || (outer && (cfg->outer_gain <= 0.0f)) ||
+      ((mode != CONTROL_REG_CC) && (cmd->target <= 0.0f)))
+  {
+    *flags |= CONTROL_FLAG_CMD_INVALID;
+  }
+  if (((mode != CONTROL_REG_CC) && !isfinite(cmd->target)) || (uses_p && !isfinite(meas->p_meas)) ||
+      ((mode == CONTROL_REG_CV) && !isfinite(meas->u_meas)))
+  {
+    *flags |= CONTROL_FLAG_NUM_INVALID;
+  }
+
+  // Новая сварка = только фронт enable_cmd: смена режима или кратковременная невалидность команды внутри
+  // сварки не обнуляют энергию и уставку внешнего контура (иначе CE→CC→CE обходит отсечку).
+  const bool session = cmd->cmd_valid && cmd->enable_cmd;
+  if (cmd->enable_cmd && !state->enable_prev)
+  {
+    state->energy_j = 0.0f;
+    state->energy_cutoff = false;
+    state->outer_i_ref = cfg->outer_i_start;
+  }
+  if (!cmd->enable_cmd)
+  {
+    state->energy_cutoff = false;
+  }
+  state->enable_prev = cmd->enable_cmd;
+
+  // Энергия считается по измеренной мощности независимо от allow: это фактически отданная в нагрузку энергия.
+  if (session && meas->meas_valid && isfinite(meas->p_meas))
+  {
+    state->energy_j += meas->p_meas * cfg->dt;
+  }
+  if (session && (mode == CONTROL_REG_CE) && (state->energy_j >= cmd->target))
+  {
+    state->energy_cutoff = true;
+  }
+  if (state->energy_cutoff)
+  {
+    // SAFETY: отсечка держится до снятия enable_cmd — повторный набор энергии в той же сварке невозможен.
+    *flags |= CONTROL_FLAG_ENERGY_CUTOFF;
+  }
+}
+
+/**
+ * @brief Уставка тока внешнего контура CP/CV (CC/CE — команда без изменений).
+ * @param cfg Указатель на конфигурацию.
+ * @param state Указатель на состояние.
+ * @param cmd Снимок команды.
+ * @param meas Указатель на измерения.
+ * @param flags Указатель на флаги шага.
+ * @return Уставка тока до conditioning, [A].
+ * @details
+ * CP: `I* = I_per·sqrt(P_ref/P_per)`, CV: `I* = I_per·U_ref/U_per` — на резистивной нагрузке это
+ * `sqrt(P_ref/R)` и `U_ref/R`, т.е. неподвижная точка не зависит от текущего тока и оценки R не требует.
+ * Уставка релаксирует к I* с коэффициентом outer_gain и ограничивается потолком `i_ref_cmd`.
+ */
+static float control_outer_ref(const control_cfg_t *cfg,
+                               control_state_t *state,
+                               const control_cmd_t *cmd,
+                               const control_meas_t *meas,
+                               uint32_t *flags)
+{
+  if ((cmd->reg_mode != CONTROL_REG_CP) && (cmd->reg_mode != CONTROL_REG_CV))
+  {
+    return cmd->i_ref_cmd;
+  }
+
+  const float y_meas = (cmd->reg_mode == CONTROL_REG_CP) ? meas->p_meas : meas->u_meas; /* [Вт] / [В] */
+  float i_target = cfg->outer_i_start; /* [A] */
+  if ((meas->i_meas >= cfg->outer_i_min) && (meas->i_meas > 0.0f) && (y_meas > 0.0f))
+  {
+    const float ratio = cmd->target / y_meas; /* [-] */
+    i_target = meas->i_meas * ((cmd->reg_mode == CONTROL_REG_CP) ? sqrtf(ratio) : ratio);
+  }
+
+  const float i_cap = (cmd->i_ref_cmd > 0.0f) ? cmd->i_ref_cmd : 0.0f; /* [A] */
+  const float i_next = state->outer_i_ref + (cfg->outer_gain * (i_target - state->outer_i_ref)); /* [A] */
+  state->outer_i_ref = control_clamp_f(i_next, 0.0f, i_cap);
+  if (state->outer_i_ref != i_next)
+  {
+    *flags |= CONTROL_FLAG_IREF_CLAMP;
+  }
+  *flags |= CONTROL_FLAG_OUTER_ACTIVE;
+  return state->outer_i_ref;
+}
+
 /**
  * @brief Применить политику безопасного запрета управления.
  * @param cfg Указатель на конфигурацию.
@@ -140,9 +306,21 @@ void control_init(control_ctx_t *ctx, const control_cfg_t *cfg)
   ctx->state.cmd_buf[0] = cmd_zero;
   ctx->state.cmd_buf[1] = cmd_zero;
   atomic_init(&ctx->state.active_cmd_idx, 0u);
+  control_limits_reset(&ctx->state.limits_buf[0]);
+  control_limits_reset(&ctx->state.limits_buf[1]);
+  atomic_init(&ctx->state.active_limits_idx, 0u);
+  const control_gains_t gains_none = {0};
+  ctx->state.gains_buf[0] = gains_none;
+  ctx->state.gains_buf[1] = gains_none;
+  atomic_init(&ctx->state.active_gains_idx, 0u);
   ctx->state.cfg_valid = false;
   ctx->state.limit_hi_steps = 0u;
   ctx->state.limit_lo_steps = 0u;
+  ctx->state.r_est = 0.0f;
+  ctx->state.outer_i_ref = 0.0f;
+  ctx->state.energy_j = 0.0f;
+  ctx->state.energy_cutoff = false;
+  ctx->state.enable_prev = false;
   ctx->state.cfg_valid = control_cfg_is_valid(cfg);
 }
 
@@ -154,6 +332,77 @@ void control_slow_step(control_ctx_t *ctx, const control_cmd_t *cmd)
   atomic_store_explicit(&ctx->state.active_cmd_idx, next_idx, memory_order_release);
 }
 
+/**
+ * @brief Проверить динамические пределы.
+ * @param limits Указатель на набор пределов.
+ * @return true, если каждый предел конечен или "без предела" в своём направлении (u_min=-INFINITY,
+ *         u_max=+INFINITY) и u_min <= u_max; NaN, u_max=-INFINITY, u_min=+INFINITY и конфликт — false.
+ */
+static bool control_limits_valid(const control_limits_t *limits)
+{
+  const bool min_ok = isfinite(limits->u_min) || (limits->u_min == -INFINITY);
+  const bool max_ok = isfinite(limits->u_max) || (limits->u_max == INFINITY);
+  return min_ok && max_ok && (limits->u_min <= limits->u_max);
+}
+
+void control_limits_reset(control_limits_t *limits)
+{
+  limits->u_min = -INFINITY;
+  limits->u_max = INFINITY;
+  limits->src_min = CONTROL_LIMIT_SRC_NONE;
+  limits->src_max = CONTROL_LIMIT_SRC_NONE;
+}
+
+void control_limits_tighten_max(control_limits_t *limits, float u_max, uint32_t src)
+{
+  if (isnan(u_max) || (u_max < limits->u_max))
+  {
+    limits->u_max = u_max;
+    limits->src_max = src;
+  }
+  else if (u_max == limits->u_max)
+  {
+    limits->src_max |= src;
+  }
+}
+
+void control_limits_tighten_min(control_limits_t *limits, float u_min, uint32_t src)
+{
+  if (isnan(u_min) || (u_min > limits->u_min))
+  {
+    limits->u_min = u_min;
+    limits->src_min = src;
+  }
+  else if (u_min == limits->u_min)
+  {
+    limits->src_min |= src;
+  }
+}
+
+void control_set_limits(control_ctx_t *ctx, const control_limits_t *limits)
+{
+  const uint32_t active_idx = atomic_load_explicit(&ctx->state.active_limits_idx, memory_order_relaxed) & 1u;
+  const uint32_t next_idx = active_idx ^ 1u;
+  if (limits != NULL)
+  {
+    ctx->state.limits_buf[next_idx] = *limits;
+  }
+  else
+  {
+    control_limits_reset(&ctx->state.limits_buf[next_idx]);
+  }
+  atomic_store_explicit(&ctx->state.active_limits_idx, next_idx, memory_order_release);
+}
+
+void control_set_gains(control_ctx_t *ctx, const control_gains_t *gains)
+{
+  const control_gains_t gains_none = {0};
+  const uint32_t active_idx = atomic_load_explicit(&ctx->state.active_gains_idx, memory_order_relaxed) & 1u;
+  const uint32_t next_idx = active_idx ^ 1u;
+  ctx->state.gains_buf[next_idx] = (gains != NULL) ? *gains : gains_none;
+  atomic_store_explicit(&ctx->state.active_gains_idx, next_idx, memory_order_release);
+}
+
 void control_fast_step(control_ctx_t *ctx, const control_meas_t *meas, bool allow, control_out_t *out)
 {
   // SAFETY: при запрете управления или невалидных измерениях запрос на управление = 0.
@@ -166,6 +415,18 @@ void control_fast_step(control_ctx_t *ctx, const control_meas_t *meas, bool allo
 
   cmd_snapshot = ctx->state.cmd_buf[cmd_idx];
 
+  const uint32_t limits_idx = atomic_load_explicit(&ctx->state.active_limits_idx, memory_order_acquire) & 1u;
+  const control_limits_t limits = ctx->state.limits_buf[limits_idx];
+
+  const uint32_t gains_idx = atomic_load_explicit(&ctx->state.active_gains_idx, memory_order_acquire) & 1u;
+  const control_gains_t gains = ctx->state.gains_buf[gains_idx];
+  const bool gains_ok = gains.valid && isfinite(gains.kp) && isfinite(gains.ki) && (gains.kp >= 0.0f) &&
+                        (gains.ki >= 0.0f);
+  const float kp = gains_ok ? gains.kp : ctx->cfg.kp; /* [отн. ед./A] */
+  const float ki = gains_ok ? gains.ki : ctx->cfg.ki; /* [отн. ед./(A*с)] */
+  // Оценка R для feedforward — единственная, от control_adapt (RLS); не опубликована/невалидна ⇒ вклад FF = 0.
+  ctx->state.r_est = (isfinite(gains.r_load) && (gains.r_load > 0.0f)) ? gains.r_load : 0.0f; /* [Ом] */
+
   if (!cmd_snapshot.cmd_valid)
   {
     flags |= CONTROL_FLAG_CMD_INVALID;
@@ -174,10 +435,11 @@ void control_fast_step(control_ctx_t *ctx, const control_meas_t *meas, bool allo
   {
     flags |= CONTROL_FLAG_CFG_INVALID;
   }
-  if (!isfinite(cmd_snapshot.i_ref_cmd) || !isfinite(meas->i_meas))
+  if (!isfinite(cmd_snapshot.i_ref_cmd) || !isfinite(meas->i_meas) || !control_limits_valid(&limits))
   {
     flags |= CONTROL_FLAG_NUM_INVALID;
   }
+  control_outer_session(&ctx->cfg, &ctx->state, &cmd_snapshot, meas, &flags);
 
   const bool allow_cmd = (allow && cmd_snapshot.cmd_valid && cmd_snapshot.enable_cmd);
 
@@ -191,9 +453,10 @@ void control_fast_step(control_ctx_t *ctx, const control_meas_t *meas, bool allo
   }
 
   if ((!allow_cmd) || (!meas->meas_valid) ||
-      ((flags & (CONTROL_FLAG_CFG_INVALID | CONTROL_FLAG_CMD_INVALID | CONTROL_FLAG_NUM_INVALID)) != 0u))
+      ((flags & (CONTROL_FLAG_CFG_INVALID | CONTROL_FLAG_CMD_INVALID | CONTROL_FLAG_NUM_INVALID |
+                 CONTROL_FLAG_ENERGY_CUTOFF)) != 0u))
   {
-    // Шаг 1: Безопасный выход при запрете или невалидных измерениях.
+    // Шаг 1: Безопасный выход при запрете, невалидных измерениях или отсечке CE.
     control_apply_disable_policy(&ctx->cfg, &ctx->state);
     out->u = 0.0f;
     out->i_ref_used = ctx->state.i_ref_used;
@@ -201,22 +464,36 @@ void control_fast_step(control_ctx_t *ctx, const control_meas_t *meas, bool allo
     out->flags = flags;
     out->limit_hi_steps = ctx->state.limit_hi_steps;
     out->limit_lo_steps = ctx->state.limit_lo_steps;
+    out->limit_src = CONTROL_LIMIT_SRC_NONE;
+    out->u_ff = 0.0f;
+    out->r_est = ctx->state.r_est;
+    out->energy_j = ctx->state.energy_j;
     return;
   }
 
-  // Шаг 2: Ограничить уставку по диапазону.
-  const float i_ref_cmd = cmd_snapshot.i_ref_cmd; /* [A] */
+  // Шаг 2: Уставка тока внешнего контура (CP/CV) или команда (CC/CE).
+  const float i_ref_cmd = control_outer_ref(&ctx->cfg, &ctx->state, &cmd_snapshot, meas, &flags); /* [A] */
+
+  // Шаг 3: Ограничить уставку по диапазону.
   const float i_ref_clamped = control_clamp_f(i_ref_cmd, ctx->cfg.i_ref_min, ctx->cfg.i_ref_max); /* [A] */
   if (i_ref_clamped != i_ref_cmd)
   {
     flags |= CONTROL_FLAG_IREF_CLAMP;
   }
 
-  // Шаг 3: Применить slew-rate лимитер.
+  // Шаг 4: Применить slew-rate лимитер: лимит ТК, но не шире аппаратного cfg.di_dt_max.
+  const float di_dt_cmd = (isfinite(cmd_snapshot.di_dt_cmd) && (cmd_snapshot.di_dt_cmd > 0.0f))
+                            ? cmd_snapshot.di_dt_cmd
+                            : 0.0f; /* [A/с] */
+  float di_dt_max = ctx->cfg.di_dt_max; /* [A/с] */
+  if ((di_dt_cmd > 0.0f) && ((di_dt_max <= 0.0f) || (di_dt_cmd < di_dt_max)))
+  {
+    di_dt_max = di_dt_cmd;
+  }
   bool slew_active = false;
   const float i_ref_used = control_apply_slew(i_ref_clamped,
                                               ctx->state.i_ref_used,
-                                              ctx->cfg.di_dt_max,
+                                              di_dt_max,
                                               ctx->cfg.dt,
                                               &slew_active); /* [A] */
   if (slew_active)
@@ -225,20 +502,48 @@ void control_fast_step(control_ctx_t *ctx, const control_meas_t *meas, bool allo
   }
   ctx->state.i_ref_used = i_ref_used;
 
-  // Шаг 4: Вычислить ошибку по току.
+  // Шаг 5: Эффективные пределы u = пересечение cfg и динамических пределов защит.
+  // SAFETY: динамические пределы уже проверены (конечны, u_min <= u_max); при конфликте с cfg
+  // (динамический u_min > cfg.u_max) побеждает верхний предел — меньше энергии.
+  float u_max = ctx->cfg.u_max; /* [отн. ед.] */
+  float u_min = ctx->cfg.u_min; /* [отн. ед.] */
+  uint32_t src_hi = CONTROL_LIMIT_SRC_NONE;
+  uint32_t src_lo = CONTROL_LIMIT_SRC_NONE;
+  if (limits.u_max < u_max)
+  {
+    u_max = limits.u_max;
+    src_hi = limits.src_max;
+    flags |= CONTROL_FLAG_DYN_LIMIT;
+  }
+  if (limits.u_min > u_min)
+  {
+    u_min = limits.u_min;
+    src_lo = limits.src_min;
+    flags |= CONTROL_FLAG_DYN_LIMIT;
+  }
+  if (u_min > u_max)
+  {
+    u_min = u_max;
+    src_lo = src_hi;
+  }
+
+  // Шаг 6: Feedforward по оценке R нагрузки (ограничен раньше PI).
+  const float u_ff = control_feedforward(&ctx->cfg, ctx->state.r_est, meas, i_ref_used, u_min, u_max, &flags);
+
+  // Шаг 7: Вычислить ошибку по току.
   const float error = i_ref_used - meas->i_meas; /* [A] */
 
-  // Шаг 5: PI + anti-windup (conditional integration).
+  // Шаг 8: PI + anti-windup (conditional integration) по эффективным пределам.
   // Anti-windup: запрещаем "ухудшающее" интегрирование в насыщении и ограничиваем интегратор,
   // чтобы после выхода из лимита не получить длительный выброс управления.
-  const float u_p = ctx->cfg.kp * error; /* [отн. ед.] */
+  const float u_p = kp * error; /* [отн. ед.] */
   float u_i = ctx->state.integrator; /* [отн. ед.] */
-  float u_unsat = u_p + u_i; /* [отн. ед.] */
-  bool sat_hi = (u_unsat > ctx->cfg.u_max);
-  bool sat_lo = (u_unsat < ctx->cfg.u_min);
+  float u_unsat = u_ff + u_p + u_i; /* [отн. ед.] */
+  bool sat_hi = (u_unsat > u_max);
+  bool sat_lo = (u_unsat < u_min);
   bool integrate = true;
 
-  if ((ctx->cfg.dt <= 0.0f) || (ctx->cfg.ki == 0.0f))
+  if ((ctx->cfg.dt <= 0.0f) || (ki == 0.0f))
   {
     integrate = false;
   }
@@ -255,7 +560,7 @@ void control_fast_step(control_ctx_t *ctx, const control_meas_t *meas, bool allo
 
   if (integrate)
   {
-    u_i = u_i + (ctx->cfg.ki * error * ctx->cfg.dt);
+    u_i = u_i + (ki * error * ctx->cfg.dt);
   }
 
   if (!isfinite(u_i))
@@ -268,20 +573,25 @@ void control_fast_step(control_ctx_t *ctx, const control_meas_t *meas, bool allo
     out->flags = flags;
     out->limit_hi_steps = ctx->state.limit_hi_steps;
     out->limit_lo_steps = ctx->state.limit_lo_steps;
+    out->limit_src = CONTROL_LIMIT_SRC_NONE;
+    out->u_ff = 0.0f;
+    out->r_est = ctx->state.r_est;
+    out->energy_j = ctx->state.energy_j;
     return;
   }
 
-  const float u_i_clamped = control_clamp_f(u_i, ctx->cfg.u_min, ctx->cfg.u_max);
+  // Интегратор ограничивается остатком диапазона после feedforward: u_ff + u_i ∈ [u_min, u_max].
+  const float u_i_clamped = control_clamp_f(u_i, u_min - u_ff, u_max - u_ff);
   if (u_i_clamped != u_i)
   {
     flags |= CONTROL_FLAG_WINDUP_BLOCK;
   }
   u_i = u_i_clamped;
 
-  u_unsat = u_p + u_i;
-  const float u = control_clamp_f(u_unsat, ctx->cfg.u_min, ctx->cfg.u_max); /* [отн. ед.] */
-  sat_hi = (u_unsat > ctx->cfg.u_max);
-  sat_lo = (u_unsat < ctx->cfg.u_min);
+  u_unsat = u_ff + u_p + u_i;
+  const float u = control_clamp_f(u_unsat, u_min, u_max); /* [отн. ед.] */
+  sat_hi = (u_unsat > u_max);
+  sat_lo = (u_unsat < u_min);
 
   if (sat_hi)
   {
@@ -305,11 +615,15 @@ void control_fast_step(control_ctx_t *ctx, const control_meas_t *meas, bool allo
 
   ctx->state.integrator = u_i;
 
-  // Шаг 6: Сформировать выход.
+  // Шаг 9: Сформировать выход.
   out->u = u;
   out->i_ref_used = i_ref_used;
   out->enable_request = true;
   out->flags = flags;
   out->limit_hi_steps = ctx->state.limit_hi_steps;
   out->limit_lo_steps = ctx->state.limit_lo_steps;
+  out->limit_src = sat_hi ? src_hi : (sat_lo ? src_lo : CONTROL_LIMIT_SRC_NONE);
+  out->u_ff = u_ff;
+  out->r_est = ctx->state.r_est;
+  out->energy_j = ctx->state.energy_j;
 }
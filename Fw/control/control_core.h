@@ -17,6 +17,10 @@ extern "C" {
  * Управление рассчитывается детерминированно в fast-домене (PWM), команды принимаются в slow-домене (250 мкс / 4 кГц).
  * В fast-домене используется последняя валидная команда (command latch), защёлкнутая на границе периода PWM.
  * Маппинг `u` в аппаратные регистры выполняется в `pwm_hal`.
+ * Динамические пределы `u` (вольт-секунды, запас по udc, тепловой дерейтинг, ManualDuty) подаются через
+ * control_set_limits() тем же double-buffer механизмом, что и команда, и применяются в control_fast_step().
+ * Режим регулирования выбирается командой (`control_cmd_t.reg_mode`): CC — ток; CP/CV — внешний контур
+ * мощности/напряжения формирует уставку тока для того же PI; CE — ток с отсечкой по энергии за сварку.
  */
 
 /**
@@ -42,9 +46,37 @@ typedef enum {
   CONTROL_FLAG_CFG_INVALID = (1u << 7),    /**< Невалидная конфигурация. */
   CONTROL_FLAG_CMD_INVALID = (1u << 8),    /**< Невалидная команда/устаревшая команда. */
   CONTROL_FLAG_NUM_INVALID = (1u << 9),    /**< Некорректные численные значения (NaN/Inf). */
-  CONTROL_FLAG_WINDUP_BLOCK = (1u << 10)   /**< Блокировка интегрирования от усугубления насыщения. */
+  CONTROL_FLAG_WINDUP_BLOCK = (1u << 10),  /**< Блокировка интегрирования от усугубления насыщения. */
+  CONTROL_FLAG_DYN_LIMIT = (1u << 11),     /**< Динамический предел u строже статического из control_cfg_t. */
+  CONTROL_FLAG_FF_ACTIVE = (1u << 12),     /**< Feedforward внёс ненулевой вклад. */
+  CONTROL_FLAG_FF_LIMITED = (1u << 13),    /**< Feedforward ограничен (ff_u_max/u_max) или отключён по Udc < Udc_crit. */
+  CONTROL_FLAG_OUTER_ACTIVE = (1u << 14),  /**< Уставка тока сформирована внешним контуром (CP/CV). */
+  CONTROL_FLAG_ENERGY_CUTOFF = (1u << 15)  /**< CE: энергия за сварку достигла цели, управление отсечено. */
 } control_status_flag_t;
 
+/**
+ * @brief Режим регулирования (внешний контур над PI тока).
+ */
+typedef enum {
+  CONTROL_REG_CC = 0u, /**< Постоянный ток: `target` не используется. */
+  CONTROL_REG_CP = 1u, /**< Постоянная мощность: `target` = P_ref, [Вт]. */
+  CONTROL_REG_CE = 2u, /**< Ток `i_ref_cmd` до достижения энергии `target` = E_ref, [Дж], затем отсечка. */
+  CONTROL_REG_CV = 3u, /**< Постоянное напряжение нагрузки: `target` = U_ref, [В]. */
+  CONTROL_REG_COUNT
+} control_reg_mode_t;
+
+/**
+ * @brief Источники динамических пределов `u` (биты `control_limits_t.src_*` и `control_out_t.limit_src`).
+ */
+typedef enum {
+  CONTROL_LIMIT_SRC_NONE = 0u,             /**< Нет источника (действует control_cfg_t). */
+  CONTROL_LIMIT_SRC_VS = (1u << 0),        /**< Вольт-секунды / насыщение трансформатора (control_vs). */
+  CONTROL_LIMIT_SRC_UDC = (1u << 1),       /**< Запас по напряжению звена DC. */
+  CONTROL_LIMIT_SRC_THERMAL = (1u << 2),   /**< Тепловой дерейтинг. */
+  CONTROL_LIMIT_SRC_MANUAL_DUTY = (1u << 3), /**< Сервисный режим ManualDuty. */
+  CONTROL_LIMIT_SRC_PROGRAM = (1u << 4)    /**< Предел сегмента программы сварки (control_program). */
+} control_limit_src_t;
+
 /**
  * @brief Конфигурация ядра управления.
  */
@@ -58,6 +90,12 @@ typedef struct {
   float i_ref_max; /**< Максимальная уставка тока, [A]. */
   float di_dt_max; /**< Максимальная скорость изменения уставки, [A/с]. */
   control_integrator_policy_t integrator_policy; /**< Политика интегратора при запрете. */
+  float ff_n_tr; /**< Коэффициент трансформации N1/N2 для feedforward (0 — feedforward выключен), [-]. */
+  float ff_udc_min; /**< Udc_crit: ниже — вклад feedforward = 0, [В]. */
+  float ff_u_max; /**< Предел вклада feedforward (ограничивается раньше PI), [отн. ед.]. */
+  float outer_gain; /**< Коэффициент релаксации внешнего контура CP/CV за период, [0..1] (0 — CP/CV запрещены). */
+  float outer_i_start; /**< Стартовая уставка тока CP/CV до появления измеримого тока, [A]. */
+  float outer_i_min; /**< Минимальный ток, при котором внешний контур пересчитывает уставку по измерениям, [A]. */
 } control_cfg_t;
 
 /**
@@ -65,9 +103,12 @@ typedef struct {
  * @details Используется последняя валидная команда, защёлкнутая на границе периода PWM (command latch).
  */
 typedef struct {
-  float i_ref_cmd; /**< Команда уставки тока от ТК, [A]. */
+  float i_ref_cmd; /**< Команда уставки тока от ТК (CC/CE), в CP/CV — потолок уставки тока, [A]. */
   bool enable_cmd; /**< Команда разрешения управления от ТК. */
   bool cmd_valid; /**< Признак валидности/актуальности команды. */
+  control_reg_mode_t reg_mode; /**< Режим регулирования (по умолчанию CC). */
+  float target; /**< Цель внешнего контура: P_ref [Вт] / E_ref [Дж] / U_ref [В] по reg_mode. */
+  float di_dt_cmd; /**< Лимит dI/dt от ТК (<= 0 — только cfg.di_dt_max; не шире cfg.di_dt_max), [A/с]. */
 } control_cmd_t;
 
 /**
@@ -75,8 +116,9 @@ typedef struct {
  */
 typedef struct {
   float i_meas; /**< Измеренный ток (среднее за период PWM), [A]. */
-  float u_meas; /**< Измеренное напряжение (опционально), [В]. */
+  float u_meas; /**< Измеренное напряжение нагрузки `U_per` (CV), [В]. */
   float udc; /**< Напряжение звена DC (опционально), [В]. */
+  float p_meas; /**< Мощность `P_per = mean(I·U)` за период (CP/CE), [Вт]. */
   bool meas_valid; /**< Признак валидности измерений. */
 } control_meas_t;
 
@@ -90,8 +132,33 @@ typedef struct {
   uint32_t flags; /**< Битовая маска control_status_flag_t. */
   uint32_t limit_hi_steps; /**< Шаги подряд в верхнем насыщении, [шаги]. */
   uint32_t limit_lo_steps; /**< Шаги подряд в нижнем насыщении, [шаги]. */
+  uint32_t limit_src; /**< Источники динамического предела, зажавшего u на этом шаге (control_limit_src_t), [битовая маска]. */
+  float u_ff; /**< Вклад feedforward в u, [отн. ед.]. */
+  float r_est; /**< Оценка R нагрузки (вторичка), применённая feedforward, [Ом] (0 — не опубликована). */
+  float energy_j; /**< Энергия за текущую сварку (с фронта enable_cmd), [Дж]. */
 } control_out_t;
 
+/**
+ * @brief Динамические пределы `u` на период PWM (пересечение всех защит).
+ * @details Собираются вызовами control_limits_tighten_*(); более строгий из пределов и cfg применяется в шаге.
+ */
+typedef struct {
+  float u_min; /**< Нижний предел u, [отн. ед.]. */
+  float u_max; /**< Верхний предел u, [отн. ед.]. */
+  uint32_t src_min; /**< Источник текущего u_min (control_limit_src_t), [битовая маска]. */
+  uint32_t src_max; /**< Источник текущего u_max (control_limit_src_t), [битовая маска]. */
+} control_limits_t;
+
+/**
+ * @brief Результат адаптации, применяемый атомарно: коэффициенты PI (gain scheduling) и оценка R для feedforward.
+ */
+typedef struct {
+  float kp; /**< Коэффициент P, [отн. ед./A]. */
+  float ki; /**< Коэффициент I, [отн. ед./(A*с)]. */
+  bool valid; /**< false — использовать kp/ki из control_cfg_t (r_load от valid не зависит). */
+  float r_load; /**< Оценка R нагрузки (вторичка) для feedforward, [Ом] (<= 0 или NaN — вклад feedforward = 0). */
+} control_gains_t;
+
 /**
  * @brief Состояние ядра управления.
  */
@@ -100,9 +167,18 @@ typedef struct {
   float i_ref_used; /**< Последняя использованная уставка, [A]. */
   control_cmd_t cmd_buf[2]; /**< Два буфера команды (double-buffer), [отн. ед.]. */
   atomic_uint_fast32_t active_cmd_idx; /**< Индекс активного буфера, [индекс]. */
+  control_limits_t limits_buf[2]; /**< Два буфера динамических пределов (double-buffer). */
+  atomic_uint_fast32_t active_limits_idx; /**< Индекс активного буфера пределов, [индекс]. */
+  control_gains_t gains_buf[2]; /**< Два буфера коэффициентов PI (double-buffer). */
+  atomic_uint_fast32_t active_gains_idx; /**< Индекс активного буфера коэффициентов, [индекс]. */
   bool cfg_valid; /**< Признак валидности конфигурации. */
   uint32_t limit_hi_steps; /**< Счётчик верхнего насыщения, [шаги]. */
   uint32_t limit_lo_steps; /**< Счётчик нижнего насыщения, [шаги]. */
+  float r_est; /**< Оценка R нагрузки из активного буфера gains_buf (control_adapt), [Ом]. */
+  float outer_i_ref; /**< Уставка тока внешнего контура CP/CV, [A]. */
+  float energy_j; /**< Энергия за текущую сварку, [Дж]. */
+  bool energy_cutoff; /**< CE: отсечка по энергии (защёлка до снятия enable_cmd, в т.ч. при смене режима). */
+  bool enable_prev; /**< enable_cmd на прошлом шаге (фронт = новая сварка). */
 } control_state_t;
 
 /**
@@ -132,6 +208,54 @@ void control_init(control_ctx_t *ctx, const control_cfg_t *cfg);
  */
 void control_slow_step(control_ctx_t *ctx, const control_cmd_t *cmd);
 
+/**
+ * @brief Сбросить набор динамических пределов (без ограничений: ±INFINITY, источников нет).
+ * @param limits Указатель на набор пределов.
+ * @return None.
+ */
+void control_limits_reset(control_limits_t *limits);
+
+/**
+ * @brief Сузить верхний предел `u` от защиты.
+ * @param limits Указатель на набор пределов.
+ * @param u_max Предел защиты, [отн. ед.].
+ * @param src Источник (control_limit_src_t).
+ * @return None.
+ * @details Предел принимается, если он строже текущего; при равенстве источники объединяются.
+ *          NaN сохраняется (детектируется в шаге как CONTROL_FLAG_NUM_INVALID).
+ * @note Шаг отвергает набор (CONTROL_FLAG_NUM_INVALID, u = 0), если предел не конечен (кроме "без предела":
+ *       u_max = +INFINITY, u_min = -INFINITY) или u_min > u_max.
+ */
+void control_limits_tighten_max(control_limits_t *limits, float u_max, uint32_t src);
+
+/**
+ * @brief Сузить нижний предел `u` от защиты.
+ * @param limits Указатель на набор пределов.
+ * @param u_min Предел защиты, [отн. ед.].
+ * @param src Источник (control_limit_src_t).
+ * @return None.
+ */
+void control_limits_tighten_min(control_limits_t *limits, float u_min, uint32_t src);
+
+/**
+ * @brief Опубликовать динамические пределы для следующего control_fast_step() (double-buffer).
+ * @param ctx Указатель на контекст.
+ * @param limits Набор пределов (NULL — снять динамические пределы).
+ * @return None.
+ * @note Пределы действуют до следующей публикации; одна публикация на период от одного писателя.
+ */
+void control_set_limits(control_ctx_t *ctx, const control_limits_t *limits);
+
+/**
+ * @brief Опубликовать коэффициенты PI и оценку R для следующего control_fast_step() (меняются атомарно).
+ * @param ctx Указатель на контекст.
+ * @param gains Коэффициенты и оценка R (NULL — kp/ki из control_cfg_t, feedforward без оценки R).
+ * @return None.
+ * @details Интегратор хранится в единицах u, поэтому смена ki не даёт скачка выхода;
+ *          невалидные (отрицательные/NaN) коэффициенты игнорируются шагом (действуют cfg).
+ */
+void control_set_gains(control_ctx_t *ctx, const control_gains_t *gains);
+
 /**
  * @brief Выполнить детерминированный шаг управления в fast-домене (PWM).
  * @param ctx Указатель на контекст.
@@ -147,7 +271,16 @@ void control_slow_step(control_ctx_t *ctx, const control_cmd_t *cmd);
  * 1) снапшот команды + базовая валидация/deny-by-default;
  * 2) conditioning уставки (`clamp` + `slew-rate`);
  * 3) gating по разрешениям/валидности измерений;
- * 4) PI + anti-windup + лимиты + диагностика.
+ * 4) feedforward (опц., DN-001 §4.2): `u_ff = I_ref_used · R_est · n_tr / Udc`, R_est — RLS-оценка control_adapt
+ *    (`control_gains_t.r_load`, control_set_gains()); без опубликованной оценки вклад 0;
+ *    вклад ограничивается (`ff_u_max`, u_max) раньше PI и обнуляется при Udc < Udc_crit;
+ * 5) PI + anti-windup + лимиты + диагностика; пределы `u` = пересечение control_cfg_t и control_set_limits()
+ *    (anti-windup работает по более строгому пределу, источник зажатия — в `out->limit_src`);
+ *    интегратор ограничивается так, чтобы `u_ff + u_i` оставалось в пределах.
+ * Внешний контур (до conditioning уставки, O(1), один `sqrtf` на период):
+ * - энергия сварки `E += P_per·dt` с фронта `enable_cmd` (смена режима не сбрасывает); CE: `E >= E_ref` ⇒ отсечка;
+ * - CP: `I* = I_per·sqrt(P_ref/P_per)`, CV: `I* = I_per·U_ref/U_per` (= sqrt(P_ref/R), U_ref/R без оценки R);
+ *   `I_ref += outer_gain·(I* - I_ref)`, ограничение `[0, i_ref_cmd]`; при `I_per < outer_i_min` — `outer_i_start`.
  */
 void control_fast_step(control_ctx_t *ctx, const control_meas_t *meas, bool allow, control_out_t *out);
 
@@ -0,0 +1,154 @@
+#include "control_program.h"
+
+#include <math.h>
+#include <stddef.h>
+
+/**
+ * @brief Признак токового сегмента.
+ * @param kind Тип сегмента.
+ * @return true для UPSLOPE/WELD/DOWNSLOPE.
+ */
+static bool control_program_is_current(uint8_t kind)
+{
+  return (kind == (uint8_t)CONTROL_PROGRAM_SEG_UPSLOPE) || (kind == (uint8_t)CONTROL_PROGRAM_SEG_WELD) ||
+         (kind == (uint8_t)CONTROL_PROGRAM_SEG_DOWNSLOPE);
+}
+
+/**
+ * @brief Длительность сегмента с учётом пульсации.
+ * @param seg Сегмент.
+ * @return `pulses·periods + (pulses-1)·cool_periods`, [периоды PWM].
+ */
+static uint32_t control_program_seg_len(const control_program_seg_t *seg)
+{
+  const uint32_t pulses = seg->pulses;
+  return (pulses * (uint32_t)seg->periods) + ((pulses - 1u) * (uint32_t)seg->cool_periods);
+}
+
+/**
+ * @brief Проверить таблицу.
+ * @param table Таблица.
+ * @return true, если таблица валидна.
+ */
+static bool control_program_table_valid(const control_program_table_t *table)
+{
+  if ((table == NULL) || (table->count == 0u) || (table->count > CONTROL_PROGRAM_SEG_MAX))
+  {
+    return false;
+  }
+  for (uint32_t i = 0u; i < table->count; ++i)
+  {
+    const control_program_seg_t *seg = &table->seg[i];
+    if ((seg->kind >= (uint8_t)CONTROL_PROGRAM_SEG_COUNT) || (seg->pulses == 0u) || (seg->periods == 0u) ||
+        (seg->u_max_pm > CONTROL_PROGRAM_U_MAX_PM))
+    {
+      return false;
+    }
+    if (!control_program_is_current(seg->kind) && ((seg->i_start_a != 0u) || (seg->i_end_a != 0u)))
+    {
+      return false;
+    }
+  }
+  /* Суммарная длительность: не более 16 · (255 · 65535 · 2) < 2^31 — переполнения u32 нет. */
+  return true;
+}
+
+bool control_program_load(control_program_t *prog, const control_program_table_t *table)
+{
+  const control_program_t zero = {0};
+  *prog = zero;
+  prog->table_valid = control_program_table_valid(table);
+  if (prog->table_valid)
+  {
+    prog->table = *table;
+    for (uint32_t i = 0u; i < table->count; ++i)
+    {
+      prog->total_periods += control_program_seg_len(&table->seg[i]);
+    }
+  }
+  return prog->table_valid;
+}
+
+bool control_program_start(control_program_t *prog, uint32_t fast_seq0)
+{
+  if (!prog->table_valid)
+  {
+    return false;
+  }
+  prog->fast_seq0 = fast_seq0;
+  prog->seg_idx = 0u;
+  prog->seg_start = 0u;
+  prog->running = true;
+  prog->done = false;
+  ++prog->cnt_runs;
+  return true;
+}
+
+void control_program_abort(control_program_t *prog)
+{
+  prog->cnt_aborts += (uint32_t)prog->running;
+  prog->running = false;
+}
+
+void control_program_step(control_program_t *prog, uint32_t fast_seq, control_program_out_t *out)
+{
+  const control_program_out_t idle = {.i_ref_a = 0.0f, .u_max = INFINITY, .done = prog->done};
+  *out = idle;
+  if (!prog->running)
+  {
+    return;
+  }
+
+  // Шаг 1: Смещение от старта по номеру периода (wrap-around u32); до старта — ток 0.
+  const uint32_t offset = fast_seq - prog->fast_seq0; /* [периоды PWM] */
+  out->running = true;
+  if ((int32_t)offset < 0)
+  {
+    return;
+  }
+  out->offset = offset;
+  if (offset >= prog->total_periods)
+  {
+    prog->running = false;
+    prog->done = true;
+    out->running = false;
+    out->done = true;
+    return;
+  }
+
+  // Шаг 2: Курсор сегмента (назад — пересчёт с начала; вперёд — не более count шагов).
+  if (offset < prog->seg_start)
+  {
+    prog->seg_idx = 0u;
+    prog->seg_start = 0u;
+  }
+  uint32_t seg_len = control_program_seg_len(&prog->table.seg[prog->seg_idx]);
+  while ((offset - prog->seg_start) >= seg_len)
+  {
+    prog->seg_start += seg_len;
+    prog->seg_idx++;
+    seg_len = control_program_seg_len(&prog->table.seg[prog->seg_idx]);
+  }
+
+  // Шаг 3: Импульс/пауза внутри сегмента — в целых периодах; значение рампы — линейная интерполяция во float
+  // (frac = (k+1)/periods, последняя точка рампы = i_end точно).
+  const control_program_seg_t *seg = &prog->table.seg[prog->seg_idx];
+  const uint32_t local = offset - prog->seg_start; /* [периоды PWM] */
+  const uint32_t pulse_len = (uint32_t)seg->periods + (uint32_t)seg->cool_periods; /* [периоды PWM] */
+  const uint32_t pulse_idx = local / pulse_len; /* [-] */
+  const uint32_t within = local - (pulse_idx * pulse_len); /* [периоды PWM] */
+  const bool on = control_program_is_current(seg->kind) && (within < seg->periods);
+
+  out->seg_idx = (uint8_t)prog->seg_idx;
+  out->seg_kind = seg->kind;
+  out->pulse_idx = (uint8_t)pulse_idx;
+  out->enable = on;
+  out->u_max = (seg->u_max_pm != 0u) ? ((float)seg->u_max_pm / (float)CONTROL_PROGRAM_U_MAX_PM) : INFINITY;
+  if (on)
+  {
+    const float frac = (float)(within + 1u) / (float)seg->periods; /* (0..1], [-] */
+    const float i_start = (float)seg->i_start_a; /* [A] */
+    const float i_end = (float)seg->i_end_a; /* [A] */
+    out->i_ref_a = i_start + ((i_end - i_start) * frac);
+  }
+}
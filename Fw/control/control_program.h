@@ -0,0 +1,139 @@
+#ifndef CONTROL_PROGRAM_H
+#define CONTROL_PROGRAM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file control_program.h
+ * @brief Программа сварки на борту: сегменты squeeze/upslope/weld/downslope/hold с пульсацией и пределами.
+ * @details
+ * Домен: slow (1 мс) или fast (PWM); вызов не чаще одного раза на период PWM, O(CONTROL_PROGRAM_SEG_MAX) в
+ * худшем случае (пропуск нескольких сегментов), O(1) в установившемся режиме, без float-накопления.
+ *
+ * Уставка — чистая функция номера периода PWM: `offset = fast_seq - fast_seq0` (wrap-around u32 допустим).
+ * Поэтому форма профиля не зависит от каденции/джиттера команд ТК (250 мкс) и от момента вызова в slow-домене:
+ * вызывающий передаёт `fast_seq` периода, для которого публикуется уставка (обычно текущий `fast_seq + 1`),
+ * и результат подаётся в control_core через control_slow_step() (command latch) и
+ * `control_limits_tighten_max(..., CONTROL_LIMIT_SRC_PROGRAM)` + control_set_limits().
+ *
+ * Таблица компактная (12 байт на сегмент, токи — целые амперы, предел `u` — промилле). Сегмент выполняется
+ * `pulses` раз: `periods` периодов тока (линейная рампа `i_start → i_end`, последняя точка = `i_end`),
+ * затем `cool_periods` периодов паузы (ток 0) между импульсами. Сегменты SQUEEZE/HOLD/COOL тока не дают
+ * (усилие электродов/охлаждение — за пределами ядра), их токи обязаны быть 0.
+ *
+ * Программа не принимает решений о fault: `enable` сегмента объединяется вызывающим с разрешением
+ * `state_machine`/`safety_supervisor`; при запрете программа прерывается control_program_abort().
+ */
+
+#define CONTROL_PROGRAM_SEG_MAX (16u) /**< Максимум сегментов программы, [шт]. */
+#define CONTROL_PROGRAM_U_MAX_PM (1000u) /**< Предел u = 1.0 в промилле, [‰]. */
+
+/**
+ * @brief Тип сегмента.
+ */
+typedef enum {
+  CONTROL_PROGRAM_SEG_SQUEEZE = 0u, /**< Сжатие электродов, тока нет. */
+  CONTROL_PROGRAM_SEG_UPSLOPE = 1u, /**< Нарастание тока. */
+  CONTROL_PROGRAM_SEG_WELD = 2u, /**< Сварка (постоянный ток или рампа). */
+  CONTROL_PROGRAM_SEG_DOWNSLOPE = 3u, /**< Спад тока. */
+  CONTROL_PROGRAM_SEG_HOLD = 4u, /**< Проковка/удержание, тока нет. */
+  CONTROL_PROGRAM_SEG_COOL = 5u, /**< Пауза между импульсами программы, тока нет. */
+  CONTROL_PROGRAM_SEG_COUNT
+} control_program_seg_kind_t;
+
+/**
+ * @brief Сегмент программы (компактная запись таблицы).
+ */
+typedef struct {
+  uint8_t kind; /**< Тип сегмента (control_program_seg_kind_t), [-]. */
+  uint8_t pulses; /**< Количество импульсов (пульсация), >= 1, [шт]. */
+  uint16_t periods; /**< Длительность импульса, >= 1, [периоды PWM]. */
+  uint16_t cool_periods; /**< Пауза между импульсами сегмента, [периоды PWM]. */
+  uint16_t i_start_a; /**< Ток в начале рампы, [A]. */
+  uint16_t i_end_a; /**< Ток в конце рампы, [A]. */
+  uint16_t u_max_pm; /**< Предел u на сегменте (0 — без предела), [‰]. */
+} control_program_seg_t;
+
+/**
+ * @brief Таблица программы.
+ */
+typedef struct {
+  control_program_seg_t seg[CONTROL_PROGRAM_SEG_MAX]; /**< Сегменты в порядке выполнения. */
+  uint32_t count; /**< Количество сегментов, [шт]. */
+} control_program_table_t;
+
+/**
+ * @brief Выход шага программы (уставка на период `fast_seq`).
+ */
+typedef struct {
+  float i_ref_a; /**< Уставка тока, [A]. */
+  float u_max; /**< Предел u сегмента (INFINITY — без предела), [отн. ед.]. */
+  bool enable; /**< Сегмент токовый и идёт импульс (не пауза). */
+  bool running; /**< Программа выполняется. */
+  bool done; /**< Программа завершена (последний сегмент пройден). */
+  uint8_t seg_idx; /**< Индекс текущего сегмента, [-]. */
+  uint8_t seg_kind; /**< Тип текущего сегмента (control_program_seg_kind_t), [-]. */
+  uint8_t pulse_idx; /**< Номер импульса в сегменте, [-]. */
+  uint32_t offset; /**< Периодов от старта, [периоды PWM]. */
+} control_program_out_t;
+
+/**
+ * @brief Состояние исполнителя программы.
+ */
+typedef struct {
+  control_program_table_t table; /**< Загруженная таблица. */
+  bool table_valid; /**< Признак валидной таблицы. */
+  bool running; /**< Программа запущена. */
+  bool done; /**< Программа завершена. */
+  uint32_t fast_seq0; /**< `fast_seq` первого периода программы, [-]. */
+  uint32_t seg_idx; /**< Курсор: текущий сегмент, [-]. */
+  uint32_t seg_start; /**< Курсор: смещение начала текущего сегмента, [периоды PWM]. */
+  uint32_t total_periods; /**< Длительность программы, [периоды PWM]. */
+  uint32_t cnt_runs; /**< Запусков, [шт]. */
+  uint32_t cnt_aborts; /**< Прерываний, [шт]. */
+} control_program_t;
+
+/**
+ * @brief Инициализировать исполнитель и загрузить таблицу (только вне сварки).
+ * @param prog Состояние.
+ * @param table Таблица (копируется).
+ * @return false при невалидной таблице (тогда старт запрещён).
+ */
+bool control_program_load(control_program_t *prog, const control_program_table_t *table);
+
+/**
+ * @brief Запустить программу с периода `fast_seq0`.
+ * @param prog Состояние.
+ * @param fast_seq0 Номер периода PWM, с которого начинается первый сегмент, [-].
+ * @return false, если таблица невалидна.
+ */
+bool control_program_start(control_program_t *prog, uint32_t fast_seq0);
+
+/**
+ * @brief Прервать программу (запрет сварки/fault/IDLE); следующий шаг выдаёт ток 0, enable=false.
+ * @param prog Состояние.
+ * @return None.
+ */
+void control_program_abort(control_program_t *prog);
+
+/**
+ * @brief Вычислить уставку на период `fast_seq`.
+ * @param prog Состояние.
+ * @param fast_seq Номер периода PWM, для которого публикуется уставка, [-].
+ * @param out Выход.
+ * @return None.
+ * @note Пропуск периодов допустим (курсор догоняет за ≤ CONTROL_PROGRAM_SEG_MAX шагов); `fast_seq` раньше
+ *       старта (знаковая разность < 0) ⇒ ток 0, enable=false.
+ */
+void control_program_step(control_program_t *prog, uint32_t fast_seq, control_program_out_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONTROL_PROGRAM_H */
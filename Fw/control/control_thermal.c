@@ -0,0 +1,187 @@
+#include "control_thermal.h"
+
+#include <math.h>
+#include <stddef.h>
+
+/**
+ * @brief Допустимый ток по допустимым потерям: корень `A2·I² + A1·I = P` (устойчивая форма без вычитания).
+ * @param p_allow Допустимые потери, [Вт].
+ * @param a1 Линейный коэффициент потерь, [Вт/A].
+ * @param a2 Квадратичный коэффициент потерь, [Вт/A²].
+ * @param i_max Предел без дерейтинга, [A].
+ * @return Допустимый ток, [0..i_max], [A].
+ */
+static float control_thermal_i_allow(float p_allow, float a1, float a2, float i_max)
+{
+  if (!(p_allow > 0.0f))
+  {
+    return 0.0f;
+  }
+  const float den = a1 + sqrtf((a1 * a1) + (4.0f * a2 * p_allow));
+  if (!(den > 0.0f))
+  {
+    return i_max;
+  }
+  const float i = (2.0f * p_allow) / den;
+  return (i < i_max) ? i : i_max;
+}
+
+bool control_thermal_init(control_thermal_t *th, const control_thermal_cfg_t *cfg)
+{
+  const control_thermal_t zero = {0};
+  *th = zero;
+
+  bool valid = (cfg != NULL) && (cfg->dt_s > 0.0f) && (cfg->n_stages >= 1u) &&
+               (cfg->n_stages <= CONTROL_THERMAL_STAGES_MAX) && (cfg->ntc_r_k_w >= 0.0f) && (cfg->ntc_tau_s > 0.0f) &&
+               (cfg->k_i > 0.0f) && (cfg->v_ce0_v >= 0.0f) && (cfg->r_ce_ohm >= 0.0f) && (cfg->e_sw_j_per_a >= 0.0f) &&
+               (cfg->f_pwm_hz > 0.0f) && (cfg->t_margin_c >= 0.0f) && (cfg->horizon_s >= 0.0f) &&
+               (cfg->i_max_a > 0.0f) && (cfg->i_rise_a_per_s > 0.0f) && isfinite(cfg->t_trip_c);
+  for (uint32_t i = 0u; valid && (i < cfg->n_stages); ++i)
+  {
+    valid = (cfg->r_k_w[i] >= 0.0f) && (cfg->tau_s[i] > 0.0f);
+  }
+  if (!valid)
+  {
+    return false;
+  }
+
+  // Коэффициенты дискретизации и прогноза считаются один раз (в тике — только умножения).
+  th->cfg = *cfg;
+  th->b_n = expf(-cfg->horizon_s / cfg->ntc_tau_s);
+  th->r_pred = (1.0f - th->b_n) * cfg->ntc_r_k_w;
+  for (uint32_t i = 0u; i < cfg->n_stages; ++i)
+  {
+    th->a[i] = expf(-cfg->dt_s / cfg->tau_s[i]);
+    th->b[i] = expf(-cfg->horizon_s / cfg->tau_s[i]);
+    th->r_pred += (1.0f - th->b[i]) * cfg->r_k_w[i];
+  }
+  th->i_limit_a = cfg->i_max_a;
+  th->cfg_valid = true;
+  return true;
+}
+
+void control_thermal_step(control_thermal_t *th, const control_thermal_in_t *in, control_thermal_out_t *out)
+{
+  const control_thermal_out_t out_zero = {0};
+  *out = out_zero;
+
+  bool inputs_ok = isfinite(in->i_per_a) && isfinite(in->duty) && isfinite(in->t_amb_c);
+  for (uint32_t m = 0u; m < CONTROL_THERMAL_MODULES; ++m)
+  {
+    inputs_ok = inputs_ok && isfinite(in->t_ntc_c[m]);
+  }
+  if (!th->cfg_valid || !inputs_ok)
+  {
+    // SAFETY: без модели или датчиков допустимый ток неизвестен ⇒ предел 0 (OVERTEMP/датчики решает supervisor).
+    th->i_limit_a = 0.0f;
+    out->sensor_invalid = th->cfg_valid;
+    out->limit_active = true;
+    return;
+  }
+
+  const control_thermal_cfg_t *cfg = &th->cfg;
+  const uint32_t ns = cfg->n_stages;
+
+  // Шаг 1: Потери модуля (проводимость ∝ d, коммутация ∝ I).
+  const float d = (in->duty < 0.0f) ? 0.0f : ((in->duty > 1.0f) ? 1.0f : in->duty);
+  const float a1 = cfg->k_i * ((d * cfg->v_ce0_v) + (cfg->f_pwm_hz * cfg->e_sw_j_per_a)); /* [Вт/A] */
+  const float a2 = d * cfg->r_ce_ohm * cfg->k_i * cfg->k_i; /* [Вт/A²] */
+  const float i_abs = fabsf(in->i_per_a); /* [A] */
+  const float p = (a1 * i_abs) + (a2 * i_abs * i_abs); /* [Вт] */
+  out->p_module_w = p;
+
+  // Шаг 2: Звенья Фостера, Tj и допустимый ток по прогнозу каждого модуля.
+  const float t_lim = cfg->t_trip_c - cfg->t_margin_c; /* [°C] */
+  float i_target = cfg->i_max_a; /* [A] */
+  out->tj_pred_max_c = -INFINITY;
+  for (uint32_t m = 0u; m < CONTROL_THERMAL_MODULES; ++m)
+  {
+    float sum_now = 0.0f; /* [К] */
+    float sum_free = 0.0f; /* свободная составляющая прогноза, [К] */
+    for (uint32_t i = 0u; i < ns; ++i)
+    {
+      float *dts = &th->dt_stage[m][i];
+      *dts = (th->a[i] * *dts) + ((1.0f - th->a[i]) * cfg->r_k_w[i] * p);
+      sum_now += *dts;
+      sum_free += th->b[i] * *dts;
+    }
+    const float rise_ntc = in->t_ntc_c[m] - in->t_amb_c; /* [К] */
+    const float t_free = in->t_amb_c + (th->b_n * rise_ntc) + sum_free; /* Tj(t+H) при P = 0, [°C] */
+    const float tj_pred = t_free + (th->r_pred * p); /* [°C] */
+    out->tj_c[m] = in->t_ntc_c[m] + sum_now;
+    out->tj_pred_max_c = (tj_pred > out->tj_pred_max_c) ? tj_pred : out->tj_pred_max_c;
+
+    const float p_allow = (th->r_pred > 0.0f) ? ((t_lim - t_free) / th->r_pred) : INFINITY; /* [Вт] */
+    const float i_m = control_thermal_i_allow(p_allow, a1, a2, cfg->i_max_a);
+    i_target = (i_m < i_target) ? i_m : i_target;
+  }
+
+  // Шаг 3: Предел снижается сразу, растёт с ограниченной скоростью.
+  const float i_rise = th->i_limit_a + (cfg->i_rise_a_per_s * cfg->dt_s); /* [A] */
+  th->i_limit_a = (i_target < th->i_limit_a) ? i_target : ((i_target < i_rise) ? i_target : i_rise);
+  out->i_limit_a = th->i_limit_a;
+  out->limit_active = th->i_limit_a < cfg->i_max_a;
+  th->cnt_limit_ticks += (uint32_t)out->limit_active;
+}
+
+bool control_thermal_clamp_cmd(const control_thermal_t *th, control_cmd_t *cmd)
+{
+  if (!(cmd->i_ref_cmd > th->i_limit_a))
+  {
+    return false;
+  }
+  cmd->i_ref_cmd = th->i_limit_a;
+  return true;
+}
+
+bool control_thermal_tighten(const control_thermal_t *th, control_limits_t *limits, float u_used, float i_per_a)
+{
+  const float i_abs = fabsf(i_per_a); /* [A] */
+  if (!(i_abs > th->i_limit_a) || !isfinite(u_used))
+  {
+    return false;
+  }
+  control_limits_tighten_max(limits, fabsf(u_used) * (th->i_limit_a / i_abs), CONTROL_LIMIT_SRC_THERMAL);
+  return true;
+}
+
+void control_thermal_fit_reset(control_thermal_fit_t *fit)
+{
+  const control_thermal_fit_t zero = {0};
+  *fit = zero;
+}
+
+void control_thermal_fit_add(control_thermal_fit_t *fit, float y, float p_w, float y_next)
+{
+  if (!isfinite(y) || !isfinite(p_w) || !isfinite(y_next))
+  {
+    return;
+  }
+  const double yd = (double)y;
+  const double pd = (double)p_w;
+  fit->s_yy += yd * yd;
+  fit->s_yp += yd * pd;
+  fit->s_pp += pd * pd;
+  fit->s_y1y += (double)y_next * yd;
+  fit->s_y1p += (double)y_next * pd;
+  fit->n++;
+}
+
+bool control_thermal_fit_solve(const control_thermal_fit_t *fit, float dt_s, float *r_k_w, float *tau_s)
+{
+  // Нормальные уравнения 2×2: [s_yy s_yp; s_yp s_pp]·[a; c] = [s_y1y; s_y1p].
+  const double det = (fit->s_yy * fit->s_pp) - (fit->s_yp * fit->s_yp);
+  if ((fit->n < 2u) || !(dt_s > 0.0f) || !(fabs(det) > (1e-12 * fit->s_yy * fit->s_pp)))
+  {
+    return false;
+  }
+  const double a = ((fit->s_y1y * fit->s_pp) - (fit->s_yp * fit->s_y1p)) / det;
+  const double c = ((fit->s_yy * fit->s_y1p) - (fit->s_yp * fit->s_y1y)) / det;
+  if (!(a > 0.0) || !(a < 1.0) || !(c > 0.0))
+  {
+    return false;
+  }
+  *tau_s = (float)(-(double)dt_s / log(a));
+  *r_k_w = (float)(c / (1.0 - a));
+  return true;
+}
@@ -0,0 +1,179 @@
+#ifndef CONTROL_THERMAL_H
+#define CONTROL_THERMAL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "control_core.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file control_thermal.h
+ * @brief Тепловая модель SEMiX252GB12 (4 модуля) и предиктивный дерейтинг тока до срабатывания OVERTEMP.
+ * @details
+ * Домен: slow (тик `dt_s`, обычно 1 мс — отсчёты AD7606 #2), O(модули·звенья), без буферов истории.
+ *
+ * Модель модуля (температура кристалла над NTC + NTC над воздухом в корпусе):
+ * - потери модуля `P = d·(V_ce0·I_m + r_ce·I_m²) + f_pwm·e_sw·I_m`, `I_m = k_i·|I_per|` — проводимость
+ *   (пропорционально скважности) + коммутация (энергия, линейная по току);
+ * - `Tj = T_ntc + Σ ΔT_i`, звенья Фостера `ΔT_i ← a_i·ΔT_i + (1-a_i)·R_i·P`, `a_i = e^{-dt/τ_i}` (Zth j→NTC
+ *   из datasheet) — NTC видит нагрев с запаздыванием, модель восполняет быстрые звенья;
+ * - NTC над воздухом в корпусе — одно звено `R_n, τ_n` (калибруется по логам, см. control_thermal_fit_*).
+ *
+ * Прогноз на горизонт `H` при постоянных потерях линеен по P:
+ * `Tj(t+H) = T_amb + (T_ntc - T_amb)·b_n + (1-b_n)·R_n·P + Σ[ΔT_i·b_i + (1-b_i)·R_i·P]`, `b = e^{-H/τ}`,
+ * отсюда допустимые потери `P_allow`, при которых `Tj(t+H) <= t_trip_c - t_margin_c`, и допустимый ток
+ * (корень квадратного уравнения потерь). Предел тока — минимум по модулям; снижается сразу, растёт с
+ * ограниченной скоростью (без автоколебаний на границе).
+ *
+ * Выход — динамический предел тока `i_limit_a`: в уставку через control_thermal_clamp_cmd() и/или в пределы
+ * `u` через control_thermal_tighten() (`CONTROL_LIMIT_SRC_THERMAL`; вызывающий выставляет `SAFETY_LIMIT_THERMAL`
+ * при `limit_active`). Решение об OVERTEMP принимает safety_supervisor по измерениям — модель его не подменяет.
+ */
+
+#define CONTROL_THERMAL_MODULES (4u) /**< Силовых модулей SEMiX252GB12, [шт]. */
+#define CONTROL_THERMAL_STAGES_MAX (4u) /**< Максимум звеньев Фостера j→NTC, [шт]. */
+
+/**
+ * @brief Конфигурация модели.
+ */
+typedef struct {
+  float dt_s; /**< Период тика, [с]. */
+  uint8_t n_stages; /**< Звеньев Фостера (1…CONTROL_THERMAL_STAGES_MAX), [шт]. */
+  float r_k_w[CONTROL_THERMAL_STAGES_MAX]; /**< R_i звеньев j→NTC, [К/Вт]. */
+  float tau_s[CONTROL_THERMAL_STAGES_MAX]; /**< τ_i звеньев j→NTC, [с]. */
+  float ntc_r_k_w; /**< R_n звена NTC→воздух в корпусе, [К/Вт]. */
+  float ntc_tau_s; /**< τ_n звена NTC→воздух в корпусе, [с]. */
+  float k_i; /**< Ток модуля на ампер `I_per` (1/N_tr · доля тока), [A/A]. */
+  float v_ce0_v; /**< Пороговое напряжение (IGBT + диод, эквивалент), [В]. */
+  float r_ce_ohm; /**< Дифференциальное сопротивление, [Ом]. */
+  float e_sw_j_per_a; /**< Энергия коммутации на ампер (E_on + E_off + E_rr), [Дж/A]. */
+  float f_pwm_hz; /**< Частота PWM, [Гц]. */
+  float t_trip_c; /**< Порог OVERTEMP (Tj), [°C]. */
+  float t_margin_c; /**< Запас дерейтинга до порога, [°C]. */
+  float horizon_s; /**< Горизонт прогноза, [с]. */
+  float i_max_a; /**< Предел тока без дерейтинга, [A]. */
+  float i_rise_a_per_s; /**< Скорость роста предела при остывании, [A/с]. */
+} control_thermal_cfg_t;
+
+/**
+ * @brief Вход тика (средние за тик).
+ */
+typedef struct {
+  float i_per_a; /**< Средний ток сварки (вторичка), [A]. */
+  float duty; /**< Средняя нормированная скважность, [0..1]. */
+  float t_ntc_c[CONTROL_THERMAL_MODULES]; /**< Температуры NTC модулей, [°C]. */
+  float t_amb_c; /**< Температура воздуха в корпусе, [°C]. */
+} control_thermal_in_t;
+
+/**
+ * @brief Выход тика.
+ */
+typedef struct {
+  float p_module_w; /**< Потери одного модуля, [Вт]. */
+  float tj_c[CONTROL_THERMAL_MODULES]; /**< Оценка Tj модулей сейчас, [°C]. */
+  float tj_pred_max_c; /**< Максимум прогноза Tj на горизонте при текущих потерях, [°C]. */
+  float i_limit_a; /**< Динамический предел тока, [A]. */
+  bool limit_active; /**< Предел ниже i_max_a (LIMIT THERMAL). */
+  bool sensor_invalid; /**< NaN/Inf во входах ⇒ i_limit_a = 0 (fail-safe). */
+} control_thermal_out_t;
+
+/**
+ * @brief Состояние модели.
+ */
+typedef struct {
+  control_thermal_cfg_t cfg; /**< Конфигурация. */
+  bool cfg_valid; /**< Признак валидности конфигурации. */
+  float a[CONTROL_THERMAL_STAGES_MAX]; /**< e^{-dt/τ_i}, [-]. */
+  float b[CONTROL_THERMAL_STAGES_MAX]; /**< e^{-H/τ_i}, [-]. */
+  float b_n; /**< e^{-H/τ_n}, [-]. */
+  float r_pred; /**< (1-b_n)·R_n + Σ(1-b_i)·R_i — чувствительность прогноза к P, [К/Вт]. */
+  float dt_stage[CONTROL_THERMAL_MODULES][CONTROL_THERMAL_STAGES_MAX]; /**< ΔT_i, [К]. */
+  float i_limit_a; /**< Текущий предел тока, [A]. */
+  uint32_t cnt_limit_ticks; /**< Тиков с активным пределом, [шт]. */
+} control_thermal_t;
+
+/**
+ * @brief Накопитель МНК для калибровки звена NTC→воздух по логам.
+ * @details Модель `y[k+1] = a·y[k] + c·P[k]`, `y = T_ntc - T_amb`; `τ_n = -dt/ln a`, `R_n = c/(1-a)`.
+ *          Суммы в double: калибровка выполняется вне fast/slow-доменов (сервис/host).
+ */
+typedef struct {
+  double s_yy; /**< Σ y[k]², [К²]. */
+  double s_yp; /**< Σ y[k]·P[k], [К·Вт]. */
+  double s_pp; /**< Σ P[k]², [Вт²]. */
+  double s_y1y; /**< Σ y[k+1]·y[k], [К²]. */
+  double s_y1p; /**< Σ y[k+1]·P[k], [К·Вт]. */
+  uint32_t n; /**< Пар отсчётов, [шт]. */
+} control_thermal_fit_t;
+
+/**
+ * @brief Инициализировать модель (ΔT_i = 0, предел = i_max_a).
+ * @param th Состояние.
+ * @param cfg Конфигурация.
+ * @return false при невалидной конфигурации (тогда тик выдаёт i_limit_a = 0 — fail-safe).
+ */
+bool control_thermal_init(control_thermal_t *th, const control_thermal_cfg_t *cfg);
+
+/**
+ * @brief Тик модели: потери, Tj, прогноз, предел тока.
+ * @param th Состояние.
+ * @param in Вход.
+ * @param out Выход.
+ * @return None.
+ */
+void control_thermal_step(control_thermal_t *th, const control_thermal_in_t *in, control_thermal_out_t *out);
+
+/**
+ * @brief Ограничить команду тока пределом модели (`i_ref_cmd = min(i_ref_cmd, i_limit_a)`; в CP/CV — потолок).
+ * @param th Состояние.
+ * @param cmd Команда (slow-домен, до control_slow_step()).
+ * @return true, если команда была ограничена.
+ */
+bool control_thermal_clamp_cmd(const control_thermal_t *th, control_cmd_t *cmd);
+
+/**
+ * @brief Сузить верхний предел `u` пропорционально `i_limit/I_per` (нагрузка ~ линейна по u).
+ * @param th Состояние.
+ * @param limits Набор пределов (до control_set_limits()).
+ * @param u_used Последнее применённое u, [отн. ед.].
+ * @param i_per_a Последний ток, [A].
+ * @return true, если предел сужен.
+ */
+bool control_thermal_tighten(const control_thermal_t *th, control_limits_t *limits, float u_used, float i_per_a);
+
+/**
+ * @brief Сбросить накопитель калибровки.
+ * @param fit Накопитель.
+ * @return None.
+ */
+void control_thermal_fit_reset(control_thermal_fit_t *fit);
+
+/**
+ * @brief Добавить пару отсчётов лога.
+ * @param fit Накопитель.
+ * @param y Превышение NTC над воздухом на шаге k, [К].
+ * @param p_w Потери модуля на шаге k, [Вт].
+ * @param y_next Превышение NTC над воздухом на шаге k+1, [К].
+ * @return None.
+ */
+void control_thermal_fit_add(control_thermal_fit_t *fit, float y, float p_w, float y_next);
+
+/**
+ * @brief Решить МНК и получить параметры звена NTC→воздух.
+ * @param fit Накопитель.
+ * @param dt_s Шаг лога, [с].
+ * @param r_k_w R_n, [К/Вт].
+ * @param tau_s τ_n, [с].
+ * @return false, если система вырождена (нет возбуждения по P) или `a ∉ (0,1)`, `c <= 0`.
+ */
+bool control_thermal_fit_solve(const control_thermal_fit_t *fit, float dt_s, float *r_k_w, float *tau_s);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONTROL_THERMAL_H */
@@ -0,0 +1,112 @@
+#include "control_vs.h"
+
+#include <math.h>
+#include <stddef.h>
+
+#define CONTROL_VS_U_EPS_V (1.0e-3f) /**< Напряжение, ниже которого поток не нарастает, [В]. */
+
+/**
+ * @brief Проверить конфигурацию.
+ * @param cfg Конфигурация.
+ * @return true, если конфигурация валидна.
+ */
+static bool control_vs_cfg_valid(const control_vs_cfg_t *cfg)
+{
+  if ((cfg == NULL) || !isfinite(cfg->t_pwm_s) || !isfinite(cfg->vs_sat) || !isfinite(cfg->vs_margin) ||
+      !isfinite(cfg->bias_tau_s) || !isfinite(cfg->sat_warn_ratio) || !isfinite(cfg->sat_hyst_ratio) ||
+      !isfinite(cfg->bias_max) || !isfinite(cfg->u_max_nominal))
+  {
+    return false;
+  }
+  return (cfg->t_pwm_s > 0.0f) && (cfg->vs_sat > 0.0f) && (cfg->vs_margin > 0.0f) && (cfg->vs_margin <= 1.0f) &&
+         (cfg->bias_tau_s > 0.0f) && (cfg->sat_warn_ratio > 0.0f) && (cfg->sat_hyst_ratio >= 0.0f) &&
+         (cfg->sat_hyst_ratio < cfg->sat_warn_ratio) && (cfg->bias_max > 0.0f) && (cfg->u_max_nominal > 0.0f);
+}
+
+/**
+ * @brief Ограничить значение диапазоном [0, 1].
+ * @param value Значение, [-].
+ * @return Ограниченное значение, [-].
+ */
+static float control_vs_clamp01(float value)
+{
+  value = (value > 0.0f) ? value : 0.0f;
+  return (value < 1.0f) ? value : 1.0f;
+}
+
+bool control_vs_init(control_vs_t *vs, const control_vs_cfg_t *cfg)
+{
+  const control_vs_cfg_t cfg_zero = {0};
+  vs->cfg_valid = control_vs_cfg_valid(cfg);
+  vs->cfg = vs->cfg_valid ? *cfg : cfg_zero;
+  vs->half_t_s = 0.5f * vs->cfg.t_pwm_s;
+  vs->bias_decay = vs->cfg_valid ? expf(-vs->cfg.t_pwm_s / vs->cfg.bias_tau_s) : 0.0f;
+  vs->vs_limit = vs->cfg.vs_sat * vs->cfg.vs_margin;
+  vs->cnt_limit_periods = 0u;
+  vs->cnt_sat_events = 0u;
+  control_vs_reset(vs);
+  return vs->cfg_valid;
+}
+
+void control_vs_reset(control_vs_t *vs)
+{
+  vs->bias = 0.0f;
+  vs->sat_suspected = false;
+}
+
+void control_vs_step(control_vs_t *vs, const control_vs_in_t *in, control_vs_out_t *out)
+{
+  const bool in_valid = isfinite(in->u_pos_v) && isfinite(in->u_neg_v) && isfinite(in->duty_pos) &&
+                        isfinite(in->duty_neg);
+  if (!vs->cfg_valid || !in_valid)
+  {
+    // SAFETY: без достоверной оценки потока скважность запрещается.
+    const control_vs_out_t fail = {.u_max = 0.0f, .limit_active = true, .sat_suspected = true, .bias = vs->bias};
+    *out = fail;
+    return;
+  }
+
+  // Шаг 1: Вольт-секунды полупериодов.
+  const float u_pos = fabsf(in->u_pos_v); /* [В] */
+  const float u_neg = fabsf(in->u_neg_v); /* [В] */
+  const float vs_pos = u_pos * control_vs_clamp01(in->duty_pos) * vs->half_t_s; /* [В·с] */
+  const float vs_neg = u_neg * control_vs_clamp01(in->duty_neg) * vs->half_t_s; /* [В·с] */
+
+  // Шаг 2: DC-подмагничивание: несимметрия периода + затухание (leaky-интегратор, без истории).
+  vs->bias = (vs->bias * vs->bias_decay) + (vs_pos - vs_neg);
+  const float bias_abs = fabsf(vs->bias); /* [В·с] */
+  const float vs_half_max = (vs_pos > vs_neg) ? vs_pos : vs_neg; /* [В·с] */
+  const float phi_peak = bias_abs + (0.5f * vs_half_max); /* [В·с] */
+  const float utilization = phi_peak / vs->cfg.vs_sat; /* [-] */
+
+  // Шаг 3: Предел скважности: |bias| + VS_half/2 <= vs_limit ⇒ d <= 2·(vs_limit - |bias|) / (U·T/2).
+  const float u_half = (u_pos > u_neg) ? u_pos : u_neg; /* [В] */
+  const float headroom = vs->vs_limit - bias_abs; /* [В·с] */
+  float duty_max = 1.0f; /* [-] */
+  if (u_half > CONTROL_VS_U_EPS_V)
+  {
+    duty_max = control_vs_clamp01((2.0f * headroom) / (u_half * vs->half_t_s));
+  }
+  // VS-предел скважности ограничивает номинальный сверху, а не масштабирует его: при duty_max >= u_max_nominal
+  // предел не связывает и LIMIT_BY_VS не выставляется.
+  const float u_max_vs = fminf(duty_max, vs->cfg.u_max_nominal); /* [отн. ед.] */
+
+  // Шаг 4: Признак насыщения с гистерезисом.
+  const bool sat_on = (utilization >= vs->cfg.sat_warn_ratio) || (bias_abs >= vs->cfg.bias_max);
+  const bool sat_off = (utilization < (vs->cfg.sat_warn_ratio - vs->cfg.sat_hyst_ratio)) && (bias_abs < vs->cfg.bias_max);
+  const bool sat_prev = vs->sat_suspected;
+  vs->sat_suspected = sat_on || (sat_prev && !sat_off);
+  vs->cnt_sat_events += (uint32_t)(vs->sat_suspected && !sat_prev);
+
+  const bool limit_active = u_max_vs < vs->cfg.u_max_nominal;
+  vs->cnt_limit_periods += (uint32_t)limit_active;
+
+  out->vs_pos = vs_pos;
+  out->vs_neg = vs_neg;
+  out->bias = vs->bias;
+  out->phi_peak = phi_peak;
+  out->utilization = utilization;
+  out->u_max = u_max_vs;
+  out->limit_active = limit_active;
+  out->sat_suspected = vs->sat_suspected;
+}
@@ -0,0 +1,111 @@
+#ifndef CONTROL_VS_H
+#define CONTROL_VS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file control_vs.h
+ * @brief Оценка вольт-секунд первички MFDC-трансформатора: DC-подмагничивание и предвестник насыщения.
+ * @details
+ * Домен: fast (PWM), один шаг на период, O(1), без буферов истории.
+ * За период мост прикладывает к первичке `+U` в положительном полупериоде и `-U` в отрицательном:
+ * - `VS+ = U+ · d+ · T/2`, `VS- = U- · d- · T/2` — вольт-секунды полупериодов;
+ * - несимметрия `VS+ - VS-` накапливается в DC-составляющей потока (bias) и затухает с постоянной
+ *   `bias_tau` (сопротивление первички / ток намагничивания) — дискретный leaky-интегратор;
+ * - пиковый поток `Φpk ≈ |bias| + max(VS+, VS-)/2` сравнивается с допустимым `vs_sat · vs_margin`.
+ *
+ * Выход — динамический предел `u_max` (скважность, при которой Φpk остаётся в допустимой зоне; подаётся в
+ * control_core через `control_limits_tighten_max(..., CONTROL_LIMIT_SRC_VS)` + control_set_limits()), а также
+ * признаки `LIMIT_BY_VS` (предел уже ниже номинального) и `SATURATION_SUSPECTED` (Φpk близко к насыщению
+ * или bias выходит за допуск). Управляющее воздействие `u` считается нормированной скважностью полупериода
+ * (`u = 1` — полная ширина).
+ */
+
+/**
+ * @brief Конфигурация оценщика.
+ */
+typedef struct {
+  float t_pwm_s; /**< Период PWM, [с]. */
+  float vs_sat; /**< Вольт-секунды до насыщения (амплитуда потока, приведённая к первичке), [В·с]. */
+  float vs_margin; /**< Допустимая доля vs_sat для ограничения скважности, (0..1], [-]. */
+  float bias_tau_s; /**< Постоянная затухания DC-подмагничивания, [с]. */
+  float sat_warn_ratio; /**< Порог Φpk/vs_sat для SATURATION_SUSPECTED, [-]. */
+  float sat_hyst_ratio; /**< Гистерезис снятия SATURATION_SUSPECTED, [-]. */
+  float bias_max; /**< Допуск |bias| для SATURATION_SUSPECTED, [В·с]. */
+  float u_max_nominal; /**< Номинальный верхний предел u (без VS-ограничения), [отн. ед.]. */
+} control_vs_cfg_t;
+
+/**
+ * @brief Вход шага: напряжение и скважности полупериодов за прошедший период.
+ */
+typedef struct {
+  float u_pos_v; /**< Напряжение первички в положительном полупериоде (или `U_per`), [В]. */
+  float u_neg_v; /**< Напряжение первички в отрицательном полупериоде (или `U_per`), [В]. */
+  float duty_pos; /**< Скважность положительного полупериода, [0..1]. */
+  float duty_neg; /**< Скважность отрицательного полупериода, [0..1]. */
+} control_vs_in_t;
+
+/**
+ * @brief Выход шага.
+ */
+typedef struct {
+  float vs_pos; /**< Вольт-секунды положительного полупериода, [В·с]. */
+  float vs_neg; /**< Вольт-секунды отрицательного полупериода, [В·с]. */
+  float bias; /**< Оценка DC-подмагничивания, [В·с]. */
+  float phi_peak; /**< Оценка пикового потока, [В·с]. */
+  float utilization; /**< Φpk / vs_sat, [-]. */
+  float u_max; /**< Динамический верхний предел u для следующего периода, [отн. ед.]. */
+  bool limit_active; /**< LIMIT_BY_VS: u_max ниже номинального. */
+  bool sat_suspected; /**< SATURATION_SUSPECTED. */
+} control_vs_out_t;
+
+/**
+ * @brief Состояние оценщика.
+ */
+typedef struct {
+  control_vs_cfg_t cfg; /**< Конфигурация. */
+  bool cfg_valid; /**< Признак валидности конфигурации. */
+  float half_t_s; /**< T/2, [с]. */
+  float bias_decay; /**< Множитель затухания bias за период, [-]. */
+  float vs_limit; /**< vs_sat · vs_margin, [В·с]. */
+  float bias; /**< DC-подмагничивание, [В·с]. */
+  bool sat_suspected; /**< Состояние признака насыщения (с гистерезисом). */
+  uint32_t cnt_limit_periods; /**< Периодов с активным LIMIT_BY_VS, [шт]. */
+  uint32_t cnt_sat_events; /**< Фронтов SATURATION_SUSPECTED, [шт]. */
+} control_vs_t;
+
+/**
+ * @brief Инициализировать оценщик.
+ * @param vs Состояние.
+ * @param cfg Конфигурация.
+ * @return false при невалидной конфигурации (тогда шаг выдаёт u_max = 0 и sat_suspected — fail-safe).
+ */
+bool control_vs_init(control_vs_t *vs, const control_vs_cfg_t *cfg);
+
+/**
+ * @brief Шаг оценщика за завершившийся период PWM.
+ * @param vs Состояние.
+ * @param in Напряжения и скважности полупериодов.
+ * @param out Выход (u_max — для следующего периода).
+ * @return None.
+ * @note Невалидные (NaN/Inf) входы ⇒ u_max = 0 и sat_suspected (fail-safe), bias не портится.
+ */
+void control_vs_step(control_vs_t *vs, const control_vs_in_t *in, control_vs_out_t *out);
+
+/**
+ * @brief Сбросить накопленный bias (PWM OFF достаточно долго / размагничивание выполнено).
+ * @param vs Состояние.
+ * @return None.
+ */
+void control_vs_reset(control_vs_t *vs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONTROL_VS_H */
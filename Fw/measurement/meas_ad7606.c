@@ -0,0 +1,164 @@
+#include "meas_ad7606.h"
+
+#include <math.h>
+#include <stddef.h>
+
+#define MEAS_AD7606_FRAME_BITS (MEAS_AD7606_CHANNELS * 16u) /**< Бит на кадр (DOUTA), [бит]. */
+
+/**
+ * @brief Время преобразования по коду OS[2:0] (AD7606 datasheet, t_CONV с оверсемплингом), [нс].
+ */
+static const uint32_t k_meas_ad7606_tconv_ns[MEAS_AD7606_OS_MAX + 1u] = {
+  4150u, 9100u, 18800u, 39000u, 78000u, 158000u, 315000u,
+};
+
+/**
+ * @brief Насыщающий инкремент счётчика u16.
+ * @param cnt Счётчик.
+ * @return None.
+ */
+static void meas_ad7606_inc_u16(uint16_t *cnt)
+{
+  *cnt = (uint16_t)(*cnt + (uint16_t)(*cnt != UINT16_MAX));
+}
+
+bool meas_ad7606_plan(const meas_ad7606_cfg_t *cfg, meas_ad7606_plan_t *plan)
+{
+  if ((cfg == NULL) || (cfg->os_ratio_log2 > MEAS_AD7606_OS_MAX) || (cfg->spi_clk_hz == 0u))
+  {
+    return false;
+  }
+
+  // Шаг 1: Длина кадра: преобразование + чтение 8×16 бит + запас.
+  const uint32_t t_conv = k_meas_ad7606_tconv_ns[cfg->os_ratio_log2]; /* [нс] */
+  const uint32_t t_read =
+    (uint32_t)(((uint64_t)MEAS_AD7606_FRAME_BITS * 1000000000u + cfg->spi_clk_hz - 1u) / cfg->spi_clk_hz); /* [нс] */
+  const uint64_t t_need = (uint64_t)t_conv + t_read + MEAS_AD7606_FRAME_GUARD_NS; /* [нс] */
+
+  // Шаг 2: Наибольшее число кадров на 1 мс (степень двойки), при котором кадр помещается в период.
+  for (uint32_t r = MEAS_AD7606_FRAMES_MAX; r >= 1u; r >>= 1)
+  {
+    const uint32_t period = (MEAS_AD7606_OUT_PERIOD_US * 1000u) / r; /* [нс] */
+    if (period >= t_need)
+    {
+      plan->os_pins = cfg->os_ratio_log2;
+      plan->t_conv_ns = t_conv;
+      plan->t_read_ns = t_read;
+      plan->frame_period_ns = period;
+      plan->frames_per_out = (uint16_t)r;
+      plan->dma_len = (uint16_t)(2u * r * MEAS_AD7606_CHANNELS);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool meas_ad7606_init(meas_ad7606_t *dev, const meas_ad7606_cfg_t *cfg, uint32_t now_us)
+{
+  const meas_ad7606_t zero = {0};
+  *dev = zero;
+  dev->last_block_us = now_us;
+
+  bool valid = meas_ad7606_plan(cfg, &dev->plan) && (cfg->stuck_frames >= 2u) && (cfg->timeout_us > 0u);
+  for (uint32_t ch = 0u; valid && (ch < MEAS_AD7606_CHANNELS); ++ch)
+  {
+    valid = isfinite(cfg->gain[ch]) && (cfg->gain[ch] != 0.0f);
+  }
+  if (valid)
+  {
+    dev->cfg = *cfg;
+  }
+  dev->valid = valid;
+  return valid;
+}
+
+bool meas_ad7606_block(meas_ad7606_t *dev, const uint16_t *words, uint32_t frames, uint32_t now_us,
+                       meas_ad7606_out_t *out)
+{
+  const meas_ad7606_out_t out_zero = {0};
+  meas_ad7606_out_t res = out_zero;
+
+  dev->last_block_us = now_us;
+  dev->cnt_blocks++;
+
+  // SAFETY: при невалидной конфигурации отсчёт остаётся нулевым (valid_mask = 0): масштабы/план не определены.
+  if (dev->valid && (frames != dev->plan.frames_per_out))
+  {
+    // SAFETY: блок не той длины — рассинхрон кольца DMA, границы каналов не гарантированы; отсчёт невалиден.
+    res.status = MEAS_AD7606_ST_SHORT;
+    meas_ad7606_inc_u16(&dev->cnt_short);
+    dev->have_last = false;
+  }
+  else if (dev->valid)
+  {
+    int32_t sum[MEAS_AD7606_CHANNELS] = {0};
+    uint32_t good = 0u;
+    const uint16_t stuck_frames = dev->cfg.stuck_frames;
+
+    // Шаг 1: Разбор кадров, диагностика bus/sat/stuck, суммы для децимации.
+    for (uint32_t f = 0u; f < frames; ++f)
+    {
+      const uint16_t *w = &words[f * MEAS_AD7606_CHANNELS];
+      uint16_t w_or = 0u;
+      uint16_t w_and = 0xFFFFu;
+      for (uint32_t ch = 0u; ch < MEAS_AD7606_CHANNELS; ++ch)
+      {
+        w_or = (uint16_t)(w_or | w[ch]);
+        w_and = (uint16_t)(w_and & w[ch]);
+      }
+      if ((w_or == 0u) || (w_and == 0xFFFFu))
+      {
+        res.status = (uint8_t)(res.status | MEAS_AD7606_ST_BUS);
+        meas_ad7606_inc_u16(&dev->cnt_bus);
+        continue;
+      }
+
+      for (uint32_t ch = 0u; ch < MEAS_AD7606_CHANNELS; ++ch)
+      {
+        const int16_t code = (int16_t)w[ch];
+        const bool same = dev->have_last && (code == dev->last_code[ch]);
+        const uint16_t run = same ? dev->same_run[ch] : 0u;
+        dev->same_run[ch] = (uint16_t)(run + (uint16_t)(run < stuck_frames));
+        dev->last_code[ch] = code;
+        sum[ch] += code;
+        res.sat_mask = (uint8_t)(res.sat_mask | (((code == INT16_MIN) || (code == INT16_MAX)) ? (1u << ch) : 0u));
+      }
+      dev->have_last = true;
+      good++;
+    }
+
+    // Шаг 2: Банк децимации (boxcar по блоку) + маски валидности.
+    for (uint32_t ch = 0u; ch < MEAS_AD7606_CHANNELS; ++ch)
+    {
+      res.stuck_mask = (uint8_t)(res.stuck_mask | ((dev->same_run[ch] >= stuck_frames) ? (1u << ch) : 0u));
+      const float mean = (good > 0u) ? ((float)sum[ch] / (float)good) : 0.0f; /* [код] */
+      res.value[ch] = dev->cfg.gain[ch] * (mean - (float)dev->cfg.offset[ch]);
+    }
+    res.valid_mask = (uint8_t)((good > 0u) ? (~(res.stuck_mask | res.sat_mask) & 0xFFu) : 0u);
+    res.status = (uint8_t)(res.status | ((res.stuck_mask != 0u) ? MEAS_AD7606_ST_STUCK : 0u) |
+                           ((res.sat_mask != 0u) ? MEAS_AD7606_ST_SAT : 0u));
+  }
+
+  dev->out = res;
+  if (out != NULL)
+  {
+    *out = res;
+  }
+  return res.valid_mask != 0u;
+}
+
+bool meas_ad7606_poll(meas_ad7606_t *dev, uint32_t now_us)
+{
+  if ((uint32_t)(now_us - dev->last_block_us) <= dev->cfg.timeout_us)
+  {
+    return false;
+  }
+  if ((dev->out.status & MEAS_AD7606_ST_TIMEOUT) == 0u)
+  {
+    meas_ad7606_inc_u16(&dev->cnt_timeout);
+  }
+  dev->out.status = (uint8_t)(dev->out.status | MEAS_AD7606_ST_TIMEOUT);
+  dev->out.valid_mask = 0u;
+  dev->have_last = false;
+  return true;
+}
@@ -0,0 +1,154 @@
+#ifndef MEAS_AD7606_H
+#define MEAS_AD7606_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file meas_ad7606.h
+ * @brief Медленные каналы 2× AD7606 (SPI3 — вход: фазные токи/линейные напряжения, SPI4 — температуры).
+ * @details
+ * Платформо-независимое ядро; порт (MX_SPI3_Init/MX_SPI4_Init) только программирует периферию по плану.
+ *
+ * Цепочка без CPU на кадр (один экземпляр на микросхему):
+ * - таймер с периодом `plan.frame_period_ns` формирует CONVST A/B;
+ * - спад BUSY (EXTI) — триггер генератора запросов DMAMUX: TX DMA пишет 8 dummy-слов в SPI DR (16-бит кадр,
+ *   только DOUTA, 8 каналов подряд), RX DMA кладёт коды в кольцевой буфер 2×`plan.frames_per_out` кадров;
+ * - half/full RX DMA ⇒ meas_ad7606_block() с `plan.frames_per_out` кадрами (ровно 1 мс данных).
+ * CPU трогает данные один раз на выходной отсчёт (1 мс), а не на кадр.
+ *
+ * Расписание (meas_ad7606_plan()): время кадра = `t_CONV(OS)` + чтение 128 бит на `spi_clk_hz` + запас;
+ * число кадров на 1 мс — наибольшая степень двойки ≤ MEAS_AD7606_FRAMES_MAX, для которой кадр помещается в период.
+ * Оверсемплинг AD7606 (пины OS[2:0], 1…64) — настраиваемый; он же определяет длину кадра.
+ *
+ * Банк децимации: на каждый канал — усреднение `frames_per_out` кадров (boxcar/CIC-1) ⇒ 1 отсчёт на 1 мс,
+ * в физических единицах `value = gain·(code - offset)`.
+ *
+ * Диагностика (логика, без HAL):
+ * - stuck: код канала не меняется `stuck_frames` кадров подряд (у живого канала с OS есть шум в младших разрядах);
+ * - sat: код на краю шкалы (-32768/+32767);
+ * - bus: кадр из одних 0x0000 или 0xFFFF (DOUTA в константе: обрыв/нет питания/нет SCK);
+ * - timeout: нет блока дольше `timeout_us` с init или с последнего блока (meas_ad7606_poll() из slow-домена);
+ *   значения невалидны.
+ */
+
+#define MEAS_AD7606_CHANNELS (8u) /**< Каналов на микросхему, [шт]. */
+#define MEAS_AD7606_FRAMES_MAX (16u) /**< Максимум кадров на выходной отсчёт (размер буферов DMA), [шт]. */
+#define MEAS_AD7606_OUT_PERIOD_US (1000u) /**< Период выходных отсчётов slow-домена, [мкс]. */
+#define MEAS_AD7606_OS_MAX (6u) /**< Максимальный код OS[2:0] (×64), [-]. */
+#define MEAS_AD7606_FRAME_GUARD_NS (2000u) /**< Запас кадра (t_CYCLE/CS/латентность DMA), [нс]. */
+
+/**
+ * @brief Флаги диагностики блока/экземпляра.
+ */
+typedef enum {
+  MEAS_AD7606_ST_STUCK = (1u << 0), /**< Есть залипший канал (см. stuck_mask). */
+  MEAS_AD7606_ST_SAT = (1u << 1), /**< Есть канал на краю шкалы (см. sat_mask). */
+  MEAS_AD7606_ST_BUS = (1u << 2), /**< Кадр из одних 0x0000/0xFFFF. */
+  MEAS_AD7606_ST_SHORT = (1u << 3), /**< Длина блока не равна плану (рассинхрон DMA). */
+  MEAS_AD7606_ST_TIMEOUT = (1u << 4) /**< Нет блоков дольше timeout_us. */
+} meas_ad7606_status_t;
+
+/**
+ * @brief Конфигурация микросхемы.
+ */
+typedef struct {
+  uint8_t os_ratio_log2; /**< Код OS[2:0]: оверсемплинг 2^os (0…MEAS_AD7606_OS_MAX), [-]. */
+  uint32_t spi_clk_hz; /**< Частота SCK, [Гц]. */
+  uint32_t timeout_us; /**< Таймаут отсутствия блоков, [мкс]. */
+  uint16_t stuck_frames; /**< Кадров без изменения кода для stuck (>= 2), [кадры]. */
+  float gain[MEAS_AD7606_CHANNELS]; /**< Масштаб каналов, [ед./код]. */
+  int16_t offset[MEAS_AD7606_CHANNELS]; /**< Смещение нуля каналов, [код]. */
+} meas_ad7606_cfg_t;
+
+/**
+ * @brief План опроса (значения для порта: таймер CONVST, длины DMA, пины OS).
+ */
+typedef struct {
+  uint8_t os_pins; /**< Значение OS[2:0], [-]. */
+  uint32_t t_conv_ns; /**< Время преобразования с оверсемплингом (max), [нс]. */
+  uint32_t t_read_ns; /**< Время чтения кадра (8×16 SCK), [нс]. */
+  uint32_t frame_period_ns; /**< Период CONVST, [нс]. */
+  uint16_t frames_per_out; /**< Кадров на 1 мс (коэффициент децимации), [кадры]. */
+  uint16_t dma_len; /**< Длина кольцевого RX DMA (2 половины), [слова]. */
+} meas_ad7606_plan_t;
+
+/**
+ * @brief Выходной отсчёт (1 мс).
+ */
+typedef struct {
+  float value[MEAS_AD7606_CHANNELS]; /**< Децимированные значения, [ед.]. */
+  uint8_t valid_mask; /**< Каналы с валидным значением, [битовая маска]. */
+  uint8_t stuck_mask; /**< Залипшие каналы, [битовая маска]. */
+  uint8_t sat_mask; /**< Каналы на краю шкалы, [битовая маска]. */
+  uint8_t status; /**< meas_ad7606_status_t, [битовая маска]. */
+} meas_ad7606_out_t;
+
+/**
+ * @brief Состояние микросхемы.
+ */
+typedef struct {
+  meas_ad7606_cfg_t cfg; /**< Конфигурация. */
+  meas_ad7606_plan_t plan; /**< План. */
+  bool valid; /**< Конфигурация валидна. */
+  int16_t last_code[MEAS_AD7606_CHANNELS]; /**< Код предыдущего кадра, [код]. */
+  uint16_t same_run[MEAS_AD7606_CHANNELS]; /**< Кадров подряд без изменения кода (насыщается), [кадры]. */
+  bool have_last; /**< last_code заполнен. */
+  uint32_t last_block_us; /**< Момент последнего блока (до первого — момент init), [мкс]. */
+  meas_ad7606_out_t out; /**< Последний выходной отсчёт. */
+  uint32_t cnt_blocks; /**< Обработано блоков, [шт]. */
+  uint16_t cnt_bus; /**< Кадров с ST_BUS (saturating), [шт]. */
+  uint16_t cnt_short; /**< Блоков неверной длины (saturating), [шт]. */
+  uint16_t cnt_timeout; /**< Входов в таймаут (saturating), [шт]. */
+} meas_ad7606_t;
+
+/**
+ * @brief Построить план опроса (чистая функция).
+ * @param cfg Конфигурация.
+ * @param plan План (заполняется только при успехе).
+ * @return false, если OS вне диапазона, `spi_clk_hz = 0` или даже один кадр на 1 мс не помещается.
+ */
+bool meas_ad7606_plan(const meas_ad7606_cfg_t *cfg, meas_ad7606_plan_t *plan);
+
+/**
+ * @brief Инициализировать экземпляр.
+ * @param dev Состояние.
+ * @param cfg Конфигурация.
+ * @param now_us Время старта, [мкс] — от него отсчитывается таймаут до первого блока (мёртвая/не тактируемая с
+ *        power-up микросхема уходит в ST_TIMEOUT так же, как пропавшая).
+ * @return false при невалидной конфигурации (план/stuck_frames/gain); экземпляр тогда выдаёт только невалидные
+ *         отсчёты.
+ */
+bool meas_ad7606_init(meas_ad7606_t *dev, const meas_ad7606_cfg_t *cfg, uint32_t now_us);
+
+/**
+ * @brief Обработать блок кадров (половина RX DMA): разбор, диагностика, децимация в один отсчёт.
+ * @param dev Состояние.
+ * @param words Слова SPI (16-бит кадр, MSB first, two's complement), `frames·8`.
+ * @param frames Кадров в блоке, [кадры].
+ * @param now_us Время, [мкс].
+ * @param out Выходной отсчёт (может быть NULL; копия остаётся в `dev->out`).
+ * @return true, если хотя бы один канал валиден.
+ * @details Время O(frames·8); кадры BUS в среднее не входят; канал валиден, если он не stuck/sat и есть
+ *          хотя бы один хороший кадр.
+ */
+bool meas_ad7606_block(meas_ad7606_t *dev, const uint16_t *words, uint32_t frames, uint32_t now_us,
+                       meas_ad7606_out_t *out);
+
+/**
+ * @brief Проверка таймаута (slow-домен, каждую 1 мс).
+ * @param dev Состояние.
+ * @param now_us Время, [мкс].
+ * @return true, если таймаут активен (тогда `dev->out` невалиден, status содержит ST_TIMEOUT).
+ */
+bool meas_ad7606_poll(meas_ad7606_t *dev, uint32_t now_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEAS_AD7606_H */
@@ -0,0 +1,107 @@
+#include "meas_imax.h"
+
+#include <stddef.h>
+
+#define MEAS_IMAX_CODE_SPAN (65536.0f) /**< Верхняя граница |код - offset| для 16-бит АЦП, [код]. */
+
+/**
+ * @brief Перевести порог из [A] в коды АЦП с насыщением.
+ * @param i_a Порог, [A].
+ * @param gain Масштаб, [A/код] (> 0).
+ * @return Порог, [код].
+ */
+static int32_t meas_imax_thr_code(float i_a, float gain)
+{
+  float code = i_a / gain;
+  code = (code > 0.0f) ? code : 0.0f;
+  code = (code < MEAS_IMAX_CODE_SPAN) ? code : MEAS_IMAX_CODE_SPAN;
+  return (int32_t)code;
+}
+
+bool meas_imax_init(meas_imax_t *mon, const meas_imax_cfg_t *cfg, meas_imax_trip_fn_t trip_fn, void *trip_user)
+{
+  const bool valid = (cfg != NULL) && (cfg->gain_a_per_code > 0.0f) && (cfg->i_warn_a <= cfg->i_trip_a) &&
+                     (cfg->i_trip_a <= cfg->i_instant_a) && (cfg->debounce_samples > 0u);
+
+  if (valid)
+  {
+    mon->thr_trip_code = meas_imax_thr_code(cfg->i_trip_a, cfg->gain_a_per_code);
+    mon->thr_instant_code = meas_imax_thr_code(cfg->i_instant_a, cfg->gain_a_per_code);
+    mon->thr_warn_code = meas_imax_thr_code(cfg->i_warn_a, cfg->gain_a_per_code);
+    mon->offset_code = cfg->offset_code;
+    mon->debounce = cfg->debounce_samples;
+  }
+  else
+  {
+    // SAFETY: невалидная калибровка ⇒ trip по первой же выборке, энергия не разрешается.
+    mon->thr_trip_code = -1;
+    mon->thr_instant_code = -1;
+    mon->thr_warn_code = -1;
+    mon->offset_code = 0;
+    mon->debounce = 1u;
+  }
+
+  mon->run = 0u;
+  mon->tripped = false;
+  mon->trip_fn = trip_fn;
+  mon->trip_user = trip_user;
+  mon->cnt_trips = 0u;
+  mon->cnt_warn_blocks = 0u;
+  mon->detect_latency_max = 0u;
+  return valid;
+}
+
+bool meas_imax_process(meas_imax_t *mon, const int16_t *samples, uint32_t count, meas_imax_out_t *out)
+{
+  const uint32_t none = MEAS_IMAX_INDEX_NONE;
+  uint32_t run = mon->run;
+  uint32_t trip_idx = none;
+  uint32_t latency = 0u;
+  int32_t peak = 0;
+  bool warn = false;
+
+  // Шаг 1: Проверка каждой выборки (серия выше i_trip насыщается на debounce).
+  for (uint32_t i = 0u; i < count; ++i)
+  {
+    const int32_t d = (int32_t)samples[i] - mon->offset_code;
+    const int32_t a = (d < 0) ? -d : d;
+    const bool over = a > mon->thr_trip_code;
+    run = over ? (run + (uint32_t)(run < mon->debounce)) : 0u;
+
+    const bool hit = (run >= mon->debounce) || (a > mon->thr_instant_code);
+    const bool first = hit && (trip_idx == none) && !mon->tripped;
+    trip_idx = first ? i : trip_idx;
+    latency = first ? (run - 1u) : latency;
+    peak = (a > peak) ? a : peak;
+    warn = warn || (a > mon->thr_warn_code);
+  }
+  mon->run = run;
+
+  // Шаг 2: Фронт trip ⇒ немедленный запрос force_off в текущем периоде.
+  const bool trip = (trip_idx != none);
+  if (trip)
+  {
+    mon->tripped = true;
+    mon->cnt_trips++;
+    mon->detect_latency_max = (latency > mon->detect_latency_max) ? (uint16_t)latency : mon->detect_latency_max;
+    if (mon->trip_fn != NULL)
+    {
+      mon->trip_fn(mon->trip_user);
+    }
+  }
+  mon->cnt_warn_blocks += (uint32_t)warn;
+
+  out->trip = trip;
+  out->warn = warn;
+  out->trip_index = (uint16_t)trip_idx;
+  out->detect_latency_samples = (uint16_t)latency;
+  out->block_latency_samples = trip ? (uint16_t)(count - 1u - trip_idx) : 0u;
+  out->peak_abs_code = (uint16_t)((peak < 0xFFFF) ? peak : 0xFFFF);
+  return mon->tripped;
+}
+
+void meas_imax_rearm(meas_imax_t *mon)
+{
+  mon->tripped = false;
+  mon->run = 0u;
+}
@@ -0,0 +1,111 @@
+#ifndef MEAS_IMAX_H
+#define MEAS_IMAX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file meas_imax.h
+ * @brief Быстрый программный монитор Imax по каждой выборке AD7380 (SFAT E-3, SF-3.2).
+ * @details
+ * Проверка выполняется в проходе measurement по сырым выборкам тока (а не по среднему за период PWM):
+ * каждая из N выборок блока (N=100 при 4 кГц, Δt=2.5 мкс) сравнивается с порогами в кодах АЦП.
+ * - `i_trip`:    превышение N_debounce выборок подряд ⇒ trip;
+ * - `i_instant`: одна выборка выше порога ⇒ trip без debounce (грубое КЗ);
+ * - `i_warn`:    признак "близко к пределу" (INFO).
+ *
+ * При trip синхронно вызывается инжектируемый `trip_fn` (программный BKIN/force_off в Fw/port),
+ * т.е. отключение запрашивается в том же периоде, в котором пришла выборка, без ожидания control_tick.
+ * Блок может обрабатываться частями (half/full DMA), состояние debounce переносится между вызовами.
+ * Латентность сообщается в выборках: от первой выборки выше порога до решения и от решения до конца блока.
+ */
+
+#define MEAS_IMAX_INDEX_NONE (0xFFFFu) /**< Индекс выборки "не было", [-]. */
+
+/**
+ * @brief Запрос программного отключения (ISR-safe, из Fw/port).
+ * @param user Контекст порта.
+ * @return None.
+ */
+typedef void (*meas_imax_trip_fn_t)(void *user);
+
+/**
+ * @brief Конфигурация монитора.
+ */
+typedef struct {
+  float gain_a_per_code; /**< Масштаб канала тока (Rogowski + интегратор), [A/код]. */
+  int16_t offset_code; /**< Смещение нуля канала тока, [код]. */
+  float i_trip_a; /**< Порог trip с debounce (по модулю), [A]. */
+  float i_instant_a; /**< Порог мгновенного trip (по модулю, >= i_trip_a), [A]. */
+  float i_warn_a; /**< Порог предупреждения (по модулю, <= i_trip_a), [A]. */
+  uint16_t debounce_samples; /**< Выборок подряд выше i_trip для trip (>= 1), [шт]. */
+} meas_imax_cfg_t;
+
+/**
+ * @brief Результат обработки блока выборок.
+ */
+typedef struct {
+  bool trip; /**< Trip произошёл в этом блоке. */
+  bool warn; /**< Была выборка выше i_warn. */
+  uint16_t trip_index; /**< Индекс выборки trip в блоке (MEAS_IMAX_INDEX_NONE — не было), [-]. */
+  uint16_t detect_latency_samples; /**< От первой выборки выше порога до решения, [выборки]. */
+  uint16_t block_latency_samples; /**< От выборки trip до конца блока (ожидание обработки), [выборки]. */
+  uint16_t peak_abs_code; /**< Максимум |код - offset| в блоке, [код]. */
+} meas_imax_out_t;
+
+/**
+ * @brief Состояние монитора.
+ */
+typedef struct {
+  int32_t thr_trip_code; /**< Порог trip, [код]. */
+  int32_t thr_instant_code; /**< Порог мгновенного trip, [код]. */
+  int32_t thr_warn_code; /**< Порог предупреждения, [код]. */
+  int32_t offset_code; /**< Смещение нуля, [код]. */
+  uint32_t debounce; /**< Требуемая длина серии, [выборки]. */
+  uint32_t run; /**< Текущая серия выше i_trip (переносится между блоками), [выборки]. */
+  bool tripped; /**< Trip зафиксирован (до meas_imax_rearm). */
+  meas_imax_trip_fn_t trip_fn; /**< Запрос force_off (может быть NULL). */
+  void *trip_user; /**< Контекст trip_fn. */
+  uint32_t cnt_trips; /**< Trip, [шт]. */
+  uint32_t cnt_warn_blocks; /**< Блоков с предупреждением, [шт]. */
+  uint16_t detect_latency_max; /**< Максимум detect_latency_samples, [выборки]. */
+} meas_imax_t;
+
+/**
+ * @brief Инициализировать монитор (пересчёт порогов из [A] в коды АЦП).
+ * @param mon Состояние.
+ * @param cfg Конфигурация.
+ * @param trip_fn Запрос force_off (NULL — только флаг в результате).
+ * @param trip_user Контекст trip_fn.
+ * @return false при невалидной конфигурации (gain <= 0, warn > trip > instant, debounce = 0); монитор
+ *         тогда настраивается на trip по любой выборке (fail-safe).
+ */
+bool meas_imax_init(meas_imax_t *mon, const meas_imax_cfg_t *cfg, meas_imax_trip_fn_t trip_fn, void *trip_user);
+
+/**
+ * @brief Проверить блок выборок тока (вызов из прохода measurement, DMA half/full или конец периода).
+ * @param mon Состояние.
+ * @param samples Сырые коды канала тока.
+ * @param count Количество выборок, [шт].
+ * @param out Результат блока.
+ * @return true, если монитор в состоянии trip (в т.ч. с предыдущих блоков).
+ * @details Время O(count), без ветвлений по данным в цикле; trip_fn вызывается один раз на фронте trip.
+ */
+bool meas_imax_process(meas_imax_t *mon, const int16_t *samples, uint32_t count, meas_imax_out_t *out);
+
+/**
+ * @brief Снять trip монитора (после recovery safety_supervisor).
+ * @param mon Состояние.
+ * @return None.
+ */
+void meas_imax_rearm(meas_imax_t *mon);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEAS_IMAX_H */
@@ -0,0 +1,286 @@
+#include "meas_pq.h"
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+#define MEAS_PQ_CH (6u) /**< Каналов: 3 линейных напряжения + 3 фазных тока, [шт]. */
+#define MEAS_PQ_PI (3.14159265358979f) /**< π, [-]. */
+#define MEAS_PQ_SQRT3 (1.7320508f) /**< √3, [-]. */
+#define MEAS_PQ_SQRT2 (1.4142136f) /**< √2, [-]. */
+#define MEAS_PQ_A_RE (-0.5f) /**< Re(a), a = e^{j2π/3}, [-]. */
+#define MEAS_PQ_A_IM (0.8660254f) /**< Im(a), [-]. */
+
+/**
+ * @brief Отношение обратной последовательности к прямой по трём фазорам.
+ * @param re Re фазоров (порядок a, b, c).
+ * @param im Im фазоров.
+ * @return `|X2|/|X1|` (0 при |X1| = 0), [отн. ед.].
+ */
+static float meas_pq_unbalance(const float re[3], const float im[3])
+{
+  // X1 = Xa + a·Xb + a²·Xc, X2 = Xa + a²·Xb + a·Xc (множитель 1/3 сокращается); a² = conj(a).
+  const float b1_re = MEAS_PQ_A_RE * re[1] - MEAS_PQ_A_IM * im[1];
+  const float b1_im = MEAS_PQ_A_RE * im[1] + MEAS_PQ_A_IM * re[1];
+  const float c1_re = MEAS_PQ_A_RE * re[2] + MEAS_PQ_A_IM * im[2];
+  const float c1_im = MEAS_PQ_A_RE * im[2] - MEAS_PQ_A_IM * re[2];
+  const float b2_re = MEAS_PQ_A_RE * re[1] + MEAS_PQ_A_IM * im[1];
+  const float b2_im = MEAS_PQ_A_RE * im[1] - MEAS_PQ_A_IM * re[1];
+  const float c2_re = MEAS_PQ_A_RE * re[2] - MEAS_PQ_A_IM * im[2];
+  const float c2_im = MEAS_PQ_A_RE * im[2] + MEAS_PQ_A_IM * re[2];
+
+  const float x1 = hypotf(re[0] + b1_re + c1_re, im[0] + b1_im + c1_im);
+  const float x2 = hypotf(re[0] + b2_re + c2_re, im[0] + b2_im + c2_im);
+  return (x1 > 0.0f) ? (x2 / x1) : 0.0f;
+}
+
+/**
+ * @brief Записать u16 LE.
+ * @param dst Буфер.
+ * @param value Значение.
+ * @return None.
+ */
+static void meas_pq_put_u16(uint8_t *dst, uint16_t value)
+{
+  dst[0] = (uint8_t)(value & 0xFFu);
+  dst[1] = (uint8_t)(value >> 8);
+}
+
+/**
+ * @brief Записать u32 LE.
+ * @param dst Буфер.
+ * @param value Значение.
+ * @return None.
+ */
+static void meas_pq_put_u32(uint8_t *dst, uint32_t value)
+{
+  dst[0] = (uint8_t)(value & 0xFFu);
+  dst[1] = (uint8_t)((value >> 8) & 0xFFu);
+  dst[2] = (uint8_t)((value >> 16) & 0xFFu);
+  dst[3] = (uint8_t)(value >> 24);
+}
+
+/**
+ * @brief Записать float (IEEE-754 binary32) LE.
+ * @param dst Буфер.
+ * @param value Значение.
+ * @return None.
+ */
+static void meas_pq_put_f32(uint8_t *dst, float value)
+{
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  meas_pq_put_u32(dst, bits);
+}
+
+/**
+ * @brief Насыщающий инкремент счётчика u16.
+ * @param cnt Счётчик.
+ * @return None.
+ */
+static void meas_pq_inc_u16(uint16_t *cnt)
+{
+  *cnt = (uint16_t)(*cnt + (uint16_t)(*cnt != UINT16_MAX));
+}
+
+/**
+ * @brief Закрыть период сети: RMS трёх линейных напряжений, провал/перенапряжение, статистика.
+ * @param pq Состояние.
+ * @return None.
+ */
+static void meas_pq_close_cycle(meas_pq_t *pq)
+{
+  const float inv = 1.0f / (float)pq->cyc_len; /* [1/кадр] */
+  float u_min = INFINITY; /* [В] */
+  float u_max = 0.0f; /* [В] */
+  for (uint32_t k = 0u; k < 3u; ++k)
+  {
+    const float rms = sqrtf(pq->cyc_sq[k] * inv);
+    u_min = (rms < u_min) ? rms : u_min;
+    u_max = (rms > u_max) ? rms : u_max;
+    pq->cyc_sq[k] = 0.0f;
+  }
+  const float min_pu = u_min / pq->cfg.u_nom_v;
+  const float max_pu = u_max / pq->cfg.u_nom_v;
+
+  // Шаг 1: События с гистерезисом (счёт по входу).
+  if (!pq->sag && (min_pu < pq->cfg.sag_pu))
+  {
+    pq->sag = true;
+    meas_pq_inc_u16(&pq->stats.sag_events);
+  }
+  else if (pq->sag && (min_pu >= (pq->cfg.sag_pu + pq->cfg.hyst_pu)))
+  {
+    pq->sag = false;
+  }
+  if (!pq->swell && (max_pu > pq->cfg.swell_pu))
+  {
+    pq->swell = true;
+    meas_pq_inc_u16(&pq->stats.swell_events);
+  }
+  else if (pq->swell && (max_pu <= (pq->cfg.swell_pu - pq->cfg.hyst_pu)))
+  {
+    pq->swell = false;
+  }
+
+  // Шаг 2: Статистика по периодам.
+  meas_pq_stats_t *st = &pq->stats;
+  st->sag_cycles += (uint32_t)pq->sag;
+  st->u_min_pu = ((st->cycles == 0u) || (min_pu < st->u_min_pu)) ? min_pu : st->u_min_pu;
+  st->u_max_pu = ((st->cycles == 0u) || (max_pu > st->u_max_pu)) ? max_pu : st->u_max_pu;
+  st->cycles++;
+}
+
+/**
+ * @brief Закрыть окно: RMS, фазоры основной гармоники, несимметрия, P/S/PF; сброс накопителей.
+ * @param pq Состояние.
+ * @return None.
+ */
+static void meas_pq_close_window(meas_pq_t *pq)
+{
+  meas_pq_result_t *r = &pq->result;
+  const float inv = 1.0f / (float)pq->win_len; /* [1/кадр] */
+  const float k1 = MEAS_PQ_SQRT2 * inv; /* |X|·√2/M = RMS основной гармоники */
+
+  // Шаг 1: RMS истинное и основной гармоники.
+  for (uint32_t k = 0u; k < 3u; ++k)
+  {
+    r->u_rms[k] = sqrtf(pq->acc_sq[k] * inv);
+    r->i_rms[k] = sqrtf(pq->acc_sq[k + 3u] * inv);
+    r->u1_rms[k] = k1 * hypotf(pq->acc_re[k], pq->acc_im[k]);
+    r->i1_rms[k] = k1 * hypotf(pq->acc_re[k + 3u], pq->acc_im[k + 3u]);
+  }
+
+  // Шаг 2: Несимметрия (обратная/прямая последовательность).
+  r->unbalance_u = meas_pq_unbalance(&pq->acc_re[0], &pq->acc_im[0]);
+  r->unbalance_i = meas_pq_unbalance(&pq->acc_re[3], &pq->acc_im[3]);
+
+  // Шаг 3: Мощности и PF.
+  const float u_avg = (r->u_rms[0] + r->u_rms[1] + r->u_rms[2]) * (1.0f / 3.0f); /* [В] */
+  const float i_avg = (r->i_rms[0] + r->i_rms[1] + r->i_rms[2]) * (1.0f / 3.0f); /* [A] */
+  r->p_w = pq->acc_p * inv;
+  r->s_va = MEAS_PQ_SQRT3 * u_avg * i_avg;
+  r->pf = (r->s_va > 0.0f) ? (r->p_w / r->s_va) : 0.0f;
+
+  // Шаг 4: Статистика по окнам.
+  meas_pq_stats_t *st = &pq->stats;
+  const float i_max = fmaxf(r->i_rms[0], fmaxf(r->i_rms[1], r->i_rms[2])); /* [A] */
+  st->i_rms_max = (i_max > st->i_rms_max) ? i_max : st->i_rms_max;
+  st->unbalance_u_max = (r->unbalance_u > st->unbalance_u_max) ? r->unbalance_u : st->unbalance_u_max;
+  st->windows++;
+
+  pq->seq++;
+  pq->have_result = true;
+  for (uint32_t ch = 0u; ch < MEAS_PQ_CH; ++ch)
+  {
+    pq->acc_re[ch] = 0.0f;
+    pq->acc_im[ch] = 0.0f;
+    pq->acc_sq[ch] = 0.0f;
+  }
+  pq->acc_p = 0.0f;
+  pq->osc_re = 1.0f;
+  pq->osc_im = 0.0f;
+  pq->n_win = 0u;
+}
+
+bool meas_pq_init(meas_pq_t *pq, const meas_pq_cfg_t *cfg)
+{
+  const meas_pq_t zero = {0};
+  *pq = zero;
+
+  const bool valid = (cfg != NULL) && isfinite(cfg->fs_hz) && (cfg->f_mains_hz > 0.0f) &&
+                     (cfg->fs_hz >= (8.0f * cfg->f_mains_hz)) && (cfg->window_cycles > 0u) &&
+                     (cfg->u_nom_v > 0.0f) && (cfg->sag_pu > 0.0f) && (cfg->sag_pu < 1.0f) &&
+                     (cfg->swell_pu > 1.0f) && (cfg->hyst_pu >= 0.0f);
+  if (!valid)
+  {
+    return false;
+  }
+
+  // Целое число кадров на период сети ⇒ окно из целого числа периодов, бин основной гармоники целый.
+  pq->cfg = *cfg;
+  pq->cyc_len = (uint32_t)lroundf(cfg->fs_hz / cfg->f_mains_hz);
+  pq->win_len = pq->cyc_len * cfg->window_cycles;
+  const float w = 2.0f * MEAS_PQ_PI / (float)pq->cyc_len; /* [рад/кадр] */
+  pq->rot_re = cosf(w);
+  pq->rot_im = -sinf(w);
+  pq->osc_re = 1.0f;
+  pq->osc_im = 0.0f;
+  pq->valid = true;
+  return true;
+}
+
+bool meas_pq_step(meas_pq_t *pq, const meas_pq_sample_t *s)
+{
+  if (!pq->valid)
+  {
+    return false;
+  }
+
+  // Шаг 1: Однобиновый ДПФ, Σx², мощность (два ваттметра: u_ac = -u_ca).
+  const float x[MEAS_PQ_CH] = {s->u_ll[0], s->u_ll[1], s->u_ll[2], s->i_ph[0], s->i_ph[1], s->i_ph[2]};
+  for (uint32_t ch = 0u; ch < MEAS_PQ_CH; ++ch)
+  {
+    pq->acc_re[ch] += x[ch] * pq->osc_re;
+    pq->acc_im[ch] += x[ch] * pq->osc_im;
+    pq->acc_sq[ch] += x[ch] * x[ch];
+  }
+  pq->acc_p += (-s->u_ll[2] * s->i_ph[0]) + (s->u_ll[1] * s->i_ph[1]);
+
+  // Шаг 2: Поворот фазора + перенормировка |osc| → 1 (первый порядок Ньютона), без накопления дрейфа.
+  const float re = (pq->osc_re * pq->rot_re) - (pq->osc_im * pq->rot_im);
+  const float im = (pq->osc_re * pq->rot_im) + (pq->osc_im * pq->rot_re);
+  const float g = 0.5f * (3.0f - ((re * re) + (im * im)));
+  pq->osc_re = re * g;
+  pq->osc_im = im * g;
+
+  // Шаг 3: Период сети (провал/перенапряжение).
+  for (uint32_t k = 0u; k < 3u; ++k)
+  {
+    pq->cyc_sq[k] += s->u_ll[k] * s->u_ll[k];
+  }
+  if (++pq->n_cyc >= pq->cyc_len)
+  {
+    pq->n_cyc = 0u;
+    meas_pq_close_cycle(pq);
+  }
+
+  // Шаг 4: Окно.
+  if (++pq->n_win >= pq->win_len)
+  {
+    meas_pq_close_window(pq);
+    return true;
+  }
+  return false;
+}
+
+void meas_pq_stats_reset(meas_pq_t *pq)
+{
+  const meas_pq_stats_t zero = {0};
+  pq->stats = zero;
+}
+
+void meas_pq_pack(const meas_pq_t *pq, uint8_t data[MEAS_PQ_REPORT_LEN])
+{
+  const meas_pq_result_t *r = &pq->result;
+  const meas_pq_stats_t *st = &pq->stats;
+  const uint16_t flags = (uint16_t)((pq->have_result ? MEAS_PQ_FLAG_VALID : 0u) | (pq->sag ? MEAS_PQ_FLAG_SAG : 0u) |
+                                    (pq->swell ? MEAS_PQ_FLAG_SWELL : 0u));
+
+  meas_pq_put_u16(&data[0], pq->seq);
+  meas_pq_put_u16(&data[2], flags);
+  for (uint32_t k = 0u; k < 3u; ++k)
+  {
+    meas_pq_put_f32(&data[4u + 4u * k], r->u_rms[k]);
+    meas_pq_put_f32(&data[16u + 4u * k], r->i_rms[k]);
+  }
+  meas_pq_put_f32(&data[28], r->unbalance_u);
+  meas_pq_put_f32(&data[32], r->unbalance_i);
+  meas_pq_put_f32(&data[36], r->pf);
+  meas_pq_put_f32(&data[40], r->p_w);
+  meas_pq_put_f32(&data[44], st->u_min_pu);
+  meas_pq_put_f32(&data[48], st->u_max_pu);
+  meas_pq_put_u16(&data[52], st->sag_events);
+  meas_pq_put_u16(&data[54], st->swell_events);
+  meas_pq_put_u32(&data[56], st->sag_cycles);
+}
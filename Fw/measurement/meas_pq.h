@@ -0,0 +1,159 @@
+#ifndef MEAS_PQ_H
+#define MEAS_PQ_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file meas_pq.h
+ * @brief Качество питания на входе (AD7606 #1): RMS, несимметрия, коэффициент мощности, провалы/перенапряжения.
+ * @details
+ * Вход — по кадру AD7606 #1 в физических единицах: линейные напряжения `U_ab, U_bc, U_ca` и фазные токи
+ * `I_a, I_b, I_c` (3-проводная сеть, нейтрали нет). Домен: slow (кадры блока DMA), O(1) на кадр,
+ * окна выборок не хранятся — только накопители:
+ * - фундаментальная гармоника каждого канала — однобиновый ДПФ, накапливаемый по выборке с вращающимся фазором
+ *   `e^{-jωn}` (перенормировка каждый шаг). Выбран вместо Goertzel: при ω = 2π·50/16000 Goertzel в float32
+ *   теряет точность (`2cos ω → 2`), а прямое накопление — нет; окно содержит целое число периодов сети
+ *   (целый бин, без утечки при целом `fs/f`);
+ * - истинное RMS — Σx² за окно; активная мощность — метод двух ваттметров `p = u_ac·i_a + u_bc·i_b`;
+ * - несимметрия — отношение обратной последовательности к прямой `|X2|/|X1|` (по фазорам окна; для линейных
+ *   напряжений то же отношение, что и для фазных);
+ * - PF = P/S, `S = √3·mean(U_ll)·mean(I)`;
+ * - провал/перенапряжение — по RMS каждого периода сети (min по трём линейным) относительно `u_nom_v`
+ *   с гистерезисом; счётчики событий и длительность провала в периодах.
+ *
+ * Статистика для планирования сварок на общем фидере (min/max напряжения, события, несимметрия, пик тока)
+ * накапливается до meas_pq_stats_reset() (вызов на начале сварки; на конце — чтение).
+ * Публикация: diag (`meas_pq_t`) и PCcom4 `InputPQ.Last` (meas_pq_pack(), см. PCCOM4.02_PROJECT §3.4.4).
+ */
+
+#define MEAS_PQ_REPORT_LEN (60u) /**< Длина payload PCcom4 `InputPQ.Last`, [байт]. */
+
+/**
+ * @brief Флаги состояния (payload `flags`).
+ */
+typedef enum {
+  MEAS_PQ_FLAG_VALID = (1u << 0), /**< Есть результат хотя бы одного окна. */
+  MEAS_PQ_FLAG_SAG = (1u << 1), /**< Провал напряжения активен. */
+  MEAS_PQ_FLAG_SWELL = (1u << 2) /**< Перенапряжение активно. */
+} meas_pq_flag_t;
+
+/**
+ * @brief Один кадр входных каналов.
+ */
+typedef struct {
+  float u_ll[3]; /**< Линейные напряжения `U_ab, U_bc, U_ca`, [В]. */
+  float i_ph[3]; /**< Фазные токи `I_a, I_b, I_c`, [A]. */
+} meas_pq_sample_t;
+
+/**
+ * @brief Конфигурация.
+ */
+typedef struct {
+  float fs_hz; /**< Частота кадров, [Гц]. */
+  float f_mains_hz; /**< Номинальная частота сети (50/60), [Гц]. */
+  uint16_t window_cycles; /**< Периодов сети в окне (10 ⇒ 200 мс при 50 Гц), [шт]. */
+  float u_nom_v; /**< Номинальное линейное напряжение (RMS), [В]. */
+  float sag_pu; /**< Порог провала, [отн. ед.] (0.9). */
+  float swell_pu; /**< Порог перенапряжения, [отн. ед.] (1.1). */
+  float hyst_pu; /**< Гистерезис выхода из события, [отн. ед.]. */
+} meas_pq_cfg_t;
+
+/**
+ * @brief Результат окна.
+ */
+typedef struct {
+  float u_rms[3]; /**< RMS линейных напряжений, [В]. */
+  float i_rms[3]; /**< RMS фазных токов, [A]. */
+  float u1_rms[3]; /**< RMS основной гармоники линейных напряжений, [В]. */
+  float i1_rms[3]; /**< RMS основной гармоники токов, [A]. */
+  float unbalance_u; /**< Несимметрия напряжений `|U2|/|U1|`, [отн. ед.]. */
+  float unbalance_i; /**< Несимметрия токов `|I2|/|I1|`, [отн. ед.]. */
+  float p_w; /**< Активная мощность, [Вт]. */
+  float s_va; /**< Полная мощность, [ВА]. */
+  float pf; /**< Коэффициент мощности P/S (0 при S ≈ 0), [отн. ед.]. */
+} meas_pq_result_t;
+
+/**
+ * @brief Статистика (с последнего meas_pq_stats_reset()).
+ */
+typedef struct {
+  float u_min_pu; /**< Минимум RMS периода (по трём линейным), [отн. ед.]. */
+  float u_max_pu; /**< Максимум RMS периода, [отн. ед.]. */
+  float unbalance_u_max; /**< Максимум несимметрии напряжений, [отн. ед.]. */
+  float i_rms_max; /**< Максимум RMS фазного тока, [A]. */
+  uint16_t sag_events; /**< Провалов (по входу, saturating), [шт]. */
+  uint16_t swell_events; /**< Перенапряжений (по входу, saturating), [шт]. */
+  uint32_t sag_cycles; /**< Суммарная длительность провалов, [периоды сети]. */
+  uint32_t cycles; /**< Периодов сети в статистике (0 ⇒ u_min/u_max не определены), [шт]. */
+  uint32_t windows; /**< Окон в статистике, [шт]. */
+} meas_pq_stats_t;
+
+/**
+ * @brief Состояние анализатора.
+ */
+typedef struct {
+  meas_pq_cfg_t cfg; /**< Конфигурация. */
+  bool valid; /**< Конфигурация валидна. */
+  uint32_t win_len; /**< Кадров в окне, [кадры]. */
+  uint32_t cyc_len; /**< Кадров в периоде сети, [кадры]. */
+  float rot_re; /**< Поворот фазора за кадр `cos ω`, [-]. */
+  float rot_im; /**< Поворот фазора за кадр `-sin ω`, [-]. */
+  float osc_re; /**< Текущий фазор `e^{-jωn}` (Re), [-]. */
+  float osc_im; /**< Текущий фазор (Im), [-]. */
+  float acc_re[6]; /**< Σ x·cos (U_ab, U_bc, U_ca, I_a, I_b, I_c), [ед.]. */
+  float acc_im[6]; /**< Σ x·(-sin), [ед.]. */
+  float acc_sq[6]; /**< Σ x² за окно, [ед.²]. */
+  float acc_p; /**< Σ p за окно, [Вт]. */
+  float cyc_sq[3]; /**< Σ u² за период сети, [В²]. */
+  uint32_t n_win; /**< Кадров в текущем окне, [кадры]. */
+  uint32_t n_cyc; /**< Кадров в текущем периоде, [кадры]. */
+  bool sag; /**< Провал активен. */
+  bool swell; /**< Перенапряжение активно. */
+  uint16_t seq; /**< Номер окна (wrap-around), [-]. */
+  meas_pq_result_t result; /**< Результат последнего окна. */
+  bool have_result; /**< result заполнен. */
+  meas_pq_stats_t stats; /**< Статистика. */
+} meas_pq_t;
+
+/**
+ * @brief Инициализировать анализатор.
+ * @param pq Состояние.
+ * @param cfg Конфигурация.
+ * @return false при невалидной конфигурации (`fs < 8·f`, пороги вне `0 < sag < 1 < swell`, `u_nom <= 0`);
+ *         тогда meas_pq_step() — no-op.
+ */
+bool meas_pq_init(meas_pq_t *pq, const meas_pq_cfg_t *cfg);
+
+/**
+ * @brief Учесть один кадр.
+ * @param pq Состояние.
+ * @param s Кадр.
+ * @return true, если закрыто окно и `pq->result` обновлён.
+ */
+bool meas_pq_step(meas_pq_t *pq, const meas_pq_sample_t *s);
+
+/**
+ * @brief Сбросить статистику (начало сварки / интервала наблюдения).
+ * @param pq Состояние.
+ * @return None.
+ */
+void meas_pq_stats_reset(meas_pq_t *pq);
+
+/**
+ * @brief Закодировать результат и статистику в payload PCcom4 `InputPQ.Last` (LE).
+ * @param pq Состояние.
+ * @param data Буфер MEAS_PQ_REPORT_LEN байт.
+ * @return None.
+ */
+void meas_pq_pack(const meas_pq_t *pq, uint8_t data[MEAS_PQ_REPORT_LEN]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEAS_PQ_H */
@@ -0,0 +1,177 @@
+#include "meas_sampling.h"
+
+#include <stddef.h>
+
+/**
+ * @brief Суммирование N выборок (общая часть ядер; N — константа времени компиляции в специализациях).
+ * @param i Коды тока.
+ * @param u Коды напряжения.
+ * @param n Число выборок, [шт].
+ * @param offset_i Смещение тока, [код].
+ * @param offset_u Смещение напряжения, [код].
+ * @param sums Суммы.
+ * @return None.
+ */
+static inline void meas_sampling_sum_n(const int16_t *i, const int16_t *u, uint32_t n, int32_t offset_i,
+                                       int32_t offset_u, meas_sampling_sums_t *sums)
+{
+  int32_t si = 0;
+  int32_t su = 0;
+  int64_t siu = 0;
+  for (uint32_t k = 0u; k < n; ++k)
+  {
+    const int32_t di = (int32_t)i[k] - offset_i;
+    const int32_t du = (int32_t)u[k] - offset_u;
+    si += di;
+    su += du;
+    siu += (int64_t)di * du;
+  }
+  sums->sum_i = si;
+  sums->sum_u = su;
+  sums->sum_iu = siu;
+}
+
+/**
+ * @brief Ядро N = 32.
+ * @param i Коды тока.
+ * @param u Коды напряжения.
+ * @param offset_i Смещение тока, [код].
+ * @param offset_u Смещение напряжения, [код].
+ * @param sums Суммы.
+ * @return None.
+ */
+static void meas_sampling_kernel_32(const int16_t *i, const int16_t *u, int32_t offset_i, int32_t offset_u,
+                                    meas_sampling_sums_t *sums)
+{
+  meas_sampling_sum_n(i, u, 32u, offset_i, offset_u, sums);
+}
+
+/**
+ * @brief Ядро N = 64.
+ * @param i Коды тока.
+ * @param u Коды напряжения.
+ * @param offset_i Смещение тока, [код].
+ * @param offset_u Смещение напряжения, [код].
+ * @param sums Суммы.
+ * @return None.
+ */
+static void meas_sampling_kernel_64(const int16_t *i, const int16_t *u, int32_t offset_i, int32_t offset_u,
+                                    meas_sampling_sums_t *sums)
+{
+  meas_sampling_sum_n(i, u, 64u, offset_i, offset_u, sums);
+}
+
+/**
+ * @brief Ядро N = 100.
+ * @param i Коды тока.
+ * @param u Коды напряжения.
+ * @param offset_i Смещение тока, [код].
+ * @param offset_u Смещение напряжения, [код].
+ * @param sums Суммы.
+ * @return None.
+ */
+static void meas_sampling_kernel_100(const int16_t *i, const int16_t *u, int32_t offset_i, int32_t offset_u,
+                                     meas_sampling_sums_t *sums)
+{
+  meas_sampling_sum_n(i, u, 100u, offset_i, offset_u, sums);
+}
+
+/**
+ * @brief Допустимые N (по убыванию) и их ядра.
+ */
+static const struct {
+  uint16_t n; /**< Выборок за период, [шт]. */
+  meas_sampling_kernel_fn_t kernel; /**< Специализация ядра. */
+} k_meas_sampling_variants[] = {
+  {100u, meas_sampling_kernel_100},
+  {64u, meas_sampling_kernel_64},
+  {32u, meas_sampling_kernel_32},
+};
+
+bool meas_sampling_plan(const meas_sampling_cfg_t *cfg, meas_sampling_plan_t *plan)
+{
+  if ((cfg == NULL) || (cfg->pwm_hz < MEAS_SAMPLING_PWM_MIN_HZ) || (cfg->pwm_hz > MEAS_SAMPLING_PWM_MAX_HZ) ||
+      (cfg->tim_clk_hz == 0u) || (cfg->budget_permille > 1000u) || !(cfg->gain_i_a_per_code > 0.0f) ||
+      !(cfg->gain_u_v_per_code > 0.0f))
+  {
+    return false;
+  }
+
+  // Шаг 1: Тики периода TIM1, окна CS и бюджет CPU/DMA на период.
+  const uint32_t fs_max = (cfg->fs_max_hz != 0u) ? cfg->fs_max_hz : MEAS_SAMPLING_FS_MAX_HZ; /* [Гц] */
+  const uint32_t frame_cost =
+    (cfg->frame_cost_ns != 0u) ? cfg->frame_cost_ns : MEAS_SAMPLING_FRAME_COST_NS; /* [нс] */
+  const uint32_t budget =
+    (cfg->budget_permille != 0u) ? cfg->budget_permille : MEAS_SAMPLING_BUDGET_PERMILLE; /* [‰] */
+  const uint32_t period = (uint32_t)(((uint64_t)cfg->tim_clk_hz + (cfg->pwm_hz / 2u)) / cfg->pwm_hz); /* [тики] */
+  const uint32_t cs_ticks =
+    (uint32_t)(((uint64_t)cfg->cs_low_ns * cfg->tim_clk_hz + 999999999u) / 1000000000u); /* [тики] */
+
+  // Шаг 2: Наибольшее N, для которого обработка укладывается в бюджет периода, кадр помещается в шаг
+  // и частота кадров не выше потолка.
+  for (uint32_t v = 0u; v < (sizeof(k_meas_sampling_variants) / sizeof(k_meas_sampling_variants[0])); ++v)
+  {
+    const uint32_t n = k_meas_sampling_variants[v].n;
+    const uint32_t step = (period + n - 1u) / n; /* ceil(P/N): N-е событие TIM3_UP не раньше сброса, [тики] */
+    const uint64_t fs = (uint64_t)cfg->tim_clk_hz / step; /* [Гц] */
+    // N·cost [нс] <= (P/f_tim)·1e9 · budget/1000 [нс] — в целых, без деления: обе части ×f_tim.
+    const bool in_budget = ((uint64_t)n * frame_cost * cfg->tim_clk_hz) <= ((uint64_t)period * budget * 1000000u);
+    if (!in_budget || (fs > fs_max) || (cs_ticks >= step) || (step > MEAS_SAMPLING_TIM_ARR_MAX))
+    {
+      continue;
+    }
+
+    // Шаг 3: Все производные величины — из одного места.
+    plan->n = (uint16_t)n;
+    plan->dma_len = (uint16_t)n;
+    plan->tim1_period_ticks = period;
+    plan->tim3_arr = step - 1u;
+    plan->tim3_ccr = cs_ticks;
+    plan->fs_hz = (uint32_t)fs;
+    plan->dt_s = (float)period / (float)cfg->tim_clk_hz;
+    plan->inv_n = 1.0f / (float)n;
+    plan->gain_i = cfg->gain_i_a_per_code;
+    plan->gain_u = cfg->gain_u_v_per_code;
+    plan->offset_i = cfg->offset_i_code;
+    plan->offset_u = cfg->offset_u_code;
+    plan->kernel = k_meas_sampling_variants[v].kernel;
+    return true;
+  }
+  return false;
+}
+
+bool meas_sampling_init(meas_sampling_t *ctx, const meas_sampling_cfg_t *cfg)
+{
+  const meas_sampling_t zero = {0};
+  *ctx = zero;
+  ctx->valid = meas_sampling_plan(cfg, &ctx->plan);
+  return ctx->valid;
+}
+
+bool meas_sampling_reconfigure(meas_sampling_t *ctx, const meas_sampling_cfg_t *cfg, bool idle)
+{
+  meas_sampling_plan_t plan;
+
+  // SAFETY: вне IDLE DMA пишет в буферы длиной активного плана — менять N/TIM3 на ходу нельзя.
+  if (!idle || !meas_sampling_plan(cfg, &plan))
+  {
+    ctx->cnt_rejected++;
+    return false;
+  }
+  ctx->plan = plan;
+  ctx->valid = true;
+  ctx->generation++;
+  return true;
+}
+
+void meas_sampling_aggregate(const meas_sampling_plan_t *plan, const int16_t *i, const int16_t *u,
+                             meas_sampling_period_t *out)
+{
+  meas_sampling_sums_t sums;
+  plan->kernel(i, u, plan->offset_i, plan->offset_u, &sums);
+
+  const float gain_p = plan->gain_i * plan->gain_u; /* [Вт/код²] */
+  out->i_per = (float)sums.sum_i * plan->inv_n * plan->gain_i;
+  out->u_per = (float)sums.sum_u * plan->inv_n * plan->gain_u;
+  out->p_per = (float)sums.sum_iu * plan->inv_n * gain_p;
+}
@@ -0,0 +1,162 @@
+#ifndef MEAS_SAMPLING_H
+#define MEAS_SAMPLING_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file meas_sampling.h
+ * @brief План дискретизации AD7380 за период PWM: N ∈ {32, 64, 100} от частоты PWM, TIM3, DMA, ядро усреднения.
+ * @details
+ * Один конфиг (meas_sampling_cfg_t) ⇒ один план (meas_sampling_plan_t), из которого берутся все зависимые
+ * величины, чтобы они не расходились между собой (MEASUREMENT_ARCHITECTURE §4.2, ADR-006):
+ * - `N` — наибольшее из {100, 64, 32}, при котором обработка кадров укладывается в бюджет CPU/DMA на период
+ *   (`N·frame_cost_ns <= T·budget_permille/1000`), частота кадров `f_pwm·N` не превышает `fs_max_hz`
+ *   (потолок SPI/DMA, 400 кГц по ADR-006) и окно CS помещается в шаг выборки;
+ * - TIM3: `ARR+1 = ceil(P/N)`, где `P = round(f_tim/f_pwm)` — тики периода TIM1. TIM3 сбрасывается TRGO TIM1,
+ *   поэтому события TIM3_UP приходят в `k·(ARR+1)`, `k = 0…N-1`, а N-е событие попадает на сброс или позже —
+ *   ровно N кадров за период при любом остатке деления; `CCR` = длительность CS LOW;
+ * - длина DMA (TIM3_UP→SPI1 TXDR, SPI1_RX, SPI2_RX) = N слов на период;
+ * - ядро усреднения — специализация под N (фиксированная длина цикла, раскрывается компилятором).
+ *
+ * Бюджет на период задаёт зависимость N от частоты: стоимость кадра (DMA SPI1/SPI2 RX по шине + ядро
+ * усреднения + разбор в measurement) почти постоянна, а период укорачивается с ростом f_pwm. По умолчанию
+ * (625 нс на кадр, 10% периода) — N=100 до 1.6 кГц, N=64 до 2.5 кГц, N=32 до 4 кГц (≤ 10% CPU на измерения
+ * при любой частоте). При 1 кГц с фиксированной частотой 400 кГц было бы 400 кадров на период; с планом — 100.
+ * Бюджет 1000‰ снимает ограничение по CPU (N ограничивают только `fs_max_hz` и окно CS).
+ *
+ * Перестройка плана — только в IDLE (PWM OFF, DMA остановлен): meas_sampling_reconfigure(). Порт после успешной
+ * перестройки перепрограммирует TIM3 и длины DMA из `plan`, а зависимые модули пересчитывают параметры,
+ * заданные в выборках/периодах (debounce meas_imax, `dt` control_core/meas_weld_acc).
+ */
+
+#define MEAS_SAMPLING_N_MAX (100u) /**< Максимум выборок за период (размер статических буферов DMA), [шт]. */
+#define MEAS_SAMPLING_PWM_MIN_HZ (1000u) /**< Нижняя граница частоты PWM, [Гц]. */
+#define MEAS_SAMPLING_PWM_MAX_HZ (4000u) /**< Верхняя граница частоты PWM, [Гц]. */
+#define MEAS_SAMPLING_FS_MAX_HZ (400000u) /**< Потолок частоты кадров AD7380 по ADR-006, [Гц]. */
+#define MEAS_SAMPLING_TIM_ARR_MAX (65536u) /**< Максимум `ARR+1` 16-бит TIM3, [тики]. */
+#define MEAS_SAMPLING_FRAME_COST_NS (625u) /**< Стоимость кадра CPU/DMA по умолчанию (оценка), [нс]. */
+#define MEAS_SAMPLING_BUDGET_PERMILLE (100u) /**< Доля периода PWM на измерения по умолчанию, [‰]. */
+
+/**
+ * @brief Суммы за период (целочисленные, без потери точности).
+ */
+typedef struct {
+  int32_t sum_i; /**< Σ (I_code - offset_i), [код]. */
+  int32_t sum_u; /**< Σ (U_code - offset_u), [код]. */
+  int64_t sum_iu; /**< Σ (I_code - offset_i)·(U_code - offset_u), [код²]. */
+} meas_sampling_sums_t;
+
+/**
+ * @brief Ядро суммирования за период (специализация под N плана).
+ * @param i Сырые коды тока, N выборок.
+ * @param u Сырые коды напряжения, N выборок.
+ * @param offset_i Смещение нуля тока, [код].
+ * @param offset_u Смещение нуля напряжения, [код].
+ * @param sums Суммы.
+ * @return None.
+ */
+typedef void (*meas_sampling_kernel_fn_t)(const int16_t *i, const int16_t *u, int32_t offset_i, int32_t offset_u,
+                                          meas_sampling_sums_t *sums);
+
+/**
+ * @brief Конфигурация дискретизации (единственный источник для TIM3/DMA/ядра).
+ */
+typedef struct {
+  uint32_t pwm_hz; /**< Частота PWM, [MEAS_SAMPLING_PWM_MIN_HZ..MEAS_SAMPLING_PWM_MAX_HZ], [Гц]. */
+  uint32_t tim_clk_hz; /**< Тактовая TIM1/TIM3, [Гц]. */
+  uint32_t fs_max_hz; /**< Потолок частоты кадров (0 ⇒ MEAS_SAMPLING_FS_MAX_HZ), [Гц]. */
+  uint32_t cs_low_ns; /**< Длительность CS LOW (16 SCK + запас), [нс]. */
+  uint32_t frame_cost_ns; /**< Стоимость кадра CPU/DMA (0 ⇒ MEAS_SAMPLING_FRAME_COST_NS), [нс]. */
+  uint32_t budget_permille; /**< Доля периода на измерения, (0..1000] (0 ⇒ MEAS_SAMPLING_BUDGET_PERMILLE), [‰]. */
+  float gain_i_a_per_code; /**< Масштаб канала тока, [A/код]. */
+  float gain_u_v_per_code; /**< Масштаб канала напряжения, [В/код]. */
+  int16_t offset_i_code; /**< Смещение нуля тока, [код]. */
+  int16_t offset_u_code; /**< Смещение нуля напряжения, [код]. */
+} meas_sampling_cfg_t;
+
+/**
+ * @brief План дискретизации (производные величины конфига).
+ */
+typedef struct {
+  uint16_t n; /**< Выборок за период, {32, 64, 100}, [шт]. */
+  uint16_t dma_len; /**< Длина DMA каждого канала за период (= n), [слова]. */
+  uint32_t tim1_period_ticks; /**< Тики периода PWM `P`, [тики]. */
+  uint32_t tim3_arr; /**< TIM3 ARR (`ceil(P/n) - 1`), [тики]. */
+  uint32_t tim3_ccr; /**< TIM3 CCR2 — длительность CS LOW, [тики]. */
+  uint32_t fs_hz; /**< Фактическая частота кадров `f_tim/(ARR+1)`, [Гц]. */
+  float dt_s; /**< Период PWM T, [с]. */
+  float inv_n; /**< 1/n, [1/шт]. */
+  float gain_i; /**< Масштаб тока, [A/код]. */
+  float gain_u; /**< Масштаб напряжения, [В/код]. */
+  int32_t offset_i; /**< Смещение нуля тока, [код]. */
+  int32_t offset_u; /**< Смещение нуля напряжения, [код]. */
+  meas_sampling_kernel_fn_t kernel; /**< Ядро суммирования под n. */
+} meas_sampling_plan_t;
+
+/**
+ * @brief Средние за период PWM.
+ */
+typedef struct {
+  float i_per; /**< Средний ток, [A]. */
+  float u_per; /**< Среднее напряжение, [В]. */
+  float p_per; /**< Средняя мгновенная мощность `mean(I·U)`, [Вт]. */
+} meas_sampling_period_t;
+
+/**
+ * @brief Состояние (активный план + счётчики перестроек).
+ */
+typedef struct {
+  meas_sampling_plan_t plan; /**< Активный план. */
+  bool valid; /**< План построен (иначе измерения не выполняются). */
+  uint32_t generation; /**< Номер плана (растёт на каждой успешной перестройке), [-]. */
+  uint32_t cnt_rejected; /**< Отклонённых перестроек (не IDLE/невалидный конфиг), [шт]. */
+} meas_sampling_t;
+
+/**
+ * @brief Построить план по конфигу (чистая функция).
+ * @param cfg Конфигурация.
+ * @param plan План (заполняется только при успехе).
+ * @return false при невалидном конфиге: PWM вне диапазона, `tim_clk_hz`/масштабы <= 0, `budget_permille > 1000`,
+ *         ни одно N не проходит по бюджету CPU/DMA, `fs_max_hz` или окну CS, `ARR+1` не помещается в 16 бит.
+ */
+bool meas_sampling_plan(const meas_sampling_cfg_t *cfg, meas_sampling_plan_t *plan);
+
+/**
+ * @brief Инициализировать состояние начальным планом.
+ * @param ctx Состояние.
+ * @param cfg Конфигурация.
+ * @return Результат meas_sampling_plan(); при false `ctx->valid=false`.
+ */
+bool meas_sampling_init(meas_sampling_t *ctx, const meas_sampling_cfg_t *cfg);
+
+/**
+ * @brief Перестроить план (смена частоты PWM/калибровки).
+ * @param ctx Состояние.
+ * @param cfg Новая конфигурация.
+ * @param idle true, если автомат в IDLE (PWM OFF, DMA остановлен).
+ * @return true — новый план активен (`generation++`); false — не IDLE или невалидный конфиг, активный план
+ *         не меняется (`cnt_rejected++`).
+ */
+bool meas_sampling_reconfigure(meas_sampling_t *ctx, const meas_sampling_cfg_t *cfg, bool idle);
+
+/**
+ * @brief Усреднить один период PWM (n выборок плана).
+ * @param plan Активный план.
+ * @param i Сырые коды тока, `plan->n` выборок.
+ * @param u Сырые коды напряжения, `plan->n` выборок.
+ * @param out Средние за период.
+ * @return None.
+ */
+void meas_sampling_aggregate(const meas_sampling_plan_t *plan, const int16_t *i, const int16_t *u,
+                             meas_sampling_period_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEAS_SAMPLING_H */
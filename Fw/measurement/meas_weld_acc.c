@@ -0,0 +1,158 @@
+#include "meas_weld_acc.h"
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief Записать u16 LE.
+ * @param dst Буфер.
+ * @param value Значение.
+ * @return None.
+ */
+static void meas_weld_put_u16(uint8_t *dst, uint16_t value)
+{
+  dst[0] = (uint8_t)(value & 0xFFu);
+  dst[1] = (uint8_t)(value >> 8);
+}
+
+/**
+ * @brief Записать u32 LE.
+ * @param dst Буфер.
+ * @param value Значение.
+ * @return None.
+ */
+static void meas_weld_put_u32(uint8_t *dst, uint32_t value)
+{
+  dst[0] = (uint8_t)(value & 0xFFu);
+  dst[1] = (uint8_t)((value >> 8) & 0xFFu);
+  dst[2] = (uint8_t)((value >> 16) & 0xFFu);
+  dst[3] = (uint8_t)(value >> 24);
+}
+
+/**
+ * @brief Записать float (IEEE-754 binary32) LE.
+ * @param dst Буфер.
+ * @param value Значение.
+ * @return None.
+ */
+static void meas_weld_put_f32(uint8_t *dst, float value)
+{
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  meas_weld_put_u32(dst, bits);
+}
+
+void meas_ksum_add(meas_ksum_t *acc, float value)
+{
+  // Neumaier: потерянная часть берётся от меньшего по модулю операнда, поэтому компенсация
+  // корректна и когда слагаемое больше накопленной суммы (в отличие от классического Kahan).
+  const float t = acc->sum + value;
+  if (fabsf(acc->sum) >= fabsf(value))
+  {
+    acc->comp += (acc->sum - t) + value;
+  }
+  else
+  {
+    acc->comp += (value - t) + acc->sum;
+  }
+  acc->sum = t;
+}
+
+float meas_ksum_value(const meas_ksum_t *acc)
+{
+  return acc->sum + acc->comp;
+}
+
+bool meas_weld_acc_init(meas_weld_acc_t *acc, float dt)
+{
+  const meas_weld_acc_t zero = {0};
+  *acc = zero;
+  if (!isfinite(dt) || (dt <= 0.0f))
+  {
+    return false;
+  }
+  acc->dt = dt;
+  return true;
+}
+
+void meas_weld_acc_begin(meas_weld_acc_t *acc)
+{
+  const meas_ksum_t ksum_zero = {0};
+  acc->energy = ksum_zero;
+  acc->charge = ksum_zero;
+  acc->i_peak = 0.0f;
+  acc->periods = 0u;
+  acc->limit_periods = 0u;
+  acc->invalid_periods = 0u;
+  acc->weld_id = (uint16_t)(acc->weld_id + 1u);
+  acc->weld_id = (uint16_t)(acc->weld_id + (uint16_t)(acc->weld_id == 0u));
+  acc->active = (acc->dt > 0.0f);
+}
+
+void meas_weld_acc_step(meas_weld_acc_t *acc, float i_per, float p_per, bool limit, bool valid)
+{
+  if (!acc->active)
+  {
+    return;
+  }
+  if (!valid || !isfinite(i_per) || !isfinite(p_per))
+  {
+    acc->invalid_periods++;
+    return;
+  }
+
+  // Шаг 1: Интегралы за период (прямоугольник: среднее за период · T).
+  meas_ksum_add(&acc->energy, p_per * acc->dt);
+  meas_ksum_add(&acc->charge, i_per * acc->dt);
+
+  // Шаг 2: Пик, счётчики.
+  const float i_abs = fabsf(i_per); /* [A] */
+  acc->i_peak = (i_abs > acc->i_peak) ? i_abs : acc->i_peak;
+  acc->periods++;
+  acc->limit_periods += (uint32_t)limit;
+}
+
+void meas_weld_acc_snapshot(const meas_weld_acc_t *acc, meas_weld_report_t *report)
+{
+  const float charge = meas_ksum_value(&acc->charge); /* [A·с] */
+  const float duration = (float)acc->periods * acc->dt; /* [с] */
+  report->weld_id = acc->weld_id;
+  report->done = false;
+  report->periods = acc->periods;
+  report->limit_periods = acc->limit_periods;
+  report->invalid_periods = acc->invalid_periods;
+  report->energy_j = meas_ksum_value(&acc->energy);
+  report->charge_c = charge;
+  report->i_peak_a = acc->i_peak;
+  report->i_mean_a = (duration > 0.0f) ? (charge / duration) : 0.0f;
+}
+
+bool meas_weld_acc_end(meas_weld_acc_t *acc, meas_weld_report_t *report)
+{
+  if (!acc->active)
+  {
+    return false;
+  }
+  meas_weld_acc_snapshot(acc, &acc->last);
+  acc->last.done = true;
+  acc->active = false;
+  if (report != NULL)
+  {
+    *report = acc->last;
+  }
+  return true;
+}
+
+void meas_weld_report_pack(const meas_weld_report_t *report, uint8_t data[MEAS_WELD_REPORT_LEN])
+{
+  meas_weld_put_u16(&data[0], report->weld_id);
+  meas_weld_put_u16(&data[2], (uint16_t)report->done);
+  meas_weld_put_u32(&data[4], report->periods);
+  meas_weld_put_f32(&data[8], report->energy_j);
+  meas_weld_put_f32(&data[12], report->charge_c);
+  meas_weld_put_f32(&data[16], report->i_peak_a);
+  meas_weld_put_f32(&data[20], report->i_mean_a);
+  meas_weld_put_u32(&data[24], report->limit_periods);
+  meas_weld_put_u32(&data[28], report->invalid_periods);
+}
@@ -0,0 +1,142 @@
+#ifndef MEAS_WELD_ACC_H
+#define MEAS_WELD_ACC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file meas_weld_acc.h
+ * @brief Накопители на сварку: энергия Σ P_per·T, заряд Σ I_per·T, пик/среднее тока, периоды LIMIT.
+ * @details
+ * Домен: fast (один вызов meas_weld_acc_step() на период PWM, O(1), без делений), отчёт — slow.
+ *
+ * Суммы энергии и заряда ведутся в float32 с компенсацией (Neumaier/Kahan–Babuška): при 50 кА и
+ * T = 250 мкс слагаемое заряда 12.5 A·с, а за сварку в сотни тысяч периодов наивная float-сумма теряет
+ * младшие разряды (ошибка растёт ~ n·eps·S), компенсированная — остаётся на уровне eps·S.
+ * Компенсация требует строгой IEEE-семантики сложения: модуль нельзя собирать с `-ffast-math`
+ * (`-ffp-contract` безопасен — в компенсирующих выражениях нет умножений).
+ *
+ * Отчёт публикуется без стриминга выборок:
+ * - PCcom4 `WeldReport.Last` — полный отчёт (meas_weld_report_pack(), 32 байта LE);
+ * - `FB_STATUS` — компактная выжимка (`weld_id`, энергия [мДж], заряд [мА·с], периоды LIMIT) из `last`;
+ *   отображение в кадр — протокольный слой (tk_fb_weld_fill_status()), измерения от кодека PDO не зависят.
+ */
+
+#define MEAS_WELD_REPORT_LEN (32u) /**< Длина payload PCcom4 `WeldReport.Last`, [байт]. */
+
+/**
+ * @brief Компенсированная сумма (значение = sum + comp).
+ */
+typedef struct {
+  float sum; /**< Накопленная сумма, [ед. слагаемого]. */
+  float comp; /**< Накопленная компенсация потерянных младших разрядов, [ед. слагаемого]. */
+} meas_ksum_t;
+
+/**
+ * @brief Отчёт сварки.
+ */
+typedef struct {
+  uint16_t weld_id; /**< Номер сварки (1..65535, 0 — отчёта нет), [-]. */
+  bool done; /**< true — сварка завершена; false — промежуточный снимок. */
+  uint32_t periods; /**< Периодов с валидными измерениями, [периоды PWM]. */
+  uint32_t limit_periods; /**< Периодов в LIMIT (насыщение регулятора/пределы), [периоды PWM]. */
+  uint32_t invalid_periods; /**< Периодов с невалидными измерениями (не учтены в суммах), [периоды PWM]. */
+  float energy_j; /**< Энергия Σ P_per·T, [Дж]. */
+  float charge_c; /**< Заряд Σ I_per·T, [A·с]. */
+  float i_peak_a; /**< Максимум |I_per|, [A]. */
+  float i_mean_a; /**< Средний ток за валидные периоды, [A]. */
+} meas_weld_report_t;
+
+/**
+ * @brief Состояние накопителя.
+ */
+typedef struct {
+  float dt; /**< Период PWM T, [с]. */
+  bool active; /**< Идёт сварка (между begin и end). */
+  meas_ksum_t energy; /**< Σ P_per·T, [Дж]. */
+  meas_ksum_t charge; /**< Σ I_per·T, [A·с]. */
+  float i_peak; /**< Максимум |I_per|, [A]. */
+  uint32_t periods; /**< Валидных периодов, [периоды PWM]. */
+  uint32_t limit_periods; /**< Периодов LIMIT, [периоды PWM]. */
+  uint32_t invalid_periods; /**< Невалидных периодов, [периоды PWM]. */
+  uint16_t weld_id; /**< Номер текущей/последней сварки, [-]. */
+  meas_weld_report_t last; /**< Отчёт последней завершённой сварки. */
+} meas_weld_acc_t;
+
+/**
+ * @brief Добавить слагаемое в компенсированную сумму (Neumaier).
+ * @param acc Сумма.
+ * @param value Слагаемое (NaN/Inf не допускаются — фильтрует вызывающий).
+ * @return None.
+ */
+void meas_ksum_add(meas_ksum_t *acc, float value);
+
+/**
+ * @brief Значение компенсированной суммы.
+ * @param acc Сумма.
+ * @return `sum + comp`.
+ */
+float meas_ksum_value(const meas_ksum_t *acc);
+
+/**
+ * @brief Инициализировать накопитель (отчёта нет, `weld_id=0`).
+ * @param acc Состояние.
+ * @param dt Период PWM, (0..∞), [с].
+ * @return false при невалидном dt (тогда шаги игнорируются).
+ */
+bool meas_weld_acc_init(meas_weld_acc_t *acc, float dt);
+
+/**
+ * @brief Начать сварку: обнулить суммы, выдать новый `weld_id` (0 пропускается при wrap-around).
+ * @param acc Состояние.
+ * @return None.
+ * @note Вызывается на фронте разрешения сварки; повторный begin без end начинает новую сварку.
+ */
+void meas_weld_acc_begin(meas_weld_acc_t *acc);
+
+/**
+ * @brief Учесть один период PWM.
+ * @param acc Состояние.
+ * @param i_per Средний ток за период, [A].
+ * @param p_per Средняя мощность за период `mean(I·U)`, [Вт].
+ * @param limit true, если период прошёл в LIMIT (насыщение/пределы регулятора).
+ * @param valid Признак валидности измерений периода.
+ * @return None.
+ * @note Вне begin/end — no-op. Невалидный период или NaN/Inf в `i_per/p_per` ⇒ `invalid_periods++`,
+ *       суммы не меняются.
+ */
+void meas_weld_acc_step(meas_weld_acc_t *acc, float i_per, float p_per, bool limit, bool valid);
+
+/**
+ * @brief Снимок текущих сумм (сварка продолжается; `done=false`).
+ * @param acc Состояние.
+ * @param report Отчёт.
+ * @return None.
+ */
+void meas_weld_acc_snapshot(const meas_weld_acc_t *acc, meas_weld_report_t *report);
+
+/**
+ * @brief Завершить сварку и зафиксировать отчёт (`acc->last`).
+ * @param acc Состояние.
+ * @param report Отчёт (может быть NULL).
+ * @return false, если сварка не была начата (отчёт не меняется).
+ */
+bool meas_weld_acc_end(meas_weld_acc_t *acc, meas_weld_report_t *report);
+
+/**
+ * @brief Закодировать отчёт в payload PCcom4 `WeldReport.Last` (LE, см. PCCOM4.02_PROJECT §3.4.3).
+ * @param report Отчёт.
+ * @param data Буфер MEAS_WELD_REPORT_LEN байт.
+ * @return None.
+ */
+void meas_weld_report_pack(const meas_weld_report_t *report, uint8_t data[MEAS_WELD_REPORT_LEN]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEAS_WELD_ACC_H */
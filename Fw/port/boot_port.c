@@ -0,0 +1,265 @@
+#include "boot_port.h"
+
+#include <stdatomic.h>
+
+#include "FreeRTOS.h"
+#include "main.h"
+#include "task.h"
+
+#include "comx_fmc_port.h"
+#include "dwt_timebase.h"
+#include "settings_flash_port.h"
+
+extern TIM_HandleTypeDef htim1;
+
+/**
+ * @brief Пункты старта (индексы таблицы).
+ */
+enum {
+  BOOT_PORT_SAFE_OUTPUTS = 0,
+  BOOT_PORT_WATCHDOG = 1,
+  BOOT_PORT_COMX = 2,
+  BOOT_PORT_NVM = 3,
+  BOOT_PORT_N = 4
+};
+
+static bool boot_port_safe_outputs(void);
+static bool boot_port_watchdog(void);
+static bool boot_port_comx(void);
+static bool boot_port_nvm(void);
+
+/**
+ * @brief Таблица старта: критичные пункты первыми, медленные — параллельно.
+ * @note COMX необязателен: отказ/таймаут — degraded, восстановление (сброс COMX, handshake) ведёт task обмена.
+ */
+static const boot_item_desc_t s_items[BOOT_PORT_N] = {
+  {"safe_outputs", true, true, 0u, 0u},
+  {"watchdog", true, true, 0u, 0u},
+  {"comx", false, false, 0u, COMX_DPM_READY_TIMEOUT_US},
+  {"nvm", false, true, 0u, 200000u},
+};
+
+/**
+ * @brief Функции пунктов (индексы совпадают с s_items).
+ */
+static bool (*const s_item_fn[BOOT_PORT_N])(void) = {
+  boot_port_safe_outputs,
+  boot_port_watchdog,
+  boot_port_comx,
+  boot_port_nvm,
+};
+
+static boot_seq_t s_boot; /**< Контекст старта. */
+static atomic_bool s_ready; /**< READY опубликован. */
+static bool s_early_kick; /**< Первый kick выполнен из MX_GPIO_Init(). */
+static atomic_uint s_alive_mask; /**< Источники, подавшие хотя бы один признак жизни, [битовая маска]. */
+static atomic_uint s_alive_us[BOOT_PORT_ALIVE_N]; /**< Последний признак жизни источника, [мкс]. */
+static uint32_t s_cnt_wdg_withheld; /**< Проходов supervisor без kick (FAULT/устаревший источник), [шт]. */
+
+/**
+ * @brief Kick внешнего watchdog (переключение EXTWDG_OUT).
+ * @return None.
+ */
+static void boot_port_wdg_kick(void)
+{
+  HAL_GPIO_TogglePin(EXTWDG_OUT_GPIO_Port, EXTWDG_OUT_Pin);
+}
+
+/**
+ * @brief Safe outputs: MOE OFF (выходы TIM1 в idle-уровне), break включён.
+ * @return true, если break TIM1 активен.
+ * @note Повторяет boot_port_early_safe_outputs() (идемпотентно) и проверяет результат для профиля.
+ */
+static bool boot_port_safe_outputs(void)
+{
+  boot_port_early_safe_outputs();
+  return ((htim1.Instance->BDTR & TIM_BDTR_MOE) == 0u) && ((htim1.Instance->BDTR & TIM_BDTR_BKE) != 0u);
+}
+
+/**
+ * @brief Проверка первого kick из MX_GPIO_Init() (далее — boot task, пока старт продвигается).
+ * @return true, если первый kick уже был.
+ */
+static bool boot_port_watchdog(void)
+{
+  boot_port_wdg_kick();
+  return s_early_kick;
+}
+
+/**
+ * @brief COMX: снять сброс, запустить task обмена, дождаться NETX_READY (handshake host ↔ netX).
+ * @return false, если ядро DPM не инициализировано или NETX_READY нет за COMX_DPM_READY_TIMEOUT_US.
+ * @note Мастер EtherCAT/переход в OP от старта не зависят; ERROR до NETX_READY восстанавливает task обмена
+ *       (сброс COMX) и после выхода пункта. Ожидание ограничено таймаутом пункта: task пункта не остаётся
+ *       висеть после того, как boot_seq отметил TIMEOUT.
+ */
+static bool boot_port_comx(void)
+{
+  if (!comx_fmc_port_init())
+  {
+    return false;
+  }
+  (void)xTaskCreate(comx_fmc_port_task, "comx", 2u * configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 3, NULL);
+  const uint32_t t_start = dwt_timebase_now_us(); /* [мкс] */
+  while (!comx_fmc_port_netx_ready())
+  {
+    if ((dwt_timebase_now_us() - t_start) >= COMX_DPM_READY_TIMEOUT_US)
+    {
+      return false;
+    }
+    vTaskDelay(pdMS_TO_TICKS(1u));
+  }
+  return true;
+}
+
+/**
+ * @brief Загрузка NVM: монтирование settings_store (проход журнала + CRC).
+ * @return true, если хранилище смонтировано (пустое — defaults + диагностический флаг).
+ */
+static bool boot_port_nvm(void)
+{
+  return settings_flash_port_mount();
+}
+
+/**
+ * @brief Все наблюдаемые источники подали признак жизни не позже BOOT_PORT_ALIVE_TIMEOUT_MS назад.
+ * @param now_us Текущее время, [мкс].
+ * @return true, если kick разрешён.
+ */
+static bool boot_port_alive_fresh(uint32_t now_us)
+{
+  const uint32_t mask = atomic_load(&s_alive_mask);
+  for (uint32_t i = 0u; i < BOOT_PORT_ALIVE_N; ++i)
+  {
+    if (((mask & (1u << i)) != 0u) && ((now_us - atomic_load(&s_alive_us[i])) > (BOOT_PORT_ALIVE_TIMEOUT_MS * 1000u)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Task пункта: выполнить и отметить завершение.
+ * @param argument Индекс пункта.
+ * @return None (task удаляется).
+ */
+static void boot_port_item_task(void *argument)
+{
+  const uint32_t idx = (uint32_t)(uintptr_t)argument;
+  const bool ok = s_item_fn[idx]();
+  (void)boot_seq_end(&s_boot, idx, ok, dwt_timebase_now_us());
+  vTaskDelete(NULL);
+}
+
+/**
+ * @brief Boot task: таймауты/фаза, запуск готовых пунктов; далее — supervisor внешнего watchdog.
+ * @param argument Не используется.
+ * @return None (не возвращается).
+ */
+static void boot_port_task(void *argument)
+{
+  (void)argument;
+  TickType_t wake = xTaskGetTickCount();
+  for (;;)
+  {
+    const uint32_t now = dwt_timebase_now_us();
+    const boot_phase_t phase = boot_seq_poll(&s_boot, now);
+
+    // SAFETY: kick только пока старт продвигается (зависший пункт уводит в FAULT по таймауту boot_seq) и после
+    // READY — пока все наблюдаемые task живы. FAULT и зависший task ⇒ без kick, внешний watchdog сбрасывает МК.
+    const bool kick = (phase == BOOT_PHASE_CRITICAL) || (phase == BOOT_PHASE_BRINGUP) ||
+                      ((phase == BOOT_PHASE_READY) && boot_port_alive_fresh(now));
+    if (kick)
+    {
+      boot_port_wdg_kick();
+    }
+    else
+    {
+      s_cnt_wdg_withheld++;
+    }
+
+    if (phase == BOOT_PHASE_READY)
+    {
+      atomic_store(&s_ready, true);
+    }
+    const uint32_t next = boot_seq_next(&s_boot);
+    for (uint32_t i = 0u; i < BOOT_PORT_N; ++i)
+    {
+      if (((next & (1u << i)) != 0u) && boot_seq_begin(&s_boot, i, now))
+      {
+        (void)xTaskCreate(boot_port_item_task, s_items[i].name, 2u * configMINIMAL_STACK_SIZE, (void *)(uintptr_t)i,
+                          tskIDLE_PRIORITY + 2, NULL);
+      }
+    }
+    vTaskDelayUntil(&wake, pdMS_TO_TICKS(BOOT_PORT_POLL_MS));
+  }
+}
+
+void boot_port_early_watchdog(void)
+{
+  boot_port_wdg_kick();
+  s_early_kick = true;
+}
+
+void boot_port_early_safe_outputs(void)
+{
+  __HAL_TIM_MOE_DISABLE_UNCONDITIONALLY(&htim1);
+}
+
+bool boot_port_start(void)
+{
+  dwt_timebase_init();
+
+  const uint32_t reset_cause = RCC->CSR & 0xFF000000u;
+  __HAL_RCC_CLEAR_RESET_FLAGS();
+  atomic_store(&s_ready, false);
+  (void)boot_seq_init(&s_boot, s_items, BOOT_PORT_N, reset_cause, 0u);
+
+  // Шаг 1: Критичные пункты — синхронно, по порядку таблицы, до старта планировщика.
+  uint32_t next = boot_seq_next(&s_boot);
+  while (next != 0u)
+  {
+    for (uint32_t i = 0u; i < BOOT_PORT_N; ++i)
+    {
+      if (((next & (1u << i)) != 0u) && s_items[i].critical && boot_seq_begin(&s_boot, i, dwt_timebase_now_us()))
+      {
+        (void)boot_seq_end(&s_boot, i, s_item_fn[i](), dwt_timebase_now_us());
+      }
+    }
+    if (boot_seq_poll(&s_boot, dwt_timebase_now_us()) != BOOT_PHASE_CRITICAL)
+    {
+      break;
+    }
+    next = boot_seq_next(&s_boot);
+  }
+
+  // Шаг 2: Boot task запускает медленные пункты параллельно и затем остаётся supervisor внешнего watchdog.
+  (void)xTaskCreate(boot_port_task, "boot", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 4, NULL);
+  return s_boot.phase != BOOT_PHASE_FAULT;
+}
+
+void boot_port_alive(uint32_t src)
+{
+  if (src >= BOOT_PORT_ALIVE_N)
+  {
+    return;
+  }
+  atomic_store(&s_alive_us[src], dwt_timebase_now_us());
+  (void)atomic_fetch_or(&s_alive_mask, 1u << src);
+}
+
+bool boot_port_ready(void)
+{
+  return atomic_load(&s_ready);
+}
+
+uint32_t boot_port_wdg_withheld_count(void)
+{
+  return s_cnt_wdg_withheld;
+}
+
+const boot_seq_t *boot_port_profile(void)
+{
+  return &s_boot;
+}
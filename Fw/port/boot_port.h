@@ -0,0 +1,92 @@
+#ifndef BOOT_PORT_H
+#define BOOT_PORT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "boot_seq.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file boot_port.h
+ * @brief Glue поэтапного старта (target-only): критичные пункты в main(), медленная инициализация — task на пункт,
+ *        затем supervisor внешнего watchdog.
+ * @details
+ * Порядок:
+ * 1. main(): MX_GPIO_Init() → boot_port_early_watchdog() (первый kick), MX_TIM1_Init() →
+ *    boot_port_early_safe_outputs() (MOE OFF до MspPostInit выводов TIM1); после всех MX_*_Init() —
+ *    boot_port_start(): причина сброса (RCC_CSR), критичные пункты проверяют safe outputs и первый kick.
+ * 2. boot task (после старта планировщика): boot_seq_poll(), запуск готовых пунктов — каждый в своём task:
+ *    COMX (до NETX_READY, необязательный), загрузка NVM. Kick каждые BOOT_PORT_POLL_MS, пока фаза CRITICAL/BRINGUP
+ *    (зависший пункт уводит в FAULT по таймауту boot_seq).
+ * 3. READY ⇒ boot_port_ready() = true; boot task становится supervisor: kick, только если каждый task, подавший
+ *    boot_port_alive(), делал это не позже BOOT_PORT_ALIVE_TIMEOUT_MS назад.
+ * 4. FAULT ⇒ энергия запрещена (PWM OFF), kick прекращается — внешний watchdog сбрасывает МК.
+ *
+ * Timebase профиля — dwt_timebase (DWT CYCCNT от входа в main(), расширенный до мкс, wrap-safe).
+ */
+
+#define BOOT_PORT_POLL_MS (1u) /**< Период boot task/supervisor, [мс]. */
+#define BOOT_PORT_ALIVE_TIMEOUT_MS (100u) /**< Предел давности признака жизни task после READY, [мс]. */
+
+/**
+ * @brief Источники признака жизни для supervisor watchdog.
+ */
+enum {
+  BOOT_PORT_ALIVE_APP = 0, /**< Прикладной task (main.c). */
+  BOOT_PORT_ALIVE_COMX = 1, /**< Task обмена PDO (comx_fmc_port). */
+  BOOT_PORT_ALIVE_N = 2
+};
+
+/**
+ * @brief Первый kick внешнего watchdog. Вызывать в конце MX_GPIO_Init() (USER CODE MX_GPIO_Init_2).
+ * @return None.
+ */
+void boot_port_early_watchdog(void);
+
+/**
+ * @brief Safe outputs TIM1 (MOE OFF). Вызывать в конце MX_TIM1_Init() (USER CODE TIM1_Init 2).
+ * @return None.
+ */
+void boot_port_early_safe_outputs(void);
+
+/**
+ * @brief Критичные пункты (синхронно) и создание boot task. Вызывать до vTaskStartScheduler().
+ * @return false, если критичный пункт не выполнен (FAULT; boot task создаётся для профиля, kick не выполняет).
+ */
+bool boot_port_start(void);
+
+/**
+ * @brief Признак жизни task (из цикла task, период заметно меньше BOOT_PORT_ALIVE_TIMEOUT_MS).
+ * @param src Источник BOOT_PORT_ALIVE_*.
+ * @return None.
+ * @note Источник наблюдается с первого вызова: task, который не стартовал, kick не блокирует.
+ */
+void boot_port_alive(uint32_t src);
+
+/**
+ * @brief Признак READY (все обязательные пункты выполнены).
+ * @return true после READY.
+ */
+bool boot_port_ready(void);
+
+/**
+ * @brief Профиль старта (diag/PCcom4).
+ * @return Указатель на контекст старта.
+ */
+const boot_seq_t *boot_port_profile(void);
+
+/**
+ * @brief Диагностика: проходов supervisor без kick (FAULT или устаревший признак жизни).
+ * @return Счётчик, [шт].
+ */
+uint32_t boot_port_wdg_withheld_count(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BOOT_PORT_H */
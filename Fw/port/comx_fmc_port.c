@@ -0,0 +1,152 @@
+#include "comx_fmc_port.h"
+
+#include "FreeRTOS.h"
+#include "main.h"
+#include "task.h"
+
+#include "boot_port.h"
+#include "dwt_timebase.h"
+#include "tk_pdo_codec.h"
+
+#define COMX_FMC_PORT_POLL_TICKS (pdMS_TO_TICKS(1u)) /**< Опрос при отсутствии IRQ (handshake), [тик]. */
+#define COMX_FMC_PORT_RESET_PULSE_MS (10u) /**< Импульс COMX_RESET (активный низкий), [мс]. */
+#define COMX_FMC_PORT_BACKOFF_MIN_MS (100u) /**< Пауза перед первым сбросом COMX из ERROR, [мс]. */
+#define COMX_FMC_PORT_BACKOFF_MAX_MS (5000u) /**< Предел паузы между сбросами COMX, [мс]. */
+
+static comms_dpm_t s_dpm; /**< Ядро DPM. */
+static TaskHandle_t s_task; /**< Task обмена PDO (цель notify из ISR). */
+static uint32_t s_backoff_ms = COMX_FMC_PORT_BACKOFF_MIN_MS; /**< Пауза перед следующим сбросом COMX, [мс]. */
+static uint32_t s_cnt_comx_reset; /**< Сбросов COMX из ERROR, [шт]. */
+static bool s_recover_armed; /**< Пауза перед сбросом COMX идёт. */
+static uint32_t s_recover_at_us; /**< Момент сброса COMX (вход в ERROR + backoff), [мкс]. */
+
+/**
+ * @brief Timebase DPM (общий wrap-safe DWT timebase портов).
+ * @param user Не используется.
+ * @return Монотонное время, [мкс] (wrap по модулю 2^32).
+ */
+static uint32_t comx_fmc_port_now_us(void *user)
+{
+  (void)user;
+  return dwt_timebase_now_us();
+}
+
+/**
+ * @brief Восстановление из ERROR: пауза с экспоненциальным backoff, импульс COMX_RESET, рестарт handshake.
+ * @return None.
+ * @note Пауза удваивается до COMX_FMC_PORT_BACKOFF_MAX_MS и сбрасывается на LINK_UP: неисправный COMX
+ *       не перезапускается непрерывно, а восстановившийся снова получает короткую паузу. Пауза отсчитывается
+ *       по проходам task (без блокировки): признак жизни для supervisor watchdog не прерывается.
+ */
+static void comx_fmc_port_recover(void)
+{
+  const uint32_t now = dwt_timebase_now_us();
+  if (!s_recover_armed)
+  {
+    s_recover_armed = true;
+    s_recover_at_us = now + (s_backoff_ms * 1000u);
+    return;
+  }
+  if ((int32_t)(now - s_recover_at_us) < 0)
+  {
+    return;
+  }
+  s_recover_armed = false;
+  s_backoff_ms = ((2u * s_backoff_ms) < COMX_FMC_PORT_BACKOFF_MAX_MS) ? (2u * s_backoff_ms)
+                                                                       : COMX_FMC_PORT_BACKOFF_MAX_MS;
+
+  HAL_GPIO_WritePin(COMX_RESET_GPIO_Port, COMX_RESET_Pin, GPIO_PIN_RESET);
+  vTaskDelay(pdMS_TO_TICKS(COMX_FMC_PORT_RESET_PULSE_MS));
+  HAL_GPIO_WritePin(COMX_RESET_GPIO_Port, COMX_RESET_Pin, GPIO_PIN_SET);
+  s_cnt_comx_reset++;
+  comms_dpm_restart(&s_dpm);
+}
+
+/**
+ * @brief Адрес слова в окне DPM.
+ * @param offset Смещение от базы bank1, [байт].
+ * @return Указатель на слово DPM.
+ */
+static volatile uint32_t *comx_fmc_port_word(uint32_t offset)
+{
+  return (volatile uint32_t *)(COMX_FMC_BANK1_BASE + offset);
+}
+
+bool comx_fmc_port_init(void)
+{
+  // CYCCNT не обнуляется: счётчик уже идёт с boot_port_start() (профиль старта).
+  dwt_timebase_init();
+
+  const comms_dpm_io_t io = {
+    .rx_area = comx_fmc_port_word(COMX_DPM_RX_AREA_OFS),
+    .tx_area = comx_fmc_port_word(COMX_DPM_TX_AREA_OFS),
+    .netx_flags = comx_fmc_port_word(COMX_DPM_NETX_FLAGS_OFS),
+    .host_flags = comx_fmc_port_word(COMX_DPM_HOST_FLAGS_OFS),
+    .now_us = comx_fmc_port_now_us,
+    .user = NULL
+  };
+  const comms_dpm_cfg_t cfg = {
+    .rx_words = TK_PDO_CMD_WELD_SIZE_WORDS,
+    .tx_words = TK_PDO_FB_STATUS_SIZE_WORDS,
+    .ready_timeout_us = COMX_DPM_READY_TIMEOUT_US,
+    .latency_budget_us = COMX_DPM_LATENCY_BUDGET_US
+  };
+
+  HAL_GPIO_WritePin(COMX_RESET_GPIO_Port, COMX_RESET_Pin, GPIO_PIN_SET);
+  return comms_dpm_init(&s_dpm, &io, &cfg);
+}
+
+void comx_fmc_port_exti_isr(uint16_t gpio_pin)
+{
+  if ((gpio_pin != COMX_IRQ_Pin) || (s_task == NULL))
+  {
+    return;
+  }
+
+  // SAFETY: в ISR нет доступа к FMC/DPM — только метка времени и notify task.
+  BaseType_t woken = pdFALSE;
+  comms_dpm_irq_mark(&s_dpm, comx_fmc_port_now_us(NULL));
+  vTaskNotifyGiveFromISR(s_task, &woken);
+  portYIELD_FROM_ISR(woken);
+}
+
+void comx_fmc_port_task(void *argument)
+{
+  (void)argument;
+  s_task = xTaskGetCurrentTaskHandle();
+
+  for (;;)
+  {
+    (void)ulTaskNotifyTake(pdTRUE, COMX_FMC_PORT_POLL_TICKS);
+    boot_port_alive(BOOT_PORT_ALIVE_COMX);
+
+    // Командный путь (CMD_WELD → tk_cmd_rx → control_core, supervisor tk_cmd_timeout на каждом проходе, FB_STATUS)
+    // подключается вместе с интеграцией control_core на target: без потребителя команд task не подтверждает
+    // `seq_applied`, а рампа soft-timeout не имеет адресата.
+    if (comms_dpm_service(&s_dpm) == COMMS_DPM_EVT_LINK_UP)
+    {
+      s_backoff_ms = COMX_FMC_PORT_BACKOFF_MIN_MS;
+    }
+
+    // ERROR (netX не READY дольше таймаута) — не тупик: сброс COMX и новый handshake.
+    if (s_dpm.state == COMMS_DPM_STATE_ERROR)
+    {
+      comx_fmc_port_recover();
+    }
+  }
+}
+
+const comms_dpm_t *comx_fmc_port_dpm(void)
+{
+  return &s_dpm;
+}
+
+bool comx_fmc_port_netx_ready(void)
+{
+  return (*comx_fmc_port_word(COMX_DPM_NETX_FLAGS_OFS) & COMMS_DPM_NETX_READY) != 0u;
+}
+
+uint32_t comx_fmc_port_reset_count(void)
+{
+  return s_cnt_comx_reset;
+}
@@ -0,0 +1,85 @@
+#ifndef COMX_FMC_PORT_H
+#define COMX_FMC_PORT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "comms_dpm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file comx_fmc_port.h
+ * @brief Glue COMX 100CA-RE ↔ FMC (target-only): окно DPM, EXTI COMX_IRQ, task обмена PDO.
+ * @details
+ * - ISR (EXTI COMX_IRQ): comx_fmc_port_exti_isr() — метка времени + notify task, без доступа к FMC;
+ * - task: comms_dpm_service() (handshake, копия/публикация RxPDO, метрики); ERROR (netX не READY дольше
+ *   COMX_DPM_READY_TIMEOUT_US) — импульс COMX_RESET и comms_dpm_restart() с экспоненциальным backoff (без
+ *   блокировки task: каждый проход подаёт boot_port_alive() для supervisor watchdog).
+ *   Мастер не в OP / потеря линка при живом netX — не ERROR: ожидание COMM_RUN без таймаута.
+ * Командный путь (tk_pdo_cmd_weld_unpack() → tk_cmd_rx_process() → control_core, tk_cmd_timeout_tick() на каждом
+ * проходе, FB_STATUS → comms_dpm_tx_write()) подключается вместе с интеграцией control_core на target: до этого
+ * команды не подтверждаются (`seq_applied`), а supervisor таймаутов не запускается (рампе некуда публиковать).
+ * COMX_IRQ = PA0/EXTI0 (EXTI0_IRQHandler → HAL_GPIO_EXTI_Callback()); NVIC-приоритет 5 — численно
+ * >= configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY (FreeRTOS API из ISR).
+ */
+
+#define COMX_FMC_BANK1_BASE (0x60000000u) /**< База FMC NOR/SRAM bank1 (NE1), [адрес]. */
+
+/* Смещения областей DPM (TBD: зафиксировать по DPM-описанию COMX/ESI, см. DN-007). */
+#define COMX_DPM_NETX_FLAGS_OFS (0x0200u) /**< Слово флагов netX → host, [байт]. */
+#define COMX_DPM_HOST_FLAGS_OFS (0x0204u) /**< Слово флагов host → netX, [байт]. */
+#define COMX_DPM_RX_AREA_OFS (0x1000u) /**< Входной образ (RxPDO, CMD_WELD), [байт]. */
+#define COMX_DPM_TX_AREA_OFS (0x1100u) /**< Выходной образ (TxPDO, FB_STATUS), [байт]. */
+
+#define COMX_DPM_READY_TIMEOUT_US (2000000u) /**< Таймаут NETX_READY после сброса/пропадания, [мкс]. */
+#define COMX_DPM_LATENCY_BUDGET_US (50u) /**< Бюджет `COMX_IRQ → образ опубликован`, [мкс]. */
+
+/**
+ * @brief Инициализировать glue: timebase (dwt_timebase), ядро DPM, снять COMX_RESET.
+ * @return true, если ядро DPM инициализировано.
+ * @note Вызывается пунктом старта `comx` (boot_port) до создания comx_fmc_port_task(), после MX_FMC_Init()/MX_GPIO_Init().
+ */
+bool comx_fmc_port_init(void);
+
+/**
+ * @brief Обработчик COMX_IRQ (вызывается из HAL_GPIO_EXTI_Callback()).
+ * @param gpio_pin Пин, вызвавший EXTI.
+ * @return None.
+ * @warning ISR-контекст: только метка времени и notify.
+ */
+void comx_fmc_port_exti_isr(uint16_t gpio_pin);
+
+/**
+ * @brief Тело FreeRTOS task обмена PDO.
+ * @param argument Не используется.
+ * @return None (не возвращается).
+ */
+void comx_fmc_port_task(void *argument);
+
+/**
+ * @brief Доступ к ядру DPM (метрики для diag/`TkPdo.Emu.Stats`).
+ * @return Указатель на контекст ядра DPM.
+ */
+const comms_dpm_t *comx_fmc_port_dpm(void);
+
+/**
+ * @brief Готовность firmware netX (флаг NETX_READY в DPM) — завершение пункта старта `comx`.
+ * @return true, если netX объявил READY.
+ * @note Только чтение слова флагов; состояние handshake-автомата ведёт task обмена.
+ */
+bool comx_fmc_port_netx_ready(void);
+
+/**
+ * @brief Счётчик сбросов COMX при восстановлении из ERROR (diag).
+ * @return Сбросов с init, [шт].
+ */
+uint32_t comx_fmc_port_reset_count(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COMX_FMC_PORT_H */
@@ -0,0 +1,30 @@
+#include "dwt_timebase.h"
+
+#include "main.h"
+
+static uint32_t s_cycles_per_us = 1u; /**< Тактов CPU на мкс, [такт/мкс]. */
+static uint32_t s_last_cyc; /**< CYCCNT на прошлом вызове, [такт]. */
+static uint32_t s_rem_cyc; /**< Остаток тактов, не перенесённый в мкс, [такт]. */
+static uint32_t s_now_us; /**< Расширенное время, [мкс]. */
+
+void dwt_timebase_init(void)
+{
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  const uint32_t cycles_per_us = SystemCoreClock / 1000000u;
+  s_cycles_per_us = (cycles_per_us != 0u) ? cycles_per_us : 1u;
+}
+
+uint32_t dwt_timebase_now_us(void)
+{
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  const uint32_t cyc = DWT->CYCCNT;
+  const uint32_t delta = (cyc - s_last_cyc) + s_rem_cyc;
+  s_last_cyc = cyc;
+  s_now_us += delta / s_cycles_per_us;
+  s_rem_cyc = delta % s_cycles_per_us;
+  const uint32_t now_us = s_now_us;
+  __set_PRIMASK(primask);
+  return now_us;
+}
@@ -0,0 +1,39 @@
+#ifndef DWT_TIMEBASE_H
+#define DWT_TIMEBASE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file dwt_timebase.h
+ * @brief Общий timebase портов (target-only): счётчик тактов DWT CYCCNT, расширенный до мкс по модулю 2^32.
+ * @details
+ * CYCCNT переполняется за 2^32 тактов (~25 с на 170 МГц); приращение тактов переносится в счётчик мкс
+ * с остатком, поэтому разности времени корректны по модулю 2^32 мкс (~71 мин) независимо от wrap CYCCNT.
+ * Отсчёт — от сброса MCU (CYCCNT не обнуляется при init), поэтому профиль старта и обмен COMX используют
+ * одну шкалу. Условие корректности: между вызовами dwt_timebase_now_us() проходит < 2^32 тактов
+ * (boot/COMX task опрашивают каждую 1 мс).
+ */
+
+/**
+ * @brief Включить DWT CYCCNT и зафиксировать частоту CPU (SystemCoreClock).
+ * @return None.
+ * @note Идемпотентна; вызывается первой в main() (boot_port_start()) и повторно из портов — безопасно.
+ */
+void dwt_timebase_init(void);
+
+/**
+ * @brief Текущее время.
+ * @return Монотонное время от сброса, [мкс] (wrap по модулю 2^32).
+ * @note ISR/task-safe: короткая секция с запретом прерываний.
+ */
+uint32_t dwt_timebase_now_us(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DWT_TIMEBASE_H */
@@ -0,0 +1,130 @@
+#include "settings_flash_port.h"
+
+#include <string.h>
+
+#include "main.h"
+
+#define SETTINGS_FLASH_PORT_SIZE (SETTINGS_FLASH_PORT_PAGES * SETTINGS_FLASH_PORT_PAGE_SIZE) /**< Область, [байт]. */
+#define SETTINGS_FLASH_PORT_BANK_OFS (SETTINGS_FLASH_PORT_FIRST_PAGE * SETTINGS_FLASH_PORT_PAGE_SIZE) /**< Смещение в bank 2, [байт]. */
+
+static settings_store_t s_store; /**< Хранилище настроек. */
+static volatile bool s_read_armed; /**< Идёт чтение области: ECCD в ней — ожидаемый исход оборванной записи. */
+static volatile bool s_read_ecc; /**< За текущее чтение была двойная ошибка ECC. */
+static volatile uint32_t s_cnt_ecc_double; /**< Погашенных двойных ошибок ECC в области, [шт]. */
+
+/**
+ * @brief Сбросить ECCD (W1C), сохранив разрешение прерывания ECCC.
+ * @param eccr Текущее значение FLASH->ECCR.
+ * @return None.
+ */
+static void settings_flash_port_ecc_clear(uint32_t eccr)
+{
+  FLASH->ECCR = (eccr & FLASH_ECCR_ECCCIE) | FLASH_ECCR_ECCD;
+}
+
+/**
+ * @brief Чтение области (memory-mapped) под охраной ECCD.
+ * @param user Не используется.
+ * @param addr Смещение от начала области, [байт].
+ * @param dst Буфер.
+ * @param len Длина, [байт].
+ * @return false при выходе за область или двойной ошибке ECC (оборванный program/erase) — settings_store
+ *         считает такую запись оборванным хвостом и пропускает её.
+ */
+static bool settings_flash_port_read(void *user, uint32_t addr, void *dst, uint32_t len)
+{
+  (void)user;
+  if ((addr > SETTINGS_FLASH_PORT_SIZE) || (len > (SETTINGS_FLASH_PORT_SIZE - addr)))
+  {
+    return false;
+  }
+
+  // Чтение double-word с несогласованным ECC поднимает NMI: settings_flash_port_ecc_nmi() гасит его только
+  // внутри этого окна и только для адресов области, данные помечаются невалидными.
+  settings_flash_port_ecc_clear(FLASH->ECCR);
+  s_read_ecc = false;
+  s_read_armed = true;
+  __DSB();
+  memcpy(dst, (const void *)(SETTINGS_FLASH_PORT_BASE + addr), len);
+  __DSB();
+  s_read_armed = false;
+  return !s_read_ecc;
+}
+
+/**
+ * @brief Программирование double-word.
+ * @param user Не используется.
+ * @param addr Смещение от начала области, [байт] (кратно 8).
+ * @param dw Значение.
+ * @return false при ошибке HAL.
+ */
+static bool settings_flash_port_program(void *user, uint32_t addr, uint64_t dw)
+{
+  (void)user;
+  (void)HAL_FLASH_Unlock();
+  const HAL_StatusTypeDef st = HAL_FLASH_Program(FLASH_TYPEPROGRAM_DOUBLEWORD, SETTINGS_FLASH_PORT_BASE + addr, dw);
+  (void)HAL_FLASH_Lock();
+  return st == HAL_OK;
+}
+
+/**
+ * @brief Стирание страницы области.
+ * @param user Не используется.
+ * @param page Страница области, [индекс].
+ * @return false при ошибке HAL.
+ */
+static bool settings_flash_port_erase(void *user, uint32_t page)
+{
+  (void)user;
+  FLASH_EraseInitTypeDef erase = {0};
+  erase.TypeErase = FLASH_TYPEERASE_PAGES;
+  erase.Banks = FLASH_BANK_2;
+  erase.Page = SETTINGS_FLASH_PORT_FIRST_PAGE + page;
+  erase.NbPages = 1u;
+  uint32_t page_error = 0u;
+  (void)HAL_FLASH_Unlock();
+  const HAL_StatusTypeDef st = HAL_FLASHEx_Erase(&erase, &page_error);
+  (void)HAL_FLASH_Lock();
+  return st == HAL_OK;
+}
+
+bool settings_flash_port_mount(void)
+{
+  const settings_store_io_t io = {
+    .read = settings_flash_port_read,
+    .program = settings_flash_port_program,
+    .erase = settings_flash_port_erase,
+    .user = NULL
+  };
+  const settings_store_cfg_t cfg = {
+    .page_size = SETTINGS_FLASH_PORT_PAGE_SIZE,
+    .page_count = SETTINGS_FLASH_PORT_PAGES
+  };
+  return settings_store_mount(&s_store, &io, &cfg);
+}
+
+settings_store_t *settings_flash_port_store(void)
+{
+  return &s_store;
+}
+
+bool settings_flash_port_ecc_nmi(void)
+{
+  const uint32_t eccr = FLASH->ECCR;
+  const uint32_t ofs = eccr & FLASH_ECCR_ADDR_ECC; /* [байт от начала банка] */
+  const bool in_area = ((eccr & FLASH_ECCR_BK_ECC) != 0u) && (ofs >= SETTINGS_FLASH_PORT_BANK_OFS) &&
+                       (ofs < (SETTINGS_FLASH_PORT_BANK_OFS + SETTINGS_FLASH_PORT_SIZE));
+  if (((eccr & FLASH_ECCR_ECCD) == 0u) || !s_read_armed || !in_area)
+  {
+    return false;
+  }
+  settings_flash_port_ecc_clear(eccr);
+  s_read_ecc = true;
+  s_cnt_ecc_double++;
+  return true;
+}
+
+uint32_t settings_flash_port_ecc_count(void)
+{
+  return s_cnt_ecc_double;
+}
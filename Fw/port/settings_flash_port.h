@@ -0,0 +1,62 @@
+#ifndef SETTINGS_FLASH_PORT_H
+#define SETTINGS_FLASH_PORT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "settings_store.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file settings_flash_port.h
+ * @brief Glue settings_store ↔ внутренняя Flash G474 (target-only): HAL_FLASH_Program DOUBLEWORD / HAL_FLASHEx_Erase.
+ * @details
+ * Область — последние SETTINGS_FLASH_PORT_PAGES страниц bank 2 (dual-bank, страница 2 КБ); исключена из
+ * региона FLASH в линкер-скриптах (`LENGTH = 504K`). Program/erase bank 2 не останавливает выборку кода из
+ * bank 1, но по контракту settings_store запись всё равно только в IDLE.
+ *
+ * Оборванный program/erase оставляет double-word с несогласованным ECC; чтение такого слова — двойная ошибка
+ * (FLASH->ECCR.ECCD), которая на G474 всегда поднимает NMI. Чтение области выполняется в "охраняемом" окне:
+ * NMI_Handler вызывает settings_flash_port_ecc_nmi(), та сбрасывает ECCD и помечает чтение неуспешным, а
+ * settings_store пропускает запись как оборванный хвост (как при несовпадении CRC). ECCD вне окна или вне
+ * области остаётся аварией.
+ */
+
+#define SETTINGS_FLASH_PORT_BASE (0x0807E000u) /**< Начало области (bank 2, страница 124), [адрес]. */
+#define SETTINGS_FLASH_PORT_FIRST_PAGE (124u) /**< Первая страница области в bank 2, [индекс]. */
+#define SETTINGS_FLASH_PORT_PAGES (4u) /**< Страниц в кольце, [шт]. */
+#define SETTINGS_FLASH_PORT_PAGE_SIZE (2048u) /**< Размер страницы, [байт]. */
+
+/**
+ * @brief Смонтировать хранилище настроек над внутренней Flash.
+ * @return true, если хранилище смонтировано (в т.ч. пустое — тогда `diag` = BLANK и действуют defaults).
+ */
+bool settings_flash_port_mount(void);
+
+/**
+ * @brief Доступ к хранилищу (чтение настроек, сохранение в IDLE).
+ * @return Указатель на контекст хранилища.
+ */
+settings_store_t *settings_flash_port_store(void);
+
+/**
+ * @brief Обработка двойной ошибки ECC из NMI_Handler.
+ * @return true — ECCD при чтении области настроек погашен (возврат из NMI); false — не наш источник NMI.
+ * @note Вызывается первой в NMI_Handler; ISR-safe (только регистры FLASH и флаги порта).
+ */
+bool settings_flash_port_ecc_nmi(void);
+
+/**
+ * @brief Диагностика: погашенных двойных ошибок ECC в области настроек.
+ * @return Счётчик, [шт].
+ */
+uint32_t settings_flash_port_ecc_count(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SETTINGS_FLASH_PORT_H */
@@ -0,0 +1,167 @@
+#include "pccom4_frame.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief Таблица CRC16 Modbus по полубайтам (полином 0xA001) — 32 байта вместо 512.
+ */
+static const uint16_t pccom4_crc_tab[16] = {
+  0x0000u, 0xCC01u, 0xD801u, 0x1400u, 0xF001u, 0x3C00u, 0x2800u, 0xE401u,
+  0xA001u, 0x6C00u, 0x7800u, 0xB401u, 0x5000u, 0x9C01u, 0x8801u, 0x4400u,
+};
+
+uint16_t pccom4_crc16(uint16_t crc, const uint8_t *data, uint32_t len)
+{
+  for (uint32_t i = 0u; i < len; ++i)
+  {
+    crc = (uint16_t)(crc ^ data[i]);
+    crc = (uint16_t)((crc >> 4) ^ pccom4_crc_tab[crc & 0x0Fu]);
+    crc = (uint16_t)((crc >> 4) ^ pccom4_crc_tab[crc & 0x0Fu]);
+  }
+  return crc;
+}
+
+/**
+ * @brief CRC FRAME по PCCOM4.02 §4.4 (байты CRC приравнены к 0).
+ * @param frame FRAME (от `Length`).
+ * @param len `Length`, [байт].
+ * @return CRC.
+ */
+static uint16_t pccom4_frame_crc(const uint8_t *frame, uint32_t len)
+{
+  static const uint8_t zero[2] = {0u, 0u};
+  return pccom4_crc16(pccom4_crc16(0xFFFFu, frame, len - 2u), zero, 2u);
+}
+
+uint32_t pccom4_frame_encode(const pccom4_frame_t *frame, uint8_t *out, uint32_t cap)
+{
+  const uint32_t len = PCCOM4_LEN_MIN + frame->data_len;
+  if ((len > PCCOM4_LEN_MAX) || (cap < (len + 1u)) || ((frame->data_len != 0u) && (frame->data == NULL)))
+  {
+    return 0u;
+  }
+  out[0] = (uint8_t)PCCOM4_PREAMBLE;
+  out[1] = (uint8_t)len;
+  out[2] = frame->dst;
+  out[3] = frame->src;
+  out[4] = frame->type;
+  out[5] = frame->node;
+  out[6] = frame->op;
+  if (frame->data_len != 0u)
+  {
+    memcpy(&out[7], frame->data, frame->data_len);
+  }
+  const uint16_t crc = pccom4_frame_crc(&out[1], len);
+  out[len - 1u] = (uint8_t)(crc & 0xFFu);
+  out[len] = (uint8_t)(crc >> 8);
+  return len + 1u;
+}
+
+void pccom4_parser_init(pccom4_parser_t *p)
+{
+  memset(p, 0, sizeof(*p));
+}
+
+/**
+ * @brief Ресинхронизация: отбросить текущий `0xFF` и сдвинуть окно к следующему `0xFF` в нём.
+ * @param p Парсер.
+ * @return None.
+ */
+static void pccom4_parser_resync(pccom4_parser_t *p)
+{
+  const uint8_t *next = (p->n > 1u) ? memchr(&p->buf[1], PCCOM4_PREAMBLE, p->n - 1u) : NULL;
+  const uint32_t drop = (next != NULL) ? (uint32_t)(next - p->buf) : p->n;
+  p->stats.parser_resync_count++;
+  p->stats.bytes_skipped += drop;
+  memmove(p->buf, &p->buf[drop], p->n - drop);
+  p->n -= drop;
+}
+
+/**
+ * @brief Разобрать окно: выдать готовые кадры, ресинхронизироваться при ошибках.
+ * @param p Парсер.
+ * @param fn Обработчик.
+ * @param user Контекст обработчика.
+ * @return Кадров, [шт].
+ */
+static uint32_t pccom4_parser_drain(pccom4_parser_t *p, pccom4_frame_fn_t fn, void *user)
+{
+  uint32_t frames = 0u;
+  while (p->n >= 2u)
+  {
+    const uint32_t len = p->buf[1];
+    if (len < PCCOM4_LEN_MIN)
+    {
+      p->stats.rx_len_err++;
+      pccom4_parser_resync(p);
+      continue;
+    }
+    if (p->n < (len + 1u))
+    {
+      break;
+    }
+    const uint8_t *f = &p->buf[1];
+    const uint16_t rx_crc = (uint16_t)((uint32_t)f[len - 2u] | ((uint32_t)f[len - 1u] << 8));
+    if (pccom4_frame_crc(f, len) != rx_crc)
+    {
+      p->stats.rx_crc_err++;
+      pccom4_parser_resync(p);
+      continue;
+    }
+    p->stats.rx_ok++;
+    frames++;
+    if (fn != NULL)
+    {
+      const pccom4_frame_t frame = {f[1], f[2], f[3], f[4], f[5], (uint8_t)(len - PCCOM4_LEN_MIN), &f[6], f};
+      fn(user, &frame);
+    }
+    memmove(p->buf, &p->buf[len + 1u], p->n - (len + 1u));
+    p->n -= len + 1u;
+    // Хвост окна мог начинаться не с `0xFF` (мусор после кадра).
+    if ((p->n != 0u) && (p->buf[0] != PCCOM4_PREAMBLE))
+    {
+      const uint8_t *next = memchr(p->buf, PCCOM4_PREAMBLE, p->n);
+      const uint32_t drop = (next != NULL) ? (uint32_t)(next - p->buf) : p->n;
+      p->stats.bytes_skipped += drop;
+      memmove(p->buf, &p->buf[drop], p->n - drop);
+      p->n -= drop;
+    }
+  }
+  return frames;
+}
+
+uint32_t pccom4_parser_feed(pccom4_parser_t *p, const uint8_t *data, uint32_t len, pccom4_frame_fn_t fn,
+                            void *user)
+{
+  uint32_t frames = 0u;
+  while (len > 0u)
+  {
+    // Шаг 1: Вне кадра — поиск `0xFF` (memchr по куску, без побайтового цикла).
+    if (p->n == 0u)
+    {
+      const uint8_t *pre = memchr(data, PCCOM4_PREAMBLE, len);
+      if (pre == NULL)
+      {
+        p->stats.bytes_skipped += len;
+        return frames;
+      }
+      const uint32_t skip = (uint32_t)(pre - data);
+      p->stats.bytes_skipped += skip;
+      data += skip;
+      len -= skip;
+    }
+
+    // Шаг 2: Докопировать ровно недостающее до `Length` / до конца кадра.
+    const uint32_t need = (p->n < 2u) ? (2u - p->n) : ((p->buf[1] + 1u) - p->n);
+    const uint32_t take = (need < len) ? need : len;
+    memcpy(&p->buf[p->n], data, take);
+    p->n += take;
+    data += take;
+    len -= take;
+
+    // Шаг 3: Кадры из окна (включая повторный разбор хвоста после ресинхронизации).
+    frames += pccom4_parser_drain(p, fn, user);
+  }
+  return frames;
+}
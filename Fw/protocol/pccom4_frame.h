@@ -0,0 +1,133 @@
+#ifndef PCCOM4_FRAME_H
+#define PCCOM4_FRAME_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file pccom4_frame.h
+ * @brief Фрейминг PCcom 4.02: сборка кадра и потоковый парсер с ресинхронизацией (PCCOM4.02 §4, §8).
+ * @details
+ * Кадр на линии: `0xFF` (PREAMBLE) + FRAME `Length|Dst|Src|Type|Node|Op|Data|CRC_LO|CRC_HI`,
+ * `Length` = длина FRAME (8..255). CRC16 Modbus считается по всему FRAME с обнулёнными байтами CRC.
+ *
+ * Парсер не выделяет память и не зависит от транспорта: pccom4_parser_feed() принимает произвольные куски
+ * потока (UART DMA, read() на host) и вызывает обработчик для каждого кадра с верным CRC. `0xFF` не уникален,
+ * поэтому при неверном `Length`/CRC окно сдвигается к следующему `0xFF` внутри уже принятых байт
+ * (`resync`). Общий для прошивки и host-инструментов.
+ */
+
+#define PCCOM4_PREAMBLE (0xFFu) /**< Преамбула кадра. */
+#define PCCOM4_LEN_MIN (8u) /**< Минимальный `Length` (без Data), [байт]. */
+#define PCCOM4_LEN_MAX (255u) /**< Максимальный `Length`, [байт]. */
+#define PCCOM4_DATA_MAX (PCCOM4_LEN_MAX - PCCOM4_LEN_MIN) /**< Максимум поля `Data`, [байт]. */
+#define PCCOM4_WIRE_MAX (PCCOM4_LEN_MAX + 1u) /**< Максимальный кадр на линии, [байт]. */
+
+#define PCCOM4_ADDR_PC (0x01u) /**< Адрес ПК/ТК (PCCOM4.02_PROJECT §1.1). */
+#define PCCOM4_ADDR_USPF (0x03u) /**< Адрес платы источника (PCCOM4.02_PROJECT §1.1). */
+
+/**
+ * @brief Тип кадра (PCCOM4.02 §5).
+ */
+typedef enum {
+  PCCOM4_TYPE_UNKNOWN_CMD = 0x00u, /**< Ответ: неизвестная команда. */
+  PCCOM4_TYPE_READ = 0x01u, /**< Чтение данных. */
+  PCCOM4_TYPE_MESSAGE = 0x02u, /**< Сообщение. */
+  PCCOM4_TYPE_WRITE = 0x03u, /**< Запись данных. */
+  PCCOM4_TYPE_READ_OK = 0x04u, /**< Ответ: чтение успешно. */
+  PCCOM4_TYPE_WRITE_OK = 0x05u, /**< Ответ: запись успешна. */
+  PCCOM4_TYPE_ACCEPTED = 0x06u, /**< Ответ: команда принята (длительная). */
+  PCCOM4_TYPE_READ_ERR = 0x07u, /**< Ответ: ошибка чтения. */
+  PCCOM4_TYPE_WRITE_ERR = 0x08u /**< Ответ: ошибка записи. */
+} pccom4_type_t;
+
+/**
+ * @brief Разобранный кадр (указатели действительны только внутри обработчика).
+ */
+typedef struct {
+  uint8_t dst; /**< Адрес получателя. */
+  uint8_t src; /**< Адрес отправителя. */
+  uint8_t type; /**< Тип (pccom4_type_t). */
+  uint8_t node; /**< Узел. */
+  uint8_t op; /**< Операция. */
+  uint8_t data_len; /**< Длина `Data`, [байт]. */
+  const uint8_t *data; /**< Поле `Data`. */
+  const uint8_t *raw; /**< FRAME целиком (от `Length` до CRC, без PREAMBLE). */
+} pccom4_frame_t;
+
+/**
+ * @brief Обработчик принятого кадра.
+ * @param user Контекст вызывающего.
+ * @param frame Кадр.
+ * @return None.
+ */
+typedef void (*pccom4_frame_fn_t)(void *user, const pccom4_frame_t *frame);
+
+/**
+ * @brief Счётчики парсера (DN-012 §13.6).
+ */
+typedef struct {
+  uint32_t rx_ok; /**< Кадров с верным CRC, [шт]. */
+  uint32_t rx_crc_err; /**< Кадров с неверным CRC, [шт]. */
+  uint32_t rx_len_err; /**< Кандидатов с `Length` вне 8..255, [шт]. */
+  uint32_t parser_resync_count; /**< Сдвигов окна к следующему `0xFF`, [шт]. */
+  uint32_t bytes_skipped; /**< Байт вне кадров, [байт]. */
+} pccom4_parser_stats_t;
+
+/**
+ * @brief Состояние потокового парсера.
+ */
+typedef struct {
+  uint8_t buf[PCCOM4_WIRE_MAX]; /**< Окно кандидата (начинается с `0xFF`). */
+  uint32_t n; /**< Байт в окне, [байт]. */
+  pccom4_parser_stats_t stats; /**< Счётчики. */
+} pccom4_parser_t;
+
+/**
+ * @brief CRC16 Modbus (poly 0xA001, init 0xFFFF, без XOR-out).
+ * @param crc Начальное значение (0xFFFF для нового расчёта).
+ * @param data Данные.
+ * @param len Длина, [байт].
+ * @return CRC.
+ */
+uint16_t pccom4_crc16(uint16_t crc, const uint8_t *data, uint32_t len);
+
+/**
+ * @brief Собрать кадр на линии (PREAMBLE + FRAME).
+ * @param frame Поля кадра (`raw` не используется).
+ * @param out Буфер.
+ * @param cap Размер буфера, [байт].
+ * @return Длина кадра на линии, [байт] (0 — `data_len` > PCCOM4_DATA_MAX или мало места).
+ */
+uint32_t pccom4_frame_encode(const pccom4_frame_t *frame, uint8_t *out, uint32_t cap);
+
+/**
+ * @brief Инициализировать парсер.
+ * @param p Парсер.
+ * @return None.
+ */
+void pccom4_parser_init(pccom4_parser_t *p);
+
+/**
+ * @brief Подать кусок потока.
+ * @param p Парсер.
+ * @param data Байты.
+ * @param len Длина, [байт].
+ * @param fn Обработчик кадров (может быть NULL — только счётчики).
+ * @param user Контекст обработчика.
+ * @return Кадров с верным CRC в этом куске, [шт].
+ * @note Ложный кандидат (`0xFF` в мусоре/данных) держит следующие кадры в окне, пока не придут его `Length` байт:
+ * задержка не больше PCCOM4_WIRE_MAX байт потока, кадры при этом не теряются.
+ */
+uint32_t pccom4_parser_feed(pccom4_parser_t *p, const uint8_t *data, uint32_t len, pccom4_frame_fn_t fn,
+                            void *user);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PCCOM4_FRAME_H */
@@ -0,0 +1,82 @@
+#include "pccom4_txsched.h"
+
+#include <string.h>
+
+void pccom4_txsched_init(pccom4_txsched_t *s)
+{
+  memset(s, 0, sizeof(*s));
+  s->cur_prio = PCCOM4_PRIO_COUNT;
+}
+
+bool pccom4_txsched_push(pccom4_txsched_t *s, pccom4_prio_t prio, const pccom4_frame_t *frame)
+{
+  const uint32_t q = (uint32_t)prio;
+  if (q >= PCCOM4_PRIO_COUNT)
+  {
+    return false;
+  }
+  if (s->count[q] >= PCCOM4_TXSCHED_DEPTH)
+  {
+    s->stats.cnt_drop[q]++;
+    return false;
+  }
+  pccom4_txsched_slot_t *slot = &s->slot[q][(s->head[q] + s->count[q]) % PCCOM4_TXSCHED_DEPTH];
+  slot->len = pccom4_frame_encode(frame, slot->wire, sizeof(slot->wire));
+  if (slot->len == 0u)
+  {
+    return false;
+  }
+  s->count[q]++;
+  if (s->count[q] > s->stats.q_highwater[q])
+  {
+    s->stats.q_highwater[q] = s->count[q];
+  }
+  return true;
+}
+
+uint32_t pccom4_txsched_space(const pccom4_txsched_t *s, pccom4_prio_t prio)
+{
+  const uint32_t q = (uint32_t)prio;
+  return (q < PCCOM4_PRIO_COUNT) ? (PCCOM4_TXSCHED_DEPTH - s->count[q]) : 0u;
+}
+
+uint32_t pccom4_txsched_pull(pccom4_txsched_t *s, uint8_t *out, uint32_t budget)
+{
+  uint32_t n = 0u;
+  while (n < budget)
+  {
+    // Шаг 1: Новый кадр — из старшей непустой очереди.
+    if (s->cur_prio == PCCOM4_PRIO_COUNT)
+    {
+      uint32_t q = 0u;
+      while ((q < PCCOM4_PRIO_COUNT) && (s->count[q] == 0u))
+      {
+        q++;
+      }
+      if (q == PCCOM4_PRIO_COUNT)
+      {
+        break;
+      }
+      s->cur_prio = q;
+      s->cur_off = 0u;
+    }
+
+    // Шаг 2: Дописать текущий кадр в пределах бюджета.
+    const uint32_t q = s->cur_prio;
+    const pccom4_txsched_slot_t *slot = &s->slot[q][s->head[q]];
+    const uint32_t left = slot->len - s->cur_off;
+    const uint32_t take = (left < (budget - n)) ? left : (budget - n);
+    memcpy(&out[n], &slot->wire[s->cur_off], take);
+    n += take;
+    s->cur_off += take;
+    if (s->cur_off == slot->len)
+    {
+      s->head[q] = (s->head[q] + 1u) % PCCOM4_TXSCHED_DEPTH;
+      s->count[q]--;
+      s->stats.frames_sent[q]++;
+      s->cur_prio = PCCOM4_PRIO_COUNT;
+    }
+  }
+  s->stats.bytes_sent += n;
+  return n;
+}
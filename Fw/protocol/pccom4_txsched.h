@@ -0,0 +1,106 @@
+#ifndef PCCOM4_TXSCHED_H
+#define PCCOM4_TXSCHED_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "pccom4_frame.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file pccom4_txsched.h
+ * @brief Планировщик передачи PCcom4 (`service_tx_scheduler`, DN-012 §4.2, §13.1.5): три очереди Q0/Q1/Q2,
+ * strict priority P0 > P1 > P2, бюджет байт на тик, счётчики деградации.
+ * @details
+ * Кадры кодируются в слот очереди при постановке (pccom4_txsched_push()), передатчик забирает байты потока
+ * кусками не больше бюджета тика (pccom4_txsched_pull(): свободное место UART TX/DMA). Начатый кадр
+ * дописывается до конца (кадр не прерывается на линии), поэтому ожидание P0 за P1/P2 ограничено одним кадром
+ * (PCCOM4_WIRE_MAX байт). Полная очередь отклоняет новый кадр и считает `cnt_drop`: деградирует observability,
+ * а не command path (Q0 разгружается первой).
+ *
+ * Контекст: slow loop; push и pull — из одного контекста (блокировок нет).
+ */
+
+#define PCCOM4_TXSCHED_DEPTH (16u) /**< Глубина каждой очереди, [кадры]. */
+
+/**
+ * @brief Приоритет (номер очереди).
+ */
+typedef enum {
+  PCCOM4_PRIO_P0 = 0u, /**< `TkPdo.Emu.*`, служебные ответы (command path). */
+  PCCOM4_PRIO_P1 = 1u, /**< Поток контурных переменных (канал B). */
+  PCCOM4_PRIO_P2 = 2u, /**< Выгрузка RAW capture (канал C). */
+  PCCOM4_PRIO_COUNT = 3u /**< Количество приоритетов. */
+} pccom4_prio_t;
+
+/**
+ * @brief Счётчики планировщика (DN-012 §13.6).
+ */
+typedef struct {
+  uint32_t q_highwater[PCCOM4_PRIO_COUNT]; /**< `q0/q1/q2_highwater`, [кадры]. */
+  uint32_t cnt_drop[PCCOM4_PRIO_COUNT]; /**< Отклонено на полной очереди (`cnt_p1_drop`, `cnt_p2_drop`), [шт]. */
+  uint32_t frames_sent[PCCOM4_PRIO_COUNT]; /**< Передано кадров, [шт]. */
+  uint32_t bytes_sent; /**< Передано байт, [байт]. */
+} pccom4_txsched_stats_t;
+
+/**
+ * @brief Слот очереди: кадр на линии.
+ */
+typedef struct {
+  uint8_t wire[PCCOM4_WIRE_MAX]; /**< PREAMBLE + FRAME. */
+  uint32_t len; /**< Длина, [байт]. */
+} pccom4_txsched_slot_t;
+
+/**
+ * @brief Состояние планировщика.
+ */
+typedef struct {
+  pccom4_txsched_slot_t slot[PCCOM4_PRIO_COUNT][PCCOM4_TXSCHED_DEPTH]; /**< Очереди. */
+  uint32_t head[PCCOM4_PRIO_COUNT]; /**< Индекс первого кадра, [шт]. */
+  uint32_t count[PCCOM4_PRIO_COUNT]; /**< Кадров в очереди, [шт]. */
+  uint32_t cur_prio; /**< Очередь передаваемого кадра (PCCOM4_PRIO_COUNT — нет). */
+  uint32_t cur_off; /**< Передано байт текущего кадра, [байт]. */
+  pccom4_txsched_stats_t stats; /**< Счётчики. */
+} pccom4_txsched_t;
+
+/**
+ * @brief Инициализировать планировщик.
+ * @param s Планировщик.
+ * @return None.
+ */
+void pccom4_txsched_init(pccom4_txsched_t *s);
+
+/**
+ * @brief Поставить кадр в очередь.
+ * @param s Планировщик.
+ * @param prio Приоритет.
+ * @param frame Кадр (`raw` не используется).
+ * @return false — очередь полна (`cnt_drop++`) или кадр не кодируется.
+ */
+bool pccom4_txsched_push(pccom4_txsched_t *s, pccom4_prio_t prio, const pccom4_frame_t *frame);
+
+/**
+ * @brief Свободные слоты очереди (backpressure для производителя: децимация/уменьшение чанков до дропов).
+ * @param s Планировщик.
+ * @param prio Приоритет.
+ * @return Свободно, [кадры].
+ */
+uint32_t pccom4_txsched_space(const pccom4_txsched_t *s, pccom4_prio_t prio);
+
+/**
+ * @brief Забрать байты для передачи (strict priority; начатый кадр дописывается первым).
+ * @param s Планировщик.
+ * @param out Буфер передатчика.
+ * @param budget Бюджет тика, [байт].
+ * @return Записано, [байт] (0 — очереди пусты).
+ */
+uint32_t pccom4_txsched_pull(pccom4_txsched_t *s, uint8_t *out, uint32_t budget);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PCCOM4_TXSCHED_H */
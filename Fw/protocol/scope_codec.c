@@ -0,0 +1,338 @@
+#include "scope_codec.h"
+
+#include <stddef.h>
+
+#define SCOPE_CODEC_K_MAX (SCOPE_CODEC_ESC_BITS - 1u) /**< Максимальный Rice k, [бит]. */
+
+/**
+ * @brief Запись битового потока (LSB-first).
+ */
+typedef struct {
+  uint8_t *out; /**< Буфер. */
+  uint32_t cap; /**< Размер буфера, [байт]. */
+  uint32_t pos; /**< Записано байт, [байт]. */
+  uint64_t acc; /**< Накопитель. */
+  uint32_t n_acc; /**< Бит в накопителе, [бит]. */
+  bool ok; /**< false — буфер переполнен. */
+} scope_codec_bw_t;
+
+/**
+ * @brief Чтение битового потока (LSB-first).
+ */
+typedef struct {
+  const uint8_t *in; /**< Поток. */
+  uint32_t end; /**< Конец потока, [байт]. */
+  uint32_t pos; /**< Прочитано байт, [байт]. */
+  uint64_t acc; /**< Накопитель. */
+  uint32_t n_acc; /**< Бит в накопителе, [бит]. */
+  bool ok; /**< false — поток исчерпан. */
+} scope_codec_br_t;
+
+/**
+ * @brief Записать младшие биты значения.
+ * @param bw Поток.
+ * @param v Значение.
+ * @param n_bits Бит, [0..32].
+ * @return None.
+ */
+static void scope_codec_put(scope_codec_bw_t *bw, uint32_t v, uint32_t n_bits)
+{
+  bw->acc |= (uint64_t)v << bw->n_acc;
+  bw->n_acc += n_bits;
+  while (bw->n_acc >= 8u)
+  {
+    if (bw->pos < bw->cap)
+    {
+      bw->out[bw->pos++] = (uint8_t)(bw->acc & 0xFFu);
+    }
+    else
+    {
+      bw->ok = false;
+    }
+    bw->acc >>= 8;
+    bw->n_acc -= 8u;
+  }
+}
+
+/**
+ * @brief Прочитать биты.
+ * @param br Поток.
+ * @param n_bits Бит, [0..32].
+ * @return Значение (0 при исчерпании потока, br->ok = false).
+ */
+static uint32_t scope_codec_get(scope_codec_br_t *br, uint32_t n_bits)
+{
+  while (br->n_acc < n_bits)
+  {
+    if (br->pos >= br->end)
+    {
+      br->ok = false;
+      return 0u;
+    }
+    br->acc |= (uint64_t)br->in[br->pos++] << br->n_acc;
+    br->n_acc += 8u;
+  }
+  const uint32_t v = (uint32_t)(br->acc & ((1ull << n_bits) - 1u));
+  br->acc >>= n_bits;
+  br->n_acc -= n_bits;
+  return v;
+}
+
+/**
+ * @brief Ширина значения, [бит] (0 для 0).
+ * @param v Значение.
+ * @return Бит, [0..32].
+ */
+static uint32_t scope_codec_width(uint32_t v)
+{
+  uint32_t w = 0u;
+  while (v != 0u)
+  {
+    v >>= 1;
+    w++;
+  }
+  return w;
+}
+
+/**
+ * @brief Предсказание отсчёта k (k >= 1) канала.
+ * @param x Кадры.
+ * @param n_ch Каналов, [шт].
+ * @param c Канал.
+ * @param k Кадр.
+ * @param linear Линейный предсказатель (для k = 1 — всегда delta).
+ * @return Предсказание.
+ */
+static int32_t scope_codec_predict(const int16_t *x, uint32_t n_ch, uint32_t c, uint32_t k, bool linear)
+{
+  const int32_t a = x[((k - 1u) * n_ch) + c];
+  if (!linear || (k < 2u))
+  {
+    return a;
+  }
+  return (2 * a) - (int32_t)x[((k - 2u) * n_ch) + c];
+}
+
+/**
+ * @brief Zigzag-код остатка.
+ * @param d Остаток.
+ * @return Код (для остатков int16-предсказателей < 2^SCOPE_CODEC_ESC_BITS).
+ */
+static uint32_t scope_codec_zigzag(int32_t d)
+{
+  return ((uint32_t)d << 1) ^ ((d < 0) ? UINT32_MAX : 0u);
+}
+
+/**
+ * @brief Стоимость Rice-кода остатка.
+ * @param zz Zigzag-код.
+ * @param k Параметр Rice, [бит].
+ * @return Бит.
+ */
+static uint32_t scope_codec_rice_bits(uint32_t zz, uint32_t k)
+{
+  const uint32_t q = zz >> k;
+  return (q < SCOPE_CODEC_ESC_Q) ? (q + 1u + k) : (SCOPE_CODEC_ESC_Q + SCOPE_CODEC_ESC_BITS);
+}
+
+/**
+ * @brief Лучший Rice k для канала блока при заданном предсказателе.
+ * @param x Кадры.
+ * @param n Кадров, [шт].
+ * @param n_ch Каналов, [шт].
+ * @param c Канал.
+ * @param linear Предсказатель.
+ * @param k_out Выход: k, [бит].
+ * @return Стоимость остатков, [бит].
+ */
+static uint32_t scope_codec_best_k(const int16_t *x, uint32_t n, uint32_t n_ch, uint32_t c, bool linear,
+                                   uint32_t *k_out)
+{
+  // Шаг 1: Оценка k по среднему остатку (оптимум Rice ≈ log2(среднего)), затем точная стоимость соседей.
+  uint32_t sum = 0u;
+  for (uint32_t k = 1u; k < n; ++k)
+  {
+    sum += scope_codec_zigzag((int32_t)x[(k * n_ch) + c] - scope_codec_predict(x, n_ch, c, k, linear));
+  }
+  const uint32_t w = scope_codec_width(sum / (n - 1u));
+  const uint32_t k_lo = (w > 2u) ? (w - 2u) : 0u;
+  const uint32_t k_hi = (w < SCOPE_CODEC_K_MAX) ? w : SCOPE_CODEC_K_MAX;
+
+  uint32_t best = UINT32_MAX;
+  for (uint32_t kr = k_lo; kr <= k_hi; ++kr)
+  {
+    uint32_t bits = 0u;
+    for (uint32_t k = 1u; k < n; ++k)
+    {
+      bits += scope_codec_rice_bits(
+        scope_codec_zigzag((int32_t)x[(k * n_ch) + c] - scope_codec_predict(x, n_ch, c, k, linear)), kr);
+    }
+    if (bits < best)
+    {
+      best = bits;
+      *k_out = kr;
+    }
+  }
+  return best;
+}
+
+uint32_t scope_codec_block_bound(uint32_t n, uint32_t n_ch)
+{
+  return SCOPE_CODEC_HDR_LEN + (n_ch * SCOPE_CODEC_CH_HDR_LEN) + (n_ch * 2u * ((n > 0u) ? (n - 1u) : 0u));
+}
+
+uint32_t scope_codec_encode(const int16_t *x, uint32_t n, uint32_t n_ch, uint8_t *out, uint32_t cap)
+{
+  const uint32_t hdr = SCOPE_CODEC_HDR_LEN + (n_ch * SCOPE_CODEC_CH_HDR_LEN);
+  if ((x == NULL) || (out == NULL) || (n == 0u) || (n > SCOPE_CODEC_BLOCK_MAX) || (n_ch == 0u) ||
+      (n_ch > SCOPE_CODEC_CH_MAX) || (cap < hdr))
+  {
+    return 0u;
+  }
+
+  // Шаг 1: Параметры каналов и заголовки: предсказатель/k с минимальной стоимостью, иначе сырой канал.
+  uint8_t param[SCOPE_CODEC_CH_MAX];
+  for (uint32_t c = 0u; c < n_ch; ++c)
+  {
+    uint32_t k_delta = 0u;
+    uint32_t k_lin = 0u;
+    const uint32_t raw_bits = 16u * (n - 1u);
+    const uint32_t bits_delta = (n > 1u) ? scope_codec_best_k(x, n, n_ch, c, false, &k_delta) : 0u;
+    const uint32_t bits_lin = (n > 2u) ? scope_codec_best_k(x, n, n_ch, c, true, &k_lin) : UINT32_MAX;
+    if ((bits_lin < bits_delta) && (bits_lin < raw_bits))
+    {
+      param[c] = (uint8_t)(SCOPE_CODEC_PARAM_LINEAR | k_lin);
+    }
+    else if ((bits_delta < raw_bits) || (n == 1u))
+    {
+      param[c] = (uint8_t)k_delta;
+    }
+    else
+    {
+      param[c] = (uint8_t)SCOPE_CODEC_PARAM_RAW;
+    }
+    const uint16_t first = (uint16_t)x[c];
+    out[SCOPE_CODEC_HDR_LEN + (c * SCOPE_CODEC_CH_HDR_LEN)] = param[c];
+    out[SCOPE_CODEC_HDR_LEN + (c * SCOPE_CODEC_CH_HDR_LEN) + 1u] = (uint8_t)(first & 0xFFu);
+    out[SCOPE_CODEC_HDR_LEN + (c * SCOPE_CODEC_CH_HDR_LEN) + 2u] = (uint8_t)(first >> 8);
+  }
+
+  // Шаг 2: Битовый поток остатков, канал за каналом.
+  scope_codec_bw_t bw = {out, cap, hdr, 0u, 0u, true};
+  for (uint32_t c = 0u; c < n_ch; ++c)
+  {
+    const bool linear = (param[c] & SCOPE_CODEC_PARAM_LINEAR) != 0u;
+    const uint32_t kr = param[c] & SCOPE_CODEC_PARAM_K_MASK;
+    for (uint32_t k = 1u; k < n; ++k)
+    {
+      if ((param[c] & SCOPE_CODEC_PARAM_RAW) != 0u)
+      {
+        scope_codec_put(&bw, (uint16_t)x[(k * n_ch) + c], 16u);
+        continue;
+      }
+      const uint32_t zz =
+        scope_codec_zigzag((int32_t)x[(k * n_ch) + c] - scope_codec_predict(x, n_ch, c, k, linear));
+      const uint32_t q = zz >> kr;
+      if (q < SCOPE_CODEC_ESC_Q)
+      {
+        scope_codec_put(&bw, (1u << q) - 1u, q + 1u);
+        scope_codec_put(&bw, zz & ((1u << kr) - 1u), kr);
+      }
+      else
+      {
+        scope_codec_put(&bw, (1u << SCOPE_CODEC_ESC_Q) - 1u, SCOPE_CODEC_ESC_Q);
+        scope_codec_put(&bw, zz, SCOPE_CODEC_ESC_BITS);
+      }
+    }
+  }
+  scope_codec_put(&bw, 0u, (8u - (bw.n_acc & 7u)) & 7u);
+  if (!bw.ok)
+  {
+    return 0u;
+  }
+
+  // Шаг 3: Заголовок блока (длина — для пропуска блока без декодирования).
+  out[0] = (uint8_t)(bw.pos & 0xFFu);
+  out[1] = (uint8_t)(bw.pos >> 8);
+  out[2] = (uint8_t)n;
+  out[3] = (uint8_t)n_ch;
+  return bw.pos;
+}
+
+uint32_t scope_codec_block_len(const uint8_t *in, uint32_t len)
+{
+  if (len < SCOPE_CODEC_HDR_LEN)
+  {
+    return 0u;
+  }
+  const uint32_t block_len = (uint32_t)in[0] | ((uint32_t)in[1] << 8);
+  const uint32_t n = in[2];
+  const uint32_t n_ch = in[3];
+  if ((n == 0u) || (n_ch == 0u) || (n_ch > SCOPE_CODEC_CH_MAX) ||
+      (block_len < (SCOPE_CODEC_HDR_LEN + (n_ch * SCOPE_CODEC_CH_HDR_LEN))) || (block_len > len))
+  {
+    return 0u;
+  }
+  return block_len;
+}
+
+uint32_t scope_codec_decode(const uint8_t *in, uint32_t len, int16_t *x, uint32_t cap_samples, uint32_t *n,
+                            uint32_t *n_ch)
+{
+  const uint32_t block_len = scope_codec_block_len(in, len);
+  if (block_len == 0u)
+  {
+    return 0u;
+  }
+  const uint32_t nn = in[2];
+  const uint32_t nc = in[3];
+  if ((nn * nc) > cap_samples)
+  {
+    return 0u;
+  }
+
+  scope_codec_br_t br = {in, block_len, SCOPE_CODEC_HDR_LEN + (nc * SCOPE_CODEC_CH_HDR_LEN), 0u, 0u, true};
+  for (uint32_t c = 0u; c < nc; ++c)
+  {
+    const uint8_t *ch = &in[SCOPE_CODEC_HDR_LEN + (c * SCOPE_CODEC_CH_HDR_LEN)];
+    const uint32_t param = ch[0];
+    const bool raw = (param & SCOPE_CODEC_PARAM_RAW) != 0u;
+    const bool linear = (param & SCOPE_CODEC_PARAM_LINEAR) != 0u;
+    const uint32_t kr = param & SCOPE_CODEC_PARAM_K_MASK;
+    if ((kr > SCOPE_CODEC_K_MAX) || (raw && ((param & ~SCOPE_CODEC_PARAM_RAW) != 0u)))
+    {
+      return 0u;
+    }
+    x[c] = (int16_t)(uint16_t)((uint32_t)ch[1] | ((uint32_t)ch[2] << 8));
+    for (uint32_t k = 1u; k < nn; ++k)
+    {
+      if (raw)
+      {
+        x[(k * nc) + c] = (int16_t)(uint16_t)scope_codec_get(&br, 16u);
+        continue;
+      }
+      uint32_t q = 0u;
+      while ((q < SCOPE_CODEC_ESC_Q) && (scope_codec_get(&br, 1u) != 0u))
+      {
+        q++;
+      }
+      const uint32_t zz = (q < SCOPE_CODEC_ESC_Q) ? ((q << kr) | scope_codec_get(&br, kr))
+                                                  : scope_codec_get(&br, SCOPE_CODEC_ESC_BITS);
+      const int32_t d = (int32_t)(zz >> 1) ^ -(int32_t)(zz & 1u);
+      const int32_t v = scope_codec_predict(x, nc, c, k, linear) + d;
+      if (!br.ok || (v < INT16_MIN) || (v > INT16_MAX))
+      {
+        return 0u;
+      }
+      x[(k * nc) + c] = (int16_t)v;
+    }
+  }
+  // Поток должен закончиться ровно на границе блока (выравнивание до байта).
+  if (!br.ok || (br.pos != block_len))
+  {
+    return 0u;
+  }
+  *n = nn;
+  *n_ch = nc;
+  return block_len;
+}
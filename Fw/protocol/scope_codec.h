@@ -0,0 +1,80 @@
+#ifndef SCOPE_CODEC_H
+#define SCOPE_CODEC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file scope_codec.h
+ * @brief Lossless кодек блоков АЦП-отсчётов для `Scope.Data`/выгрузки RAW capture (PCcom4 `Node=0x06`).
+ * @details
+ * Вход — чередующиеся кадры int16 (`x[k * n_ch + c]`, как кадры AD7606). Блок фиксированной длины кодируется
+ * независимо от соседних (произвольный доступ: блок начинается с собственной длины):
+ * - на канал выбирается предсказатель (delta `x[k-1]` или линейный `2x[k-1] - x[k-2]`) и параметр Rice `k`
+ *   по точной стоимости блока;
+ * - остаток zigzag → Rice (унарная часть до SCOPE_CODEC_ESC_Q, далее escape + сырые SCOPE_CODEC_ESC_BITS бит);
+ * - если Rice не выигрывает у 16 бит/отсчёт — канал блока пишется сырым (размер блока ограничен сверху).
+ *
+ * Один модуль для MCU (кодер) и host-инструментов (декодер), формат — PCCOM4.02_PROJECT §3.5.3.
+ */
+
+#define SCOPE_CODEC_CH_MAX (8u) /**< Каналов в кадре, [шт]. */
+#define SCOPE_CODEC_BLOCK_MAX (255u) /**< Кадров в блоке, [шт]. */
+#define SCOPE_CODEC_HDR_LEN (4u) /**< Заголовок блока: длина u16, n u8, n_ch u8, [байт]. */
+#define SCOPE_CODEC_CH_HDR_LEN (3u) /**< Заголовок канала: параметры u8, первый отсчёт i16, [байт]. */
+#define SCOPE_CODEC_ESC_Q (16u) /**< Унарная часть, с которой остаток пишется escape-кодом, [шт]. */
+#define SCOPE_CODEC_ESC_BITS (18u) /**< Ширина сырого остатка после escape (zigzag остатка int16), [бит]. */
+
+#define SCOPE_CODEC_PARAM_K_MASK (0x1Fu) /**< Байт параметров: Rice k. */
+#define SCOPE_CODEC_PARAM_RAW (0x40u) /**< Байт параметров: канал блока сырой (int16 LE). */
+#define SCOPE_CODEC_PARAM_LINEAR (0x80u) /**< Байт параметров: линейный предсказатель. */
+
+/**
+ * @brief Верхняя граница размера блока (канал сырой + заголовки).
+ * @param n Кадров, [шт].
+ * @param n_ch Каналов, [шт].
+ * @return Размер, [байт].
+ */
+uint32_t scope_codec_block_bound(uint32_t n, uint32_t n_ch);
+
+/**
+ * @brief Закодировать блок.
+ * @param x Кадры (чередование каналов), `n * n_ch` отсчётов.
+ * @param n Кадров, [шт] (1..SCOPE_CODEC_BLOCK_MAX).
+ * @param n_ch Каналов, [шт] (1..SCOPE_CODEC_CH_MAX).
+ * @param out Буфер блока.
+ * @param cap Размер буфера, [байт] (scope_codec_block_bound() гарантированно достаточно).
+ * @return Длина блока, [байт] (0 — невалидные параметры или мало места).
+ */
+uint32_t scope_codec_encode(const int16_t *x, uint32_t n, uint32_t n_ch, uint8_t *out, uint32_t cap);
+
+/**
+ * @brief Длина блока по заголовку (пропуск без декодирования).
+ * @param in Начало блока.
+ * @param len Доступно байт, [байт].
+ * @return Длина блока, [байт] (0 — заголовок невалиден или блок обрезан).
+ */
+uint32_t scope_codec_block_len(const uint8_t *in, uint32_t len);
+
+/**
+ * @brief Декодировать блок.
+ * @param in Начало блока.
+ * @param len Доступно байт, [байт].
+ * @param x Выход: кадры (чередование каналов).
+ * @param cap_samples Ёмкость x, [отсчёты].
+ * @param n Выход: кадров, [шт].
+ * @param n_ch Выход: каналов, [шт].
+ * @return Длина блока, [байт] (0 — ошибка формата/ёмкости).
+ */
+uint32_t scope_codec_decode(const uint8_t *in, uint32_t len, int16_t *x, uint32_t cap_samples, uint32_t *n,
+                            uint32_t *n_ch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCOPE_CODEC_H */
@@ -0,0 +1,412 @@
+#include "scope_vars.h"
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief Количество единичных битов.
+ * @param v Значение.
+ * @return Битов, [шт].
+ */
+static uint32_t scope_vars_popcount(uint32_t v)
+{
+  uint32_t n = 0u;
+  while (v != 0u)
+  {
+    v &= v - 1u;
+    n++;
+  }
+  return n;
+}
+
+/**
+ * @brief Ширина zigzag-значения, [бит] (0 для 0).
+ * @param zz Значение.
+ * @return Бит, [0..32].
+ */
+static uint32_t scope_vars_width(uint32_t zz)
+{
+  uint32_t w = 0u;
+  while (zz != 0u)
+  {
+    zz >>= 1;
+    w++;
+  }
+  return w;
+}
+
+/**
+ * @brief Zigzag-код разности `cur - prev` (по модулю 2^32).
+ * @param cur Текущее значение.
+ * @param prev Предыдущее значение.
+ * @return Код.
+ */
+static uint32_t scope_vars_zigzag(int32_t cur, int32_t prev)
+{
+  const uint32_t d = (uint32_t)cur - (uint32_t)prev;
+  return (d << 1) ^ (((d >> 31) != 0u) ? UINT32_MAX : 0u);
+}
+
+/**
+ * @brief Прочитать сигнал через его объявленный тип и вернуть сырое слово.
+ * @param desc Сигнал.
+ * @return Сырое слово: биты float (F32), значение (U32), 0/1 (BOOL).
+ * @note Одно volatile-чтение объекта его собственного типа; биты float переносятся в слово через memcpy
+ *       (без type punning через чужой lvalue — strict aliasing).
+ */
+static uint32_t scope_vars_read_raw(const scope_var_desc_t *desc)
+{
+  uint32_t raw;
+  if (desc->type == SCOPE_VAR_F32)
+  {
+    const float v = *(const volatile float *)desc->ptr;
+    memcpy(&raw, &v, sizeof(raw));
+  }
+  else if (desc->type == SCOPE_VAR_BOOL)
+  {
+    raw = (*(const volatile bool *)desc->ptr) ? 1u : 0u;
+  }
+  else
+  {
+    raw = *(const volatile uint32_t *)desc->ptr;
+  }
+  return raw;
+}
+
+/**
+ * @brief Квантовать сырое слово сигнала в целое кадра.
+ * @param desc Сигнал.
+ * @param raw Сырое слово.
+ * @return Значение кадра (F32: `lrintf(v/scale)` с насыщением, NaN ⇒ INT32_MIN).
+ */
+static int32_t scope_vars_quant(const scope_var_desc_t *desc, uint32_t raw)
+{
+  if (desc->type != SCOPE_VAR_F32)
+  {
+    return (int32_t)raw;
+  }
+  float v;
+  memcpy(&v, &raw, sizeof(v));
+  const float q = v / desc->scale;
+  if (isnan(q))
+  {
+    return INT32_MIN;
+  }
+  if (q >= 2147483520.0f)
+  {
+    return INT32_MAX;
+  }
+  if (q <= -2147483520.0f)
+  {
+    return INT32_MIN + 1;
+  }
+  return (int32_t)lrintf(q);
+}
+
+/**
+ * @brief Записать u32 LE.
+ * @param b Байты.
+ * @param v Значение.
+ * @return None.
+ */
+static void scope_vars_put_u32(uint8_t *b, uint32_t v)
+{
+  b[0] = (uint8_t)(v & 0xFFu);
+  b[1] = (uint8_t)((v >> 8) & 0xFFu);
+  b[2] = (uint8_t)((v >> 16) & 0xFFu);
+  b[3] = (uint8_t)((v >> 24) & 0xFFu);
+}
+
+/**
+ * @brief Прочитать u32 LE.
+ * @param b Байты.
+ * @return Значение.
+ */
+static uint32_t scope_vars_get_u32(const uint8_t *b)
+{
+  return (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+}
+
+void scope_vars_init(scope_vars_t *sv)
+{
+  memset(sv, 0, sizeof(*sv));
+  atomic_init(&sv->cfg_req, 0u);
+  atomic_init(&sv->cfg_gen, 0u);
+  atomic_init(&sv->head, 0u);
+  atomic_init(&sv->tail, 0u);
+  sv->decim = 1u;
+}
+
+int32_t scope_vars_add(scope_vars_t *sv, const char *name, const volatile void *ptr, scope_var_type_t type,
+                       float scale)
+{
+  if ((sv->n_sig >= SCOPE_VARS_SIGNALS_MAX) || (ptr == NULL) || (type > SCOPE_VAR_BOOL) ||
+      ((type == SCOPE_VAR_F32) && !(scale > 0.0f)))
+  {
+    return -1;
+  }
+  const scope_var_desc_t desc = {name, ptr, type, (type == SCOPE_VAR_F32) ? scale : 1.0f};
+  sv->sig[sv->n_sig] = desc;
+  return (int32_t)sv->n_sig++;
+}
+
+uint32_t scope_vars_add_control(scope_vars_t *sv, const control_out_t *out, const control_ctx_t *ctx,
+                                const control_meas_t *meas)
+{
+  // Шаги квантования: ток 0.1 A, напряжение 0.01 В, u 1e-5, R 1 мкОм, энергия 0.1 Дж, мощность 1 Вт.
+  const int32_t idx[] = {
+    scope_vars_add(sv, "u", &out->u, SCOPE_VAR_F32, 1e-5f),
+    scope_vars_add(sv, "i_ref_used", &out->i_ref_used, SCOPE_VAR_F32, 0.1f),
+    scope_vars_add(sv, "i_meas", &meas->i_meas, SCOPE_VAR_F32, 0.1f),
+    scope_vars_add(sv, "u_meas", &meas->u_meas, SCOPE_VAR_F32, 0.01f),
+    scope_vars_add(sv, "udc", &meas->udc, SCOPE_VAR_F32, 0.01f),
+    scope_vars_add(sv, "p_meas", &meas->p_meas, SCOPE_VAR_F32, 1.0f),
+    scope_vars_add(sv, "integrator", &ctx->state.integrator, SCOPE_VAR_F32, 1e-5f),
+    scope_vars_add(sv, "u_ff", &out->u_ff, SCOPE_VAR_F32, 1e-5f),
+    scope_vars_add(sv, "r_est", &out->r_est, SCOPE_VAR_F32, 1e-6f),
+    scope_vars_add(sv, "outer_i_ref", &ctx->state.outer_i_ref, SCOPE_VAR_F32, 0.1f),
+    scope_vars_add(sv, "energy_j", &out->energy_j, SCOPE_VAR_F32, 0.1f),
+    scope_vars_add(sv, "flags", &out->flags, SCOPE_VAR_U32, 1.0f),
+    scope_vars_add(sv, "limit_src", &out->limit_src, SCOPE_VAR_U32, 1.0f),
+    scope_vars_add(sv, "enable_request", &out->enable_request, SCOPE_VAR_BOOL, 1.0f),
+  };
+  uint32_t n = 0u;
+  for (uint32_t i = 0u; i < (sizeof(idx) / sizeof(idx[0])); ++i)
+  {
+    n += (idx[i] >= 0) ? 1u : 0u;
+  }
+  return n;
+}
+
+bool scope_vars_configure(scope_vars_t *sv, bool on, uint32_t mask, uint16_t decim)
+{
+  const uint32_t known = (sv->n_sig >= 32u) ? UINT32_MAX : ((1u << sv->n_sig) - 1u);
+  const uint32_t req = atomic_load(&sv->cfg_req);
+  // Прошлый запрос ещё не применён fast-доменом ⇒ pending-поля заняты.
+  if ((req != atomic_load(&sv->cfg_gen)) || (decim == 0u) || ((mask & ~known) != 0u) ||
+      (scope_vars_popcount(mask) > SCOPE_VARS_SLOT_WORDS) || (on && (mask == 0u)))
+  {
+    sv->stats.cnt_cfg_rejected++;
+    return false;
+  }
+  sv->pend_on = on;
+  sv->pend_mask = mask;
+  sv->pend_decim = decim;
+  atomic_store(&sv->cfg_req, req + 1u);
+  return true;
+}
+
+bool scope_vars_sample(scope_vars_t *sv)
+{
+  // Шаг 1: Новая конфигурация (поля pending стабильны, пока cfg_gen != cfg_req).
+  const uint32_t req = atomic_load(&sv->cfg_req);
+  if (req != atomic_load_explicit(&sv->cfg_gen, memory_order_relaxed))
+  {
+    sv->on = sv->pend_on;
+    sv->mask = sv->pend_mask;
+    sv->decim = sv->pend_decim;
+    sv->decim_cnt = 0u;
+    sv->n_sel = 0u;
+    for (uint32_t i = 0u; i < SCOPE_VARS_SIGNALS_MAX; ++i)
+    {
+      if ((sv->mask & (1u << i)) != 0u)
+      {
+        sv->sel[sv->n_sel++] = (uint8_t)i;
+      }
+    }
+    sv->stats.cnt_cfg_applied++;
+    atomic_store(&sv->cfg_gen, req);
+  }
+  if (!sv->on)
+  {
+    return false;
+  }
+
+  // Шаг 2: Децимация.
+  if (++sv->decim_cnt < sv->decim)
+  {
+    return false;
+  }
+  sv->decim_cnt = 0u;
+  const uint16_t seq = sv->sample_seq++;
+
+  // Шаг 3: Копия сырых слов выбранных полей в слот (кольцо полно ⇒ отсчёт теряется, счётчик).
+  const uint32_t head = atomic_load_explicit(&sv->head, memory_order_relaxed);
+  const uint32_t used = head - atomic_load(&sv->tail);
+  if (used >= SCOPE_VARS_RING_SLOTS)
+  {
+    sv->stats.cnt_drop++;
+    return false;
+  }
+  const uint32_t slot = head & (SCOPE_VARS_RING_SLOTS - 1u);
+  for (uint32_t j = 0u; j < sv->n_sel; ++j)
+  {
+    sv->ring[slot].w[j] = scope_vars_read_raw(&sv->sig[sv->sel[j]]);
+  }
+  sv->ring_gen[slot] = (uint8_t)(req & 0xFFu);
+  sv->ring_seq[slot] = seq;
+  sv->ring_mask[slot] = sv->mask;
+  atomic_store(&sv->head, head + 1u);
+  sv->stats.cnt_samples++;
+  sv->stats.ring_highwater = ((used + 1u) > sv->stats.ring_highwater) ? (used + 1u) : sv->stats.ring_highwater;
+  return true;
+}
+
+/**
+ * @brief Квантованные значения слота в порядке маски.
+ * @param sv Контекст.
+ * @param slot Слот.
+ * @param n_sel Сигналов, [шт].
+ * @param q Выход.
+ * @return None.
+ */
+static void scope_vars_slot_quant(const scope_vars_t *sv, uint32_t slot, uint32_t n_sel, int32_t *q)
+{
+  uint32_t mask = sv->ring_mask[slot];
+  for (uint32_t j = 0u; j < n_sel; ++j)
+  {
+    const uint32_t i = (uint32_t)__builtin_ctz(mask);
+    mask &= mask - 1u;
+    q[j] = scope_vars_quant(&sv->sig[i], sv->ring[slot].w[j]);
+  }
+}
+
+uint32_t scope_vars_pack(scope_vars_t *sv, uint8_t *out, uint32_t cap)
+{
+  const uint32_t tail = atomic_load_explicit(&sv->tail, memory_order_relaxed);
+  const uint32_t avail = atomic_load(&sv->head) - tail;
+  if (avail == 0u)
+  {
+    return 0u;
+  }
+  const uint32_t first = tail & (SCOPE_VARS_RING_SLOTS - 1u);
+  const uint32_t mask = sv->ring_mask[first];
+  const uint32_t n_sel = scope_vars_popcount(mask);
+  const uint32_t base = SCOPE_VARS_HDR_LEN + n_sel + (4u * n_sel); /* [байт] */
+  if (cap < base)
+  {
+    return 0u;
+  }
+
+  // Шаг 1: Сколько отсчётов одной конфигурации помещается: ширины растут по мере добавления дельт.
+  uint8_t width[SCOPE_VARS_SLOT_WORDS] = {0};
+  int32_t prev[SCOPE_VARS_SLOT_WORDS];
+  int32_t cur[SCOPE_VARS_SLOT_WORDS];
+  scope_vars_slot_quant(sv, first, n_sel, prev);
+  uint32_t n = 1u;
+  uint32_t bits = 0u; /* Σ ширин, [бит/отсчёт] */
+  while ((n < avail) && (n < 255u))
+  {
+    const uint32_t slot = (tail + n) & (SCOPE_VARS_RING_SLOTS - 1u);
+    if ((sv->ring_mask[slot] != mask) || (sv->ring_gen[slot] != sv->ring_gen[first]))
+    {
+      break;
+    }
+    scope_vars_slot_quant(sv, slot, n_sel, cur);
+    uint8_t w_new[SCOPE_VARS_SLOT_WORDS];
+    uint32_t bits_new = 0u;
+    for (uint32_t j = 0u; j < n_sel; ++j)
+    {
+      const uint32_t w = scope_vars_width(scope_vars_zigzag(cur[j], prev[j]));
+      w_new[j] = (uint8_t)((w > width[j]) ? w : width[j]);
+      bits_new += w_new[j];
+    }
+    if ((base + (((bits_new * n) + 7u) / 8u)) > cap)
+    {
+      break;
+    }
+    memcpy(width, w_new, sizeof(width));
+    memcpy(prev, cur, sizeof(prev));
+    bits = bits_new;
+    n++;
+  }
+
+  // Шаг 2: Заголовок, ширины, первый отсчёт.
+  out[0] = (uint8_t)SCOPE_VARS_SET_ID;
+  out[1] = sv->ring_gen[first];
+  out[2] = (uint8_t)(sv->ring_seq[first] & 0xFFu);
+  out[3] = (uint8_t)(sv->ring_seq[first] >> 8);
+  scope_vars_put_u32(&out[4], mask);
+  out[8] = (uint8_t)n;
+  memcpy(&out[SCOPE_VARS_HDR_LEN], width, n_sel);
+  scope_vars_slot_quant(sv, first, n_sel, prev);
+  for (uint32_t j = 0u; j < n_sel; ++j)
+  {
+    scope_vars_put_u32(&out[SCOPE_VARS_HDR_LEN + n_sel + (4u * j)], (uint32_t)prev[j]);
+  }
+
+  // Шаг 3: Битовый поток дельт (LSB-first), отсчёт за отсчётом, сигнал за сигналом.
+  const uint32_t stream_len = ((bits * (n - 1u)) + 7u) / 8u;
+  memset(&out[base], 0, stream_len);
+  uint32_t bitpos = 0u;
+  for (uint32_t k = 1u; k < n; ++k)
+  {
+    scope_vars_slot_quant(sv, (tail + k) & (SCOPE_VARS_RING_SLOTS - 1u), n_sel, cur);
+    for (uint32_t j = 0u; j < n_sel; ++j)
+    {
+      const uint32_t zz = scope_vars_zigzag(cur[j], prev[j]);
+      for (uint32_t b = 0u; b < width[j]; ++b, ++bitpos)
+      {
+        out[base + (bitpos >> 3)] |= (uint8_t)(((zz >> b) & 1u) << (bitpos & 7u));
+      }
+      prev[j] = cur[j];
+    }
+  }
+
+  atomic_store(&sv->tail, tail + n);
+  sv->stats.cnt_frames++;
+  return base + stream_len;
+}
+
+bool scope_vars_decode(const uint8_t *data, uint32_t len, scope_vars_frame_t *hdr, int32_t *values,
+                       uint32_t cap_values)
+{
+  if ((len < SCOPE_VARS_HDR_LEN) || (data[0] != SCOPE_VARS_SET_ID))
+  {
+    return false;
+  }
+  hdr->gen = data[1];
+  hdr->seq = (uint16_t)((uint32_t)data[2] | ((uint32_t)data[3] << 8));
+  hdr->mask = scope_vars_get_u32(&data[4]);
+  hdr->n_samples = data[8];
+  const uint32_t n_sel = scope_vars_popcount(hdr->mask);
+  hdr->n_sel = (uint8_t)n_sel;
+  const uint32_t n = hdr->n_samples;
+  const uint32_t base = SCOPE_VARS_HDR_LEN + n_sel + (4u * n_sel);
+  if ((n_sel > SCOPE_VARS_SLOT_WORDS) || (n == 0u) || (len < base) || ((n * n_sel) > cap_values))
+  {
+    return false;
+  }
+  uint32_t bits = 0u;
+  for (uint32_t j = 0u; j < n_sel; ++j)
+  {
+    if (data[SCOPE_VARS_HDR_LEN + j] > 32u)
+    {
+      return false;
+    }
+    bits += data[SCOPE_VARS_HDR_LEN + j];
+    values[j] = (int32_t)scope_vars_get_u32(&data[SCOPE_VARS_HDR_LEN + n_sel + (4u * j)]);
+  }
+  if ((base + (((bits * (n - 1u)) + 7u) / 8u)) != len)
+  {
+    return false;
+  }
+
+  uint32_t bitpos = 0u;
+  for (uint32_t k = 1u; k < n; ++k)
+  {
+    for (uint32_t j = 0u; j < n_sel; ++j)
+    {
+      const uint32_t w = data[SCOPE_VARS_HDR_LEN + j];
+      uint32_t zz = 0u;
+      for (uint32_t b = 0u; b < w; ++b, ++bitpos)
+      {
+        zz |= (uint32_t)((data[base + (bitpos >> 3)] >> (bitpos & 7u)) & 1u) << b;
+      }
+      const uint32_t d = (zz >> 1) ^ (((zz & 1u) != 0u) ? UINT32_MAX : 0u);
+      values[(k * n_sel) + j] = (int32_t)((uint32_t)values[((k - 1u) * n_sel) + j] + d);
+    }
+  }
+  return true;
+}
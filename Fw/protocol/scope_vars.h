@@ -0,0 +1,195 @@
+#ifndef SCOPE_VARS_H
+#define SCOPE_VARS_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "control_core.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file scope_vars.h
+ * @brief Канал B DN-012: decimated поток внутренних переменных контура (PCcom4 `Node=0x06`, `Scope.Data` набор 1).
+ * @details
+ * Реестр сигналов — именованные указатели на поля `control_out_t`/`control_state_t`/`control_meas_t` и поля
+ * measurement (регистрирует интеграция до старта потока). Клиент выбирает маску (`Scope.SignalMask`, до
+ * SCOPE_VARS_SLOT_WORDS сигналов) и децимацию (`Scope.Decimation`).
+ *
+ * Домены:
+ * - fast (граница периода PWM, после control_fast_step()): scope_vars_sample() — счётчик децимации и копия
+ *   сырых 32-битных слов выбранных сигналов в слот кольца (O(выбранных), без float-математики); кольцо полно ⇒
+ *   отсчёт отбрасывается (`cnt_drop`, DN-012 `cnt_p1_drop`);
+ * - slow: scope_vars_configure() (новая маска/децимация применяется fast-доменом на ближайшем отсчёте),
+ *   scope_vars_pack() — кадр `Scope.Data`: первый отсчёт целиком, далее zigzag-дельты, упакованные по битам
+ *   с шириной на сигнал (минимум для кадра). Float квантуется шагом `scale` сигнала.
+ *
+ * Формат кадра (LE) — см. PCCOM4.02_PROJECT §3.5.2; scope_vars_decode() — эталонный декодер (host).
+ */
+
+#define SCOPE_VARS_SIGNALS_MAX (32u) /**< Сигналов в реестре (бит маски), [шт]. */
+#define SCOPE_VARS_SLOT_WORDS (12u) /**< Максимум одновременно выбранных сигналов, [шт]. */
+#define SCOPE_VARS_RING_SLOTS (64u) /**< Слотов кольца (степень двойки), [шт]. */
+#define SCOPE_VARS_SET_ID (0x01u) /**< Номер набора `Scope.Data` для канала B. */
+#define SCOPE_VARS_FRAME_MAX (246u) /**< Максимум поля данных `Scope.Data`, [байт]. */
+#define SCOPE_VARS_HDR_LEN (9u) /**< Заголовок кадра до ширин, [байт]. */
+
+/**
+ * @brief Тип сигнала.
+ */
+typedef enum {
+  SCOPE_VAR_F32 = 0u,  /**< float, квантуется `lrintf(v/scale)`. */
+  SCOPE_VAR_U32 = 1u,  /**< uint32_t (счётчики, битовые маски) — как есть. */
+  SCOPE_VAR_BOOL = 2u  /**< bool — 0/1. */
+} scope_var_type_t;
+
+/**
+ * @brief Сигнал реестра.
+ */
+typedef struct {
+  const char *name; /**< Имя для клиента/логов. */
+  const volatile void *ptr; /**< Адрес поля (живёт всё время работы). */
+  scope_var_type_t type; /**< Тип. */
+  float scale; /**< Шаг квантования F32 (единица младшего разряда), [ед. сигнала]. */
+} scope_var_desc_t;
+
+/**
+ * @brief Слот кольца: сырые слова выбранных сигналов.
+ */
+typedef struct {
+  uint32_t w[SCOPE_VARS_SLOT_WORDS]; /**< Значения в порядке возрастания индексов маски. */
+} scope_vars_slot_t;
+
+/**
+ * @brief Метрики.
+ */
+typedef struct {
+  uint32_t cnt_samples; /**< Записанных отсчётов, [шт]. */
+  uint32_t cnt_drop; /**< Отброшенных отсчётов (кольцо полно), [шт]. */
+  uint32_t cnt_frames; /**< Собранных кадров, [шт]. */
+  uint32_t cnt_cfg_applied; /**< Применённых конфигураций, [шт]. */
+  uint32_t cnt_cfg_rejected; /**< Отклонённых конфигураций, [шт]. */
+  uint32_t ring_highwater; /**< Максимальное заполнение кольца, [слоты]. */
+} scope_vars_stats_t;
+
+/**
+ * @brief Контекст потока.
+ */
+typedef struct {
+  scope_var_desc_t sig[SCOPE_VARS_SIGNALS_MAX]; /**< Реестр. */
+  uint32_t n_sig; /**< Зарегистрировано сигналов, [шт]. */
+
+  /* Конфигурация: slow пишет pending + инкремент cfg_req, fast применяет при несовпадении с cfg_gen. */
+  uint32_t pend_mask; /**< Новая маска, [битовая маска]. */
+  uint16_t pend_decim; /**< Новая децимация, [периоды PWM]. */
+  bool pend_on; /**< Новое состояние потока. */
+  atomic_uint cfg_req; /**< Поколение запрошенной конфигурации, [шт]. */
+  atomic_uint cfg_gen; /**< Поколение применённой конфигурации (пишет fast), [шт]. */
+
+  /* Состояние fast-домена. */
+  bool on; /**< Поток включён. */
+  uint32_t mask; /**< Активная маска, [битовая маска]. */
+  uint16_t decim; /**< Активная децимация, [периоды PWM]. */
+  uint16_t decim_cnt; /**< Счётчик децимации, [периоды PWM]. */
+  uint8_t n_sel; /**< Выбрано сигналов, [шт]. */
+  uint8_t sel[SCOPE_VARS_SLOT_WORDS]; /**< Индексы выбранных сигналов, [индекс]. */
+  uint16_t sample_seq; /**< Номер следующего отсчёта (wrap), [шт]. */
+
+  /* SPSC-кольцо: fast пишет head, slow читает tail; каждый слот несёт поколение конфигурации. */
+  scope_vars_slot_t ring[SCOPE_VARS_RING_SLOTS]; /**< Слоты. */
+  uint8_t ring_gen[SCOPE_VARS_RING_SLOTS]; /**< Поколение конфигурации слота (младший байт). */
+  uint16_t ring_seq[SCOPE_VARS_RING_SLOTS]; /**< Номер отсчёта слота. */
+  uint32_t ring_mask[SCOPE_VARS_RING_SLOTS]; /**< Маска слота (кадр не смешивает конфигурации), [битовая маска]. */
+  atomic_uint head; /**< Индекс записи, [шт]. */
+  atomic_uint tail; /**< Индекс чтения, [шт]. */
+
+  scope_vars_stats_t stats; /**< Метрики. */
+} scope_vars_t;
+
+/**
+ * @brief Декодированный кадр (host).
+ */
+typedef struct {
+  uint8_t gen; /**< Поколение конфигурации. */
+  uint16_t seq; /**< Номер первого отсчёта. */
+  uint32_t mask; /**< Маска сигналов. */
+  uint8_t n_samples; /**< Отсчётов, [шт]. */
+  uint8_t n_sel; /**< Сигналов в отсчёте, [шт]. */
+} scope_vars_frame_t;
+
+/**
+ * @brief Инициализировать поток (реестр пуст, поток выключен).
+ * @param sv Контекст.
+ * @return None.
+ */
+void scope_vars_init(scope_vars_t *sv);
+
+/**
+ * @brief Зарегистрировать сигнал (до включения потока).
+ * @param sv Контекст.
+ * @param name Имя.
+ * @param ptr Адрес поля.
+ * @param type Тип.
+ * @param scale Шаг квантования F32 (> 0), [ед. сигнала].
+ * @return Индекс сигнала (бит маски) или -1 (реестр полон/невалидные параметры).
+ */
+int32_t scope_vars_add(scope_vars_t *sv, const char *name, const volatile void *ptr, scope_var_type_t type,
+                       float scale);
+
+/**
+ * @brief Зарегистрировать стандартный набор переменных контура (u, i_ref, i_meas, u_meas, integrator, …).
+ * @param sv Контекст.
+ * @param out Выход control_fast_step().
+ * @param ctx Контекст регулятора.
+ * @param meas Измерения периода.
+ * @return Количество зарегистрированных сигналов, [шт].
+ */
+uint32_t scope_vars_add_control(scope_vars_t *sv, const control_out_t *out, const control_ctx_t *ctx,
+                                const control_meas_t *meas);
+
+/**
+ * @brief Запросить конфигурацию потока (slow; применяется fast-доменом на ближайшем периоде).
+ * @param sv Контекст.
+ * @param on Поток включён (`Scope.StreamControl`).
+ * @param mask Маска сигналов (`Scope.SignalMask`), [битовая маска].
+ * @param decim Децимация (`Scope.Decimation`), [периоды PWM] (>= 1).
+ * @return false при невалидной конфигурации (неизвестный сигнал, > SCOPE_VARS_SLOT_WORDS, decim = 0).
+ */
+bool scope_vars_configure(scope_vars_t *sv, bool on, uint32_t mask, uint16_t decim);
+
+/**
+ * @brief Fast-домен: применить новую конфигурацию, децимация, копия выбранных полей в кольцо.
+ * @param sv Контекст.
+ * @return true, если отсчёт записан.
+ */
+bool scope_vars_sample(scope_vars_t *sv);
+
+/**
+ * @brief Slow-домен: собрать кадр `Scope.Data` из накопленных отсчётов.
+ * @param sv Контекст.
+ * @param out Буфер кадра.
+ * @param cap Размер буфера, [байт] (обычно SCOPE_VARS_FRAME_MAX).
+ * @return Длина кадра, [байт] (0 — нет отсчётов).
+ */
+uint32_t scope_vars_pack(scope_vars_t *sv, uint8_t *out, uint32_t cap);
+
+/**
+ * @brief Декодировать кадр в целые значения (квант F32 / u32 / bool) — эталон для host-клиента.
+ * @param data Кадр.
+ * @param len Длина, [байт].
+ * @param hdr Заголовок кадра.
+ * @param values Выход: `values[k * n_sel + j]` — сигнал j отсчёта k.
+ * @param cap_values Ёмкость values, [шт].
+ * @return false при ошибке формата/ёмкости.
+ */
+bool scope_vars_decode(const uint8_t *data, uint32_t len, scope_vars_frame_t *hdr, int32_t *values,
+                       uint32_t cap_values);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCOPE_VARS_H */
@@ -0,0 +1,110 @@
+#include "tk_cmd_rx.h"
+
+#include <stddef.h>
+
+#define TK_CMD_RX_MA_TO_A (0.001f) /**< Пересчёт mA → A, [A/mA]. */
+#define TK_CMD_RX_A_MS_TO_A_S (1000.0f) /**< Пересчёт A/мс → A/с, [мс/с]. */
+#define TK_CMD_RX_TARGET_CP_W (10.0f) /**< Единица `target` в CP, [Вт]. */
+#define TK_CMD_RX_TARGET_CE_J (1.0f) /**< Единица `target` в CE, [Дж]. */
+#define TK_CMD_RX_TARGET_CV_V (0.001f) /**< Единица `target` в CV, [В]. */
+
+/**
+ * @brief Инкремент saturating u16 счётчика.
+ * @param counter Текущее значение, [шт].
+ * @return counter + 1 с насыщением на 0xFFFF, [шт].
+ */
+static uint16_t tk_cmd_rx_sat_inc_u16(uint16_t counter)
+{
+  return (uint16_t)(counter + (uint16_t)(counter != UINT16_MAX));
+}
+
+void tk_cmd_rx_init(tk_cmd_rx_t *rx)
+{
+  const tk_cmd_weld_t cmd_zero = {0};
+  rx->last_seq = 0u;
+  rx->has_last = false;
+  rx->status_bits = 0u;
+  rx->cnt_cmd_reject = 0u;
+  rx->cnt_seq_gap = 0u;
+  rx->last_reject_mask = TK_CMD_REJECT_NONE;
+  rx->last_seq_class = TK_SEQ_FIRST;
+  rx->applied = cmd_zero;
+}
+
+void tk_cmd_rx_restart_seq(tk_cmd_rx_t *rx)
+{
+  rx->has_last = false;
+}
+
+void tk_cmd_rx_to_control(const tk_cmd_weld_t *cmd, control_cmd_t *out)
+{
+  // Режим внешнего контура и единицы `target` — табличное отображение (mode уже провалидирован).
+  static const control_reg_mode_t k_reg_mode[] = {
+    CONTROL_REG_CC, CONTROL_REG_CC, CONTROL_REG_CC, CONTROL_REG_CP, CONTROL_REG_CE, CONTROL_REG_CV
+  };
+  static const float k_target_scale[] = {0.0f, 0.0f, 0.0f, TK_CMD_RX_TARGET_CP_W, TK_CMD_RX_TARGET_CE_J,
+                                         TK_CMD_RX_TARGET_CV_V};
+  const uint32_t mode = (cmd->mode <= TK_MODE_WELD_CV) ? cmd->mode : TK_MODE_IDLE;
+
+  out->i_ref_cmd = (float)cmd->i_ref_cmd_ma * TK_CMD_RX_MA_TO_A;
+  out->enable_cmd = (mode >= TK_MODE_WELD) && (cmd->enable == 1u);
+  out->cmd_valid = true;
+  out->reg_mode = k_reg_mode[mode];
+  out->target = (float)cmd->target * k_target_scale[mode];
+  const uint32_t slew_a_ms =
+    (cmd->max_slew_rate_a_ms != 0u) ? cmd->max_slew_rate_a_ms : TK_MAX_SLEW_RATE_DEFAULT_A_MS; /* [A/мс] */
+  out->di_dt_cmd = (float)slew_a_ms * TK_CMD_RX_A_MS_TO_A_S;
+}
+
+tk_cmd_rx_verdict_t tk_cmd_rx_process(tk_cmd_rx_t *rx, const tk_cmd_weld_t *cmd, bool in_fault, control_ctx_t *ctrl)
+{
+  // SAFETY: в control_core публикуется только команда, прошедшая все валидаторы и политику seq.
+  // SAFETY: REJECT не меняет ни last_seq, ни опубликованную команду (действует последняя валидная).
+
+  // Шаг 1: Классификация seq и валидация полей (обе O(1), без ветвлений по содержимому кадра).
+  const tk_seq_class_t seq_class = tk_pdo_seq_classify(rx->last_seq, cmd->seq, rx->has_last);
+  const uint32_t reject = tk_pdo_cmd_weld_validate(cmd, in_fault) | tk_pdo_seq_reject_mask(seq_class);
+  rx->last_seq_class = seq_class;
+
+  // Шаг 2: REJECT — только статус и счётчик.
+  if (reject != TK_CMD_REJECT_NONE)
+  {
+    rx->last_reject_mask = reject;
+    rx->status_bits |= (uint16_t)TK_STATUS_CMD_REJECTED;
+    rx->cnt_cmd_reject = tk_cmd_rx_sat_inc_u16(rx->cnt_cmd_reject);
+    return TK_CMD_RX_REJECT;
+  }
+
+  // Шаг 3: APPLY — обновить seq и статусные биты.
+  const bool gap = (seq_class == TK_SEQ_GAP);
+  rx->last_seq = cmd->seq;
+  rx->has_last = true;
+  rx->applied = *cmd;
+  rx->status_bits &= (uint16_t)~(uint16_t)(TK_STATUS_CMD_REJECTED | TK_STATUS_SEQ_GAP_DETECTED);
+  rx->status_bits |= (uint16_t)((uint32_t)gap * TK_STATUS_SEQ_GAP_DETECTED);
+  rx->cnt_seq_gap = gap ? tk_cmd_rx_sat_inc_u16(rx->cnt_seq_gap) : rx->cnt_seq_gap;
+
+  // Шаг 4: Публикация последней валидной команды (защёлкивается fast-доменом на границе периода PWM).
+  if (ctrl != NULL)
+  {
+    control_cmd_t ctrl_cmd;
+    tk_cmd_rx_to_control(cmd, &ctrl_cmd);
+    control_slow_step(ctrl, &ctrl_cmd);
+  }
+
+  return TK_CMD_RX_APPLY;
+}
+
+uint16_t tk_cmd_rx_seq_applied(const tk_cmd_rx_t *rx)
+{
+  return rx->last_seq;
+}
+
+void tk_cmd_rx_fill_status(const tk_cmd_rx_t *rx, tk_fb_status_t *status)
+{
+  const uint16_t own_bits = (uint16_t)(TK_STATUS_CMD_REJECTED | TK_STATUS_SEQ_GAP_DETECTED);
+  status->seq_applied = rx->last_seq;
+  status->status_word = (uint16_t)((status->status_word & (uint16_t)~own_bits) | (rx->status_bits & own_bits));
+  status->cnt_cmd_reject = rx->cnt_cmd_reject;
+  status->cnt_seq_gap = rx->cnt_seq_gap;
+}
@@ -0,0 +1,119 @@
+#ifndef TK_CMD_RX_H
+#define TK_CMD_RX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "control_core.h"
+#include "tk_pdo_codec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file tk_cmd_rx.h
+ * @brief Приём `CMD_WELD`: политика `seq`, валидация и публикация "последней валидной" команды.
+ * @details
+ * Домен: 250 мкс / 4 кГц (task-контекст), вызывается один раз на каждый принятый RxPDO.
+ * Каждая команда классифицируется за O(1) (без истории кадров) и получает вердикт APPLY/REJECT.
+ *
+ * APPLY в этом профиле = "команда валидирована и опубликована как последняя валидная" (PROTOCOL_TK_ETHERCAT §1.2.3):
+ * публикация идёт в double-buffer `control_core` через control_slow_step(), а fast-домен защёлкивает
+ * последнюю опубликованную команду на границе периода PWM. Поэтому при cmd-rate 4 кГц и PWM 1–4 кГц
+ * промежуточные команды просто перезаписываются, а `SEQ_GAP_DETECTED` относится только к приёму.
+ *
+ * В `control_core` попадают только прошедшие валидатор команды (`cmd_valid=true`),
+ * fast-домен не повторяет протокольную валидацию.
+ */
+
+/**
+ * @brief Вердикт обработки принятого `CMD_WELD`.
+ */
+typedef enum {
+  TK_CMD_RX_APPLY = 0u, /**< Команда принята и опубликована как последняя валидная. */
+  TK_CMD_RX_REJECT = 1u /**< Команда отвергнута (reserved/поля/seq). */
+} tk_cmd_rx_verdict_t;
+
+/**
+ * @brief Состояние приёмника команд.
+ */
+typedef struct {
+  uint16_t last_seq; /**< Последний применённый `seq`, [-]. */
+  bool has_last; /**< false после старта/выхода из FAULT (следующий валидный кадр = FIRST). */
+  uint16_t status_bits; /**< Биты TK_STATUS_CMD_REJECTED/TK_STATUS_SEQ_GAP_DETECTED, [битовая маска]. */
+  uint16_t cnt_cmd_reject; /**< Счётчик отвергнутых кадров (saturating), [шт]. */
+  uint16_t cnt_seq_gap; /**< Счётчик APPLY с gap по `seq` (saturating), [шт]. */
+  uint32_t last_reject_mask; /**< Маска tk_cmd_reject_bit_t последнего отказа, [битовая маска]. */
+  tk_seq_class_t last_seq_class; /**< Класс `seq` последнего принятого кадра. */
+  tk_cmd_weld_t applied; /**< Последняя применённая (валидная) команда. */
+} tk_cmd_rx_t;
+
+/**
+ * @brief Инициализировать приёмник команд.
+ * @param rx Указатель на состояние.
+ * @return None.
+ * @pre rx != NULL.
+ * @post Нет применённой команды, `seq_applied=0`, счётчики = 0.
+ */
+void tk_cmd_rx_init(tk_cmd_rx_t *rx);
+
+/**
+ * @brief Сбросить историю `seq` (выход из FAULT/восстановление связи).
+ * @param rx Указатель на состояние.
+ * @return None.
+ * @note Следующий валидный кадр будет классифицирован как FIRST и применён без gap.
+ */
+void tk_cmd_rx_restart_seq(tk_cmd_rx_t *rx);
+
+/**
+ * @brief Обработать принятый `CMD_WELD` и при APPLY опубликовать его в `control_core`.
+ * @param rx Указатель на состояние приёмника.
+ * @param cmd Декодированная команда (tk_pdo_cmd_weld_unpack()).
+ * @param in_fault true, если источник в FAULT (правило `fault_reset`).
+ * @param ctrl Контекст `control_core` для публикации (может быть NULL — только классификация/статус).
+ * @return Вердикт APPLY/REJECT.
+ * @pre rx != NULL, cmd != NULL.
+ * @details
+ * Алгоритм (O(1), без циклов):
+ * 1) маска отказа = валидатор полей | маска отказа по `seq`;
+ * 2) REJECT: `CMD_REJECTED=1`, `cnt_cmd_reject++`, `seq_applied` не меняется;
+ * 3) APPLY: `last_seq=seq`, `CMD_REJECTED=0`, `SEQ_GAP_DETECTED` = (класс GAP), `cnt_seq_gap++` на GAP;
+ * 4) APPLY: публикация tk_cmd_rx_to_control() через control_slow_step().
+ */
+tk_cmd_rx_verdict_t tk_cmd_rx_process(tk_cmd_rx_t *rx, const tk_cmd_weld_t *cmd, bool in_fault, control_ctx_t *ctrl);
+
+/**
+ * @brief Преобразовать валидную команду протокола в команду `control_core`.
+ * @param cmd Валидная команда `CMD_WELD`.
+ * @param out Указатель на команду `control_core`.
+ * @return None.
+ * @pre cmd прошла tk_pdo_cmd_weld_validate() и политику `seq`.
+ * @note `enable_cmd` = (`mode` ∈ WELD/WELD_CP/WELD_CE/WELD_CV && `enable==1`): ARMED не подаёт энергию.
+ *       `reg_mode`/`target` — по режиму: CP [10 Вт] → [Вт], CE [Дж], CV [мВ] → [В]; I_ref_cmd в CP/CV — потолок тока.
+ *       `max_slew_rate_A_ms` (0 ⇒ TK_MAX_SLEW_RATE_DEFAULT_A_MS) → `di_dt_cmd` [A/с]; control_core применяет его
+ *       не шире локального аппаратного лимита `cfg.di_dt_max`.
+ */
+void tk_cmd_rx_to_control(const tk_cmd_weld_t *cmd, control_cmd_t *out);
+
+/**
+ * @brief Последний применённый `seq` (`FB_STATUS.seq_applied`).
+ * @param rx Указатель на состояние.
+ * @return `seq_applied`, [-].
+ */
+uint16_t tk_cmd_rx_seq_applied(const tk_cmd_rx_t *rx);
+
+/**
+ * @brief Заполнить поля `FB_STATUS`, за которые отвечает приёмник команд.
+ * @param rx Указатель на состояние.
+ * @param status Статус: выставляются `seq_applied`, `cnt_cmd_reject`, `cnt_seq_gap` и биты
+ *               `CMD_REJECTED`/`SEQ_GAP_DETECTED` в `status_word` (остальные биты не трогаются).
+ * @return None.
+ */
+void tk_cmd_rx_fill_status(const tk_cmd_rx_t *rx, tk_fb_status_t *status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TK_CMD_RX_H */
@@ -0,0 +1,138 @@
+#include "tk_cmd_timeout.h"
+
+#include <stddef.h>
+
+#include "tk_cmd_rx.h"
+
+/**
+ * @brief Инкремент saturating u16 счётчика.
+ * @param counter Текущее значение, [шт].
+ * @return counter + 1 с насыщением на 0xFFFF, [шт].
+ */
+static uint16_t tk_cmd_timeout_sat_inc_u16(uint16_t counter)
+{
+  return (uint16_t)(counter + (uint16_t)(counter != UINT16_MAX));
+}
+
+/**
+ * @brief Проверить конфигурацию.
+ * @param cfg Конфигурация.
+ * @return true, если 0 < soft < hard и 0 < ramp <= hard - soft.
+ */
+static bool tk_cmd_timeout_cfg_valid(const tk_cmd_timeout_cfg_t *cfg)
+{
+  return (cfg->soft_timeout_us > 0u) && (cfg->hard_timeout_us > cfg->soft_timeout_us) && (cfg->ramp_time_us > 0u) &&
+         (cfg->ramp_time_us <= (cfg->hard_timeout_us - cfg->soft_timeout_us));
+}
+
+bool tk_cmd_timeout_init(tk_cmd_timeout_t *sup, const tk_cmd_timeout_cfg_t *cfg)
+{
+  const tk_cmd_timeout_cfg_t cfg_default = {
+    .soft_timeout_us = TK_CMD_TIMEOUT_SOFT_US_DEFAULT,
+    .hard_timeout_us = TK_CMD_TIMEOUT_HARD_US_DEFAULT,
+    .ramp_time_us = TK_CMD_TIMEOUT_RAMP_US_DEFAULT
+  };
+  const control_cmd_t cmd_zero = {0};
+
+  const bool valid = (cfg != NULL) && tk_cmd_timeout_cfg_valid(cfg);
+  sup->cfg = valid ? *cfg : cfg_default;
+  sup->state = TK_CMD_TIMEOUT_DISARMED;
+  sup->soft_active = false;
+  sup->hard_latched = false;
+  sup->last_valid_us = 0u;
+  sup->age_us = 0u;
+  sup->age_max_us = 0u;
+  sup->hold = cmd_zero;
+  sup->ramp_k = 1.0f / (float)sup->cfg.ramp_time_us;
+  sup->i_ref_out = 0.0f;
+  sup->cnt_soft_timeout = 0u;
+  sup->cnt_hard_timeout = 0u;
+  return (cfg == NULL) || valid;
+}
+
+void tk_cmd_timeout_on_apply(tk_cmd_timeout_t *sup, const tk_cmd_weld_t *cmd, uint32_t now_us)
+{
+  // SAFETY: hard-timeout снимается только явным `fault_reset` (валидатор пропускает его лишь в IDLE/enable=0).
+  const bool reset = sup->hard_latched && (cmd->fault_reset == 1u);
+  sup->hard_latched = sup->hard_latched && !reset;
+
+  tk_cmd_rx_to_control(cmd, &sup->hold);
+  sup->last_valid_us = now_us;
+  sup->age_us = 0u;
+  sup->soft_active = false;
+  sup->i_ref_out = sup->hold.i_ref_cmd;
+  sup->state = sup->hard_latched ? TK_CMD_TIMEOUT_HARD : TK_CMD_TIMEOUT_OK;
+}
+
+tk_cmd_timeout_state_t tk_cmd_timeout_tick(tk_cmd_timeout_t *sup, uint32_t now_us, control_ctx_t *ctrl)
+{
+  if (sup->state == TK_CMD_TIMEOUT_DISARMED)
+  {
+    return sup->state;
+  }
+
+  // Шаг 1: Возраст последней валидной команды (wrap-safe разность).
+  const uint32_t age_us = now_us - sup->last_valid_us;
+  sup->age_us = age_us;
+  sup->age_max_us = (age_us > sup->age_max_us) ? age_us : sup->age_max_us;
+
+  // Шаг 2: Пороги. soft_active снимается только новой валидной командой (on_apply), не переполнением age.
+  const bool soft_edge = !sup->soft_active && (age_us >= sup->cfg.soft_timeout_us);
+  const bool hard_edge = !sup->hard_latched && (sup->soft_active || soft_edge) && (age_us >= sup->cfg.hard_timeout_us);
+  sup->soft_active = sup->soft_active || soft_edge;
+  sup->hard_latched = sup->hard_latched || hard_edge;
+  sup->cnt_soft_timeout = soft_edge ? tk_cmd_timeout_sat_inc_u16(sup->cnt_soft_timeout) : sup->cnt_soft_timeout;
+  sup->cnt_hard_timeout = hard_edge ? tk_cmd_timeout_sat_inc_u16(sup->cnt_hard_timeout) : sup->cnt_hard_timeout;
+
+  if (sup->hard_latched)
+  {
+    // SAFETY: hard-timeout ⇒ запрет энергии в control_core на каждом tick (переживает любую публикацию).
+    const control_cmd_t stop = {.i_ref_cmd = 0.0f, .enable_cmd = false, .cmd_valid = true};
+    sup->i_ref_out = 0.0f;
+    sup->state = TK_CMD_TIMEOUT_HARD;
+    if (ctrl != NULL)
+    {
+      control_slow_step(ctrl, &stop);
+    }
+    return sup->state;
+  }
+
+  if (!sup->soft_active)
+  {
+    sup->state = TK_CMD_TIMEOUT_OK;
+    return sup->state;
+  }
+
+  // Шаг 3: SOFT — линейный спад от удерживаемой уставки; монотонность защищает от wrap возраста.
+  float frac = 1.0f - (float)(age_us - sup->cfg.soft_timeout_us) * sup->ramp_k;
+  frac = (frac > 0.0f) ? frac : 0.0f;
+  const float i_ramp = sup->hold.i_ref_cmd * frac;
+  sup->i_ref_out = (i_ramp < sup->i_ref_out) ? i_ramp : sup->i_ref_out;
+
+  const control_cmd_t ramp = {
+    .i_ref_cmd = sup->i_ref_out,
+    .enable_cmd = sup->hold.enable_cmd && (sup->i_ref_out > 0.0f),
+    .cmd_valid = true
+  };
+  sup->state = TK_CMD_TIMEOUT_SOFT;
+  if (ctrl != NULL)
+  {
+    control_slow_step(ctrl, &ramp);
+  }
+  return sup->state;
+}
+
+bool tk_cmd_timeout_publish_allowed(const tk_cmd_timeout_t *sup)
+{
+  return !sup->hard_latched;
+}
+
+void tk_cmd_timeout_fill_status(const tk_cmd_timeout_t *sup, tk_fb_status_t *status)
+{
+  const uint16_t own_bits = (uint16_t)(TK_STATUS_COMMS_SOFT_TIMEOUT_ACTIVE | TK_STATUS_COMMS_HARD_TIMEOUT_ACTIVE);
+  uint16_t bits = 0u;
+  bits |= (uint16_t)((uint32_t)sup->soft_active * TK_STATUS_COMMS_SOFT_TIMEOUT_ACTIVE);
+  bits |= (uint16_t)((uint32_t)sup->hard_latched * TK_STATUS_COMMS_HARD_TIMEOUT_ACTIVE);
+  status->status_word = (uint16_t)((status->status_word & (uint16_t)~own_bits) | bits);
+  status->fault_word = (uint16_t)(status->fault_word | (uint16_t)((uint32_t)sup->hard_latched * TK_FAULT_COMMS_TIMEOUT_HARD));
+}
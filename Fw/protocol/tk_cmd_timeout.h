@@ -0,0 +1,127 @@
+#ifndef TK_CMD_TIMEOUT_H
+#define TK_CMD_TIMEOUT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "control_core.h"
+#include "tk_pdo_codec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file tk_cmd_timeout.h
+ * @brief Supervisor таймаутов команд ТК: soft-timeout (controlled stop) и hard-timeout (запрет + FAULT).
+ * @details
+ * Политика PROJECT_CONTEXT §5 / PROTOCOL_TK_ETHERCAT:
+ * - нет валидных `CMD_WELD` дольше soft-timeout (5 мс) ⇒ `COMMS_SOFT_TIMEOUT_ACTIVE`, спад `I_ref_used`;
+ * - нет валидных `CMD_WELD` дольше hard-timeout (20 мс) ⇒ `COMMS_HARD_TIMEOUT_ACTIVE` + `fault_word.COMMS_TIMEOUT_HARD`
+ *   (latch до восстановления связи и `fault_reset`).
+ *
+ * Домен: slow (250 мкс / 4 кГц, task), тактируется timebase. Каждый tick — O(1), без аллокаций и блокировок:
+ * в soft-timeout спадающая уставка публикуется в double-buffer `control_core` через control_slow_step(),
+ * fast-домен защёлкивает её на границе периода PWM как обычную команду.
+ *
+ * Спад линейный от последней валидной уставки до 0 за `ramp_time_us` и считается напрямую из возраста команды
+ * (без накопления ошибки и зависимости от частоты tick). `ramp_time_us <= hard_timeout_us - soft_timeout_us`,
+ * поэтому энергия снята до hard-timeout.
+ *
+ * Supervisor взводится первой валидной командой: до неё энергии нет и таймаут не отсчитывается.
+ */
+
+#define TK_CMD_TIMEOUT_SOFT_US_DEFAULT (5000u)  /**< Soft-timeout (Draft 0.2), [мкс]. */
+#define TK_CMD_TIMEOUT_HARD_US_DEFAULT (20000u) /**< Hard-timeout (Draft 0.2), [мкс]. */
+#define TK_CMD_TIMEOUT_RAMP_US_DEFAULT (10000u) /**< Время спада уставки до 0 в soft-timeout, [мкс]. */
+
+/**
+ * @brief Состояние supervisor.
+ */
+typedef enum {
+  TK_CMD_TIMEOUT_DISARMED = 0u, /**< Не было ни одной валидной команды (таймаут не отсчитывается). */
+  TK_CMD_TIMEOUT_OK = 1u,       /**< Команды свежие. */
+  TK_CMD_TIMEOUT_SOFT = 2u,     /**< Soft-timeout: controlled stop. */
+  TK_CMD_TIMEOUT_HARD = 3u      /**< Hard-timeout: запрет сварки, FAULT latch. */
+} tk_cmd_timeout_state_t;
+
+/**
+ * @brief Конфигурация supervisor.
+ */
+typedef struct {
+  uint32_t soft_timeout_us; /**< Soft-timeout, [мкс]. */
+  uint32_t hard_timeout_us; /**< Hard-timeout, [мкс] (> soft_timeout_us). */
+  uint32_t ramp_time_us; /**< Время спада уставки до 0, [мкс] (<= hard - soft). */
+} tk_cmd_timeout_cfg_t;
+
+/**
+ * @brief Состояние supervisor таймаутов.
+ */
+typedef struct {
+  tk_cmd_timeout_cfg_t cfg; /**< Конфигурация. */
+  tk_cmd_timeout_state_t state; /**< Текущее состояние. */
+  bool soft_active; /**< Нет валидных команд дольше soft-timeout (бит `COMMS_SOFT_TIMEOUT_ACTIVE`). */
+  bool hard_latched; /**< Hard-timeout защёлкнут (сброс — tk_cmd_timeout_on_apply() с `fault_reset`). */
+  uint32_t last_valid_us; /**< Момент последней валидной команды, [мкс]. */
+  uint32_t age_us; /**< Возраст последней валидной команды на последнем tick, [мкс]. */
+  uint32_t age_max_us; /**< Максимальный возраст команды (`cmd_age_max_us`), [мкс]. */
+  control_cmd_t hold; /**< Последняя валидная команда (точка начала спада). */
+  float ramp_k; /**< Обратное время спада, [1/мкс]. */
+  float i_ref_out; /**< Уставка, опубликованная на последнем tick в SOFT/HARD, [A]. */
+  uint16_t cnt_soft_timeout; /**< Счётчик входов в soft-timeout (saturating), [шт]. */
+  uint16_t cnt_hard_timeout; /**< Счётчик входов в hard-timeout (saturating), [шт]. */
+} tk_cmd_timeout_t;
+
+/**
+ * @brief Инициализировать supervisor.
+ * @param sup Указатель на состояние.
+ * @param cfg Конфигурация (NULL — значения по умолчанию).
+ * @return true, если конфигурация валидна; иначе применены значения по умолчанию.
+ * @post Состояние DISARMED.
+ */
+bool tk_cmd_timeout_init(tk_cmd_timeout_t *sup, const tk_cmd_timeout_cfg_t *cfg);
+
+/**
+ * @brief Учесть применённую (APPLY) команду.
+ * @param sup Указатель на состояние.
+ * @param cmd Команда, получившая APPLY в tk_cmd_rx_process().
+ * @param now_us Момент приёма, [мкс].
+ * @return None.
+ * @details
+ * Обновляет момент последней валидной команды и снимает soft-timeout.
+ * Hard-timeout снимается только командой `fault_reset=1` (IDLE, enable=0) — она сама подтверждает восстановление связи.
+ */
+void tk_cmd_timeout_on_apply(tk_cmd_timeout_t *sup, const tk_cmd_weld_t *cmd, uint32_t now_us);
+
+/**
+ * @brief Шаг supervisor (каждый tick slow-домена).
+ * @param sup Указатель на состояние.
+ * @param now_us Текущее время timebase, [мкс].
+ * @param ctrl Контекст `control_core` для публикации спада/запрета (может быть NULL).
+ * @return Текущее состояние.
+ * @details
+ * O(1): возраст команды → состояние; в SOFT публикуется спадающая уставка (enable сохраняется, пока уставка > 0),
+ * в HARD — `enable_cmd=false`, `i_ref_cmd=0`. В OK/DISARMED ничего не публикуется.
+ */
+tk_cmd_timeout_state_t tk_cmd_timeout_tick(tk_cmd_timeout_t *sup, uint32_t now_us, control_ctx_t *ctrl);
+
+/**
+ * @brief Разрешена ли публикация принятых команд в `control_core`.
+ * @param sup Указатель на состояние.
+ * @return false при защёлкнутом hard-timeout (команды только классифицируются, до `fault_reset`).
+ */
+bool tk_cmd_timeout_publish_allowed(const tk_cmd_timeout_t *sup);
+
+/**
+ * @brief Заполнить поля `FB_STATUS`, за которые отвечает supervisor.
+ * @param sup Указатель на состояние.
+ * @param status Статус: биты `COMMS_SOFT/HARD_TIMEOUT_ACTIVE` в `status_word` и `COMMS_TIMEOUT_HARD` в `fault_word`.
+ * @return None.
+ */
+void tk_cmd_timeout_fill_status(const tk_cmd_timeout_t *sup, tk_fb_status_t *status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TK_CMD_TIMEOUT_H */
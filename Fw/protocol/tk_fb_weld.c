@@ -0,0 +1,29 @@
+#include "tk_fb_weld.h"
+
+/**
+ * @brief Насыщающее преобразование неотрицательного float в u32.
+ * @param value Значение (NaN/отрицательное ⇒ 0), [ед. поля].
+ * @param max Максимум поля, [ед. поля].
+ * @return round(value), ограниченное [0..max].
+ */
+static uint32_t tk_fb_weld_sat_u32(float value, uint32_t max)
+{
+  if (!(value > 0.0f))
+  {
+    return 0u;
+  }
+  if (value >= (float)max)
+  {
+    return max;
+  }
+  return (uint32_t)(value + 0.5f);
+}
+
+void tk_fb_weld_fill_status(const meas_weld_report_t *report, tk_fb_status_t *status)
+{
+  status->weld_id = report->done ? report->weld_id : 0u;
+  status->weld_energy_mj = tk_fb_weld_sat_u32(report->energy_j * 1000.0f, UINT32_MAX);
+  status->weld_charge_mas = tk_fb_weld_sat_u32(report->charge_c * 1000.0f, UINT32_MAX);
+  status->weld_limit_periods =
+    (uint16_t)((report->limit_periods > UINT16_MAX) ? UINT16_MAX : report->limit_periods);
+}
@@ -0,0 +1,33 @@
+#ifndef TK_FB_WELD_H
+#define TK_FB_WELD_H
+
+#include "meas_weld_acc.h"
+#include "tk_pdo_codec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file tk_fb_weld.h
+ * @brief Выжимка отчёта сварки (meas_weld_acc) в поля `weld_*` статуса `FB_STATUS`.
+ * @details
+ * Протокольный слой отображает отчёт измерительного тракта в формат кадра (как tk_cmd_rx — команду в
+ * control_core): измерения не зависят от кодека PDO. Домен: slow (формирование статуса), O(1).
+ * Масштабирование с насыщением: энергия [мДж] u32, заряд [мА·с] u32, периоды LIMIT u16.
+ */
+
+/**
+ * @brief Заполнить поля `weld_*` в `FB_STATUS` по отчёту последней завершённой сварки.
+ * @param report Отчёт (`meas_weld_acc_t.last`); `done=false` ⇒ `weld_id=0` (отчёта нет).
+ * @param status Статус: выставляются `weld_id`, `weld_energy_mj`, `weld_charge_mas`, `weld_limit_periods`
+ *               (saturating; остальные поля не трогаются).
+ * @return None.
+ */
+void tk_fb_weld_fill_status(const meas_weld_report_t *report, tk_fb_status_t *status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TK_FB_WELD_H */
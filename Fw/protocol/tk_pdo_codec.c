@@ -0,0 +1,155 @@
+#include "tk_pdo_codec.h"
+
+/*
+ * Раскладка по словам (байт N кадра = байт (N % 4) слова N / 4, LE).
+ *
+ * CMD_WELD (4 слова):
+ *   w0: [15:0] seq, [23:16] mode, [31:24] enable
+ *   w1: [31:0] I_ref_cmd (i32, mA)
+ *   w2: [15:0] max_slew_rate_A_ms, [23:16] fault_reset, [31:24] flags (MUST=0)
+ *   w3: [7:0] crc (MUST=0), [15:8] reserved0 (MUST=0), [31:16] target (u16; MUST=0 вне CP/CE/CV)
+ *
+ * FB_STATUS (12 слов):
+ *   w0: [15:0] seq_applied, [23:16] state, [31:24] reserved0
+ *   w1: [15:0] status_word, [31:16] fault_word
+ *   w2: [15:0] limit_word, [31:16] fault_code
+ *   w3: [31:0] I_ref_used (i32, mA)
+ *   w4: [15:0] duty_used_permille, [31:16] I_per[15:0]
+ *   w5: [15:0] I_per[31:16], [31:16] U_per
+ *   w6: [15:0] weld_limit_periods (бывший reserved_power), [31:16] cnt_cmd_reject
+ *   w7: [15:0] cnt_seq_gap, [31:16] cnt_adc_fault
+ *   w8: [15:0] cnt_comms_fault, [31:16] cnt_ctrl_overrun
+ *   w9: [15:0] cnt_log_overrun, [31:16] weld_id
+ *   w10: [31:0] weld_energy_mj
+ *   w11: [31:0] weld_charge_mas
+ */
+
+#define TK_PDO_SEQ_HALF_RANGE (0x7FFFu) /**< Граница "вперёд/назад" для half-range правила, [-]. */
+
+void tk_pdo_cmd_weld_unpack(const volatile uint32_t *window, tk_cmd_weld_t *cmd)
+{
+  const uint32_t w0 = window[0];
+  const uint32_t w1 = window[1];
+  const uint32_t w2 = window[2];
+  const uint32_t w3 = window[3];
+
+  cmd->seq = (uint16_t)(w0 & 0xFFFFu);
+  cmd->mode = (uint8_t)((w0 >> 16) & 0xFFu);
+  cmd->enable = (uint8_t)(w0 >> 24);
+  cmd->i_ref_cmd_ma = (int32_t)w1;
+  cmd->max_slew_rate_a_ms = (uint16_t)(w2 & 0xFFFFu);
+  cmd->fault_reset = (uint8_t)((w2 >> 16) & 0xFFu);
+  cmd->target = (uint16_t)(w3 >> 16);
+  cmd->must_be_zero = (w2 >> 24) | (w3 & 0xFFFFu);
+}
+
+void tk_pdo_cmd_weld_pack(const tk_cmd_weld_t *cmd, volatile uint32_t *window)
+{
+  window[0] = (uint32_t)cmd->seq | ((uint32_t)cmd->mode << 16) | ((uint32_t)cmd->enable << 24);
+  window[1] = (uint32_t)cmd->i_ref_cmd_ma;
+  window[2] = (uint32_t)cmd->max_slew_rate_a_ms | ((uint32_t)cmd->fault_reset << 16);
+  window[3] = (uint32_t)cmd->target << 16;
+}
+
+uint32_t tk_pdo_cmd_weld_validate(const tk_cmd_weld_t *cmd, bool in_fault)
+{
+  // SAFETY: любой "сомнительный" кадр даёт ненулевую маску ⇒ REJECT (не включаем энергию вслепую).
+  // Правила вычисляются все и без ранних выходов: время выполнения не зависит от содержимого кадра.
+  const uint32_t mode = cmd->mode;
+  const uint32_t enable = cmd->enable;
+  const uint32_t fault_reset = cmd->fault_reset;
+  const int32_t i_ref = cmd->i_ref_cmd_ma; /* [mA] */
+
+  const uint32_t outer_mode = (uint32_t)(mode >= TK_MODE_WELD_CP) & (uint32_t)(mode <= TK_MODE_WELD_CV);
+  const uint32_t target_zero = (uint32_t)(cmd->target == 0u);
+
+  const uint32_t reset_requested = (uint32_t)(fault_reset == 1u);
+  const uint32_t reset_context_ok = (uint32_t)in_fault & (uint32_t)(enable == 0u) & (uint32_t)(mode == TK_MODE_IDLE);
+
+  uint32_t reject = 0u;
+  reject |= ((uint32_t)(cmd->must_be_zero != 0u) | ((outer_mode ^ 1u) & (target_zero ^ 1u))) * TK_CMD_REJECT_RESERVED;
+  reject |= (uint32_t)(mode > TK_MODE_WELD_CV) * TK_CMD_REJECT_MODE;
+  reject |= (outer_mode & target_zero) * TK_CMD_REJECT_TARGET;
+  reject |= (uint32_t)(enable > 1u) * TK_CMD_REJECT_ENABLE;
+  reject |= ((uint32_t)(enable == 0u) & (uint32_t)(mode != TK_MODE_IDLE)) * TK_CMD_REJECT_MODE_ENABLE;
+  reject |= ((uint32_t)(i_ref < 0) | (uint32_t)(i_ref > TK_I_REF_MAX_MA)) * TK_CMD_REJECT_I_REF_RANGE;
+  reject |= (uint32_t)(cmd->max_slew_rate_a_ms > TK_MAX_SLEW_RATE_MAX_A_MS) * TK_CMD_REJECT_SLEW_RANGE;
+  reject |= ((uint32_t)(fault_reset > 1u) | (reset_requested & (reset_context_ok ^ 1u))) * TK_CMD_REJECT_FAULT_RESET;
+  return reject;
+}
+
+tk_seq_class_t tk_pdo_seq_classify(uint16_t last_seq, uint16_t seq, bool has_last)
+{
+  const uint32_t delta = (uint32_t)(uint16_t)(seq - last_seq); /* [-], по модулю 65536 */
+
+  // Классы взаимоисключающие, поэтому сумма "bool * код" даёт ровно один код без ветвлений.
+  const uint32_t cls = ((uint32_t)(delta == 0u) * (uint32_t)TK_SEQ_REPEAT) +
+                       ((uint32_t)(delta == 1u) * (uint32_t)TK_SEQ_NEXT) +
+                       (((uint32_t)(delta > 1u) & (uint32_t)(delta <= TK_PDO_SEQ_HALF_RANGE)) * (uint32_t)TK_SEQ_GAP) +
+                       ((uint32_t)(delta > TK_PDO_SEQ_HALF_RANGE) * (uint32_t)TK_SEQ_BACKWARD);
+
+  return has_last ? (tk_seq_class_t)cls : TK_SEQ_FIRST;
+}
+
+uint32_t tk_pdo_seq_reject_mask(tk_seq_class_t seq_class)
+{
+  return ((uint32_t)(seq_class == TK_SEQ_REPEAT) * TK_CMD_REJECT_SEQ_REPEAT) |
+         ((uint32_t)(seq_class == TK_SEQ_BACKWARD) * TK_CMD_REJECT_SEQ_BACKWARD);
+}
+
+void tk_pdo_fb_status_pack(const tk_fb_status_t *status, volatile uint32_t *window)
+{
+  const uint32_t i_per = (uint32_t)status->i_per_ma;
+
+  window[0] = (uint32_t)status->seq_applied | ((uint32_t)status->state << 16);
+  window[1] = (uint32_t)status->status_word | ((uint32_t)status->fault_word << 16);
+  window[2] = (uint32_t)status->limit_word | ((uint32_t)status->fault_code << 16);
+  window[3] = (uint32_t)status->i_ref_used_ma;
+  window[4] = (uint32_t)status->duty_used_permille | (i_per << 16);
+  window[5] = (i_per >> 16) | ((uint32_t)status->u_per_dv << 16);
+  window[6] = (uint32_t)status->weld_limit_periods | ((uint32_t)status->cnt_cmd_reject << 16);
+  window[7] = (uint32_t)status->cnt_seq_gap | ((uint32_t)status->cnt_adc_fault << 16);
+  window[8] = (uint32_t)status->cnt_comms_fault | ((uint32_t)status->cnt_ctrl_overrun << 16);
+  window[9] = (uint32_t)status->cnt_log_overrun | ((uint32_t)status->weld_id << 16);
+  window[10] = status->weld_energy_mj;
+  window[11] = status->weld_charge_mas;
+}
+
+uint32_t tk_pdo_fb_status_unpack(const volatile uint32_t *window, tk_fb_status_t *status)
+{
+  const uint32_t w0 = window[0];
+  const uint32_t w1 = window[1];
+  const uint32_t w2 = window[2];
+  const uint32_t w3 = window[3];
+  const uint32_t w4 = window[4];
+  const uint32_t w5 = window[5];
+  const uint32_t w6 = window[6];
+  const uint32_t w7 = window[7];
+  const uint32_t w8 = window[8];
+  const uint32_t w9 = window[9];
+  const uint32_t w10 = window[10];
+  const uint32_t w11 = window[11];
+
+  status->seq_applied = (uint16_t)(w0 & 0xFFFFu);
+  status->state = (uint8_t)((w0 >> 16) & 0xFFu);
+  status->status_word = (uint16_t)(w1 & 0xFFFFu);
+  status->fault_word = (uint16_t)(w1 >> 16);
+  status->limit_word = (uint16_t)(w2 & 0xFFFFu);
+  status->fault_code = (uint16_t)(w2 >> 16);
+  status->i_ref_used_ma = (int32_t)w3;
+  status->duty_used_permille = (uint16_t)(w4 & 0xFFFFu);
+  status->i_per_ma = (int32_t)((w4 >> 16) | (w5 << 16));
+  status->u_per_dv = (uint16_t)(w5 >> 16);
+  status->cnt_cmd_reject = (uint16_t)(w6 >> 16);
+  status->cnt_seq_gap = (uint16_t)(w7 & 0xFFFFu);
+  status->cnt_adc_fault = (uint16_t)(w7 >> 16);
+  status->cnt_comms_fault = (uint16_t)(w8 & 0xFFFFu);
+  status->cnt_ctrl_overrun = (uint16_t)(w8 >> 16);
+  status->cnt_log_overrun = (uint16_t)(w9 & 0xFFFFu);
+  status->weld_id = (uint16_t)(w9 >> 16);
+  status->weld_energy_mj = w10;
+  status->weld_charge_mas = w11;
+  status->weld_limit_periods = (uint16_t)(w6 & 0xFFFFu);
+
+  return w0 >> 24;
+}
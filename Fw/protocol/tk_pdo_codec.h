@@ -0,0 +1,263 @@
+#ifndef TK_PDO_CODEC_H
+#define TK_PDO_CODEC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file tk_pdo_codec.h
+ * @brief Кодек EtherCAT PDO `CMD_WELD`/`FB_STATUS` (профиль `docs/protocols/PROTOCOL_TK_ETHERCAT.md`).
+ * @details
+ * Кодек работает прямо по окну process image (COMX DPM, отображённое через FMC):
+ * - чтение/запись только выровненными 32-битными словами (4 слова `CMD_WELD`, 12 слов `FB_STATUS`);
+ * - поля выделяются сдвигами/масками, без packed-структур, `memcpy` и промежуточных копий кадра;
+ * - каждое слово окна читается/пишется ровно один раз (минимум транзакций FMC).
+ *
+ * Раскладка LE (см. PROTOCOL_TK_ETHERCAT §3.4/§4.1.2) совпадает с порядком байт Cortex-M4,
+ * поэтому слово окна интерпретируется без перестановки байт.
+ *
+ * Валидаторы branch-light: каждое правило вычисляется как бит маски отказа, итог — OR.
+ * Кодек не хранит состояние и не знает про таймауты/счётчики: это зона `tk_seq`/supervisor.
+ */
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__)
+#error "tk_pdo_codec: word-level LE codec requires a little-endian target"
+#endif
+
+#define TK_PDO_CMD_WELD_SIZE_BYTES (16u)  /**< Длина `RxPDO_CMD_WELD`, [байт]. */
+#define TK_PDO_CMD_WELD_SIZE_WORDS (4u)   /**< Длина `RxPDO_CMD_WELD`, [слова 32 бит]. */
+#define TK_PDO_FB_STATUS_SIZE_BYTES (48u) /**< Длина `TxPDO_FB_STATUS`, [байт]. */
+#define TK_PDO_FB_STATUS_SIZE_WORDS (12u) /**< Длина `TxPDO_FB_STATUS`, [слова 32 бит]. */
+
+#define TK_I_REF_MAX_MA (50000000)                /**< Максимальная уставка `I_ref_max_mA`, [mA]. */
+#define TK_MAX_SLEW_RATE_MAX_A_MS (50000u)        /**< Верхняя граница `max_slew_rate_A_ms`, [A/мс]. */
+#define TK_MAX_SLEW_RATE_DEFAULT_A_MS (5000u)     /**< Значение по умолчанию при `max_slew_rate_A_ms=0`, [A/мс]. */
+
+/**
+ * @brief Запрошенный режим (`CMD_WELD.mode`).
+ */
+typedef enum {
+  TK_MODE_IDLE = 0u,  /**< Запрос IDLE (сварка запрещена). */
+  TK_MODE_ARMED = 1u, /**< Запрос ARMED (подготовка). */
+  TK_MODE_WELD = 2u,    /**< Запрос WELD (активная сварка, постоянный ток). */
+  TK_MODE_WELD_CP = 3u, /**< WELD с внешним контуром постоянной мощности (`target` = P_ref, [10 Вт]). */
+  TK_MODE_WELD_CE = 4u, /**< WELD с отсечкой по энергии за сварку (`target` = E_ref, [Дж]). */
+  TK_MODE_WELD_CV = 5u  /**< WELD с внешним контуром постоянного напряжения (`target` = U_ref, [мВ]). */
+} tk_mode_t;
+
+/**
+ * @brief Фактическое состояние источника (`FB_STATUS.state`).
+ */
+typedef enum {
+  TK_STATE_IDLE = 0u,  /**< IDLE: PWM OFF. */
+  TK_STATE_ARMED = 1u, /**< ARMED: готовность, PWM OFF. */
+  TK_STATE_WELD = 2u,  /**< WELD: активная сварка. */
+  TK_STATE_FAULT = 3u  /**< FAULT: latched-off до recovery. */
+} tk_state_t;
+
+/**
+ * @brief Биты `FB_STATUS.status_word`.
+ */
+typedef enum {
+  TK_STATUS_READY = (1u << 0),                     /**< Готов к сварке при enable=1 (gating OK). */
+  TK_STATUS_CMD_REJECTED = (1u << 1),              /**< Последний `CMD_WELD` отвергнут. */
+  TK_STATUS_COMMS_SOFT_TIMEOUT_ACTIVE = (1u << 2), /**< Активен soft-timeout команд. */
+  TK_STATUS_COMMS_HARD_TIMEOUT_ACTIVE = (1u << 3), /**< Активен hard-timeout команд. */
+  TK_STATUS_BUS_OFF_ACTIVE = (1u << 4),            /**< CAN-specific; для EtherCAT всегда 0. */
+  TK_STATUS_ADC_INVALID = (1u << 5),               /**< Измерения невалидны. */
+  TK_STATUS_CTRL_OVERRUN = (1u << 6),              /**< Overrun критического цикла в отчётном окне. */
+  TK_STATUS_MANUAL_DUTY_ACTIVE = (1u << 7),        /**< Активен сервисный режим ManualDuty. */
+  TK_STATUS_SEQ_GAP_DETECTED = (1u << 8)           /**< Последний APPLY имел gap по `seq`. */
+} tk_status_bit_t;
+
+/**
+ * @brief Биты `FB_STATUS.fault_word`.
+ */
+typedef enum {
+  TK_FAULT_DRIVER_FAULT = (1u << 0),       /**< Авария драйвера. */
+  TK_FAULT_HW_TRIP = (1u << 1),            /**< Аппаратный trip (BKIN). */
+  TK_FAULT_ADC_FAULT = (1u << 2),          /**< Авария измерений. */
+  TK_FAULT_COMMS_TIMEOUT_HARD = (1u << 3), /**< Hard-timeout команд ТК. */
+  TK_FAULT_CTRL_OVERRUN = (1u << 4),       /**< Overrun критического цикла (по политике latch). */
+  TK_FAULT_OVERTEMP = (1u << 5)            /**< Перегрев. */
+} tk_fault_bit_t;
+
+/**
+ * @brief Биты `FB_STATUS.limit_word`.
+ */
+typedef enum {
+  TK_LIMIT_DUTY = (1u << 0),                 /**< Ограничение по скважности. */
+  TK_LIMIT_DI_DT = (1u << 1),                /**< Ограничение dI/dt. */
+  TK_LIMIT_BY_VS = (1u << 2),                /**< Ограничение по вольт-секундам. */
+  TK_LIMIT_SATURATION_SUSPECTED = (1u << 3)  /**< Подозрение на насыщение трансформатора. */
+} tk_limit_bit_t;
+
+/**
+ * @brief Коды `fault_code` (последняя причина), PROTOCOL_TK_ETHERCAT §6.
+ */
+typedef enum {
+  TK_FAULT_CODE_NONE = 0u,               /**< Нет причины. */
+  TK_FAULT_CODE_DRIVER_FAULT = 1u,       /**< Авария драйвера. */
+  TK_FAULT_CODE_HW_TRIP = 2u,            /**< Аппаратный trip. */
+  TK_FAULT_CODE_ADC_SPI_TIMEOUT = 3u,    /**< Таймаут SPI АЦП. */
+  TK_FAULT_CODE_ADC_RANGE = 4u,          /**< Выход измерений за диапазон. */
+  TK_FAULT_CODE_ADC_STUCK = 5u,          /**< Залипание измерений. */
+  TK_FAULT_CODE_COMMS_TIMEOUT_HARD = 6u, /**< Hard-timeout команд. */
+  TK_FAULT_CODE_COMMS_TIMEOUT_SOFT = 7u, /**< Soft-timeout команд. */
+  TK_FAULT_CODE_BUS_OFF = 8u,            /**< CAN-specific, для EtherCAT не используется. */
+  TK_FAULT_CODE_CMD_INVALID = 9u,        /**< Невалидная команда. */
+  TK_FAULT_CODE_CTRL_OVERRUN = 10u,      /**< Overrun критического цикла. */
+  TK_FAULT_CODE_OVERTEMP = 11u,          /**< Перегрев. */
+  TK_FAULT_CODE_INCOMPATIBLE_MODE = 12u, /**< Режим несовместим с конфигурацией. */
+  TK_FAULT_CODE_INTERNAL_ERR = 13u       /**< Внутренняя ошибка. */
+} tk_fault_code_t;
+
+/**
+ * @brief Биты маски отказа валидатора `CMD_WELD` (0 = команда валидна).
+ */
+typedef enum {
+  TK_CMD_REJECT_NONE = 0u,               /**< Нет причин отказа. */
+  TK_CMD_REJECT_RESERVED = (1u << 0),    /**< `flags/crc/reserved*` != 0. */
+  TK_CMD_REJECT_MODE = (1u << 1),        /**< `mode` вне перечисления. */
+  TK_CMD_REJECT_ENABLE = (1u << 2),      /**< `enable` не 0/1. */
+  TK_CMD_REJECT_MODE_ENABLE = (1u << 3), /**< `enable=0` при `mode!=IDLE`. */
+  TK_CMD_REJECT_I_REF_RANGE = (1u << 4), /**< `I_ref_cmd` вне `0…I_ref_max_mA`. */
+  TK_CMD_REJECT_SLEW_RANGE = (1u << 5),  /**< `max_slew_rate_A_ms` вне `0…50000`. */
+  TK_CMD_REJECT_FAULT_RESET = (1u << 6), /**< `fault_reset` невалиден/неприменим в текущем состоянии. */
+  TK_CMD_REJECT_SEQ_REPEAT = (1u << 7),  /**< Повтор `seq` (delta==0). */
+  TK_CMD_REJECT_SEQ_BACKWARD = (1u << 8), /**< Скачок `seq` назад (delta>0x7FFF). */
+  TK_CMD_REJECT_TARGET = (1u << 9)       /**< `target=0` в режиме CP/CE/CV. */
+} tk_cmd_reject_bit_t;
+
+/**
+ * @brief Классификация `seq` по half-range правилу (PROTOCOL_TK_ETHERCAT §1.2.3).
+ */
+typedef enum {
+  TK_SEQ_FIRST = 0u,    /**< Первый кадр после старта/выхода из FAULT: APPLY. */
+  TK_SEQ_NEXT = 1u,     /**< delta==1: APPLY. */
+  TK_SEQ_GAP = 2u,      /**< 1<delta<=0x7FFF: APPLY + SEQ_GAP_DETECTED. */
+  TK_SEQ_REPEAT = 3u,   /**< delta==0: REJECT. */
+  TK_SEQ_BACKWARD = 4u  /**< delta>0x7FFF: REJECT. */
+} tk_seq_class_t;
+
+/**
+ * @brief Декодированная команда `CMD_WELD` (поля в единицах протокола).
+ */
+typedef struct {
+  uint16_t seq; /**< Номер командного кадра, [-]. */
+  uint8_t mode; /**< Запрошенный режим (tk_mode_t), [-]. */
+  uint8_t enable; /**< Разрешение сварки (0/1), [-]. */
+  int32_t i_ref_cmd_ma; /**< Уставка тока, [mA]. */
+  uint16_t max_slew_rate_a_ms; /**< Лимит dI/dt (0 = default), [A/мс]. */
+  uint8_t fault_reset; /**< Запрос recovery (0/1), [-]. */
+  uint16_t target; /**< Цель внешнего контура (CP [10 Вт] / CE [Дж] / CV [мВ]; иначе MUST=0), [-]. */
+  uint32_t must_be_zero; /**< OR всех битов `flags/crc/reserved0`, [битовая маска]. */
+} tk_cmd_weld_t;
+
+/**
+ * @brief Поля статуса `FB_STATUS` (reserved поля не хранятся: при передаче всегда 0).
+ * @details Поля `weld_*` — расширение отчёта сварки в бывших `reserved_tail` (байты 38..47) и `reserved_power`
+ *          (байты 24..25, `weld_limit_periods`): заряд занимает полное слово u32 [мА·с].
+ */
+typedef struct {
+  uint16_t seq_applied; /**< Последний защёлкнутый `seq`, [-]. */
+  uint8_t state; /**< Состояние (tk_state_t), [-]. */
+  uint16_t status_word; /**< Биты tk_status_bit_t, [битовая маска]. */
+  uint16_t fault_word; /**< Биты tk_fault_bit_t, [битовая маска]. */
+  uint16_t limit_word; /**< Биты tk_limit_bit_t, [битовая маска]. */
+  uint16_t fault_code; /**< Последняя причина (tk_fault_code_t), [-]. */
+  int32_t i_ref_used_ma; /**< Использованная уставка, [mA]. */
+  uint16_t duty_used_permille; /**< Применённая скважность, [‰]. */
+  int32_t i_per_ma; /**< Ток за период PWM, [mA]. */
+  uint16_t u_per_dv; /**< Напряжение за период PWM, [0.1 В]. */
+  uint16_t cnt_cmd_reject; /**< Счётчик отвергнутых команд (saturating), [шт]. */
+  uint16_t cnt_seq_gap; /**< Счётчик gap по seq (saturating), [шт]. */
+  uint16_t cnt_adc_fault; /**< Счётчик невалидности измерений (saturating), [шт]. */
+  uint16_t cnt_comms_fault; /**< Счётчик входов в timeout (saturating), [шт]. */
+  uint16_t cnt_ctrl_overrun; /**< Счётчик overrun (saturating), [шт]. */
+  uint16_t cnt_log_overrun; /**< Счётчик overrun логирования (saturating), [шт]. */
+  uint16_t weld_id; /**< Номер последнего завершённого отчёта сварки (0 — отчёта нет), [-]. */
+  uint32_t weld_energy_mj; /**< Энергия последней сварки (saturating), [мДж]. */
+  uint32_t weld_charge_mas; /**< Заряд последней сварки (saturating), [мА·с]. */
+  uint16_t weld_limit_periods; /**< Периодов в LIMIT за последнюю сварку (saturating), [периоды PWM]. */
+} tk_fb_status_t;
+
+/**
+ * @brief Декодировать `CMD_WELD` из окна process image.
+ * @param window Окно RxPDO (4 выровненных слова; может быть FMC/volatile).
+ * @param cmd Указатель на результат.
+ * @return None.
+ * @pre window выровнен на 4 байта, window != NULL, cmd != NULL.
+ * @note Ровно 4 чтения слова; валидация не выполняется (см. tk_pdo_cmd_weld_validate()).
+ */
+void tk_pdo_cmd_weld_unpack(const volatile uint32_t *window, tk_cmd_weld_t *cmd);
+
+/**
+ * @brief Закодировать `CMD_WELD` в окно (host/эмуляция ТК/тесты).
+ * @param cmd Указатель на команду.
+ * @param window Окно (4 выровненных слова).
+ * @return None.
+ * @pre window выровнен на 4 байта, window != NULL, cmd != NULL.
+ * @note `flags/crc/reserved0` всегда записываются нулями (MUST=0 при передаче); `cmd->must_be_zero` игнорируется.
+ */
+void tk_pdo_cmd_weld_pack(const tk_cmd_weld_t *cmd, volatile uint32_t *window);
+
+/**
+ * @brief Провалидировать поля `CMD_WELD` (без `seq`).
+ * @param cmd Указатель на декодированную команду.
+ * @param in_fault true, если текущее состояние источника FAULT (для правила `fault_reset`).
+ * @return Маска tk_cmd_reject_bit_t (0 = команда валидна).
+ * @pre cmd != NULL.
+ * @details
+ * Правила (PROTOCOL_TK §3.2): reserved MUST=0; `mode` ∈ {IDLE,ARMED,WELD,WELD_CP,WELD_CE,WELD_CV};
+ * `target` != 0 в CP/CE/CV и `target` = 0 (reserved) в остальных режимах; `enable` ∈ {0,1};
+ * `enable=0` ⇒ `mode=IDLE`; `I_ref_cmd` ∈ `0…I_ref_max_mA`; `max_slew_rate_A_ms` ≤ 50000;
+ * `fault_reset` ∈ {0,1}, а `fault_reset=1` допустим только в FAULT при `enable=0`, `mode=IDLE`.
+ * Все правила вычисляются безусловно (константное время, без ранних выходов).
+ */
+uint32_t tk_pdo_cmd_weld_validate(const tk_cmd_weld_t *cmd, bool in_fault);
+
+/**
+ * @brief Классифицировать `seq` относительно последнего применённого.
+ * @param last_seq Последний применённый `seq`, [-].
+ * @param seq Принятый `seq`, [-].
+ * @param has_last false после старта/выхода из FAULT (нет `last_seq`).
+ * @return Класс tk_seq_class_t.
+ */
+tk_seq_class_t tk_pdo_seq_classify(uint16_t last_seq, uint16_t seq, bool has_last);
+
+/**
+ * @brief Маска отказа по классу `seq`.
+ * @param seq_class Класс `seq`.
+ * @return TK_CMD_REJECT_SEQ_REPEAT/TK_CMD_REJECT_SEQ_BACKWARD или 0.
+ */
+uint32_t tk_pdo_seq_reject_mask(tk_seq_class_t seq_class);
+
+/**
+ * @brief Закодировать `FB_STATUS` в окно process image.
+ * @param status Указатель на статус.
+ * @param window Окно TxPDO (12 выровненных слов; может быть FMC/volatile).
+ * @return None.
+ * @pre window выровнен на 4 байта, window != NULL, status != NULL.
+ * @note Ровно 12 записей слова; все reserved поля записываются нулями.
+ */
+void tk_pdo_fb_status_pack(const tk_fb_status_t *status, volatile uint32_t *window);
+
+/**
+ * @brief Декодировать `FB_STATUS` (host-инструменты/тесты/эмуляция ТК).
+ * @param window Окно (12 выровненных слов).
+ * @param status Указатель на результат.
+ * @return OR всех reserved битов кадра (0 = кадр соответствует reserved policy).
+ * @pre window != NULL, status != NULL.
+ */
+uint32_t tk_pdo_fb_status_unpack(const volatile uint32_t *window, tk_fb_status_t *status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TK_PDO_CODEC_H */
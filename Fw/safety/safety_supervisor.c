@@ -0,0 +1,89 @@
+#include "safety_supervisor.h"
+
+#include <stddef.h>
+
+#define SAFETY_LATCH_MASK (SAFETY_CLASS_HARD_MASK | SAFETY_CLASS_SOFT_MASK) /**< Классы с latch, [битовая маска]. */
+#define SAFETY_LIMIT_ESCALATE_DEFAULT (200u) /**< Эскалация LIMIT по умолчанию, [периоды PWM]. */
+#define SAFETY_LIMIT_DECAY_DEFAULT (1u)      /**< Спад аккумулятора по умолчанию, [периоды PWM/период PWM]. */
+
+/**
+ * @brief Маска "все единицы" из логического условия (без ветвления).
+ * @param cond Условие.
+ * @return 0xFFFFFFFF при cond, иначе 0, [битовая маска].
+ */
+static uint32_t safety_mask_from_bool(bool cond)
+{
+  return (uint32_t)0u - (uint32_t)cond;
+}
+
+/**
+ * @brief Шаг одного LIMIT-аккумулятора (leaky bucket, насыщение 0..UINT16_MAX).
+ * @param acc Текущее значение, [периоды PWM].
+ * @param active LIMIT-бит активен в этом периоде.
+ * @param decay Спад за период без LIMIT, [периоды PWM].
+ * @return Новое значение, [периоды PWM].
+ */
+static uint16_t safety_limit_acc_step(uint16_t acc, bool active, uint16_t decay)
+{
+  const uint32_t inc = (uint32_t)acc + (uint32_t)(acc != UINT16_MAX);
+  const uint32_t dec = (uint32_t)acc - ((acc > decay) ? (uint32_t)decay : (uint32_t)acc);
+  const uint32_t sel = safety_mask_from_bool(active);
+  return (uint16_t)((inc & sel) | (dec & ~sel));
+}
+
+void safety_supervisor_init(safety_supervisor_t *sup, const safety_cfg_t *cfg)
+{
+  safety_cfg_t cfg_default;
+  for (uint32_t i = 0u; i < SAFETY_LIMIT_COUNT; ++i)
+  {
+    cfg_default.limit_escalate_ticks[i] = SAFETY_LIMIT_ESCALATE_DEFAULT;
+    sup->limit_acc[i] = 0u;
+  }
+  cfg_default.limit_decay_per_tick = SAFETY_LIMIT_DECAY_DEFAULT;
+
+  sup->cfg = (cfg != NULL) ? *cfg : cfg_default;
+  sup->latched = 0u;
+  sup->first_latched = 0u;
+  atomic_init(&sup->clear_request, (uint_fast32_t)SAFETY_CLEAR_NONE);
+  sup->cnt_hard_trips = 0u;
+  sup->cnt_soft_trips = 0u;
+  sup->cnt_limit_escalations = 0u;
+}
+
+void safety_supervisor_step(safety_supervisor_t *sup, uint32_t raw, safety_out_t *out)
+{
+  // Шаг 1: LIMIT — накопление времени; эскалация при достижении порога (0 = эскалация отключена).
+  bool escalate = false;
+  for (uint32_t i = 0u; i < SAFETY_LIMIT_COUNT; ++i)
+  {
+    const bool bit = ((raw >> (SAFETY_LIMIT_SHIFT + i)) & 1u) != 0u;
+    const uint16_t thr = sup->cfg.limit_escalate_ticks[i];
+    sup->limit_acc[i] = safety_limit_acc_step(sup->limit_acc[i], bit, sup->cfg.limit_decay_per_tick);
+    escalate = escalate | ((thr != 0u) & (sup->limit_acc[i] >= thr));
+  }
+  const uint32_t active = raw | (SAFETY_SOFT_LIMIT_ESCALATED & safety_mask_from_bool(escalate));
+
+  // Шаг 2: Recovery. SAFETY: снимается только защёлка тех битов, чья причина уже исчезла.
+  const uint32_t clear = (uint32_t)atomic_exchange(&sup->clear_request, (uint_fast32_t)SAFETY_CLEAR_NONE);
+  sup->latched &= ~(clear & SAFETY_LATCH_MASK & ~active);
+
+  // Шаг 3: Latch HARD/SOFT; первая причина фиксируется до полного снятия.
+  const uint32_t fresh = active & SAFETY_LATCH_MASK & ~sup->latched;
+  sup->first_latched &= safety_mask_from_bool(sup->latched != 0u);
+  sup->first_latched |= fresh & safety_mask_from_bool(sup->first_latched == 0u);
+  sup->latched |= fresh;
+  sup->cnt_hard_trips += (uint32_t)((fresh & SAFETY_CLASS_HARD_MASK) != 0u);
+  sup->cnt_soft_trips += (uint32_t)((fresh & SAFETY_CLASS_SOFT_MASK) != 0u);
+  sup->cnt_limit_escalations += (uint32_t)((fresh & SAFETY_SOFT_LIMIT_ESCALATED) != 0u);
+
+  // Шаг 4: Разрешение. SAFETY: любой HARD/SOFT (активный или защёлкнутый) запрещает энергию.
+  out->allow = (sup->latched == 0u);
+  out->active = active;
+  out->latched = sup->latched;
+  out->first_latched = sup->first_latched;
+}
+
+void safety_supervisor_request_clear(safety_supervisor_t *sup, safety_clear_t clear)
+{
+  (void)atomic_fetch_or(&sup->clear_request, (uint_fast32_t)clear);
+}
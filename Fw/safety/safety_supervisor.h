@@ -0,0 +1,152 @@
+#ifndef SAFETY_SUPERVISOR_H
+#define SAFETY_SUPERVISOR_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file safety_supervisor.h
+ * @brief Платформо-независимый safety supervisor: агрегация fault-условий в одно слово и разрешение сварки.
+ * @details
+ * Домен: PWM (1–4 кГц), вызывается в control_tick перед control_fast_step() (ARCHITECTURE §3.1, шаг 3).
+ * Шаг выполняется за постоянное время: фиксированное число операций над словами, без ветвлений по данным
+ * (кроме цикла фиксированной длины по LIMIT-аккумуляторам).
+ *
+ * Класс аварии задаётся позицией бита в слове (PROJECT_CONTEXT §6, SAFETY §3/§5):
+ * - HARD  (биты 0..7):   всегда latch; снятие — только явный recovery и только если причина исчезла;
+ * - SOFT  (биты 8..15):  latch до конца цикла сварки / подтверждения ТК (тоже при исчезнувшей причине);
+ * - LIMIT (биты 16..23): без latch, сварку не запрещают; время в LIMIT накапливается (leaky bucket)
+ *                        и при превышении порога эскалирует в SOFT `SAFETY_SOFT_LIMIT_ESCALATED`;
+ * - INFO  (биты 24..31): только телеметрия.
+ *
+ * Recovery запрашивается из slow-домена (ТК `fault_reset`, конец цикла) через атомарный запрос,
+ * который fast-домен забирает в начале следующего шага — без блокировок между доменами.
+ */
+
+#define SAFETY_CLASS_HARD_MASK (0x000000FFu)  /**< Биты класса HARD, [битовая маска]. */
+#define SAFETY_CLASS_SOFT_MASK (0x0000FF00u)  /**< Биты класса SOFT, [битовая маска]. */
+#define SAFETY_CLASS_LIMIT_MASK (0x00FF0000u) /**< Биты класса LIMIT, [битовая маска]. */
+#define SAFETY_CLASS_INFO_MASK (0xFF000000u)  /**< Биты класса INFO, [битовая маска]. */
+#define SAFETY_LIMIT_SHIFT (16u)              /**< Позиция первого LIMIT-бита, [бит]. */
+#define SAFETY_LIMIT_COUNT (8u)               /**< Количество LIMIT-аккумуляторов, [шт]. */
+
+/**
+ * @brief Источники fault-условий (позиция бита = класс).
+ */
+typedef enum {
+  /* HARD: аппаратные/критические, всегда latch. */
+  SAFETY_HARD_DRV_FAULT = (1u << 0),        /**< Fault драйвера (DESAT/UVLO SKYPER). */
+  SAFETY_HARD_HW_TRIP = (1u << 1),          /**< Сработал BKIN/BKIN2 (аппаратный trip). */
+  SAFETY_HARD_OVERCURRENT = (1u << 2),      /**< Превышение Imax (программный монитор). */
+  SAFETY_HARD_OVERTEMP = (1u << 3),         /**< Критический перегрев. */
+  SAFETY_HARD_COMMS_TIMEOUT = (1u << 4),    /**< Hard-timeout команд ТК. */
+  SAFETY_HARD_EXT_SUPERVISOR = (1u << 5),   /**< Внешний супервизор/watchdog. */
+  SAFETY_HARD_CFG_INVALID = (1u << 6),      /**< Невалидная конфигурация/калибровка. */
+
+  /* SOFT: прервать импульс/цикл, latch до конца цикла / ack ТК. */
+  SAFETY_SOFT_MEAS_INVALID = (1u << 8),     /**< Невалидные измерения (stuck/sat/пределы). */
+  SAFETY_SOFT_ADC_TIMEOUT = (1u << 9),      /**< Таймаут SPI/DMA АЦП. */
+  SAFETY_SOFT_OVERRUN = (1u << 10),         /**< Overrun control_tick. */
+  SAFETY_SOFT_NO_CURRENT = (1u << 11),      /**< Нет тока при разрешённой сварке. */
+  SAFETY_SOFT_UNSTABLE = (1u << 12),        /**< Нестабильная регулировка. */
+  SAFETY_SOFT_LIMIT_ESCALATED = (1u << 13), /**< Длительный LIMIT (эскалация, формирует supervisor). */
+
+  /* LIMIT: ограничение без latch, с накоплением времени. */
+  SAFETY_LIMIT_DUTY = (1u << 16),           /**< Headroom/duty limit. */
+  SAFETY_LIMIT_DIDT = (1u << 17),           /**< Ограничение dI/dt. */
+  SAFETY_LIMIT_VOLT_SEC = (1u << 18),       /**< Ограничение по вольт-секундам. */
+  SAFETY_LIMIT_SATURATION = (1u << 19),     /**< Подозрение на насыщение трансформатора. */
+  SAFETY_LIMIT_THERMAL = (1u << 20),        /**< Тепловой дерейтинг. */
+  SAFETY_LIMIT_COMMS_SOFT = (1u << 21),     /**< Soft-timeout команд (controlled stop). */
+
+  /* INFO: только телеметрия. */
+  SAFETY_INFO_TEMP_WARN = (1u << 24),       /**< Температура близко к пределу. */
+  SAFETY_INFO_MEAS_WARN = (1u << 25),       /**< Измерение близко к пределу, но валидно. */
+  SAFETY_INFO_SERVICE = (1u << 26)          /**< Активен сервисный режим. */
+} safety_fault_bit_t;
+
+/**
+ * @brief Запрос recovery (из slow-домена).
+ */
+typedef enum {
+  SAFETY_CLEAR_NONE = 0u,                     /**< Нет запроса. */
+  SAFETY_CLEAR_SOFT = SAFETY_CLASS_SOFT_MASK, /**< Конец цикла сварки: снять SOFT-latch. */
+  SAFETY_CLEAR_ALL = SAFETY_CLASS_HARD_MASK | SAFETY_CLASS_SOFT_MASK /**< `fault_reset` ТК: снять HARD+SOFT. */
+} safety_clear_t;
+
+/**
+ * @brief Конфигурация supervisor.
+ */
+typedef struct {
+  uint16_t limit_escalate_ticks[SAFETY_LIMIT_COUNT]; /**< Порог накопления для эскалации LIMIT-бита, [периоды PWM]
+                                                          (0 = без эскалации). */
+  uint16_t limit_decay_per_tick; /**< Спад аккумулятора за период без LIMIT, [периоды PWM/период PWM]. */
+} safety_cfg_t;
+
+/**
+ * @brief Выход шага supervisor.
+ */
+typedef struct {
+  bool allow; /**< Разрешение управления для control_fast_step(). */
+  uint32_t active; /**< Активные условия этого шага (вход + эскалация), [битовая маска]. */
+  uint32_t latched; /**< Защёлкнутые HARD/SOFT, [битовая маска]. */
+  uint32_t first_latched; /**< Первая причина latch с последнего recovery (для `fault_code`), [битовая маска]. */
+} safety_out_t;
+
+/**
+ * @brief Состояние supervisor.
+ */
+typedef struct {
+  safety_cfg_t cfg; /**< Конфигурация. */
+  uint32_t latched; /**< Защёлкнутые HARD/SOFT, [битовая маска]. */
+  uint32_t first_latched; /**< Первая причина latch, [битовая маска]. */
+  uint16_t limit_acc[SAFETY_LIMIT_COUNT]; /**< Аккумуляторы времени в LIMIT, [периоды PWM]. */
+  atomic_uint_fast32_t clear_request; /**< Запрос recovery (safety_clear_t), пишет slow-домен. */
+  uint32_t cnt_hard_trips; /**< Новых HARD-latch, [шт]. */
+  uint32_t cnt_soft_trips; /**< Новых SOFT-latch, [шт]. */
+  uint32_t cnt_limit_escalations; /**< Эскалаций LIMIT → SOFT, [шт]. */
+} safety_supervisor_t;
+
+/**
+ * @brief Инициализировать supervisor.
+ * @param sup Указатель на состояние.
+ * @param cfg Конфигурация (NULL — значения по умолчанию: эскалация LIMIT через 200 периодов, спад 1/период).
+ * @return None.
+ * @post Нет latch; allow определяется первым шагом.
+ */
+void safety_supervisor_init(safety_supervisor_t *sup, const safety_cfg_t *cfg);
+
+/**
+ * @brief Шаг supervisor (PWM-домен, до control_fast_step()).
+ * @param sup Указатель на состояние.
+ * @param raw Fault-условия этого периода от measurement/comms/overrun/драйвера (safety_fault_bit_t), [битовая маска].
+ * @param out Указатель на выход.
+ * @return None.
+ * @details
+ * Алгоритм (постоянное время):
+ * 1) LIMIT-аккумуляторы: +1 в LIMIT, иначе −decay (насыщение 0..UINT16_MAX); порог ⇒ `SOFT_LIMIT_ESCALATED`;
+ * 2) забрать запрос recovery; снять защёлку только у битов, чья причина сейчас не активна;
+ * 3) latched |= active & (HARD|SOFT);
+ * 4) allow = (latched == 0), т.е. нет ни активных, ни защёлкнутых HARD/SOFT.
+ */
+void safety_supervisor_step(safety_supervisor_t *sup, uint32_t raw, safety_out_t *out);
+
+/**
+ * @brief Запросить recovery (slow-домен; применяется на следующем шаге).
+ * @param sup Указатель на состояние.
+ * @param clear SAFETY_CLEAR_SOFT (конец цикла) или SAFETY_CLEAR_ALL (валидный `fault_reset`).
+ * @return None.
+ * @note Вызывающий отвечает за валидность `fault_reset` (валидатор протокола, состояние IDLE).
+ */
+void safety_supervisor_request_clear(safety_supervisor_t *sup, safety_clear_t clear);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SAFETY_SUPERVISOR_H */
@@ -0,0 +1,204 @@
+#include "boot_seq.h"
+
+#include <stddef.h>
+
+/**
+ * @brief Прочитать состояние пункта.
+ * @param bs Контекст.
+ * @param idx Индекс пункта.
+ * @return Состояние.
+ */
+static boot_item_state_t boot_seq_state(const boot_seq_t *bs, uint32_t idx)
+{
+  return (boot_item_state_t)atomic_load(&((boot_seq_t *)bs)->state[idx]);
+}
+
+/**
+ * @brief Маска пунктов в заданном состоянии.
+ * @param bs Контекст.
+ * @param st Состояние.
+ * @return Маска, [битовая маска].
+ */
+static uint32_t boot_seq_mask(const boot_seq_t *bs, boot_item_state_t st)
+{
+  uint32_t mask = 0u;
+  for (uint32_t i = 0u; i < bs->n_items; ++i)
+  {
+    mask |= (boot_seq_state(bs, i) == st) ? (1u << i) : 0u;
+  }
+  return mask;
+}
+
+bool boot_seq_init(boot_seq_t *bs, const boot_item_desc_t *items, uint32_t n_items, uint32_t reset_cause,
+                   uint32_t now_us)
+{
+  bs->items = NULL;
+  bs->n_items = 0u;
+  bs->t0_us = now_us;
+  bs->reset_cause = reset_cause;
+  bs->phase = BOOT_PHASE_FAULT;
+  bs->t_ready_us = 0u;
+  bs->degraded_mask = 0u;
+  bs->fault_mask = 0u;
+  bs->cnt_late_end = 0u;
+  for (uint32_t i = 0u; i < BOOT_SEQ_ITEMS_MAX; ++i)
+  {
+    atomic_init(&bs->state[i], (unsigned)BOOT_ITEM_PENDING);
+    bs->rec[i].t_start_us = 0u;
+    bs->rec[i].t_end_us = 0u;
+  }
+
+  if ((items == NULL) || (n_items == 0u) || (n_items > BOOT_SEQ_ITEMS_MAX))
+  {
+    return false;
+  }
+  uint32_t critical = 0u;
+  for (uint32_t i = 0u; i < n_items; ++i)
+  {
+    // Зависимости только на предыдущие пункты ⇒ граф без циклов, пропуски распространяются одним проходом.
+    const uint32_t lower = (1u << i) - 1u;
+    if (((items[i].deps & ~lower) != 0u) || (items[i].critical && ((items[i].deps & ~critical) != 0u)))
+    {
+      return false;
+    }
+    critical |= items[i].critical ? (1u << i) : 0u;
+  }
+  bs->items = items;
+  bs->n_items = n_items;
+  bs->phase = BOOT_PHASE_CRITICAL;
+  return true;
+}
+
+uint32_t boot_seq_next(const boot_seq_t *bs)
+{
+  if ((bs->phase == BOOT_PHASE_FAULT) || (bs->n_items == 0u))
+  {
+    return 0u;
+  }
+  const uint32_t done = boot_seq_mask(bs, BOOT_ITEM_DONE);
+  uint32_t critical = 0u;
+  for (uint32_t i = 0u; i < bs->n_items; ++i)
+  {
+    critical |= bs->items[i].critical ? (1u << i) : 0u;
+  }
+  const bool barrier = (critical & ~done) == 0u;
+
+  uint32_t next = 0u;
+  for (uint32_t i = 0u; i < bs->n_items; ++i)
+  {
+    const boot_item_desc_t *it = &bs->items[i];
+    if ((boot_seq_state(bs, i) == BOOT_ITEM_PENDING) && ((it->deps & ~done) == 0u) && (it->critical || barrier))
+    {
+      next |= 1u << i;
+    }
+  }
+  return next;
+}
+
+bool boot_seq_begin(boot_seq_t *bs, uint32_t idx, uint32_t now_us)
+{
+  if ((idx >= bs->n_items) || (boot_seq_state(bs, idx) != BOOT_ITEM_PENDING))
+  {
+    return false;
+  }
+  bs->rec[idx].t_start_us = now_us - bs->t0_us;
+  atomic_store(&bs->state[idx], (unsigned)BOOT_ITEM_RUNNING);
+  return true;
+}
+
+bool boot_seq_end(boot_seq_t *bs, uint32_t idx, bool ok, uint32_t now_us)
+{
+  if (idx >= bs->n_items)
+  {
+    return false;
+  }
+  // Сначала CAS, затем время: после таймаута (CAS supervisor-а выиграл) t_end таймаута не перезаписывается.
+  const uint32_t t_end = now_us - bs->t0_us;
+  unsigned expected = (unsigned)BOOT_ITEM_RUNNING;
+  if (!atomic_compare_exchange_strong(&bs->state[idx], &expected, (unsigned)(ok ? BOOT_ITEM_DONE : BOOT_ITEM_FAILED)))
+  {
+    bs->cnt_late_end++;
+    return false;
+  }
+  bs->rec[idx].t_end_us = t_end;
+  return true;
+}
+
+boot_phase_t boot_seq_poll(boot_seq_t *bs, uint32_t now_us)
+{
+  if ((bs->phase == BOOT_PHASE_FAULT) || (bs->n_items == 0u))
+  {
+    return bs->phase;
+  }
+  const uint32_t t_now = now_us - bs->t0_us; /* [мкс] */
+
+  // Шаг 1: Таймауты и пропуски (зависимости на меньшие индексы ⇒ один проход по порядку).
+  uint32_t failed = 0u;
+  uint32_t required = 0u;
+  for (uint32_t i = 0u; i < bs->n_items; ++i)
+  {
+    const boot_item_desc_t *it = &bs->items[i];
+    boot_item_rec_t *rec = &bs->rec[i];
+    unsigned expected = (unsigned)BOOT_ITEM_RUNNING;
+    if ((it->timeout_us != 0u) && (boot_seq_state(bs, i) == BOOT_ITEM_RUNNING) &&
+        ((t_now - rec->t_start_us) >= it->timeout_us) &&
+        atomic_compare_exchange_strong(&bs->state[i], &expected, (unsigned)BOOT_ITEM_TIMEOUT))
+    {
+      rec->t_end_us = rec->t_start_us + it->timeout_us;
+    }
+    if ((boot_seq_state(bs, i) == BOOT_ITEM_PENDING) && ((it->deps & failed) != 0u))
+    {
+      atomic_store(&bs->state[i], (unsigned)BOOT_ITEM_SKIPPED);
+    }
+    const boot_item_state_t st = boot_seq_state(bs, i);
+    const bool is_failed = (st == BOOT_ITEM_FAILED) || (st == BOOT_ITEM_TIMEOUT) || (st == BOOT_ITEM_SKIPPED);
+    const bool is_required = it->critical || it->required;
+    failed |= is_failed ? (1u << i) : 0u;
+    required |= is_required ? (1u << i) : 0u;
+  }
+  bs->fault_mask = failed & required;
+  bs->degraded_mask = failed & ~required;
+
+  // Шаг 2: Фаза; момент READY/FAULT фиксируется один раз.
+  const uint32_t done = boot_seq_mask(bs, BOOT_ITEM_DONE);
+  uint32_t critical = 0u;
+  for (uint32_t i = 0u; i < bs->n_items; ++i)
+  {
+    critical |= bs->items[i].critical ? (1u << i) : 0u;
+  }
+  const boot_phase_t prev = bs->phase;
+  if (bs->fault_mask != 0u)
+  {
+    // SAFETY: отказ обязательного пункта — READY не выставляется, энергия запрещена.
+    bs->phase = BOOT_PHASE_FAULT;
+  }
+  else if ((required & ~done) == 0u)
+  {
+    bs->phase = BOOT_PHASE_READY;
+  }
+  else
+  {
+    bs->phase = ((critical & ~done) == 0u) ? BOOT_PHASE_BRINGUP : BOOT_PHASE_CRITICAL;
+  }
+  if ((prev != bs->phase) && ((bs->phase == BOOT_PHASE_READY) || (bs->phase == BOOT_PHASE_FAULT)))
+  {
+    bs->t_ready_us = t_now;
+  }
+  return bs->phase;
+}
+
+uint32_t boot_seq_busy_sum_us(const boot_seq_t *bs)
+{
+  uint32_t sum = 0u;
+  for (uint32_t i = 0u; i < bs->n_items; ++i)
+  {
+    const boot_item_state_t st = boot_seq_state(bs, i);
+    // t_end пишется после CAS: запись, ещё не опубликованная task пункта (t_end < t_start), не учитывается.
+    if (((st == BOOT_ITEM_DONE) || (st == BOOT_ITEM_FAILED) || (st == BOOT_ITEM_TIMEOUT)) &&
+        (bs->rec[i].t_end_us >= bs->rec[i].t_start_us))
+    {
+      sum += bs->rec[i].t_end_us - bs->rec[i].t_start_us;
+    }
+  }
+  return sum;
+}
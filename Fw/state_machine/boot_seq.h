@@ -0,0 +1,150 @@
+#ifndef BOOT_SEQ_H
+#define BOOT_SEQ_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file boot_seq.h
+ * @brief Поэтапный старт: критичные пункты синхронно до планировщика, медленная инициализация — параллельно в task.
+ * @details
+ * Пункт старта описывается таблицей (boot_item_desc_t): признак `critical`, признак `required` для READY,
+ * зависимости (битовая маска пунктов с меньшими индексами) и таймаут.
+ * - Критичные пункты (TIM1 break/safe outputs, watchdog) выполняются в `main()` по порядку таблицы; пока
+ *   все они не DONE, некритичные не стартуют (барьер). Отказ критичного ⇒ FAULT.
+ * - Некритичные (handshake COMX, загрузка NVM + CRC) стартуют, как только выполнены зависимости, и идут
+ *   параллельно в отдельных task; boot_seq_end() вызывается из task пункта.
+ * - READY — все `required` пункты DONE; необязательные могут завершаться позже (их отказ — `degraded_mask`).
+ *   Отказ/таймаут `required` (или недостижимость из-за отказа зависимости) ⇒ FAULT (PWM остаётся OFF).
+ *
+ * Профиль старта: начало/конец каждого пункта и момент READY относительно t0 (timebase порта, мкс) +
+ * причина сброса — для оценки time-to-READY после power-on/watchdog reset.
+ *
+ * Потоки: boot_seq_next()/boot_seq_begin()/boot_seq_poll() — один supervisor-контекст (main до старта
+ * планировщика, затем boot task); boot_seq_end() — из task пункта. Состояние пункта — атомарное (CAS), поэтому
+ * поздний boot_seq_end() после таймаута игнорируется.
+ */
+
+#define BOOT_SEQ_ITEMS_MAX (16u) /**< Максимум пунктов старта, [шт]. */
+
+/**
+ * @brief Состояние пункта.
+ */
+typedef enum {
+  BOOT_ITEM_PENDING = 0u, /**< Ждёт зависимостей/барьера. */
+  BOOT_ITEM_RUNNING = 1u, /**< Выполняется. */
+  BOOT_ITEM_DONE = 2u,    /**< Успешно завершён. */
+  BOOT_ITEM_FAILED = 3u,  /**< Завершён с ошибкой. */
+  BOOT_ITEM_TIMEOUT = 4u, /**< Не завершён за timeout_us. */
+  BOOT_ITEM_SKIPPED = 5u  /**< Не стартовал: отказ зависимости. */
+} boot_item_state_t;
+
+/**
+ * @brief Фаза старта.
+ */
+typedef enum {
+  BOOT_PHASE_CRITICAL = 0u, /**< Критичные пункты (синхронно). */
+  BOOT_PHASE_BRINGUP = 1u,  /**< Параллельная инициализация. */
+  BOOT_PHASE_READY = 2u,    /**< Все required DONE: разрешён переход в IDLE/READY. */
+  BOOT_PHASE_FAULT = 3u     /**< Отказ required: safe state. */
+} boot_phase_t;
+
+/**
+ * @brief Описание пункта старта.
+ */
+typedef struct {
+  const char *name; /**< Имя для профиля/логов. */
+  bool critical; /**< Синхронно до планировщика, барьер для остальных. */
+  bool required; /**< Нужен для READY (иначе отказ — degraded). */
+  uint32_t deps; /**< Зависимости: маска пунктов с меньшими индексами, [битовая маска]. */
+  uint32_t timeout_us; /**< Таймаут выполнения (0 = без таймаута), [мкс]. */
+} boot_item_desc_t;
+
+/**
+ * @brief Запись профиля пункта (время относительно t0).
+ */
+typedef struct {
+  uint32_t t_start_us; /**< Начало, [мкс]. */
+  uint32_t t_end_us; /**< Конец (для TIMEOUT — t_start + timeout), [мкс]. */
+} boot_item_rec_t;
+
+/**
+ * @brief Контекст старта.
+ */
+typedef struct {
+  const boot_item_desc_t *items; /**< Таблица пунктов (не копируется). */
+  uint32_t n_items; /**< Пунктов, [шт]. */
+  uint32_t t0_us; /**< Точка отсчёта профиля (timebase порта), [мкс]. */
+  uint32_t reset_cause; /**< Причина сброса (флаги RCC_CSR порта), [битовая маска]. */
+  atomic_uint state[BOOT_SEQ_ITEMS_MAX]; /**< Состояния пунктов (boot_item_state_t). */
+  boot_item_rec_t rec[BOOT_SEQ_ITEMS_MAX]; /**< Профиль пунктов. */
+  boot_phase_t phase; /**< Фаза. */
+  uint32_t t_ready_us; /**< Момент READY/FAULT относительно t0, [мкс]. */
+  uint32_t degraded_mask; /**< Необязательные пункты с отказом, [битовая маска]. */
+  uint32_t fault_mask; /**< Required пункты с отказом/таймаутом/пропуском, [битовая маска]. */
+  uint32_t cnt_late_end; /**< boot_seq_end() после таймаута (игнорированы), [шт]. */
+} boot_seq_t;
+
+/**
+ * @brief Инициализировать старт.
+ * @param bs Контекст.
+ * @param items Таблица пунктов (время жизни — весь старт).
+ * @param n_items Пунктов, [шт] (1…BOOT_SEQ_ITEMS_MAX).
+ * @param reset_cause Причина сброса, [битовая маска].
+ * @param now_us Текущее время (t0), [мкс].
+ * @return false при невалидной таблице (зависимость не на меньший индекс, критичный зависит от некритичного).
+ */
+bool boot_seq_init(boot_seq_t *bs, const boot_item_desc_t *items, uint32_t n_items, uint32_t reset_cause,
+                   uint32_t now_us);
+
+/**
+ * @brief Пункты, которые можно запустить сейчас (PENDING, зависимости DONE, барьер критичных пройден).
+ * @param bs Контекст.
+ * @return Маска пунктов, [битовая маска].
+ */
+uint32_t boot_seq_next(const boot_seq_t *bs);
+
+/**
+ * @brief Отметить запуск пункта.
+ * @param bs Контекст.
+ * @param idx Индекс пункта.
+ * @param now_us Текущее время, [мкс].
+ * @return false, если пункт не PENDING.
+ */
+bool boot_seq_begin(boot_seq_t *bs, uint32_t idx, uint32_t now_us);
+
+/**
+ * @brief Отметить завершение пункта (из task пункта).
+ * @param bs Контекст.
+ * @param idx Индекс пункта.
+ * @param ok Успех.
+ * @param now_us Текущее время, [мкс].
+ * @return false, если пункт уже не RUNNING (например, снят по таймауту).
+ */
+bool boot_seq_end(boot_seq_t *bs, uint32_t idx, bool ok, uint32_t now_us);
+
+/**
+ * @brief Таймауты, пропуски по отказу зависимостей, фаза и момент READY.
+ * @param bs Контекст.
+ * @param now_us Текущее время, [мкс].
+ * @return Фаза.
+ */
+boot_phase_t boot_seq_poll(boot_seq_t *bs, uint32_t now_us);
+
+/**
+ * @brief Суммарная длительность завершённых пунктов (последовательный эквивалент старта).
+ * @param bs Контекст.
+ * @return Σ (t_end - t_start), [мкс].
+ */
+uint32_t boot_seq_busy_sum_us(const boot_seq_t *bs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BOOT_SEQ_H */
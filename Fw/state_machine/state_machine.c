@@ -0,0 +1,161 @@
+#include "state_machine.h"
+
+#include <stddef.h>
+
+_Static_assert((SM_TRACE_LEN & (SM_TRACE_LEN - 1u)) == 0u, "SM_TRACE_LEN must be a power of two");
+
+/**
+ * @brief Guard перехода: читает только выход safety_supervisor.
+ */
+typedef bool (*sm_guard_fn_t)(const safety_out_t *safety);
+
+/**
+ * @brief Ячейка таблицы переходов.
+ */
+typedef struct {
+  sm_state_t next; /**< Новое состояние (== текущему — событие принимается без перехода). */
+  sm_guard_fn_t guard; /**< Guard (NULL — переход не определён). */
+} sm_transition_t;
+
+/**
+ * @brief Guard: без условий.
+ * @param safety Выход safety_supervisor.
+ * @return true.
+ */
+static bool sm_guard_always(const safety_out_t *safety)
+{
+  (void)safety;
+  return true;
+}
+
+/**
+ * @brief Guard: нет ни активных, ни защёлкнутых HARD/SOFT (в т.ч. recovery уже выполнен supervisor).
+ * @param safety Выход safety_supervisor.
+ * @return safety->allow.
+ */
+static bool sm_guard_allow(const safety_out_t *safety)
+{
+  return safety->allow;
+}
+
+/**
+ * @brief Guard: supervisor запретил энергию.
+ * @param safety Выход safety_supervisor.
+ * @return !safety->allow.
+ */
+static bool sm_guard_trip(const safety_out_t *safety)
+{
+  return !safety->allow;
+}
+
+/*
+ * Таблица переходов: X(from, event, to, guard).
+ * SAFETY: IDLE → WELD напрямую не определён (только через ARMED); выход из FAULT — только FAULT_RESET
+ * после снятия latch в supervisor (нет автозапуска, SAFETY §5).
+ */
+#define SM_TRANSITIONS(X)                  \
+  X(IDLE, REQ_IDLE, IDLE, always)          \
+  X(IDLE, REQ_ARMED, ARMED, allow)         \
+  X(IDLE, SAFETY_TRIP, FAULT, trip)        \
+  X(ARMED, REQ_IDLE, IDLE, always)         \
+  X(ARMED, REQ_ARMED, ARMED, always)       \
+  X(ARMED, REQ_WELD, WELD, allow)          \
+  X(ARMED, SAFETY_TRIP, FAULT, trip)       \
+  X(WELD, REQ_IDLE, IDLE, always)          \
+  X(WELD, REQ_ARMED, ARMED, always)        \
+  X(WELD, REQ_WELD, WELD, always)          \
+  X(WELD, SAFETY_TRIP, FAULT, trip)        \
+  X(FAULT, REQ_IDLE, FAULT, always)        \
+  X(FAULT, SAFETY_TRIP, FAULT, always)     \
+  X(FAULT, FAULT_RESET, IDLE, allow)
+
+#define SM_TABLE_ROW(from, evt, to, guard_name) \
+  [SM_STATE_##from][SM_EVT_##evt] = {.next = SM_STATE_##to, .guard = sm_guard_##guard_name},
+
+static const sm_transition_t k_sm_table[SM_STATE_COUNT][SM_EVT_COUNT] = {SM_TRANSITIONS(SM_TABLE_ROW)};
+
+#undef SM_TABLE_ROW
+
+/**
+ * @brief Записать переход в trace (SPSC, при переполнении запись отбрасывается).
+ * @param sm Контекст.
+ * @param entry Запись.
+ * @return None.
+ */
+static void sm_trace_push(sm_ctx_t *sm, const sm_trace_entry_t *entry)
+{
+  const unsigned head = atomic_load_explicit(&sm->trace_head, memory_order_relaxed);
+  const unsigned tail = atomic_load_explicit(&sm->trace_tail, memory_order_acquire);
+  if ((head - tail) >= SM_TRACE_LEN)
+  {
+    sm->cnt_trace_dropped++;
+    return;
+  }
+  sm->trace[head & (SM_TRACE_LEN - 1u)] = *entry;
+  atomic_store_explicit(&sm->trace_head, head + 1u, memory_order_release);
+}
+
+void state_machine_init(sm_ctx_t *sm)
+{
+  sm->state = SM_STATE_IDLE;
+  atomic_init(&sm->trace_head, 0u);
+  atomic_init(&sm->trace_tail, 0u);
+  sm->cnt_transitions = 0u;
+  sm->cnt_rejected = 0u;
+  sm->cnt_trace_dropped = 0u;
+}
+
+bool state_machine_dispatch(sm_ctx_t *sm, sm_event_t event, const safety_out_t *safety, uint32_t t_us)
+{
+  if ((uint32_t)event >= (uint32_t)SM_EVT_COUNT)
+  {
+    sm->cnt_rejected++;
+    return false;
+  }
+
+  // Шаг 1: O(1) поиск и один guard.
+  const sm_state_t from = sm->state;
+  const sm_transition_t *tr = &k_sm_table[from][event];
+  const bool accepted = (tr->guard != NULL) && tr->guard(safety);
+  if (!accepted)
+  {
+    sm->cnt_rejected++;
+    return false;
+  }
+  if (tr->next == from)
+  {
+    return false;
+  }
+
+  // Шаг 2: Переход и trace.
+  const sm_trace_entry_t entry = {
+    .t_us = t_us,
+    .safety_latched = safety->latched,
+    .from = (uint8_t)from,
+    .to = (uint8_t)tr->next,
+    .event = (uint8_t)event
+  };
+  sm->state = tr->next;
+  sm->cnt_transitions++;
+  sm_trace_push(sm, &entry);
+  return true;
+}
+
+bool state_machine_trace_pop(sm_ctx_t *sm, sm_trace_entry_t *entry)
+{
+  const unsigned tail = atomic_load_explicit(&sm->trace_tail, memory_order_relaxed);
+  const unsigned head = atomic_load_explicit(&sm->trace_head, memory_order_acquire);
+  if (head == tail)
+  {
+    return false;
+  }
+  *entry = sm->trace[tail & (SM_TRACE_LEN - 1u)];
+  atomic_store_explicit(&sm->trace_tail, tail + 1u, memory_order_release);
+  return true;
+}
+
+const char *state_machine_state_name(sm_state_t state)
+{
+  static const char *const k_names[SM_STATE_COUNT] = {"IDLE", "ARMED", "WELD", "FAULT"};
+  return ((uint32_t)state < (uint32_t)SM_STATE_COUNT) ? k_names[state] : "?";
+}
@@ -0,0 +1,114 @@
+#ifndef STATE_MACHINE_H
+#define STATE_MACHINE_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "safety_supervisor.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file state_machine.h
+ * @brief Платформо-независимый автомат состояний IDLE/ARMED/WELD/FAULT (табличный, O(1) dispatch).
+ * @details
+ * Домен: граница периода PWM, после safety_supervisor_step() (ARCHITECTURE §2.1 п.5, §3.3).
+ * Таблица переходов `[состояние][событие]` формируется на этапе компиляции из списка SM_TRANSITIONS
+ * (state_machine.c); не перечисленные пары — отклонённые события. Guard-функции читают только выход
+ * safety_supervisor — автомат сам не принимает решений о latch/recovery.
+ *
+ * Каждый выполненный переход пишется в кольцевой trace (SPSC: пишет PWM-домен, вычитывает
+ * diag/logging task через state_machine_trace_pop()). Без аллокаций, время dispatch ограничено.
+ */
+
+#define SM_TRACE_LEN (16u) /**< Глубина trace переходов (степень двойки), [шт]. */
+
+/**
+ * @brief Состояния (значения совпадают с `FB_STATUS.state`, см. tk_state_t).
+ */
+typedef enum {
+  SM_STATE_IDLE = 0u,  /**< PWM OFF, сварка запрещена. */
+  SM_STATE_ARMED = 1u, /**< Готовность, PWM OFF. */
+  SM_STATE_WELD = 2u,  /**< Активная сварка. */
+  SM_STATE_FAULT = 3u, /**< Latched-off до recovery. */
+  SM_STATE_COUNT = 4u  /**< Количество состояний, [шт]. */
+} sm_state_t;
+
+/**
+ * @brief События автомата.
+ */
+typedef enum {
+  SM_EVT_REQ_IDLE = 0u,    /**< Запрос IDLE (ТК `mode`, конец цикла). */
+  SM_EVT_REQ_ARMED = 1u,   /**< Запрос ARMED. */
+  SM_EVT_REQ_WELD = 2u,    /**< Запрос WELD. */
+  SM_EVT_SAFETY_TRIP = 3u, /**< safety_supervisor запретил энергию (есть latch). */
+  SM_EVT_FAULT_RESET = 4u, /**< Явный recovery (валидный `fault_reset`). */
+  SM_EVT_COUNT = 5u        /**< Количество событий, [шт]. */
+} sm_event_t;
+
+/**
+ * @brief Запись trace перехода.
+ */
+typedef struct {
+  uint32_t t_us; /**< Момент перехода, [мкс]. */
+  uint32_t safety_latched; /**< Слово latch safety_supervisor в момент перехода, [битовая маска]. */
+  uint8_t from; /**< Исходное состояние (sm_state_t), [-]. */
+  uint8_t to; /**< Новое состояние (sm_state_t), [-]. */
+  uint8_t event; /**< Событие (sm_event_t), [-]. */
+} sm_trace_entry_t;
+
+/**
+ * @brief Контекст автомата.
+ */
+typedef struct {
+  sm_state_t state; /**< Текущее состояние. */
+  sm_trace_entry_t trace[SM_TRACE_LEN]; /**< Кольцо trace переходов. */
+  atomic_uint trace_head; /**< Индекс записи (PWM-домен), [шт]. */
+  atomic_uint trace_tail; /**< Индекс чтения (diag task), [шт]. */
+  uint32_t cnt_transitions; /**< Выполненных переходов, [шт]. */
+  uint32_t cnt_rejected; /**< Отклонённых событий (нет перехода или guard=false), [шт]. */
+  uint32_t cnt_trace_dropped; /**< Переходов, не попавших в переполненный trace, [шт]. */
+} sm_ctx_t;
+
+/**
+ * @brief Инициализировать автомат.
+ * @param sm Контекст.
+ * @return None.
+ * @post state = IDLE, trace пуст.
+ */
+void state_machine_init(sm_ctx_t *sm);
+
+/**
+ * @brief Обработать событие (O(1): индекс таблицы + один guard).
+ * @param sm Контекст.
+ * @param event Событие.
+ * @param safety Выход safety_supervisor этого периода.
+ * @param t_us Текущее время (для trace), [мкс].
+ * @return true, если переход выполнен.
+ * @note Неизвестное событие (>= SM_EVT_COUNT) отклоняется и учитывается в cnt_rejected.
+ */
+bool state_machine_dispatch(sm_ctx_t *sm, sm_event_t event, const safety_out_t *safety, uint32_t t_us);
+
+/**
+ * @brief Вычитать самую старую запись trace (diag/logging task).
+ * @param sm Контекст.
+ * @param entry Выход: запись.
+ * @return true, если запись была.
+ */
+bool state_machine_trace_pop(sm_ctx_t *sm, sm_trace_entry_t *entry);
+
+/**
+ * @brief Имя состояния для логов/CLI.
+ * @param state Состояние.
+ * @return Строка (для неизвестного значения — "?").
+ */
+const char *state_machine_state_name(sm_state_t state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STATE_MACHINE_H */
@@ -0,0 +1,183 @@
+#include "settings_flash_emu.h"
+
+#include <string.h>
+
+/**
+ * @brief Следующее псевдослучайное 32-битное значение (xorshift32).
+ * @param emu Эмулятор.
+ * @return Значение.
+ */
+static uint32_t settings_flash_emu_rand(settings_flash_emu_t *emu)
+{
+  uint32_t x = emu->rnd;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  emu->rnd = x;
+  return x;
+}
+
+/**
+ * @brief Учёт шага program/erase для инжекции power-loss.
+ * @param emu Эмулятор.
+ * @param partial Шаг выполняется частично (питание пропадает на нём).
+ * @return false, если питания уже нет.
+ */
+static bool settings_flash_emu_step(settings_flash_emu_t *emu, bool *partial)
+{
+  *partial = false;
+  if (emu->powered_off)
+  {
+    return false;
+  }
+  if (emu->armed && (emu->step == emu->at_step))
+  {
+    *partial = true;
+    emu->powered_off = true;
+  }
+  emu->step++;
+  return true;
+}
+
+/**
+ * @brief Чтение (memory-mapped Flash).
+ * @param user Эмулятор.
+ * @param addr Адрес, [байт].
+ * @param dst Буфер.
+ * @param len Длина, [байт].
+ * @return false при выходе за область, без питания или при двойной ошибке ECC в читаемых double-word.
+ */
+static bool settings_flash_emu_read(void *user, uint32_t addr, void *dst, uint32_t len)
+{
+  settings_flash_emu_t *emu = (settings_flash_emu_t *)user;
+  const uint32_t size = emu->page_size * emu->page_count;
+  if (emu->powered_off || (addr > size) || (len > (size - addr)))
+  {
+    return false;
+  }
+  for (uint32_t dw = addr / 8u; (len != 0u) && (dw <= ((addr + len - 1u) / 8u)); ++dw)
+  {
+    if (emu->ecc_bad[dw])
+    {
+      emu->cnt_ecc_double++;
+      return false;
+    }
+  }
+  memcpy(dst, &emu->mem[addr], len);
+  return true;
+}
+
+/**
+ * @brief Программирование double-word (только в стёртый double-word, как FLASH_TYPEPROGRAM_DOUBLEWORD).
+ * @param user Эмулятор.
+ * @param addr Адрес, [байт] (кратен 8).
+ * @param dw Значение.
+ * @return false при ошибке/PROGERR/потере питания.
+ */
+static bool settings_flash_emu_program(void *user, uint32_t addr, uint64_t dw)
+{
+  settings_flash_emu_t *emu = (settings_flash_emu_t *)user;
+  const uint32_t size = emu->page_size * emu->page_count;
+  if (((addr % 8u) != 0u) || (addr > (size - 8u)))
+  {
+    return false;
+  }
+  for (uint32_t i = 0u; i < 8u; ++i)
+  {
+    if (emu->mem[addr + i] != 0xFFu)
+    {
+      emu->cnt_prog_violation++;
+      return false;
+    }
+  }
+  bool partial = false;
+  if (!settings_flash_emu_step(emu, &partial))
+  {
+    return false;
+  }
+  if (partial)
+  {
+    // Оборванный program: часть битов 1 → 0 не успела переключиться.
+    dw |= ((uint64_t)settings_flash_emu_rand(emu) << 32) | settings_flash_emu_rand(emu);
+  }
+  for (uint32_t i = 0u; i < 8u; ++i)
+  {
+    emu->mem[addr + i] = (uint8_t)((dw >> (8u * i)) & 0xFFu);
+  }
+  emu->ecc_bad[addr / 8u] = partial;
+  emu->cnt_program++;
+  return !partial;
+}
+
+/**
+ * @brief Стирание страницы.
+ * @param user Эмулятор.
+ * @param page Страница.
+ * @return false при ошибке/потере питания.
+ */
+static bool settings_flash_emu_erase(void *user, uint32_t page)
+{
+  settings_flash_emu_t *emu = (settings_flash_emu_t *)user;
+  if (page >= emu->page_count)
+  {
+    return false;
+  }
+  bool partial = false;
+  if (!settings_flash_emu_step(emu, &partial))
+  {
+    return false;
+  }
+  uint8_t *p = &emu->mem[page * emu->page_size];
+  for (uint32_t i = 0u; i < emu->page_size; ++i)
+  {
+    // Оборванный erase: часть битов 0 → 1 не успела переключиться.
+    p[i] = partial ? (uint8_t)(p[i] | (settings_flash_emu_rand(emu) & 0xFFu)) : 0xFFu;
+  }
+  for (uint32_t i = 0u; i < emu->page_size; i += 8u)
+  {
+    const uint8_t erased[8] = {0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu};
+    emu->ecc_bad[((page * emu->page_size) + i) / 8u] = partial && (memcmp(&p[i], erased, 8u) != 0);
+  }
+  emu->cnt_erase[page]++;
+  return !partial;
+}
+
+bool settings_flash_emu_init(settings_flash_emu_t *emu, uint32_t page_size, uint32_t page_count)
+{
+  memset(emu, 0, sizeof(*emu));
+  if ((page_size == 0u) || ((page_size % 8u) != 0u) || (page_count == 0u) ||
+      (page_count > SETTINGS_STORE_PAGES_MAX) || (page_size > (SETTINGS_FLASH_EMU_SIZE_MAX / page_count)))
+  {
+    return false;
+  }
+  emu->page_size = page_size;
+  emu->page_count = page_count;
+  emu->rnd = 1u;
+  memset(emu->mem, 0xFF, sizeof(emu->mem));
+  return true;
+}
+
+settings_store_io_t settings_flash_emu_io(settings_flash_emu_t *emu)
+{
+  const settings_store_io_t io = {
+    .read = settings_flash_emu_read,
+    .program = settings_flash_emu_program,
+    .erase = settings_flash_emu_erase,
+    .user = emu,
+  };
+  return io;
+}
+
+void settings_flash_emu_arm(settings_flash_emu_t *emu, uint32_t at_step, uint32_t seed)
+{
+  emu->armed = true;
+  emu->at_step = at_step;
+  emu->step = 0u;
+  emu->rnd = (seed != 0u) ? seed : 1u;
+}
+
+void settings_flash_emu_restore(settings_flash_emu_t *emu)
+{
+  emu->armed = false;
+  emu->powered_off = false;
+}
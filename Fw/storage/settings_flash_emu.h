@@ -0,0 +1,86 @@
+#ifndef SETTINGS_FLASH_EMU_H
+#define SETTINGS_FLASH_EMU_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "settings_store.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file settings_flash_emu.h
+ * @brief Host-эмулятор внутренней Flash G474 для settings_store с инжекцией power-loss на любом шаге program/erase.
+ * @details
+ * Правила G474: стёртое состояние 0xFF, программирование только double-word и только в стёртый double-word
+ * (иначе PROGERR — ошибка, счётчик `cnt_prog_violation`), erase — страницей.
+ *
+ * Power-loss: после settings_flash_emu_arm() шаги program/erase нумеруются с 0; шаг с номером `at_step`
+ * выполняется частично (program: `old & (new | rnd)`, erase: `old | rnd` — случайный набор битов), все
+ * последующие операции завершаются ошибкой до settings_flash_emu_restore() (перезапуск питания).
+ *
+ * ECC: оборванный шаг оставляет double-word с несогласованным ECC (program — всегда, erase — если слово не
+ * стало 0xFF). Чтение такого слова на G474 — двойная ошибка ECCD (NMI); порт (settings_flash_port) гасит её и
+ * возвращает ошибку чтения — эмулятор делает то же (`cnt_ecc_double`). Полное erase/program снимает отметку.
+ */
+
+#define SETTINGS_FLASH_EMU_SIZE_MAX (16u * 2048u) /**< Максимальный объём области, [байт]. */
+
+/**
+ * @brief Состояние эмулятора.
+ */
+typedef struct {
+  uint8_t mem[SETTINGS_FLASH_EMU_SIZE_MAX]; /**< Содержимое области. */
+  bool ecc_bad[SETTINGS_FLASH_EMU_SIZE_MAX / 8u]; /**< Double-word с несогласованным ECC (оборванный шаг). */
+  uint32_t page_size; /**< Размер страницы, [байт]. */
+  uint32_t page_count; /**< Страниц, [шт]. */
+  bool armed; /**< Инжекция power-loss взведена. */
+  bool powered_off; /**< Питание "пропало": операции отклоняются. */
+  uint32_t at_step; /**< Шаг, на котором пропадает питание, [шт]. */
+  uint32_t step; /**< Шагов program/erase с момента arm, [шт]. */
+  uint32_t rnd; /**< Состояние xorshift32 для частичных шагов. */
+  uint32_t cnt_program; /**< Запрограммированных double-word, [шт]. */
+  uint32_t cnt_prog_violation; /**< Попыток программировать нестёртый double-word, [шт]. */
+  uint32_t cnt_ecc_double; /**< Чтений с двойной ошибкой ECC (ECCD), [шт]. */
+  uint32_t cnt_erase[SETTINGS_STORE_PAGES_MAX]; /**< Стираний по страницам (износ), [шт]. */
+} settings_flash_emu_t;
+
+/**
+ * @brief Инициализировать эмулятор (вся область стёрта).
+ * @param emu Эмулятор.
+ * @param page_size Размер страницы, [байт] (кратен 8).
+ * @param page_count Страниц, [шт].
+ * @return false, если геометрия не помещается в SETTINGS_FLASH_EMU_SIZE_MAX.
+ */
+bool settings_flash_emu_init(settings_flash_emu_t *emu, uint32_t page_size, uint32_t page_count);
+
+/**
+ * @brief Интерфейс доступа для settings_store_mount().
+ * @param emu Эмулятор.
+ * @return Набор функций с user = emu.
+ */
+settings_store_io_t settings_flash_emu_io(settings_flash_emu_t *emu);
+
+/**
+ * @brief Взвести power-loss на шаге `at_step` (отсчёт шагов с 0 от этого вызова).
+ * @param emu Эмулятор.
+ * @param at_step Номер шага program/erase, [шт].
+ * @param seed Seed частичного результата шага.
+ * @return None.
+ */
+void settings_flash_emu_arm(settings_flash_emu_t *emu, uint32_t at_step, uint32_t seed);
+
+/**
+ * @brief Восстановить питание (снять инжекцию; содержимое сохраняется).
+ * @param emu Эмулятор.
+ * @return None.
+ */
+void settings_flash_emu_restore(settings_flash_emu_t *emu);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SETTINGS_FLASH_EMU_H */
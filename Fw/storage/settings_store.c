@@ -0,0 +1,440 @@
+#include "settings_store.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#define SETTINGS_STORE_DW (8u) /**< Единица программирования, [байт]. */
+#define SETTINGS_STORE_NONE (UINT32_MAX) /**< Нет записи для ID. */
+
+/**
+ * @brief Таблица CRC-32 по полубайтам (полином 0xEDB88320) — 64 байта вместо 1 КБ.
+ */
+static const uint32_t settings_store_crc_tab[16] = {
+  0x00000000u, 0x1DB71064u, 0x3B6E20C8u, 0x26D930ACu, 0x76DC4190u, 0x6B6B51F4u, 0x4DB26158u, 0x5005713Cu,
+  0xEDB88320u, 0xF00F9344u, 0xD6D6A3E8u, 0xCB61B38Cu, 0x9B64C2B0u, 0x86D3D2D4u, 0xA00AE278u, 0xBDBDF21Cu,
+};
+
+uint32_t settings_store_crc32(uint32_t crc, const void *data, uint32_t len)
+{
+  const uint8_t *p = (const uint8_t *)data;
+  crc = ~crc;
+  for (uint32_t i = 0u; i < len; ++i)
+  {
+    crc ^= p[i];
+    crc = (crc >> 4) ^ settings_store_crc_tab[crc & 0x0Fu];
+    crc = (crc >> 4) ^ settings_store_crc_tab[crc & 0x0Fu];
+  }
+  return ~crc;
+}
+
+/**
+ * @brief Размер записи в журнале (заголовок + payload, выровнено на double-word).
+ * @param len Длина payload, [байт].
+ * @return Размер, [байт].
+ */
+static uint32_t settings_store_rec_size(uint32_t len)
+{
+  return SETTINGS_STORE_REC_HDR_LEN + ((len + (SETTINGS_STORE_DW - 1u)) & ~(SETTINGS_STORE_DW - 1u));
+}
+
+/**
+ * @brief Собрать double-word из 8 байт (LE).
+ * @param b Байты.
+ * @return Double-word.
+ */
+static uint64_t settings_store_dw(const uint8_t *b)
+{
+  uint64_t v = 0u;
+  for (uint32_t i = 0u; i < SETTINGS_STORE_DW; ++i)
+  {
+    v |= (uint64_t)b[i] << (8u * i);
+  }
+  return v;
+}
+
+/**
+ * @brief Прочитать u16 LE.
+ * @param b Байты.
+ * @return Значение.
+ */
+static uint16_t settings_store_u16(const uint8_t *b)
+{
+  return (uint16_t)((uint32_t)b[0] | ((uint32_t)b[1] << 8));
+}
+
+/**
+ * @brief Прочитать u32 LE.
+ * @param b Байты.
+ * @return Значение.
+ */
+static uint32_t settings_store_u32(const uint8_t *b)
+{
+  return (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+}
+
+/**
+ * @brief Записать u32 LE.
+ * @param b Байты.
+ * @param v Значение.
+ * @return None.
+ */
+static void settings_store_put_u32(uint8_t *b, uint32_t v)
+{
+  b[0] = (uint8_t)(v & 0xFFu);
+  b[1] = (uint8_t)((v >> 8) & 0xFFu);
+  b[2] = (uint8_t)((v >> 16) & 0xFFu);
+  b[3] = (uint8_t)((v >> 24) & 0xFFu);
+}
+
+/**
+ * @brief Запрограммировать последовательность double-word.
+ * @param st Контекст.
+ * @param addr Адрес, [байт] (кратен 8).
+ * @param b Байты (len кратна 8).
+ * @param len Длина, [байт].
+ * @return false при ошибке program.
+ */
+static bool settings_store_program(settings_store_t *st, uint32_t addr, const uint8_t *b, uint32_t len)
+{
+  for (uint32_t i = 0u; i < len; i += SETTINGS_STORE_DW)
+  {
+    if (!st->io.program(st->io.user, addr + i, settings_store_dw(&b[i])))
+    {
+      st->stats.cnt_io_err++;
+      return false;
+    }
+    st->stats.cnt_program++;
+  }
+  return true;
+}
+
+/**
+ * @brief Заголовок записи + CRC payload.
+ * @param hdr Заголовок (8 байт).
+ * @param id ID.
+ * @param data Payload.
+ * @param len Длина, [байт].
+ * @return None.
+ */
+static void settings_store_rec_hdr(uint8_t *hdr, uint16_t id, const uint8_t *data, uint32_t len)
+{
+  hdr[0] = (uint8_t)(id & 0xFFu);
+  hdr[1] = (uint8_t)(id >> 8);
+  hdr[2] = (uint8_t)(len & 0xFFu);
+  hdr[3] = (uint8_t)(len >> 8);
+  settings_store_put_u32(&hdr[4], settings_store_crc32(settings_store_crc32(0u, hdr, 4u), data, len));
+}
+
+/**
+ * @brief Запрограммировать запись: заголовок, затем payload (хвост — 0xFF).
+ * @param st Контекст.
+ * @param addr Адрес, [байт].
+ * @param id ID.
+ * @param data Payload.
+ * @param len Длина, [байт].
+ * @return false при ошибке program.
+ */
+static bool settings_store_program_rec(settings_store_t *st, uint32_t addr, uint16_t id, const uint8_t *data,
+                                       uint32_t len)
+{
+  uint8_t hdr[SETTINGS_STORE_REC_HDR_LEN];
+  settings_store_rec_hdr(hdr, id, data, len);
+  if (!settings_store_program(st, addr, hdr, SETTINGS_STORE_REC_HDR_LEN))
+  {
+    return false;
+  }
+  const uint32_t full = len & ~(SETTINGS_STORE_DW - 1u); /* [байт] */
+  if (!settings_store_program(st, addr + SETTINGS_STORE_REC_HDR_LEN, data, full))
+  {
+    return false;
+  }
+  if (full < len)
+  {
+    uint8_t tail[SETTINGS_STORE_DW];
+    memset(tail, 0xFF, sizeof(tail));
+    memcpy(tail, &data[full], len - full);
+    return settings_store_program(st, addr + SETTINGS_STORE_REC_HDR_LEN + full, tail, SETTINGS_STORE_DW);
+  }
+  return true;
+}
+
+/**
+ * @brief Прочитать и проверить заголовок страницы.
+ * @param st Контекст.
+ * @param page Страница.
+ * @param seq seq страницы.
+ * @return true, если заголовок валиден и версия совпадает.
+ */
+static bool settings_store_page_valid(settings_store_t *st, uint32_t page, uint32_t *seq)
+{
+  uint8_t hdr[SETTINGS_STORE_PAGE_HDR_LEN];
+  if (!st->io.read(st->io.user, page * st->cfg.page_size, hdr, sizeof(hdr)) ||
+      (settings_store_u32(&hdr[0]) != SETTINGS_STORE_MAGIC) ||
+      (settings_store_u32(&hdr[12]) != settings_store_crc32(0u, hdr, 12u)))
+  {
+    return false;
+  }
+  if (settings_store_u16(&hdr[4]) != SETTINGS_STORE_VERSION)
+  {
+    st->diag |= (uint32_t)SETTINGS_STORE_DIAG_VERSION;
+    return false;
+  }
+  *seq = settings_store_u32(&hdr[8]);
+  return true;
+}
+
+/**
+ * @brief Один последовательный проход журнала активной страницы: индекс последних записей и смещение дописывания.
+ * @param st Контекст.
+ * @return None.
+ */
+static void settings_store_scan(settings_store_t *st)
+{
+  const uint32_t base = st->active_page * st->cfg.page_size;
+  uint32_t off = SETTINGS_STORE_PAGE_HDR_LEN;
+  while ((off + SETTINGS_STORE_REC_HDR_LEN) <= st->cfg.page_size)
+  {
+    uint8_t hdr[SETTINGS_STORE_REC_HDR_LEN];
+    if (!st->io.read(st->io.user, base + off, hdr, sizeof(hdr)))
+    {
+      st->tail_dirty = true;
+      break;
+    }
+    if (settings_store_dw(hdr) == UINT64_MAX)
+    {
+      break; /* стёртая область: конец журнала */
+    }
+
+    // Шаг 1: Границы записи; заголовок с мусором (оборванный program) ⇒ хвост грязный.
+    const uint16_t id = settings_store_u16(&hdr[0]);
+    const uint32_t len = settings_store_u16(&hdr[2]);
+    const uint32_t size = settings_store_rec_size(len); /* [байт] */
+    if ((id >= SETTINGS_STORE_IDS_MAX) || (len > SETTINGS_STORE_VALUE_MAX) || ((off + size) > st->cfg.page_size))
+    {
+      st->tail_dirty = true;
+      break;
+    }
+
+    // Шаг 2: CRC payload; несовпадение ⇒ запись оборвана, всё после неё не используется.
+    uint8_t buf[SETTINGS_STORE_VALUE_MAX];
+    if (!st->io.read(st->io.user, base + off + SETTINGS_STORE_REC_HDR_LEN, buf, len) ||
+        (settings_store_crc32(settings_store_crc32(0u, hdr, 4u), buf, len) != settings_store_u32(&hdr[4])))
+    {
+      st->tail_dirty = true;
+      break;
+    }
+    st->rec_addr[id] = base + off;
+    st->rec_len[id] = (uint16_t)len;
+    off += size;
+  }
+  st->wr_off = off;
+  if (st->tail_dirty)
+  {
+    st->diag |= (uint32_t)SETTINGS_STORE_DIAG_TORN_TAIL;
+  }
+}
+
+bool settings_store_mount(settings_store_t *st, const settings_store_io_t *io, const settings_store_cfg_t *cfg)
+{
+  const settings_store_t zero = {0};
+  *st = zero;
+  for (uint32_t i = 0u; i < SETTINGS_STORE_IDS_MAX; ++i)
+  {
+    st->rec_addr[i] = SETTINGS_STORE_NONE;
+  }
+
+  if ((io == NULL) || (cfg == NULL) || (io->read == NULL) || (io->program == NULL) || (io->erase == NULL) ||
+      (cfg->page_count < 2u) || (cfg->page_count > SETTINGS_STORE_PAGES_MAX) ||
+      ((cfg->page_size % SETTINGS_STORE_DW) != 0u) ||
+      (cfg->page_size < (SETTINGS_STORE_PAGE_HDR_LEN + settings_store_rec_size(SETTINGS_STORE_VALUE_MAX))) ||
+      (cfg->page_size > (UINT32_MAX / cfg->page_count)))
+  {
+    return false;
+  }
+  st->io = *io;
+  st->cfg = *cfg;
+  st->mounted = true;
+
+  // Шаг 1: Активная страница — валидный заголовок с максимальным seq (сравнение устойчиво к переполнению).
+  for (uint32_t p = 0u; p < cfg->page_count; ++p)
+  {
+    uint32_t seq = 0u;
+    if (settings_store_page_valid(st, p, &seq) && (!st->has_active || ((int32_t)(seq - st->seq) > 0)))
+    {
+      st->has_active = true;
+      st->active_page = p;
+      st->seq = seq;
+    }
+  }
+  if (!st->has_active)
+  {
+    st->diag |= (uint32_t)SETTINGS_STORE_DIAG_BLANK;
+    return true;
+  }
+
+  // Шаг 2: Индекс последних записей.
+  settings_store_scan(st);
+  return true;
+}
+
+bool settings_store_read(const settings_store_t *st, uint16_t id, void *dst, uint32_t cap, uint32_t *len)
+{
+  if (!st->mounted || (id >= SETTINGS_STORE_IDS_MAX) || (st->rec_addr[id] == SETTINGS_STORE_NONE) ||
+      (st->rec_len[id] > cap))
+  {
+    return false;
+  }
+  *len = st->rec_len[id];
+  return st->io.read(st->io.user, st->rec_addr[id] + SETTINGS_STORE_REC_HDR_LEN, dst, st->rec_len[id]);
+}
+
+/**
+ * @brief Уплотнение: живые записи + новая запись в следующую страницу кольца, заголовок — последним.
+ * @param st Контекст.
+ * @param id ID новой записи.
+ * @param data Payload.
+ * @param len Длина, [байт].
+ * @return Результат.
+ */
+static settings_store_status_t settings_store_compact(settings_store_t *st, uint16_t id, const uint8_t *data,
+                                                      uint32_t len)
+{
+  // Шаг 1: Проверка, что живые данные помещаются (иначе — отказ без erase).
+  uint32_t need = SETTINGS_STORE_PAGE_HDR_LEN + settings_store_rec_size(len); /* [байт] */
+  for (uint32_t i = 0u; i < SETTINGS_STORE_IDS_MAX; ++i)
+  {
+    if ((i != id) && (st->rec_addr[i] != SETTINGS_STORE_NONE))
+    {
+      need += settings_store_rec_size(st->rec_len[i]);
+    }
+  }
+  if (need > st->cfg.page_size)
+  {
+    st->stats.cnt_rejected++;
+    return SETTINGS_STORE_ERR_FULL;
+  }
+
+  // Шаг 2: Erase следующей страницы кольца (износ распределяется по всем страницам).
+  const uint32_t target = st->has_active ? ((st->active_page + 1u) % st->cfg.page_count) : 0u;
+  const uint32_t base = target * st->cfg.page_size;
+  if (!st->io.erase(st->io.user, target))
+  {
+    st->stats.cnt_io_err++;
+    return SETTINGS_STORE_ERR_IO;
+  }
+  st->stats.cnt_erase++;
+
+  // Шаг 3: Копия живых записей как есть (CRC уже внутри), затем новая запись.
+  uint32_t new_addr[SETTINGS_STORE_IDS_MAX];
+  uint32_t off = SETTINGS_STORE_PAGE_HDR_LEN;
+  for (uint32_t i = 0u; i < SETTINGS_STORE_IDS_MAX; ++i)
+  {
+    new_addr[i] = SETTINGS_STORE_NONE;
+    if ((i == id) || (st->rec_addr[i] == SETTINGS_STORE_NONE))
+    {
+      continue;
+    }
+    const uint32_t size = settings_store_rec_size(st->rec_len[i]);
+    for (uint32_t k = 0u; k < size; k += SETTINGS_STORE_DW)
+    {
+      uint8_t dw[SETTINGS_STORE_DW];
+      if (!st->io.read(st->io.user, st->rec_addr[i] + k, dw, SETTINGS_STORE_DW) ||
+          !settings_store_program(st, base + off + k, dw, SETTINGS_STORE_DW))
+      {
+        return SETTINGS_STORE_ERR_IO;
+      }
+    }
+    new_addr[i] = base + off;
+    off += size;
+  }
+  new_addr[id] = base + off;
+  if (!settings_store_program_rec(st, base + off, id, data, len))
+  {
+    return SETTINGS_STORE_ERR_IO;
+  }
+  off += settings_store_rec_size(len);
+
+  // Шаг 4: Заголовок с seq + 1 — точка фиксации (до неё действует прежняя страница).
+  // SAFETY: оборванное уплотнение не портит Active — заголовок новой страницы невалиден.
+  const uint32_t seq = st->has_active ? (st->seq + 1u) : 1u;
+  uint8_t hdr[SETTINGS_STORE_PAGE_HDR_LEN];
+  settings_store_put_u32(&hdr[0], SETTINGS_STORE_MAGIC);
+  hdr[4] = (uint8_t)(SETTINGS_STORE_VERSION & 0xFFu);
+  hdr[5] = (uint8_t)(SETTINGS_STORE_VERSION >> 8);
+  hdr[6] = 0u;
+  hdr[7] = 0u;
+  settings_store_put_u32(&hdr[8], seq);
+  settings_store_put_u32(&hdr[12], settings_store_crc32(0u, hdr, 12u));
+  if (!settings_store_program(st, base, hdr, SETTINGS_STORE_PAGE_HDR_LEN))
+  {
+    return SETTINGS_STORE_ERR_IO;
+  }
+
+  st->has_active = true;
+  st->active_page = target;
+  st->seq = seq;
+  st->wr_off = off;
+  st->tail_dirty = false;
+  memcpy(st->rec_addr, new_addr, sizeof(new_addr));
+  st->rec_len[id] = (uint16_t)len;
+  st->stats.cnt_compact++;
+  return SETTINGS_STORE_OK;
+}
+
+/**
+ * @brief Совпадает ли новое значение с сохранённым.
+ * @param st Контекст.
+ * @param id ID.
+ * @param data Значение.
+ * @param len Длина, [байт].
+ * @return true, если запись не нужна.
+ */
+static bool settings_store_unchanged(const settings_store_t *st, uint16_t id, const uint8_t *data, uint32_t len)
+{
+  uint8_t cur[SETTINGS_STORE_VALUE_MAX];
+  uint32_t cur_len = 0u;
+  return settings_store_read(st, id, cur, sizeof(cur), &cur_len) && (cur_len == len) &&
+         (memcmp(cur, data, len) == 0);
+}
+
+settings_store_status_t settings_store_write(settings_store_t *st, uint16_t id, const void *data, uint32_t len,
+                                             bool idle)
+{
+  // SAFETY: program/erase останавливает выборку из Flash банка — только в IDLE (PWM OFF).
+  if (!idle)
+  {
+    st->stats.cnt_rejected++;
+    return SETTINGS_STORE_ERR_NOT_IDLE;
+  }
+  if (!st->mounted || (id >= SETTINGS_STORE_IDS_MAX) || (len > SETTINGS_STORE_VALUE_MAX) ||
+      ((data == NULL) && (len != 0u)))
+  {
+    st->stats.cnt_rejected++;
+    return SETTINGS_STORE_ERR_PARAM;
+  }
+  const uint8_t *bytes = (const uint8_t *)data;
+  if (settings_store_unchanged(st, id, bytes, len))
+  {
+    st->stats.cnt_unchanged++;
+    return SETTINGS_STORE_OK;
+  }
+
+  const uint32_t size = settings_store_rec_size(len);
+  if (!st->has_active || st->tail_dirty || ((st->wr_off + size) > st->cfg.page_size))
+  {
+    return settings_store_compact(st, id, bytes, len);
+  }
+
+  const uint32_t addr = (st->active_page * st->cfg.page_size) + st->wr_off;
+  if (!settings_store_program_rec(st, addr, id, bytes, len))
+  {
+    // Часть записи могла попасть во Flash: дописывать поверх нельзя ⇒ следующее сохранение через уплотнение.
+    st->tail_dirty = true;
+    return SETTINGS_STORE_ERR_IO;
+  }
+  st->rec_addr[id] = addr;
+  st->rec_len[id] = (uint16_t)len;
+  st->wr_off += size;
+  st->stats.cnt_append++;
+  return SETTINGS_STORE_OK;
+}
@@ -0,0 +1,155 @@
+#ifndef SETTINGS_STORE_H
+#define SETTINGS_STORE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file settings_store.h
+ * @brief Хранилище настроек/калибровок во внутренней Flash G474: журнал записей по ID параметра, Active/Backup.
+ * @details
+ * Контракт (PROJECT_CONTEXT §5, DN-003 §3.3): `magic + version + crc32 + payload`, запись только в `IDLE`,
+ * при отсутствии валидных данных — hardcoded defaults вызывающего + диагностический флаг.
+ *
+ * Раскладка: область из `page_count` страниц (кольцо). Страница = заголовок 16 байт
+ * `{magic u32, version u16, 0 u16, seq u32, crc32 u32}` + журнал записей `{id u16, len u16, crc32 u32}` + payload
+ * (выравнивание на double-word 8 байт — единица программирования G474). Действительна запись с последним адресом.
+ * - Сохранение = дописать одну запись в активную страницу (несколько double-word, без erase).
+ * - Страница заполнена (или хвост повреждён) ⇒ уплотнение: erase следующей страницы кольца, копия живых записей,
+ *   новая запись, заголовок с `seq + 1` — последним. До записи заголовка активна старая страница (Active), после —
+ *   новая; старая остаётся нетронутой до следующего уплотнения (Backup). Кольцо выравнивает износ страниц.
+ * - Старт: чтение заголовков страниц, выбор валидной с максимальным `seq`, один последовательный проход журнала;
+ *   проход останавливается на первой записи с ошибкой (power-loss при дописывании) — хвост помечается грязным,
+ *   следующее сохранение начинается с уплотнения.
+ *
+ * Доступ к Flash инжектируется портом (HAL_FLASH_Program DOUBLEWORD / HAL_FLASHEx_Erase, чтение — memory-mapped);
+ * на host — эмулятор `settings_flash_emu` с инжекцией power-loss.
+ */
+
+#define SETTINGS_STORE_MAGIC (0x5453464Du) /**< "MFST" (LE). */
+#define SETTINGS_STORE_VERSION (1u) /**< Версия формата страницы. */
+#define SETTINGS_STORE_IDS_MAX (64u) /**< ID параметров 0…IDS_MAX-1, [шт]. */
+#define SETTINGS_STORE_VALUE_MAX (256u) /**< Максимальный payload записи, [байт]. */
+#define SETTINGS_STORE_PAGE_HDR_LEN (16u) /**< Заголовок страницы, [байт]. */
+#define SETTINGS_STORE_REC_HDR_LEN (8u) /**< Заголовок записи, [байт]. */
+#define SETTINGS_STORE_PAGES_MAX (16u) /**< Максимум страниц в кольце, [шт]. */
+
+/**
+ * @brief Диагностика монтирования (битовая маска).
+ */
+typedef enum {
+  SETTINGS_STORE_DIAG_BLANK = (1u << 0),     /**< Нет валидной страницы: вызывающий использует defaults. */
+  SETTINGS_STORE_DIAG_TORN_TAIL = (1u << 1), /**< Журнал оборван (power-loss при дописывании). */
+  SETTINGS_STORE_DIAG_VERSION = (1u << 2)    /**< Найдена страница другой версии формата (игнорируется). */
+} settings_store_diag_t;
+
+/**
+ * @brief Результат сохранения.
+ */
+typedef enum {
+  SETTINGS_STORE_OK = 0u,          /**< Записано (или значение не изменилось). */
+  SETTINGS_STORE_ERR_NOT_IDLE = 1u, /**< Запись вне IDLE запрещена (Flash не трогается). */
+  SETTINGS_STORE_ERR_PARAM = 2u,   /**< ID/длина вне диапазона или хранилище не смонтировано. */
+  SETTINGS_STORE_ERR_FULL = 3u,    /**< Живые записи не помещаются в страницу. */
+  SETTINGS_STORE_ERR_IO = 4u       /**< Ошибка program/erase: действует прежнее значение. */
+} settings_store_status_t;
+
+/**
+ * @brief Доступ к Flash (инжектируется портом; адреса — смещения от начала области).
+ */
+typedef struct {
+  bool (*read)(void *user, uint32_t addr, void *dst, uint32_t len); /**< Чтение. */
+  bool (*program)(void *user, uint32_t addr, uint64_t dw); /**< Программирование double-word (addr кратен 8). */
+  bool (*erase)(void *user, uint32_t page); /**< Стирание страницы. */
+  void *user; /**< Контекст для функций. */
+} settings_store_io_t;
+
+/**
+ * @brief Геометрия области.
+ */
+typedef struct {
+  uint32_t page_size; /**< Размер страницы (G474: 2048 в dual-bank), [байт]. */
+  uint32_t page_count; /**< Страниц в кольце (2…SETTINGS_STORE_PAGES_MAX), [шт]. */
+} settings_store_cfg_t;
+
+/**
+ * @brief Метрики.
+ */
+typedef struct {
+  uint32_t cnt_append; /**< Сохранений дописыванием, [шт]. */
+  uint32_t cnt_compact; /**< Уплотнений, [шт]. */
+  uint32_t cnt_unchanged; /**< Сохранений без записи (значение совпало), [шт]. */
+  uint32_t cnt_erase; /**< Стираний страниц, [шт]. */
+  uint32_t cnt_program; /**< Запрограммированных double-word, [шт]. */
+  uint32_t cnt_rejected; /**< Отказов NOT_IDLE/PARAM/FULL, [шт]. */
+  uint32_t cnt_io_err; /**< Ошибок program/erase, [шт]. */
+} settings_store_stats_t;
+
+/**
+ * @brief Контекст хранилища.
+ */
+typedef struct {
+  settings_store_io_t io; /**< Доступ к Flash. */
+  settings_store_cfg_t cfg; /**< Геометрия. */
+  bool mounted; /**< Монтирование выполнено (конфигурация валидна). */
+  bool has_active; /**< Есть активная страница. */
+  bool tail_dirty; /**< Хвост журнала не стёрт: следующее сохранение — через уплотнение. */
+  uint32_t active_page; /**< Активная страница, [индекс]. */
+  uint32_t seq; /**< seq активной страницы, [шт]. */
+  uint32_t wr_off; /**< Смещение дописывания в активной странице, [байт]. */
+  uint32_t rec_addr[SETTINGS_STORE_IDS_MAX]; /**< Адрес последней записи ID (UINT32_MAX = нет), [байт]. */
+  uint16_t rec_len[SETTINGS_STORE_IDS_MAX]; /**< Длина payload последней записи ID, [байт]. */
+  uint32_t diag; /**< Диагностика монтирования (settings_store_diag_t), [битовая маска]. */
+  settings_store_stats_t stats; /**< Метрики. */
+} settings_store_t;
+
+/**
+ * @brief Смонтировать хранилище: выбрать активную страницу и восстановить индекс одним проходом журнала.
+ * @param st Контекст.
+ * @param io Доступ к Flash (копируется).
+ * @param cfg Геометрия (копируется).
+ * @return false при невалидной конфигурации/io (хранилище не смонтировано).
+ */
+bool settings_store_mount(settings_store_t *st, const settings_store_io_t *io, const settings_store_cfg_t *cfg);
+
+/**
+ * @brief Прочитать значение параметра.
+ * @param st Контекст.
+ * @param id ID параметра.
+ * @param dst Буфер.
+ * @param cap Размер буфера, [байт].
+ * @param len Длина значения, [байт].
+ * @return false, если значения нет (вызывающий берёт default) или буфер мал.
+ */
+bool settings_store_read(const settings_store_t *st, uint16_t id, void *dst, uint32_t cap, uint32_t *len);
+
+/**
+ * @brief Сохранить значение параметра (только в IDLE).
+ * @param st Контекст.
+ * @param id ID параметра.
+ * @param data Значение.
+ * @param len Длина, [байт] (0…SETTINGS_STORE_VALUE_MAX).
+ * @param idle Система в IDLE (PWM OFF).
+ * @return Результат; при ошибке действует прежнее значение.
+ */
+settings_store_status_t settings_store_write(settings_store_t *st, uint16_t id, const void *data, uint32_t len,
+                                             bool idle);
+
+/**
+ * @brief CRC-32 (IEEE 802.3, отражённый, init/xorout 0xFFFFFFFF).
+ * @param crc Предыдущее значение (0 для начала).
+ * @param data Данные.
+ * @param len Длина, [байт].
+ * @return CRC-32.
+ */
+uint32_t settings_store_crc32(uint32_t crc, const void *data, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SETTINGS_STORE_H */
@@ -0,0 +1,209 @@
+#include <string.h>
+
+#include "control_core.h"
+#include "sil_scenarios.h"
+#include "tk_cmd_rx.h"
+#include "tk_cmd_timeout.h"
+
+#define SIL_CT_TICK_US (250u) /**< Период команд/tick slow-домена (4 кГц), [мкс]. */
+#define SIL_CT_PWM_TICKS (4u) /**< Период PWM в tick (1 кГц), [шт]. */
+#define SIL_CT_PLANT_ALPHA (0.2f) /**< Дискретная модель нагрузки: i += alpha * (u - i), [-]. */
+
+/**
+ * @brief Состояние генератора потока команд.
+ */
+typedef struct {
+  bool on; /**< Поток идёт (false = пропуск команд). */
+  int32_t i_ref_ma; /**< Уставка потока, [mA]. */
+  bool enable; /**< true = WELD/enable=1, false = IDLE/enable=0. */
+  bool reset_pending; /**< Следующий кадр — IDLE + fault_reset. */
+  uint16_t seq; /**< Следующий `seq`, [-]. */
+} sil_ct_stream_t;
+
+/**
+ * @brief Применить событие трассы к генератору.
+ * @param stream Генератор.
+ * @param evt Событие.
+ * @return false, если событие неизвестно.
+ */
+static bool sil_ct_apply_event(sil_ct_stream_t *stream, const sil_event_t *evt)
+{
+  if (strcmp(evt->name, "stream") == 0)
+  {
+    stream->on = true;
+    stream->i_ref_ma = evt->arg0;
+    stream->enable = (evt->arg1 != 0);
+    return true;
+  }
+  if (strcmp(evt->name, "drop") == 0)
+  {
+    stream->on = false;
+    return true;
+  }
+  if (strcmp(evt->name, "reset") == 0)
+  {
+    stream->reset_pending = true;
+    return true;
+  }
+  return strcmp(evt->name, "end") == 0;
+}
+
+/**
+ * @brief Собрать очередной кадр `CMD_WELD`.
+ * @param stream Генератор.
+ * @return Кадр.
+ */
+static tk_cmd_weld_t sil_ct_next_cmd(sil_ct_stream_t *stream)
+{
+  const bool weld = stream->enable && !stream->reset_pending;
+  const tk_cmd_weld_t cmd = {
+    .seq = stream->seq,
+    .mode = weld ? TK_MODE_WELD : TK_MODE_IDLE,
+    .enable = weld ? 1u : 0u,
+    .i_ref_cmd_ma = weld ? stream->i_ref_ma : 0,
+    .max_slew_rate_a_ms = 0u,
+    .fault_reset = stream->reset_pending ? 1u : 0u,
+    .must_be_zero = 0u
+  };
+  stream->seq++;
+  stream->reset_pending = false;
+  return cmd;
+}
+
+/**
+ * @brief Обновить метрику "момент первого фронта".
+ * @param slot Метрика (-1 = ещё не было), [мкс].
+ * @param cond Условие фронта.
+ * @param t_us Текущее время, [мкс].
+ * @return None.
+ */
+static void sil_ct_first(int64_t *slot, bool cond, uint32_t t_us)
+{
+  if (cond && (*slot < 0))
+  {
+    *slot = (int64_t)t_us;
+  }
+}
+
+bool sil_scenario_comms_timeout(const sil_trace_t *trace, FILE *out, sil_report_t *report)
+{
+  if (trace->event_count == 0u)
+  {
+    return false;
+  }
+
+  /* Ядро: те же настройки, что и на target, без slew/ограничений (наблюдаем чистую уставку). */
+  const control_cfg_t ctrl_cfg = {
+    .kp = 1.0f,
+    .ki = 100.0f,
+    .dt = 0.001f,
+    .u_min = -1.0e6f,
+    .u_max = 1.0e6f,
+    .i_ref_min = 0.0f,
+    .i_ref_max = 50000.0f,
+    .di_dt_max = 0.0f,
+    .integrator_policy = CONTROL_INTEGRATOR_RESET
+  };
+  control_ctx_t ctrl;
+  tk_cmd_rx_t rx;
+  tk_cmd_timeout_t sup;
+  control_init(&ctrl, &ctrl_cfg);
+  tk_cmd_rx_init(&rx);
+  (void)tk_cmd_timeout_init(&sup, NULL);
+
+  sil_ct_stream_t stream = {0};
+  control_out_t ctrl_out = {0};
+  float i_meas = 0.0f;
+  uint32_t next_evt = 0u;
+  const uint32_t t_end = trace->events[trace->event_count - 1u].t_us;
+
+  int64_t soft_rise = -1;
+  int64_t soft_clear = -1;
+  int64_t hard_rise = -1;
+  int64_t hard_clear = -1;
+  int64_t i_ref_at_hard_ma = -1;
+  bool monotonic = true;
+  bool energy_in_hard = false;
+  bool prev_soft = false;
+  bool prev_hard = false;
+  float prev_i_ref = 0.0f;
+
+  if (out != NULL)
+  {
+    (void)fprintf(out, "t_us,cmd_rx,verdict,sup_state,soft,hard,i_ref_used_a,enable_request,i_meas_a\n");
+  }
+
+  for (uint32_t tick = 0u; (tick * SIL_CT_TICK_US) <= t_end; ++tick)
+  {
+    const uint32_t t_us = tick * SIL_CT_TICK_US;
+
+    // Шаг 1: События трассы на этот момент.
+    while ((next_evt < trace->event_count) && (trace->events[next_evt].t_us <= t_us))
+    {
+      if (!sil_ct_apply_event(&stream, &trace->events[next_evt]))
+      {
+        (void)fprintf(stderr, "SIL comms_timeout: unknown event '%s'\n", trace->events[next_evt].name);
+        return false;
+      }
+      next_evt++;
+    }
+
+    // Шаг 2: Приём кадра (если поток не пропущен) — та же цепочка, что и в task COMX.
+    int verdict = -1;
+    if (stream.on)
+    {
+      const tk_cmd_weld_t cmd = sil_ct_next_cmd(&stream);
+      const bool publish = tk_cmd_timeout_publish_allowed(&sup);
+      verdict = (int)tk_cmd_rx_process(&rx, &cmd, sup.hard_latched, publish ? &ctrl : NULL);
+      if (verdict == (int)TK_CMD_RX_APPLY)
+      {
+        tk_cmd_timeout_on_apply(&sup, &cmd, t_us);
+      }
+    }
+
+    // Шаг 3: Supervisor таймаутов (каждый tick) и fast-домен на границе периода PWM.
+    const tk_cmd_timeout_state_t state = tk_cmd_timeout_tick(&sup, t_us, &ctrl);
+    if ((tick % SIL_CT_PWM_TICKS) == 0u)
+    {
+      const control_meas_t meas = {.i_meas = i_meas, .u_meas = 0.0f, .udc = 0.0f, .meas_valid = true};
+      control_fast_step(&ctrl, &meas, true, &ctrl_out);
+      i_meas += SIL_CT_PLANT_ALPHA * (ctrl_out.u - i_meas);
+    }
+
+    // Шаг 4: Метрики.
+    const bool soft = sup.soft_active;
+    const bool hard = sup.hard_latched;
+    sil_ct_first(&soft_rise, soft && !prev_soft, t_us);
+    sil_ct_first(&soft_clear, !soft && prev_soft, t_us);
+    sil_ct_first(&hard_rise, hard && !prev_hard, t_us);
+    sil_ct_first(&hard_clear, !hard && prev_hard, t_us);
+    if (hard && !prev_hard)
+    {
+      i_ref_at_hard_ma = (int64_t)(ctrl_out.i_ref_used * 1000.0f + 0.5f);
+    }
+    monotonic = monotonic && !(soft && prev_soft && !hard && (ctrl_out.i_ref_used > prev_i_ref + 1e-3f));
+    energy_in_hard = energy_in_hard || (hard && prev_hard && ctrl_out.enable_request);
+    prev_soft = soft;
+    prev_hard = hard;
+    prev_i_ref = ctrl_out.i_ref_used;
+
+    if (out != NULL)
+    {
+      (void)fprintf(out, "%u,%d,%d,%u,%d,%d,%.3f,%d,%.3f\n", t_us, stream.on ? 1 : 0, verdict, (unsigned)state,
+                    soft ? 1 : 0, hard ? 1 : 0, (double)ctrl_out.i_ref_used, ctrl_out.enable_request ? 1 : 0,
+                    (double)i_meas);
+    }
+  }
+
+  sil_report_set(report, "soft_rise_us", soft_rise);
+  sil_report_set(report, "soft_clear_us", soft_clear);
+  sil_report_set(report, "hard_rise_us", hard_rise);
+  sil_report_set(report, "hard_clear_us", hard_clear);
+  sil_report_set(report, "i_ref_at_hard_ma", i_ref_at_hard_ma);
+  sil_report_set(report, "ramp_monotonic", monotonic ? 1 : 0);
+  sil_report_set(report, "energy_in_hard", energy_in_hard ? 1 : 0);
+  sil_report_set(report, "cnt_soft_timeout", sup.cnt_soft_timeout);
+  sil_report_set(report, "cnt_hard_timeout", sup.cnt_hard_timeout);
+  sil_report_set(report, "cmd_age_max_us", sup.age_max_us);
+  return true;
+}
@@ -0,0 +1,271 @@
+#include <math.h>
+#include <string.h>
+
+#include "control_adapt.h"
+#include "control_core.h"
+#include "sil_scenarios.h"
+
+#define SIL_GS_PWM_US (1000u) /**< Период PWM (1 кГц), [мкс]. */
+#define SIL_GS_N_TR (50.0f) /**< Коэффициент трансформации, [-]. */
+#define SIL_GS_UDC_V (500.0f) /**< Напряжение звена, [В]. */
+#define SIL_GS_WC_RAD_S (150.0f) /**< Расчётная полоса контура тока, [рад/с]. */
+#define SIL_GS_L_NOM_H (1.0e-6f) /**< Номинальная индуктивность для расчёта kp, [Гн]. */
+#define SIL_GS_R_NOM_OHM (100e-6f) /**< Номинальное R (фиксированные коэффициенты), [Ом]. */
+#define SIL_GS_BAND (0.05f) /**< Полоса установления, доля уставки, [-]. */
+#define SIL_GS_BAND_MIN_A (50.0f) /**< Минимальная полоса установления (уставка 0), [A]. */
+#define SIL_GS_R_TOL (0.05f) /**< Допуск оценки R для r_est_ok, [-]. */
+#define SIL_GS_OVERSHOOT_MAX (0.10f) /**< Допустимое перерегулирование, [-]. */
+
+/**
+ * @brief Модель нагрузки: вторичный R-L контур, точная дискретизация на периоде PWM.
+ */
+typedef struct {
+  float r_ohm; /**< Сопротивление, [Ом]. */
+  float l_h; /**< Индуктивность, [Гн]. */
+  float i_a; /**< Ток в конце периода, [A]. */
+} sil_gs_plant_t;
+
+/**
+ * @brief Контур "регулятор + нагрузка" со статистикой установления.
+ */
+typedef struct {
+  control_ctx_t ctrl; /**< Ядро управления. */
+  sil_gs_plant_t plant; /**< Нагрузка. */
+  control_out_t out; /**< Выход последнего шага. */
+  float i_avg_a; /**< Средний ток последнего периода (`I_per`), [A]. */
+  float u_sec_v; /**< Напряжение вторички последнего периода (`U_per`), [В]. */
+  int64_t t_last_out_us; /**< Последний момент вне полосы (-1 = не было), [мкс]. */
+  float i_peak_a; /**< Максимум тока после последней уставки, [A]. */
+} sil_gs_loop_t;
+
+/**
+ * @brief Коэффициенты PI для R/L: нуль PI компенсирует полюс R/L, полоса SIL_GS_WC_RAD_S.
+ * @param r_ohm Сопротивление, [Ом].
+ * @param l_h Индуктивность, [Гн].
+ * @return Точка таблицы.
+ */
+static control_adapt_point_t sil_gs_design(float r_ohm, float l_h)
+{
+  const float k_plant = SIL_GS_UDC_V / SIL_GS_N_TR; /* [В/отн. ед.] */
+  const control_adapt_point_t pt = {
+    .r_ohm = r_ohm,
+    .kp = (SIL_GS_WC_RAD_S * l_h) / k_plant,
+    .ki = (SIL_GS_WC_RAD_S * r_ohm) / k_plant
+  };
+  return pt;
+}
+
+/**
+ * @brief Продвинуть нагрузку на один период при постоянном u.
+ * @param loop Контур.
+ * @param u Нормированное управление, [отн. ед.].
+ * @return None.
+ */
+static void sil_gs_plant_step(sil_gs_loop_t *loop, float u)
+{
+  sil_gs_plant_t *p = &loop->plant;
+  const float t_s = (float)SIL_GS_PWM_US * 1.0e-6f; /* [с] */
+  const float v = u * (SIL_GS_UDC_V / SIL_GS_N_TR); /* [В] */
+  const float tau = p->l_h / p->r_ohm; /* [с] */
+  const float i_ss = v / p->r_ohm; /* [A] */
+  const float decay = expf(-t_s / tau); /* [-] */
+  const float i0 = p->i_a; /* [A] */
+  p->i_a = i_ss + ((i0 - i_ss) * decay);
+  loop->i_avg_a = i_ss + (((i0 - i_ss) * tau * (1.0f - decay)) / t_s);
+  loop->u_sec_v = v;
+}
+
+/**
+ * @brief Инициализировать контур.
+ * @param loop Контур.
+ * @param cfg Конфигурация ядра.
+ * @return None.
+ */
+static void sil_gs_loop_init(sil_gs_loop_t *loop, const control_cfg_t *cfg)
+{
+  const sil_gs_loop_t zero = {0};
+  *loop = zero;
+  control_init(&loop->ctrl, cfg);
+  loop->plant.r_ohm = SIL_GS_R_NOM_OHM;
+  loop->plant.l_h = SIL_GS_L_NOM_H;
+  loop->t_last_out_us = -1;
+}
+
+/**
+ * @brief Один период PWM: fast-шаг по измерениям прошлого периода, нагрузка, статистика.
+ * @param loop Контур.
+ * @param t_us Время начала периода, [мкс].
+ * @param i_ref Текущая уставка, [A].
+ * @return None.
+ */
+static void sil_gs_loop_step(sil_gs_loop_t *loop, uint32_t t_us, float i_ref)
+{
+  const control_meas_t meas = {.i_meas = loop->i_avg_a, .u_meas = loop->u_sec_v, .udc = SIL_GS_UDC_V,
+                               .meas_valid = true};
+  control_fast_step(&loop->ctrl, &meas, true, &loop->out);
+  sil_gs_plant_step(loop, loop->out.u);
+
+  const float band = fmaxf(SIL_GS_BAND * fabsf(i_ref), SIL_GS_BAND_MIN_A); /* [A] */
+  if (fabsf(loop->i_avg_a - i_ref) > band)
+  {
+    loop->t_last_out_us = (int64_t)t_us;
+  }
+  loop->i_peak_a = fmaxf(loop->i_peak_a, loop->i_avg_a);
+}
+
+/**
+ * @brief Время установления относительно уставки.
+ * @param loop Контур.
+ * @param t_ref_us Момент уставки, [мкс].
+ * @param t_end_us Последний период, [мкс].
+ * @return Время установления (-1 = не установился), [мкс].
+ */
+static int64_t sil_gs_settle_us(const sil_gs_loop_t *loop, uint32_t t_ref_us, uint32_t t_end_us)
+{
+  if (loop->t_last_out_us < 0)
+  {
+    return 0;
+  }
+  if (loop->t_last_out_us >= (int64_t)t_end_us)
+  {
+    return -1;
+  }
+  return (loop->t_last_out_us + (int64_t)SIL_GS_PWM_US) - (int64_t)t_ref_us;
+}
+
+bool sil_scenario_gain_sched(const sil_trace_t *trace, FILE *out, sil_report_t *report)
+{
+  if (trace->event_count == 0u)
+  {
+    return false;
+  }
+
+  /* Ядро: FF выключен, чтобы сравнивать только PI; коэффициенты cfg рассчитаны на номинальную нагрузку. */
+  const control_adapt_point_t nominal = sil_gs_design(SIL_GS_R_NOM_OHM, SIL_GS_L_NOM_H);
+  const control_cfg_t ctrl_cfg = {
+    .kp = nominal.kp,
+    .ki = nominal.ki,
+    .dt = (float)SIL_GS_PWM_US * 1.0e-6f,
+    .u_min = 0.0f,
+    .u_max = 1.0f,
+    .i_ref_min = 0.0f,
+    .i_ref_max = 50000.0f,
+    .di_dt_max = 0.0f,
+    .integrator_policy = CONTROL_INTEGRATOR_RESET
+  };
+
+  /* Таблица: kp — по номинальной L, ki — по R (нуль PI на полюсе R/L). */
+  control_adapt_cfg_t adapt_cfg = {
+    .dt = ctrl_cfg.dt,
+    .lambda = 0.95f,
+    .p0 = 100.0f,
+    .i_scale = 10000.0f,
+    .i_min = 500.0f,
+    .r_init = SIL_GS_R_NOM_OHM,
+    .l_init = SIL_GS_L_NOM_H,
+    .r_min = 20e-6f,
+    .r_max = 2000e-6f,
+    .l_min = 0.1e-6f,
+    .l_max = 10e-6f,
+    .sched_count = 5u
+  };
+  const float sched_r[5] = {50e-6f, 100e-6f, 200e-6f, 400e-6f, 800e-6f};
+  for (uint32_t i = 0u; i < adapt_cfg.sched_count; ++i)
+  {
+    adapt_cfg.sched[i] = sil_gs_design(sched_r[i], SIL_GS_L_NOM_H);
+  }
+
+  sil_gs_loop_t fixed;
+  sil_gs_loop_t sched;
+  control_adapt_t est;
+  sil_gs_loop_init(&fixed, &ctrl_cfg);
+  sil_gs_loop_init(&sched, &ctrl_cfg);
+  if (!control_adapt_init(&est, &adapt_cfg))
+  {
+    (void)fprintf(stderr, "SIL gain_sched: invalid adapt cfg\n");
+    return false;
+  }
+
+  float i_ref = 0.0f;
+  uint32_t t_ref_us = 0u;
+  uint32_t next_evt = 0u;
+  control_adapt_out_t est_out = {0};
+  const uint32_t t_end = trace->events[trace->event_count - 1u].t_us;
+
+  if (out != NULL)
+  {
+    (void)fprintf(out, "t_us,i_ref_a,i_fixed_a,u_fixed,i_sched_a,u_sched,r_est_uohm,l_est_nh,kp,ki\n");
+  }
+
+  for (uint32_t t_us = 0u; t_us <= t_end; t_us += SIL_GS_PWM_US)
+  {
+    // Шаг 1: События трассы на этот момент.
+    while ((next_evt < trace->event_count) && (trace->events[next_evt].t_us <= t_us))
+    {
+      const sil_event_t *evt = &trace->events[next_evt];
+      if (strcmp(evt->name, "load") == 0)
+      {
+        const sil_gs_plant_t plant = {.r_ohm = (float)evt->arg0 * 1.0e-6f, .l_h = (float)evt->arg1 * 1.0e-9f};
+        if (!(plant.r_ohm > 0.0f) || !(plant.l_h > 0.0f))
+        {
+          (void)fprintf(stderr, "SIL gain_sched: invalid load %d/%d\n", evt->arg0, evt->arg1);
+          return false;
+        }
+        fixed.plant.r_ohm = plant.r_ohm;
+        fixed.plant.l_h = plant.l_h;
+        sched.plant.r_ohm = plant.r_ohm;
+        sched.plant.l_h = plant.l_h;
+      }
+      else if (strcmp(evt->name, "ref") == 0)
+      {
+        i_ref = (float)evt->arg0;
+        t_ref_us = t_us;
+        const control_cmd_t cmd = {.i_ref_cmd = i_ref, .enable_cmd = true, .cmd_valid = true};
+        control_slow_step(&fixed.ctrl, &cmd);
+        control_slow_step(&sched.ctrl, &cmd);
+        fixed.t_last_out_us = -1;
+        sched.t_last_out_us = -1;
+        fixed.i_peak_a = 0.0f;
+        sched.i_peak_a = 0.0f;
+      }
+      else if (strcmp(evt->name, "end") != 0)
+      {
+        (void)fprintf(stderr, "SIL gain_sched: unknown event '%s'\n", evt->name);
+        return false;
+      }
+      next_evt++;
+    }
+
+    // Шаг 2: Оба контура на одной нагрузке; у второго коэффициенты из расписания прошлого периода.
+    sil_gs_loop_step(&fixed, t_us, i_ref);
+    sil_gs_loop_step(&sched, t_us, i_ref);
+
+    // Шаг 3: Оценка R/L по I_per/U_per завершившегося периода → коэффициенты на следующий период.
+    control_adapt_step(&est, sched.i_avg_a, sched.u_sec_v, &est_out);
+    control_set_gains(&sched.ctrl, &est_out.gains);
+
+    if (out != NULL)
+    {
+      (void)fprintf(out, "%u,%.1f,%.1f,%.5f,%.1f,%.5f,%.2f,%.1f,%.4g,%.4g\n", t_us, (double)i_ref,
+                    (double)fixed.i_avg_a, (double)fixed.out.u, (double)sched.i_avg_a, (double)sched.out.u,
+                    (double)(est_out.r_est * 1.0e6f), (double)(est_out.l_est * 1.0e9f), (double)est_out.gains.kp,
+                    (double)est_out.gains.ki);
+    }
+  }
+
+  const uint32_t t_last = (t_end / SIL_GS_PWM_US) * SIL_GS_PWM_US;
+  const int64_t settle_fixed = sil_gs_settle_us(&fixed, t_ref_us, t_last);
+  const int64_t settle_sched = sil_gs_settle_us(&sched, t_ref_us, t_last);
+  const bool faster = (settle_sched >= 0) && ((settle_fixed < 0) || (settle_sched < settle_fixed));
+  const float r_err = fabsf(est_out.r_est - sched.plant.r_ohm) / sched.plant.r_ohm; /* [-] */
+  const bool overshoot_ok = sched.i_peak_a <= (i_ref * (1.0f + SIL_GS_OVERSHOOT_MAX));
+
+  sil_report_set(report, "settle_fixed_us", settle_fixed);
+  sil_report_set(report, "settle_sched_us", settle_sched);
+  sil_report_set(report, "sched_faster", faster ? 1 : 0);
+  sil_report_set(report, "r_est_ok", (r_err <= SIL_GS_R_TOL) ? 1 : 0);
+  sil_report_set(report, "overshoot_ok", overshoot_ok ? 1 : 0);
+  sil_report_set(report, "cnt_rls_updates", est.cnt_updates);
+  sil_report_set(report, "cnt_p_resets", est.cnt_p_resets);
+  return true;
+}
@@ -0,0 +1,251 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sil_scenarios.h"
+#include "sil_trace.h"
+
+#define SIL_PATH_LEN (512u) /**< Максимальная длина пути, [байт]. */
+
+/**
+ * @brief Запись реестра сценариев.
+ */
+typedef struct {
+  const char *name; /**< Имя сценария (`#!scenario`). */
+  sil_scenario_fn_t fn; /**< Функция прогона. */
+} sil_scenario_entry_t;
+
+static const sil_scenario_entry_t k_scenarios[] = {
+  {"comms_timeout", sil_scenario_comms_timeout},
+  {"gain_sched", sil_scenario_gain_sched},
+};
+
+void sil_report_set(sil_report_t *report, const char *key, int64_t value)
+{
+  if (report->count >= SIL_REPORT_MAX_METRICS)
+  {
+    return;
+  }
+  sil_expect_t *metric = &report->metrics[report->count++];
+  (void)snprintf(metric->key, sizeof(metric->key), "%s", key);
+  metric->value = value;
+}
+
+/**
+ * @brief Найти сценарий по имени.
+ * @param name Имя сценария.
+ * @return Функция прогона или NULL.
+ */
+static sil_scenario_fn_t sil_find_scenario(const char *name)
+{
+  for (size_t i = 0u; i < (sizeof(k_scenarios) / sizeof(k_scenarios[0])); ++i)
+  {
+    if (strcmp(k_scenarios[i].name, name) == 0)
+    {
+      return k_scenarios[i].fn;
+    }
+  }
+  return NULL;
+}
+
+/**
+ * @brief Сравнить метрики с ожиданиями трассы.
+ * @param trace Трасса.
+ * @param report Метрики прогона.
+ * @param name Имя трассы (для вывода).
+ * @return true, если все ожидания выполнены.
+ */
+static bool sil_check(const sil_trace_t *trace, const sil_report_t *report, const char *name)
+{
+  int64_t tol_us = 0;
+  (void)sil_trace_expect(trace, "tol_us", &tol_us);
+
+  bool pass = true;
+  for (uint32_t i = 0u; i < trace->expect_count; ++i)
+  {
+    const sil_expect_t *exp = &trace->expects[i];
+    if (strcmp(exp->key, "tol_us") == 0)
+    {
+      continue;
+    }
+
+    const sil_expect_t *metric = NULL;
+    for (uint32_t j = 0u; j < report->count; ++j)
+    {
+      metric = (strcmp(report->metrics[j].key, exp->key) == 0) ? &report->metrics[j] : metric;
+    }
+    if (metric == NULL)
+    {
+      (void)printf("  %s: unknown metric '%s'\n", name, exp->key);
+      pass = false;
+      continue;
+    }
+
+    /* Времена с допуском; "-1 = не случилось" сравнивается точно. */
+    const size_t key_len = strlen(exp->key);
+    const bool is_time = (key_len > 3u) && (strcmp(&exp->key[key_len - 3u], "_us") == 0);
+    const bool never = (exp->value < 0) || (metric->value < 0);
+    const int64_t tol = (is_time && !never) ? tol_us : 0;
+    const int64_t diff = metric->value - exp->value;
+    if ((diff > tol) || (diff < -tol))
+    {
+      (void)printf("  %s: %s = %" PRId64 ", expected %" PRId64 " (tol %" PRId64 ")\n", name, exp->key, metric->value,
+                   exp->value, tol);
+      pass = false;
+    }
+  }
+  return pass;
+}
+
+/**
+ * @brief Базовое имя файла без расширения.
+ * @param path Путь.
+ * @param out Буфер.
+ * @param len Размер буфера, [байт].
+ * @return None.
+ */
+static void sil_basename(const char *path, char *out, size_t len)
+{
+  const char *slash = strrchr(path, '/');
+  (void)snprintf(out, len, "%s", (slash != NULL) ? (slash + 1) : path);
+  char *dot = strrchr(out, '.');
+  if (dot != NULL)
+  {
+    *dot = '\0';
+  }
+}
+
+/**
+ * @brief Прогнать одну трассу.
+ * @param path Путь к трассе.
+ * @param out_dir Каталог выходных трасс (может быть NULL).
+ * @param summary Файл резюме (может быть NULL).
+ * @return true = PASS.
+ */
+static bool sil_run_trace(const char *path, const char *out_dir, FILE *summary)
+{
+  static sil_trace_t trace;
+  char name[SIL_PATH_LEN];
+  sil_basename(path, name, sizeof(name));
+
+  bool pass = sil_trace_load(path, &trace);
+  const sil_scenario_fn_t fn = pass ? sil_find_scenario(trace.scenario) : NULL;
+  if (pass && (fn == NULL))
+  {
+    (void)printf("  %s: unknown scenario '%s'\n", name, trace.scenario);
+    pass = false;
+  }
+
+  sil_report_t report = {0};
+  if (pass)
+  {
+    FILE *out = NULL;
+    if (out_dir != NULL)
+    {
+      char out_path[2u * SIL_PATH_LEN];
+      (void)snprintf(out_path, sizeof(out_path), "%s/%s.out.csv", out_dir, name);
+      out = fopen(out_path, "w");
+    }
+    pass = fn(&trace, out, &report) && sil_check(&trace, &report, name);
+    if (out != NULL)
+    {
+      (void)fclose(out);
+    }
+  }
+
+  (void)printf("%s %s\n", pass ? "PASS" : "FAIL", name);
+  if (summary != NULL)
+  {
+    (void)fprintf(summary, "%s %s [%s]", pass ? "PASS" : "FAIL", name, trace.scenario);
+    for (uint32_t i = 0u; i < report.count; ++i)
+    {
+      (void)fprintf(summary, " %s=%" PRId64, report.metrics[i].key, report.metrics[i].value);
+    }
+    (void)fprintf(summary, "\n");
+  }
+  return pass;
+}
+
+/**
+ * @brief Точка входа L2 SIL runner.
+ * @param argc Количество аргументов командной строки, [шт].
+ * @param argv `--manifest <file> --traces-dir <dir> [--out-dir <dir>] [--summary <file>]` или `<trace.csv>...`.
+ * @return Код завершения (0 = все трассы PASS).
+ * @details Манифест — список путей к трассам относительно `--traces-dir` (по одному на строку, `#` — комментарий).
+ */
+int main(int argc, char **argv)
+{
+  const char *manifest = NULL;
+  const char *traces_dir = ".";
+  const char *out_dir = NULL;
+  const char *summary_path = NULL;
+  int first_trace = argc;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    if ((strcmp(argv[i], "--manifest") == 0) && ((i + 1) < argc))
+    {
+      manifest = argv[++i];
+    }
+    else if ((strcmp(argv[i], "--traces-dir") == 0) && ((i + 1) < argc))
+    {
+      traces_dir = argv[++i];
+    }
+    else if ((strcmp(argv[i], "--out-dir") == 0) && ((i + 1) < argc))
+    {
+      out_dir = argv[++i];
+    }
+    else if ((strcmp(argv[i], "--summary") == 0) && ((i + 1) < argc))
+    {
+      summary_path = argv[++i];
+    }
+    else
+    {
+      first_trace = i;
+      break;
+    }
+  }
+
+  FILE *summary = (summary_path != NULL) ? fopen(summary_path, "w") : NULL;
+  uint32_t total = 0u;
+  uint32_t failed = 0u;
+
+  if (manifest != NULL)
+  {
+    FILE *list = fopen(manifest, "r");
+    if (list == NULL)
+    {
+      (void)fprintf(stderr, "SIL: cannot open manifest %s\n", manifest);
+      return 2;
+    }
+    char line[SIL_PATH_LEN];
+    while (fgets(line, sizeof(line), list) != NULL)
+    {
+      line[strcspn(line, "\r\n")] = '\0';
+      if ((line[0] == '\0') || (line[0] == '#'))
+      {
+        continue;
+      }
+      char path[2u * SIL_PATH_LEN];
+      (void)snprintf(path, sizeof(path), "%s/%s", traces_dir, line);
+      total++;
+      failed += sil_run_trace(path, out_dir, summary) ? 0u : 1u;
+    }
+    (void)fclose(list);
+  }
+
+  for (int i = first_trace; i < argc; ++i)
+  {
+    total++;
+    failed += sil_run_trace(argv[i], out_dir, summary) ? 0u : 1u;
+  }
+
+  if (summary != NULL)
+  {
+    (void)fprintf(summary, "total=%u failed=%u\n", total, failed);
+    (void)fclose(summary);
+  }
+  (void)printf("SIL: %u traces, %u failed\n", total, failed);
+  return ((failed == 0u) && (total > 0u)) ? 0 : 1;
+}
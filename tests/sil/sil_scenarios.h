@@ -0,0 +1,72 @@
+#ifndef SIL_SCENARIOS_H
+#define SIL_SCENARIOS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "sil_trace.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file sil_scenarios.h
+ * @brief Сценарии L2 SIL: прогон core-модулей по трассе, выходная трасса CSV и метрики.
+ * @details
+ * Сценарий моделирует время сам (без реального времени/потоков), поэтому прогон детерминирован.
+ * Метрики сравниваются раннером с `#!expect` трассы: ключи `*_us` — с допуском `tol_us`, прочие — точно.
+ */
+
+#define SIL_REPORT_MAX_METRICS (16u) /**< Максимум метрик сценария, [шт]. */
+
+/**
+ * @brief Метрики прогона сценария.
+ */
+typedef struct {
+  sil_expect_t metrics[SIL_REPORT_MAX_METRICS]; /**< Пары ключ/значение. */
+  uint32_t count; /**< Количество метрик, [шт]. */
+} sil_report_t;
+
+/**
+ * @brief Сценарий: прогнать трассу, записать выходную трассу и метрики.
+ * @param trace Входная трасса.
+ * @param out Выходная трасса CSV (может быть NULL).
+ * @param report Метрики (заполняются).
+ * @return true, если прогон выполнен (PASS/FAIL решает сравнение метрик).
+ */
+typedef bool (*sil_scenario_fn_t)(const sil_trace_t *trace, FILE *out, sil_report_t *report);
+
+/**
+ * @brief Записать метрику.
+ * @param report Метрики.
+ * @param key Имя метрики.
+ * @param value Значение.
+ * @return None.
+ */
+void sil_report_set(sil_report_t *report, const char *key, int64_t value);
+
+/**
+ * @brief Сценарий `comms_timeout`: поток `CMD_WELD` 4 кГц с пропусками → tk_cmd_rx + tk_cmd_timeout + control_core.
+ * @param trace Входная трасса.
+ * @param out Выходная трасса CSV (может быть NULL).
+ * @param report Метрики.
+ * @return true, если прогон выполнен.
+ */
+bool sil_scenario_comms_timeout(const sil_trace_t *trace, FILE *out, sil_report_t *report);
+
+/**
+ * @brief Сценарий `gain_sched`: R-L нагрузка, PI с фиксированными коэффициентами vs control_adapt + gain schedule.
+ * @param trace Входная трасса.
+ * @param out Выходная трасса CSV (может быть NULL).
+ * @param report Метрики.
+ * @return true, если прогон выполнен.
+ */
+bool sil_scenario_gain_sched(const sil_trace_t *trace, FILE *out, sil_report_t *report);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIL_SCENARIOS_H */
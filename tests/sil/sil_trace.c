@@ -0,0 +1,112 @@
+#include "sil_trace.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SIL_TRACE_LINE_LEN (256u) /**< Максимальная длина строки трассы, [байт]. */
+
+/**
+ * @brief Разобрать директиву `#!...`.
+ * @param line Строка после `#!`.
+ * @param trace Трасса.
+ * @return true, если директива распознана и сохранена.
+ */
+static bool sil_trace_parse_directive(const char *line, sil_trace_t *trace)
+{
+  char key[SIL_TRACE_NAME_LEN];
+  long long value = 0;
+
+  if (sscanf(line, "scenario %31s", trace->scenario) == 1)
+  {
+    return true;
+  }
+  if (sscanf(line, "expect %31[^=]=%lld", key, &value) == 2)
+  {
+    if (trace->expect_count >= SIL_TRACE_MAX_EXPECT)
+    {
+      return false;
+    }
+    sil_expect_t *exp = &trace->expects[trace->expect_count++];
+    (void)snprintf(exp->key, sizeof(exp->key), "%s", key);
+    exp->value = (int64_t)value;
+    return true;
+  }
+  return false;
+}
+
+bool sil_trace_load(const char *path, sil_trace_t *trace)
+{
+  FILE *file = fopen(path, "r");
+  if (file == NULL)
+  {
+    (void)fprintf(stderr, "SIL: cannot open trace %s\n", path);
+    return false;
+  }
+
+  memset(trace, 0, sizeof(*trace));
+  char line[SIL_TRACE_LINE_LEN];
+  uint32_t line_no = 0u;
+  bool ok = true;
+
+  while (ok && (fgets(line, sizeof(line), file) != NULL))
+  {
+    line_no++;
+    line[strcspn(line, "\r\n")] = '\0';
+    if ((line[0] == '\0') || (strncmp(line, "t_us,", 5u) == 0))
+    {
+      continue;
+    }
+    if (strncmp(line, "#!", 2u) == 0)
+    {
+      ok = sil_trace_parse_directive(&line[2], trace);
+      continue;
+    }
+    if (line[0] == '#')
+    {
+      continue;
+    }
+
+    unsigned long t_us = 0u;
+    long arg0 = 0;
+    long arg1 = 0;
+    char name[SIL_TRACE_NAME_LEN];
+    if ((sscanf(line, "%lu,%31[^,],%ld,%ld", &t_us, name, &arg0, &arg1) != 4) ||
+        (trace->event_count >= SIL_TRACE_MAX_EVENTS))
+    {
+      ok = false;
+      continue;
+    }
+    sil_event_t *evt = &trace->events[trace->event_count];
+    if ((trace->event_count > 0u) && ((uint32_t)t_us < trace->events[trace->event_count - 1u].t_us))
+    {
+      ok = false;
+      continue;
+    }
+    evt->t_us = (uint32_t)t_us;
+    (void)snprintf(evt->name, sizeof(evt->name), "%s", name);
+    evt->arg0 = (int32_t)arg0;
+    evt->arg1 = (int32_t)arg1;
+    trace->event_count++;
+  }
+  (void)fclose(file);
+
+  if (!ok)
+  {
+    (void)fprintf(stderr, "SIL: %s:%u: malformed trace line\n", path, line_no);
+  }
+  return ok && (trace->scenario[0] != '\0');
+}
+
+bool sil_trace_expect(const sil_trace_t *trace, const char *key, int64_t *value)
+{
+  for (uint32_t i = 0u; i < trace->expect_count; ++i)
+  {
+    if (strcmp(trace->expects[i].key, key) == 0)
+    {
+      *value = trace->expects[i].value;
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,75 @@
+#ifndef SIL_TRACE_H
+#define SIL_TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file sil_trace.h
+ * @brief Входная трасса L2 SIL: директивы сценария/ожиданий + события во времени.
+ * @details
+ * Формат (CSV, UTF-8, `#` — комментарий):
+ * - `#!scenario <name>` — сценарий (см. sil_scenarios.h);
+ * - `#!expect <key>=<value>` — ожидаемая метрика (целое; времена в мкс, -1 = "не должно случиться");
+ * - `t_us,event,arg0,arg1` — событие; строки упорядочены по времени.
+ */
+
+#define SIL_TRACE_MAX_EVENTS (256u) /**< Максимум событий в трассе, [шт]. */
+#define SIL_TRACE_MAX_EXPECT (16u) /**< Максимум ожиданий, [шт]. */
+#define SIL_TRACE_NAME_LEN (32u) /**< Длина имени события/ключа (с '\0'), [байт]. */
+
+/**
+ * @brief Событие трассы.
+ */
+typedef struct {
+  uint32_t t_us; /**< Время события от начала трассы, [мкс]. */
+  char name[SIL_TRACE_NAME_LEN]; /**< Имя события. */
+  int32_t arg0; /**< Аргумент 0 (единицы — по событию). */
+  int32_t arg1; /**< Аргумент 1 (единицы — по событию). */
+} sil_event_t;
+
+/**
+ * @brief Ожидаемая метрика.
+ */
+typedef struct {
+  char key[SIL_TRACE_NAME_LEN]; /**< Имя метрики. */
+  int64_t value; /**< Ожидаемое значение. */
+} sil_expect_t;
+
+/**
+ * @brief Загруженная трасса.
+ */
+typedef struct {
+  char scenario[SIL_TRACE_NAME_LEN]; /**< Имя сценария. */
+  sil_event_t events[SIL_TRACE_MAX_EVENTS]; /**< События, упорядоченные по t_us. */
+  uint32_t event_count; /**< Количество событий, [шт]. */
+  sil_expect_t expects[SIL_TRACE_MAX_EXPECT]; /**< Ожидания. */
+  uint32_t expect_count; /**< Количество ожиданий, [шт]. */
+} sil_trace_t;
+
+/**
+ * @brief Загрузить трассу из файла.
+ * @param path Путь к файлу.
+ * @param trace Трасса (заполняется).
+ * @return true, если файл прочитан и формат корректен (события упорядочены, лимиты не превышены).
+ */
+bool sil_trace_load(const char *path, sil_trace_t *trace);
+
+/**
+ * @brief Найти ожидание по ключу.
+ * @param trace Трасса.
+ * @param key Имя метрики.
+ * @param value Ожидаемое значение (заполняется при успехе).
+ * @return true, если ожидание задано.
+ */
+bool sil_trace_expect(const sil_trace_t *trace, const char *key, int64_t *value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIL_TRACE_H */
@@ -0,0 +1,177 @@
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "boot_seq.h"
+#include "test_runner.h"
+
+#define TEST_DT_US (100u) /**< Шаг симуляции времени, [мкс]. */
+#define TEST_T0_US (5000u) /**< Timebase в момент входа в main(), [мкс]. */
+
+enum {
+  TEST_SAFE_OUT = 0,
+  TEST_WDG = 1,
+  TEST_COMX = 2,
+  TEST_PSRAM = 3,
+  TEST_AD7606 = 4,
+  TEST_NVM = 5,
+  TEST_CALIB = 6,
+  TEST_N = 7
+};
+
+/**
+ * @brief Таблица старта проекта (как в boot_port): 2 критичных + 5 параллельных пунктов.
+ */
+static const boot_item_desc_t s_items[TEST_N] = {
+  {"safe_outputs", true, true, 0u, 0u},
+  {"watchdog", true, true, 0u, 0u},
+  {"comx", false, true, 0u, 3000000u},
+  {"psram", false, false, 0u, 100000u},
+  {"ad7606", false, true, 0u, 50000u},
+  {"nvm", false, true, 0u, 200000u},
+  {"calib", false, true, (1u << TEST_AD7606) | (1u << TEST_NVM), 10000u},
+};
+
+/**
+ * @brief Результат симуляции.
+ */
+typedef struct {
+  uint32_t first_noncritical_start_us; /**< Самый ранний старт некритичного пункта, [мкс]. */
+  uint32_t critical_end_us; /**< Конец последнего критичного пункта, [мкс]. */
+  uint32_t max_running; /**< Максимум одновременно выполняемых пунктов, [шт]. */
+} test_sim_t;
+
+/**
+ * @brief Симуляция supervisor + task пунктов: шаг времени, завершение пунктов по длительности, poll, запуск готовых.
+ * @param bs Контекст.
+ * @param dur_us Длительности пунктов, [мкс].
+ * @param fail_mask Пункты, завершающиеся ошибкой, [битовая маска].
+ * @param t_max_us Предел симуляции, [мкс].
+ * @return Результат.
+ */
+static test_sim_t test_run(boot_seq_t *bs, const uint32_t *dur_us, uint32_t fail_mask, uint32_t t_max_us)
+{
+  test_sim_t sim = {UINT32_MAX, 0u, 0u};
+  for (uint32_t t = 0u; t <= t_max_us; t += TEST_DT_US)
+  {
+    const uint32_t now = TEST_T0_US + t;
+    uint32_t running = 0u;
+    for (uint32_t i = 0u; i < TEST_N; ++i)
+    {
+      if ((atomic_load(&bs->state[i]) == BOOT_ITEM_RUNNING) && (t >= (bs->rec[i].t_start_us + dur_us[i])))
+      {
+        (void)boot_seq_end(bs, i, (fail_mask & (1u << i)) == 0u, now);
+        if (s_items[i].critical)
+        {
+          sim.critical_end_us = t;
+        }
+      }
+      running += (atomic_load(&bs->state[i]) == BOOT_ITEM_RUNNING) ? 1u : 0u;
+    }
+    sim.max_running = (running > sim.max_running) ? running : sim.max_running;
+    (void)boot_seq_poll(bs, now);
+    const uint32_t next = boot_seq_next(bs);
+    for (uint32_t i = 0u; i < TEST_N; ++i)
+    {
+      if (((next & (1u << i)) != 0u) && boot_seq_begin(bs, i, now) && !s_items[i].critical &&
+          (t < sim.first_noncritical_start_us))
+      {
+        sim.first_noncritical_start_us = t;
+      }
+    }
+  }
+  return sim;
+}
+
+/**
+ * @brief Тест: критичные пункты первыми (барьер), медленные — параллельно, READY = самый длинный путь, а не сумма.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_staged_parallel_ready(test_ctx_t *ctx)
+{
+  boot_seq_t bs;
+  test_expect_true(ctx, boot_seq_init(&bs, s_items, TEST_N, 0x04u, TEST_T0_US), "init");
+  test_expect_eq_u32(ctx, boot_seq_next(&bs), (1u << TEST_SAFE_OUT) | (1u << TEST_WDG), "critical first");
+
+  const uint32_t dur[TEST_N] = {100u, 100u, 1200000u, 30000u, 5000u, 40000u, 1000u};
+  const test_sim_t sim = test_run(&bs, dur, 1u << TEST_PSRAM, 2000000u);
+
+  test_expect_eq_u32(ctx, bs.phase, BOOT_PHASE_READY, "READY");
+  test_expect_true(ctx, sim.first_noncritical_start_us >= sim.critical_end_us, "barrier after critical items");
+  test_expect_true(ctx, bs.rec[TEST_CALIB].t_start_us >= bs.rec[TEST_NVM].t_end_us, "calib after NVM");
+  test_expect_true(ctx, bs.rec[TEST_CALIB].t_start_us >= bs.rec[TEST_AD7606].t_end_us, "calib after AD7606");
+  test_expect_true(ctx, sim.max_running >= 4u, "slow items run concurrently");
+  test_expect_true(ctx, bs.t_ready_us <= 1200000u + 1000u, "time-to-READY = longest chain");
+  test_expect_true(ctx, boot_seq_busy_sum_us(&bs) >= 1276000u, "sequential equivalent is longer");
+  test_expect_eq_u32(ctx, bs.degraded_mask, 1u << TEST_PSRAM, "optional PSRAM failure = degraded");
+  test_expect_eq_u32(ctx, bs.reset_cause, 0x04u, "reset cause kept");
+}
+
+/**
+ * @brief Тест: таймаут COMX ⇒ FAULT; поздний boot_seq_end() игнорируется; момент FAULT в профиле.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_timeout_fault(test_ctx_t *ctx)
+{
+  boot_seq_t bs;
+  (void)boot_seq_init(&bs, s_items, TEST_N, 0u, TEST_T0_US);
+  const uint32_t dur[TEST_N] = {100u, 100u, 4000000u, 30000u, 5000u, 40000u, 1000u};
+  (void)test_run(&bs, dur, 0u, 3500000u);
+
+  test_expect_eq_u32(ctx, bs.phase, BOOT_PHASE_FAULT, "FAULT");
+  test_expect_eq_u32(ctx, bs.fault_mask, 1u << TEST_COMX, "COMX in fault mask");
+  test_expect_eq_u32(ctx, atomic_load(&bs.state[TEST_COMX]), BOOT_ITEM_TIMEOUT, "COMX timeout");
+  test_expect_eq_u32(ctx, bs.rec[TEST_COMX].t_end_us - bs.rec[TEST_COMX].t_start_us, 3000000u, "timeout length");
+  test_expect_true(ctx, (bs.t_ready_us >= 3000000u) && (bs.t_ready_us <= 3000300u), "fault time");
+  test_expect_true(ctx, !boot_seq_end(&bs, TEST_COMX, true, TEST_T0_US + 4000000u), "late end ignored");
+  test_expect_eq_u32(ctx, bs.cnt_late_end, 1u, "late end counted");
+  test_expect_eq_u32(ctx, bs.rec[TEST_COMX].t_end_us - bs.rec[TEST_COMX].t_start_us, 3000000u,
+                     "late end keeps timeout time");
+  test_expect_eq_u32(ctx, boot_seq_next(&bs), 0u, "nothing starts after FAULT");
+}
+
+/**
+ * @brief Тест: ошибка NVM ⇒ зависимый пункт пропущен, FAULT; невалидные таблицы отклоняются.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_dep_failure_and_table(test_ctx_t *ctx)
+{
+  boot_seq_t bs;
+  (void)boot_seq_init(&bs, s_items, TEST_N, 0u, TEST_T0_US);
+  const uint32_t dur[TEST_N] = {100u, 100u, 10000u, 30000u, 5000u, 40000u, 1000u};
+  (void)test_run(&bs, dur, 1u << TEST_NVM, 100000u);
+  test_expect_eq_u32(ctx, bs.phase, BOOT_PHASE_FAULT, "FAULT");
+  test_expect_eq_u32(ctx, atomic_load(&bs.state[TEST_CALIB]), BOOT_ITEM_SKIPPED, "calib skipped");
+  test_expect_eq_u32(ctx, bs.fault_mask, (1u << TEST_NVM) | (1u << TEST_CALIB), "fault mask");
+
+  boot_seq_t crit;
+  (void)boot_seq_init(&crit, s_items, TEST_N, 0u, TEST_T0_US);
+  (void)test_run(&crit, dur, 1u << TEST_WDG, 1000u);
+  test_expect_eq_u32(ctx, crit.phase, BOOT_PHASE_FAULT, "critical failure ⇒ FAULT");
+  test_expect_eq_u32(ctx, atomic_load(&crit.state[TEST_COMX]), BOOT_ITEM_PENDING, "bring-up not started");
+
+  const boot_item_desc_t fwd[2] = {{"a", false, true, 1u << 1, 0u}, {"b", false, true, 0u, 0u}};
+  test_expect_true(ctx, !boot_seq_init(&bs, fwd, 2u, 0u, 0u), "forward dependency rejected");
+  const boot_item_desc_t mixed[2] = {{"a", false, true, 0u, 0u}, {"b", true, true, 1u << 0, 0u}};
+  test_expect_true(ctx, !boot_seq_init(&bs, mixed, 2u, 0u, 0u), "critical on non-critical rejected");
+  test_expect_eq_u32(ctx, boot_seq_next(&bs), 0u, "invalid table: nothing starts");
+}
+
+/**
+ * @brief Точка входа для L1 unit tests поэтапного старта.
+ * @param argc Количество аргументов командной строки, [шт].
+ * @param argv Массив аргументов командной строки.
+ * @return Код завершения (0 = OK).
+ */
+int main(int argc, char **argv)
+{
+  const test_case_t tests[] = {
+    {"staged_parallel_ready", test_staged_parallel_ready},
+    {"timeout_fault", test_timeout_fault},
+    {"dep_failure_and_table", test_dep_failure_and_table},
+  };
+
+  return test_main(argc, argv, tests, sizeof(tests) / sizeof(tests[0]));
+}
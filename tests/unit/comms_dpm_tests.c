@@ -0,0 +1,553 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "comms_dpm.h"
+#include "control_core.h"
+#include "test_runner.h"
+#include "tk_cmd_rx.h"
+#include "tk_pdo_codec.h"
+
+#define TEST_CYCLE_US (250u) /**< Период обмена EtherCAT, [мкс]. */
+#define TEST_BUDGET_US (50u) /**< Бюджет `IRQ → publish` в тестах, [мкс]. */
+
+/**
+ * @brief Fake DPM: окно COMX в RAM + модель поведения netX + симулированное время.
+ */
+typedef struct {
+  uint32_t rx[COMMS_DPM_IMAGE_MAX_WORDS]; /**< Входная область (пишет "COMX"), [слова]. */
+  uint32_t tx[COMMS_DPM_IMAGE_MAX_WORDS]; /**< Выходная область (пишет MCU), [слова]. */
+  uint32_t netx; /**< Флаги netX → host, [битовая маска]. */
+  uint32_t host; /**< Флаги host → netX, [битовая маска]. */
+  uint32_t t_us; /**< Симулированное время, [мкс]. */
+  uint32_t copy_delay_us; /**< Инжектированная длительность копирования по FMC, [мкс]. */
+  uint32_t now_calls; /**< Количество вызовов now_us, [шт]. */
+  uint32_t torn_at_call; /**< Номер вызова now_us, на котором "COMX" пишет образ без handshake (0 = нет), [шт]. */
+} test_fake_dpm_t;
+
+/**
+ * @brief Timebase fake DPM: после каждого отсчёта время сдвигается на copy_delay_us (длительность копии по FMC).
+ * @param user Указатель на test_fake_dpm_t.
+ * @return Текущее время, [мкс].
+ */
+static uint32_t test_fake_now_us(void *user)
+{
+  test_fake_dpm_t *fake = (test_fake_dpm_t *)user;
+  fake->now_calls++;
+  if ((fake->torn_at_call != 0u) && (fake->now_calls == fake->torn_at_call))
+  {
+    /* Нарушение протокола: COMX перезаписывает область, пока она принадлежит host. */
+    fake->rx[0] ^= 0xA5A5A5A5u;
+    fake->netx ^= COMMS_DPM_NETX_PD_IN_TOGGLE;
+  }
+  const uint32_t now_us = fake->t_us;
+  fake->t_us += fake->copy_delay_us;
+  return now_us;
+}
+
+/**
+ * @brief Инициализировать fake DPM и ядро DPM над ним.
+ * @param fake Fake DPM.
+ * @param dpm Контекст ядра DPM.
+ * @return None.
+ */
+static void test_fake_init(test_fake_dpm_t *fake, comms_dpm_t *dpm)
+{
+  const test_fake_dpm_t zero = {0};
+  *fake = zero;
+
+  const comms_dpm_io_t io = {
+    .rx_area = fake->rx,
+    .tx_area = fake->tx,
+    .netx_flags = &fake->netx,
+    .host_flags = &fake->host,
+    .now_us = test_fake_now_us,
+    .user = fake
+  };
+  const comms_dpm_cfg_t cfg = {
+    .rx_words = TK_PDO_CMD_WELD_SIZE_WORDS,
+    .tx_words = TK_PDO_FB_STATUS_SIZE_WORDS,
+    .ready_timeout_us = 100000u,
+    .latency_budget_us = TEST_BUDGET_US
+  };
+  (void)comms_dpm_init(dpm, &io, &cfg);
+}
+
+/**
+ * @brief Поднять связь: COMX READY+COMM_RUN, один service → OPERATIONAL.
+ * @param fake Fake DPM.
+ * @param dpm Контекст ядра DPM.
+ * @return Событие последнего service.
+ */
+static comms_dpm_event_t test_fake_link_up(test_fake_dpm_t *fake, comms_dpm_t *dpm)
+{
+  (void)comms_dpm_service(dpm);
+  fake->netx |= COMMS_DPM_NETX_READY | COMMS_DPM_NETX_COMM_RUN;
+  return comms_dpm_service(dpm);
+}
+
+/**
+ * @brief "COMX" записывает новый входной образ (по правилам handshake).
+ * @param fake Fake DPM.
+ * @param words Образ, [слова].
+ * @param count Количество слов, [шт].
+ * @return true, если область была свободна и образ записан.
+ */
+static bool test_comx_push(test_fake_dpm_t *fake, const uint32_t *words, uint32_t count)
+{
+  const bool toggle = (fake->netx & COMMS_DPM_NETX_PD_IN_TOGGLE) != 0u;
+  const bool ack = (fake->host & COMMS_DPM_HOST_PD_IN_ACK) != 0u;
+  if (toggle != ack)
+  {
+    return false;
+  }
+  for (uint32_t i = 0u; i < count; ++i)
+  {
+    fake->rx[i] = words[i];
+  }
+  fake->netx ^= COMMS_DPM_NETX_PD_IN_TOGGLE;
+  return true;
+}
+
+/**
+ * @brief "COMX" забирает выходной образ, если host его передал.
+ * @param fake Fake DPM.
+ * @return true, если образ был забран.
+ */
+static bool test_comx_take(test_fake_dpm_t *fake)
+{
+  const bool toggle = (fake->host & COMMS_DPM_HOST_PD_OUT_TOGGLE) != 0u;
+  const bool ack = (fake->netx & COMMS_DPM_NETX_PD_OUT_ACK) != 0u;
+  if (toggle == ack)
+  {
+    return false;
+  }
+  fake->netx ^= COMMS_DPM_NETX_PD_OUT_ACK;
+  return true;
+}
+
+/**
+ * @brief Тест: невалидная конфигурация отклоняется, ядро остаётся в ERROR.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_init_rejects_invalid_cfg(test_ctx_t *ctx)
+{
+  test_fake_dpm_t fake = {0};
+  comms_dpm_t dpm;
+  const comms_dpm_io_t io = {
+    .rx_area = fake.rx,
+    .tx_area = fake.tx,
+    .netx_flags = &fake.netx,
+    .host_flags = &fake.host,
+    .now_us = test_fake_now_us,
+    .user = &fake
+  };
+  const comms_dpm_cfg_t cfg = {
+    .rx_words = COMMS_DPM_IMAGE_MAX_WORDS + 1u,
+    .tx_words = 4u,
+    .ready_timeout_us = 1000u,
+    .latency_budget_us = 50u
+  };
+  test_expect_true(ctx, !comms_dpm_init(&dpm, &io, &cfg), "oversized image rejected");
+  test_expect_eq_u32(ctx, dpm.state, COMMS_DPM_STATE_ERROR, "invalid cfg -> ERROR");
+  test_expect_eq_u32(ctx, comms_dpm_service(&dpm), COMMS_DPM_EVT_NONE, "ERROR: service is a no-op");
+}
+
+/**
+ * @brief Тест: HOST_READY, таймаут готовности COMX и восстановление через restart.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_ready_timeout_and_restart(test_ctx_t *ctx)
+{
+  test_fake_dpm_t fake;
+  comms_dpm_t dpm;
+  test_fake_init(&fake, &dpm);
+
+  test_expect_eq_u32(ctx, fake.host, 0u, "OFFLINE: host flags cleared");
+  test_expect_eq_u32(ctx, comms_dpm_service(&dpm), COMMS_DPM_EVT_NONE, "no COMX yet");
+  test_expect_eq_u32(ctx, dpm.state, COMMS_DPM_STATE_WAIT_READY, "WAIT_READY after first service");
+  test_expect_eq_u32(ctx, fake.host & COMMS_DPM_HOST_READY, COMMS_DPM_HOST_READY, "HOST_READY announced");
+
+  fake.t_us += 99999u;
+  test_expect_eq_u32(ctx, comms_dpm_service(&dpm), COMMS_DPM_EVT_NONE, "before timeout");
+  fake.t_us += 1u;
+  test_expect_eq_u32(ctx, comms_dpm_service(&dpm), COMMS_DPM_EVT_ERROR, "ready timeout");
+  test_expect_eq_u32(ctx, dpm.state, COMMS_DPM_STATE_ERROR, "ERROR latched");
+
+  fake.netx = COMMS_DPM_NETX_READY | COMMS_DPM_NETX_COMM_RUN;
+  test_expect_eq_u32(ctx, comms_dpm_service(&dpm), COMMS_DPM_EVT_NONE, "ERROR needs restart");
+
+  comms_dpm_restart(&dpm);
+  test_expect_eq_u32(ctx, comms_dpm_service(&dpm), COMMS_DPM_EVT_LINK_UP, "link up right after restart");
+}
+
+/**
+ * @brief Тест: netX READY без COMM_RUN (мастер не в OP, в т.ч. после потери линка) — ожидание без таймаута;
+ * ERROR только по отсутствию NETX_READY дольше таймаута.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_master_late_to_op(test_ctx_t *ctx)
+{
+  test_fake_dpm_t fake;
+  comms_dpm_t dpm;
+  test_fake_init(&fake, &dpm);
+
+  (void)comms_dpm_service(&dpm);
+  fake.netx = COMMS_DPM_NETX_READY;
+  for (uint32_t i = 0u; i < 10u; ++i)
+  {
+    fake.t_us += 100000u;
+    test_expect_eq_u32(ctx, comms_dpm_service(&dpm), COMMS_DPM_EVT_NONE, "READY without OP: keep waiting");
+  }
+  test_expect_eq_u32(ctx, dpm.state, COMMS_DPM_STATE_WAIT_READY, "no ERROR while netX is READY");
+
+  fake.netx |= COMMS_DPM_NETX_COMM_RUN;
+  test_expect_eq_u32(ctx, comms_dpm_service(&dpm), COMMS_DPM_EVT_LINK_UP, "master reaches OP late");
+
+  fake.netx &= ~(uint32_t)COMMS_DPM_NETX_COMM_RUN;
+  test_expect_eq_u32(ctx, comms_dpm_service(&dpm), COMMS_DPM_EVT_LINK_DOWN, "master leaves OP");
+  fake.t_us += 1000000u;
+  test_expect_eq_u32(ctx, comms_dpm_service(&dpm), COMMS_DPM_EVT_NONE, "long link outage: still waiting");
+  test_expect_eq_u32(ctx, dpm.state, COMMS_DPM_STATE_WAIT_READY, "link outage is not ERROR");
+
+  fake.netx = 0u;
+  fake.t_us += 99999u;
+  test_expect_eq_u32(ctx, comms_dpm_service(&dpm), COMMS_DPM_EVT_NONE, "timeout counts from last READY");
+  fake.t_us += 1u;
+  test_expect_eq_u32(ctx, comms_dpm_service(&dpm), COMMS_DPM_EVT_ERROR, "netX gone: ERROR");
+}
+
+/**
+ * @brief Тест: цикл 4 кГц — каждый образ публикуется один раз, выход передаётся COMX.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_cyclic_exchange(test_ctx_t *ctx)
+{
+  test_fake_dpm_t fake;
+  comms_dpm_t dpm;
+  test_fake_init(&fake, &dpm);
+  test_expect_eq_u32(ctx, test_fake_link_up(&fake, &dpm), COMMS_DPM_EVT_LINK_UP, "link up");
+
+  bool ok = true;
+  for (uint32_t cycle = 1u; cycle <= 4000u; ++cycle)
+  {
+    const uint32_t img[4] = {cycle, ~cycle, cycle * 3u, 0u};
+    fake.t_us += TEST_CYCLE_US;
+    ok = ok && test_comx_push(&fake, img, 4u);
+    comms_dpm_irq_mark(&dpm, fake.t_us);
+    fake.t_us += 10u;
+    ok = ok && (comms_dpm_service(&dpm) == COMMS_DPM_EVT_RX_NEW);
+
+    uint32_t gen = 0u;
+    const uint32_t *rx = comms_dpm_rx_image(&dpm, &gen);
+    ok = ok && (gen == cycle) && (rx[0] == cycle) && (rx[1] == ~cycle) && (rx[2] == cycle * 3u);
+
+    uint32_t tx[TK_PDO_FB_STATUS_SIZE_WORDS] = {0};
+    tx[0] = cycle;
+    ok = ok && comms_dpm_tx_write(&dpm, tx);
+    ok = ok && (fake.tx[0] == cycle) && test_comx_take(&fake);
+  }
+
+  test_expect_true(ctx, ok, "every image published once and every output handed over");
+  test_expect_eq_u32(ctx, dpm.stats.cnt_rx_new, 4000u, "cnt_rx_new");
+  test_expect_eq_u32(ctx, dpm.stats.cnt_tx_written, 4000u, "cnt_tx_written");
+  test_expect_eq_u32(ctx, dpm.stats.last_latency_us, 10u, "latency IRQ -> publish");
+  test_expect_eq_u32(ctx, dpm.stats.cnt_budget_overrun, 0u, "no budget overrun");
+  test_expect_eq_u32(ctx, dpm.stats.cnt_rx_torn, 0u, "no torn frames");
+}
+
+/**
+ * @brief Тест: инжектированные задержки task и копирования учитываются в бюджете латентности.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_latency_budget_with_injected_delays(test_ctx_t *ctx)
+{
+  test_fake_dpm_t fake;
+  comms_dpm_t dpm;
+  test_fake_init(&fake, &dpm);
+  (void)test_fake_link_up(&fake, &dpm);
+
+  const uint32_t task_delay_us[6] = {5u, 20u, 45u, 60u, 30u, 120u};
+  const uint32_t img[4] = {1u, 2u, 3u, 4u};
+  for (uint32_t i = 0u; i < 6u; ++i)
+  {
+    fake.t_us += TEST_CYCLE_US;
+    (void)test_comx_push(&fake, img, 4u);
+    comms_dpm_irq_mark(&dpm, fake.t_us);
+    fake.t_us += task_delay_us[i];
+    (void)comms_dpm_service(&dpm);
+  }
+  test_expect_eq_u32(ctx, dpm.stats.max_latency_us, 120u, "max latency tracked");
+  test_expect_eq_u32(ctx, dpm.stats.cnt_budget_overrun, 2u, "two cycles above budget");
+
+  /* Медленная FMC: копия занимает 40 мкс, задержка task 20 мкс => 60 мкс > бюджета. */
+  fake.t_us += TEST_CYCLE_US;
+  (void)test_comx_push(&fake, img, 4u);
+  comms_dpm_irq_mark(&dpm, fake.t_us);
+  fake.t_us += 20u;
+  fake.copy_delay_us = 40u;
+  fake.now_calls = 0u;
+  (void)comms_dpm_service(&dpm);
+  fake.copy_delay_us = 0u;
+  test_expect_eq_u32(ctx, fake.now_calls, 2u, "service samples time before and after copy");
+  test_expect_eq_u32(ctx, dpm.stats.last_copy_us, 40u, "copy duration measured");
+  test_expect_eq_u32(ctx, dpm.stats.last_latency_us, 60u, "latency includes copy");
+  test_expect_eq_u32(ctx, dpm.stats.cnt_budget_overrun, 3u, "slow FMC copy counted as overrun");
+
+  comms_dpm_reset_stats(&dpm);
+  test_expect_eq_u32(ctx, dpm.stats.max_latency_us, 0u, "stats reset");
+
+  /* Повторный notify без нового образа: латентность не учитывается. */
+  comms_dpm_irq_mark(&dpm, fake.t_us);
+  fake.t_us += 500u;
+  test_expect_eq_u32(ctx, comms_dpm_service(&dpm), COMMS_DPM_EVT_NONE, "spurious IRQ");
+  test_expect_eq_u32(ctx, dpm.stats.cnt_budget_overrun, 0u, "spurious IRQ not counted as overrun");
+  test_expect_eq_u32(ctx, dpm.stats.cnt_no_update, 1u, "cnt_no_update");
+}
+
+/**
+ * @brief Тест: stale-данные (COMX в OP, но toggle не меняется) — образ не переопубликуется, возраст растёт.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_stale_data(test_ctx_t *ctx)
+{
+  test_fake_dpm_t fake;
+  comms_dpm_t dpm;
+  test_fake_init(&fake, &dpm);
+  (void)test_fake_link_up(&fake, &dpm);
+  test_expect_eq_u32(ctx, comms_dpm_rx_age_us(&dpm, fake.t_us), UINT32_MAX, "no image yet");
+
+  const uint32_t img[4] = {7u, 7u, 7u, 7u};
+  fake.t_us += TEST_CYCLE_US;
+  (void)test_comx_push(&fake, img, 4u);
+  test_expect_eq_u32(ctx, comms_dpm_service(&dpm), COMMS_DPM_EVT_RX_NEW, "first image");
+
+  /* COMX перестаёт обновлять образ, а область продолжает меняться "мусором" без toggle. */
+  for (uint32_t i = 0u; i < 40u; ++i)
+  {
+    fake.t_us += TEST_CYCLE_US;
+    fake.rx[0] = 0xDEAD0000u + i;
+    comms_dpm_irq_mark(&dpm, fake.t_us);
+    (void)comms_dpm_service(&dpm);
+  }
+
+  uint32_t gen = 0u;
+  const uint32_t *rx = comms_dpm_rx_image(&dpm, &gen);
+  test_expect_eq_u32(ctx, gen, 1u, "generation frozen on stale data");
+  test_expect_eq_u32(ctx, rx[0], 7u, "stale area never republished");
+  test_expect_eq_u32(ctx, dpm.stats.cnt_no_update, 40u, "cnt_no_update");
+  test_expect_eq_u32(ctx, comms_dpm_rx_age_us(&dpm, fake.t_us), 40u * TEST_CYCLE_US, "image age grows");
+}
+
+/**
+ * @brief Тест: COMX пишет образ во время копирования — кадр отбрасывается, публикация остаётся прежней.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_torn_snapshot_dropped(test_ctx_t *ctx)
+{
+  test_fake_dpm_t fake;
+  comms_dpm_t dpm;
+  test_fake_init(&fake, &dpm);
+  (void)test_fake_link_up(&fake, &dpm);
+
+  const uint32_t img_a[4] = {0x11u, 0x12u, 0x13u, 0x14u};
+  (void)test_comx_push(&fake, img_a, 4u);
+  test_expect_eq_u32(ctx, comms_dpm_service(&dpm), COMMS_DPM_EVT_RX_NEW, "image A");
+
+  const uint32_t img_b[4] = {0x21u, 0x22u, 0x23u, 0x24u};
+  (void)test_comx_push(&fake, img_b, 4u);
+  fake.now_calls = 0u;
+  fake.torn_at_call = 2u;
+  test_expect_eq_u32(ctx, comms_dpm_service(&dpm), COMMS_DPM_EVT_RX_TORN, "torn copy detected");
+  fake.torn_at_call = 0u;
+
+  const uint32_t *rx = comms_dpm_rx_image(&dpm, NULL);
+  test_expect_eq_u32(ctx, rx[0], 0x11u, "previous image stays published");
+  test_expect_eq_u32(ctx, dpm.stats.cnt_rx_torn, 1u, "cnt_rx_torn");
+
+  /* Следующий корректный образ после нарушения публикуется. */
+  const uint32_t img_c[4] = {0x31u, 0x32u, 0x33u, 0x34u};
+  (void)test_comx_push(&fake, img_c, 4u);
+  test_expect_eq_u32(ctx, comms_dpm_service(&dpm), COMMS_DPM_EVT_RX_NEW, "recovered");
+  rx = comms_dpm_rx_image(&dpm, NULL);
+  test_expect_eq_u32(ctx, rx[0], 0x31u, "fresh image published");
+}
+
+/**
+ * @brief Тест: двойной буфер — ранее полученный указатель не меняется после следующей публикации.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_double_buffer_reader(test_ctx_t *ctx)
+{
+  test_fake_dpm_t fake;
+  comms_dpm_t dpm;
+  test_fake_init(&fake, &dpm);
+  (void)test_fake_link_up(&fake, &dpm);
+
+  const uint32_t img_a[4] = {0xAAu, 0u, 0u, 0u};
+  const uint32_t img_b[4] = {0xBBu, 0u, 0u, 0u};
+  (void)test_comx_push(&fake, img_a, 4u);
+  (void)comms_dpm_service(&dpm);
+  const uint32_t *reader = comms_dpm_rx_image(&dpm, NULL);
+
+  (void)test_comx_push(&fake, img_b, 4u);
+  (void)comms_dpm_service(&dpm);
+  test_expect_eq_u32(ctx, reader[0], 0xAAu, "reader's buffer untouched by next copy");
+  test_expect_eq_u32(ctx, comms_dpm_rx_image(&dpm, NULL)[0], 0xBBu, "new image in other buffer");
+}
+
+/**
+ * @brief Тест: выход не пишется, пока COMX не забрал предыдущий; потеря COMM_RUN и повторный LINK_UP.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_tx_busy_and_link_down(test_ctx_t *ctx)
+{
+  test_fake_dpm_t fake;
+  comms_dpm_t dpm;
+  test_fake_init(&fake, &dpm);
+
+  uint32_t tx[TK_PDO_FB_STATUS_SIZE_WORDS] = {0};
+  test_expect_true(ctx, !comms_dpm_tx_write(&dpm, tx), "no TX before link up");
+  (void)test_fake_link_up(&fake, &dpm);
+
+  tx[0] = 1u;
+  test_expect_true(ctx, comms_dpm_tx_write(&dpm, tx), "first output written");
+  tx[0] = 2u;
+  test_expect_true(ctx, !comms_dpm_tx_write(&dpm, tx), "busy until COMX takes it");
+  test_expect_eq_u32(ctx, fake.tx[0], 1u, "area owned by COMX not overwritten");
+  test_expect_eq_u32(ctx, dpm.stats.cnt_tx_busy, 1u, "cnt_tx_busy");
+  (void)test_comx_take(&fake);
+  test_expect_true(ctx, comms_dpm_tx_write(&dpm, tx), "written after take");
+
+  /* COMX выходит из OP, за время простоя "накапливается" не подтверждённый входной образ. */
+  fake.netx &= ~(uint32_t)COMMS_DPM_NETX_COMM_RUN;
+  test_expect_eq_u32(ctx, comms_dpm_service(&dpm), COMMS_DPM_EVT_LINK_DOWN, "link down");
+  test_expect_eq_u32(ctx, dpm.state, COMMS_DPM_STATE_WAIT_READY, "back to WAIT_READY");
+  fake.netx ^= COMMS_DPM_NETX_PD_IN_TOGGLE;
+
+  fake.netx |= COMMS_DPM_NETX_COMM_RUN;
+  test_expect_eq_u32(ctx, comms_dpm_service(&dpm), COMMS_DPM_EVT_LINK_UP, "link up again");
+  test_expect_eq_u32(ctx, comms_dpm_service(&dpm), COMMS_DPM_EVT_NONE, "pre-link image not consumed");
+  test_expect_eq_u32(ctx, dpm.stats.cnt_link_down, 1u, "cnt_link_down");
+}
+
+/**
+ * @brief Тест: сквозной путь DPM → tk_pdo_codec → tk_cmd_rx → control_core и FB_STATUS обратно.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_end_to_end_cmd_weld(test_ctx_t *ctx)
+{
+  test_fake_dpm_t fake;
+  comms_dpm_t dpm;
+  test_fake_init(&fake, &dpm);
+  (void)test_fake_link_up(&fake, &dpm);
+
+  const control_cfg_t ctrl_cfg = {
+    .kp = 1.0f,
+    .ki = 0.0f,
+    .dt = 0.001f,
+    .u_min = -1.0e9f,
+    .u_max = 1.0e9f,
+    .i_ref_min = 0.0f,
+    .i_ref_max = 50000.0f,
+    .di_dt_max = 0.0f,
+    .integrator_policy = CONTROL_INTEGRATOR_RESET
+  };
+  control_ctx_t ctrl;
+  control_init(&ctrl, &ctrl_cfg);
+  tk_cmd_rx_t rx;
+  tk_cmd_rx_init(&rx);
+
+  const tk_cmd_weld_t cmd = {
+    .seq = 42u,
+    .mode = TK_MODE_WELD,
+    .enable = 1u,
+    .i_ref_cmd_ma = 1500000,
+    .max_slew_rate_a_ms = 0u,
+    .fault_reset = 0u,
+    .must_be_zero = 0u
+  };
+  uint32_t img[TK_PDO_CMD_WELD_SIZE_WORDS];
+  tk_pdo_cmd_weld_pack(&cmd, img);
+  (void)test_comx_push(&fake, img, TK_PDO_CMD_WELD_SIZE_WORDS);
+  test_expect_eq_u32(ctx, comms_dpm_service(&dpm), COMMS_DPM_EVT_RX_NEW, "CMD_WELD received");
+
+  tk_cmd_weld_t decoded;
+  tk_pdo_cmd_weld_unpack(comms_dpm_rx_image(&dpm, NULL), &decoded);
+  test_expect_eq_u32(ctx, tk_cmd_rx_process(&rx, &decoded, false, &ctrl), TK_CMD_RX_APPLY, "applied");
+
+  const control_meas_t meas = {.i_meas = 0.0f, .u_meas = 0.0f, .udc = 0.0f, .meas_valid = true};
+  control_out_t out;
+  control_fast_step(&ctrl, &meas, true, &out);
+  test_expect_close(ctx, out.i_ref_used, 1500.0f, 1e-3f, "i_ref reaches control_core");
+
+  tk_fb_status_t fb = {0};
+  tk_cmd_rx_fill_status(&rx, &fb);
+  uint32_t tx[TK_PDO_FB_STATUS_SIZE_WORDS];
+  tk_pdo_fb_status_pack(&fb, tx);
+  test_expect_true(ctx, comms_dpm_tx_write(&dpm, tx), "FB_STATUS written");
+  test_expect_eq_u32(ctx, fake.tx[0] & 0xFFFFu, 42u, "seq_applied in FB_STATUS word 0");
+}
+
+/**
+ * @brief Тест: производительность service + копии образа (host-оценка, без учёта FMC).
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_service_throughput(test_ctx_t *ctx)
+{
+  test_fake_dpm_t fake;
+  comms_dpm_t dpm;
+  test_fake_init(&fake, &dpm);
+  (void)test_fake_link_up(&fake, &dpm);
+
+  const uint32_t cycles = 200000u;
+  const uint64_t t0 = test_now_ns();
+  uint32_t published = 0u;
+  for (uint32_t i = 0u; i < cycles; ++i)
+  {
+    fake.rx[0] = i;
+    fake.netx ^= COMMS_DPM_NETX_PD_IN_TOGGLE;
+    published += (uint32_t)(comms_dpm_service(&dpm) == COMMS_DPM_EVT_RX_NEW);
+  }
+  const uint64_t t1 = test_now_ns();
+  const double ns_per_cycle = (double)(t1 - t0) / (double)cycles; /* [нс] */
+  (void)printf("INFO: comms_dpm service cycle = %.1f ns\n", ns_per_cycle);
+
+  test_expect_eq_u32(ctx, published, cycles, "all images published");
+}
+
+/**
+ * @brief Точка входа для L1 unit tests ядра DPM.
+ * @param argc Количество аргументов командной строки, [шт].
+ * @param argv Массив аргументов командной строки.
+ * @return Код завершения (0 = OK).
+ */
+int main(int argc, char **argv)
+{
+  const test_case_t tests[] = {
+    {"init_rejects_invalid_cfg", test_init_rejects_invalid_cfg},
+    {"ready_timeout_and_restart", test_ready_timeout_and_restart},
+    {"master_late_to_op", test_master_late_to_op},
+    {"cyclic_exchange", test_cyclic_exchange},
+    {"latency_budget_with_injected_delays", test_latency_budget_with_injected_delays},
+    {"stale_data", test_stale_data},
+    {"torn_snapshot_dropped", test_torn_snapshot_dropped},
+    {"double_buffer_reader", test_double_buffer_reader},
+    {"tx_busy_and_link_down", test_tx_busy_and_link_down},
+    {"end_to_end_cmd_weld", test_end_to_end_cmd_weld},
+    {"service_throughput", test_service_throughput},
+  };
+
+  return test_main(argc, argv, tests, sizeof(tests) / sizeof(tests[0]));
+}
@@ -0,0 +1,224 @@
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "control_adapt.h"
+#include "test_runner.h"
+
+/**
+ * @brief Конфигурация: 1 кГц, i_scale = 10 кА, R ∈ [20..2000] мкОм, L ∈ [0.1..10] мкГн.
+ * @return Конфигурация.
+ */
+static control_adapt_cfg_t test_cfg(void)
+{
+  const control_adapt_cfg_t cfg = {
+    .dt = 1.0e-3f,
+    .lambda = 0.98f,
+    .p0 = 100.0f,
+    .i_scale = 10000.0f,
+    .i_min = 200.0f,
+    .r_init = 100e-6f,
+    .l_init = 1.0e-6f,
+    .r_min = 20e-6f,
+    .r_max = 2000e-6f,
+    .l_min = 0.1e-6f,
+    .l_max = 10e-6f,
+    .sched = {
+      {.r_ohm = 100e-6f, .kp = 1.0e-5f, .ki = 1.0e-3f},
+      {.r_ohm = 200e-6f, .kp = 2.0e-5f, .ki = 3.0e-3f},
+      {.r_ohm = 400e-6f, .kp = 4.0e-5f, .ki = 9.0e-3f},
+    },
+    .sched_count = 3u
+  };
+  return cfg;
+}
+
+/**
+ * @brief Прогнать оценщик на точной модели U = R·I + L·ΔI/T с переменным током.
+ * @param est Состояние.
+ * @param r_ohm Сопротивление, [Ом].
+ * @param l_h Индуктивность, [Гн].
+ * @param steps Количество периодов, [шт].
+ * @param seed Состояние ГПСЧ.
+ * @param out Выход последнего шага.
+ * @return None.
+ */
+static void test_run_plant(control_adapt_t *est, float r_ohm, float l_h, uint32_t steps, uint32_t *seed,
+                           control_adapt_out_t *out)
+{
+  float i_prev = est->i_prev; /* [A] */
+  for (uint32_t k = 0u; k < steps; ++k)
+  {
+    const float i = 5000.0f + (float)(test_rand_u32(seed) % 5000u); /* [A] */
+    const float u = (r_ohm * i) + ((l_h * (i - i_prev)) / 1.0e-3f); /* [В] */
+    control_adapt_step(est, i, u, out);
+    i_prev = i;
+  }
+}
+
+/**
+ * @brief Тест: RLS сходится к R и L нагрузки, отличной от начальной оценки.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_rls_converges(test_ctx_t *ctx)
+{
+  control_adapt_t est;
+  const control_adapt_cfg_t cfg = test_cfg();
+  test_expect_true(ctx, control_adapt_init(&est, &cfg), "init");
+
+  uint32_t seed = 12345u;
+  control_adapt_out_t out;
+  test_run_plant(&est, 350e-6f, 2.5e-6f, 200u, &seed, &out);
+  test_expect_close(ctx, out.r_est, 350e-6f, 350e-6f * 0.01f, "R converged");
+  test_expect_close(ctx, out.l_est, 2.5e-6f, 2.5e-6f * 0.02f, "L converged");
+  test_expect_close(ctx, out.gains.r_load, out.r_est, 0.0f, "R published for feedforward");
+  test_expect_true(ctx, out.updated, "updated");
+  test_expect_eq_u32(ctx, est.cnt_p_resets, 0u, "no P resets");
+}
+
+/**
+ * @brief Тест: с забыванием оценка отслеживает смену нагрузки; след P ограничен.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_rls_tracks_change(test_ctx_t *ctx)
+{
+  control_adapt_t est;
+  const control_adapt_cfg_t cfg = test_cfg();
+  (void)control_adapt_init(&est, &cfg);
+
+  uint32_t seed = 777u;
+  control_adapt_out_t out;
+  test_run_plant(&est, 100e-6f, 1.0e-6f, 200u, &seed, &out);
+  test_run_plant(&est, 500e-6f, 1.0e-6f, 300u, &seed, &out);
+  test_expect_close(ctx, out.r_est, 500e-6f, 500e-6f * 0.02f, "R tracked");
+  test_expect_true(ctx, (est.p[0][0] + est.p[1][1]) <= (2.0f * cfg.p0), "P trace bounded");
+}
+
+/**
+ * @brief Тест: без возбуждения (|I| < i_min) и при NaN оценка не меняется.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_no_excitation_no_update(test_ctx_t *ctx)
+{
+  control_adapt_t est;
+  const control_adapt_cfg_t cfg = test_cfg();
+  (void)control_adapt_init(&est, &cfg);
+
+  control_adapt_out_t out;
+  for (uint32_t k = 0u; k < 100u; ++k)
+  {
+    control_adapt_step(&est, 50.0f, 1.0f, &out);
+  }
+  control_adapt_step(&est, NAN, 1.0f, &out);
+  control_adapt_step(&est, 5000.0f, NAN, &out);
+  test_expect_eq_u32(ctx, est.cnt_updates, 0u, "no updates");
+  test_expect_close(ctx, out.r_est, cfg.r_init, 1e-9f, "R kept");
+  test_expect_true(ctx, !out.updated, "not updated");
+
+  /* После NaN пара I_{k-1}/I_k разорвана: первое валидное измерение тоже не обновляет. */
+  control_adapt_step(&est, 5000.0f, 0.5f, &out);
+  test_expect_true(ctx, !out.updated, "first sample after NaN skipped");
+  control_adapt_step(&est, 5000.0f, 0.5f, &out);
+  test_expect_true(ctx, out.updated, "second sample updates");
+}
+
+/**
+ * @brief Тест: после паузы без возбуждения P сбрасывается (warm start), θ сохраняется.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_warm_start_after_pause(test_ctx_t *ctx)
+{
+  control_adapt_t est;
+  const control_adapt_cfg_t cfg = test_cfg();
+  (void)control_adapt_init(&est, &cfg);
+
+  uint32_t seed = 4242u;
+  control_adapt_out_t out;
+  test_run_plant(&est, 300e-6f, 1.0e-6f, 100u, &seed, &out);
+  test_expect_eq_u32(ctx, est.cnt_warm_starts, 0u, "no warm start within a pulse");
+  const float r_before = out.r_est;
+
+  for (uint32_t k = 0u; k < 20u; ++k)
+  {
+    control_adapt_step(&est, 0.0f, 0.0f, &out);
+  }
+  test_expect_close(ctx, out.r_est, r_before, 1e-9f, "theta kept over pause");
+  control_adapt_step(&est, 5000.0f, 1.5f + (1.0e-6f * 5000.0f / 1.0e-3f), &out);
+  test_expect_eq_u32(ctx, est.cnt_warm_starts, 1u, "warm start on new pulse");
+  test_expect_true(ctx, out.updated, "updated on new pulse");
+}
+
+/**
+ * @brief Тест: оценка R ограничивается [r_min..r_max] при неправдоподобных данных.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_estimate_bounded(test_ctx_t *ctx)
+{
+  control_adapt_t est;
+  const control_adapt_cfg_t cfg = test_cfg();
+  (void)control_adapt_init(&est, &cfg);
+
+  control_adapt_out_t out;
+  for (uint32_t k = 0u; k < 200u; ++k)
+  {
+    control_adapt_step(&est, 1000.0f, 1000.0f, &out);
+  }
+  test_expect_close(ctx, out.r_est, cfg.r_max, cfg.r_max * 1e-5f, "R clamped to r_max");
+  test_expect_true(ctx, isfinite(out.l_est) && (out.l_est >= cfg.l_min) && (out.l_est <= cfg.l_max), "L in range");
+}
+
+/**
+ * @brief Тест: таблица расписания — интерполяция, насыщение на краях, NaN/пустая таблица.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_schedule_lookup(test_ctx_t *ctx)
+{
+  control_adapt_cfg_t cfg = test_cfg();
+
+  control_gains_t g = control_adapt_schedule(&cfg, 50e-6f);
+  test_expect_true(ctx, g.valid, "valid");
+  test_expect_close(ctx, g.kp, 1.0e-5f, 1e-12f, "low edge kp");
+
+  g = control_adapt_schedule(&cfg, 300e-6f);
+  test_expect_close(ctx, g.kp, 3.0e-5f, 1e-10f, "interp kp");
+  test_expect_close(ctx, g.ki, 6.0e-3f, 1e-8f, "interp ki");
+
+  g = control_adapt_schedule(&cfg, 1.0f);
+  test_expect_close(ctx, g.ki, 9.0e-3f, 1e-10f, "high edge ki");
+
+  g = control_adapt_schedule(&cfg, NAN);
+  test_expect_true(ctx, !g.valid, "NaN -> invalid");
+
+  cfg.sched[2].r_ohm = 150e-6f;
+  control_adapt_t est;
+  test_expect_true(ctx, !control_adapt_init(&est, &cfg), "non-monotonic table rejected");
+  control_adapt_out_t out;
+  control_adapt_step(&est, 5000.0f, 1.0f, &out);
+  test_expect_true(ctx, !out.gains.valid, "invalid cfg -> cfg gains");
+}
+
+/**
+ * @brief Точка входа для L1 unit tests оценщика R/L и gain schedule.
+ * @param argc Количество аргументов командной строки, [шт].
+ * @param argv Массив аргументов командной строки.
+ * @return Код завершения (0 = OK).
+ */
+int main(int argc, char **argv)
+{
+  const test_case_t tests[] = {
+    {"rls_converges", test_rls_converges},
+    {"rls_tracks_change", test_rls_tracks_change},
+    {"no_excitation_no_update", test_no_excitation_no_update},
+    {"warm_start_after_pause", test_warm_start_after_pause},
+    {"estimate_bounded", test_estimate_bounded},
+    {"schedule_lookup", test_schedule_lookup},
+  };
+
+  return test_main(argc, argv, tests, sizeof(tests) / sizeof(tests[0]));
+}
@@ -1,79 +1,10 @@
 #include <stdbool.h>
 #include <stdint.h>
-#include <stdio.h>
 #include <math.h>
-#include <string.h>
 
+#include "control_adapt.h"
 #include "control_core.h"
-
-/**
- * @brief Контекст простого тестового раннера.
- */
-typedef struct {
-  int failed; /**< Количество проваленных проверок, [шт]. */
-} test_ctx_t;
-
-/**
- * @brief Тип функции теста.
- */
-typedef void (*test_fn_t)(test_ctx_t *ctx);
-
-/**
- * @brief Описание одного теста.
- */
-typedef struct {
-  const char *name; /**< Имя теста (стабильный идентификатор), [строка]. */
-  test_fn_t fn;     /**< Указатель на функцию теста. */
-} test_case_t;
-
-/**
- * @brief Получить модуль числа.
- * @param value Входное значение, [отн. ед.].
- * @return Модуль значения, [отн. ед.].
- */
-static float test_abs_f(float value)
-{
-  return (value < 0.0f) ? -value : value;
-}
-
-/**
- * @brief Проверить булево условие.
- * @param ctx Контекст тестов.
- * @param condition Условие.
- * @param message Сообщение об ошибке.
- * @return None.
- */
-static void test_expect_true(test_ctx_t *ctx, bool condition, const char *message)
-{
-  if (!condition)
-  {
-    ctx->failed += 1;
-    (void)printf("FAIL: %s\n", message);
-  }
-}
-
-/**
- * @brief Проверить близость чисел с допуском.
- * @param ctx Контекст тестов.
- * @param actual Фактическое значение, [отн. ед.].
- * @param expected Ожидаемое значение, [отн. ед.].
- * @param tol Допуск, [отн. ед.].
- * @param message Сообщение об ошибке.
- * @return None.
- */
-static void test_expect_close(test_ctx_t *ctx,
-                              float actual,
-                              float expected,
-                              float tol,
-                              const char *message)
-{
-  const float diff = test_abs_f(actual - expected); /* [отн. ед.] */
-  if (diff > tol)
-  {
-    ctx->failed += 1;
-    (void)printf("FAIL: %s (actual=%.6f expected=%.6f tol=%.6f)\n", message, actual, expected, tol);
-  }
-}
+#include "test_runner.h"
 
 /**
  * @brief Тест: запрет управления сбрасывает интегратор.
@@ -559,65 +490,595 @@ static void test_anti_windup_holds_integrator(test_ctx_t *ctx)
 }
 
 /**
- * @brief Проверить, что имя теста совпадает с фильтром.
- * @param name Имя теста, [строка].
- * @param filter Фильтр (подстрока) или NULL, [строка].
- * @return true, если тест должен быть запущен.
+ * @brief Тест: динамический предел строже cfg зажимает u, источник и флаг публикуются; NULL снимает предел.
+ * @param ctx Контекст тестов.
+ * @return None.
  */
-static bool test_matches_filter(const char *name, const char *filter)
+static void test_dynamic_limits_clamp_and_source(test_ctx_t *ctx)
 {
-  if (filter == NULL)
+  /* Единицы полей см. control_cfg_t. */
+  const control_cfg_t cfg = {
+    .kp = 1.0f,
+    .ki = 0.0f,
+    .dt = 1.0f,
+    .u_min = 0.0f,
+    .u_max = 1.0f,
+    .i_ref_min = 0.0f,
+    .i_ref_max = 100.0f,
+    .di_dt_max = 0.0f,
+    .integrator_policy = CONTROL_INTEGRATOR_RESET
+  };
+
+  control_ctx_t ctrl;
+  control_init(&ctrl, &cfg);
+
+  /* Единицы полей см. control_cmd_t. */
+  const control_cmd_t cmd = {
+    .i_ref_cmd = 10.0f,
+    .enable_cmd = true,
+    .cmd_valid = true
+  };
+  control_slow_step(&ctrl, &cmd);
+
+  /* Единицы полей см. control_meas_t. */
+  const control_meas_t meas = {
+    .i_meas = 0.0f,
+    .u_meas = 0.0f,
+    .udc = 0.0f,
+    .meas_valid = true
+  };
+
+  control_limits_t limits;
+  control_limits_reset(&limits);
+  control_limits_tighten_max(&limits, 0.8f, CONTROL_LIMIT_SRC_THERMAL);
+  control_limits_tighten_max(&limits, 0.6f, CONTROL_LIMIT_SRC_VS);
+  control_limits_tighten_max(&limits, 0.9f, CONTROL_LIMIT_SRC_UDC);
+  control_limits_tighten_max(&limits, 0.6f, CONTROL_LIMIT_SRC_MANUAL_DUTY);
+  test_expect_eq_u32(ctx, limits.src_max, CONTROL_LIMIT_SRC_VS | CONTROL_LIMIT_SRC_MANUAL_DUTY,
+                     "tightest sources merged");
+  control_set_limits(&ctrl, &limits);
+
+  control_out_t out = {0};
+  control_fast_step(&ctrl, &meas, true, &out);
+  test_expect_close(ctx, out.u, 0.6f, 1e-6f, "u should clamp to dynamic u_max");
+  test_expect_true(ctx, (out.flags & CONTROL_FLAG_DYN_LIMIT) != 0u, "dyn limit flag should be set");
+  test_expect_true(ctx, (out.flags & CONTROL_FLAG_LIMIT_HI) != 0u, "limit_hi flag should be set");
+  test_expect_eq_u32(ctx, out.limit_src, CONTROL_LIMIT_SRC_VS | CONTROL_LIMIT_SRC_MANUAL_DUTY, "limit source");
+
+  /* Предел мягче cfg не расширяет диапазон. */
+  control_limits_reset(&limits);
+  control_limits_tighten_max(&limits, 5.0f, CONTROL_LIMIT_SRC_UDC);
+  control_set_limits(&ctrl, &limits);
+  control_fast_step(&ctrl, &meas, true, &out);
+  test_expect_close(ctx, out.u, 1.0f, 1e-6f, "cfg u_max still applies");
+  test_expect_true(ctx, (out.flags & CONTROL_FLAG_DYN_LIMIT) == 0u, "dyn flag clear when looser");
+  test_expect_eq_u32(ctx, out.limit_src, CONTROL_LIMIT_SRC_NONE, "cfg limit has no source");
+
+  /* Конфликт динамического u_min с cfg u_max: побеждает верхний предел. */
+  control_limits_reset(&limits);
+  control_limits_tighten_min(&limits, 1.5f, CONTROL_LIMIT_SRC_MANUAL_DUTY);
+  control_set_limits(&ctrl, &limits);
+  control_fast_step(&ctrl, &meas, true, &out);
+  test_expect_close(ctx, out.u, 1.0f, 1e-6f, "upper bound wins on conflict with cfg");
+
+  /* Динамические u_min > u_max и ±inf не в своём направлении: набор отвергается, управление запрещено. */
+  control_limits_reset(&limits);
+  control_limits_tighten_min(&limits, 0.7f, CONTROL_LIMIT_SRC_MANUAL_DUTY);
+  control_limits_tighten_max(&limits, 0.3f, CONTROL_LIMIT_SRC_VS);
+  control_set_limits(&ctrl, &limits);
+  control_fast_step(&ctrl, &meas, true, &out);
+  test_expect_close(ctx, out.u, 0.0f, 1e-6f, "u_min > u_max blocks control");
+  test_expect_true(ctx, (out.flags & CONTROL_FLAG_NUM_INVALID) != 0u, "u_min > u_max flagged");
+
+  control_limits_reset(&limits);
+  control_limits_tighten_max(&limits, -INFINITY, CONTROL_LIMIT_SRC_VS);
+  control_set_limits(&ctrl, &limits);
+  control_fast_step(&ctrl, &meas, true, &out);
+  test_expect_close(ctx, out.u, 0.0f, 1e-6f, "u_max = -inf blocks control");
+  test_expect_true(ctx, (out.flags & CONTROL_FLAG_NUM_INVALID) != 0u, "u_max = -inf flagged");
+
+  control_limits_reset(&limits);
+  control_limits_tighten_min(&limits, INFINITY, CONTROL_LIMIT_SRC_MANUAL_DUTY);
+  control_set_limits(&ctrl, &limits);
+  control_fast_step(&ctrl, &meas, true, &out);
+  test_expect_close(ctx, out.u, 0.0f, 1e-6f, "u_min = +inf blocks control");
+  test_expect_true(ctx, (out.flags & CONTROL_FLAG_NUM_INVALID) != 0u, "u_min = +inf flagged");
+
+  control_limits_reset(&limits);
+  control_set_limits(&ctrl, &limits);
+  control_fast_step(&ctrl, &meas, true, &out);
+  test_expect_close(ctx, out.u, 1.0f, 1e-6f, "reset limits (+-inf = none) are valid");
+  test_expect_true(ctx, (out.flags & CONTROL_FLAG_NUM_INVALID) == 0u, "reset limits not flagged");
+
+  control_set_limits(&ctrl, NULL);
+  control_fast_step(&ctrl, &meas, true, &out);
+  test_expect_close(ctx, out.u, 1.0f, 1e-6f, "NULL clears dynamic limits");
+}
+
+/**
+ * @brief Тест: anti-windup работает по более строгому динамическому пределу; NaN-предел запрещает управление.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_dynamic_limits_anti_windup(test_ctx_t *ctx)
+{
+  /* Единицы полей см. control_cfg_t. */
+  const control_cfg_t cfg = {
+    .kp = 0.0f,
+    .ki = 1.0f,
+    .dt = 0.1f,
+    .u_min = 0.0f,
+    .u_max = 1.0f,
+    .i_ref_min = 0.0f,
+    .i_ref_max = 100.0f,
+    .di_dt_max = 0.0f,
+    .integrator_policy = CONTROL_INTEGRATOR_RESET
+  };
+
+  control_ctx_t ctrl;
+  control_init(&ctrl, &cfg);
+
+  /* Единицы полей см. control_cmd_t. */
+  const control_cmd_t cmd = {
+    .i_ref_cmd = 10.0f,
+    .enable_cmd = true,
+    .cmd_valid = true
+  };
+  control_slow_step(&ctrl, &cmd);
+
+  /* Единицы полей см. control_meas_t. */
+  const control_meas_t meas = {
+    .i_meas = 0.0f,
+    .u_meas = 0.0f,
+    .udc = 0.0f,
+    .meas_valid = true
+  };
+
+  control_limits_t limits;
+  control_limits_reset(&limits);
+  control_limits_tighten_max(&limits, 0.25f, CONTROL_LIMIT_SRC_VS);
+  control_set_limits(&ctrl, &limits);
+
+  control_out_t out = {0};
+  for (uint32_t i = 0u; i < 50u; ++i)
   {
-    return true;
+    control_fast_step(&ctrl, &meas, true, &out);
   }
-  if (filter[0] == '\0')
+  test_expect_close(ctx, ctrl.state.integrator, 0.25f, 1e-6f, "integrator bounded by dynamic u_max");
+  test_expect_true(ctx, (out.flags & CONTROL_FLAG_WINDUP_BLOCK) != 0u, "windup block under dynamic limit");
+
+  control_limits_tighten_max(&limits, NAN, CONTROL_LIMIT_SRC_THERMAL);
+  control_set_limits(&ctrl, &limits);
+  control_fast_step(&ctrl, &meas, true, &out);
+  test_expect_close(ctx, out.u, 0.0f, 1e-6f, "NaN limit blocks control");
+  test_expect_true(ctx, (out.flags & CONTROL_FLAG_NUM_INVALID) != 0u, "NaN limit flagged");
+}
+
+/**
+ * @brief Прогнать PI(+FF) на модели нагрузки и вернуть число периодов до 90% уставки.
+ * @param ff_n_tr Коэффициент трансформации для feedforward (0 — без FF).
+ * @param r_est_out Выход: оценка R, применённая регулятором в конце прогона, [Ом].
+ * @return Периоды до |i - i_ref| < 10% (или 1000, если не достигнуто), [шаги].
+ * @details Оценка R — RLS control_adapt по `I_per`/`U_per`, публикуется каждый период через control_set_gains()
+ *          (таблица из одной точки: kp/ki совпадают с cfg, меняется только R для feedforward).
+ */
+static uint32_t test_ff_settle_steps(float ff_n_tr, float *r_est_out)
+{
+  /* Нагрузка: R = 100 мкОм, n = 50, Udc = 500 В ⇒ номинальная скважность для 10 кА = 0.1. */
+  const float r_load = 100e-6f; /* [Ом] */
+  const float n_tr = 50.0f; /* [-] */
+  const float udc = 500.0f; /* [В] */
+
+  /* Единицы полей см. control_cfg_t. */
+  const control_cfg_t cfg = {
+    .kp = 1.0e-6f,
+    .ki = 5.0e-3f,
+    .dt = 1.0e-3f,
+    .u_min = 0.0f,
+    .u_max = 1.0f,
+    .i_ref_min = 0.0f,
+    .i_ref_max = 20000.0f,
+    .di_dt_max = 0.0f,
+    .integrator_policy = CONTROL_INTEGRATOR_RESET,
+    .ff_n_tr = ff_n_tr,
+    .ff_udc_min = 100.0f,
+    .ff_u_max = 0.8f
+  };
+  /* Единицы полей см. control_adapt_cfg_t; априорная оценка R занижена вдвое. */
+  const control_adapt_cfg_t adapt_cfg = {
+    .dt = 1.0e-3f,
+    .lambda = 0.98f,
+    .p0 = 100.0f,
+    .i_scale = 10000.0f,
+    .i_min = 100.0f,
+    .r_init = 50e-6f,
+    .l_init = 0.0f,
+    .r_min = 10e-6f,
+    .r_max = 0.01f,
+    .l_min = 0.0f,
+    .l_max = 1e-6f,
+    .sched = {{100e-6f, 1.0e-6f, 5.0e-3f}},
+    .sched_count = 1u
+  };
+
+  control_ctx_t ctrl;
+  control_init(&ctrl, &cfg);
+  control_adapt_t adapt;
+  (void)control_adapt_init(&adapt, &adapt_cfg);
+
+  /* Предварительный импульс малого тока — "обучение" R_est (как первый импульс сварки). */
+  const control_cmd_t warm = {.i_ref_cmd = 1000.0f, .enable_cmd = true, .cmd_valid = true};
+  const control_cmd_t cmd = {.i_ref_cmd = 10000.0f, .enable_cmd = true, .cmd_valid = true};
+  control_out_t out = {0};
+  control_adapt_out_t adapt_out;
+  float i = 0.0f; /* [A] */
+  uint32_t settle = 1000u;
+
+  for (uint32_t k = 0u; k < 1200u; ++k)
   {
-    return true;
+    control_slow_step(&ctrl, (k < 200u) ? &warm : &cmd);
+    const control_meas_t meas = {.i_meas = i, .u_meas = i * r_load, .udc = udc, .meas_valid = true};
+    control_fast_step(&ctrl, &meas, true, &out);
+    control_adapt_step(&adapt, meas.i_meas, meas.u_meas, &adapt_out);
+    control_set_gains(&ctrl, &adapt_out.gains);
+    /* Первый порядок с τ = 5 периодов. */
+    i += 0.2f * (((out.u * udc) / (n_tr * r_load)) - i);
+    if ((k >= 200u) && (settle == 1000u) && (fabsf(i - 10000.0f) < 1000.0f))
+    {
+      settle = k - 200u;
+    }
   }
-  return (strstr(name, filter) != NULL);
+  *r_est_out = out.r_est;
+  return settle;
 }
 
 /**
- * @brief Вывести список доступных тестов.
- * @param tests Массив тестов.
- * @param count Количество тестов, [шт].
+ * @brief Тест: feedforward с оценкой R ускоряет выход на уставку при тех же (низких) коэффициентах PI.
+ * @param ctx Контекст тестов.
  * @return None.
  */
-static void test_print_list(const test_case_t *tests, size_t count)
+static void test_feedforward_faster_rise(test_ctx_t *ctx)
 {
-  (void)printf("Available tests (%zu):\n", count);
-  for (size_t i = 0; i < count; ++i)
+  float r_pi = 0.0f;
+  float r_ff = 0.0f;
+  const uint32_t steps_pi = test_ff_settle_steps(0.0f, &r_pi);
+  const uint32_t steps_ff = test_ff_settle_steps(50.0f, &r_ff);
+  test_expect_close(ctx, r_ff, 100e-6f, 1e-6f, "feedforward uses the RLS estimate of R");
+  test_expect_true(ctx, steps_ff < steps_pi, "FF settles faster than pure PI");
+  test_expect_true(ctx, steps_ff <= 15u, "FF settles within a few plant time constants");
+}
+
+/**
+ * @brief Тест: вклад FF ограничивается раньше PI и обнуляется при Udc < Udc_crit.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_feedforward_limits(test_ctx_t *ctx)
+{
+  /* Единицы полей см. control_cfg_t. */
+  const control_cfg_t cfg = {
+    .kp = 0.0f,
+    .ki = 0.0f,
+    .dt = 1.0e-3f,
+    .u_min = 0.0f,
+    .u_max = 1.0f,
+    .i_ref_min = 0.0f,
+    .i_ref_max = 20000.0f,
+    .di_dt_max = 0.0f,
+    .integrator_policy = CONTROL_INTEGRATOR_RESET,
+    .ff_n_tr = 50.0f,
+    .ff_udc_min = 100.0f,
+    .ff_u_max = 0.5f
+  };
+
+  control_ctx_t ctrl;
+  control_init(&ctrl, &cfg);
+  const control_cmd_t cmd = {.i_ref_cmd = 10000.0f, .enable_cmd = true, .cmd_valid = true};
+  control_slow_step(&ctrl, &cmd);
+
+  /* Без опубликованной оценки R feedforward не вносит вклад. */
+  control_meas_t meas = {.i_meas = 1000.0f, .u_meas = 0.2f, .udc = 500.0f, .meas_valid = true};
+  control_out_t out = {0};
+  control_fast_step(&ctrl, &meas, true, &out);
+  test_expect_close(ctx, out.u_ff, 0.0f, 0.0f, "no ff without R estimate");
+
+  /* R = 200 мкО (только оценка R, kp/ki из cfg): u_ff = 10000 · 200e-6 · 50 / 500 = 0.2. */
+  const control_gains_t est = {.valid = false, .r_load = 200e-6f};
+  control_set_gains(&ctrl, &est);
+  control_fast_step(&ctrl, &meas, true, &out);
+  test_expect_close(ctx, out.u_ff, 0.2f, 1e-5f, "nominal duty");
+  test_expect_true(ctx, (out.flags & CONTROL_FLAG_FF_ACTIVE) != 0u, "ff active");
+
+  /* Udc = 150 В: u_ff_raw = 0.667 > ff_u_max. */
+  meas.udc = 150.0f;
+  control_fast_step(&ctrl, &meas, true, &out);
+  test_expect_close(ctx, out.u_ff, 0.5f, 1e-6f, "ff clamped by ff_u_max");
+  test_expect_true(ctx, (out.flags & CONTROL_FLAG_FF_LIMITED) != 0u, "ff limited flag");
+
+  /* Динамический u_max ниже ff_u_max ограничивает и FF. */
+  control_limits_t limits;
+  control_limits_reset(&limits);
+  control_limits_tighten_max(&limits, 0.3f, CONTROL_LIMIT_SRC_VS);
+  control_set_limits(&ctrl, &limits);
+  control_fast_step(&ctrl, &meas, true, &out);
+  test_expect_close(ctx, out.u_ff, 0.3f, 1e-6f, "ff clamped by dynamic u_max");
+  control_set_limits(&ctrl, NULL);
+
+  meas.udc = 50.0f;
+  control_fast_step(&ctrl, &meas, true, &out);
+  test_expect_close(ctx, out.u_ff, 0.0f, 0.0f, "no ff below Udc_crit");
+  test_expect_true(ctx, (out.flags & CONTROL_FLAG_FF_LIMITED) != 0u, "low udc flagged");
+  test_expect_true(ctx, (out.flags & CONTROL_FLAG_FF_ACTIVE) == 0u, "ff inactive at low udc");
+}
+
+/**
+ * @brief Тест: control_set_gains() подменяет kp/ki атомарно и безударно; NULL/невалидные — возврат к cfg.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_set_gains_bumpless(test_ctx_t *ctx)
+{
+  /* Единицы полей см. control_cfg_t. */
+  const control_cfg_t cfg = {
+    .kp = 0.01f,
+    .ki = 1.0f,
+    .dt = 0.01f,
+    .u_min = -10.0f,
+    .u_max = 10.0f,
+    .i_ref_min = 0.0f,
+    .i_ref_max = 100.0f,
+    .di_dt_max = 0.0f,
+    .integrator_policy = CONTROL_INTEGRATOR_RESET
+  };
+
+  control_ctx_t ctrl;
+  control_init(&ctrl, &cfg);
+  const control_cmd_t cmd = {.i_ref_cmd = 10.0f, .enable_cmd = true, .cmd_valid = true};
+  control_slow_step(&ctrl, &cmd);
+  const control_meas_t meas = {.i_meas = 0.0f, .u_meas = 0.0f, .udc = 0.0f, .meas_valid = true};
+
+  control_out_t out = {0};
+  control_fast_step(&ctrl, &meas, true, &out);
+  /* u = kp·e + ki·e·dt = 0.1 + 0.1. */
+  test_expect_close(ctx, out.u, 0.2f, 1e-6f, "cfg gains");
+
+  const control_gains_t gains = {.kp = 0.02f, .ki = 3.0f, .valid = true};
+  control_set_gains(&ctrl, &gains);
+  control_fast_step(&ctrl, &meas, true, &out);
+  /* Интегратор сохраняется (0.1), новая пара: 0.2 + (0.1 + 0.3). */
+  test_expect_close(ctx, out.u, 0.6f, 1e-6f, "scheduled gains, integrator kept");
+
+  const control_gains_t bad = {.kp = NAN, .ki = 3.0f, .valid = true};
+  control_set_gains(&ctrl, &bad);
+  control_fast_step(&ctrl, &meas, true, &out);
+  test_expect_close(ctx, out.u, 0.1f + 0.5f, 1e-6f, "invalid gains fall back to cfg");
+
+  control_set_gains(&ctrl, NULL);
+  control_fast_step(&ctrl, &meas, true, &out);
+  test_expect_close(ctx, out.u, 0.1f + 0.6f, 1e-6f, "NULL restores cfg gains");
+}
+
+/**
+ * @brief Конфигурация PI+FF на нагрузке R = 100 мкОм, n = 50, Udc = 500 В с внешним контуром.
+ * @param outer_gain Коэффициент релаксации внешнего контура, [0..1].
+ * @return Конфигурация.
+ */
+static control_cfg_t test_outer_cfg(float outer_gain)
+{
+  /* Единицы полей см. control_cfg_t. */
+  const control_cfg_t cfg = {
+    .kp = 1.0e-6f,
+    .ki = 5.0e-3f,
+    .dt = 1.0e-3f,
+    .u_min = 0.0f,
+    .u_max = 1.0f,
+    .i_ref_min = 0.0f,
+    .i_ref_max = 20000.0f,
+    .di_dt_max = 0.0f,
+    .integrator_policy = CONTROL_INTEGRATOR_RESET,
+    .ff_n_tr = 50.0f,
+    .ff_udc_min = 100.0f,
+    .ff_u_max = 0.8f,
+    .outer_gain = outer_gain,
+    .outer_i_start = 1000.0f,
+    .outer_i_min = 100.0f
+  };
+  return cfg;
+}
+
+/**
+ * @brief Прогнать регулятор на резистивной нагрузке (первый порядок, τ = 5 периодов).
+ * @param ctrl Контекст регулятора.
+ * @param cmd Команда.
+ * @param steps Количество периодов, [шт].
+ * @param i Ток нагрузки (вход/выход), [A].
+ * @param out Выход последнего шага.
+ * @return None.
+ */
+static void test_outer_run(control_ctx_t *ctrl, const control_cmd_t *cmd, uint32_t steps, float *i,
+                           control_out_t *out)
+{
+  const float r_load = 100e-6f; /* [Ом] */
+  control_slow_step(ctrl, cmd);
+  for (uint32_t k = 0u; k < steps; ++k)
   {
-    (void)printf("  %s\n", tests[i].name);
+    const float u_load = *i * r_load; /* [В] */
+    const control_meas_t meas = {
+      .i_meas = *i, .u_meas = u_load, .udc = 500.0f, .p_meas = *i * u_load, .meas_valid = true
+    };
+    control_fast_step(ctrl, &meas, true, out);
+    *i += 0.2f * (((out->u * 500.0f) / (50.0f * r_load)) - *i);
   }
 }
 
 /**
- * @brief Запустить набор тестов с фильтром по имени.
+ * @brief Тест: CP и CV выводят нагрузку на заданные P/U через тот же PI тока; потолок — I_ref_cmd.
  * @param ctx Контекст тестов.
- * @param tests Массив тестов.
- * @param count Количество тестов, [шт].
- * @param filter Фильтр по имени (подстрока) или NULL.
- * @return Количество реально запущенных тестов, [шт].
+ * @return None.
  */
-static size_t test_run_filtered(test_ctx_t *ctx,
-                                const test_case_t *tests,
-                                size_t count,
-                                const char *filter)
+static void test_outer_cp_cv_converge(test_ctx_t *ctx)
 {
-  size_t executed = 0;
+  const control_cfg_t cfg = test_outer_cfg(0.5f);
+  control_ctx_t ctrl;
+  control_out_t out = {0};
+  float i = 0.0f; /* [A] */
+
+  /* CP 10 кВт на 100 мкОм ⇒ I = 10 кА. */
+  control_init(&ctrl, &cfg);
+  const control_cmd_t cp = {
+    .i_ref_cmd = 20000.0f, .enable_cmd = true, .cmd_valid = true, .reg_mode = CONTROL_REG_CP, .target = 10000.0f
+  };
+  test_outer_run(&ctrl, &cp, 300u, &i, &out);
+  test_expect_close(ctx, i, 10000.0f, 100.0f, "CP current");
+  test_expect_close(ctx, i * i * 100e-6f, 10000.0f, 200.0f, "CP power");
+  test_expect_true(ctx, (out.flags & CONTROL_FLAG_OUTER_ACTIVE) != 0u, "outer active");
+
+  /* CV 0.5 В ⇒ I = 5 кА. */
+  const control_cmd_t cv = {
+    .i_ref_cmd = 20000.0f, .enable_cmd = true, .cmd_valid = true, .reg_mode = CONTROL_REG_CV, .target = 0.5f
+  };
+  test_outer_run(&ctrl, &cv, 300u, &i, &out);
+  test_expect_close(ctx, i * 100e-6f, 0.5f, 0.01f, "CV voltage");
 
-  for (size_t i = 0; i < count; ++i)
+  /* Потолок: CP 40 кВт требует 20 кА, команда ограничивает 12 кА. */
+  const control_cmd_t cp_cap = {
+    .i_ref_cmd = 12000.0f, .enable_cmd = true, .cmd_valid = true, .reg_mode = CONTROL_REG_CP, .target = 40000.0f
+  };
+  test_outer_run(&ctrl, &cp_cap, 300u, &i, &out);
+  test_expect_close(ctx, out.i_ref_used, 12000.0f, 1e-3f, "ceiling holds");
+  test_expect_true(ctx, (out.flags & CONTROL_FLAG_IREF_CLAMP) != 0u, "ceiling flagged");
+}
+
+/**
+ * @brief Тест: CE отсекает управление по энергии за сварку и держит отсечку до снятия enable_cmd.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_outer_ce_cutoff(test_ctx_t *ctx)
+{
+  const control_cfg_t cfg = test_outer_cfg(0.0f);
+  control_ctx_t ctrl;
+  control_init(&ctrl, &cfg);
+  control_out_t out = {0};
+  float i = 0.0f; /* [A] */
+
+  /* 10 кА на 100 мкОм = 10 кВт = 10 Дж за период: 200 Дж — не раньше ~15 периодов (с учётом фронта тока). */
+  const control_cmd_t ce = {
+    .i_ref_cmd = 10000.0f, .enable_cmd = true, .cmd_valid = true, .reg_mode = CONTROL_REG_CE, .target = 200.0f
+  };
+  uint32_t k_cut = 0u;
+  for (uint32_t k = 0u; (k < 200u) && (k_cut == 0u); ++k)
   {
-    if (!test_matches_filter(tests[i].name, filter))
-    {
-      continue;
-    }
-    executed += 1u;
-    tests[i].fn(ctx);
+    test_outer_run(&ctrl, &ce, 1u, &i, &out);
+    k_cut = ((out.flags & CONTROL_FLAG_ENERGY_CUTOFF) != 0u) ? k : 0u;
   }
+  test_expect_true(ctx, k_cut >= 10u, "cut-off after energy reached");
+  test_expect_true(ctx, !out.enable_request && (out.u == 0.0f), "no drive after cut-off");
+  /* Перебег не больше энергии одного периода при пиковом токе (< 16 кА ⇒ < 26 Дж). */
+  test_expect_true(ctx, (out.energy_j >= 200.0f) && (out.energy_j < 226.0f), "energy within one period");
+
+  test_outer_run(&ctrl, &ce, 50u, &i, &out);
+  test_expect_true(ctx, (out.flags & CONTROL_FLAG_ENERGY_CUTOFF) != 0u, "cut-off latched for this weld");
+
+  /* Снятие enable и новая сварка — энергия с нуля. */
+  control_cmd_t off = ce;
+  off.enable_cmd = false;
+  test_outer_run(&ctrl, &off, 1u, &i, &out);
+  i = 0.0f;
+  test_outer_run(&ctrl, &ce, 1u, &i, &out);
+  test_expect_true(ctx, out.enable_request, "new weld enabled");
+  test_expect_close(ctx, out.energy_j, 0.0f, 0.0f, "energy restarted");
+}
+
+/**
+ * @brief Тест: смена режима CE→CC→CE внутри сварки не сбрасывает энергию и не снимает отсечку.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_outer_mode_toggle_keeps_session(test_ctx_t *ctx)
+{
+  const control_cfg_t cfg = test_outer_cfg(0.0f);
+  control_ctx_t ctrl;
+  control_init(&ctrl, &cfg);
+  control_out_t out = {0};
+  float i = 0.0f; /* [A] */
+
+  const control_cmd_t ce = {
+    .i_ref_cmd = 10000.0f, .enable_cmd = true, .cmd_valid = true, .reg_mode = CONTROL_REG_CE, .target = 200.0f
+  };
+  control_cmd_t cc = ce;
+  cc.reg_mode = CONTROL_REG_CC;
+
+  /* Часть энергии в CE, затем CC в той же сварке: энергия продолжает накапливаться. */
+  test_outer_run(&ctrl, &ce, 10u, &i, &out);
+  const float e_ce = out.energy_j; /* [Дж] */
+  test_expect_true(ctx, (e_ce > 0.0f) && (e_ce < 200.0f), "CE below target");
+  test_outer_run(&ctrl, &cc, 1u, &i, &out);
+  test_expect_true(ctx, out.energy_j > e_ce, "energy kept over CE->CC");
+  test_outer_run(&ctrl, &ce, 1u, &i, &out);
+  test_expect_true(ctx, out.energy_j > e_ce, "energy kept over CC->CE");
+
+  /* Отсечка, затем CC и снова CE: отсечка держится до снятия enable_cmd. */
+  test_outer_run(&ctrl, &ce, 50u, &i, &out);
+  test_expect_true(ctx, (out.flags & CONTROL_FLAG_ENERGY_CUTOFF) != 0u, "cut-off reached");
+  test_outer_run(&ctrl, &cc, 1u, &i, &out);
+  test_expect_true(ctx, ((out.flags & CONTROL_FLAG_ENERGY_CUTOFF) != 0u) && !out.enable_request,
+                   "cut-off latched in CC");
+  test_outer_run(&ctrl, &ce, 1u, &i, &out);
+  test_expect_true(ctx, ((out.flags & CONTROL_FLAG_ENERGY_CUTOFF) != 0u) && (out.energy_j >= 200.0f),
+                   "CE->CC->CE does not re-arm");
+
+  /* Кратковременно невалидная команда внутри сварки — тоже не новая сварка. */
+  control_cmd_t glitch = ce;
+  glitch.cmd_valid = false;
+  test_outer_run(&ctrl, &glitch, 1u, &i, &out);
+  test_outer_run(&ctrl, &ce, 1u, &i, &out);
+  test_expect_true(ctx, (out.flags & CONTROL_FLAG_ENERGY_CUTOFF) != 0u, "cmd_valid glitch does not re-arm");
+
+  /* Снятие enable_cmd снимает отсечку. */
+  control_cmd_t off = ce;
+  off.enable_cmd = false;
+  test_outer_run(&ctrl, &off, 1u, &i, &out);
+  test_expect_true(ctx, (out.flags & CONTROL_FLAG_ENERGY_CUTOFF) == 0u, "cut-off released with enable");
+}
+
+/**
+ * @brief Тест: невалидный режим/цель и выключенный внешний контур блокируют управление.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_outer_invalid_blocks_control(test_ctx_t *ctx)
+{
+  control_ctx_t ctrl;
+  const control_cfg_t cfg = test_outer_cfg(0.0f);
+  control_init(&ctrl, &cfg);
+  control_out_t out = {0};
+  float i = 1000.0f; /* [A] */
 
-  return executed;
+  control_cmd_t cmd = {
+    .i_ref_cmd = 10000.0f, .enable_cmd = true, .cmd_valid = true, .reg_mode = CONTROL_REG_CP, .target = 1000.0f
+  };
+  test_outer_run(&ctrl, &cmd, 1u, &i, &out);
+  test_expect_true(ctx, !out.enable_request && ((out.flags & CONTROL_FLAG_CMD_INVALID) != 0u), "CP with gain 0");
+
+  cmd.reg_mode = CONTROL_REG_CE;
+  cmd.target = 0.0f;
+  test_outer_run(&ctrl, &cmd, 1u, &i, &out);
+  test_expect_true(ctx, (out.flags & CONTROL_FLAG_CMD_INVALID) != 0u, "CE without target");
+
+  cmd.target = NAN;
+  test_outer_run(&ctrl, &cmd, 1u, &i, &out);
+  test_expect_true(ctx, (out.flags & CONTROL_FLAG_NUM_INVALID) != 0u, "NaN target");
+
+  cmd.reg_mode = CONTROL_REG_COUNT;
+  cmd.target = 1.0f;
+  test_outer_run(&ctrl, &cmd, 1u, &i, &out);
+  test_expect_true(ctx, (out.flags & CONTROL_FLAG_CMD_INVALID) != 0u, "unknown mode");
+
+  control_cfg_t bad = cfg;
+  bad.outer_gain = 1.5f;
+  control_init(&ctrl, &bad);
+  test_expect_true(ctx, !ctrl.state.cfg_valid, "outer_gain > 1 rejected");
 }
 
 /**
@@ -635,8 +1096,6 @@ static size_t test_run_filtered(test_ctx_t *ctx,
  */
 int main(int argc, char **argv)
 {
-  test_ctx_t ctx = {0};
-
   const test_case_t tests[] = {
     {"disable_resets_integrator", test_disable_resets_integrator},
     {"meas_invalid_blocks_control", test_meas_invalid_blocks_control},
@@ -648,63 +1107,16 @@ int main(int argc, char **argv)
     {"iref_clamp_flag", test_iref_clamp_flag},
     {"saturation_flags_and_counters", test_saturation_flags_and_counters},
     {"anti_windup_holds_integrator", test_anti_windup_holds_integrator},
+    {"dynamic_limits_clamp_and_source", test_dynamic_limits_clamp_and_source},
+    {"dynamic_limits_anti_windup", test_dynamic_limits_anti_windup},
+    {"feedforward_faster_rise", test_feedforward_faster_rise},
+    {"feedforward_limits", test_feedforward_limits},
+    {"set_gains_bumpless", test_set_gains_bumpless},
+    {"outer_cp_cv_converge", test_outer_cp_cv_converge},
+    {"outer_ce_cutoff", test_outer_ce_cutoff},
+    {"outer_mode_toggle_keeps_session", test_outer_mode_toggle_keeps_session},
+    {"outer_invalid_blocks_control", test_outer_invalid_blocks_control},
   };
-  const size_t test_count = sizeof(tests) / sizeof(tests[0]);
 
-  const char *filter = NULL;
-  bool list_only = false;
-  bool exact_run = false;
-
-  if (argc == 1)
-  {
-    /* default */
-  }
-  else if ((argc == 2) && (strcmp(argv[1], "--list") == 0))
-  {
-    list_only = true;
-  }
-  else if ((argc == 3) && (strcmp(argv[1], "--filter") == 0))
-  {
-    filter = argv[2];
-  }
-  else if ((argc == 3) && (strcmp(argv[1], "--run") == 0))
-  {
-    filter = argv[2];
-    exact_run = true;
-  }
-  else
-  {
-    (void)printf("Usage:\n");
-    (void)printf("  %s\n", argv[0]);
-    (void)printf("  %s --list\n", argv[0]);
-    (void)printf("  %s --filter <substring>\n", argv[0]);
-    (void)printf("  %s --run <name>\n", argv[0]);
-    return 2;
-  }
-
-  if (list_only)
-  {
-    test_print_list(tests, test_count);
-    return 0;
-  }
-
-  const size_t executed = test_run_filtered(&ctx, tests, test_count, filter);
-  if (exact_run && (executed != 1u))
-  {
-    (void)printf("FAIL: test '%s' not found.\n", filter);
-    test_print_list(tests, test_count);
-    return 2;
-  }
-
-  if (ctx.failed != 0)
-  {
-    (void)printf("Tests failed: %d\n", ctx.failed);
-    return 1;
-  }
-
-  (void)printf("All tests passed.\n");
-  return 0;
+  return test_main(argc, argv, tests, sizeof(tests) / sizeof(tests[0]));
 }
-
-
-
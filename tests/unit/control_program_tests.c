@@ -0,0 +1,201 @@
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "control_program.h"
+#include "test_runner.h"
+
+/**
+ * @brief Программа: squeeze 5, upslope 0→8000 A за 10, weld 8000 A × 20 (u ≤ 0.6), downslope 8000→2000 за 3, hold 4.
+ * @return Таблица.
+ */
+static control_program_table_t test_table(void)
+{
+  const control_program_table_t table = {
+    .seg = {
+      {.kind = CONTROL_PROGRAM_SEG_SQUEEZE, .pulses = 1u, .periods = 5u},
+      {.kind = CONTROL_PROGRAM_SEG_UPSLOPE, .pulses = 1u, .periods = 10u, .i_start_a = 0u, .i_end_a = 8000u},
+      {.kind = CONTROL_PROGRAM_SEG_WELD, .pulses = 1u, .periods = 20u, .i_start_a = 8000u, .i_end_a = 8000u,
+       .u_max_pm = 600u},
+      {.kind = CONTROL_PROGRAM_SEG_DOWNSLOPE, .pulses = 1u, .periods = 3u, .i_start_a = 8000u, .i_end_a = 2000u},
+      {.kind = CONTROL_PROGRAM_SEG_HOLD, .pulses = 1u, .periods = 4u},
+    },
+    .count = 5u
+  };
+  return table;
+}
+
+/**
+ * @brief Тест: форма профиля по сегментам (squeeze без тока, линейные рампы, плато, hold, завершение).
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_profile_shape(test_ctx_t *ctx)
+{
+  control_program_t prog;
+  const control_program_table_t table = test_table();
+  test_expect_true(ctx, control_program_load(&prog, &table), "load");
+  test_expect_eq_u32(ctx, prog.total_periods, 42u, "total periods");
+  test_expect_true(ctx, control_program_start(&prog, 1000u), "start");
+
+  control_program_out_t out;
+  control_program_step(&prog, 1000u, &out);
+  test_expect_true(ctx, out.running && !out.enable, "squeeze: no current");
+  test_expect_eq_u32(ctx, out.seg_kind, CONTROL_PROGRAM_SEG_SQUEEZE, "squeeze kind");
+
+  control_program_step(&prog, 1005u, &out);
+  test_expect_true(ctx, out.enable, "upslope enabled");
+  test_expect_close(ctx, out.i_ref_a, 800.0f, 1e-3f, "upslope first point");
+  control_program_step(&prog, 1009u, &out);
+  test_expect_close(ctx, out.i_ref_a, 4000.0f, 1e-3f, "upslope mid");
+  control_program_step(&prog, 1014u, &out);
+  test_expect_close(ctx, out.i_ref_a, 8000.0f, 1e-3f, "upslope ends at i_end");
+  test_expect_true(ctx, isinf(out.u_max), "no u limit on upslope");
+
+  control_program_step(&prog, 1020u, &out);
+  test_expect_close(ctx, out.i_ref_a, 8000.0f, 1e-3f, "weld plateau");
+  test_expect_close(ctx, out.u_max, 0.6f, 1e-6f, "segment u limit");
+
+  control_program_step(&prog, 1035u, &out);
+  test_expect_close(ctx, out.i_ref_a, 6000.0f, 1e-3f, "downslope");
+  control_program_step(&prog, 1037u, &out);
+  test_expect_close(ctx, out.i_ref_a, 2000.0f, 1e-3f, "downslope end");
+
+  control_program_step(&prog, 1038u, &out);
+  test_expect_true(ctx, !out.enable && (out.seg_kind == CONTROL_PROGRAM_SEG_HOLD), "hold: no current");
+  control_program_step(&prog, 1042u, &out);
+  test_expect_true(ctx, out.done && !out.running && !out.enable, "done");
+  test_expect_close(ctx, out.i_ref_a, 0.0f, 0.0f, "zero after done");
+}
+
+/**
+ * @brief Тест: пульсация — импульсы и паузы внутри сегмента, номер импульса.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_pulsation(test_ctx_t *ctx)
+{
+  const control_program_table_t table = {
+    .seg = {
+      {.kind = CONTROL_PROGRAM_SEG_WELD, .pulses = 3u, .periods = 4u, .cool_periods = 2u, .i_start_a = 5000u,
+       .i_end_a = 5000u},
+    },
+    .count = 1u
+  };
+  control_program_t prog;
+  test_expect_true(ctx, control_program_load(&prog, &table), "load");
+  test_expect_eq_u32(ctx, prog.total_periods, 16u, "3 pulses + 2 pauses");
+  (void)control_program_start(&prog, 0u);
+
+  uint32_t on_count = 0u;
+  control_program_out_t out;
+  for (uint32_t seq = 0u; seq < 16u; ++seq)
+  {
+    control_program_step(&prog, seq, &out);
+    on_count += (uint32_t)out.enable;
+    const bool expect_on = (seq % 6u) < 4u;
+    test_expect_true(ctx, out.enable == expect_on, "pulse pattern");
+    test_expect_eq_u32(ctx, out.pulse_idx, seq / 6u, "pulse index");
+  }
+  test_expect_eq_u32(ctx, on_count, 12u, "on periods");
+}
+
+/**
+ * @brief Тест: уставка — функция fast_seq; джиттер/пропуски вызовов не меняют профиль, wrap-around u32.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_jitter_and_wrap(test_ctx_t *ctx)
+{
+  const control_program_table_t table = test_table();
+  control_program_t ref;
+  control_program_t jit;
+  const uint32_t seq0 = 0xFFFFFFF0u;
+  (void)control_program_load(&ref, &table);
+  (void)control_program_load(&jit, &table);
+  (void)control_program_start(&ref, seq0);
+  (void)control_program_start(&jit, seq0);
+
+  float profile[42];
+  control_program_out_t out;
+  for (uint32_t k = 0u; k < 42u; ++k)
+  {
+    control_program_step(&ref, seq0 + k, &out);
+    profile[k] = out.i_ref_a;
+  }
+
+  uint32_t seed = 99u;
+  uint32_t k = 0u;
+  bool match = true;
+  while (k < 42u)
+  {
+    control_program_step(&jit, seq0 + k, &out);
+    match = match && (out.i_ref_a == profile[k]);
+    k += 1u + (test_rand_u32(&seed) % 7u);
+  }
+  test_expect_true(ctx, match, "same i_ref at same fast_seq regardless of call cadence");
+
+  /* Запрос назад (повтор уже пройденного периода) — тот же результат. */
+  control_program_step(&jit, seq0 + 6u, &out);
+  test_expect_close(ctx, out.i_ref_a, profile[6], 0.0f, "backward query");
+
+  /* До старта — ток 0. */
+  control_program_t pre;
+  (void)control_program_load(&pre, &table);
+  (void)control_program_start(&pre, 500u);
+  control_program_step(&pre, 490u, &out);
+  test_expect_true(ctx, out.running && !out.enable && (out.i_ref_a == 0.0f), "before start");
+}
+
+/**
+ * @brief Тест: прерывание и невалидные таблицы.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_abort_and_invalid(test_ctx_t *ctx)
+{
+  control_program_t prog;
+  control_program_table_t table = test_table();
+  (void)control_program_load(&prog, &table);
+  (void)control_program_start(&prog, 0u);
+
+  control_program_out_t out;
+  control_program_step(&prog, 20u, &out);
+  test_expect_true(ctx, out.enable, "welding");
+  control_program_abort(&prog);
+  control_program_step(&prog, 21u, &out);
+  test_expect_true(ctx, !out.enable && !out.running && !out.done, "aborted");
+  test_expect_eq_u32(ctx, prog.cnt_aborts, 1u, "abort counted");
+
+  table.seg[0].i_start_a = 100u;
+  test_expect_true(ctx, !control_program_load(&prog, &table), "current in squeeze rejected");
+  test_expect_true(ctx, !control_program_start(&prog, 0u), "start refused");
+
+  table = test_table();
+  table.seg[2].pulses = 0u;
+  test_expect_true(ctx, !control_program_load(&prog, &table), "zero pulses rejected");
+  table = test_table();
+  table.seg[2].u_max_pm = 1001u;
+  test_expect_true(ctx, !control_program_load(&prog, &table), "u_max > 1 rejected");
+  table = test_table();
+  table.count = 0u;
+  test_expect_true(ctx, !control_program_load(&prog, &table), "empty rejected");
+}
+
+/**
+ * @brief Точка входа для L1 unit tests программы сварки.
+ * @param argc Количество аргументов командной строки, [шт].
+ * @param argv Массив аргументов командной строки.
+ * @return Код завершения (0 = OK).
+ */
+int main(int argc, char **argv)
+{
+  const test_case_t tests[] = {
+    {"profile_shape", test_profile_shape},
+    {"pulsation", test_pulsation},
+    {"jitter_and_wrap", test_jitter_and_wrap},
+    {"abort_and_invalid", test_abort_and_invalid},
+  };
+
+  return test_main(argc, argv, tests, sizeof(tests) / sizeof(tests[0]));
+}
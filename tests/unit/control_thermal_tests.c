@@ -0,0 +1,241 @@
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "control_thermal.h"
+#include "test_runner.h"
+
+#define TEST_T_AMB (40.0f) /**< Воздух в корпусе, [°C]. */
+
+/**
+ * @brief Конфиг: 3 звена j→NTC, NTC→воздух 0.15 К/Вт / 20 с, I_m = 0.01·I_per, 1 кГц, порог 150 °C, запас 10 °C.
+ * @return Конфигурация.
+ */
+static control_thermal_cfg_t test_cfg(void)
+{
+  const control_thermal_cfg_t cfg = {
+    .dt_s = 1.0e-3f,
+    .n_stages = 3u,
+    .r_k_w = {0.02f, 0.05f, 0.08f},
+    .tau_s = {0.005f, 0.05f, 0.5f},
+    .ntc_r_k_w = 0.15f,
+    .ntc_tau_s = 20.0f,
+    .k_i = 0.01f,
+    .v_ce0_v = 1.5f,
+    .r_ce_ohm = 0.0015f,
+    .e_sw_j_per_a = 2.0e-4f,
+    .f_pwm_hz = 1000.0f,
+    .t_trip_c = 150.0f,
+    .t_margin_c = 10.0f,
+    .horizon_s = 2.0f,
+    .i_max_a = 40000.0f,
+    .i_rise_a_per_s = 5000.0f,
+  };
+  return cfg;
+}
+
+/**
+ * @brief "Железо": те же звенья Фостера + NTC над воздухом (истинная Tj).
+ */
+typedef struct {
+  float stage[CONTROL_THERMAL_STAGES_MAX]; /**< ΔT_i, [К]. */
+  float y_ntc; /**< T_ntc - T_amb, [К]. */
+} test_plant_t;
+
+/**
+ * @brief Шаг "железа" с потерями p, возврат истинной Tj.
+ * @param pl Состояние.
+ * @param cfg Параметры.
+ * @param p Потери, [Вт].
+ * @return Tj, [°C].
+ */
+static float test_plant_step(test_plant_t *pl, const control_thermal_cfg_t *cfg, float p)
+{
+  float tj = TEST_T_AMB;
+  for (uint32_t i = 0u; i < cfg->n_stages; ++i)
+  {
+    const float a = expf(-cfg->dt_s / cfg->tau_s[i]);
+    pl->stage[i] = a * pl->stage[i] + (1.0f - a) * cfg->r_k_w[i] * p;
+    tj += pl->stage[i];
+  }
+  const float an = expf(-cfg->dt_s / cfg->ntc_tau_s);
+  pl->y_ntc = an * pl->y_ntc + (1.0f - an) * cfg->ntc_r_k_w * p;
+  return tj + pl->y_ntc;
+}
+
+/**
+ * @brief Тест: потери модуля и оценка Tj совпадают с "железом" (NTC + быстрые звенья), без дерейтинга.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_losses_and_tj(test_ctx_t *ctx)
+{
+  const control_thermal_cfg_t cfg = test_cfg();
+  control_thermal_t th;
+  test_expect_true(ctx, control_thermal_init(&th, &cfg), "init");
+
+  test_plant_t pl = {0};
+  control_thermal_out_t out = {0};
+  float tj_true = TEST_T_AMB;
+  for (uint32_t k = 0u; k < 3000u; ++k)
+  {
+    /* Вход тика видит NTC до шага (как AD7606 — с задержкой тика), затем "железо" делает шаг. */
+    control_thermal_in_t in = {.i_per_a = 10000.0f, .duty = 0.5f, .t_amb_c = TEST_T_AMB};
+    for (uint32_t m = 0u; m < CONTROL_THERMAL_MODULES; ++m)
+    {
+      in.t_ntc_c[m] = TEST_T_AMB + pl.y_ntc;
+    }
+    control_thermal_step(&th, &in, &out);
+    tj_true = test_plant_step(&pl, &cfg, out.p_module_w);
+  }
+  /* I_m = 100 A: 0.5·(1.5·100 + 0.0015·100²) + 1000·2e-4·100 = 82.5 + 20 Вт. */
+  test_expect_close(ctx, out.p_module_w, 102.5f, 1e-3f, "module losses");
+  test_expect_close(ctx, out.tj_c[0], tj_true, 0.05f, "Tj estimate tracks junction");
+  test_expect_true(ctx, (tj_true - (TEST_T_AMB + pl.y_ntc)) > 10.0f, "NTC lags junction by > 10 K");
+  test_expect_true(ctx, !out.limit_active, "no derating at 10 kA");
+}
+
+/**
+ * @brief Тест: замкнутый дерейтинг при 30 кА — предел срабатывает раньше NTC, Tj не превышает порог.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_predictive_derating(test_ctx_t *ctx)
+{
+  const control_thermal_cfg_t cfg = test_cfg();
+  control_thermal_t th;
+  (void)control_thermal_init(&th, &cfg);
+
+  test_plant_t pl = {0};
+  control_thermal_out_t out = {0};
+  float tj_max = 0.0f;
+  float t_ntc_at_limit = NAN;
+  float i_applied = 0.0f;
+  for (uint32_t k = 0u; k < 120000u; ++k)
+  {
+    control_cmd_t cmd = {.i_ref_cmd = 30000.0f, .enable_cmd = true, .cmd_valid = true};
+    (void)control_thermal_clamp_cmd(&th, &cmd);
+    i_applied = cmd.i_ref_cmd;
+
+    control_thermal_in_t in = {.i_per_a = i_applied, .duty = 0.8f, .t_amb_c = TEST_T_AMB};
+    for (uint32_t m = 0u; m < CONTROL_THERMAL_MODULES; ++m)
+    {
+      in.t_ntc_c[m] = TEST_T_AMB + pl.y_ntc;
+    }
+    control_thermal_step(&th, &in, &out);
+    const float tj = test_plant_step(&pl, &cfg, out.p_module_w);
+    tj_max = (tj > tj_max) ? tj : tj_max;
+    if (out.limit_active && isnan(t_ntc_at_limit))
+    {
+      t_ntc_at_limit = in.t_ntc_c[0];
+    }
+  }
+  test_expect_true(ctx, out.limit_active, "derating active");
+  test_expect_true(ctx, i_applied < 30000.0f, "current limited");
+  test_expect_true(ctx, tj_max <= 140.5f, "Tj held below trip - margin");
+  test_expect_true(ctx, out.tj_pred_max_c <= 140.5f, "prediction held at limit");
+  test_expect_true(ctx, t_ntc_at_limit < 100.0f, "limit engaged well before NTC nears threshold");
+  test_expect_true(ctx, th.cnt_limit_ticks > 0u, "limit ticks counted");
+}
+
+/**
+ * @brief Тест: калибровка звена NTC→воздух по логу (МНК) восстанавливает R_n, τ_n.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_fit_from_log(test_ctx_t *ctx)
+{
+  const float dt = 0.1f;
+  const float r = 0.15f;
+  const float tau = 20.0f;
+  const float a = expf(-dt / tau);
+  uint32_t seed = 43u;
+
+  control_thermal_fit_t fit;
+  control_thermal_fit_reset(&fit);
+  float y = 0.0f;
+  float p = 0.0f;
+  for (uint32_t k = 0u; k < 20000u; ++k)
+  {
+    if ((k % 300u) == 0u)
+    {
+      p = (float)(test_rand_u32(&seed) % 600u);
+    }
+    const float y_next = a * y + (1.0f - a) * r * p;
+    control_thermal_fit_add(&fit, y, p, y_next);
+    y = y_next;
+  }
+  float r_fit = 0.0f;
+  float tau_fit = 0.0f;
+  test_expect_true(ctx, control_thermal_fit_solve(&fit, dt, &r_fit, &tau_fit), "solve");
+  test_expect_close(ctx, r_fit, r, r * 0.01f, "R_n");
+  test_expect_close(ctx, tau_fit, tau, tau * 0.01f, "tau_n");
+
+  control_thermal_fit_reset(&fit);
+  for (uint32_t k = 0u; k < 100u; ++k)
+  {
+    control_thermal_fit_add(&fit, 0.0f, 0.0f, 0.0f);
+  }
+  test_expect_true(ctx, !control_thermal_fit_solve(&fit, dt, &r_fit, &tau_fit), "no excitation");
+}
+
+/**
+ * @brief Тест: fail-safe (NaN датчика, невалидный конфиг) и сужение пределов `u`.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_failsafe_and_limits(test_ctx_t *ctx)
+{
+  const control_thermal_cfg_t cfg = test_cfg();
+  control_thermal_t th;
+  (void)control_thermal_init(&th, &cfg);
+
+  control_thermal_in_t in = {.i_per_a = 1000.0f, .duty = 0.5f, .t_amb_c = TEST_T_AMB};
+  for (uint32_t m = 0u; m < CONTROL_THERMAL_MODULES; ++m)
+  {
+    in.t_ntc_c[m] = 50.0f;
+  }
+  in.t_ntc_c[2] = NAN;
+  control_thermal_out_t out;
+  control_thermal_step(&th, &in, &out);
+  test_expect_true(ctx, out.sensor_invalid && out.limit_active, "NaN NTC ⇒ fail-safe");
+  test_expect_close(ctx, out.i_limit_a, 0.0f, 0.0f, "limit 0");
+
+  /* Датчик вернулся ⇒ предел растёт со скоростью i_rise (5 А за тик). */
+  in.t_ntc_c[2] = 50.0f;
+  control_thermal_step(&th, &in, &out);
+  test_expect_close(ctx, out.i_limit_a, 5.0f, 1e-3f, "limit ramps up");
+
+  control_limits_t limits;
+  control_limits_reset(&limits);
+  test_expect_true(ctx, control_thermal_tighten(&th, &limits, 0.6f, 10.0f), "tighten");
+  test_expect_close(ctx, limits.u_max, 0.3f, 1e-6f, "u_max scaled by I_limit/I_per");
+  test_expect_eq_u32(ctx, limits.src_max, CONTROL_LIMIT_SRC_THERMAL, "src THERMAL");
+  test_expect_true(ctx, !control_thermal_tighten(&th, &limits, 0.6f, 4.0f), "below limit: no tighten");
+
+  control_thermal_cfg_t bad = test_cfg();
+  bad.tau_s[1] = 0.0f;
+  control_thermal_t th_bad;
+  test_expect_true(ctx, !control_thermal_init(&th_bad, &bad), "invalid cfg");
+  in.t_ntc_c[2] = 50.0f;
+  control_thermal_step(&th_bad, &in, &out);
+  test_expect_true(ctx, (out.i_limit_a == 0.0f) && !out.sensor_invalid, "invalid cfg ⇒ limit 0");
+}
+
+/**
+ * @brief Точка входа для L1 unit tests тепловой модели.
+ * @param argc Количество аргументов командной строки, [шт].
+ * @param argv Массив аргументов командной строки.
+ * @return Код завершения (0 = OK).
+ */
+int main(int argc, char **argv)
+{
+  const test_case_t tests[] = {
+    {"losses_and_tj", test_losses_and_tj},
+    {"predictive_derating", test_predictive_derating},
+    {"fit_from_log", test_fit_from_log},
+    {"failsafe_and_limits", test_failsafe_and_limits},
+  };
+
+  return test_main(argc, argv, tests, sizeof(tests) / sizeof(tests[0]));
+}
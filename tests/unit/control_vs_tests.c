@@ -0,0 +1,210 @@
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "control_vs.h"
+#include "test_runner.h"
+
+/**
+ * @brief Конфигурация: 1 кГц (полупериод 500 мкс), vs_sat = 0.15 В·с, margin 0.9, τ_bias = 20 мс.
+ * @return Конфигурация.
+ */
+static control_vs_cfg_t test_cfg(void)
+{
+  /* Полная скважность при 500 В: VS_half = 500 · 0.5e-3 = 0.25 В·с, Φpk = 0.125 В·с. */
+  const control_vs_cfg_t cfg = {
+    .t_pwm_s = 1.0e-3f,
+    .vs_sat = 0.15f,
+    .vs_margin = 0.9f,
+    .bias_tau_s = 0.02f,
+    .sat_warn_ratio = 0.95f,
+    .sat_hyst_ratio = 0.05f,
+    .bias_max = 0.02f,
+    .u_max_nominal = 1.0f
+  };
+  return cfg;
+}
+
+/**
+ * @brief Тест: симметричный режим — bias = 0, Φpk = VS/2, предел не активен.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_symmetric_no_limit(test_ctx_t *ctx)
+{
+  control_vs_t vs;
+  const control_vs_cfg_t cfg = test_cfg();
+  test_expect_true(ctx, control_vs_init(&vs, &cfg), "init");
+
+  const control_vs_in_t in = {.u_pos_v = 500.0f, .u_neg_v = 500.0f, .duty_pos = 0.8f, .duty_neg = 0.8f};
+  control_vs_out_t out;
+  for (uint32_t i = 0u; i < 1000u; ++i)
+  {
+    control_vs_step(&vs, &in, &out);
+  }
+  test_expect_close(ctx, out.vs_pos, 0.2f, 1e-6f, "vs_pos");
+  test_expect_close(ctx, out.bias, 0.0f, 1e-9f, "no bias");
+  test_expect_close(ctx, out.phi_peak, 0.1f, 1e-6f, "phi_peak");
+  test_expect_true(ctx, !out.limit_active && !out.sat_suspected, "no limit/sat");
+  test_expect_close(ctx, out.u_max, 1.0f, 1e-6f, "u_max nominal");
+}
+
+/**
+ * @brief Тест: полная скважность без bias ограничивается по vs_margin.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_full_duty_limited(test_ctx_t *ctx)
+{
+  control_vs_t vs;
+  const control_vs_cfg_t cfg = test_cfg();
+  (void)control_vs_init(&vs, &cfg);
+
+  const control_vs_in_t in = {.u_pos_v = 500.0f, .u_neg_v = 500.0f, .duty_pos = 1.0f, .duty_neg = 1.0f};
+  control_vs_out_t out;
+  control_vs_step(&vs, &in, &out);
+  /* d_max = 2 · 0.135 / (500 · 0.5e-3) = 1.08 → 1.0; при 600 В: 0.27 / 0.3 = 0.9. */
+  test_expect_true(ctx, !out.limit_active, "500 V fits");
+  const control_vs_in_t in_hi = {.u_pos_v = 600.0f, .u_neg_v = 600.0f, .duty_pos = 0.5f, .duty_neg = 0.5f};
+  control_vs_step(&vs, &in_hi, &out);
+  test_expect_close(ctx, out.u_max, 0.9f, 1e-4f, "u_max at 600 V");
+  test_expect_true(ctx, out.limit_active, "LIMIT_BY_VS");
+}
+
+/**
+ * @brief Тест: u_max_nominal < 1 — VS-предел ограничивает номинальный сверху, а не масштабирует его.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_nominal_below_one(test_ctx_t *ctx)
+{
+  control_vs_t vs;
+  control_vs_cfg_t cfg = test_cfg();
+  cfg.u_max_nominal = 0.95f;
+  (void)control_vs_init(&vs, &cfg);
+
+  /* d_max = 0.27 / (556.7 · 0.5e-3) ≈ 0.97 >= 0.95: предел не связывает. */
+  const control_vs_in_t in = {.u_pos_v = 556.7f, .u_neg_v = 556.7f, .duty_pos = 0.5f, .duty_neg = 0.5f};
+  control_vs_out_t out;
+  control_vs_step(&vs, &in, &out);
+  test_expect_close(ctx, out.u_max, 0.95f, 1e-6f, "duty_max above nominal keeps nominal");
+  test_expect_true(ctx, !out.limit_active, "non-binding VS limit not reported");
+  test_expect_eq_u32(ctx, vs.cnt_limit_periods, 0u, "no limit periods");
+
+  /* 600 В: d_max = 0.9 < 0.95 — предел связывает. */
+  const control_vs_in_t in_hi = {.u_pos_v = 600.0f, .u_neg_v = 600.0f, .duty_pos = 0.5f, .duty_neg = 0.5f};
+  control_vs_step(&vs, &in_hi, &out);
+  test_expect_close(ctx, out.u_max, 0.9f, 1e-4f, "binding VS limit");
+  test_expect_true(ctx, out.limit_active, "LIMIT_BY_VS");
+  test_expect_eq_u32(ctx, vs.cnt_limit_periods, 1u, "one limit period");
+}
+
+/**
+ * @brief Тест: несимметрия полупериодов накапливает bias до установившегося значения, предел сужается.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_asymmetry_bias(test_ctx_t *ctx)
+{
+  control_vs_t vs;
+  const control_vs_cfg_t cfg = test_cfg();
+  (void)control_vs_init(&vs, &cfg);
+
+  /* ΔVS = 500 · 0.02 · 0.5e-3 = 5e-3 В·с/период; установившийся bias = ΔVS / (1 - exp(-T/τ)). */
+  const control_vs_in_t in = {.u_pos_v = 500.0f, .u_neg_v = 500.0f, .duty_pos = 0.62f, .duty_neg = 0.60f};
+  control_vs_out_t out;
+  for (uint32_t i = 0u; i < 2000u; ++i)
+  {
+    control_vs_step(&vs, &in, &out);
+  }
+  const float bias_ss = 5.0e-3f / (1.0f - expf(-1.0e-3f / 0.02f));
+  test_expect_close(ctx, out.bias, bias_ss, 1e-4f, "steady-state bias");
+  test_expect_true(ctx, out.sat_suspected, "bias above bias_max");
+  const float d_max = (2.0f * (0.135f - bias_ss)) / (500.0f * 0.5e-3f);
+  test_expect_close(ctx, out.u_max, (d_max > 0.0f) ? d_max : 0.0f, 1e-3f, "u_max shrinks with bias");
+  test_expect_true(ctx, out.limit_active, "limit active");
+}
+
+/**
+ * @brief Тест: признак насыщения с гистерезисом и затухание bias после выравнивания.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_sat_hysteresis_and_decay(test_ctx_t *ctx)
+{
+  control_vs_t vs;
+  control_vs_cfg_t cfg = test_cfg();
+  cfg.bias_max = 1.0f; /* только по utilization */
+  (void)control_vs_init(&vs, &cfg);
+
+  control_vs_out_t out;
+  /* Φpk = 0.5 · 600 · 0.97 · 0.5e-3 = 0.1455 ⇒ 0.97 · vs_sat. */
+  const control_vs_in_t hi = {.u_pos_v = 600.0f, .u_neg_v = 600.0f, .duty_pos = 0.97f, .duty_neg = 0.97f};
+  control_vs_step(&vs, &hi, &out);
+  test_expect_true(ctx, out.sat_suspected, "sat on");
+
+  /* 0.92 · vs_sat: внутри гистерезиса — держим. */
+  const control_vs_in_t mid = {.u_pos_v = 600.0f, .u_neg_v = 600.0f, .duty_pos = 0.92f, .duty_neg = 0.92f};
+  control_vs_step(&vs, &mid, &out);
+  test_expect_true(ctx, out.sat_suspected, "held in hysteresis");
+
+  const control_vs_in_t lo = {.u_pos_v = 600.0f, .u_neg_v = 600.0f, .duty_pos = 0.5f, .duty_neg = 0.5f};
+  control_vs_step(&vs, &lo, &out);
+  test_expect_true(ctx, !out.sat_suspected, "sat off");
+  test_expect_eq_u32(ctx, vs.cnt_sat_events, 1u, "one sat event");
+
+  /* Затухание bias: одна несимметричная посылка, далее симметрия. */
+  const control_vs_in_t kick = {.u_pos_v = 500.0f, .u_neg_v = 500.0f, .duty_pos = 0.5f, .duty_neg = 0.0f};
+  control_vs_step(&vs, &kick, &out);
+  const float b0 = out.bias;
+  for (uint32_t i = 0u; i < 20u; ++i)
+  {
+    control_vs_step(&vs, &lo, &out);
+  }
+  test_expect_close(ctx, out.bias, b0 * expf(-20.0f * 1.0e-3f / 0.02f), 1e-5f, "bias decays with tau");
+}
+
+/**
+ * @brief Тест: невалидные вход/конфигурация ⇒ fail-safe (u_max = 0, sat_suspected), bias не портится.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_fail_safe(test_ctx_t *ctx)
+{
+  control_vs_t vs;
+  control_vs_cfg_t cfg = test_cfg();
+  (void)control_vs_init(&vs, &cfg);
+
+  const control_vs_in_t bad = {.u_pos_v = NAN, .u_neg_v = 500.0f, .duty_pos = 0.5f, .duty_neg = 0.5f};
+  control_vs_out_t out;
+  control_vs_step(&vs, &bad, &out);
+  test_expect_close(ctx, out.u_max, 0.0f, 0.0f, "u_max = 0 on NaN");
+  test_expect_true(ctx, out.sat_suspected, "sat on NaN");
+  test_expect_true(ctx, isfinite(vs.bias), "bias finite");
+
+  cfg.vs_margin = 1.5f;
+  test_expect_true(ctx, !control_vs_init(&vs, &cfg), "margin > 1 rejected");
+  const control_vs_in_t ok = {.u_pos_v = 500.0f, .u_neg_v = 500.0f, .duty_pos = 0.5f, .duty_neg = 0.5f};
+  control_vs_step(&vs, &ok, &out);
+  test_expect_close(ctx, out.u_max, 0.0f, 0.0f, "u_max = 0 on invalid cfg");
+}
+
+/**
+ * @brief Точка входа для L1 unit tests оценщика вольт-секунд.
+ * @param argc Количество аргументов командной строки, [шт].
+ * @param argv Массив аргументов командной строки.
+ * @return Код завершения (0 = OK).
+ */
+int main(int argc, char **argv)
+{
+  const test_case_t tests[] = {
+    {"symmetric_no_limit", test_symmetric_no_limit},
+    {"full_duty_limited", test_full_duty_limited},
+    {"nominal_below_one", test_nominal_below_one},
+    {"asymmetry_bias", test_asymmetry_bias},
+    {"sat_hysteresis_and_decay", test_sat_hysteresis_and_decay},
+    {"fail_safe", test_fail_safe},
+  };
+
+  return test_main(argc, argv, tests, sizeof(tests) / sizeof(tests[0]));
+}
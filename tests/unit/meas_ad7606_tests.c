@@ -0,0 +1,219 @@
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "meas_ad7606.h"
+#include "test_runner.h"
+
+/**
+ * @brief Конфиг: SCK 16 МГц, таймаут 5 мс, stuck 32 кадра, gain 0.01, offset 100.
+ * @param os Код OS[2:0], [-].
+ * @return Конфигурация.
+ */
+static meas_ad7606_cfg_t test_cfg(uint8_t os)
+{
+  meas_ad7606_cfg_t cfg = {
+    .os_ratio_log2 = os,
+    .spi_clk_hz = 16000000u,
+    .timeout_us = 5000u,
+    .stuck_frames = 32u,
+  };
+  for (uint32_t ch = 0u; ch < MEAS_AD7606_CHANNELS; ++ch)
+  {
+    cfg.gain[ch] = 0.01f;
+    cfg.offset[ch] = 100;
+  }
+  return cfg;
+}
+
+/**
+ * @brief Заполнить блок кадров: канал ch = base + 10·ch + шум ±noise (шум — от номера кадра).
+ * @param words Буфер.
+ * @param frames Кадров, [кадры].
+ * @param base Базовый код, [код].
+ * @param noise Амплитуда шума (0 — константа), [код].
+ * @return None.
+ */
+static void test_fill(uint16_t *words, uint32_t frames, int32_t base, int32_t noise)
+{
+  for (uint32_t f = 0u; f < frames; ++f)
+  {
+    const int32_t n = (noise != 0) ? ((((int32_t)f & 1) != 0) ? noise : -noise) : 0;
+    for (uint32_t ch = 0u; ch < MEAS_AD7606_CHANNELS; ++ch)
+    {
+      words[f * MEAS_AD7606_CHANNELS + ch] = (uint16_t)(int16_t)(base + 10 * (int32_t)ch + n);
+    }
+  }
+}
+
+/**
+ * @brief Тест: расписание по OS (кадров на 1 мс, длина DMA, чтение 128 бит) и невалидные конфиги.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_plan_by_os(test_ctx_t *ctx)
+{
+  const uint16_t frames_expected[MEAS_AD7606_OS_MAX + 1u] = {16u, 16u, 16u, 16u, 8u, 4u, 2u};
+  meas_ad7606_plan_t plan;
+  for (uint8_t os = 0u; os <= MEAS_AD7606_OS_MAX; ++os)
+  {
+    const meas_ad7606_cfg_t cfg = test_cfg(os);
+    test_expect_true(ctx, meas_ad7606_plan(&cfg, &plan), "plan");
+    test_expect_eq_u32(ctx, plan.frames_per_out, frames_expected[os], "frames per 1 ms");
+    test_expect_eq_u32(ctx, plan.t_read_ns, 8000u, "128 SCK at 16 MHz");
+    test_expect_true(ctx, plan.frame_period_ns >= (plan.t_conv_ns + plan.t_read_ns), "frame fits period");
+    test_expect_eq_u32(ctx, plan.frame_period_ns * plan.frames_per_out, 1000000u, "1 ms per block");
+    test_expect_eq_u32(ctx, plan.dma_len, 2u * 8u * plan.frames_per_out, "ping-pong DMA length");
+  }
+
+  meas_ad7606_cfg_t bad = test_cfg(7u);
+  test_expect_true(ctx, !meas_ad7606_plan(&bad, &plan), "OS out of range");
+  bad = test_cfg(6u);
+  bad.spi_clk_hz = 100000u; /* 1.28 мс чтения ⇒ кадр не помещается в 1 мс */
+  test_expect_true(ctx, !meas_ad7606_plan(&bad, &plan), "frame longer than 1 ms");
+
+  meas_ad7606_t dev;
+  bad = test_cfg(0u);
+  bad.stuck_frames = 1u;
+  test_expect_true(ctx, !meas_ad7606_init(&dev, &bad, 0u), "stuck_frames < 2");
+  uint16_t words[MEAS_AD7606_FRAMES_MAX * MEAS_AD7606_CHANNELS];
+  test_fill(words, 16u, 1000, 3);
+  test_expect_true(ctx, !meas_ad7606_block(&dev, words, 16u, 0u, NULL), "invalid cfg ⇒ no valid output");
+}
+
+/**
+ * @brief Тест: разбор кадров и децимация 16 кадров в отсчёт 1 мс (gain·(mean - offset)).
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_decimate(test_ctx_t *ctx)
+{
+  meas_ad7606_t dev;
+  const meas_ad7606_cfg_t cfg = test_cfg(2u);
+  test_expect_true(ctx, meas_ad7606_init(&dev, &cfg, 0u), "init");
+
+  uint16_t words[MEAS_AD7606_FRAMES_MAX * MEAS_AD7606_CHANNELS];
+  test_fill(words, 16u, -2000, 5);
+  words[3] = (uint16_t)(int16_t)(-2000 + 30 - 5 + 160); /* кадр 0, канал 3: +160 кодов ⇒ среднее +10 */
+
+  meas_ad7606_out_t out;
+  test_expect_true(ctx, meas_ad7606_block(&dev, words, 16u, 1000u, &out), "valid block");
+  test_expect_eq_u32(ctx, out.valid_mask, 0xFFu, "all channels valid");
+  test_expect_eq_u32(ctx, out.status, 0u, "no diagnostics");
+  test_expect_close(ctx, out.value[0], 0.01f * (-2000.0f - 100.0f), 1e-4f, "ch0");
+  test_expect_close(ctx, out.value[3], 0.01f * (-2000.0f + 30.0f + 10.0f - 100.0f), 1e-4f, "ch3 decimated");
+  test_expect_close(ctx, out.value[7], 0.01f * (-2000.0f + 70.0f - 100.0f), 1e-4f, "ch7");
+}
+
+/**
+ * @brief Тест: stuck (накопление через границу блоков), sat, bus, блок неверной длины.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_diagnostics(test_ctx_t *ctx)
+{
+  meas_ad7606_t dev;
+  const meas_ad7606_cfg_t cfg = test_cfg(0u);
+  (void)meas_ad7606_init(&dev, &cfg, 0u);
+  uint16_t words[MEAS_AD7606_FRAMES_MAX * MEAS_AD7606_CHANNELS];
+  meas_ad7606_out_t out;
+
+  /* Канал 5 залип: 16 кадров — ещё нет (порог 32), 32 кадра — stuck. */
+  test_fill(words, 16u, 500, 2);
+  for (uint32_t f = 0u; f < 16u; ++f)
+  {
+    words[f * MEAS_AD7606_CHANNELS + 5u] = 1234u;
+  }
+  (void)meas_ad7606_block(&dev, words, 16u, 0u, &out);
+  test_expect_eq_u32(ctx, out.stuck_mask, 0u, "below stuck threshold");
+  (void)meas_ad7606_block(&dev, words, 16u, 1000u, &out);
+  test_expect_eq_u32(ctx, out.stuck_mask, 1u << 5, "stuck across blocks");
+  test_expect_eq_u32(ctx, out.valid_mask, 0xFFu & ~(1u << 5), "stuck channel invalid");
+  test_expect_true(ctx, (out.status & MEAS_AD7606_ST_STUCK) != 0u, "ST_STUCK");
+
+  /* Канал ожил ⇒ stuck снимается; канал 1 на краю шкалы. */
+  test_fill(words, 16u, 500, 2);
+  words[1] = 0x7FFFu;
+  (void)meas_ad7606_block(&dev, words, 16u, 2000u, &out);
+  test_expect_eq_u32(ctx, out.stuck_mask, 0u, "stuck cleared");
+  test_expect_eq_u32(ctx, out.sat_mask, 1u << 1, "sat channel");
+  test_expect_true(ctx, (out.status & MEAS_AD7606_ST_SAT) != 0u, "ST_SAT");
+
+  /* Кадр из 0xFFFF (DOUTA в 1) исключается из среднего. */
+  test_fill(words, 16u, 500, 0);
+  for (uint32_t ch = 0u; ch < MEAS_AD7606_CHANNELS; ++ch)
+  {
+    words[4u * MEAS_AD7606_CHANNELS + ch] = 0xFFFFu;
+  }
+  (void)meas_ad7606_block(&dev, words, 16u, 3000u, &out);
+  test_expect_true(ctx, (out.status & MEAS_AD7606_ST_BUS) != 0u, "ST_BUS");
+  test_expect_eq_u32(ctx, dev.cnt_bus, 1u, "bus frame counted");
+  test_expect_close(ctx, out.value[0], 0.01f * 400.0f, 1e-4f, "bus frame excluded");
+
+  test_expect_true(ctx, !meas_ad7606_block(&dev, words, 15u, 4000u, &out), "short block invalid");
+  test_expect_eq_u32(ctx, out.status, MEAS_AD7606_ST_SHORT, "ST_SHORT");
+  test_expect_eq_u32(ctx, dev.cnt_short, 1u, "short counted");
+}
+
+/**
+ * @brief Тест: таймаут блоков (wrap-around времени, счётчик по фронту, восстановление).
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_timeout(test_ctx_t *ctx)
+{
+  meas_ad7606_t dev;
+  const meas_ad7606_cfg_t cfg = test_cfg(0u);
+  const uint32_t t0 = 0xFFFFF000u;
+  (void)meas_ad7606_init(&dev, &cfg, t0 - 1000u);
+
+  uint16_t words[MEAS_AD7606_FRAMES_MAX * MEAS_AD7606_CHANNELS];
+  test_fill(words, 16u, 0, 7);
+  (void)meas_ad7606_block(&dev, words, 16u, t0, NULL);
+  test_expect_true(ctx, !meas_ad7606_poll(&dev, t0 + 5000u), "at timeout boundary");
+  test_expect_true(ctx, meas_ad7606_poll(&dev, t0 + 5001u), "timeout across wrap");
+  test_expect_true(ctx, meas_ad7606_poll(&dev, t0 + 9000u), "still timed out");
+  test_expect_eq_u32(ctx, dev.cnt_timeout, 1u, "counted once");
+  test_expect_eq_u32(ctx, dev.out.valid_mask, 0u, "output invalid");
+
+  (void)meas_ad7606_block(&dev, words, 16u, t0 + 10000u, NULL);
+  test_expect_true(ctx, !meas_ad7606_poll(&dev, t0 + 10500u), "recovered");
+  test_expect_eq_u32(ctx, dev.out.valid_mask, 0xFFu, "valid after recovery");
+}
+
+/**
+ * @brief Тест: микросхема без блоков с power-up (мёртвая/не тактируется) уходит в таймаут от момента init.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_timeout_no_blocks(test_ctx_t *ctx)
+{
+  meas_ad7606_t dev;
+  const meas_ad7606_cfg_t cfg = test_cfg(0u);
+  (void)meas_ad7606_init(&dev, &cfg, 1000u);
+  test_expect_true(ctx, !meas_ad7606_poll(&dev, 6000u), "within timeout after init");
+  test_expect_eq_u32(ctx, dev.cnt_timeout, 0u, "no timeout yet");
+  test_expect_true(ctx, meas_ad7606_poll(&dev, 6001u), "timeout without any block");
+  test_expect_true(ctx, meas_ad7606_poll(&dev, 100000u), "stays timed out");
+  test_expect_eq_u32(ctx, dev.cnt_timeout, 1u, "timeout counted");
+  test_expect_true(ctx, (dev.out.status & MEAS_AD7606_ST_TIMEOUT) != 0u, "ST_TIMEOUT");
+  test_expect_eq_u32(ctx, dev.out.valid_mask, 0u, "output invalid");
+}
+
+/**
+ * @brief Точка входа для L1 unit tests медленных каналов AD7606.
+ * @param argc Количество аргументов командной строки, [шт].
+ * @param argv Массив аргументов командной строки.
+ * @return Код завершения (0 = OK).
+ */
+int main(int argc, char **argv)
+{
+  const test_case_t tests[] = {
+    {"plan_by_os", test_plan_by_os},
+    {"decimate", test_decimate},
+    {"diagnostics", test_diagnostics},
+    {"timeout", test_timeout},
+    {"timeout_no_blocks", test_timeout_no_blocks},
+  };
+
+  return test_main(argc, argv, tests, sizeof(tests) / sizeof(tests[0]));
+}
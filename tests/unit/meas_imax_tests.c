@@ -0,0 +1,218 @@
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "meas_imax.h"
+#include "test_runner.h"
+
+#define TEST_N (100u) /**< Выборок на период PWM (4 кГц, Δt=2.5 мкс), [шт]. */
+#define TEST_OFFSET (100) /**< Смещение нуля, [код]. */
+
+/**
+ * @brief Счётчик вызовов trip_fn.
+ * @param user Указатель на счётчик.
+ * @return None.
+ */
+static void test_trip_hook(void *user)
+{
+  uint32_t *calls = (uint32_t *)user;
+  (*calls)++;
+}
+
+/**
+ * @brief Конфигурация: 1 A/код, trip 1000 A (3 выборки), instant 2000 A, warn 800 A.
+ * @return Конфигурация.
+ */
+static meas_imax_cfg_t test_cfg(void)
+{
+  const meas_imax_cfg_t cfg = {
+    .gain_a_per_code = 1.0f,
+    .offset_code = TEST_OFFSET,
+    .i_trip_a = 1000.0f,
+    .i_instant_a = 2000.0f,
+    .i_warn_a = 800.0f,
+    .debounce_samples = 3u
+  };
+  return cfg;
+}
+
+/**
+ * @brief Заполнить блок постоянным током.
+ * @param buf Блок.
+ * @param i_a Ток, [A] (= код при 1 A/код).
+ * @return None.
+ */
+static void test_fill(int16_t *buf, int32_t i_a)
+{
+  for (uint32_t i = 0u; i < TEST_N; ++i)
+  {
+    buf[i] = (int16_t)(i_a + TEST_OFFSET);
+  }
+}
+
+/**
+ * @brief Тест: ток ниже порогов — нет trip, warn по порогу, пик с учётом offset и знака.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_below_threshold(test_ctx_t *ctx)
+{
+  meas_imax_t mon;
+  const meas_imax_cfg_t cfg = test_cfg();
+  uint32_t calls = 0u;
+  test_expect_true(ctx, meas_imax_init(&mon, &cfg, test_trip_hook, &calls), "init");
+
+  int16_t buf[TEST_N];
+  test_fill(buf, 500);
+  buf[10] = (int16_t)(-900 + TEST_OFFSET);
+  meas_imax_out_t out;
+  test_expect_true(ctx, !meas_imax_process(&mon, buf, TEST_N, &out), "no trip");
+  test_expect_true(ctx, out.warn, "negative sample above warn");
+  test_expect_eq_u32(ctx, out.peak_abs_code, 900u, "peak abs");
+  test_expect_eq_u32(ctx, out.trip_index, MEAS_IMAX_INDEX_NONE, "no trip index");
+  test_expect_eq_u32(ctx, calls, 0u, "hook not called");
+}
+
+/**
+ * @brief Тест: короткий импульс внутри периода (среднее за период ниже порога) ловится по выборкам.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_short_pulse_caught(test_ctx_t *ctx)
+{
+  meas_imax_t mon;
+  const meas_imax_cfg_t cfg = test_cfg();
+  uint32_t calls = 0u;
+  (void)meas_imax_init(&mon, &cfg, test_trip_hook, &calls);
+
+  int16_t buf[TEST_N];
+  test_fill(buf, 200);
+  int32_t sum = 0;
+  for (uint32_t i = 20u; i < 25u; ++i)
+  {
+    buf[i] = (int16_t)(1500 + TEST_OFFSET);
+  }
+  for (uint32_t i = 0u; i < TEST_N; ++i)
+  {
+    sum += buf[i] - TEST_OFFSET;
+  }
+  test_expect_true(ctx, (sum / (int32_t)TEST_N) < 1000, "period mean below trip");
+
+  meas_imax_out_t out;
+  test_expect_true(ctx, meas_imax_process(&mon, buf, TEST_N, &out), "trip");
+  test_expect_eq_u32(ctx, out.trip_index, 22u, "trip on 3rd sample of run");
+  test_expect_eq_u32(ctx, out.detect_latency_samples, 2u, "detect latency = debounce - 1");
+  test_expect_eq_u32(ctx, out.block_latency_samples, TEST_N - 1u - 22u, "block latency");
+  test_expect_eq_u32(ctx, calls, 1u, "force_off requested once");
+}
+
+/**
+ * @brief Тест: одиночный выброс ниже instant фильтруется debounce, выше instant — мгновенный trip.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_debounce_and_instant(test_ctx_t *ctx)
+{
+  meas_imax_t mon;
+  const meas_imax_cfg_t cfg = test_cfg();
+  (void)meas_imax_init(&mon, &cfg, NULL, NULL);
+
+  int16_t buf[TEST_N];
+  test_fill(buf, 0);
+  buf[5] = (int16_t)(1500 + TEST_OFFSET);
+  buf[6] = (int16_t)(1500 + TEST_OFFSET);
+  meas_imax_out_t out;
+  test_expect_true(ctx, !meas_imax_process(&mon, buf, TEST_N, &out), "2-sample glitch filtered");
+
+  buf[50] = (int16_t)(2500 + TEST_OFFSET);
+  test_expect_true(ctx, meas_imax_process(&mon, buf, TEST_N, &out), "instant trip");
+  test_expect_eq_u32(ctx, out.trip_index, 50u, "instant index");
+  test_expect_eq_u32(ctx, out.detect_latency_samples, 0u, "instant latency");
+}
+
+/**
+ * @brief Тест: серия через границу блоков (half/full DMA) — debounce переносится.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_run_across_blocks(test_ctx_t *ctx)
+{
+  meas_imax_t mon;
+  const meas_imax_cfg_t cfg = test_cfg();
+  (void)meas_imax_init(&mon, &cfg, NULL, NULL);
+
+  int16_t buf[TEST_N];
+  test_fill(buf, 0);
+  buf[48] = (int16_t)(1200 + TEST_OFFSET);
+  buf[49] = (int16_t)(1200 + TEST_OFFSET);
+  buf[50] = (int16_t)(1200 + TEST_OFFSET);
+  meas_imax_out_t out;
+  test_expect_true(ctx, !meas_imax_process(&mon, buf, TEST_N / 2u, &out), "first half: run 2");
+  test_expect_true(ctx, meas_imax_process(&mon, &buf[TEST_N / 2u], TEST_N / 2u, &out), "second half trips");
+  test_expect_eq_u32(ctx, out.trip_index, 0u, "first sample of second half");
+  test_expect_eq_u32(ctx, out.detect_latency_samples, 2u, "latency across blocks");
+}
+
+/**
+ * @brief Тест: trip защёлкнут до rearm, hook не повторяется; rearm возвращает наблюдение.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_latched_until_rearm(test_ctx_t *ctx)
+{
+  meas_imax_t mon;
+  const meas_imax_cfg_t cfg = test_cfg();
+  uint32_t calls = 0u;
+  (void)meas_imax_init(&mon, &cfg, test_trip_hook, &calls);
+
+  int16_t buf[TEST_N];
+  test_fill(buf, 3000);
+  meas_imax_out_t out;
+  (void)meas_imax_process(&mon, buf, TEST_N, &out);
+  test_expect_true(ctx, meas_imax_process(&mon, buf, TEST_N, &out), "still tripped");
+  test_expect_true(ctx, !out.trip, "no new edge");
+  test_expect_eq_u32(ctx, calls, 1u, "hook once");
+
+  meas_imax_rearm(&mon);
+  test_fill(buf, 0);
+  test_expect_true(ctx, !meas_imax_process(&mon, buf, TEST_N, &out), "clear after rearm");
+  test_expect_eq_u32(ctx, mon.cnt_trips, 1u, "cnt_trips");
+}
+
+/**
+ * @brief Тест: невалидная конфигурация ⇒ fail-safe trip по первой выборке.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_invalid_cfg_fail_safe(test_ctx_t *ctx)
+{
+  meas_imax_t mon;
+  meas_imax_cfg_t cfg = test_cfg();
+  cfg.i_instant_a = 500.0f;
+  test_expect_true(ctx, !meas_imax_init(&mon, &cfg, NULL, NULL), "instant < trip rejected");
+
+  int16_t buf[TEST_N];
+  test_fill(buf, 0);
+  meas_imax_out_t out;
+  test_expect_true(ctx, meas_imax_process(&mon, buf, TEST_N, &out), "fail-safe trip");
+  test_expect_eq_u32(ctx, out.trip_index, 0u, "on first sample");
+}
+
+/**
+ * @brief Точка входа для L1 unit tests монитора Imax.
+ * @param argc Количество аргументов командной строки, [шт].
+ * @param argv Массив аргументов командной строки.
+ * @return Код завершения (0 = OK).
+ */
+int main(int argc, char **argv)
+{
+  const test_case_t tests[] = {
+    {"below_threshold", test_below_threshold},
+    {"short_pulse_caught", test_short_pulse_caught},
+    {"debounce_and_instant", test_debounce_and_instant},
+    {"run_across_blocks", test_run_across_blocks},
+    {"latched_until_rearm", test_latched_until_rearm},
+    {"invalid_cfg_fail_safe", test_invalid_cfg_fail_safe},
+  };
+
+  return test_main(argc, argv, tests, sizeof(tests) / sizeof(tests[0]));
+}
@@ -0,0 +1,182 @@
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "meas_pq.h"
+#include "test_runner.h"
+
+#define TEST_PI (3.14159265358979)
+#define TEST_U_LL (400.0) /**< Номинальное линейное RMS, [В]. */
+
+/**
+ * @brief Конфиг: 16 кГц (AD7606 OS0), 50 Гц, окно 10 периодов, 400 В, 0.9/1.1, гистерезис 0.02.
+ * @param fs Частота кадров, [Гц].
+ * @return Конфигурация.
+ */
+static meas_pq_cfg_t test_cfg(float fs)
+{
+  const meas_pq_cfg_t cfg = {
+    .fs_hz = fs,
+    .f_mains_hz = 50.0f,
+    .window_cycles = 10u,
+    .u_nom_v = (float)TEST_U_LL,
+    .sag_pu = 0.9f,
+    .swell_pu = 1.1f,
+    .hyst_pu = 0.02f,
+  };
+  return cfg;
+}
+
+/**
+ * @brief Синтез кадра: прямая последовательность + доля обратной в напряжениях, ток с отставанием φ.
+ * @param n Номер кадра.
+ * @param fs Частота кадров, [Гц].
+ * @param scale Масштаб напряжения, [отн. ед.].
+ * @param neg Доля обратной последовательности в напряжениях, [отн. ед.].
+ * @param i_rms RMS тока, [A].
+ * @param phi Отставание тока от фазного напряжения, [рад].
+ * @return Кадр.
+ */
+static meas_pq_sample_t test_sample(uint32_t n, double fs, double scale, double neg, double i_rms, double phi)
+{
+  const double th = 2.0 * TEST_PI * 50.0 * (double)n / fs;
+  const double vp = scale * TEST_U_LL / sqrt(3.0) * sqrt(2.0); /* амплитуда фазного, [В] */
+  const double sh = 2.0 * TEST_PI / 3.0;
+  double v[3];
+  for (int k = 0; k < 3; ++k)
+  {
+    v[k] = vp * (cos(th - sh * k) + neg * cos(th + sh * k));
+  }
+  meas_pq_sample_t s;
+  for (int k = 0; k < 3; ++k)
+  {
+    s.u_ll[k] = (float)(v[k] - v[(k + 1) % 3]);
+    s.i_ph[k] = (float)(i_rms * sqrt(2.0) * cos(th - sh * k - phi));
+  }
+  return s;
+}
+
+/**
+ * @brief Тест: симметричная сеть — RMS, основная гармоника, несимметрия ≈ 0, P и PF = cos φ.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_balanced(test_ctx_t *ctx)
+{
+  meas_pq_t pq;
+  const meas_pq_cfg_t cfg = test_cfg(16000.0f);
+  test_expect_true(ctx, meas_pq_init(&pq, &cfg), "init");
+
+  const double phi = TEST_PI / 6.0;
+  uint32_t windows = 0u;
+  for (uint32_t n = 0u; n < 3u * 3200u; ++n)
+  {
+    const meas_pq_sample_t s = test_sample(n, 16000.0, 1.0, 0.0, 100.0, phi);
+    windows += (uint32_t)meas_pq_step(&pq, &s);
+  }
+  test_expect_eq_u32(ctx, windows, 3u, "200 ms windows");
+
+  const meas_pq_result_t *r = &pq.result;
+  for (uint32_t k = 0u; k < 3u; ++k)
+  {
+    test_expect_close(ctx, r->u_rms[k], 400.0f, 0.05f, "U_ll rms");
+    test_expect_close(ctx, r->u1_rms[k], 400.0f, 0.05f, "U_ll fundamental");
+    test_expect_close(ctx, r->i_rms[k], 100.0f, 0.01f, "I rms");
+  }
+  test_expect_true(ctx, r->unbalance_u < 1e-4f, "no voltage unbalance");
+  test_expect_true(ctx, r->unbalance_i < 1e-4f, "no current unbalance");
+  test_expect_close(ctx, r->pf, (float)cos(phi), 1e-4f, "PF = cos phi");
+  test_expect_close(ctx, r->p_w, (float)(sqrt(3.0) * 400.0 * 100.0 * cos(phi)), 10.0f, "P two-wattmeter");
+  test_expect_eq_u32(ctx, pq.stats.sag_events + pq.stats.swell_events, 0u, "no events");
+}
+
+/**
+ * @brief Тест: 3% обратной последовательности и нецелое число кадров на период сети (15625 Гц).
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_unbalance_noninteger_fs(test_ctx_t *ctx)
+{
+  meas_pq_t pq;
+  const meas_pq_cfg_t cfg = test_cfg(15625.0f);
+  test_expect_true(ctx, meas_pq_init(&pq, &cfg), "init");
+
+  bool ready = false;
+  for (uint32_t n = 0u; !ready; ++n)
+  {
+    const meas_pq_sample_t s = test_sample(n, 15625.0, 1.0, 0.03, 50.0, 0.0);
+    ready = meas_pq_step(&pq, &s);
+  }
+  test_expect_close(ctx, pq.result.unbalance_u, 0.03f, 2e-3f, "negative/positive sequence");
+  const float u1_avg = (pq.result.u1_rms[0] + pq.result.u1_rms[1] + pq.result.u1_rms[2]) / 3.0f; /* [В] */
+  test_expect_close(ctx, u1_avg, 400.0f, 4.0f, "fundamental within 1% at non-integer fs/f");
+  test_expect_close(ctx, pq.result.pf, 1.0f, 1e-2f, "resistive PF");
+}
+
+/**
+ * @brief Тест: провал 0.8 о.е. на 3 периода и перенапряжение 1.15 о.е. на 2 периода; статистика и payload.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_sag_swell_report(test_ctx_t *ctx)
+{
+  meas_pq_t pq;
+  const meas_pq_cfg_t cfg = test_cfg(16000.0f);
+  (void)meas_pq_init(&pq, &cfg);
+
+  const double scale[] = {1.0, 1.0, 0.8, 0.8, 0.8, 1.0, 1.15, 1.15, 1.0, 1.0};
+  for (uint32_t c = 0u; c < 10u; ++c)
+  {
+    for (uint32_t k = 0u; k < 320u; ++k)
+    {
+      const uint32_t n = c * 320u + k;
+      const meas_pq_sample_t s = test_sample(n, 16000.0, scale[c], 0.0, 10.0, 0.0);
+      (void)meas_pq_step(&pq, &s);
+      test_expect_true(ctx, !((c == 3u) && (k == 0u)) || pq.sag, "sag active after first low cycle");
+    }
+  }
+  test_expect_eq_u32(ctx, pq.stats.sag_events, 1u, "one sag");
+  test_expect_eq_u32(ctx, pq.stats.sag_cycles, 3u, "sag duration");
+  test_expect_eq_u32(ctx, pq.stats.swell_events, 1u, "one swell");
+  test_expect_close(ctx, pq.stats.u_min_pu, 0.8f, 1e-3f, "u_min");
+  test_expect_close(ctx, pq.stats.u_max_pu, 1.15f, 1e-3f, "u_max");
+  test_expect_true(ctx, !pq.sag && !pq.swell, "events cleared");
+  test_expect_eq_u32(ctx, pq.stats.windows, 1u, "window closed");
+
+  uint8_t data[MEAS_PQ_REPORT_LEN];
+  meas_pq_pack(&pq, data);
+  test_expect_eq_u32(ctx, (uint32_t)data[0] | ((uint32_t)data[1] << 8), 1u, "seq");
+  test_expect_eq_u32(ctx, data[2], MEAS_PQ_FLAG_VALID, "flags");
+  test_expect_eq_u32(ctx, data[52], 1u, "sag events");
+  test_expect_eq_u32(ctx, data[54], 1u, "swell events");
+  test_expect_eq_u32(ctx, data[56], 3u, "sag cycles");
+
+  meas_pq_stats_reset(&pq);
+  test_expect_eq_u32(ctx, pq.stats.cycles, 0u, "stats reset");
+
+  meas_pq_t bad;
+  meas_pq_cfg_t bad_cfg = test_cfg(300.0f);
+  test_expect_true(ctx, !meas_pq_init(&bad, &bad_cfg), "fs < 8 f");
+  bad_cfg = test_cfg(16000.0f);
+  bad_cfg.swell_pu = 0.95f;
+  test_expect_true(ctx, !meas_pq_init(&bad, &bad_cfg), "swell <= 1");
+  const meas_pq_sample_t s = test_sample(0u, 16000.0, 1.0, 0.0, 0.0, 0.0);
+  test_expect_true(ctx, !meas_pq_step(&bad, &s), "invalid cfg: no-op");
+}
+
+/**
+ * @brief Точка входа для L1 unit tests качества питания.
+ * @param argc Количество аргументов командной строки, [шт].
+ * @param argv Массив аргументов командной строки.
+ * @return Код завершения (0 = OK).
+ */
+int main(int argc, char **argv)
+{
+  const test_case_t tests[] = {
+    {"balanced", test_balanced},
+    {"unbalance_noninteger_fs", test_unbalance_noninteger_fs},
+    {"sag_swell_report", test_sag_swell_report},
+  };
+
+  return test_main(argc, argv, tests, sizeof(tests) / sizeof(tests[0]));
+}
@@ -0,0 +1,221 @@
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "meas_sampling.h"
+#include "test_runner.h"
+
+#define TEST_TIM_CLK_HZ (170000000u) /**< Тактовая TIM1/TIM3 STM32G474, [Гц]. */
+
+/**
+ * @brief Базовый конфиг: 170 МГц, потолок 400 кГц, CS LOW 1.8 мкс, бюджет CPU/DMA по умолчанию (625 нс, 10%).
+ * @param pwm_hz Частота PWM, [Гц].
+ * @return Конфигурация.
+ */
+static meas_sampling_cfg_t test_cfg(uint32_t pwm_hz)
+{
+  const meas_sampling_cfg_t cfg = {
+    .pwm_hz = pwm_hz,
+    .tim_clk_hz = TEST_TIM_CLK_HZ,
+    .fs_max_hz = 0u,
+    .cs_low_ns = 1800u,
+    .frame_cost_ns = 0u,
+    .budget_permille = 0u,
+    .gain_i_a_per_code = 2.0f,
+    .gain_u_v_per_code = 0.001f,
+    .offset_i_code = 10,
+    .offset_u_code = -20,
+  };
+  return cfg;
+}
+
+/**
+ * @brief Проверить инварианты плана: ровно N событий TIM3_UP до сброса, CS в шаге, fs под потолком.
+ * @param ctx Контекст тестов.
+ * @param plan План.
+ * @param fs_max Потолок, [Гц].
+ * @param msg Сообщение.
+ * @return None.
+ */
+static void test_expect_plan_invariants(test_ctx_t *ctx, const meas_sampling_plan_t *plan, uint32_t fs_max,
+                                        const char *msg)
+{
+  const uint32_t step = plan->tim3_arr + 1u; /* [тики] */
+  const bool n_events =
+    ((plan->n - 1u) * step < plan->tim1_period_ticks) && (plan->n * step >= plan->tim1_period_ticks);
+  test_expect_true(ctx, n_events, msg);
+  test_expect_true(ctx, plan->tim3_ccr < step, msg);
+  test_expect_true(ctx, plan->fs_hz <= fs_max, msg);
+  test_expect_eq_u32(ctx, plan->dma_len, plan->n, msg);
+}
+
+/**
+ * @brief Тест: N по бюджету CPU/DMA на период (100/64/32 по частоте PWM), тайминги TIM3, потолок кадров.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_plan_by_pwm(test_ctx_t *ctx)
+{
+  meas_sampling_plan_t plan;
+  meas_sampling_cfg_t cfg = test_cfg(1000u);
+
+  /* Бюджет по умолчанию 625 нс·N <= 10% T: N=100 до 1.6 кГц, 64 до 2.5 кГц, 32 выше. */
+  test_expect_true(ctx, meas_sampling_plan(&cfg, &plan), "1 kHz");
+  test_expect_eq_u32(ctx, plan.n, 100u, "1 kHz: N=100");
+  test_expect_eq_u32(ctx, plan.fs_hz, 100000u, "1 kHz: 100 kHz, not 400 kHz");
+  test_expect_eq_u32(ctx, plan.tim3_arr, 1699u, "1 kHz: TIM3");
+
+  const uint32_t pwm[] = {1600u, 1700u, 2000u, 2500u, 2600u, 3000u, 4000u};
+  const uint32_t n_budget[] = {100u, 64u, 64u, 64u, 32u, 32u, 32u};
+  for (uint32_t k = 0u; k < (sizeof(pwm) / sizeof(pwm[0])); ++k)
+  {
+    cfg.pwm_hz = pwm[k];
+    test_expect_true(ctx, meas_sampling_plan(&cfg, &plan), "plan in default budget");
+    test_expect_eq_u32(ctx, plan.n, n_budget[k], "N by PWM (budget)");
+    test_expect_plan_invariants(ctx, &plan, MEAS_SAMPLING_FS_MAX_HZ, "invariants in default budget");
+    test_expect_true(ctx, ((float)plan.n * 625.0e-9f) <= (plan.dt_s * 0.1f), "N frames fit 10% of T");
+  }
+  test_expect_eq_u32(ctx, plan.tim3_arr, 1328u, "4 kHz: N=32, ARR+1 = ceil(42500/32)");
+  test_expect_eq_u32(ctx, plan.tim3_ccr, 306u, "CS LOW 1.8 us");
+  test_expect_close(ctx, plan.dt_s, 250.0e-6f, 1e-9f, "T");
+
+  /* Дорогой кадр (1.25 мкс) сдвигает пороги вниз: 2 кГц уже 32. */
+  cfg.frame_cost_ns = 1250u;
+  cfg.pwm_hz = 1000u;
+  test_expect_true(ctx, meas_sampling_plan(&cfg, &plan) && (plan.n == 64u), "1 kHz, 1.25 us/frame: N=64");
+  cfg.pwm_hz = 2000u;
+  test_expect_true(ctx, meas_sampling_plan(&cfg, &plan) && (plan.n == 32u), "2 kHz, 1.25 us/frame: N=32");
+
+  /* Весь период на измерения: N ограничивает только потолок кадров ADR-006 (4 кГц · 100 = 400 кГц). */
+  cfg = test_cfg(4000u);
+  cfg.budget_permille = 1000u;
+  test_expect_true(ctx, meas_sampling_plan(&cfg, &plan), "4 kHz, full budget");
+  test_expect_eq_u32(ctx, plan.n, 100u, "4 kHz, full budget: N=100 (ADR-006)");
+  test_expect_eq_u32(ctx, plan.tim3_arr, 424u, "4 kHz: 400 kHz");
+
+  /* Потолок 200 кГц: верх диапазона уходит на 64/32 выборки. */
+  const uint32_t n_ceiling[] = {100u, 100u, 64u, 32u};
+  cfg.fs_max_hz = 200000u;
+  for (uint32_t k = 0u; k < 4u; ++k)
+  {
+    cfg.pwm_hz = 1000u * (k + 1u);
+    test_expect_true(ctx, meas_sampling_plan(&cfg, &plan), "plan at 200 kHz ceiling");
+    test_expect_eq_u32(ctx, plan.n, n_ceiling[k], "N by PWM (ceiling)");
+    test_expect_plan_invariants(ctx, &plan, cfg.fs_max_hz, "invariants at 200 kHz ceiling");
+  }
+
+  /* Частоты без целого деления: N событий на период сохраняются. */
+  cfg.fs_max_hz = 0u;
+  for (uint32_t f = MEAS_SAMPLING_PWM_MIN_HZ; f <= MEAS_SAMPLING_PWM_MAX_HZ; f += 37u)
+  {
+    cfg.pwm_hz = f;
+    test_expect_true(ctx, meas_sampling_plan(&cfg, &plan), "plan sweep");
+    test_expect_plan_invariants(ctx, &plan, MEAS_SAMPLING_FS_MAX_HZ, "invariants sweep");
+  }
+}
+
+/**
+ * @brief Тест: невалидные конфиги и перестройка только в IDLE.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_reconfigure_idle_only(test_ctx_t *ctx)
+{
+  meas_sampling_plan_t plan;
+  meas_sampling_cfg_t bad = test_cfg(999u);
+  test_expect_true(ctx, !meas_sampling_plan(&bad, &plan), "PWM below range");
+  bad = test_cfg(4001u);
+  test_expect_true(ctx, !meas_sampling_plan(&bad, &plan), "PWM above range");
+  bad = test_cfg(4000u);
+  bad.cs_low_ns = 20000u;
+  test_expect_true(ctx, !meas_sampling_plan(&bad, &plan), "CS window does not fit");
+  bad = test_cfg(4000u);
+  bad.fs_max_hz = 100000u;
+  test_expect_true(ctx, !meas_sampling_plan(&bad, &plan), "no N under ceiling");
+  bad = test_cfg(4000u);
+  bad.budget_permille = 1001u;
+  test_expect_true(ctx, !meas_sampling_plan(&bad, &plan), "budget above 100%");
+  bad = test_cfg(4000u);
+  bad.frame_cost_ns = 10000u;
+  test_expect_true(ctx, !meas_sampling_plan(&bad, &plan), "no N in CPU budget");
+  bad = test_cfg(4000u);
+  bad.gain_u_v_per_code = NAN;
+  test_expect_true(ctx, !meas_sampling_plan(&bad, &plan), "NaN gain");
+
+  meas_sampling_t s;
+  meas_sampling_cfg_t cfg = test_cfg(4000u);
+  test_expect_true(ctx, meas_sampling_init(&s, &cfg), "init");
+
+  cfg.pwm_hz = 1000u;
+  test_expect_true(ctx, !meas_sampling_reconfigure(&s, &cfg, false), "rejected outside IDLE");
+  test_expect_eq_u32(ctx, s.plan.tim3_arr, 1328u, "active plan kept");
+  test_expect_true(ctx, !meas_sampling_reconfigure(&s, &bad, true), "invalid cfg rejected in IDLE");
+  test_expect_eq_u32(ctx, s.cnt_rejected, 2u, "rejections counted");
+
+  test_expect_true(ctx, meas_sampling_reconfigure(&s, &cfg, true), "accepted in IDLE");
+  test_expect_eq_u32(ctx, s.plan.tim3_arr, 1699u, "TIM3 regenerated");
+  test_expect_eq_u32(ctx, s.generation, 1u, "generation");
+}
+
+/**
+ * @brief Тест: ядра 32/64/100 совпадают с эталоном (double) на случайных кодах полного диапазона.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_aggregate_kernels(test_ctx_t *ctx)
+{
+  const uint32_t fs_max[] = {0u, 260000u, 130000u}; /* ⇒ N = 100, 64, 32 при 4 кГц (бюджет CPU 100%) */
+  uint32_t seed = 40u;
+  int16_t i[MEAS_SAMPLING_N_MAX];
+  int16_t u[MEAS_SAMPLING_N_MAX];
+
+  for (uint32_t v = 0u; v < 3u; ++v)
+  {
+    meas_sampling_cfg_t cfg = test_cfg(4000u);
+    cfg.budget_permille = 1000u;
+    cfg.fs_max_hz = fs_max[v];
+    meas_sampling_plan_t plan;
+    test_expect_true(ctx, meas_sampling_plan(&cfg, &plan), "plan");
+
+    for (uint32_t rep = 0u; rep < 50u; ++rep)
+    {
+      double si = 0.0;
+      double su = 0.0;
+      double siu = 0.0;
+      for (uint32_t k = 0u; k < plan.n; ++k)
+      {
+        i[k] = (int16_t)(test_rand_u32(&seed) & 0xFFFFu);
+        u[k] = (int16_t)(test_rand_u32(&seed) & 0xFFFFu);
+        const double di = (double)i[k] - (double)cfg.offset_i_code;
+        const double du = (double)u[k] - (double)cfg.offset_u_code;
+        si += di;
+        su += du;
+        siu += di * du;
+      }
+      meas_sampling_period_t out;
+      meas_sampling_aggregate(&plan, i, u, &out);
+      const double n = (double)plan.n;
+      test_expect_close(ctx, out.i_per, (float)(si / n * 2.0), 0.1f, "I_per");
+      test_expect_close(ctx, out.u_per, (float)(su / n * 0.001), 1e-4f, "U_per");
+      test_expect_close(ctx, out.p_per, (float)(siu / n * 0.002), (float)fabs(siu / n * 0.002) * 1e-6f + 1e-3f,
+                        "P_per");
+    }
+  }
+}
+
+/**
+ * @brief Точка входа для L1 unit tests плана дискретизации.
+ * @param argc Количество аргументов командной строки, [шт].
+ * @param argv Массив аргументов командной строки.
+ * @return Код завершения (0 = OK).
+ */
+int main(int argc, char **argv)
+{
+  const test_case_t tests[] = {
+    {"plan_by_pwm", test_plan_by_pwm},
+    {"reconfigure_idle_only", test_reconfigure_idle_only},
+    {"aggregate_kernels", test_aggregate_kernels},
+  };
+
+  return test_main(argc, argv, tests, sizeof(tests) / sizeof(tests[0]));
+}
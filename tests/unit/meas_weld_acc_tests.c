@@ -0,0 +1,133 @@
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "meas_weld_acc.h"
+#include "test_runner.h"
+
+#define TEST_DT (250.0e-6f) /**< Период PWM 4 кГц, [с]. */
+
+/**
+ * @brief Тест: компенсированная сумма 50 кА за 100 с (400 000 периодов) совпадает с double-эталоном,
+ *        наивная float-сумма — нет.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_compensated_precision(test_ctx_t *ctx)
+{
+  meas_weld_acc_t acc;
+  test_expect_true(ctx, meas_weld_acc_init(&acc, TEST_DT), "init");
+  meas_weld_acc_begin(&acc);
+
+  uint32_t seed = 2024u;
+  double ref = 0.0; /* [A·с] */
+  float naive = 0.0f; /* [A·с] */
+  for (uint32_t k = 0u; k < 400000u; ++k)
+  {
+    const float i = 50000.0f + (float)(test_rand_u32(&seed) % 2001u) - 1000.0f; /* [A] */
+    meas_weld_acc_step(&acc, i, i * 2.0f, false, true);
+    ref += (double)(i * TEST_DT);
+    naive += i * TEST_DT;
+  }
+
+  meas_weld_report_t report;
+  test_expect_true(ctx, meas_weld_acc_end(&acc, &report), "end");
+  const float rel_comp = (float)fabs(((double)report.charge_c - ref) / ref); /* [-] */
+  const float rel_naive = (float)fabs(((double)naive - ref) / ref); /* [-] */
+  test_expect_true(ctx, rel_comp < 1.0e-7f, "compensated charge at float resolution");
+  test_expect_true(ctx, rel_naive > (10.0f * rel_comp), "naive float sum drifts");
+  test_expect_close(ctx, report.energy_j, 2.0f * report.charge_c, report.energy_j * 1.0e-7f, "energy Σ P·T");
+  test_expect_close(ctx, report.i_mean_a, 50000.0f, 5.0f, "mean current");
+}
+
+/**
+ * @brief Тест: пик/среднее, периоды LIMIT и невалидные периоды (NaN не портит суммы).
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_peak_mean_limit_invalid(test_ctx_t *ctx)
+{
+  meas_weld_acc_t acc;
+  (void)meas_weld_acc_init(&acc, 1.0e-3f);
+
+  meas_weld_acc_step(&acc, 1000.0f, 1000.0f, true, true);
+  test_expect_eq_u32(ctx, acc.periods, 0u, "ignored before begin");
+
+  meas_weld_acc_begin(&acc);
+  meas_weld_acc_step(&acc, 10000.0f, 10000.0f, false, true);
+  meas_weld_acc_step(&acc, 30000.0f, 90000.0f, true, true);
+  meas_weld_acc_step(&acc, NAN, 1.0f, true, true);
+  meas_weld_acc_step(&acc, 5000.0f, 1.0f, true, false);
+  meas_weld_acc_step(&acc, 20000.0f, 40000.0f, true, true);
+
+  meas_weld_report_t report;
+  meas_weld_acc_snapshot(&acc, &report);
+  test_expect_true(ctx, !report.done, "snapshot is not final");
+  test_expect_eq_u32(ctx, report.periods, 3u, "valid periods");
+  test_expect_eq_u32(ctx, report.invalid_periods, 2u, "invalid periods");
+  test_expect_eq_u32(ctx, report.limit_periods, 2u, "limit periods (valid only)");
+  test_expect_close(ctx, report.i_peak_a, 30000.0f, 0.0f, "peak");
+  test_expect_close(ctx, report.i_mean_a, 20000.0f, 1e-2f, "mean");
+  test_expect_close(ctx, report.charge_c, 60.0f, 1e-4f, "charge");
+  test_expect_close(ctx, report.energy_j, 140.0f, 1e-4f, "energy");
+}
+
+/**
+ * @brief Тест: номер сварки (0 пропускается), end без begin, payload PCcom4 `WeldReport.Last`.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_report_publish(test_ctx_t *ctx)
+{
+  meas_weld_acc_t acc;
+  (void)meas_weld_acc_init(&acc, 1.0e-3f);
+  test_expect_true(ctx, !meas_weld_acc_end(&acc, NULL), "end without begin");
+  test_expect_true(ctx, !acc.last.done && (acc.last.weld_id == 0u), "no report yet");
+
+  acc.weld_id = 0xFFFFu;
+  meas_weld_acc_begin(&acc);
+  test_expect_eq_u32(ctx, acc.weld_id, 1u, "weld_id skips 0 on wrap");
+  meas_weld_acc_step(&acc, 12345.0f, 12345.0f * 1.5f, true, true);
+  meas_weld_acc_begin(&acc);
+  test_expect_eq_u32(ctx, acc.periods, 0u, "begin restarts sums");
+  for (uint32_t k = 0u; k < 70000u; ++k)
+  {
+    meas_weld_acc_step(&acc, 2000.0f, 4.0e6f, true, true);
+  }
+  meas_weld_report_t report;
+  (void)meas_weld_acc_end(&acc, &report);
+  test_expect_true(ctx, report.done && (report.weld_id == 2u), "final report");
+  test_expect_true(ctx, acc.last.done && (acc.last.weld_id == 2u), "last report kept");
+
+  /* PCcom4 payload: LE поля на фиксированных смещениях. */
+  uint8_t data[MEAS_WELD_REPORT_LEN];
+  const meas_weld_report_t r = {
+    .weld_id = 0x0102u, .done = true, .periods = 0x03040506u, .energy_j = 1.0f, .charge_c = -2.0f,
+    .limit_periods = 0x0708090Au, .invalid_periods = 0x0B0C0D0Eu
+  };
+  meas_weld_report_pack(&r, data);
+  test_expect_eq_u32(ctx, (uint32_t)data[0] | ((uint32_t)data[1] << 8), 0x0102u, "weld_id LE");
+  test_expect_eq_u32(ctx, data[2], 1u, "done flag");
+  test_expect_eq_u32(ctx, data[4], 0x06u, "periods LSB first");
+  test_expect_eq_u32(ctx, (uint32_t)data[10] | ((uint32_t)data[11] << 8), 0x3F80u, "energy 1.0f");
+  test_expect_eq_u32(ctx, data[15], 0xC0u, "charge -2.0f MSB");
+  test_expect_eq_u32(ctx, data[24], 0x0Au, "limit periods");
+  test_expect_eq_u32(ctx, data[31], 0x0Bu, "invalid periods MSB");
+}
+
+/**
+ * @brief Точка входа для L1 unit tests накопителей сварки.
+ * @param argc Количество аргументов командной строки, [шт].
+ * @param argv Массив аргументов командной строки.
+ * @return Код завершения (0 = OK).
+ */
+int main(int argc, char **argv)
+{
+  const test_case_t tests[] = {
+    {"compensated_precision", test_compensated_precision},
+    {"peak_mean_limit_invalid", test_peak_mean_limit_invalid},
+    {"report_publish", test_report_publish},
+  };
+
+  return test_main(argc, argv, tests, sizeof(tests) / sizeof(tests[0]));
+}
@@ -0,0 +1,258 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pccom4_frame.h"
+#include "test_runner.h"
+
+#define TEST_FRAMES (512u) /**< Кадров в потоке, [шт]. */
+#define TEST_STREAM_CAP ((TEST_FRAMES + 1u) * (PCCOM4_WIRE_MAX + 16u)) /**< Поток с мусором, [байт]. */
+#define TEST_FT232H_BPS (1200000.0) /**< Предел FT232H (12 Мбод, 8N1), [байт/с]. */
+#define TEST_PARSER_MARGIN (10.0) /**< Требуемый запас разбора над линией FT232H, [раз]. */
+#define TEST_PARSER_MARGIN_SLOW (1.0) /**< Запас под sanitizer/valgrind (замедление 10–50x), [раз]. */
+
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#define TEST_INSTRUMENTED (1)
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer) || __has_feature(memory_sanitizer)
+#define TEST_INSTRUMENTED (1)
+#endif
+#endif
+#ifndef TEST_INSTRUMENTED
+#define TEST_INSTRUMENTED (0)
+#endif
+
+static uint8_t s_stream[TEST_STREAM_CAP]; /**< Поток на линии. */
+static uint32_t s_wire_off[TEST_FRAMES]; /**< Смещение кадра в потоке (после PREAMBLE), [байт]. */
+static uint8_t s_data[TEST_FRAMES][PCCOM4_DATA_MAX]; /**< Данные кадров. */
+
+/**
+ * @brief Приёмник: сверяет принятые кадры с отправленными по порядку.
+ */
+typedef struct {
+  uint32_t next; /**< Индекс ожидаемого кадра, [шт]. */
+  uint32_t skip; /**< Индекс испорченного кадра (TEST_FRAMES — нет). */
+  uint32_t mismatch; /**< Несовпадений, [шт]. */
+} test_sink_t;
+
+/**
+ * @brief Обработчик кадра.
+ * @param user Приёмник.
+ * @param frame Кадр.
+ * @return None.
+ */
+static void test_on_frame(void *user, const pccom4_frame_t *frame)
+{
+  test_sink_t *sink = (test_sink_t *)user;
+  if (sink->next == sink->skip)
+  {
+    sink->next++;
+  }
+  const uint32_t k = sink->next;
+  if ((k >= TEST_FRAMES) || (frame->data_len != (k % (PCCOM4_DATA_MAX + 1u))) || (frame->node != (uint8_t)k) ||
+      (frame->dst != PCCOM4_ADDR_PC) || (frame->src != PCCOM4_ADDR_USPF) || (frame->type != PCCOM4_TYPE_MESSAGE) ||
+      (memcmp(frame->data, s_data[k], frame->data_len) != 0) ||
+      (memcmp(frame->raw, &s_stream[s_wire_off[k]], (uint32_t)frame->data_len + PCCOM4_LEN_MIN) != 0))
+  {
+    sink->mismatch++;
+  }
+  sink->next++;
+}
+
+/**
+ * @brief Собрать поток: кадры всех длин `Data` 0..247, данные случайные (с `0xFF` внутри); опционально — мусор
+ * между кадрами (всплески `0xFF`, `0xFF` с неверным `Length`).
+ * @param seed Состояние генератора.
+ * @param garbage Вставлять мусор.
+ * @return Длина потока, [байт].
+ */
+static uint32_t test_build_stream(uint32_t seed, bool garbage)
+{
+  uint32_t pos = 0u;
+  for (uint32_t k = 0u; k < TEST_FRAMES; ++k)
+  {
+    if (garbage && ((k % 3u) == 1u))
+    {
+      const uint32_t burst = test_rand_u32(&seed) % 6u;
+      for (uint32_t i = 0u; i < burst; ++i)
+      {
+        s_stream[pos++] = (uint8_t)PCCOM4_PREAMBLE;
+      }
+      s_stream[pos++] = (uint8_t)(test_rand_u32(&seed) % PCCOM4_LEN_MIN);
+      s_stream[pos++] = (uint8_t)test_rand_u32(&seed);
+    }
+    const uint8_t data_len = (uint8_t)(k % (PCCOM4_DATA_MAX + 1u));
+    for (uint32_t i = 0u; i < data_len; ++i)
+    {
+      s_data[k][i] = (uint8_t)test_rand_u32(&seed);
+    }
+    const pccom4_frame_t frame = {PCCOM4_ADDR_PC, PCCOM4_ADDR_USPF, PCCOM4_TYPE_MESSAGE, (uint8_t)k, 0x11u,
+                                  data_len, s_data[k], NULL};
+    s_wire_off[k] = pos + 1u;
+    pos += pccom4_frame_encode(&frame, &s_stream[pos], TEST_STREAM_CAP - pos);
+  }
+  if (garbage)
+  {
+    // Хвост: ложный кандидат из мусора выталкивается следующими байтами (на линии — следующими кадрами).
+    memset(&s_stream[pos], 0, PCCOM4_WIRE_MAX);
+    pos += PCCOM4_WIRE_MAX;
+  }
+  return pos;
+}
+
+/**
+ * @brief Кодирование: раскладка полей и CRC16 Modbus (контрольное значение "123456789" = 0x4B37).
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_encode_layout(test_ctx_t *ctx)
+{
+  const uint8_t check[9] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+  test_expect_eq_u32(ctx, pccom4_crc16(0xFFFFu, check, sizeof(check)), 0x4B37u, "crc16 modbus check value");
+
+  const uint8_t data[2] = {0xAAu, 0xFFu};
+  const pccom4_frame_t frame = {PCCOM4_ADDR_USPF, PCCOM4_ADDR_PC, PCCOM4_TYPE_WRITE, 0x06u, 0x21u, 2u, data, NULL};
+  uint8_t wire[PCCOM4_WIRE_MAX];
+  test_expect_eq_u32(ctx, pccom4_frame_encode(&frame, wire, sizeof(wire)), 11u, "wire length");
+  test_expect_eq_u32(ctx, wire[0], PCCOM4_PREAMBLE, "preamble");
+  test_expect_eq_u32(ctx, wire[1], 10u, "Length excludes preamble");
+  test_expect_eq_u32(ctx, wire[2], PCCOM4_ADDR_USPF, "dst");
+  test_expect_eq_u32(ctx, wire[3], PCCOM4_ADDR_PC, "src");
+  test_expect_eq_u32(ctx, wire[4], PCCOM4_TYPE_WRITE, "type");
+  test_expect_eq_u32(ctx, wire[5], 0x06u, "node");
+  test_expect_eq_u32(ctx, wire[6], 0x21u, "op");
+  test_expect_eq_u32(ctx, wire[8], 0xFFu, "data");
+  // CRC считается по FRAME с обнулёнными байтами CRC.
+  uint8_t f[10];
+  memcpy(f, &wire[1], sizeof(f));
+  f[8] = 0u;
+  f[9] = 0u;
+  const uint16_t crc = pccom4_crc16(0xFFFFu, f, sizeof(f));
+  test_expect_eq_u32(ctx, (uint32_t)wire[9] | ((uint32_t)wire[10] << 8), crc, "crc over frame, LE");
+
+  test_expect_eq_u32(ctx, pccom4_frame_encode(&frame, wire, 10u), 0u, "buffer too small");
+  const pccom4_frame_t big = {0u, 0u, 0u, 0u, 0u, (uint8_t)(PCCOM4_DATA_MAX + 1u), s_data[0], NULL};
+  test_expect_eq_u32(ctx, pccom4_frame_encode(&big, wire, sizeof(wire)), 0u, "data too long");
+}
+
+/**
+ * @brief Поток без ошибок: одним куском, побайтно и случайными кусками — все кадры по порядку, без счётчиков ошибок.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_roundtrip_chunking(test_ctx_t *ctx)
+{
+  const uint32_t total = test_build_stream(0x1234u, false);
+  uint32_t seed = 0xBEEFu;
+  for (uint32_t mode = 0u; mode < 3u; ++mode)
+  {
+    pccom4_parser_t p;
+    pccom4_parser_init(&p);
+    test_sink_t sink = {0u, TEST_FRAMES, 0u};
+    uint32_t frames = 0u;
+    uint32_t pos = 0u;
+    while (pos < total)
+    {
+      uint32_t chunk = (mode == 0u) ? total : ((mode == 1u) ? 1u : (1u + (test_rand_u32(&seed) % 700u)));
+      chunk = (chunk > (total - pos)) ? (total - pos) : chunk;
+      frames += pccom4_parser_feed(&p, &s_stream[pos], chunk, test_on_frame, &sink);
+      pos += chunk;
+    }
+    test_expect_eq_u32(ctx, frames, TEST_FRAMES, "all frames");
+    test_expect_eq_u32(ctx, sink.next, TEST_FRAMES, "handler calls");
+    test_expect_eq_u32(ctx, sink.mismatch, 0u, "content");
+    test_expect_eq_u32(ctx, p.stats.rx_crc_err + p.stats.rx_len_err + p.stats.bytes_skipped, 0u, "no errors");
+  }
+}
+
+/**
+ * @brief Мусор между кадрами и испорченный кадр: теряется только испорченный, счётчики ресинхронизации растут.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_resync_garbage(test_ctx_t *ctx)
+{
+  const uint32_t total = test_build_stream(0x5678u, true);
+  const uint32_t bad = 200u;
+  s_stream[s_wire_off[bad] + 7u] ^= 0x5Au;
+
+  uint32_t seed = 0x42u;
+  pccom4_parser_t p;
+  pccom4_parser_init(&p);
+  test_sink_t sink = {0u, bad, 0u};
+  uint32_t pos = 0u;
+  while (pos < total)
+  {
+    uint32_t chunk = 1u + (test_rand_u32(&seed) % 300u);
+    chunk = (chunk > (total - pos)) ? (total - pos) : chunk;
+    (void)pccom4_parser_feed(&p, &s_stream[pos], chunk, test_on_frame, &sink);
+    pos += chunk;
+  }
+  test_expect_eq_u32(ctx, p.stats.rx_ok, TEST_FRAMES - 1u, "only the corrupted frame lost");
+  test_expect_eq_u32(ctx, sink.mismatch, 0u, "content");
+  test_expect_true(ctx, p.stats.rx_crc_err >= 1u, "crc error counted");
+  test_expect_true(ctx, p.stats.rx_len_err >= 1u, "bad Length counted");
+  test_expect_true(ctx, p.stats.parser_resync_count >= p.stats.rx_crc_err + p.stats.rx_len_err, "resync counted");
+  test_expect_true(ctx, p.stats.bytes_skipped > 0u, "garbage skipped");
+}
+
+/**
+ * @brief Запуск под инструментированием (sanitizer при сборке, valgrind — по его LD_PRELOAD).
+ * @return true, если порог пропускной способности нужно ослабить.
+ */
+static bool test_instrumented(void)
+{
+  const char *preload = getenv("LD_PRELOAD");
+  return (TEST_INSTRUMENTED != 0) || ((preload != NULL) && (strstr(preload, "vgpreload") != NULL));
+}
+
+/**
+ * @brief Пропускная способность разбора: с запасом TEST_PARSER_MARGIN выше предела линии FT232H, все кадры приняты.
+ * @param ctx Контекст тестов.
+ * @return None.
+ * @note Под sanitizer/valgrind порог ослаблен до TEST_PARSER_MARGIN_SLOW: проверяется только, что разбор
+ *       не отстаёт от линии.
+ */
+static void test_throughput(test_ctx_t *ctx)
+{
+  const uint32_t total = test_build_stream(0x9ABCu, false);
+  pccom4_parser_t p;
+  pccom4_parser_init(&p);
+  const uint32_t reps = 32u;
+  const uint64_t t0 = test_now_ns();
+  for (uint32_t r = 0u; r < reps; ++r)
+  {
+    for (uint32_t pos = 0u; pos < total; pos += 4096u)
+    {
+      const uint32_t chunk = ((total - pos) < 4096u) ? (total - pos) : 4096u;
+      (void)pccom4_parser_feed(&p, &s_stream[pos], chunk, NULL, NULL);
+    }
+  }
+  const double sec = (double)(test_now_ns() - t0) * 1e-9;
+  const double bps = ((double)total * (double)reps) / ((sec > 0.0) ? sec : 1e-9); /* [байт/с] */
+  const double margin = test_instrumented() ? TEST_PARSER_MARGIN_SLOW : TEST_PARSER_MARGIN; /* [раз] */
+  test_expect_eq_u32(ctx, p.stats.rx_ok, TEST_FRAMES * reps, "all frames");
+  (void)printf("INFO: pccom4 parser = %.1f MB/s (%.1fx FT232H line rate, required %.0fx)\n", bps * 1e-6,
+               bps / TEST_FT232H_BPS, margin);
+  test_expect_true(ctx, bps >= (margin * TEST_FT232H_BPS), "parser keeps up with FT232H line rate (with margin)");
+}
+
+/**
+ * @brief Точка входа для L1 unit tests кадрирования PCcom4.
+ * @param argc Количество аргументов командной строки, [шт].
+ * @param argv Массив аргументов командной строки.
+ * @return Код завершения (0 = OK).
+ */
+int main(int argc, char **argv)
+{
+  const test_case_t tests[] = {
+    {"encode_layout", test_encode_layout},
+    {"roundtrip_chunking", test_roundtrip_chunking},
+    {"resync_garbage", test_resync_garbage},
+    {"throughput", test_throughput},
+  };
+
+  return test_main(argc, argv, tests, sizeof(tests) / sizeof(tests[0]));
+}
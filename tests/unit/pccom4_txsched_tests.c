@@ -0,0 +1,183 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "pccom4_txsched.h"
+#include "test_runner.h"
+
+static pccom4_txsched_t s_sched; /**< Планировщик (большой — не на стеке). */
+static uint8_t s_line[64u * 1024u]; /**< Байты на линии. */
+
+/**
+ * @brief Порядок принятых кадров (по `Op`).
+ */
+typedef struct {
+  uint8_t op[256]; /**< `Op` по порядку приёма. */
+  uint32_t n; /**< Кадров, [шт]. */
+} test_rx_t;
+
+/**
+ * @brief Обработчик кадра.
+ * @param user Приёмник.
+ * @param frame Кадр.
+ * @return None.
+ */
+static void test_on_frame(void *user, const pccom4_frame_t *frame)
+{
+  test_rx_t *rx = (test_rx_t *)user;
+  if (rx->n < sizeof(rx->op))
+  {
+    rx->op[rx->n] = frame->op;
+  }
+  rx->n++;
+}
+
+/**
+ * @brief Поставить кадр с `Op` = op и `Data` длины len.
+ * @param prio Приоритет.
+ * @param op Операция (метка кадра).
+ * @param len Длина `Data`, [байт].
+ * @return Результат pccom4_txsched_push().
+ */
+static bool test_push(pccom4_prio_t prio, uint8_t op, uint8_t len)
+{
+  static const uint8_t data[PCCOM4_DATA_MAX] = {0};
+  const pccom4_frame_t frame = {PCCOM4_ADDR_PC, PCCOM4_ADDR_USPF, PCCOM4_TYPE_MESSAGE, (uint8_t)(6u - (uint32_t)prio),
+                                op, len, data, NULL};
+  return pccom4_txsched_push(&s_sched, prio, &frame);
+}
+
+/**
+ * @brief Strict priority: P0 раньше P1 раньше P2 независимо от порядка постановки; FIFO внутри очереди.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_strict_priority(test_ctx_t *ctx)
+{
+  pccom4_txsched_init(&s_sched);
+  test_expect_true(ctx, test_push(PCCOM4_PRIO_P2, 0x21u, 100u), "push P2");
+  test_expect_true(ctx, test_push(PCCOM4_PRIO_P1, 0x11u, 50u), "push P1");
+  test_expect_true(ctx, test_push(PCCOM4_PRIO_P2, 0x22u, 100u), "push P2");
+  test_expect_true(ctx, test_push(PCCOM4_PRIO_P0, 0x01u, 48u), "push P0");
+  test_expect_true(ctx, test_push(PCCOM4_PRIO_P0, 0x02u, 48u), "push P0");
+
+  const uint32_t n = pccom4_txsched_pull(&s_sched, s_line, sizeof(s_line));
+  pccom4_parser_t p;
+  pccom4_parser_init(&p);
+  test_rx_t rx = {{0}, 0u};
+  (void)pccom4_parser_feed(&p, s_line, n, test_on_frame, &rx);
+  const uint8_t expect[5] = {0x01u, 0x02u, 0x11u, 0x21u, 0x22u};
+  test_expect_eq_u32(ctx, rx.n, 5u, "frames");
+  test_expect_true(ctx, memcmp(rx.op, expect, sizeof(expect)) == 0, "P0, P1, P2; FIFO within queue");
+  test_expect_eq_u32(ctx, s_sched.stats.bytes_sent, n, "bytes_sent");
+  test_expect_eq_u32(ctx, s_sched.stats.frames_sent[PCCOM4_PRIO_P2], 2u, "frames_sent P2");
+  test_expect_eq_u32(ctx, pccom4_txsched_pull(&s_sched, s_line, sizeof(s_line)), 0u, "empty");
+}
+
+/**
+ * @brief Начатый кадр P2 не прерывается: P0 идёт сразу за ним, поток на линии остаётся валидным.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_no_preemption(test_ctx_t *ctx)
+{
+  pccom4_txsched_init(&s_sched);
+  (void)test_push(PCCOM4_PRIO_P2, 0x21u, PCCOM4_DATA_MAX);
+  (void)test_push(PCCOM4_PRIO_P2, 0x22u, PCCOM4_DATA_MAX);
+  uint32_t n = pccom4_txsched_pull(&s_sched, s_line, 10u);
+  test_expect_eq_u32(ctx, n, 10u, "budget respected");
+  (void)test_push(PCCOM4_PRIO_P0, 0x01u, 48u);
+  uint32_t got = pccom4_txsched_pull(&s_sched, &s_line[n], 7u);
+  while (got != 0u)
+  {
+    n += got;
+    got = pccom4_txsched_pull(&s_sched, &s_line[n], 7u);
+  }
+  pccom4_parser_t p;
+  pccom4_parser_init(&p);
+  test_rx_t rx = {{0}, 0u};
+  (void)pccom4_parser_feed(&p, s_line, n, test_on_frame, &rx);
+  test_expect_eq_u32(ctx, rx.n, 3u, "frames");
+  test_expect_eq_u32(ctx, rx.op[0], 0x21u, "started P2 completes");
+  test_expect_eq_u32(ctx, rx.op[1], 0x01u, "P0 next");
+  test_expect_eq_u32(ctx, rx.op[2], 0x22u, "then remaining P2");
+  test_expect_eq_u32(ctx, p.stats.rx_crc_err + p.stats.bytes_skipped, 0u, "stream intact");
+}
+
+/**
+ * @brief Перегрузка линии через P2 при бюджете тика: дропы только в P2, ожидание P0 не больше одного кадра + тик.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_overload(test_ctx_t *ctx)
+{
+  pccom4_txsched_init(&s_sched);
+  const uint32_t budget = 64u;
+  uint32_t p0_ticks_max = 0u;
+  uint32_t p0_pending_since = 0u;
+  bool p0_pending = false;
+  for (uint32_t tick = 1u; tick <= 2000u; ++tick)
+  {
+    if ((tick % 4u) == 0u)
+    {
+      (void)test_push(PCCOM4_PRIO_P1, 0x11u, 120u);
+    }
+    (void)test_push(PCCOM4_PRIO_P2, 0x21u, PCCOM4_DATA_MAX);
+    if (!p0_pending && ((tick % 8u) == 0u))
+    {
+      test_expect_true(ctx, test_push(PCCOM4_PRIO_P0, 0x01u, 48u), "P0 accepted");
+      p0_pending = true;
+      p0_pending_since = tick;
+    }
+    const uint32_t sent_before = s_sched.stats.frames_sent[PCCOM4_PRIO_P0];
+    (void)pccom4_txsched_pull(&s_sched, s_line, budget);
+    if (p0_pending && (s_sched.stats.frames_sent[PCCOM4_PRIO_P0] != sent_before))
+    {
+      const uint32_t wait = tick - p0_pending_since + 1u;
+      p0_ticks_max = (wait > p0_ticks_max) ? wait : p0_ticks_max;
+      p0_pending = false;
+    }
+  }
+  // Худший случай: дописать PCCOM4_WIRE_MAX байт начатого кадра + сам P0 (57 байт).
+  const uint32_t bound = ((PCCOM4_WIRE_MAX + 57u) + budget - 1u) / budget;
+  test_expect_true(ctx, p0_ticks_max <= bound, "P0 wait bounded by one frame");
+  test_expect_eq_u32(ctx, s_sched.stats.cnt_drop[PCCOM4_PRIO_P0], 0u, "no P0 drops");
+  test_expect_eq_u32(ctx, s_sched.stats.cnt_drop[PCCOM4_PRIO_P1], 0u, "P1 within share");
+  test_expect_true(ctx, s_sched.stats.cnt_drop[PCCOM4_PRIO_P2] > 0u, "P2 degrades");
+  test_expect_eq_u32(ctx, s_sched.stats.q_highwater[PCCOM4_PRIO_P2], PCCOM4_TXSCHED_DEPTH, "q2_highwater");
+  test_expect_eq_u32(ctx, s_sched.stats.q_highwater[PCCOM4_PRIO_P0], 1u, "q0_highwater");
+  test_expect_eq_u32(ctx, pccom4_txsched_space(&s_sched, PCCOM4_PRIO_P2), 0u, "P2 backpressure visible");
+  test_expect_true(ctx, s_sched.stats.frames_sent[PCCOM4_PRIO_P2] > 0u, "P2 gets remaining budget");
+}
+
+/**
+ * @brief Невалидные параметры.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_rejects(test_ctx_t *ctx)
+{
+  pccom4_txsched_init(&s_sched);
+  test_expect_true(ctx, !test_push(PCCOM4_PRIO_COUNT, 0x01u, 1u), "bad priority");
+  test_expect_true(ctx, !test_push(PCCOM4_PRIO_P1, 0x01u, (uint8_t)(PCCOM4_DATA_MAX + 1u)), "data too long");
+  test_expect_eq_u32(ctx, pccom4_txsched_space(&s_sched, PCCOM4_PRIO_P1), PCCOM4_TXSCHED_DEPTH, "nothing queued");
+  test_expect_eq_u32(ctx, pccom4_txsched_space(&s_sched, PCCOM4_PRIO_COUNT), 0u, "bad priority space");
+}
+
+/**
+ * @brief Точка входа для L1 unit tests планировщика передачи PCcom4.
+ * @param argc Количество аргументов командной строки, [шт].
+ * @param argv Массив аргументов командной строки.
+ * @return Код завершения (0 = OK).
+ */
+int main(int argc, char **argv)
+{
+  const test_case_t tests[] = {
+    {"strict_priority", test_strict_priority},
+    {"no_preemption", test_no_preemption},
+    {"overload", test_overload},
+    {"rejects", test_rejects},
+  };
+
+  return test_main(argc, argv, tests, sizeof(tests) / sizeof(tests[0]));
+}
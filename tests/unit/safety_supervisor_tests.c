@@ -0,0 +1,213 @@
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "safety_supervisor.h"
+#include "test_runner.h"
+
+/**
+ * @brief Выполнить шаг supervisor и вернуть выход.
+ * @param sup Состояние supervisor.
+ * @param raw Fault-условия периода, [битовая маска].
+ * @return Выход шага.
+ */
+static safety_out_t test_step(safety_supervisor_t *sup, uint32_t raw)
+{
+  safety_out_t out;
+  safety_supervisor_step(sup, raw, &out);
+  return out;
+}
+
+/**
+ * @brief Тест: без условий — allow, после init нет latch.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_idle_allows(test_ctx_t *ctx)
+{
+  safety_supervisor_t sup;
+  safety_supervisor_init(&sup, NULL);
+  const safety_out_t out = test_step(&sup, 0u);
+  test_expect_true(ctx, out.allow, "allow without faults");
+  test_expect_eq_u32(ctx, out.latched, 0u, "nothing latched");
+}
+
+/**
+ * @brief Тест: HARD защёлкивается, не снимается исчезновением причины, SOFT-clear и clear при активной причине.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_hard_latch_and_recovery(test_ctx_t *ctx)
+{
+  safety_supervisor_t sup;
+  safety_supervisor_init(&sup, NULL);
+
+  test_expect_true(ctx, !test_step(&sup, SAFETY_HARD_DRV_FAULT).allow, "hard blocks");
+  test_expect_true(ctx, !test_step(&sup, 0u).allow, "hard stays latched after cause gone");
+
+  safety_supervisor_request_clear(&sup, SAFETY_CLEAR_SOFT);
+  test_expect_true(ctx, !test_step(&sup, 0u).allow, "soft clear does not release hard");
+
+  safety_supervisor_request_clear(&sup, SAFETY_CLEAR_ALL);
+  test_expect_true(ctx, !test_step(&sup, SAFETY_HARD_DRV_FAULT).allow, "no recovery while cause active");
+  test_expect_true(ctx, !test_step(&sup, 0u).allow, "clear request consumed once");
+
+  safety_supervisor_request_clear(&sup, SAFETY_CLEAR_ALL);
+  test_expect_true(ctx, test_step(&sup, 0u).allow, "fault_reset releases hard");
+  test_expect_eq_u32(ctx, sup.cnt_hard_trips, 1u, "cnt_hard_trips");
+}
+
+/**
+ * @brief Тест: SOFT снимается по концу цикла; LIMIT и INFO не запрещают сварку и не защёлкиваются.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_soft_limit_info(test_ctx_t *ctx)
+{
+  safety_supervisor_t sup;
+  safety_supervisor_init(&sup, NULL);
+
+  test_expect_true(ctx, !test_step(&sup, SAFETY_SOFT_OVERRUN).allow, "soft blocks");
+  safety_supervisor_request_clear(&sup, SAFETY_CLEAR_SOFT);
+  test_expect_true(ctx, test_step(&sup, 0u).allow, "end of cycle releases soft");
+
+  const safety_out_t out = test_step(&sup, SAFETY_LIMIT_DIDT | SAFETY_INFO_TEMP_WARN);
+  test_expect_true(ctx, out.allow, "limit/info allow");
+  test_expect_eq_u32(ctx, out.latched, 0u, "limit/info not latched");
+  test_expect_eq_u32(ctx, out.active, SAFETY_LIMIT_DIDT | SAFETY_INFO_TEMP_WARN, "active reported");
+}
+
+/**
+ * @brief Тест: длительный LIMIT эскалирует в SOFT ровно на пороге; спад аккумулятора снимает причину.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_limit_escalation(test_ctx_t *ctx)
+{
+  safety_cfg_t cfg = {.limit_decay_per_tick = 2u};
+  cfg.limit_escalate_ticks[1] = 10u; /* SAFETY_LIMIT_DIDT */
+  safety_supervisor_t sup;
+  safety_supervisor_init(&sup, &cfg);
+
+  for (uint32_t i = 0u; i < 9u; ++i)
+  {
+    test_expect_true(ctx, test_step(&sup, SAFETY_LIMIT_DIDT).allow, "below threshold");
+  }
+  const safety_out_t esc = test_step(&sup, SAFETY_LIMIT_DIDT);
+  test_expect_true(ctx, !esc.allow, "escalated on threshold");
+  test_expect_eq_u32(ctx, esc.first_latched, SAFETY_SOFT_LIMIT_ESCALATED, "first cause");
+  test_expect_eq_u32(ctx, sup.cnt_limit_escalations, 1u, "cnt_limit_escalations");
+
+  /* Прочие LIMIT с порогом 0 не эскалируют. */
+  safety_supervisor_t other;
+  safety_supervisor_init(&other, &cfg);
+  for (uint32_t i = 0u; i < 1000u; ++i)
+  {
+    (void)test_step(&other, SAFETY_LIMIT_DUTY);
+  }
+  test_expect_true(ctx, test_step(&other, SAFETY_LIMIT_DUTY).allow, "threshold 0 disables escalation");
+
+  /* Пока аккумулятор не ниже порога — причина активна, recovery отклоняется. */
+  safety_supervisor_request_clear(&sup, SAFETY_CLEAR_SOFT);
+  test_expect_true(ctx, !test_step(&sup, SAFETY_LIMIT_DIDT).allow, "recovery rejected in limit");
+  (void)test_step(&sup, 0u);
+  safety_supervisor_request_clear(&sup, SAFETY_CLEAR_SOFT);
+  test_expect_true(ctx, test_step(&sup, 0u).allow, "recovery after decay");
+}
+
+/**
+ * @brief Тест: прерывистый LIMIT накапливается (спад медленнее роста) и всё равно эскалирует.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_limit_intermittent_accumulates(test_ctx_t *ctx)
+{
+  safety_cfg_t cfg = {.limit_decay_per_tick = 1u};
+  cfg.limit_escalate_ticks[2] = 20u; /* SAFETY_LIMIT_VOLT_SEC */
+  safety_supervisor_t sup;
+  safety_supervisor_init(&sup, &cfg);
+
+  bool escalated = false;
+  uint32_t ticks = 0u;
+  while (!escalated && (ticks < 1000u))
+  {
+    /* 3 периода в LIMIT, 1 без: чистый рост +2 за 4 периода. */
+    escalated = !test_step(&sup, ((ticks & 3u) != 3u) ? SAFETY_LIMIT_VOLT_SEC : 0u).allow;
+    ticks++;
+  }
+  test_expect_true(ctx, escalated, "intermittent limit escalates");
+  test_expect_true(ctx, ticks > 20u, "later than continuous limit");
+}
+
+/**
+ * @brief Тест: first_latched хранит первую причину до полного recovery и сбрасывается после.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_first_latched(test_ctx_t *ctx)
+{
+  safety_supervisor_t sup;
+  safety_supervisor_init(&sup, NULL);
+
+  (void)test_step(&sup, SAFETY_SOFT_MEAS_INVALID);
+  const safety_out_t out = test_step(&sup, SAFETY_HARD_OVERCURRENT);
+  test_expect_eq_u32(ctx, out.latched, SAFETY_SOFT_MEAS_INVALID | SAFETY_HARD_OVERCURRENT, "both latched");
+  test_expect_eq_u32(ctx, out.first_latched, SAFETY_SOFT_MEAS_INVALID, "first cause kept");
+
+  safety_supervisor_request_clear(&sup, SAFETY_CLEAR_SOFT);
+  test_expect_eq_u32(ctx, test_step(&sup, 0u).first_latched, SAFETY_SOFT_MEAS_INVALID, "kept while hard latched");
+
+  safety_supervisor_request_clear(&sup, SAFETY_CLEAR_ALL);
+  test_expect_eq_u32(ctx, test_step(&sup, 0u).first_latched, 0u, "reset after full recovery");
+  test_expect_eq_u32(ctx, test_step(&sup, SAFETY_HARD_HW_TRIP).first_latched, SAFETY_HARD_HW_TRIP, "new first cause");
+}
+
+/**
+ * @brief Тест: случайные слова — инвариант allow == (нет HARD/SOFT ни активных, ни защёлкнутых).
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_random_invariant(test_ctx_t *ctx)
+{
+  safety_supervisor_t sup;
+  safety_supervisor_init(&sup, NULL);
+  uint32_t seed = 0x5AFE7u;
+  bool ok = true;
+
+  for (uint32_t i = 0u; i < 100000u; ++i)
+  {
+    const uint32_t r = test_rand_u32(&seed);
+    /* Редкие HARD/SOFT, частые LIMIT/INFO. */
+    const uint32_t raw = (((r & 0xFFu) == 0u) ? (r & 0x0000FFFFu) : 0u) | (r & 0xFFFF0000u);
+    if ((r & 0x3FFu) == 0x3FFu)
+    {
+      safety_supervisor_request_clear(&sup, SAFETY_CLEAR_ALL);
+    }
+    const safety_out_t out = test_step(&sup, raw);
+    const uint32_t latch_mask = SAFETY_CLASS_HARD_MASK | SAFETY_CLASS_SOFT_MASK;
+    ok = ok && (out.allow == (out.latched == 0u));
+    ok = ok && ((out.active & latch_mask & ~out.latched) == 0u);
+    ok = ok && ((out.latched & ~latch_mask) == 0u);
+  }
+  test_expect_true(ctx, ok, "allow/latch invariant");
+}
+
+/**
+ * @brief Точка входа для L1 unit tests safety supervisor.
+ * @param argc Количество аргументов командной строки, [шт].
+ * @param argv Массив аргументов командной строки.
+ * @return Код завершения (0 = OK).
+ */
+int main(int argc, char **argv)
+{
+  const test_case_t tests[] = {
+    {"idle_allows", test_idle_allows},
+    {"hard_latch_and_recovery", test_hard_latch_and_recovery},
+    {"soft_limit_info", test_soft_limit_info},
+    {"limit_escalation", test_limit_escalation},
+    {"limit_intermittent_accumulates", test_limit_intermittent_accumulates},
+    {"first_latched", test_first_latched},
+    {"random_invariant", test_random_invariant},
+  };
+
+  return test_main(argc, argv, tests, sizeof(tests) / sizeof(tests[0]));
+}
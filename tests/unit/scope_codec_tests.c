@@ -0,0 +1,214 @@
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "scope_codec.h"
+#include "test_runner.h"
+
+#define TEST_N (64u) /**< Кадров в блоке, [шт]. */
+#define TEST_CH (8u) /**< Каналов (AD7606), [шт]. */
+#define TEST_BLOCKS (16u) /**< Блоков в записи, [шт]. */
+#define TEST_FS_HZ (200000.0f) /**< Частота кадров AD7606, [Гц]. */
+
+static int16_t s_x[TEST_BLOCKS * TEST_N * TEST_CH]; /**< Запись (кадры). */
+static int16_t s_y[TEST_BLOCKS * TEST_N * TEST_CH]; /**< Декодированная запись. */
+static uint8_t s_buf[TEST_BLOCKS * 4096u]; /**< Закодированный поток. */
+
+/**
+ * @brief Сварочная осциллограмма: I_weld/U_weld с пульсацией PWM 4 кГц + шум АЦП ±2 кода, прочие каналы медленные.
+ * @param seed Состояние генератора шума.
+ * @return None.
+ */
+static void test_fill_weld(uint32_t seed)
+{
+  for (uint32_t k = 0u; k < (TEST_BLOCKS * TEST_N); ++k)
+  {
+    const float t = (float)k / TEST_FS_HZ;
+    const float ripple = sinf(6.2831853f * 4000.0f * t);
+    for (uint32_t c = 0u; c < TEST_CH; ++c)
+    {
+      const float base = (c == 0u) ? (20000.0f + 1500.0f * ripple)
+                                   : ((c == 1u) ? (9000.0f - 2500.0f * ripple) : (1000.0f * (float)c));
+      const int32_t noise = (int32_t)(test_rand_u32(&seed) % 5u) - 2;
+      s_x[(k * TEST_CH) + c] = (int16_t)((int32_t)lrintf(base) + noise);
+    }
+  }
+}
+
+/**
+ * @brief Закодировать запись поблочно.
+ * @param n Кадров в блоке, [шт].
+ * @param blocks Блоков, [шт].
+ * @return Длина потока, [байт] (0 — ошибка кодера).
+ */
+static uint32_t test_encode_all(uint32_t n, uint32_t blocks)
+{
+  uint32_t pos = 0u;
+  for (uint32_t b = 0u; b < blocks; ++b)
+  {
+    const uint32_t len = scope_codec_encode(&s_x[b * n * TEST_CH], n, TEST_CH, &s_buf[pos], sizeof(s_buf) - pos);
+    if ((len == 0u) || (len > scope_codec_block_bound(n, TEST_CH)))
+    {
+      return 0u;
+    }
+    pos += len;
+  }
+  return pos;
+}
+
+/**
+ * @brief Декодировать поток целиком и сравнить с исходной записью.
+ * @param total Длина потока, [байт].
+ * @param samples Отсчётов в записи, [шт].
+ * @return true при точном совпадении.
+ */
+static bool test_decode_all(uint32_t total, uint32_t samples)
+{
+  uint32_t pos = 0u;
+  uint32_t out = 0u;
+  while (pos < total)
+  {
+    uint32_t n = 0u;
+    uint32_t n_ch = 0u;
+    const uint32_t len = scope_codec_decode(&s_buf[pos], total - pos, &s_y[out], samples - out, &n, &n_ch);
+    if (len == 0u)
+    {
+      return false;
+    }
+    pos += len;
+    out += n * n_ch;
+  }
+  return (out == samples) && (memcmp(s_x, s_y, samples * sizeof(int16_t)) == 0);
+}
+
+/**
+ * @brief Гладкие сварочные сигналы: точное восстановление и сжатие не хуже 2x.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_weld_roundtrip_ratio(test_ctx_t *ctx)
+{
+  test_fill_weld(0x1234u);
+  const uint32_t samples = TEST_BLOCKS * TEST_N * TEST_CH;
+  const uint32_t total = test_encode_all(TEST_N, TEST_BLOCKS);
+  test_expect_true(ctx, total > 0u, "encode");
+  test_expect_true(ctx, test_decode_all(total, samples), "lossless");
+  test_expect_true(ctx, (total * 2u) <= (samples * sizeof(int16_t)), "compressed >= 2x vs int16");
+
+  const uint32_t len0 = scope_codec_block_len(s_buf, total);
+  test_expect_true(ctx, (s_buf[SCOPE_CODEC_HDR_LEN] & SCOPE_CODEC_PARAM_RAW) == 0u, "I_weld coded with Rice");
+  test_expect_true(ctx, len0 < scope_codec_block_bound(TEST_N, TEST_CH), "block below bound");
+}
+
+/**
+ * @brief Худший случай: белый шум полного диапазона и скачки ±full-scale — сырые каналы, размер не выше границы.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_worst_case_bound(test_ctx_t *ctx)
+{
+  uint32_t seed = 0xBEEFu;
+  for (uint32_t i = 0u; i < (TEST_N * TEST_CH); ++i)
+  {
+    s_x[i] = (int16_t)(uint16_t)test_rand_u32(&seed);
+  }
+  uint32_t total = test_encode_all(TEST_N, 1u);
+  test_expect_true(ctx, (total > 0u) && (total <= scope_codec_block_bound(TEST_N, TEST_CH)), "noise within bound");
+  test_expect_true(ctx, test_decode_all(total, TEST_N * TEST_CH), "noise lossless");
+
+  for (uint32_t k = 0u; k < TEST_N; ++k)
+  {
+    for (uint32_t c = 0u; c < TEST_CH; ++c)
+    {
+      s_x[(k * TEST_CH) + c] = ((k + c) & 1u) ? INT16_MAX : INT16_MIN;
+    }
+  }
+  s_x[5u * TEST_CH] = 0; /* одиночный выброс: escape-код */
+  total = test_encode_all(TEST_N, 1u);
+  test_expect_true(ctx, (total > 0u) && (total <= scope_codec_block_bound(TEST_N, TEST_CH)),
+                   "full-scale within bound");
+  test_expect_true(ctx, test_decode_all(total, TEST_N * TEST_CH), "full-scale lossless");
+
+  for (uint32_t i = 0u; i < (TEST_N * TEST_CH); ++i)
+  {
+    s_x[i] = (int16_t)(((i / TEST_CH) == 10u) ? 30000 : -30000);
+  }
+  total = test_encode_all(TEST_N, 1u);
+  test_expect_true(ctx, test_decode_all(total, TEST_N * TEST_CH), "step with escape lossless");
+}
+
+/**
+ * @brief Произвольный доступ: пропуск блоков по длине и декодирование одного блока.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_random_access(test_ctx_t *ctx)
+{
+  test_fill_weld(0x55u);
+  const uint32_t total = test_encode_all(TEST_N, TEST_BLOCKS);
+  uint32_t pos = 0u;
+  for (uint32_t b = 0u; b < 11u; ++b)
+  {
+    pos += scope_codec_block_len(&s_buf[pos], total - pos);
+  }
+  uint32_t n = 0u;
+  uint32_t n_ch = 0u;
+  const uint32_t len = scope_codec_decode(&s_buf[pos], total - pos, s_y, TEST_N * TEST_CH, &n, &n_ch);
+  test_expect_true(ctx, len > 0u, "block 11 decoded in isolation");
+  test_expect_eq_u32(ctx, n, TEST_N, "frames");
+  test_expect_eq_u32(ctx, n_ch, TEST_CH, "channels");
+  test_expect_true(ctx, memcmp(s_y, &s_x[11u * TEST_N * TEST_CH], TEST_N * TEST_CH * sizeof(int16_t)) == 0,
+                   "block 11 matches");
+
+  // Короткий хвостовой блок и одиночный кадр.
+  uint8_t blk[64];
+  int16_t one[TEST_CH];
+  test_expect_eq_u32(ctx, scope_codec_encode(s_x, 1u, TEST_CH, blk, sizeof(blk)), scope_codec_block_bound(1u, TEST_CH),
+                     "single frame = headers only");
+  test_expect_true(ctx, scope_codec_decode(blk, sizeof(blk), one, TEST_CH, &n, &n_ch) > 0u, "single frame decoded");
+  test_expect_true(ctx, memcmp(one, s_x, sizeof(one)) == 0, "single frame matches");
+}
+
+/**
+ * @brief Невалидные параметры и повреждённые блоки отклоняются.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_rejects(test_ctx_t *ctx)
+{
+  test_fill_weld(0x77u);
+  uint8_t blk[4096];
+  test_expect_eq_u32(ctx, scope_codec_encode(s_x, 0u, TEST_CH, blk, sizeof(blk)), 0u, "n = 0");
+  test_expect_eq_u32(ctx, scope_codec_encode(s_x, 256u, TEST_CH, blk, sizeof(blk)), 0u, "n > max");
+  test_expect_eq_u32(ctx, scope_codec_encode(s_x, TEST_N, 9u, blk, sizeof(blk)), 0u, "too many channels");
+  test_expect_eq_u32(ctx, scope_codec_encode(s_x, TEST_N, TEST_CH, blk, 40u), 0u, "buffer too small");
+
+  const uint32_t len = scope_codec_encode(s_x, TEST_N, TEST_CH, blk, sizeof(blk));
+  uint32_t n = 0u;
+  uint32_t n_ch = 0u;
+  test_expect_eq_u32(ctx, scope_codec_decode(blk, len - 1u, s_y, TEST_N * TEST_CH, &n, &n_ch), 0u, "truncated");
+  test_expect_eq_u32(ctx, scope_codec_decode(blk, len, s_y, (TEST_N * TEST_CH) - 1u, &n, &n_ch), 0u, "capacity");
+  blk[SCOPE_CODEC_HDR_LEN] = 0x1Fu;
+  test_expect_eq_u32(ctx, scope_codec_decode(blk, len, s_y, TEST_N * TEST_CH, &n, &n_ch), 0u, "invalid k");
+  blk[3] = 0u;
+  test_expect_eq_u32(ctx, scope_codec_block_len(blk, len), 0u, "zero channels");
+}
+
+/**
+ * @brief Точка входа для L1 unit tests кодека осциллограмм.
+ * @param argc Количество аргументов командной строки, [шт].
+ * @param argv Массив аргументов командной строки.
+ * @return Код завершения (0 = OK).
+ */
+int main(int argc, char **argv)
+{
+  const test_case_t tests[] = {
+    {"weld_roundtrip_ratio", test_weld_roundtrip_ratio},
+    {"worst_case_bound", test_worst_case_bound},
+    {"random_access", test_random_access},
+    {"rejects", test_rejects},
+  };
+
+  return test_main(argc, argv, tests, sizeof(tests) / sizeof(tests[0]));
+}
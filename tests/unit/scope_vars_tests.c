@@ -0,0 +1,250 @@
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "scope_vars.h"
+#include "test_runner.h"
+
+#define TEST_SIG_U (0u) /**< Индекс `u` в стандартном наборе. */
+#define TEST_SIG_I_REF (1u) /**< Индекс `i_ref_used`. */
+#define TEST_SIG_I_MEAS (2u) /**< Индекс `i_meas`. */
+#define TEST_SIG_INTEG (6u) /**< Индекс `integrator`. */
+#define TEST_SIG_FLAGS (11u) /**< Индекс `flags`. */
+#define TEST_SIG_ENABLE (13u) /**< Индекс `enable_request`. */
+
+static scope_vars_t s_sv; /**< Контекст потока. */
+static control_out_t s_out; /**< Выход регулятора. */
+static control_ctx_t s_ctx; /**< Контекст регулятора. */
+static control_meas_t s_meas; /**< Измерения. */
+
+/**
+ * @brief Сбросить поток и зарегистрировать стандартный набор.
+ * @return Количество сигналов, [шт].
+ */
+static uint32_t test_setup(void)
+{
+  const control_out_t out0 = {0};
+  const control_meas_t meas0 = {0};
+  s_out = out0;
+  s_meas = meas0;
+  memset(&s_ctx, 0, sizeof(s_ctx));
+  scope_vars_init(&s_sv);
+  return scope_vars_add_control(&s_sv, &s_out, &s_ctx, &s_meas);
+}
+
+/**
+ * @brief Период PWM: гладкие переменные контура (как в сварке — ток и u меняются медленно).
+ * @param k Номер периода.
+ * @return None.
+ */
+static void test_step(uint32_t k)
+{
+  const float t = (float)k * 1e-3f;
+  s_meas.i_meas = 8000.0f + 200.0f * sinf(t * 6.0f);
+  s_out.i_ref_used = 8000.0f;
+  s_out.u = 0.45f + 0.01f * sinf(t * 6.0f);
+  s_ctx.state.integrator = 0.4f + 0.001f * (float)(k % 50u);
+  s_out.flags = (k > 100u) ? 0x3u : 0x1u;
+  s_out.enable_request = true;
+}
+
+/**
+ * @brief Реестр, маска и децимация: отсчёт каждые decim периодов, только выбранные сигналы.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_registry_mask_decim(test_ctx_t *ctx)
+{
+  test_expect_eq_u32(ctx, test_setup(), 14u, "standard set registered");
+  test_expect_true(ctx, !scope_vars_sample(&s_sv), "stream off by default");
+
+  const uint32_t mask = (1u << TEST_SIG_I_MEAS) | (1u << TEST_SIG_FLAGS) | (1u << TEST_SIG_ENABLE);
+  test_expect_true(ctx, scope_vars_configure(&s_sv, true, mask, 4u), "configure");
+  uint32_t written = 0u;
+  for (uint32_t k = 0u; k < 40u; ++k)
+  {
+    test_step(k);
+    written += scope_vars_sample(&s_sv) ? 1u : 0u;
+  }
+  test_expect_eq_u32(ctx, written, 10u, "one sample per 4 periods");
+  test_expect_eq_u32(ctx, s_sv.n_sel, 3u, "three signals selected");
+  test_expect_eq_u32(ctx, s_sv.ring[0].w[1], 0x1u, "flags copied raw");
+  test_expect_eq_u32(ctx, s_sv.ring[0].w[2], 1u, "bool copied as 1");
+  float v;
+  memcpy(&v, &s_sv.ring[0].w[0], sizeof(v));
+  test_expect_true(ctx, v > 7000.0f, "float copied bitwise");
+  test_expect_eq_u32(ctx, s_sv.stats.cnt_cfg_applied, 1u, "config applied once");
+}
+
+/**
+ * @brief pack/decode: значения совпадают с квантованными исходными, кадр меньше сырого.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_roundtrip_ratio(test_ctx_t *ctx)
+{
+  (void)test_setup();
+  const uint32_t mask = (1u << TEST_SIG_U) | (1u << TEST_SIG_I_REF) | (1u << TEST_SIG_I_MEAS) |
+                        (1u << TEST_SIG_INTEG) | (1u << TEST_SIG_FLAGS);
+  test_expect_true(ctx, scope_vars_configure(&s_sv, true, mask, 1u), "configure");
+  int32_t expect[60][5];
+  for (uint32_t k = 0u; k < 60u; ++k)
+  {
+    test_step(k);
+    (void)scope_vars_sample(&s_sv);
+    expect[k][0] = (int32_t)lrintf(s_out.u / 1e-5f);
+    expect[k][1] = (int32_t)lrintf(s_out.i_ref_used / 0.1f);
+    expect[k][2] = (int32_t)lrintf(s_meas.i_meas / 0.1f);
+    expect[k][3] = (int32_t)lrintf(s_ctx.state.integrator / 1e-5f);
+    expect[k][4] = (int32_t)s_out.flags;
+  }
+
+  uint8_t frame[SCOPE_VARS_FRAME_MAX];
+  int32_t values[255u * SCOPE_VARS_SLOT_WORDS];
+  uint32_t got = 0u;
+  uint32_t bytes = 0u;
+  bool ok = true;
+  for (uint32_t f = 0u; f < 10u; ++f)
+  {
+    const uint32_t len = scope_vars_pack(&s_sv, frame, sizeof(frame));
+    if (len == 0u)
+    {
+      break;
+    }
+    bytes += len;
+    scope_vars_frame_t hdr;
+    ok = ok && scope_vars_decode(frame, len, &hdr, values, sizeof(values) / sizeof(values[0]));
+    ok = ok && (hdr.mask == mask) && (hdr.n_sel == 5u) && (hdr.seq == got);
+    for (uint32_t k = 0u; ok && (k < hdr.n_samples); ++k)
+    {
+      ok = memcmp(&values[k * 5u], expect[got + k], sizeof(expect[0])) == 0;
+    }
+    got += hdr.n_samples;
+  }
+  test_expect_true(ctx, ok, "decoded values equal quantized inputs");
+  test_expect_eq_u32(ctx, got, 60u, "all samples delivered");
+  test_expect_true(ctx, (bytes * 2u) < (60u * 5u * 4u), "at least 2x smaller than raw u32");
+  test_expect_eq_u32(ctx, scope_vars_pack(&s_sv, frame, sizeof(frame)), 0u, "ring drained");
+}
+
+/**
+ * @brief Кольцо полно: отсчёты теряются и считаются, fast-домен не блокируется.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_ring_full_drop(test_ctx_t *ctx)
+{
+  (void)test_setup();
+  test_expect_true(ctx, scope_vars_configure(&s_sv, true, 1u << TEST_SIG_I_MEAS, 1u), "configure");
+  for (uint32_t k = 0u; k < (SCOPE_VARS_RING_SLOTS + 10u); ++k)
+  {
+    test_step(k);
+    (void)scope_vars_sample(&s_sv);
+  }
+  test_expect_eq_u32(ctx, s_sv.stats.cnt_drop, 10u, "overflow counted");
+  test_expect_eq_u32(ctx, s_sv.stats.ring_highwater, SCOPE_VARS_RING_SLOTS, "highwater = ring size");
+
+  uint8_t frame[SCOPE_VARS_FRAME_MAX];
+  scope_vars_frame_t hdr;
+  int32_t values[255];
+  const uint32_t len = scope_vars_pack(&s_sv, frame, sizeof(frame));
+  test_expect_true(ctx, scope_vars_decode(frame, len, &hdr, values, 255u), "decode");
+  test_expect_true(ctx, scope_vars_sample(&s_sv), "sample accepted after drain");
+  test_expect_eq_u32(ctx, s_sv.ring_seq[(SCOPE_VARS_RING_SLOTS) & (SCOPE_VARS_RING_SLOTS - 1u)],
+                     SCOPE_VARS_RING_SLOTS + 10u, "seq reveals the gap to the client");
+}
+
+/**
+ * @brief Смена конфигурации: кадр не смешивает отсчёты разных масок, поколение растёт.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_config_change_splits(test_ctx_t *ctx)
+{
+  (void)test_setup();
+  test_expect_true(ctx, scope_vars_configure(&s_sv, true, 1u << TEST_SIG_I_MEAS, 1u), "configure A");
+  test_expect_true(ctx, !scope_vars_configure(&s_sv, true, 1u << TEST_SIG_U, 1u), "busy until applied");
+  for (uint32_t k = 0u; k < 5u; ++k)
+  {
+    test_step(k);
+    (void)scope_vars_sample(&s_sv);
+  }
+  test_expect_true(ctx, scope_vars_configure(&s_sv, true, (1u << TEST_SIG_U) | (1u << TEST_SIG_FLAGS), 1u),
+                   "configure B");
+  for (uint32_t k = 5u; k < 10u; ++k)
+  {
+    test_step(k);
+    (void)scope_vars_sample(&s_sv);
+  }
+
+  uint8_t frame[SCOPE_VARS_FRAME_MAX];
+  scope_vars_frame_t a;
+  scope_vars_frame_t b;
+  int32_t values[255u * SCOPE_VARS_SLOT_WORDS];
+  const uint32_t cap = sizeof(values) / sizeof(values[0]);
+  test_expect_true(ctx, scope_vars_decode(frame, scope_vars_pack(&s_sv, frame, sizeof(frame)), &a, values, cap),
+                   "frame A");
+  test_expect_true(ctx, scope_vars_decode(frame, scope_vars_pack(&s_sv, frame, sizeof(frame)), &b, values, cap),
+                   "frame B");
+  test_expect_eq_u32(ctx, a.n_samples, 5u, "frame A holds only mask A");
+  test_expect_eq_u32(ctx, b.n_samples, 5u, "frame B holds only mask B");
+  test_expect_eq_u32(ctx, b.n_sel, 2u, "frame B carries two signals");
+  test_expect_eq_u32(ctx, (uint32_t)(uint8_t)(b.gen - a.gen), 1u, "generation advanced");
+  test_expect_eq_u32(ctx, (uint32_t)values[(4u * 2u) + 1u], 0x1u, "flags of last sample");
+}
+
+/**
+ * @brief Невалидные конфигурации и кадры отклоняются.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_rejects(test_ctx_t *ctx)
+{
+  (void)test_setup();
+  test_expect_true(ctx, !scope_vars_configure(&s_sv, true, 1u << 20, 1u), "unknown signal");
+  test_expect_true(ctx, !scope_vars_configure(&s_sv, true, 0x1FFFu, 1u), "more than SLOT_WORDS");
+  test_expect_true(ctx, !scope_vars_configure(&s_sv, true, 0x1u, 0u), "decimation 0");
+  test_expect_true(ctx, !scope_vars_configure(&s_sv, true, 0u, 1u), "empty mask with stream on");
+  test_expect_eq_u32(ctx, s_sv.stats.cnt_cfg_rejected, 4u, "rejections counted");
+  test_expect_true(ctx, scope_vars_add(&s_sv, "x", NULL, SCOPE_VAR_U32, 1.0f) < 0, "null pointer");
+  test_expect_true(ctx, scope_vars_add(&s_sv, "x", &s_out.u, SCOPE_VAR_F32, 0.0f) < 0, "zero scale");
+
+  // Насыщение квантования: значение вне диапазона int32 не переполняется.
+  test_expect_true(ctx, scope_vars_configure(&s_sv, true, 1u << TEST_SIG_U, 1u), "configure");
+  s_out.u = 1e30f;
+  (void)scope_vars_sample(&s_sv);
+  s_out.u = -1e30f;
+  (void)scope_vars_sample(&s_sv);
+  uint8_t frame[SCOPE_VARS_FRAME_MAX];
+  const uint32_t len = scope_vars_pack(&s_sv, frame, sizeof(frame));
+  scope_vars_frame_t hdr;
+  int32_t values[8];
+  test_expect_true(ctx, scope_vars_decode(frame, len, &hdr, values, 8u), "decode saturated");
+  test_expect_eq_u32(ctx, (uint32_t)values[0], (uint32_t)INT32_MAX, "positive saturation");
+  test_expect_eq_u32(ctx, (uint32_t)values[1], (uint32_t)(INT32_MIN + 1), "negative saturation");
+
+  test_expect_true(ctx, !scope_vars_decode(frame, len - 1u, &hdr, values, 8u), "truncated frame");
+  test_expect_true(ctx, !scope_vars_decode(frame, len, &hdr, values, 1u), "values capacity");
+  frame[0] = 0x02u;
+  test_expect_true(ctx, !scope_vars_decode(frame, len, &hdr, values, 8u), "foreign set id");
+}
+
+/**
+ * @brief Точка входа для L1 unit tests потока переменных контура.
+ * @param argc Количество аргументов командной строки, [шт].
+ * @param argv Массив аргументов командной строки.
+ * @return Код завершения (0 = OK).
+ */
+int main(int argc, char **argv)
+{
+  const test_case_t tests[] = {
+    {"registry_mask_decim", test_registry_mask_decim},
+    {"roundtrip_ratio", test_roundtrip_ratio},
+    {"ring_full_drop", test_ring_full_drop},
+    {"config_change_splits", test_config_change_splits},
+    {"rejects", test_rejects},
+  };
+
+  return test_main(argc, argv, tests, sizeof(tests) / sizeof(tests[0]));
+}
@@ -0,0 +1,329 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "settings_flash_emu.h"
+#include "settings_store.h"
+#include "test_runner.h"
+
+#define TEST_PAGE (2048u) /**< Страница G474 (dual-bank), [байт]. */
+#define TEST_IDS (4u) /**< ID в сценарии power-loss, [шт]. */
+#define TEST_LEN (100u) /**< Длина значения в сценарии power-loss, [байт]. */
+#define TEST_OPS (24u) /**< Сохранений в сценарии power-loss, [шт]. */
+
+static settings_flash_emu_t s_emu; /**< Эмулятор под тестом. */
+static settings_flash_emu_t s_base; /**< Снимок Flash перед сценарием. */
+
+/**
+ * @brief Смонтировать хранилище над эмулятором.
+ * @param st Контекст.
+ * @param emu Эмулятор.
+ * @return Результат settings_store_mount().
+ */
+static bool test_mount(settings_store_t *st, settings_flash_emu_t *emu)
+{
+  const settings_store_io_t io = settings_flash_emu_io(emu);
+  const settings_store_cfg_t cfg = {.page_size = emu->page_size, .page_count = emu->page_count};
+  return settings_store_mount(st, &io, &cfg);
+}
+
+/**
+ * @brief Значение операции `op` сценария (детерминированный шаблон).
+ * @param buf Буфер TEST_LEN байт.
+ * @param op Номер операции.
+ * @return None.
+ */
+static void test_value(uint8_t *buf, uint32_t op)
+{
+  for (uint32_t i = 0u; i < TEST_LEN; ++i)
+  {
+    buf[i] = (uint8_t)((op * 37u + i * 11u) & 0xFFu);
+  }
+}
+
+/**
+ * @brief Тест: CRC-32 (контрольное значение "123456789"), пустая Flash ⇒ defaults, сохранение/чтение после рестарта.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_mount_write_read(test_ctx_t *ctx)
+{
+  test_expect_eq_u32(ctx, settings_store_crc32(0u, "123456789", 9u), 0xCBF43926u, "crc32 check value");
+
+  (void)settings_flash_emu_init(&s_emu, TEST_PAGE, 2u);
+  settings_store_t st;
+  test_expect_true(ctx, test_mount(&st, &s_emu), "mount");
+  test_expect_eq_u32(ctx, st.diag, SETTINGS_STORE_DIAG_BLANK, "blank ⇒ defaults");
+  uint8_t buf[SETTINGS_STORE_VALUE_MAX];
+  uint32_t len = 0u;
+  test_expect_true(ctx, !settings_store_read(&st, 3u, buf, sizeof(buf), &len), "absent");
+
+  const float kp = 0.125f;
+  const uint8_t name[5] = {'P', 'R', 'O', 'F', '1'};
+  test_expect_eq_u32(ctx, settings_store_write(&st, 3u, &kp, sizeof(kp), true), SETTINGS_STORE_OK, "write kp");
+  test_expect_eq_u32(ctx, settings_store_write(&st, 7u, name, sizeof(name), true), SETTINGS_STORE_OK, "write name");
+  test_expect_eq_u32(ctx, settings_store_write(&st, 9u, NULL, 0u, true), SETTINGS_STORE_OK, "write empty");
+  test_expect_eq_u32(ctx, s_emu.cnt_erase[0] + s_emu.cnt_erase[1], 1u, "only first save erases");
+
+  /* Повторное сохранение того же значения не трогает Flash. */
+  const uint32_t programs = s_emu.cnt_program;
+  test_expect_eq_u32(ctx, settings_store_write(&st, 3u, &kp, sizeof(kp), true), SETTINGS_STORE_OK, "same value");
+  test_expect_eq_u32(ctx, s_emu.cnt_program, programs, "no program for unchanged value");
+  test_expect_eq_u32(ctx, st.stats.cnt_unchanged, 1u, "unchanged counted");
+
+  /* Сохранение настройки = одна запись (заголовок + 1 double-word), без erase. */
+  const float kp2 = 0.25f;
+  test_expect_eq_u32(ctx, settings_store_write(&st, 3u, &kp2, sizeof(kp2), true), SETTINGS_STORE_OK, "update");
+  test_expect_eq_u32(ctx, s_emu.cnt_program - programs, 2u, "2 double-words per tuning save");
+
+  settings_store_t st2;
+  (void)test_mount(&st2, &s_emu);
+  test_expect_eq_u32(ctx, st2.diag, 0u, "clean mount");
+  float kp_rd = 0.0f;
+  test_expect_true(ctx, settings_store_read(&st2, 3u, &kp_rd, sizeof(kp_rd), &len), "read kp");
+  test_expect_true(ctx, (len == sizeof(kp_rd)) && (kp_rd == kp2), "latest kp");
+  test_expect_true(ctx, settings_store_read(&st2, 7u, buf, sizeof(buf), &len), "read name");
+  test_expect_true(ctx, (len == sizeof(name)) && (memcmp(buf, name, sizeof(name)) == 0), "name");
+  test_expect_true(ctx, settings_store_read(&st2, 9u, buf, sizeof(buf), &len) && (len == 0u), "empty value");
+  test_expect_true(ctx, !settings_store_read(&st2, 7u, buf, 4u, &len), "buffer too small");
+}
+
+/**
+ * @brief Тест: многократные сохранения — уплотнения по кольцу из 4 страниц, износ равномерный, данные целы.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_compaction_wear(test_ctx_t *ctx)
+{
+  (void)settings_flash_emu_init(&s_emu, TEST_PAGE, 4u);
+  settings_store_t st;
+  (void)test_mount(&st, &s_emu);
+
+  uint8_t val[TEST_LEN];
+  for (uint32_t op = 0u; op < 2000u; ++op)
+  {
+    test_value(val, op);
+    const uint16_t id = (uint16_t)(op % 10u);
+    if (settings_store_write(&st, id, val, TEST_LEN, true) != SETTINGS_STORE_OK)
+    {
+      test_expect_true(ctx, false, "write failed");
+      return;
+    }
+  }
+  test_expect_true(ctx, st.stats.cnt_compact > 100u, "compactions happened");
+  uint32_t e_min = UINT32_MAX;
+  uint32_t e_max = 0u;
+  for (uint32_t p = 0u; p < 4u; ++p)
+  {
+    e_min = (s_emu.cnt_erase[p] < e_min) ? s_emu.cnt_erase[p] : e_min;
+    e_max = (s_emu.cnt_erase[p] > e_max) ? s_emu.cnt_erase[p] : e_max;
+  }
+  test_expect_true(ctx, (e_max - e_min) <= 1u, "wear levelled across ring");
+  test_expect_eq_u32(ctx, s_emu.cnt_prog_violation, 0u, "no program into non-erased double-word");
+
+  settings_store_t st2;
+  (void)test_mount(&st2, &s_emu);
+  uint8_t rd[TEST_LEN];
+  uint32_t len = 0u;
+  for (uint32_t id = 0u; id < 10u; ++id)
+  {
+    test_value(val, 1990u + id);
+    test_expect_true(ctx, settings_store_read(&st2, (uint16_t)id, rd, sizeof(rd), &len), "read back");
+    test_expect_true(ctx, memcmp(rd, val, TEST_LEN) == 0, "latest value after remount");
+  }
+}
+
+/**
+ * @brief Тест: power-loss на каждом шаге program/erase сценария с уплотнением — после рестарта каждое значение либо
+ *        последнее подтверждённое, либо (для оборванного сохранения) новое; хранилище продолжает работать.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_power_loss_every_step(test_ctx_t *ctx)
+{
+  (void)settings_flash_emu_init(&s_base, TEST_PAGE, 2u);
+  settings_store_t st;
+  (void)test_mount(&st, &s_base);
+  uint8_t init_val[TEST_IDS][TEST_LEN];
+  for (uint32_t id = 0u; id < TEST_IDS; ++id)
+  {
+    test_value(init_val[id], 1000u + id);
+    (void)settings_store_write(&st, (uint16_t)id, init_val[id], TEST_LEN, true);
+  }
+
+  /* Прогон без сбоев: число шагов и наличие уплотнения в сценарии. */
+  s_emu = s_base;
+  (void)test_mount(&st, &s_emu);
+  settings_flash_emu_arm(&s_emu, UINT32_MAX, 1u);
+  uint8_t val[TEST_LEN];
+  for (uint32_t op = 0u; op < TEST_OPS; ++op)
+  {
+    test_value(val, op);
+    (void)settings_store_write(&st, (uint16_t)(op % TEST_IDS), val, TEST_LEN, true);
+  }
+  const uint32_t steps = s_emu.step;
+  test_expect_true(ctx, st.stats.cnt_compact >= 1u, "scenario includes compaction");
+
+  uint32_t fails = 0u;
+  for (uint32_t k = 0u; k < steps; ++k)
+  {
+    s_emu = s_base;
+    (void)test_mount(&st, &s_emu);
+    settings_flash_emu_arm(&s_emu, k, k + 7u);
+
+    uint8_t committed[TEST_IDS][TEST_LEN];
+    memcpy(committed, init_val, sizeof(committed));
+    uint32_t torn_id = UINT32_MAX;
+    uint8_t torn_val[TEST_LEN];
+    for (uint32_t op = 0u; op < TEST_OPS; ++op)
+    {
+      const uint32_t id = op % TEST_IDS;
+      test_value(val, op);
+      if (settings_store_write(&st, (uint16_t)id, val, TEST_LEN, true) != SETTINGS_STORE_OK)
+      {
+        torn_id = id;
+        memcpy(torn_val, val, TEST_LEN);
+        break;
+      }
+      memcpy(committed[id], val, TEST_LEN);
+    }
+
+    // Рестарт: восстановление только по содержимому Flash.
+    settings_flash_emu_restore(&s_emu);
+    settings_store_t st2;
+    (void)test_mount(&st2, &s_emu);
+    bool ok = (torn_id != UINT32_MAX) && ((st2.diag & SETTINGS_STORE_DIAG_BLANK) == 0u);
+    uint8_t rd[TEST_LEN];
+    uint32_t len = 0u;
+    for (uint32_t id = 0u; ok && (id < TEST_IDS); ++id)
+    {
+      ok = settings_store_read(&st2, (uint16_t)id, rd, sizeof(rd), &len) && (len == TEST_LEN) &&
+           ((memcmp(rd, committed[id], TEST_LEN) == 0) || ((id == torn_id) && (memcmp(rd, torn_val, TEST_LEN) == 0)));
+    }
+
+    // Хранилище работоспособно после сбоя: новое сохранение видно после следующего рестарта.
+    test_value(val, 777u + k);
+    ok = ok && (settings_store_write(&st2, 0u, val, TEST_LEN, true) == SETTINGS_STORE_OK);
+    settings_store_t st3;
+    (void)test_mount(&st3, &s_emu);
+    ok = ok && settings_store_read(&st3, 0u, rd, sizeof(rd), &len) && (memcmp(rd, val, TEST_LEN) == 0);
+    for (uint32_t id = 1u; ok && (id < TEST_IDS); ++id)
+    {
+      ok = settings_store_read(&st3, (uint16_t)id, rd, sizeof(rd), &len) &&
+           ((memcmp(rd, committed[id], TEST_LEN) == 0) || ((id == torn_id) && (memcmp(rd, torn_val, TEST_LEN) == 0)));
+    }
+    ok = ok && (s_emu.cnt_prog_violation == 0u);
+    fails += (uint32_t)!ok;
+  }
+  test_expect_true(ctx, steps > 100u, "scenario long enough");
+  test_expect_eq_u32(ctx, fails, 0u, "every power-loss point recovers");
+}
+
+/**
+ * @brief Тест: оборванный program заголовка записи ⇒ двойная ошибка ECC при чтении (как ECCD на G474) —
+ *        запись пропускается как оборванный хвост, прежние значения и дальнейшие сохранения работают.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_torn_record_ecc(test_ctx_t *ctx)
+{
+  (void)settings_flash_emu_init(&s_emu, TEST_PAGE, 2u);
+  settings_store_t st;
+  (void)test_mount(&st, &s_emu);
+  uint8_t a[TEST_LEN];
+  uint8_t b[TEST_LEN];
+  uint8_t c[TEST_LEN];
+  test_value(a, 1u);
+  test_value(b, 2u);
+  test_value(c, 3u);
+  (void)settings_store_write(&st, 0u, a, TEST_LEN, true);
+  (void)settings_store_write(&st, 1u, b, TEST_LEN, true);
+
+  settings_flash_emu_arm(&s_emu, 0u, 5u);
+  test_expect_true(ctx, settings_store_write(&st, 0u, c, TEST_LEN, true) != SETTINGS_STORE_OK, "torn write");
+  settings_flash_emu_restore(&s_emu);
+
+  settings_store_t st2;
+  test_expect_true(ctx, test_mount(&st2, &s_emu), "mount over torn record");
+  test_expect_true(ctx, s_emu.cnt_ecc_double >= 1u, "torn double-word read as ECC error");
+  test_expect_true(ctx, (st2.diag & SETTINGS_STORE_DIAG_TORN_TAIL) != 0u, "torn tail reported");
+  uint8_t rd[TEST_LEN];
+  uint32_t len = 0u;
+  test_expect_true(ctx, settings_store_read(&st2, 0u, rd, sizeof(rd), &len) && (memcmp(rd, a, TEST_LEN) == 0),
+                   "previous value kept");
+  test_expect_true(ctx, settings_store_read(&st2, 1u, rd, sizeof(rd), &len) && (memcmp(rd, b, TEST_LEN) == 0),
+                   "other value kept");
+
+  test_expect_eq_u32(ctx, settings_store_write(&st2, 0u, c, TEST_LEN, true), SETTINGS_STORE_OK, "write after ECC");
+  settings_store_t st3;
+  (void)test_mount(&st3, &s_emu);
+  test_expect_true(ctx, settings_store_read(&st3, 0u, rd, sizeof(rd), &len) && (memcmp(rd, c, TEST_LEN) == 0),
+                   "new value after restart");
+  test_expect_eq_u32(ctx, s_emu.cnt_prog_violation, 0u, "no program over torn double-word");
+}
+
+/**
+ * @brief Тест: запись вне IDLE, параметры вне диапазона и переполнение отклоняются без изменения данных.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_rejects(test_ctx_t *ctx)
+{
+  (void)settings_flash_emu_init(&s_emu, TEST_PAGE, 2u);
+  settings_store_t st;
+  (void)test_mount(&st, &s_emu);
+
+  const uint32_t v = 42u;
+  test_expect_eq_u32(ctx, settings_store_write(&st, 1u, &v, sizeof(v), false), SETTINGS_STORE_ERR_NOT_IDLE,
+                     "not idle");
+  test_expect_eq_u32(ctx, s_emu.cnt_program + s_emu.cnt_erase[0] + s_emu.cnt_erase[1], 0u, "flash untouched");
+  test_expect_eq_u32(ctx, settings_store_write(&st, SETTINGS_STORE_IDS_MAX, &v, sizeof(v), true),
+                     SETTINGS_STORE_ERR_PARAM, "id out of range");
+  uint8_t big[SETTINGS_STORE_VALUE_MAX + 1u];
+  memset(big, 0x5A, sizeof(big));
+  test_expect_eq_u32(ctx, settings_store_write(&st, 1u, big, sizeof(big), true), SETTINGS_STORE_ERR_PARAM,
+                     "value too long");
+
+  /* 7 значений по 256 байт (7·264 + 16 = 1864) помещаются, 8-е (2128) — нет. */
+  settings_store_status_t res = SETTINGS_STORE_OK;
+  uint16_t id = 0u;
+  for (; (id < 8u) && (res == SETTINGS_STORE_OK); ++id)
+  {
+    big[0] = (uint8_t)id;
+    res = settings_store_write(&st, id, big, SETTINGS_STORE_VALUE_MAX, true);
+  }
+  test_expect_eq_u32(ctx, res, SETTINGS_STORE_ERR_FULL, "page full");
+  test_expect_eq_u32(ctx, id, 8u, "8th value rejected");
+
+  settings_store_t st2;
+  (void)test_mount(&st2, &s_emu);
+  uint8_t rd[SETTINGS_STORE_VALUE_MAX];
+  uint32_t len = 0u;
+  test_expect_true(ctx, settings_store_read(&st2, 6u, rd, sizeof(rd), &len) && (rd[0] == 6u), "earlier data kept");
+  test_expect_true(ctx, !settings_store_read(&st2, 7u, rd, sizeof(rd), &len), "rejected value absent");
+
+  settings_store_cfg_t bad = {.page_size = TEST_PAGE, .page_count = 1u};
+  const settings_store_io_t io = settings_flash_emu_io(&s_emu);
+  test_expect_true(ctx, !settings_store_mount(&st, &io, &bad), "single page rejected");
+  test_expect_eq_u32(ctx, settings_store_write(&st, 1u, &v, sizeof(v), true), SETTINGS_STORE_ERR_PARAM,
+                     "unmounted");
+}
+
+/**
+ * @brief Точка входа для L1 unit tests хранилища настроек.
+ * @param argc Количество аргументов командной строки, [шт].
+ * @param argv Массив аргументов командной строки.
+ * @return Код завершения (0 = OK).
+ */
+int main(int argc, char **argv)
+{
+  const test_case_t tests[] = {
+    {"mount_write_read", test_mount_write_read},
+    {"compaction_wear", test_compaction_wear},
+    {"power_loss_every_step", test_power_loss_every_step},
+    {"torn_record_ecc", test_torn_record_ecc},
+    {"rejects", test_rejects},
+  };
+
+  return test_main(argc, argv, tests, sizeof(tests) / sizeof(tests[0]));
+}
@@ -0,0 +1,219 @@
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "safety_supervisor.h"
+#include "state_machine.h"
+#include "test_runner.h"
+
+/**
+ * @brief Эталонная модель переходов (независимо от таблицы в state_machine.c).
+ * @param from Исходное состояние.
+ * @param event Событие.
+ * @param allow Выход safety_supervisor `allow`.
+ * @return Ожидаемое состояние после dispatch.
+ */
+static sm_state_t test_oracle(sm_state_t from, sm_event_t event, bool allow)
+{
+  if (from == SM_STATE_FAULT)
+  {
+    return ((event == SM_EVT_FAULT_RESET) && allow) ? SM_STATE_IDLE : SM_STATE_FAULT;
+  }
+  switch (event)
+  {
+    case SM_EVT_SAFETY_TRIP:
+      return allow ? from : SM_STATE_FAULT;
+    case SM_EVT_REQ_IDLE:
+      return SM_STATE_IDLE;
+    case SM_EVT_REQ_ARMED:
+      return ((from != SM_STATE_IDLE) || allow) ? SM_STATE_ARMED : from;
+    case SM_EVT_REQ_WELD:
+      return ((from == SM_STATE_WELD) || ((from == SM_STATE_ARMED) && allow)) ? SM_STATE_WELD : from;
+    default:
+      return from;
+  }
+}
+
+/**
+ * @brief Перевести автомат в заданное состояние штатной последовательностью событий.
+ * @param sm Контекст.
+ * @param target Целевое состояние.
+ * @return None.
+ */
+static void test_drive_to(sm_ctx_t *sm, sm_state_t target)
+{
+  const safety_out_t ok = {.allow = true};
+  const safety_out_t trip = {.allow = false, .latched = SAFETY_HARD_DRV_FAULT};
+  state_machine_init(sm);
+  if (target == SM_STATE_FAULT)
+  {
+    (void)state_machine_dispatch(sm, SM_EVT_SAFETY_TRIP, &trip, 0u);
+    return;
+  }
+  if (target != SM_STATE_IDLE)
+  {
+    (void)state_machine_dispatch(sm, SM_EVT_REQ_ARMED, &ok, 0u);
+  }
+  if (target == SM_STATE_WELD)
+  {
+    (void)state_machine_dispatch(sm, SM_EVT_REQ_WELD, &ok, 0u);
+  }
+}
+
+/**
+ * @brief Тест: все пары (состояние, событие) × (allow/запрет) совпадают с эталонной моделью.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_exhaustive_pairs(test_ctx_t *ctx)
+{
+  uint32_t mismatches = 0u;
+  for (uint32_t s = 0u; s < (uint32_t)SM_STATE_COUNT; ++s)
+  {
+    for (uint32_t e = 0u; e < (uint32_t)SM_EVT_COUNT; ++e)
+    {
+      for (uint32_t a = 0u; a < 2u; ++a)
+      {
+        sm_ctx_t sm;
+        test_drive_to(&sm, (sm_state_t)s);
+        if ((uint32_t)sm.state != s)
+        {
+          mismatches++;
+          continue;
+        }
+        const safety_out_t safety = {.allow = (a != 0u), .latched = (a != 0u) ? 0u : SAFETY_SOFT_OVERRUN};
+        const uint32_t transitions = sm.cnt_transitions;
+        const bool moved = state_machine_dispatch(&sm, (sm_event_t)e, &safety, 0u);
+        const sm_state_t expected = test_oracle((sm_state_t)s, (sm_event_t)e, a != 0u);
+        mismatches += (sm.state != expected) ? 1u : 0u;
+        mismatches += (moved != (expected != (sm_state_t)s)) ? 1u : 0u;
+        mismatches += ((sm.cnt_transitions - transitions) != (moved ? 1u : 0u)) ? 1u : 0u;
+      }
+    }
+  }
+  test_expect_eq_u32(ctx, mismatches, 0u, "table matches oracle for all pairs");
+}
+
+/**
+ * @brief Тест: недопустимые события и неизвестный код события отклоняются и учитываются.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_rejected_events(test_ctx_t *ctx)
+{
+  const safety_out_t ok = {.allow = true};
+  sm_ctx_t sm;
+  state_machine_init(&sm);
+
+  test_expect_true(ctx, !state_machine_dispatch(&sm, SM_EVT_REQ_WELD, &ok, 0u), "no IDLE->WELD");
+  test_expect_true(ctx, !state_machine_dispatch(&sm, (sm_event_t)200u, &ok, 0u), "unknown event");
+  test_expect_true(ctx, !state_machine_dispatch(&sm, SM_EVT_REQ_IDLE, &ok, 0u), "self IDLE");
+  test_expect_eq_u32(ctx, sm.state, SM_STATE_IDLE, "still IDLE");
+  test_expect_eq_u32(ctx, sm.cnt_rejected, 2u, "self-request not counted as rejected");
+}
+
+/**
+ * @brief Тест: штатный цикл + trip + recovery пишет trace в порядке переходов.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_trace_sequence(test_ctx_t *ctx)
+{
+  const safety_out_t ok = {.allow = true};
+  const safety_out_t trip = {.allow = false, .latched = SAFETY_HARD_OVERCURRENT};
+  sm_ctx_t sm;
+  state_machine_init(&sm);
+
+  (void)state_machine_dispatch(&sm, SM_EVT_REQ_ARMED, &ok, 100u);
+  (void)state_machine_dispatch(&sm, SM_EVT_REQ_WELD, &ok, 200u);
+  (void)state_machine_dispatch(&sm, SM_EVT_SAFETY_TRIP, &trip, 300u);
+  test_expect_true(ctx, !state_machine_dispatch(&sm, SM_EVT_FAULT_RESET, &trip, 400u), "no reset while latched");
+  (void)state_machine_dispatch(&sm, SM_EVT_FAULT_RESET, &ok, 500u);
+
+  const uint8_t exp_to[] = {SM_STATE_ARMED, SM_STATE_WELD, SM_STATE_FAULT, SM_STATE_IDLE};
+  const uint32_t exp_t[] = {100u, 200u, 300u, 500u};
+  sm_trace_entry_t entry;
+  uint32_t n = 0u;
+  bool ok_seq = true;
+  while (state_machine_trace_pop(&sm, &entry))
+  {
+    ok_seq = ok_seq && (n < 4u) && (entry.to == exp_to[n]) && (entry.t_us == exp_t[n]);
+    n++;
+  }
+  test_expect_eq_u32(ctx, n, 4u, "trace entries");
+  test_expect_true(ctx, ok_seq, "trace order/time");
+  test_expect_eq_u32(ctx, sm.state, SM_STATE_IDLE, "recovered to IDLE");
+}
+
+/**
+ * @brief Тест: переполнение trace не блокирует переходы и учитывается.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_trace_overflow(test_ctx_t *ctx)
+{
+  const safety_out_t ok = {.allow = true};
+  sm_ctx_t sm;
+  state_machine_init(&sm);
+
+  for (uint32_t i = 0u; i < (2u * SM_TRACE_LEN); ++i)
+  {
+    (void)state_machine_dispatch(&sm, ((i & 1u) == 0u) ? SM_EVT_REQ_ARMED : SM_EVT_REQ_IDLE, &ok, i);
+  }
+  test_expect_eq_u32(ctx, sm.cnt_transitions, 2u * SM_TRACE_LEN, "all transitions done");
+  test_expect_eq_u32(ctx, sm.cnt_trace_dropped, SM_TRACE_LEN, "overflow counted");
+
+  sm_trace_entry_t entry;
+  test_expect_true(ctx, state_machine_trace_pop(&sm, &entry), "pop");
+  test_expect_eq_u32(ctx, entry.t_us, 0u, "oldest kept");
+  (void)state_machine_dispatch(&sm, SM_EVT_REQ_ARMED, &ok, 1000u);
+  test_expect_eq_u32(ctx, sm.cnt_trace_dropped, SM_TRACE_LEN, "room after pop");
+}
+
+/**
+ * @brief Тест: связка с safety_supervisor — HARD trip ⇒ FAULT, recovery только после снятия latch.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_with_supervisor(test_ctx_t *ctx)
+{
+  safety_supervisor_t sup;
+  safety_out_t safety;
+  sm_ctx_t sm;
+  safety_supervisor_init(&sup, NULL);
+  state_machine_init(&sm);
+
+  safety_supervisor_step(&sup, 0u, &safety);
+  (void)state_machine_dispatch(&sm, SM_EVT_REQ_ARMED, &safety, 0u);
+  (void)state_machine_dispatch(&sm, SM_EVT_REQ_WELD, &safety, 0u);
+
+  safety_supervisor_step(&sup, SAFETY_HARD_DRV_FAULT, &safety);
+  (void)state_machine_dispatch(&sm, SM_EVT_SAFETY_TRIP, &safety, 0u);
+  test_expect_eq_u32(ctx, sm.state, SM_STATE_FAULT, "trip to FAULT");
+
+  safety_supervisor_step(&sup, 0u, &safety);
+  test_expect_true(ctx, !state_machine_dispatch(&sm, SM_EVT_FAULT_RESET, &safety, 0u), "latch blocks reset");
+
+  safety_supervisor_request_clear(&sup, SAFETY_CLEAR_ALL);
+  safety_supervisor_step(&sup, 0u, &safety);
+  test_expect_true(ctx, state_machine_dispatch(&sm, SM_EVT_FAULT_RESET, &safety, 0u), "reset after clear");
+  test_expect_eq_u32(ctx, sm.state, SM_STATE_IDLE, "IDLE after recovery");
+}
+
+/**
+ * @brief Точка входа для L1 unit tests state machine.
+ * @param argc Количество аргументов командной строки, [шт].
+ * @param argv Массив аргументов командной строки.
+ * @return Код завершения (0 = OK).
+ */
+int main(int argc, char **argv)
+{
+  const test_case_t tests[] = {
+    {"exhaustive_pairs", test_exhaustive_pairs},
+    {"rejected_events", test_rejected_events},
+    {"trace_sequence", test_trace_sequence},
+    {"trace_overflow", test_trace_overflow},
+    {"with_supervisor", test_with_supervisor},
+  };
+
+  return test_main(argc, argv, tests, sizeof(tests) / sizeof(tests[0]));
+}
@@ -0,0 +1,184 @@
+#include "test_runner.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief Получить модуль числа.
+ * @param value Входное значение, [отн. ед.].
+ * @return Модуль значения, [отн. ед.].
+ */
+static float test_abs_f(float value)
+{
+  return (value < 0.0f) ? -value : value;
+}
+
+void test_expect_true(test_ctx_t *ctx, bool condition, const char *message)
+{
+  if (!condition)
+  {
+    ctx->failed += 1;
+    (void)printf("FAIL: %s\n", message);
+  }
+}
+
+void test_expect_close(test_ctx_t *ctx, float actual, float expected, float tol, const char *message)
+{
+  const float diff = test_abs_f(actual - expected); /* [отн. ед.] */
+  if (!(diff <= tol))
+  {
+    ctx->failed += 1;
+    (void)printf("FAIL: %s (actual=%.6f expected=%.6f tol=%.6f)\n", message, actual, expected, tol);
+  }
+}
+
+void test_expect_eq_u32(test_ctx_t *ctx, uint32_t actual, uint32_t expected, const char *message)
+{
+  if (actual != expected)
+  {
+    ctx->failed += 1;
+    (void)printf("FAIL: %s (actual=0x%08lX expected=0x%08lX)\n",
+                 message,
+                 (unsigned long)actual,
+                 (unsigned long)expected);
+  }
+}
+
+uint32_t test_rand_u32(uint32_t *state)
+{
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *state = x;
+  return x;
+}
+
+uint64_t test_now_ns(void)
+{
+  struct timespec ts;
+  (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Проверить, что имя теста совпадает с фильтром.
+ * @param name Имя теста, [строка].
+ * @param filter Фильтр (подстрока) или NULL, [строка].
+ * @return true, если тест должен быть запущен.
+ */
+static bool test_matches_filter(const char *name, const char *filter)
+{
+  if (filter == NULL)
+  {
+    return true;
+  }
+  if (filter[0] == '\0')
+  {
+    return true;
+  }
+  return (strstr(name, filter) != NULL);
+}
+
+/**
+ * @brief Вывести список доступных тестов.
+ * @param tests Массив тестов.
+ * @param count Количество тестов, [шт].
+ * @return None.
+ */
+static void test_print_list(const test_case_t *tests, size_t count)
+{
+  (void)printf("Available tests (%zu):\n", count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    (void)printf("  %s\n", tests[i].name);
+  }
+}
+
+/**
+ * @brief Запустить набор тестов с фильтром по имени.
+ * @param ctx Контекст тестов.
+ * @param tests Массив тестов.
+ * @param count Количество тестов, [шт].
+ * @param filter Фильтр по имени (подстрока) или NULL.
+ * @return Количество реально запущенных тестов, [шт].
+ */
+static size_t test_run_filtered(test_ctx_t *ctx,
+                                const test_case_t *tests,
+                                size_t count,
+                                const char *filter)
+{
+  size_t executed = 0;
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (!test_matches_filter(tests[i].name, filter))
+    {
+      continue;
+    }
+    executed += 1u;
+    tests[i].fn(ctx);
+  }
+
+  return executed;
+}
+
+int test_main(int argc, char **argv, const test_case_t *tests, size_t count)
+{
+  test_ctx_t ctx = {0};
+
+  const char *filter = NULL;
+  bool list_only = false;
+  bool exact_run = false;
+
+  if (argc == 1)
+  {
+    /* default */
+  }
+  else if ((argc == 2) && (strcmp(argv[1], "--list") == 0))
+  {
+    list_only = true;
+  }
+  else if ((argc == 3) && (strcmp(argv[1], "--filter") == 0))
+  {
+    filter = argv[2];
+  }
+  else if ((argc == 3) && (strcmp(argv[1], "--run") == 0))
+  {
+    filter = argv[2];
+    exact_run = true;
+  }
+  else
+  {
+    (void)printf("Usage:\n");
+    (void)printf("  %s\n", argv[0]);
+    (void)printf("  %s --list\n", argv[0]);
+    (void)printf("  %s --filter <substring>\n", argv[0]);
+    (void)printf("  %s --run <name>\n", argv[0]);
+    return 2;
+  }
+
+  if (list_only)
+  {
+    test_print_list(tests, count);
+    return 0;
+  }
+
+  const size_t executed = test_run_filtered(&ctx, tests, count, filter);
+  if (exact_run && (executed != 1u))
+  {
+    (void)printf("FAIL: test '%s' not found.\n", filter);
+    test_print_list(tests, count);
+    return 2;
+  }
+
+  if (ctx.failed != 0)
+  {
+    (void)printf("Tests failed: %d\n", ctx.failed);
+    return 1;
+  }
+
+  (void)printf("All tests passed.\n");
+  return 0;
+}
@@ -0,0 +1,107 @@
+#ifndef TEST_RUNNER_H
+#define TEST_RUNNER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file test_runner.h
+ * @brief Минимальный раннер L1 unit tests (общий для всех `*_tests.c`).
+ * @details
+ * Раннер намеренно не зависит от внешних фреймворков: тест — обычная функция,
+ * проверки считают провалы в контексте, `main()` разбирает `--list/--filter/--run`.
+ */
+
+/**
+ * @brief Контекст простого тестового раннера.
+ */
+typedef struct {
+  int failed; /**< Количество проваленных проверок, [шт]. */
+} test_ctx_t;
+
+/**
+ * @brief Тип функции теста.
+ */
+typedef void (*test_fn_t)(test_ctx_t *ctx);
+
+/**
+ * @brief Описание одного теста.
+ */
+typedef struct {
+  const char *name; /**< Имя теста (стабильный идентификатор), [строка]. */
+  test_fn_t fn;     /**< Указатель на функцию теста. */
+} test_case_t;
+
+/**
+ * @brief Проверить булево условие.
+ * @param ctx Контекст тестов.
+ * @param condition Условие.
+ * @param message Сообщение об ошибке.
+ * @return None.
+ */
+void test_expect_true(test_ctx_t *ctx, bool condition, const char *message);
+
+/**
+ * @brief Проверить близость чисел с допуском.
+ * @param ctx Контекст тестов.
+ * @param actual Фактическое значение, [отн. ед.].
+ * @param expected Ожидаемое значение, [отн. ед.].
+ * @param tol Допуск, [отн. ед.].
+ * @param message Сообщение об ошибке.
+ * @return None.
+ */
+void test_expect_close(test_ctx_t *ctx, float actual, float expected, float tol, const char *message);
+
+/**
+ * @brief Проверить равенство целых чисел.
+ * @param ctx Контекст тестов.
+ * @param actual Фактическое значение.
+ * @param expected Ожидаемое значение.
+ * @param message Сообщение об ошибке.
+ * @return None.
+ */
+void test_expect_eq_u32(test_ctx_t *ctx, uint32_t actual, uint32_t expected, const char *message);
+
+/**
+ * @brief Псевдослучайный генератор для fuzz/рандомизированных тестов (xorshift32).
+ * @param state Указатель на состояние генератора (не 0).
+ * @return Следующее псевдослучайное значение.
+ * @note Детерминирован: одинаковый seed ⇒ одинаковая последовательность (воспроизводимость в CI).
+ */
+uint32_t test_rand_u32(uint32_t *state);
+
+/**
+ * @brief Монотонное время (CLOCK_MONOTONIC) для замеров производительности на host.
+ * @return Время, [нс].
+ * @note Замеры печатаются (`INFO:`); порогом проверяются только требования с большим запасом (разбор PCcom4
+ *       относительно линии FT232H), чтобы нагрузка CI не роняла тесты.
+ */
+uint64_t test_now_ns(void);
+
+/**
+ * @brief Точка входа L1 теста: разбор аргументов и запуск набора.
+ * @param argc Количество аргументов командной строки, [шт].
+ * @param argv Массив аргументов командной строки.
+ * @param tests Массив тестов.
+ * @param count Количество тестов, [шт].
+ * @return Код завершения (0 = OK, 1 = провалы, 2 = ошибка использования).
+ *
+ * @details
+ * Поддерживаемые режимы:
+ * - без аргументов: запустить все тесты;
+ * - `--list`: вывести список тестов;
+ * - `--filter <substring>`: запустить тесты, чьи имена содержат подстроку;
+ * - `--run <name>`: запустить один тест по точному имени.
+ */
+int test_main(int argc, char **argv, const test_case_t *tests, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TEST_RUNNER_H */
@@ -0,0 +1,338 @@
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "control_core.h"
+#include "test_runner.h"
+#include "tk_cmd_rx.h"
+
+/**
+ * @brief Собрать валидную команду WELD.
+ * @param seq Номер кадра, [-].
+ * @param i_ref_ma Уставка, [mA].
+ * @return Команда.
+ */
+static tk_cmd_weld_t test_make_cmd(uint16_t seq, int32_t i_ref_ma)
+{
+  const tk_cmd_weld_t cmd = {
+    .seq = seq,
+    .mode = TK_MODE_WELD,
+    .enable = 1u,
+    .i_ref_cmd_ma = i_ref_ma,
+    .max_slew_rate_a_ms = 0u,
+    .fault_reset = 0u,
+    .must_be_zero = 0u
+  };
+  return cmd;
+}
+
+/**
+ * @brief Инициализировать control_core без slew/интегратора (выход = kp * ошибка).
+ * @param ctrl Контекст control_core.
+ * @return None.
+ */
+static void test_init_control(control_ctx_t *ctrl)
+{
+  /* Единицы полей см. control_cfg_t. */
+  const control_cfg_t cfg = {
+    .kp = 1.0f,
+    .ki = 0.0f,
+    .dt = 0.001f,
+    .u_min = -1.0e9f,
+    .u_max = 1.0e9f,
+    .i_ref_min = 0.0f,
+    .i_ref_max = 50000.0f,
+    .di_dt_max = 0.0f,
+    .integrator_policy = CONTROL_INTEGRATOR_RESET
+  };
+  control_init(ctrl, &cfg);
+}
+
+/**
+ * @brief Тест: первый кадр, нормальная последовательность и wrap-around применяются без gap.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_first_next_wrap_apply(test_ctx_t *ctx)
+{
+  tk_cmd_rx_t rx;
+  tk_cmd_rx_init(&rx);
+
+  tk_cmd_weld_t cmd = test_make_cmd(0xFFFEu, 1000);
+  test_expect_eq_u32(ctx, tk_cmd_rx_process(&rx, &cmd, false, NULL), TK_CMD_RX_APPLY, "first frame applied");
+  test_expect_eq_u32(ctx, rx.last_seq_class, TK_SEQ_FIRST, "first frame classified FIRST");
+
+  cmd.seq = 0xFFFFu;
+  test_expect_eq_u32(ctx, tk_cmd_rx_process(&rx, &cmd, false, NULL), TK_CMD_RX_APPLY, "next applied");
+  cmd.seq = 0x0000u;
+  test_expect_eq_u32(ctx, tk_cmd_rx_process(&rx, &cmd, false, NULL), TK_CMD_RX_APPLY, "wrap applied");
+
+  test_expect_eq_u32(ctx, tk_cmd_rx_seq_applied(&rx), 0u, "seq_applied follows wrap");
+  test_expect_eq_u32(ctx, rx.cnt_seq_gap, 0u, "no gaps on contiguous stream");
+  test_expect_eq_u32(ctx, rx.status_bits, 0u, "no status bits on contiguous stream");
+}
+
+/**
+ * @brief Тест: repeat и backward отвергаются, seq_applied не меняется.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_repeat_backward_reject(test_ctx_t *ctx)
+{
+  tk_cmd_rx_t rx;
+  tk_cmd_rx_init(&rx);
+
+  tk_cmd_weld_t cmd = test_make_cmd(100u, 1000);
+  (void)tk_cmd_rx_process(&rx, &cmd, false, NULL);
+
+  test_expect_eq_u32(ctx, tk_cmd_rx_process(&rx, &cmd, false, NULL), TK_CMD_RX_REJECT, "repeat rejected");
+  test_expect_true(ctx, (rx.last_reject_mask & TK_CMD_REJECT_SEQ_REPEAT) != 0u, "repeat reason recorded");
+
+  cmd.seq = 99u;
+  test_expect_eq_u32(ctx, tk_cmd_rx_process(&rx, &cmd, false, NULL), TK_CMD_RX_REJECT, "backward rejected");
+  test_expect_true(ctx, (rx.last_reject_mask & TK_CMD_REJECT_SEQ_BACKWARD) != 0u, "backward reason recorded");
+
+  test_expect_eq_u32(ctx, tk_cmd_rx_seq_applied(&rx), 100u, "seq_applied unchanged by rejects");
+  test_expect_eq_u32(ctx, rx.cnt_cmd_reject, 2u, "cnt_cmd_reject counts rejects");
+  test_expect_true(ctx, (rx.status_bits & TK_STATUS_CMD_REJECTED) != 0u, "CMD_REJECTED set");
+
+  cmd.seq = 101u;
+  test_expect_eq_u32(ctx, tk_cmd_rx_process(&rx, &cmd, false, NULL), TK_CMD_RX_APPLY, "next after rejects applied");
+  test_expect_true(ctx, (rx.status_bits & TK_STATUS_CMD_REJECTED) == 0u, "CMD_REJECTED cleared by APPLY");
+}
+
+/**
+ * @brief Тест: gap применяется, выставляет SEQ_GAP_DETECTED и cnt_seq_gap; сброс при delta==1.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_gap_apply_and_clear(test_ctx_t *ctx)
+{
+  tk_cmd_rx_t rx;
+  tk_cmd_rx_init(&rx);
+
+  tk_cmd_weld_t cmd = test_make_cmd(10u, 1000);
+  (void)tk_cmd_rx_process(&rx, &cmd, false, NULL);
+  cmd.seq = 15u;
+  test_expect_eq_u32(ctx, tk_cmd_rx_process(&rx, &cmd, false, NULL), TK_CMD_RX_APPLY, "gap applied");
+  test_expect_true(ctx, (rx.status_bits & TK_STATUS_SEQ_GAP_DETECTED) != 0u, "SEQ_GAP_DETECTED set");
+  test_expect_eq_u32(ctx, rx.cnt_seq_gap, 1u, "cnt_seq_gap incremented");
+
+  cmd.seq = 16u;
+  (void)tk_cmd_rx_process(&rx, &cmd, false, NULL);
+  test_expect_true(ctx, (rx.status_bits & TK_STATUS_SEQ_GAP_DETECTED) == 0u, "SEQ_GAP_DETECTED cleared on delta==1");
+  test_expect_eq_u32(ctx, rx.cnt_seq_gap, 1u, "cnt_seq_gap is cumulative");
+
+  tk_fb_status_t status = {0};
+  status.status_word = TK_STATUS_READY;
+  tk_cmd_rx_fill_status(&rx, &status);
+  test_expect_eq_u32(ctx, status.seq_applied, 16u, "status seq_applied");
+  test_expect_eq_u32(ctx, status.cnt_seq_gap, 1u, "status cnt_seq_gap");
+  test_expect_eq_u32(ctx, status.status_word, TK_STATUS_READY, "foreign status bits preserved");
+}
+
+/**
+ * @brief Тест: невалидные поля отвергаются и не публикуются в control_core.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_invalid_fields_not_published(test_ctx_t *ctx)
+{
+  control_ctx_t ctrl;
+  test_init_control(&ctrl);
+  tk_cmd_rx_t rx;
+  tk_cmd_rx_init(&rx);
+
+  tk_cmd_weld_t cmd = test_make_cmd(1u, 2000000); /* 2000 A */
+  (void)tk_cmd_rx_process(&rx, &cmd, false, &ctrl);
+
+  cmd.seq = 2u;
+  cmd.i_ref_cmd_ma = TK_I_REF_MAX_MA + 1;
+  test_expect_eq_u32(ctx, tk_cmd_rx_process(&rx, &cmd, false, &ctrl), TK_CMD_RX_REJECT, "out-of-range rejected");
+  cmd.i_ref_cmd_ma = 3000000;
+  cmd.must_be_zero = 1u;
+  test_expect_eq_u32(ctx, tk_cmd_rx_process(&rx, &cmd, false, &ctrl), TK_CMD_RX_REJECT, "reserved rejected");
+
+  const control_meas_t meas = {.i_meas = 0.0f, .u_meas = 0.0f, .udc = 0.0f, .meas_valid = true};
+  control_out_t out = {0};
+  control_fast_step(&ctrl, &meas, true, &out);
+  test_expect_close(ctx, out.i_ref_used, 2000.0f, 1e-3f, "fast loop keeps last valid command");
+  test_expect_eq_u32(ctx, tk_cmd_rx_seq_applied(&rx), 1u, "seq_applied of last valid command");
+}
+
+/**
+ * @brief Тест: cmd-rate 4 кГц при PWM 1 кГц — fast-домен защёлкивает последнюю валидную команду без ложных gap.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_latch_last_valid_at_pwm_boundary(test_ctx_t *ctx)
+{
+  control_ctx_t ctrl;
+  test_init_control(&ctrl);
+  tk_cmd_rx_t rx;
+  tk_cmd_rx_init(&rx);
+
+  const control_meas_t meas = {.i_meas = 0.0f, .u_meas = 0.0f, .udc = 0.0f, .meas_valid = true};
+  control_out_t out = {0};
+  uint16_t seq = 0u;
+
+  for (uint32_t pwm_period = 0u; pwm_period < 10u; ++pwm_period)
+  {
+    /* 4 команды на период PWM 1 кГц (250 мкс каждая); уставка растёт на 1 A с каждой командой. */
+    for (uint32_t sub = 0u; sub < 4u; ++sub)
+    {
+      const tk_cmd_weld_t cmd = test_make_cmd(seq, (int32_t)(seq + 1u) * 1000);
+      (void)tk_cmd_rx_process(&rx, &cmd, false, &ctrl);
+      seq = (uint16_t)(seq + 1u);
+    }
+    control_fast_step(&ctrl, &meas, true, &out);
+    test_expect_close(ctx, out.i_ref_used, (float)seq, 1e-3f, "fast loop uses last published command");
+    test_expect_true(ctx, out.enable_request, "enable_request for valid WELD command");
+  }
+
+  test_expect_eq_u32(ctx, rx.cnt_seq_gap, 0u, "no false SEQ_GAP at cmd-rate > PWM-rate");
+  test_expect_eq_u32(ctx, tk_cmd_rx_seq_applied(&rx), (uint32_t)(uint16_t)(seq - 1u), "seq_applied is last command");
+}
+
+/**
+ * @brief Тест: ARMED не подаёт энергию, restart_seq даёт FIRST без gap.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_armed_and_restart(test_ctx_t *ctx)
+{
+  tk_cmd_rx_t rx;
+  tk_cmd_rx_init(&rx);
+
+  tk_cmd_weld_t cmd = test_make_cmd(5u, 1000);
+  cmd.mode = TK_MODE_ARMED;
+  control_cmd_t ctrl_cmd;
+  tk_cmd_rx_to_control(&cmd, &ctrl_cmd);
+  test_expect_true(ctx, !ctrl_cmd.enable_cmd, "ARMED does not enable control");
+  test_expect_close(ctx, ctrl_cmd.i_ref_cmd, 1.0f, 1e-6f, "mA converted to A");
+
+  (void)tk_cmd_rx_process(&rx, &cmd, false, NULL);
+  tk_cmd_rx_restart_seq(&rx);
+  cmd.seq = 500u;
+  (void)tk_cmd_rx_process(&rx, &cmd, false, NULL);
+  test_expect_eq_u32(ctx, rx.last_seq_class, TK_SEQ_FIRST, "restart makes next frame FIRST");
+  test_expect_eq_u32(ctx, rx.cnt_seq_gap, 0u, "no gap after restart");
+}
+
+/**
+ * @brief Тест: `max_slew_rate_A_ms` → лимит dI/dt control_core, не шире локального `cfg.di_dt_max`.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_slew_rate_to_control(test_ctx_t *ctx)
+{
+  tk_cmd_weld_t cmd = test_make_cmd(1u, 10000); /* 10 A */
+  control_cmd_t ctrl_cmd;
+  tk_cmd_rx_to_control(&cmd, &ctrl_cmd);
+  test_expect_close(ctx, ctrl_cmd.di_dt_cmd, (float)TK_MAX_SLEW_RATE_DEFAULT_A_MS * 1000.0f, 1.0f, "0 -> default");
+
+  control_ctx_t ctrl;
+  test_init_control(&ctrl);
+  tk_cmd_rx_t rx;
+  tk_cmd_rx_init(&rx);
+  const control_meas_t meas = {.i_meas = 0.0f, .u_meas = 0.0f, .udc = 0.0f, .meas_valid = true};
+  control_out_t out = {0};
+
+  /* 2 A/мс при dt = 1 мс: 2 A за шаг. */
+  cmd.max_slew_rate_a_ms = 2u;
+  (void)tk_cmd_rx_process(&rx, &cmd, false, &ctrl);
+  control_fast_step(&ctrl, &meas, true, &out);
+  test_expect_close(ctx, out.i_ref_used, 2.0f, 1e-4f, "master slew limit applied");
+  test_expect_true(ctx, (out.flags & CONTROL_FLAG_SLEW_ACTIVE) != 0u, "slew flag");
+
+  /* Локальный аппаратный лимит 1 A/мс строже команды: команда его не ослабляет. */
+  ctrl.cfg.di_dt_max = 1000.0f; /* [A/с] */
+  control_fast_step(&ctrl, &meas, true, &out);
+  test_expect_close(ctx, out.i_ref_used, 3.0f, 1e-4f, "clamped to local di/dt limit");
+
+  /* Команда строже аппаратного лимита — действует команда. */
+  ctrl.cfg.di_dt_max = 5000.0f; /* [A/с] */
+  control_fast_step(&ctrl, &meas, true, &out);
+  test_expect_close(ctx, out.i_ref_used, 5.0f, 1e-4f, "stricter master limit wins");
+}
+
+/**
+ * @brief Тест: режимы CP/CE/CV подают энергию и переводят `target` в единицы control_core.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_outer_modes_to_control(test_ctx_t *ctx)
+{
+  tk_cmd_weld_t cmd = test_make_cmd(1u, 20000000);
+  control_cmd_t ctrl_cmd;
+
+  tk_cmd_rx_to_control(&cmd, &ctrl_cmd);
+  test_expect_eq_u32(ctx, ctrl_cmd.reg_mode, CONTROL_REG_CC, "WELD -> CC");
+  test_expect_close(ctx, ctrl_cmd.target, 0.0f, 0.0f, "CC target unused");
+
+  cmd.mode = TK_MODE_WELD_CP;
+  cmd.target = 1500u; /* [10 Вт] */
+  tk_cmd_rx_to_control(&cmd, &ctrl_cmd);
+  test_expect_true(ctx, ctrl_cmd.enable_cmd && (ctrl_cmd.reg_mode == CONTROL_REG_CP), "CP enables");
+  test_expect_close(ctx, ctrl_cmd.target, 15000.0f, 1e-3f, "CP target in W");
+  test_expect_close(ctx, ctrl_cmd.i_ref_cmd, 20000.0f, 1e-3f, "I_ref is the ceiling");
+
+  cmd.mode = TK_MODE_WELD_CE;
+  cmd.target = 800u; /* [Дж] */
+  tk_cmd_rx_to_control(&cmd, &ctrl_cmd);
+  test_expect_true(ctx, ctrl_cmd.enable_cmd && (ctrl_cmd.reg_mode == CONTROL_REG_CE), "CE enables");
+  test_expect_close(ctx, ctrl_cmd.target, 800.0f, 1e-3f, "CE target in J");
+
+  cmd.mode = TK_MODE_WELD_CV;
+  cmd.target = 1250u; /* [мВ] */
+  tk_cmd_rx_to_control(&cmd, &ctrl_cmd);
+  test_expect_true(ctx, ctrl_cmd.enable_cmd && (ctrl_cmd.reg_mode == CONTROL_REG_CV), "CV enables");
+  test_expect_close(ctx, ctrl_cmd.target, 1.25f, 1e-6f, "CV target in V");
+
+  /* Без target режим внешнего контура отвергается и не публикуется. */
+  tk_cmd_rx_t rx;
+  tk_cmd_rx_init(&rx);
+  cmd.target = 0u;
+  test_expect_eq_u32(ctx, tk_cmd_rx_process(&rx, &cmd, false, NULL), TK_CMD_RX_REJECT, "CV without target");
+  test_expect_eq_u32(ctx, rx.last_reject_mask, TK_CMD_REJECT_TARGET, "reject reason");
+}
+
+/**
+ * @brief Тест: счётчики насыщаются на 0xFFFF.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_counters_saturate(test_ctx_t *ctx)
+{
+  tk_cmd_rx_t rx;
+  tk_cmd_rx_init(&rx);
+  tk_cmd_weld_t cmd = test_make_cmd(1u, 1000);
+  cmd.mode = 7u;
+  for (uint32_t i = 0u; i < 70000u; ++i)
+  {
+    (void)tk_cmd_rx_process(&rx, &cmd, false, NULL);
+  }
+  test_expect_eq_u32(ctx, rx.cnt_cmd_reject, 0xFFFFu, "cnt_cmd_reject saturates");
+}
+
+/**
+ * @brief Точка входа для L1 unit tests приёмника команд.
+ * @param argc Количество аргументов командной строки, [шт].
+ * @param argv Массив аргументов командной строки.
+ * @return Код завершения (0 = OK).
+ */
+int main(int argc, char **argv)
+{
+  const test_case_t tests[] = {
+    {"first_next_wrap_apply", test_first_next_wrap_apply},
+    {"repeat_backward_reject", test_repeat_backward_reject},
+    {"gap_apply_and_clear", test_gap_apply_and_clear},
+    {"invalid_fields_not_published", test_invalid_fields_not_published},
+    {"latch_last_valid_at_pwm_boundary", test_latch_last_valid_at_pwm_boundary},
+    {"armed_and_restart", test_armed_and_restart},
+    {"slew_rate_to_control", test_slew_rate_to_control},
+    {"outer_modes_to_control", test_outer_modes_to_control},
+    {"counters_saturate", test_counters_saturate},
+  };
+
+  return test_main(argc, argv, tests, sizeof(tests) / sizeof(tests[0]));
+}
@@ -0,0 +1,286 @@
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "control_core.h"
+#include "test_runner.h"
+#include "tk_cmd_timeout.h"
+
+#define TEST_TICK_US (250u) /**< Период tick slow-домена, [мкс]. */
+
+/**
+ * @brief Собрать валидную команду WELD.
+ * @param i_ref_ma Уставка, [mA].
+ * @return Команда.
+ */
+static tk_cmd_weld_t test_make_cmd(int32_t i_ref_ma)
+{
+  const tk_cmd_weld_t cmd = {
+    .seq = 1u,
+    .mode = TK_MODE_WELD,
+    .enable = 1u,
+    .i_ref_cmd_ma = i_ref_ma,
+    .max_slew_rate_a_ms = 0u,
+    .fault_reset = 0u,
+    .must_be_zero = 0u
+  };
+  return cmd;
+}
+
+/**
+ * @brief Инициализировать control_core без slew/интегратора (i_ref_used = опубликованная уставка).
+ * @param ctrl Контекст control_core.
+ * @return None.
+ */
+static void test_init_control(control_ctx_t *ctrl)
+{
+  /* Единицы полей см. control_cfg_t. */
+  const control_cfg_t cfg = {
+    .kp = 1.0f,
+    .ki = 0.0f,
+    .dt = 0.001f,
+    .u_min = -1.0e9f,
+    .u_max = 1.0e9f,
+    .i_ref_min = 0.0f,
+    .i_ref_max = 50000.0f,
+    .di_dt_max = 0.0f,
+    .integrator_policy = CONTROL_INTEGRATOR_RESET
+  };
+  control_init(ctrl, &cfg);
+}
+
+/**
+ * @brief Выполнить шаг fast-домена и вернуть выход.
+ * @param ctrl Контекст control_core.
+ * @return Выход control_core.
+ */
+static control_out_t test_fast_step(control_ctx_t *ctrl)
+{
+  const control_meas_t meas = {.i_meas = 0.0f, .u_meas = 0.0f, .udc = 0.0f, .meas_valid = true};
+  control_out_t out;
+  control_fast_step(ctrl, &meas, true, &out);
+  return out;
+}
+
+/**
+ * @brief Тест: до первой валидной команды таймаут не отсчитывается.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_disarmed_until_first_cmd(test_ctx_t *ctx)
+{
+  tk_cmd_timeout_t sup;
+  test_expect_true(ctx, tk_cmd_timeout_init(&sup, NULL), "defaults accepted");
+
+  test_expect_eq_u32(ctx, tk_cmd_timeout_tick(&sup, 1000000u, NULL), TK_CMD_TIMEOUT_DISARMED, "disarmed");
+  tk_fb_status_t fb = {0};
+  tk_cmd_timeout_fill_status(&sup, &fb);
+  test_expect_eq_u32(ctx, fb.status_word, 0u, "no timeout bits while disarmed");
+  test_expect_true(ctx, tk_cmd_timeout_publish_allowed(&sup), "publish allowed");
+}
+
+/**
+ * @brief Тест: порог soft-timeout и линейный спад уставки в control_core до 0 раньше hard-timeout.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_soft_timeout_ramp(test_ctx_t *ctx)
+{
+  tk_cmd_timeout_t sup;
+  control_ctx_t ctrl;
+  (void)tk_cmd_timeout_init(&sup, NULL);
+  test_init_control(&ctrl);
+
+  const tk_cmd_weld_t cmd = test_make_cmd(2000000);
+  const uint32_t t0 = 1000u;
+  tk_cmd_timeout_on_apply(&sup, &cmd, t0);
+
+  test_expect_eq_u32(ctx, tk_cmd_timeout_tick(&sup, t0 + 4999u, &ctrl), TK_CMD_TIMEOUT_OK, "fresh at 4999 us");
+  test_expect_eq_u32(ctx, tk_cmd_timeout_tick(&sup, t0 + 5000u, &ctrl), TK_CMD_TIMEOUT_SOFT, "soft at 5000 us");
+  test_expect_eq_u32(ctx, sup.cnt_soft_timeout, 1u, "cnt_soft_timeout");
+  test_expect_close(ctx, test_fast_step(&ctrl).i_ref_used, 2000.0f, 1e-3f, "ramp starts from held i_ref");
+
+  (void)tk_cmd_timeout_tick(&sup, t0 + 10000u, &ctrl);
+  test_expect_close(ctx, test_fast_step(&ctrl).i_ref_used, 1000.0f, 1e-2f, "half ramp after 5 ms");
+
+  (void)tk_cmd_timeout_tick(&sup, t0 + 15000u, &ctrl);
+  const control_out_t out = test_fast_step(&ctrl);
+  test_expect_close(ctx, out.i_ref_used, 0.0f, 1e-3f, "ramp reaches 0 before hard-timeout");
+  test_expect_true(ctx, !out.enable_request, "enable dropped at zero");
+  test_expect_eq_u32(ctx, tk_cmd_timeout_tick(&sup, t0 + 19999u, &ctrl), TK_CMD_TIMEOUT_SOFT, "still soft");
+}
+
+/**
+ * @brief Тест: спад монотонный и не зависит от частоты tick.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_ramp_tick_rate_independent(test_ctx_t *ctx)
+{
+  tk_cmd_timeout_t fine;
+  tk_cmd_timeout_t coarse;
+  (void)tk_cmd_timeout_init(&fine, NULL);
+  (void)tk_cmd_timeout_init(&coarse, NULL);
+  const tk_cmd_weld_t cmd = test_make_cmd(1500000);
+  tk_cmd_timeout_on_apply(&fine, &cmd, 0u);
+  tk_cmd_timeout_on_apply(&coarse, &cmd, 0u);
+
+  bool monotonic = true;
+  bool same = true;
+  float prev = 1.0e9f;
+  for (uint32_t t = TEST_TICK_US; t < 20000u; t += TEST_TICK_US)
+  {
+    (void)tk_cmd_timeout_tick(&fine, t, NULL);
+    if ((t % 1000u) == 0u)
+    {
+      (void)tk_cmd_timeout_tick(&coarse, t, NULL);
+      const float diff = fine.i_ref_out - coarse.i_ref_out;
+      same = same && (diff < 1e-3f) && (diff > -1e-3f);
+    }
+    monotonic = monotonic && (fine.i_ref_out <= prev);
+    prev = fine.i_ref_out;
+  }
+  test_expect_true(ctx, monotonic, "i_ref_out non-increasing");
+  test_expect_true(ctx, same, "250 us and 1 ms ticks agree");
+}
+
+/**
+ * @brief Тест: валидная команда в soft-timeout снимает его, публикация идёт обычным путём.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_soft_recovery(test_ctx_t *ctx)
+{
+  tk_cmd_timeout_t sup;
+  (void)tk_cmd_timeout_init(&sup, NULL);
+  const tk_cmd_weld_t cmd = test_make_cmd(1000000);
+  tk_cmd_timeout_on_apply(&sup, &cmd, 0u);
+  (void)tk_cmd_timeout_tick(&sup, 8000u, NULL);
+
+  tk_fb_status_t fb = {0};
+  tk_cmd_timeout_fill_status(&sup, &fb);
+  test_expect_eq_u32(ctx, fb.status_word, TK_STATUS_COMMS_SOFT_TIMEOUT_ACTIVE, "SOFT bit set");
+
+  tk_cmd_timeout_on_apply(&sup, &cmd, 8100u);
+  test_expect_eq_u32(ctx, tk_cmd_timeout_tick(&sup, 8250u, NULL), TK_CMD_TIMEOUT_OK, "recovered");
+  tk_cmd_timeout_fill_status(&sup, &fb);
+  test_expect_eq_u32(ctx, fb.status_word, 0u, "SOFT bit cleared by valid CMD_WELD");
+  test_expect_eq_u32(ctx, sup.age_max_us, 8000u, "cmd_age_max tracked");
+}
+
+/**
+ * @brief Тест: hard-timeout защёлкивается, свежие команды его не снимают, снимает только fault_reset.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_hard_latch_and_reset(test_ctx_t *ctx)
+{
+  tk_cmd_timeout_t sup;
+  control_ctx_t ctrl;
+  (void)tk_cmd_timeout_init(&sup, NULL);
+  test_init_control(&ctrl);
+
+  const tk_cmd_weld_t cmd = test_make_cmd(1000000);
+  tk_cmd_timeout_on_apply(&sup, &cmd, 0u);
+  test_expect_eq_u32(ctx, tk_cmd_timeout_tick(&sup, 19999u, &ctrl), TK_CMD_TIMEOUT_SOFT, "soft before 20 ms");
+  test_expect_eq_u32(ctx, tk_cmd_timeout_tick(&sup, 20000u, &ctrl), TK_CMD_TIMEOUT_HARD, "hard at 20 ms");
+  test_expect_true(ctx, !tk_cmd_timeout_publish_allowed(&sup), "publish blocked");
+
+  tk_fb_status_t fb = {0};
+  tk_cmd_timeout_fill_status(&sup, &fb);
+  test_expect_eq_u32(ctx, fb.status_word,
+                     TK_STATUS_COMMS_SOFT_TIMEOUT_ACTIVE | TK_STATUS_COMMS_HARD_TIMEOUT_ACTIVE, "both bits set");
+  test_expect_eq_u32(ctx, fb.fault_word, TK_FAULT_COMMS_TIMEOUT_HARD, "fault_word.COMMS_TIMEOUT_HARD");
+
+  /* Связь восстановилась: обычная WELD-команда не снимает latch, tick продолжает держать запрет. */
+  tk_cmd_timeout_on_apply(&sup, &cmd, 30000u);
+  control_slow_step(&ctrl, &(control_cmd_t){.i_ref_cmd = 1000.0f, .enable_cmd = true, .cmd_valid = true});
+  test_expect_eq_u32(ctx, tk_cmd_timeout_tick(&sup, 30250u, &ctrl), TK_CMD_TIMEOUT_HARD, "still latched");
+  test_expect_true(ctx, !test_fast_step(&ctrl).enable_request, "tick overrides stray publish");
+  tk_cmd_timeout_fill_status(&sup, &fb);
+  test_expect_eq_u32(ctx, fb.status_word, TK_STATUS_COMMS_HARD_TIMEOUT_ACTIVE, "soft cleared, hard stays");
+
+  const tk_cmd_weld_t reset = {
+    .seq = 2u,
+    .mode = TK_MODE_IDLE,
+    .enable = 0u,
+    .i_ref_cmd_ma = 0,
+    .max_slew_rate_a_ms = 0u,
+    .fault_reset = 1u,
+    .must_be_zero = 0u
+  };
+  tk_cmd_timeout_on_apply(&sup, &reset, 30500u);
+  test_expect_eq_u32(ctx, tk_cmd_timeout_tick(&sup, 30750u, &ctrl), TK_CMD_TIMEOUT_OK, "fault_reset clears hard");
+  test_expect_true(ctx, tk_cmd_timeout_publish_allowed(&sup), "publish allowed again");
+  test_expect_eq_u32(ctx, sup.cnt_hard_timeout, 1u, "cnt_hard_timeout");
+}
+
+/**
+ * @brief Тест: редкий tick сразу за hard-timeout выставляет оба уровня (soft затем hard) без пропуска.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_late_tick_escalates(test_ctx_t *ctx)
+{
+  tk_cmd_timeout_t sup;
+  (void)tk_cmd_timeout_init(&sup, NULL);
+  const tk_cmd_weld_t cmd = test_make_cmd(1000000);
+  tk_cmd_timeout_on_apply(&sup, &cmd, 0u);
+
+  test_expect_eq_u32(ctx, tk_cmd_timeout_tick(&sup, 50000u, NULL), TK_CMD_TIMEOUT_HARD, "hard on late tick");
+  test_expect_eq_u32(ctx, sup.cnt_soft_timeout, 1u, "soft counted");
+  test_expect_eq_u32(ctx, sup.cnt_hard_timeout, 1u, "hard counted");
+}
+
+/**
+ * @brief Тест: wrap timebase (2^32 мкс) не ломает пороги и не поднимает уставку.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_timebase_wrap(test_ctx_t *ctx)
+{
+  tk_cmd_timeout_t sup;
+  (void)tk_cmd_timeout_init(&sup, NULL);
+  const tk_cmd_weld_t cmd = test_make_cmd(1000000);
+  const uint32_t t0 = UINT32_MAX - 2000u;
+  tk_cmd_timeout_on_apply(&sup, &cmd, t0);
+
+  test_expect_eq_u32(ctx, tk_cmd_timeout_tick(&sup, t0 + 4000u, NULL), TK_CMD_TIMEOUT_OK, "fresh across wrap");
+  test_expect_eq_u32(ctx, tk_cmd_timeout_tick(&sup, t0 + 7500u, NULL), TK_CMD_TIMEOUT_SOFT, "soft across wrap");
+  test_expect_close(ctx, sup.i_ref_out, 750.0f, 1e-2f, "ramp across wrap");
+}
+
+/**
+ * @brief Тест: невалидная конфигурация заменяется значениями по умолчанию.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_invalid_cfg_defaults(test_ctx_t *ctx)
+{
+  tk_cmd_timeout_t sup;
+  const tk_cmd_timeout_cfg_t cfg = {.soft_timeout_us = 5000u, .hard_timeout_us = 10000u, .ramp_time_us = 8000u};
+  test_expect_true(ctx, !tk_cmd_timeout_init(&sup, &cfg), "ramp longer than hard-soft rejected");
+  test_expect_eq_u32(ctx, sup.cfg.hard_timeout_us, TK_CMD_TIMEOUT_HARD_US_DEFAULT, "default hard");
+  test_expect_eq_u32(ctx, sup.cfg.ramp_time_us, TK_CMD_TIMEOUT_RAMP_US_DEFAULT, "default ramp");
+}
+
+/**
+ * @brief Точка входа для L1 unit tests supervisor таймаутов.
+ * @param argc Количество аргументов командной строки, [шт].
+ * @param argv Массив аргументов командной строки.
+ * @return Код завершения (0 = OK).
+ */
+int main(int argc, char **argv)
+{
+  const test_case_t tests[] = {
+    {"disarmed_until_first_cmd", test_disarmed_until_first_cmd},
+    {"soft_timeout_ramp", test_soft_timeout_ramp},
+    {"ramp_tick_rate_independent", test_ramp_tick_rate_independent},
+    {"soft_recovery", test_soft_recovery},
+    {"hard_latch_and_reset", test_hard_latch_and_reset},
+    {"late_tick_escalates", test_late_tick_escalates},
+    {"timebase_wrap", test_timebase_wrap},
+    {"invalid_cfg_defaults", test_invalid_cfg_defaults},
+  };
+
+  return test_main(argc, argv, tests, sizeof(tests) / sizeof(tests[0]));
+}
@@ -0,0 +1,81 @@
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "tk_fb_weld.h"
+#include "test_runner.h"
+
+/**
+ * @brief Тест: нет отчёта ⇒ `weld_id=0`; масштабы [мДж]/[мА·с] и округление на короткой сварке.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_fill_scaling(test_ctx_t *ctx)
+{
+  tk_fb_status_t status = {0};
+  status.seq_applied = 0x1234u;
+
+  const meas_weld_report_t none = {0};
+  tk_fb_weld_fill_status(&none, &status);
+  test_expect_eq_u32(ctx, status.weld_id, 0u, "no report yet");
+
+  /* Короткая сварка 1 кА × 2.5 мс: 2.5 A·с — целые A·с теряли бы 20%. */
+  const meas_weld_report_t r = {
+    .weld_id = 7u, .done = true, .energy_j = 1.2344f, .charge_c = 2.5004f, .limit_periods = 3u
+  };
+  tk_fb_weld_fill_status(&r, &status);
+  test_expect_eq_u32(ctx, status.weld_id, 7u, "weld_id");
+  test_expect_eq_u32(ctx, status.weld_energy_mj, 1234u, "energy [mJ]");
+  test_expect_eq_u32(ctx, status.weld_charge_mas, 2500u, "charge [mA*s]");
+  test_expect_eq_u32(ctx, status.weld_limit_periods, 3u, "limit periods");
+  test_expect_eq_u32(ctx, status.seq_applied, 0x1234u, "other fields untouched");
+
+  /* Промежуточный снимок — не отчёт. */
+  meas_weld_report_t snap = r;
+  snap.done = false;
+  tk_fb_weld_fill_status(&snap, &status);
+  test_expect_eq_u32(ctx, status.weld_id, 0u, "snapshot is not a report");
+}
+
+/**
+ * @brief Тест: насыщение u32/u16 и NaN/отрицательные суммы ⇒ 0.
+ * @param ctx Контекст тестов.
+ * @return None.
+ */
+static void test_fill_saturation(test_ctx_t *ctx)
+{
+  tk_fb_status_t status = {0};
+
+  /* 70 000 периодов × 2 кА × 1 мс = 140 000 A·с (1.4e8 мА·с — в u32), 280 МДж > u32 мДж. */
+  const meas_weld_report_t big = {
+    .weld_id = 2u, .done = true, .energy_j = 2.8e8f, .charge_c = 1.4e5f, .limit_periods = 70000u
+  };
+  tk_fb_weld_fill_status(&big, &status);
+  test_expect_eq_u32(ctx, status.weld_energy_mj, UINT32_MAX, "energy saturates (280 MJ > u32 mJ)");
+  test_expect_eq_u32(ctx, status.weld_charge_mas, 140000000u, "charge fits u32 mA*s");
+  test_expect_eq_u32(ctx, status.weld_limit_periods, 65535u, "limit periods saturate");
+
+  const meas_weld_report_t huge = {.weld_id = 3u, .done = true, .charge_c = 5.0e6f};
+  tk_fb_weld_fill_status(&huge, &status);
+  test_expect_eq_u32(ctx, status.weld_charge_mas, UINT32_MAX, "charge saturates");
+
+  const meas_weld_report_t neg = {.weld_id = 4u, .done = true, .energy_j = -1.0f, .charge_c = -2.0f};
+  tk_fb_weld_fill_status(&neg, &status);
+  test_expect_eq_u32(ctx, status.weld_energy_mj, 0u, "negative energy -> 0");
+  test_expect_eq_u32(ctx, status.weld_charge_mas, 0u, "negative charge -> 0");
+}
+
+/**
+ * @brief Точка входа для L1 unit tests выжимки отчёта сварки в FB_STATUS.
+ * @param argc Количество аргументов командной строки, [шт].
+ * @param argv Массив аргументов командной строки.
+ * @return Код завершения (0 = OK).
+ */
+int main(int argc, char **argv)
+{
+  const test_case_t tests[] = {
+    {"fill_scaling", test_fill_scaling},
+    {"fill_saturation", test_fill_saturation},
+  };
+
+  return test_main(argc, argv, tests, sizeof(tests) / sizeof(tests[0]));
+}
@@ -0,0 +1,272 @@
+#include "pccom4_client.h"
+
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "pccom4_serial.h"
+
+#define PCCOM4_CLIENT_STALL_NS (200000L) /**< Пауза reader на полной очереди, [нс]. */
+
+uint64_t pccom4_now_ns(void)
+{
+  struct timespec ts;
+  (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Reader thread: read() порта в слоты очереди.
+ * @param arg Клиент.
+ * @return NULL.
+ */
+static void *pccom4_client_reader(void *arg)
+{
+  pccom4_client_t *cl = (pccom4_client_t *)arg;
+  while (!atomic_load_explicit(&cl->stop, memory_order_relaxed))
+  {
+    pccom4_rxq_chunk_t *chunk = pccom4_rxq_write_begin(&cl->rxq);
+    if (chunk == NULL)
+    {
+      // Очередь полна: байты ждут в буфере драйвера, а не теряются здесь.
+      atomic_fetch_add_explicit(&cl->rxq.cnt_stall, 1u, memory_order_relaxed);
+      const struct timespec pause = {0, PCCOM4_CLIENT_STALL_NS};
+      (void)nanosleep(&pause, NULL);
+      continue;
+    }
+    const ssize_t got = read(cl->fd, chunk->data, PCCOM4_RXQ_CHUNK);
+    if (got > 0)
+    {
+      chunk->t_ns = pccom4_now_ns() - cl->t0_ns;
+      chunk->len = (uint32_t)got;
+      pccom4_rxq_write_commit(&cl->rxq);
+    }
+    else if ((got < 0) && (errno != EINTR) && (errno != EAGAIN))
+    {
+      // EIO: pty без второй стороны / отключённый FT232H.
+      break;
+    }
+  }
+  atomic_store(&cl->rx_closed, true);
+  return NULL;
+}
+
+bool pccom4_client_open(pccom4_client_t *cl, const pccom4_client_cfg_t *cfg)
+{
+  memset(cl, 0, sizeof(*cl));
+  cl->cfg = *cfg;
+  cl->fd = -1;
+  atomic_init(&cl->stop, false);
+  atomic_init(&cl->rx_closed, false);
+  pccom4_parser_init(&cl->parser);
+  cl->t0_ns = pccom4_now_ns();
+
+  // Шаг 1: Очередь, трасса, порт.
+  if (!pccom4_rxq_init(&cl->rxq, (cfg->rxq_slots != 0u) ? cfg->rxq_slots : PCCOM4_RXQ_SLOTS_DEFAULT))
+  {
+    return false;
+  }
+  if (cfg->trace_path != NULL)
+  {
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_REALTIME, &ts);
+    cl->tracing =
+      pccom4_trace_create(&cl->trace, cfg->trace_path, ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec);
+    if (!cl->tracing)
+    {
+      (void)pccom4_trace_close(&cl->trace);
+      pccom4_rxq_free(&cl->rxq);
+      return false;
+    }
+  }
+  cl->fd = pccom4_serial_open(cfg->dev, cfg->baud);
+
+  // Шаг 2: Reader thread.
+  if ((cl->fd < 0) || (pthread_create(&cl->reader, NULL, pccom4_client_reader, cl) != 0))
+  {
+    (void)pccom4_client_close(cl, NULL, NULL);
+    return false;
+  }
+  cl->reader_started = true;
+  return true;
+}
+
+/**
+ * @brief Обработчик парсера: трасса, затем пользовательский обработчик.
+ * @param user Клиент.
+ * @param frame Кадр.
+ * @return None.
+ */
+static void pccom4_client_on_frame(void *user, const pccom4_frame_t *frame)
+{
+  pccom4_client_t *cl = (pccom4_client_t *)user;
+  if (cl->tracing)
+  {
+    (void)pccom4_trace_append(&cl->trace, PCCOM4_TRACE_FRAME, cl->chunk_t_ns, frame->raw,
+                              (uint32_t)frame->data_len + PCCOM4_LEN_MIN);
+  }
+  if (cl->fn != NULL)
+  {
+    cl->fn(cl->fn_user, frame);
+  }
+}
+
+uint32_t pccom4_client_poll(pccom4_client_t *cl, pccom4_frame_fn_t fn, void *user, uint64_t *t_ns)
+{
+  uint32_t frames = 0u;
+  cl->fn = fn;
+  cl->fn_user = user;
+  const pccom4_rxq_chunk_t *chunk = pccom4_rxq_read_begin(&cl->rxq);
+  while (chunk != NULL)
+  {
+    cl->chunk_t_ns = chunk->t_ns;
+    if (cl->tracing)
+    {
+      // Сырые байты до разбора: по ним восстанавливаются кадры с ошибкой CRC и причины resync.
+      (void)pccom4_trace_append(&cl->trace, PCCOM4_TRACE_RX, chunk->t_ns, chunk->data, chunk->len);
+    }
+    frames += pccom4_parser_feed(&cl->parser, chunk->data, chunk->len, pccom4_client_on_frame, cl);
+    cl->rx_bytes += chunk->len;
+    cl->rx_chunks++;
+    pccom4_rxq_read_commit(&cl->rxq);
+    chunk = pccom4_rxq_read_begin(&cl->rxq);
+  }
+  if (t_ns != NULL)
+  {
+    *t_ns = cl->chunk_t_ns;
+  }
+  return frames;
+}
+
+bool pccom4_client_send(pccom4_client_t *cl, uint8_t type, uint8_t node, uint8_t op, const uint8_t *data,
+                        uint32_t len)
+{
+  if (len > PCCOM4_DATA_MAX)
+  {
+    return false;
+  }
+  const pccom4_frame_t frame = {cl->cfg.addr_dev, cl->cfg.addr_self, type, node, op, (uint8_t)len, data, NULL};
+  uint8_t wire[PCCOM4_WIRE_MAX];
+  const uint32_t n = pccom4_frame_encode(&frame, wire, sizeof(wire));
+  uint32_t off = 0u;
+  while ((n != 0u) && (off < n))
+  {
+    const ssize_t put = write(cl->fd, &wire[off], n - off);
+    if ((put < 0) && (errno == EINTR))
+    {
+      continue;
+    }
+    if (put <= 0)
+    {
+      return false;
+    }
+    off += (uint32_t)put;
+  }
+  if (n == 0u)
+  {
+    return false;
+  }
+  cl->tx_frames++;
+  if (cl->tracing)
+  {
+    (void)pccom4_trace_append(&cl->trace, PCCOM4_TRACE_TX, pccom4_now_ns() - cl->t0_ns, &wire[1], n - 1u);
+  }
+  return true;
+}
+
+void pccom4_client_stats(pccom4_client_t *cl, pccom4_client_stats_t *st)
+{
+  st->rx_bytes = cl->rx_bytes;
+  st->rx_chunks = cl->rx_chunks;
+  st->rxq_highwater = cl->rxq.highwater;
+  st->rxq_stall = atomic_load_explicit(&cl->rxq.cnt_stall, memory_order_relaxed);
+  st->tx_frames = cl->tx_frames;
+  st->trace_bytes = cl->trace.bytes;
+  st->trace_error = cl->trace.error;
+  st->rx_closed = atomic_load(&cl->rx_closed);
+  st->parser = cl->parser.stats;
+}
+
+bool pccom4_client_trace_stats(pccom4_client_t *cl)
+{
+  if (!cl->tracing)
+  {
+    return false;
+  }
+  pccom4_client_stats_t st;
+  pccom4_client_stats(cl, &st);
+  const uint32_t words[8] = {
+    st.rxq_highwater, st.rxq_stall, st.parser.rx_ok, st.parser.rx_crc_err,
+    st.parser.rx_len_err, st.parser.parser_resync_count, st.parser.bytes_skipped, st.tx_frames,
+  };
+  uint8_t rec[PCCOM4_CLIENT_STATS_LEN];
+  for (uint32_t i = 0u; i < 8u; ++i)
+  {
+    rec[i] = (uint8_t)((st.rx_bytes >> (8u * i)) & 0xFFu);
+  }
+  for (uint32_t w = 0u; w < 8u; ++w)
+  {
+    for (uint32_t i = 0u; i < 4u; ++i)
+    {
+      rec[8u + (4u * w) + i] = (uint8_t)((words[w] >> (8u * i)) & 0xFFu);
+    }
+  }
+  return pccom4_trace_append(&cl->trace, PCCOM4_TRACE_STATS, pccom4_now_ns() - cl->t0_ns, rec, sizeof(rec));
+}
+
+bool pccom4_client_stats_unpack(const uint8_t *data, uint32_t len, pccom4_client_stats_t *st)
+{
+  if (len != PCCOM4_CLIENT_STATS_LEN)
+  {
+    return false;
+  }
+  const pccom4_client_stats_t zero = {0};
+  *st = zero;
+  for (uint32_t i = 0u; i < 8u; ++i)
+  {
+    st->rx_bytes |= (uint64_t)data[i] << (8u * i);
+  }
+  uint32_t words[8] = {0};
+  for (uint32_t w = 0u; w < 8u; ++w)
+  {
+    for (uint32_t i = 0u; i < 4u; ++i)
+    {
+      words[w] |= (uint32_t)data[8u + (4u * w) + i] << (8u * i);
+    }
+  }
+  st->rxq_highwater = words[0];
+  st->rxq_stall = words[1];
+  st->parser.rx_ok = words[2];
+  st->parser.rx_crc_err = words[3];
+  st->parser.rx_len_err = words[4];
+  st->parser.parser_resync_count = words[5];
+  st->parser.bytes_skipped = words[6];
+  st->tx_frames = words[7];
+  return true;
+}
+
+bool pccom4_client_close(pccom4_client_t *cl, pccom4_frame_fn_t fn, void *user)
+{
+  if (cl->reader_started)
+  {
+    atomic_store(&cl->stop, true);
+    (void)pthread_join(cl->reader, NULL);
+    cl->reader_started = false;
+  }
+  if (cl->rxq.slot != NULL)
+  {
+    (void)pccom4_client_poll(cl, fn, user, NULL);
+    (void)pccom4_client_trace_stats(cl);
+  }
+  pccom4_serial_close(cl->fd);
+  cl->fd = -1;
+  pccom4_rxq_free(&cl->rxq);
+  bool ok = true;
+  if (cl->tracing)
+  {
+    ok = pccom4_trace_close(&cl->trace);
+    cl->tracing = false;
+  }
+  return ok;
+}
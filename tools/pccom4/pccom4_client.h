@@ -0,0 +1,157 @@
+#ifndef PCCOM4_CLIENT_H
+#define PCCOM4_CLIENT_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "pccom4_frame.h"
+#include "pccom4_rxq.h"
+#include "pccom4_trace.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file pccom4_client.h
+ * @brief Host-клиент PCcom4: приём на полной скорости линии и непрерывная запись трассы.
+ * @details
+ * Потоки:
+ * - reader thread — только read() порта в слоты pccom4_rxq_t (никакого разбора/ввода-вывода на диск);
+ * - поток вызывающего — pccom4_client_poll(): разбор кадров (pccom4_parser_feed()), запись трассы,
+ *   обработчик кадров. Остановка диска/обработчика не теряет байты, пока не исчерпана очередь.
+ *
+ * Отправка (pccom4_client_send()) — write() из потока вызывающего; кадр также пишется в трассу.
+ */
+
+#define PCCOM4_CLIENT_STATS_LEN (40u) /**< Запись PCCOM4_TRACE_STATS, [байт]. */
+
+/**
+ * @brief Параметры клиента.
+ */
+typedef struct {
+  const char *dev; /**< Путь порта (`/dev/ttyUSB0`, pty). */
+  uint32_t baud; /**< Скорость, [бод] (0 — не менять). */
+  const char *trace_path; /**< Файл трассы (NULL — без записи). */
+  uint32_t rxq_slots; /**< Слотов очереди, [шт] (0 — PCCOM4_RXQ_SLOTS_DEFAULT). */
+  uint8_t addr_self; /**< Адрес клиента (SrcAddr исходящих кадров). */
+  uint8_t addr_dev; /**< Адрес устройства (DstAddr исходящих кадров). */
+} pccom4_client_cfg_t;
+
+/**
+ * @brief Счётчики клиента.
+ */
+typedef struct {
+  uint64_t rx_bytes; /**< Принято байт, [байт]. */
+  uint32_t rx_chunks; /**< Разобрано слотов, [шт]. */
+  uint32_t rxq_highwater; /**< Максимум занятых слотов, [шт]. */
+  uint32_t rxq_stall; /**< Ожиданий reader на полной очереди, [шт]. */
+  uint32_t tx_frames; /**< Отправлено кадров, [шт]. */
+  uint64_t trace_bytes; /**< Записано в трассу, [байт]. */
+  bool trace_error; /**< Ошибка записи трассы. */
+  bool rx_closed; /**< Порт закрыт/ошибка read() (reader завершён). */
+  pccom4_parser_stats_t parser; /**< Счётчики парсера. */
+} pccom4_client_stats_t;
+
+/**
+ * @brief Контекст клиента.
+ */
+typedef struct {
+  pccom4_client_cfg_t cfg; /**< Параметры. */
+  int fd; /**< Дескриптор порта. */
+  pthread_t reader; /**< Reader thread. */
+  bool reader_started; /**< Reader thread создан. */
+  atomic_bool stop; /**< Запрос остановки reader. */
+  atomic_bool rx_closed; /**< Reader завершён по ошибке/EOF. */
+  uint64_t t0_ns; /**< Монотонное время старта, [нс]. */
+  pccom4_rxq_t rxq; /**< Очередь RX. */
+  pccom4_parser_t parser; /**< Парсер. */
+  pccom4_trace_t trace; /**< Трасса. */
+  bool tracing; /**< Трасса открыта. */
+  uint64_t chunk_t_ns; /**< Время текущего разбираемого слота, [нс]. */
+  pccom4_frame_fn_t fn; /**< Обработчик текущего poll. */
+  void *fn_user; /**< Контекст обработчика. */
+  uint64_t rx_bytes; /**< Принято байт, [байт]. */
+  uint32_t rx_chunks; /**< Разобрано слотов, [шт]. */
+  uint32_t tx_frames; /**< Отправлено кадров, [шт]. */
+} pccom4_client_t;
+
+/**
+ * @brief Монотонное время host.
+ * @return Время, [нс].
+ */
+uint64_t pccom4_now_ns(void);
+
+/**
+ * @brief Открыть порт, трассу и запустить reader thread.
+ * @param cl Клиент.
+ * @param cfg Параметры.
+ * @return false при ошибке порта/трассы/памяти/потока (всё открытое закрывается).
+ */
+bool pccom4_client_open(pccom4_client_t *cl, const pccom4_client_cfg_t *cfg);
+
+/**
+ * @brief Разобрать всё, что принято: кадры → трасса → обработчик.
+ * @param cl Клиент.
+ * @param fn Обработчик кадров (может быть NULL).
+ * @param user Контекст обработчика.
+ * @param t_ns Выход: время слота последнего кадра, [нс от старта] (может быть NULL).
+ * @return Кадров, [шт].
+ */
+uint32_t pccom4_client_poll(pccom4_client_t *cl, pccom4_frame_fn_t fn, void *user, uint64_t *t_ns);
+
+/**
+ * @brief Отправить кадр (SrcAddr/DstAddr — из параметров клиента).
+ * @param cl Клиент.
+ * @param type Тип (pccom4_type_t).
+ * @param node Узел.
+ * @param op Операция.
+ * @param data Данные.
+ * @param len Длина, [байт].
+ * @return false при ошибке кодирования/write().
+ */
+bool pccom4_client_send(pccom4_client_t *cl, uint8_t type, uint8_t node, uint8_t op, const uint8_t *data,
+                        uint32_t len);
+
+/**
+ * @brief Снимок счётчиков.
+ * @param cl Клиент.
+ * @param st Результат.
+ * @return None.
+ */
+void pccom4_client_stats(pccom4_client_t *cl, pccom4_client_stats_t *st);
+
+/**
+ * @brief Записать снимок счётчиков в трассу (PCCOM4_TRACE_STATS): качество захвата видно при разборе трассы.
+ * @param cl Клиент.
+ * @return false, если трасса не ведётся или ошибка записи.
+ * @details Раскладка (LE): `rx_bytes` u64, далее u32: `rxq_highwater`, `rxq_stall`, `rx_ok`, `rx_crc_err`,
+ * `rx_len_err`, `parser_resync_count`, `bytes_skipped`, `tx_frames`.
+ */
+bool pccom4_client_trace_stats(pccom4_client_t *cl);
+
+/**
+ * @brief Разобрать запись PCCOM4_TRACE_STATS.
+ * @param data Данные записи.
+ * @param len Длина, [байт].
+ * @param st Результат (поля трассы/rx_closed не заполняются).
+ * @return false при неверной длине.
+ */
+bool pccom4_client_stats_unpack(const uint8_t *data, uint32_t len, pccom4_client_stats_t *st);
+
+/**
+ * @brief Остановить reader, дочитать очередь, закрыть трассу и порт.
+ * @param cl Клиент.
+ * @param fn Обработчик для оставшихся кадров (может быть NULL).
+ * @param user Контекст обработчика.
+ * @return false, если запись трассы завершилась ошибкой.
+ */
+bool pccom4_client_close(pccom4_client_t *cl, pccom4_frame_fn_t fn, void *user);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PCCOM4_CLIENT_H */
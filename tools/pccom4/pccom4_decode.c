@@ -0,0 +1,138 @@
+#include "pccom4_decode.h"
+
+#include <string.h>
+
+#include "scope_codec.h"
+
+/**
+ * @brief Прочитать u32 LE.
+ * @param b Байты.
+ * @return Значение.
+ */
+static uint32_t pccom4_decode_u32(const uint8_t *b)
+{
+  return (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+}
+
+/**
+ * @brief `TkPdo.Emu.*` (Node 0x03).
+ * @param frame Кадр.
+ * @param msg Результат.
+ * @return Вид.
+ */
+static pccom4_msg_kind_t pccom4_decode_tkpdo(const pccom4_frame_t *frame, pccom4_msg_t *msg)
+{
+  // Окно process image — выровненные LE-слова (tk_pdo_codec), payload кадра выравнивания не имеет.
+  uint32_t window[TK_PDO_FB_STATUS_SIZE_WORDS];
+  switch (frame->op)
+  {
+    case PCCOM4_OP_CMD_WELD:
+      if (frame->data_len != TK_PDO_CMD_WELD_SIZE_BYTES)
+      {
+        return PCCOM4_MSG_BAD;
+      }
+      memcpy(window, frame->data, TK_PDO_CMD_WELD_SIZE_BYTES);
+      tk_pdo_cmd_weld_unpack(window, &msg->cmd);
+      return PCCOM4_MSG_CMD_WELD;
+    case PCCOM4_OP_FB_STATUS:
+      if (frame->data_len != TK_PDO_FB_STATUS_SIZE_BYTES)
+      {
+        return PCCOM4_MSG_BAD;
+      }
+      memcpy(window, frame->data, TK_PDO_FB_STATUS_SIZE_BYTES);
+      (void)tk_pdo_fb_status_unpack(window, &msg->fb);
+      return PCCOM4_MSG_FB_STATUS;
+    case PCCOM4_OP_PDO_FAULT:
+      if (frame->data_len != PCCOM4_PDO_FAULT_LEN)
+      {
+        return PCCOM4_MSG_BAD;
+      }
+      memcpy(msg->fault, frame->data, PCCOM4_PDO_FAULT_LEN);
+      return PCCOM4_MSG_PDO_FAULT;
+    case PCCOM4_OP_PDO_STATS:
+      if (frame->type != PCCOM4_TYPE_READ_OK)
+      {
+        return PCCOM4_MSG_OTHER;
+      }
+      if (frame->data_len != PCCOM4_PDO_STATS_LEN)
+      {
+        return PCCOM4_MSG_BAD;
+      }
+      msg->stats.rx_ok = pccom4_decode_u32(&frame->data[0]);
+      msg->stats.rx_crc_err = pccom4_decode_u32(&frame->data[4]);
+      msg->stats.rx_out_of_order = pccom4_decode_u32(&frame->data[8]);
+      msg->stats.rx_missed = pccom4_decode_u32(&frame->data[12]);
+      msg->stats.watchdog_trip = pccom4_decode_u32(&frame->data[16]);
+      msg->stats.pdo_age_max_us = pccom4_decode_u32(&frame->data[20]);
+      msg->stats.last_seq = (uint16_t)(pccom4_decode_u32(&frame->data[24]) & 0xFFFFu);
+      msg->stats.last_rtt_us = pccom4_decode_u32(&frame->data[28]);
+      return PCCOM4_MSG_PDO_STATS;
+    default:
+      return PCCOM4_MSG_OTHER;
+  }
+}
+
+/**
+ * @brief `Scope.Data` (Node 0x06): набор 1 — переменные контура, остальные — сжатые блоки АЦП.
+ * @param frame Кадр.
+ * @param msg Результат.
+ * @return Вид.
+ */
+static pccom4_msg_kind_t pccom4_decode_scope(const pccom4_frame_t *frame, pccom4_msg_t *msg)
+{
+  if ((frame->op < PCCOM4_OP_SCOPE_DATA_FIRST) || (frame->op > PCCOM4_OP_SCOPE_DATA_LAST) || (frame->data_len < 2u))
+  {
+    return PCCOM4_MSG_OTHER;
+  }
+  if (frame->data[0] == SCOPE_VARS_SET_ID)
+  {
+    return scope_vars_decode(frame->data, frame->data_len, &msg->vars, msg->vars_values,
+                             (uint32_t)(sizeof(msg->vars_values) / sizeof(msg->vars_values[0])))
+             ? PCCOM4_MSG_SCOPE_VARS
+             : PCCOM4_MSG_BAD;
+  }
+
+  msg->raw_set = frame->data[0];
+  msg->raw_blocks = 0u;
+  msg->raw_frames = 0u;
+  msg->raw_n_ch = 0u;
+  uint32_t pos = 1u;
+  uint32_t samples = 0u;
+  while (pos < frame->data_len)
+  {
+    uint32_t n = 0u;
+    uint32_t n_ch = 0u;
+    const uint32_t len = scope_codec_decode(&frame->data[pos], frame->data_len - pos, &msg->raw[samples],
+                                            PCCOM4_DECODE_RAW_MAX - samples, &n, &n_ch);
+    if ((len == 0u) || ((msg->raw_n_ch != 0u) && (n_ch != msg->raw_n_ch)))
+    {
+      return PCCOM4_MSG_BAD;
+    }
+    msg->raw_n_ch = n_ch;
+    msg->raw_frames += n;
+    msg->raw_blocks++;
+    samples += n * n_ch;
+    pos += len;
+  }
+  return PCCOM4_MSG_SCOPE_RAW;
+}
+
+pccom4_msg_kind_t pccom4_decode(const pccom4_frame_t *frame, pccom4_msg_t *msg)
+{
+  msg->kind = PCCOM4_MSG_OTHER;
+  if (frame->node == PCCOM4_NODE_TKPDO_EMU)
+  {
+    msg->kind = pccom4_decode_tkpdo(frame, msg);
+  }
+  else if ((frame->node == PCCOM4_NODE_SCOPE) && (frame->type == PCCOM4_TYPE_MESSAGE))
+  {
+    msg->kind = pccom4_decode_scope(frame, msg);
+  }
+  return msg->kind;
+}
+
+const char *pccom4_msg_name(pccom4_msg_kind_t kind)
+{
+  static const char *const names[] = {"other", "CmdWeld", "FbStatus", "Fault", "Stats", "ScopeVars", "ScopeRaw", "bad"};
+  return ((uint32_t)kind < (sizeof(names) / sizeof(names[0]))) ? names[kind] : "?";
+}
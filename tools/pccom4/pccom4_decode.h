@@ -0,0 +1,105 @@
+#ifndef PCCOM4_DECODE_H
+#define PCCOM4_DECODE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "pccom4_frame.h"
+#include "scope_vars.h"
+#include "tk_pdo_codec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file pccom4_decode.h
+ * @brief Декодирование payload проектных узлов PCcom4 на host: `TkPdo.Emu.*` (Node 0x03) и `Scope.*` (Node 0x06).
+ * @details
+ * Payload разбирают те же кодеки, что и прошивка (tk_pdo_codec, scope_vars_decode(), scope_codec), поэтому
+ * host и MCU не расходятся в формате. Номера узлов/операций — PCCOM4.02_PROJECT §3.2, §3.5.
+ */
+
+#define PCCOM4_NODE_TKPDO_EMU (0x03u) /**< Узел имитации EtherCAT PDO. */
+#define PCCOM4_NODE_SCOPE (0x06u) /**< Узел цифрового осциллографа. */
+
+#define PCCOM4_OP_CMD_WELD (0x01u) /**< `TkPdo.Emu.CmdWeld`. */
+#define PCCOM4_OP_FB_STATUS (0x02u) /**< `TkPdo.Emu.FbStatus`. */
+#define PCCOM4_OP_PDO_FAULT (0x03u) /**< `TkPdo.Emu.Fault`. */
+#define PCCOM4_OP_PDO_STATS (0x10u) /**< `TkPdo.Emu.Stats`. */
+#define PCCOM4_OP_SCOPE_STREAM (0x01u) /**< `Scope.StreamControl` (первая операция диапазона 0x01..0x0F). */
+#define PCCOM4_OP_SCOPE_DATA_FIRST (0x11u) /**< `Scope.Data`: первая операция. */
+#define PCCOM4_OP_SCOPE_DATA_LAST (0x1Fu) /**< `Scope.Data`: последняя операция. */
+#define PCCOM4_OP_SCOPE_MASK (0x20u) /**< `Scope.SignalMask`. */
+#define PCCOM4_OP_SCOPE_DECIM (0x21u) /**< `Scope.Decimation`. */
+
+#define PCCOM4_PDO_FAULT_LEN (16u) /**< `TkPdo.Emu.Fault`, [байт]. */
+#define PCCOM4_PDO_STATS_LEN (32u) /**< `TkPdo.Emu.Stats`, [байт]. */
+#define PCCOM4_DECODE_RAW_MAX (4096u) /**< Отсчётов АЦП в одном `Scope.Data`, [шт]. */
+
+/**
+ * @brief Вид декодированного сообщения.
+ */
+typedef enum {
+  PCCOM4_MSG_OTHER = 0u, /**< Не декодируется (другой узел/операция/тип). */
+  PCCOM4_MSG_CMD_WELD = 1u, /**< `TkPdo.Emu.CmdWeld`. */
+  PCCOM4_MSG_FB_STATUS = 2u, /**< `TkPdo.Emu.FbStatus`. */
+  PCCOM4_MSG_PDO_FAULT = 3u, /**< `TkPdo.Emu.Fault` (payload как есть). */
+  PCCOM4_MSG_PDO_STATS = 4u, /**< `TkPdo.Emu.Stats` (ответ на чтение). */
+  PCCOM4_MSG_SCOPE_VARS = 5u, /**< `Scope.Data` набор 1 — переменные контура. */
+  PCCOM4_MSG_SCOPE_RAW = 6u, /**< `Scope.Data` — сжатые блоки АЦП. */
+  PCCOM4_MSG_BAD = 7u /**< Узел/операция известны, но payload не разобран (длина/формат). */
+} pccom4_msg_kind_t;
+
+/**
+ * @brief `TkPdo.Emu.Stats` (PCCOM4.02_PROJECT §3.2.4).
+ */
+typedef struct {
+  uint32_t rx_ok; /**< Валидных `CmdWeld`, [шт]. */
+  uint32_t rx_crc_err; /**< Кадров с ошибкой CRC, [шт]. */
+  uint32_t rx_out_of_order; /**< Отвергнутых по `seq`, [шт]. */
+  uint32_t rx_missed; /**< Пропущенных `seq`, [шт]. */
+  uint32_t watchdog_trip; /**< Входов в hard-timeout, [шт]. */
+  uint32_t pdo_age_max_us; /**< Максимальный возраст команды, [мкс]. */
+  uint16_t last_seq; /**< Последний валидный `seq`. */
+  uint32_t last_rtt_us; /**< RTT, [мкс]. */
+} pccom4_pdo_stats_t;
+
+/**
+ * @brief Декодированное сообщение (заполнено только поле, соответствующее kind).
+ */
+typedef struct {
+  pccom4_msg_kind_t kind; /**< Вид. */
+  tk_cmd_weld_t cmd; /**< `CmdWeld`. */
+  tk_fb_status_t fb; /**< `FbStatus`. */
+  uint8_t fault[PCCOM4_PDO_FAULT_LEN]; /**< `Fault`. */
+  pccom4_pdo_stats_t stats; /**< `Stats`. */
+  scope_vars_frame_t vars; /**< Заголовок набора 1. */
+  int32_t vars_values[255u * SCOPE_VARS_SLOT_WORDS]; /**< Значения набора 1 (`[k * n_sel + j]`). */
+  uint8_t raw_set; /**< Номер набора сжатых блоков. */
+  uint32_t raw_blocks; /**< Блоков, [шт]. */
+  uint32_t raw_frames; /**< Кадров АЦП, [шт]. */
+  uint32_t raw_n_ch; /**< Каналов, [шт]. */
+  int16_t raw[PCCOM4_DECODE_RAW_MAX]; /**< Кадры АЦП (чередование каналов). */
+} pccom4_msg_t;
+
+/**
+ * @brief Декодировать payload кадра.
+ * @param frame Кадр.
+ * @param msg Результат.
+ * @return Вид сообщения (msg->kind).
+ */
+pccom4_msg_kind_t pccom4_decode(const pccom4_frame_t *frame, pccom4_msg_t *msg);
+
+/**
+ * @brief Имя вида сообщения (логи/CLI).
+ * @param kind Вид.
+ * @return Строка.
+ */
+const char *pccom4_msg_name(pccom4_msg_kind_t kind);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PCCOM4_DECODE_H */
@@ -0,0 +1,64 @@
+#include "pccom4_rxq.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+bool pccom4_rxq_init(pccom4_rxq_t *q, uint32_t n_slots)
+{
+  memset(q, 0, sizeof(*q));
+  if ((n_slots < 2u) || ((n_slots & (n_slots - 1u)) != 0u))
+  {
+    return false;
+  }
+  q->slot = calloc(n_slots, sizeof(pccom4_rxq_chunk_t));
+  if (q->slot == NULL)
+  {
+    return false;
+  }
+  q->n_slots = n_slots;
+  atomic_init(&q->head, 0u);
+  atomic_init(&q->tail, 0u);
+  atomic_init(&q->cnt_stall, 0u);
+  return true;
+}
+
+void pccom4_rxq_free(pccom4_rxq_t *q)
+{
+  free(q->slot);
+  q->slot = NULL;
+  q->n_slots = 0u;
+}
+
+pccom4_rxq_chunk_t *pccom4_rxq_write_begin(pccom4_rxq_t *q)
+{
+  const uint32_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+  if ((head - atomic_load_explicit(&q->tail, memory_order_acquire)) >= q->n_slots)
+  {
+    return NULL;
+  }
+  return &q->slot[head & (q->n_slots - 1u)];
+}
+
+void pccom4_rxq_write_commit(pccom4_rxq_t *q)
+{
+  const uint32_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+  atomic_store_explicit(&q->head, head + 1u, memory_order_release);
+}
+
+const pccom4_rxq_chunk_t *pccom4_rxq_read_begin(pccom4_rxq_t *q)
+{
+  const uint32_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+  const uint32_t used = atomic_load_explicit(&q->head, memory_order_acquire) - tail;
+  if (used == 0u)
+  {
+    return NULL;
+  }
+  q->highwater = (used > q->highwater) ? used : q->highwater;
+  return &q->slot[tail & (q->n_slots - 1u)];
+}
+
+void pccom4_rxq_read_commit(pccom4_rxq_t *q)
+{
+  const uint32_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+  atomic_store_explicit(&q->tail, tail + 1u, memory_order_release);
+}
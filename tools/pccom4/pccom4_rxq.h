@@ -0,0 +1,93 @@
+#ifndef PCCOM4_RXQ_H
+#define PCCOM4_RXQ_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file pccom4_rxq.h
+ * @brief Lock-free SPSC очередь кусков RX-потока: reader thread → поток разбора/записи трассы.
+ * @details
+ * Reader читает read() прямо в свободный слот (без копий) и публикует его store-release `head`;
+ * потребитель разбирает слот на месте и освобождает его store-release `tail`. Очередь полна ⇒ reader
+ * не теряет данные, а ждёт (байты копятся в буфере драйвера), счётчик `cnt_stall` фиксирует событие.
+ * Глубина по умолчанию ≈ 16 МБ — ~13 с потока FT232H на 12 Мбод при остановке диска.
+ */
+
+#define PCCOM4_RXQ_CHUNK (4096u) /**< Размер слота, [байт]. */
+#define PCCOM4_RXQ_SLOTS_DEFAULT (4096u) /**< Слотов по умолчанию (степень двойки), [шт]. */
+
+/**
+ * @brief Слот: кусок потока и время его приёма.
+ */
+typedef struct {
+  uint64_t t_ns; /**< Время возврата read() (монотонное, от старта клиента), [нс]. */
+  uint32_t len; /**< Байт в слоте, [байт]. */
+  uint8_t data[PCCOM4_RXQ_CHUNK]; /**< Данные. */
+} pccom4_rxq_chunk_t;
+
+/**
+ * @brief Очередь.
+ */
+typedef struct {
+  pccom4_rxq_chunk_t *slot; /**< Слоты (heap). */
+  uint32_t n_slots; /**< Слотов (степень двойки), [шт]. */
+  atomic_uint head; /**< Индекс записи (reader), [шт]. */
+  atomic_uint tail; /**< Индекс чтения (потребитель), [шт]. */
+  atomic_uint cnt_stall; /**< Ожиданий reader на полной очереди, [шт]. */
+  uint32_t highwater; /**< Максимум занятых слотов (пишет потребитель), [шт]. */
+} pccom4_rxq_t;
+
+/**
+ * @brief Выделить очередь.
+ * @param q Очередь.
+ * @param n_slots Слотов, [шт] (степень двойки, >= 2).
+ * @return false при ошибке параметров/памяти.
+ */
+bool pccom4_rxq_init(pccom4_rxq_t *q, uint32_t n_slots);
+
+/**
+ * @brief Освободить очередь.
+ * @param q Очередь.
+ * @return None.
+ */
+void pccom4_rxq_free(pccom4_rxq_t *q);
+
+/**
+ * @brief Reader: свободный слот для записи.
+ * @param q Очередь.
+ * @return Слот или NULL (очередь полна).
+ */
+pccom4_rxq_chunk_t *pccom4_rxq_write_begin(pccom4_rxq_t *q);
+
+/**
+ * @brief Reader: опубликовать слот, полученный pccom4_rxq_write_begin().
+ * @param q Очередь.
+ * @return None.
+ */
+void pccom4_rxq_write_commit(pccom4_rxq_t *q);
+
+/**
+ * @brief Потребитель: самый старый заполненный слот.
+ * @param q Очередь.
+ * @return Слот или NULL (очередь пуста).
+ */
+const pccom4_rxq_chunk_t *pccom4_rxq_read_begin(pccom4_rxq_t *q);
+
+/**
+ * @brief Потребитель: освободить слот, полученный pccom4_rxq_read_begin().
+ * @param q Очередь.
+ * @return None.
+ */
+void pccom4_rxq_read_commit(pccom4_rxq_t *q);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PCCOM4_RXQ_H */
@@ -0,0 +1,49 @@
+#include "pccom4_serial.h"
+
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+int pccom4_serial_open(const char *path, uint32_t baud)
+{
+  const int fd = open(path, O_RDWR | O_NOCTTY | O_CLOEXEC);
+  if (fd < 0)
+  {
+    return -1;
+  }
+
+  // Шаг 1: Raw 8N1, без эха/канонического режима/XON-XOFF; read() с таймаутом.
+  struct termios tio;
+  if (tcgetattr(fd, &tio) != 0)
+  {
+    (void)close(fd);
+    return -1;
+  }
+  cfmakeraw(&tio);
+  tio.c_cflag |= (tcflag_t)(CLOCAL | CREAD);
+  tio.c_cflag &= (tcflag_t)~CRTSCTS;
+  tio.c_cc[VMIN] = 0;
+  tio.c_cc[VTIME] = (cc_t)PCCOM4_SERIAL_READ_TIMEOUT_DS;
+  if (tcsetattr(fd, TCSANOW, &tio) != 0)
+  {
+    (void)close(fd);
+    return -1;
+  }
+
+  // Шаг 2: Скорость (после tcsetattr: termios2 не должен быть перезаписан).
+  if ((baud != 0u) && !pccom4_serial_set_baud(fd, baud))
+  {
+    (void)close(fd);
+    return -1;
+  }
+  (void)tcflush(fd, TCIOFLUSH);
+  return fd;
+}
+
+void pccom4_serial_close(int fd)
+{
+  if (fd >= 0)
+  {
+    (void)close(fd);
+  }
+}
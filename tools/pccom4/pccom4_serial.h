@@ -0,0 +1,49 @@
+#ifndef PCCOM4_SERIAL_H
+#define PCCOM4_SERIAL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file pccom4_serial.h
+ * @brief Последовательный порт host (POSIX): FT232H (`/dev/ttyUSB*`) или pty для тестов.
+ * @details
+ * Порт открывается в raw-режиме 8N1 без управления потоком; read() возвращается не позже
+ * PCCOM4_SERIAL_READ_TIMEOUT_DS (reader thread успевает проверить флаг остановки).
+ * Нестандартные скорости FT232H (до 12 Мбод) задаются через termios2/BOTHER (Linux).
+ */
+
+#define PCCOM4_SERIAL_READ_TIMEOUT_DS (1u) /**< Таймаут read() без данных, [0.1 с]. */
+
+/**
+ * @brief Открыть порт.
+ * @param path Путь устройства.
+ * @param baud Скорость, [бод] (0 — не менять: pty).
+ * @return Дескриптор или -1 (errno — причина).
+ */
+int pccom4_serial_open(const char *path, uint32_t baud);
+
+/**
+ * @brief Установить произвольную скорость (termios2/BOTHER).
+ * @param fd Дескриптор.
+ * @param baud Скорость, [бод].
+ * @return false, если драйвер/платформа не поддерживает.
+ */
+bool pccom4_serial_set_baud(int fd, uint32_t baud);
+
+/**
+ * @brief Закрыть порт.
+ * @param fd Дескриптор.
+ * @return None.
+ */
+void pccom4_serial_close(int fd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PCCOM4_SERIAL_H */
@@ -0,0 +1,32 @@
+// Отдельная единица трансляции: <asm/termbits.h> конфликтует с <termios.h>.
+#include "pccom4_serial.h"
+
+#if defined(__linux__)
+
+#include <asm/termbits.h>
+#include <sys/ioctl.h>
+
+bool pccom4_serial_set_baud(int fd, uint32_t baud)
+{
+  struct termios2 tio;
+  if (ioctl(fd, TCGETS2, &tio) != 0)
+  {
+    return false;
+  }
+  tio.c_cflag &= (tcflag_t)~CBAUD;
+  tio.c_cflag |= (tcflag_t)BOTHER;
+  tio.c_ispeed = baud;
+  tio.c_ospeed = baud;
+  return ioctl(fd, TCSETS2, &tio) == 0;
+}
+
+#else
+
+bool pccom4_serial_set_baud(int fd, uint32_t baud)
+{
+  (void)fd;
+  (void)baud;
+  return false;
+}
+
+#endif
@@ -0,0 +1,169 @@
+#include "pccom4_trace.h"
+
+#include <string.h>
+
+#define PCCOM4_TRACE_WBUF (1u << 20) /**< Буфер stdio записи, [байт]. */
+
+/**
+ * @brief Записать u16 LE.
+ * @param b Байты.
+ * @param v Значение.
+ * @return None.
+ */
+static void pccom4_trace_put_u16(uint8_t *b, uint16_t v)
+{
+  b[0] = (uint8_t)(v & 0xFFu);
+  b[1] = (uint8_t)(v >> 8);
+}
+
+/**
+ * @brief Записать u32 LE.
+ * @param b Байты.
+ * @param v Значение.
+ * @return None.
+ */
+static void pccom4_trace_put_u32(uint8_t *b, uint32_t v)
+{
+  pccom4_trace_put_u16(b, (uint16_t)(v & 0xFFFFu));
+  pccom4_trace_put_u16(&b[2], (uint16_t)(v >> 16));
+}
+
+/**
+ * @brief Записать u64 LE.
+ * @param b Байты.
+ * @param v Значение.
+ * @return None.
+ */
+static void pccom4_trace_put_u64(uint8_t *b, uint64_t v)
+{
+  pccom4_trace_put_u32(b, (uint32_t)(v & 0xFFFFFFFFu));
+  pccom4_trace_put_u32(&b[4], (uint32_t)(v >> 32));
+}
+
+/**
+ * @brief Прочитать u16 LE.
+ * @param b Байты.
+ * @return Значение.
+ */
+static uint16_t pccom4_trace_u16(const uint8_t *b)
+{
+  return (uint16_t)((uint32_t)b[0] | ((uint32_t)b[1] << 8));
+}
+
+/**
+ * @brief Прочитать u32 LE.
+ * @param b Байты.
+ * @return Значение.
+ */
+static uint32_t pccom4_trace_u32(const uint8_t *b)
+{
+  return (uint32_t)pccom4_trace_u16(b) | ((uint32_t)pccom4_trace_u16(&b[2]) << 16);
+}
+
+/**
+ * @brief Прочитать u64 LE.
+ * @param b Байты.
+ * @return Значение.
+ */
+static uint64_t pccom4_trace_u64(const uint8_t *b)
+{
+  return (uint64_t)pccom4_trace_u32(b) | ((uint64_t)pccom4_trace_u32(&b[4]) << 32);
+}
+
+bool pccom4_trace_create(pccom4_trace_t *tr, const char *path, uint64_t t0_unix_ns)
+{
+  memset(tr, 0, sizeof(*tr));
+  tr->f = fopen(path, "wb");
+  if (tr->f == NULL)
+  {
+    return false;
+  }
+  (void)setvbuf(tr->f, NULL, _IOFBF, PCCOM4_TRACE_WBUF);
+  tr->t0_unix_ns = t0_unix_ns;
+
+  uint8_t hdr[PCCOM4_TRACE_HDR_LEN] = {0};
+  pccom4_trace_put_u32(&hdr[0], PCCOM4_TRACE_MAGIC);
+  pccom4_trace_put_u16(&hdr[4], PCCOM4_TRACE_VERSION);
+  pccom4_trace_put_u16(&hdr[6], PCCOM4_TRACE_HDR_LEN);
+  pccom4_trace_put_u64(&hdr[8], t0_unix_ns);
+  tr->error = fwrite(hdr, 1u, sizeof(hdr), tr->f) != sizeof(hdr);
+  tr->bytes = sizeof(hdr);
+  return !tr->error;
+}
+
+bool pccom4_trace_append(pccom4_trace_t *tr, pccom4_trace_kind_t kind, uint64_t t_ns, const void *data,
+                         uint32_t len)
+{
+  if (len > PCCOM4_TRACE_REC_MAX)
+  {
+    tr->error = true;
+    return false;
+  }
+  uint8_t hdr[PCCOM4_TRACE_REC_HDR_LEN] = {0};
+  pccom4_trace_put_u64(&hdr[0], t_ns);
+  pccom4_trace_put_u16(&hdr[8], (uint16_t)len);
+  hdr[10] = (uint8_t)kind;
+  const bool ok = (fwrite(hdr, 1u, sizeof(hdr), tr->f) == sizeof(hdr)) && (fwrite(data, 1u, len, tr->f) == len);
+  tr->error = tr->error || !ok;
+  tr->records++;
+  tr->bytes += sizeof(hdr) + len;
+  return ok;
+}
+
+bool pccom4_trace_open(pccom4_trace_t *tr, const char *path)
+{
+  memset(tr, 0, sizeof(*tr));
+  tr->f = fopen(path, "rb");
+  if (tr->f == NULL)
+  {
+    return false;
+  }
+  uint8_t hdr[PCCOM4_TRACE_HDR_LEN];
+  if ((fread(hdr, 1u, sizeof(hdr), tr->f) != sizeof(hdr)) || (pccom4_trace_u32(&hdr[0]) != PCCOM4_TRACE_MAGIC) ||
+      (pccom4_trace_u16(&hdr[4]) != PCCOM4_TRACE_VERSION) || (pccom4_trace_u16(&hdr[6]) < PCCOM4_TRACE_HDR_LEN))
+  {
+    (void)fclose(tr->f);
+    tr->f = NULL;
+    return false;
+  }
+  // Заголовок новой версии может быть длиннее: пропустить хвост.
+  if (fseek(tr->f, (long)pccom4_trace_u16(&hdr[6]), SEEK_SET) != 0)
+  {
+    (void)fclose(tr->f);
+    tr->f = NULL;
+    return false;
+  }
+  tr->t0_unix_ns = pccom4_trace_u64(&hdr[8]);
+  tr->bytes = pccom4_trace_u16(&hdr[6]);
+  return true;
+}
+
+int pccom4_trace_next(pccom4_trace_t *tr, pccom4_trace_rec_t *rec, uint8_t *data)
+{
+  uint8_t hdr[PCCOM4_TRACE_REC_HDR_LEN];
+  const size_t got = fread(hdr, 1u, sizeof(hdr), tr->f);
+  if (got != sizeof(hdr))
+  {
+    return ferror(tr->f) ? -1 : 0;
+  }
+  rec->t_ns = pccom4_trace_u64(&hdr[0]);
+  rec->len = pccom4_trace_u16(&hdr[8]);
+  rec->kind = hdr[10];
+  if (fread(data, 1u, rec->len, tr->f) != rec->len)
+  {
+    return ferror(tr->f) ? -1 : 0;
+  }
+  tr->records++;
+  tr->bytes += sizeof(hdr) + rec->len;
+  return 1;
+}
+
+bool pccom4_trace_close(pccom4_trace_t *tr)
+{
+  if (tr->f != NULL)
+  {
+    tr->error = (fclose(tr->f) != 0) || tr->error;
+    tr->f = NULL;
+  }
+  return !tr->error;
+}
@@ -0,0 +1,112 @@
+#ifndef PCCOM4_TRACE_H
+#define PCCOM4_TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file pccom4_trace.h
+ * @brief Бинарный контейнер трассы PCcom4 (`*.mftr`): непрерывная запись принятых байт и кадров с метками времени.
+ * @details
+ * Формат (LE):
+ * - заголовок файла PCCOM4_TRACE_HDR_LEN байт: `magic` u32 = PCCOM4_TRACE_MAGIC, `version` u16,
+ *   `hdr_len` u16, `t0_unix_ns` u64 (время старта записи), остальное — 0;
+ * - записи подряд: `t_ns` u64 (монотонное от старта), `len` u16, `kind` u8 (pccom4_trace_kind_t), 0 u8,
+ *   затем `len` байт. Для PCCOM4_TRACE_FRAME/PCCOM4_TRACE_TX — FRAME целиком (от `Length` до CRC, без `0xFF`);
+ *   для PCCOM4_TRACE_RX — блок байт порта как прочитан (до разбора, включая мусор и кадры с ошибкой CRC).
+ *
+ * Контейнер только дописывается (буфер stdio), поэтому обрыв записи теряет не больше хвостовой записи;
+ * читатель останавливается на неполной записи.
+ */
+
+#define PCCOM4_TRACE_MAGIC (0x5254464Du) /**< "MFTR". */
+#define PCCOM4_TRACE_VERSION (1u) /**< Версия формата. */
+#define PCCOM4_TRACE_HDR_LEN (32u) /**< Заголовок файла, [байт]. */
+#define PCCOM4_TRACE_REC_HDR_LEN (12u) /**< Заголовок записи, [байт]. */
+#define PCCOM4_TRACE_REC_MAX (0xFFFFu) /**< Максимум данных записи, [байт]. */
+
+/**
+ * @brief Вид записи.
+ */
+typedef enum {
+  PCCOM4_TRACE_FRAME = 1u, /**< Принятый кадр с верным CRC. */
+  PCCOM4_TRACE_TX = 2u, /**< Отправленный клиентом кадр. */
+  PCCOM4_TRACE_STATS = 3u, /**< Снимок счётчиков клиента (pccom4_client_trace_stats()). */
+  PCCOM4_TRACE_RX = 4u /**< Сырой принятый блок (до разбора): post-mortem ошибок CRC/resync. */
+} pccom4_trace_kind_t;
+
+/**
+ * @brief Заголовок записи.
+ */
+typedef struct {
+  uint64_t t_ns; /**< Время от старта записи, [нс]. */
+  uint16_t len; /**< Длина данных, [байт]. */
+  uint8_t kind; /**< Вид (pccom4_trace_kind_t). */
+} pccom4_trace_rec_t;
+
+/**
+ * @brief Открытый контейнер.
+ */
+typedef struct {
+  FILE *f; /**< Файл. */
+  uint64_t t0_unix_ns; /**< Время старта записи (UNIX), [нс]. */
+  uint64_t records; /**< Записей, [шт]. */
+  uint64_t bytes; /**< Байт в файле, [байт]. */
+  bool error; /**< Ошибка ввода-вывода. */
+} pccom4_trace_t;
+
+/**
+ * @brief Создать контейнер для записи.
+ * @param tr Контейнер.
+ * @param path Путь.
+ * @param t0_unix_ns Время старта (UNIX), [нс].
+ * @return false при ошибке открытия/записи.
+ */
+bool pccom4_trace_create(pccom4_trace_t *tr, const char *path, uint64_t t0_unix_ns);
+
+/**
+ * @brief Дописать запись.
+ * @param tr Контейнер.
+ * @param kind Вид.
+ * @param t_ns Время от старта, [нс].
+ * @param data Данные.
+ * @param len Длина, [байт] (<= PCCOM4_TRACE_REC_MAX).
+ * @return false при ошибке записи.
+ */
+bool pccom4_trace_append(pccom4_trace_t *tr, pccom4_trace_kind_t kind, uint64_t t_ns, const void *data,
+                         uint32_t len);
+
+/**
+ * @brief Открыть контейнер для чтения (проверка заголовка).
+ * @param tr Контейнер.
+ * @param path Путь.
+ * @return false при ошибке открытия или неверном заголовке.
+ */
+bool pccom4_trace_open(pccom4_trace_t *tr, const char *path);
+
+/**
+ * @brief Прочитать следующую запись.
+ * @param tr Контейнер.
+ * @param rec Заголовок записи.
+ * @param data Буфер данных (не меньше PCCOM4_TRACE_REC_MAX).
+ * @return 1 — запись, 0 — конец файла (включая неполную хвостовую запись), -1 — ошибка.
+ */
+int pccom4_trace_next(pccom4_trace_t *tr, pccom4_trace_rec_t *rec, uint8_t *data);
+
+/**
+ * @brief Закрыть контейнер (сброс буфера записи).
+ * @param tr Контейнер.
+ * @return false, если была ошибка ввода-вывода.
+ */
+bool pccom4_trace_close(pccom4_trace_t *tr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PCCOM4_TRACE_H */
@@ -0,0 +1,368 @@
+/**
+ * @file pccom4cap.c
+ * @brief CLI захвата PCcom4: live-приём в трассу `*.mftr` и разбор трассы.
+ * @details
+ * Режимы:
+ * - `capture --dev <path> [--baud <N>] [--out <file>] [--seconds <S>] [--scope <mask>,<decim>] [--print]` —
+ *   приём до SIGINT/таймаута/закрытия порта; `--scope` включает набор 1 `Scope.Data` (SignalMask, Decimation,
+ *   StreamControl=ON); раз в секунду в stderr — скорость и счётчики;
+ * - `dump <file> [--print]` — разбор трассы: счётчики по видам сообщений, последний снимок счётчиков захвата.
+ * Итог — строки `key=value` в stdout (удобно для скриптов/CTest).
+ */
+#include <inttypes.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "pccom4_client.h"
+#include "pccom4_decode.h"
+#include "pccom4_trace.h"
+
+#define PCCOM4CAP_IDLE_NS (500000L) /**< Пауза главного цикла без данных, [нс]. */
+#define PCCOM4CAP_KINDS (8u) /**< Видов сообщений (pccom4_msg_kind_t), [шт]. */
+
+static volatile sig_atomic_t s_stop; /**< SIGINT/SIGTERM. */
+static pccom4_msg_t s_msg; /**< Декодированное сообщение (большое — не на стеке). */
+
+/**
+ * @brief Состояние разбора.
+ */
+typedef struct {
+  uint64_t count[PCCOM4CAP_KINDS]; /**< Сообщений по видам, [шт]. */
+  uint64_t scope_samples; /**< Значений Scope.Data, [шт]. */
+  bool print; /**< Печатать каждое сообщение. */
+  uint64_t t_ns; /**< Время текущего кадра, [нс]. */
+} pccom4cap_ctx_t;
+
+/**
+ * @brief Обработчик сигнала остановки.
+ * @param sig Номер сигнала.
+ * @return None.
+ */
+static void pccom4cap_on_signal(int sig)
+{
+  (void)sig;
+  s_stop = 1;
+}
+
+/**
+ * @brief Напечатать сообщение (одна строка).
+ * @param ctx Состояние.
+ * @param frame Кадр.
+ * @return None.
+ */
+static void pccom4cap_print(const pccom4cap_ctx_t *ctx, const pccom4_frame_t *frame)
+{
+  (void)printf("%12.6f node=0x%02X op=0x%02X type=0x%02X len=%u %s", (double)ctx->t_ns * 1e-9, frame->node,
+               frame->op, frame->type, frame->data_len, pccom4_msg_name(s_msg.kind));
+  switch (s_msg.kind)
+  {
+    case PCCOM4_MSG_CMD_WELD:
+      (void)printf(" seq=%u mode=%u enable=%u i_ref_ma=%" PRId32, s_msg.cmd.seq, s_msg.cmd.mode, s_msg.cmd.enable,
+                   s_msg.cmd.i_ref_cmd_ma);
+      break;
+    case PCCOM4_MSG_FB_STATUS:
+      (void)printf(" seq_applied=%u state=%u status=0x%04X fault=0x%04X i_per_ma=%" PRId32, s_msg.fb.seq_applied,
+                   s_msg.fb.state, s_msg.fb.status_word, s_msg.fb.fault_word, s_msg.fb.i_per_ma);
+      break;
+    case PCCOM4_MSG_PDO_STATS:
+      (void)printf(" rx_ok=%" PRIu32 " rx_crc_err=%" PRIu32 " rx_missed=%" PRIu32, s_msg.stats.rx_ok,
+                   s_msg.stats.rx_crc_err, s_msg.stats.rx_missed);
+      break;
+    case PCCOM4_MSG_SCOPE_VARS:
+      (void)printf(" gen=%u seq=%u mask=0x%08" PRIX32 " n=%u", s_msg.vars.gen, s_msg.vars.seq, s_msg.vars.mask,
+                   s_msg.vars.n_samples);
+      break;
+    case PCCOM4_MSG_SCOPE_RAW:
+      (void)printf(" set=%u blocks=%" PRIu32 " frames=%" PRIu32 " ch=%" PRIu32, s_msg.raw_set, s_msg.raw_blocks,
+                   s_msg.raw_frames, s_msg.raw_n_ch);
+      break;
+    default:
+      break;
+  }
+  (void)printf("\n");
+}
+
+/**
+ * @brief Обработчик кадра: декодирование, счётчики, печать.
+ * @param user Состояние (pccom4cap_ctx_t).
+ * @param frame Кадр.
+ * @return None.
+ */
+static void pccom4cap_on_frame(void *user, const pccom4_frame_t *frame)
+{
+  pccom4cap_ctx_t *ctx = (pccom4cap_ctx_t *)user;
+  const pccom4_msg_kind_t kind = pccom4_decode(frame, &s_msg);
+  ctx->count[kind]++;
+  if (kind == PCCOM4_MSG_SCOPE_VARS)
+  {
+    ctx->scope_samples += (uint64_t)s_msg.vars.n_samples * s_msg.vars.n_sel;
+  }
+  else if (kind == PCCOM4_MSG_SCOPE_RAW)
+  {
+    ctx->scope_samples += (uint64_t)s_msg.raw_frames * s_msg.raw_n_ch;
+  }
+  if (ctx->print)
+  {
+    pccom4cap_print(ctx, frame);
+  }
+}
+
+/**
+ * @brief Итог в stdout (`key=value`).
+ * @param ctx Состояние.
+ * @param st Счётчики захвата.
+ * @return None.
+ */
+static void pccom4cap_summary(const pccom4cap_ctx_t *ctx, const pccom4_client_stats_t *st)
+{
+  (void)printf("rx_bytes=%" PRIu64 "\n", st->rx_bytes);
+  (void)printf("rx_ok=%" PRIu32 "\nrx_crc_err=%" PRIu32 "\nrx_len_err=%" PRIu32 "\n", st->parser.rx_ok,
+               st->parser.rx_crc_err, st->parser.rx_len_err);
+  (void)printf("parser_resync_count=%" PRIu32 "\nbytes_skipped=%" PRIu32 "\n", st->parser.parser_resync_count,
+               st->parser.bytes_skipped);
+  (void)printf("rxq_highwater=%" PRIu32 "\nrxq_stall=%" PRIu32 "\ntx_frames=%" PRIu32 "\n", st->rxq_highwater,
+               st->rxq_stall, st->tx_frames);
+  for (uint32_t k = 0u; k < PCCOM4CAP_KINDS; ++k)
+  {
+    (void)printf("msg_%s=%" PRIu64 "\n", pccom4_msg_name((pccom4_msg_kind_t)k), ctx->count[k]);
+  }
+  (void)printf("scope_samples=%" PRIu64 "\n", ctx->scope_samples);
+}
+
+/**
+ * @brief Включить набор 1 `Scope.Data`: маска, децимация, StreamControl=ON.
+ * @param cl Клиент.
+ * @param arg `<mask>,<decim>`.
+ * @return false при ошибке аргумента/отправки.
+ */
+static bool pccom4cap_scope_on(pccom4_client_t *cl, const char *arg)
+{
+  char *end = NULL;
+  const unsigned long mask = strtoul(arg, &end, 0);
+  if ((end == NULL) || (*end != ','))
+  {
+    return false;
+  }
+  const unsigned long decim = strtoul(end + 1, &end, 0);
+  if ((*end != '\0') || (decim == 0u) || (decim > 0xFFFFu) || (mask > 0xFFFFFFFFu))
+  {
+    return false;
+  }
+  const uint8_t m[4] = {(uint8_t)(mask & 0xFFu), (uint8_t)((mask >> 8) & 0xFFu), (uint8_t)((mask >> 16) & 0xFFu),
+                        (uint8_t)((mask >> 24) & 0xFFu)};
+  const uint8_t d[2] = {(uint8_t)(decim & 0xFFu), (uint8_t)(decim >> 8)};
+  const uint8_t on = 0x01u;
+  return pccom4_client_send(cl, PCCOM4_TYPE_WRITE, PCCOM4_NODE_SCOPE, PCCOM4_OP_SCOPE_MASK, m, sizeof(m)) &&
+         pccom4_client_send(cl, PCCOM4_TYPE_WRITE, PCCOM4_NODE_SCOPE, PCCOM4_OP_SCOPE_DECIM, d, sizeof(d)) &&
+         pccom4_client_send(cl, PCCOM4_TYPE_WRITE, PCCOM4_NODE_SCOPE, PCCOM4_OP_SCOPE_STREAM, &on, 1u);
+}
+
+/**
+ * @brief Режим `capture`.
+ * @param argc Количество аргументов.
+ * @param argv Аргументы (после имени режима).
+ * @return Код завершения.
+ */
+static int pccom4cap_capture(int argc, char **argv)
+{
+  pccom4_client_cfg_t cfg = {NULL, 0u, NULL, 0u, PCCOM4_ADDR_PC, PCCOM4_ADDR_USPF};
+  double seconds = 0.0;
+  const char *scope = NULL;
+  pccom4cap_ctx_t ctx = {{0}, 0u, false, 0u};
+  for (int i = 0; i < argc; ++i)
+  {
+    if ((strcmp(argv[i], "--dev") == 0) && ((i + 1) < argc))
+    {
+      cfg.dev = argv[++i];
+    }
+    else if ((strcmp(argv[i], "--baud") == 0) && ((i + 1) < argc))
+    {
+      cfg.baud = (uint32_t)strtoul(argv[++i], NULL, 0);
+    }
+    else if ((strcmp(argv[i], "--out") == 0) && ((i + 1) < argc))
+    {
+      cfg.trace_path = argv[++i];
+    }
+    else if ((strcmp(argv[i], "--seconds") == 0) && ((i + 1) < argc))
+    {
+      seconds = strtod(argv[++i], NULL);
+    }
+    else if ((strcmp(argv[i], "--scope") == 0) && ((i + 1) < argc))
+    {
+      scope = argv[++i];
+    }
+    else if (strcmp(argv[i], "--print") == 0)
+    {
+      ctx.print = true;
+    }
+    else
+    {
+      (void)fprintf(stderr, "pccom4cap: unknown argument %s\n", argv[i]);
+      return 2;
+    }
+  }
+  if (cfg.dev == NULL)
+  {
+    (void)fprintf(stderr, "pccom4cap: --dev is required\n");
+    return 2;
+  }
+
+  pccom4_client_t *cl = calloc(1u, sizeof(*cl));
+  if ((cl == NULL) || !pccom4_client_open(cl, &cfg))
+  {
+    (void)fprintf(stderr, "pccom4cap: cannot open %s%s%s\n", cfg.dev, (cfg.trace_path != NULL) ? " / " : "",
+                  (cfg.trace_path != NULL) ? cfg.trace_path : "");
+    free(cl);
+    return 1;
+  }
+  if ((scope != NULL) && !pccom4cap_scope_on(cl, scope))
+  {
+    (void)fprintf(stderr, "pccom4cap: --scope %s failed\n", scope);
+  }
+
+  // Главный цикл: разбор очереди, раз в секунду — строка состояния.
+  const uint64_t t_start = pccom4_now_ns();
+  uint64_t t_report = t_start;
+  uint64_t bytes_report = 0u;
+  pccom4_client_stats_t st;
+  while (s_stop == 0)
+  {
+    if (pccom4_client_poll(cl, pccom4cap_on_frame, &ctx, &ctx.t_ns) == 0u)
+    {
+      const struct timespec idle = {0, PCCOM4CAP_IDLE_NS};
+      (void)nanosleep(&idle, NULL);
+    }
+    pccom4_client_stats(cl, &st);
+    const uint64_t now = pccom4_now_ns();
+    if ((now - t_report) >= 1000000000ull)
+    {
+      (void)fprintf(stderr, "t=%.1fs rx=%.3f MB/s frames=%" PRIu32 " crc_err=%" PRIu32 " resync=%" PRIu32
+                    " rxq_hw=%" PRIu32 " stall=%" PRIu32 "\n",
+                    (double)(now - t_start) * 1e-9, (double)(st.rx_bytes - bytes_report) * 1e-6 * 1e9 /
+                    (double)(now - t_report), st.parser.rx_ok, st.parser.rx_crc_err, st.parser.parser_resync_count,
+                    st.rxq_highwater, st.rxq_stall);
+      (void)pccom4_client_trace_stats(cl);
+      t_report = now;
+      bytes_report = st.rx_bytes;
+    }
+    if (st.rx_closed || ((seconds > 0.0) && ((double)(now - t_start) * 1e-9 >= seconds)))
+    {
+      break;
+    }
+  }
+
+  const bool ok = pccom4_client_close(cl, pccom4cap_on_frame, &ctx);
+  pccom4_client_stats(cl, &st);
+  pccom4cap_summary(&ctx, &st);
+  (void)printf("trace_ok=%d\n", ok ? 1 : 0);
+  free(cl);
+  return ok ? 0 : 1;
+}
+
+/**
+ * @brief Режим `dump`.
+ * @param argc Количество аргументов.
+ * @param argv Аргументы (после имени режима).
+ * @return Код завершения.
+ */
+static int pccom4cap_dump(int argc, char **argv)
+{
+  const char *path = NULL;
+  pccom4cap_ctx_t ctx = {{0}, 0u, false, 0u};
+  for (int i = 0; i < argc; ++i)
+  {
+    if (strcmp(argv[i], "--print") == 0)
+    {
+      ctx.print = true;
+    }
+    else
+    {
+      path = argv[i];
+    }
+  }
+  pccom4_trace_t tr;
+  if ((path == NULL) || !pccom4_trace_open(&tr, path))
+  {
+    (void)fprintf(stderr, "pccom4cap: cannot open trace %s\n", (path != NULL) ? path : "(none)");
+    return 2;
+  }
+
+  static uint8_t data[PCCOM4_TRACE_REC_MAX];
+  uint8_t wire[PCCOM4_WIRE_MAX];
+  pccom4_parser_t parser;
+  pccom4_parser_init(&parser);
+  pccom4_parser_t raw; /* Повторный разбор сырых блоков RX: ошибки линии, а не записи. */
+  pccom4_parser_init(&raw);
+  pccom4_client_stats_t st;
+  const pccom4_client_stats_t zero = {0};
+  st = zero;
+  uint64_t n_tx = 0u;
+  uint64_t n_rx = 0u;
+  uint64_t rx_raw_bytes = 0u; /* [байт] */
+  pccom4_trace_rec_t rec;
+  int r = pccom4_trace_next(&tr, &rec, data);
+  while (r > 0)
+  {
+    ctx.t_ns = rec.t_ns;
+    if ((rec.kind == PCCOM4_TRACE_FRAME) && (rec.len < PCCOM4_WIRE_MAX))
+    {
+      // Через парсер: CRC записанного кадра проверяется ещё раз.
+      wire[0] = (uint8_t)PCCOM4_PREAMBLE;
+      memcpy(&wire[1], data, rec.len);
+      (void)pccom4_parser_feed(&parser, wire, (uint32_t)rec.len + 1u, pccom4cap_on_frame, &ctx);
+    }
+    else if (rec.kind == PCCOM4_TRACE_TX)
+    {
+      n_tx++;
+    }
+    else if (rec.kind == PCCOM4_TRACE_STATS)
+    {
+      (void)pccom4_client_stats_unpack(data, rec.len, &st);
+    }
+    else if (rec.kind == PCCOM4_TRACE_RX)
+    {
+      n_rx++;
+      rx_raw_bytes += rec.len;
+      (void)pccom4_parser_feed(&raw, data, rec.len, NULL, NULL);
+    }
+    r = pccom4_trace_next(&tr, &rec, data);
+  }
+  (void)pccom4_trace_close(&tr);
+
+  // Счётчики захвата — из последнего снимка в трассе; целостность записанных кадров — из повторного разбора.
+  pccom4cap_summary(&ctx, &st);
+  (void)printf("records=%" PRIu64 "\ntx_records=%" PRIu64 "\nframes_recheck_ok=%" PRIu32 "\n", tr.records, n_tx,
+               parser.stats.rx_ok);
+  (void)printf("rx_raw_records=%" PRIu64 "\nrx_raw_bytes=%" PRIu64 "\n", n_rx, rx_raw_bytes);
+  (void)printf("rx_raw_ok=%" PRIu32 "\nrx_raw_crc_err=%" PRIu32 "\nrx_raw_resync=%" PRIu32 "\n", raw.stats.rx_ok,
+               raw.stats.rx_crc_err, raw.stats.parser_resync_count);
+  return (r < 0) || (parser.stats.rx_crc_err != 0u) ? 1 : 0;
+}
+
+/**
+ * @brief Точка входа.
+ * @param argc Количество аргументов командной строки, [шт].
+ * @param argv Массив аргументов командной строки.
+ * @return Код завершения (0 = OK, 1 = ошибка, 2 = ошибка использования).
+ */
+int main(int argc, char **argv)
+{
+  (void)signal(SIGINT, pccom4cap_on_signal);
+  (void)signal(SIGTERM, pccom4cap_on_signal);
+  if ((argc >= 2) && (strcmp(argv[1], "capture") == 0))
+  {
+    return pccom4cap_capture(argc - 2, &argv[2]);
+  }
+  if ((argc >= 2) && (strcmp(argv[1], "dump") == 0))
+  {
+    return pccom4cap_dump(argc - 2, &argv[2]);
+  }
+  (void)fprintf(stderr,
+                "usage: pccom4cap capture --dev <path> [--baud <N>] [--out <file.mftr>] [--seconds <S>]"
+                " [--scope <mask>,<decim>] [--print]\n"
+                "       pccom4cap dump <file.mftr> [--print]\n");
+  return 2;
+}
@@ -0,0 +1,585 @@
+/**
+ * @file pccom4gen.c
+ * @brief Генератор `TkPdo.Emu.CmdWeld` (ADR-003: эмуляция EtherCAT PDO по PCcom4) с точным темпом и сбором
+ * `FbStatus`: замена ТК на стенде с производственными таймингами.
+ * @details
+ * - темп: абсолютные дедлайны `t0 + k * T`; сон timerfd (Linux, CLOCK_MONOTONIC, TFD_TIMER_ABSTIME) до
+ *   `дедлайн - spin`, затем busy-poll часов до дедлайна; опоздание больше периода пропускает слоты
+ *   (`tx_slots_skipped`) без догоняющей пачки;
+ * - `seq`: +1 на каждый отправленный кадр (wrap 0xFFFF → 0x0000, PROTOCOL_TK_ETHERCAT §1.2.3);
+ * - профиль (`--profile`): текстовый файл шагов `<duration_ms> <mode> <enable> <i_ref_ma> [max_slew_a_ms]
+ *   [target] [fault_reset]`, `#` — комментарий; шаги проверяются tk_pdo_cmd_weld_validate() при загрузке;
+ *   без профиля — `IDLE`/`enable=0` (keepalive);
+ * - ответы: RTT по первому `FbStatus` с `seq_applied` = `seq` (время read() на ПК), пропуски/повторы
+ *   `seq_applied`, последние счётчики устройства (`cnt_seq_gap`, `cnt_cmd_reject`, `cnt_comms_fault`).
+ * Итог — строки `key=value` (перцентили и гистограмма RTT); `--max-rtt-p99-us`/`--min-reply-ratio` — проверка.
+ */
+#define _GNU_SOURCE /* sched_setscheduler(), mlockall() */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/timerfd.h>
+#endif
+
+#include "pccom4_client.h"
+#include "pccom4_decode.h"
+#include "tk_pdo_codec.h"
+
+#define PCCOM4GEN_SEQ_N (65536u) /**< Меток времени по `seq`, [шт]. */
+#define PCCOM4GEN_SAMPLES_MAX (1u << 22) /**< Отсчётов RTT/опоздания (~17 мин при 4 кГц), [шт]. */
+#define PCCOM4GEN_STEPS_MAX (1024u) /**< Шагов профиля, [шт]. */
+#define PCCOM4GEN_DRAIN_NS (100000000ull) /**< Ожидание ответов после последней команды, [нс]. */
+#define PCCOM4GEN_HIST_N (9u) /**< Корзин гистограммы RTT, [шт]. */
+
+/**
+ * @brief Шаг профиля.
+ */
+typedef struct {
+  uint64_t end_ns; /**< Конец шага от старта, [нс]. */
+  tk_cmd_weld_t cmd; /**< Поля команды (`seq` подставляется при отправке). */
+} pccom4gen_step_t;
+
+/**
+ * @brief Параметры.
+ */
+typedef struct {
+  const char *dev; /**< Порт. */
+  uint32_t baud; /**< Скорость, [бод] (0 — не менять). */
+  const char *out; /**< Трасса `*.mftr` (NULL — без записи). */
+  const char *profile; /**< Файл профиля (NULL — keepalive IDLE). */
+  double hz; /**< Частота команд, [Гц]. */
+  double seconds; /**< Длительность, [с] (0 — длина профиля). */
+  uint32_t spin_us; /**< Busy-poll перед дедлайном, [мкс]. */
+  bool loop; /**< Повторять профиль. */
+  bool rt; /**< SCHED_FIFO + mlockall(). */
+  double max_rtt_p99_us; /**< Порог p99 RTT (0 — без проверки), [мкс]. */
+  double min_reply_ratio; /**< Порог доли команд с ответом (0 — без проверки), [-]. */
+} pccom4gen_cfg_t;
+
+/**
+ * @brief Учёт ответов.
+ */
+typedef struct {
+  pccom4_client_t *cl; /**< Клиент. */
+  uint32_t fb_rx; /**< Принято `FbStatus`, [шт]. */
+  uint32_t n_rtt; /**< Команд с ответом, [шт]. */
+  bool has_last; /**< Был `FbStatus`. */
+  uint16_t last_seq; /**< Последний `seq_applied`. */
+  uint32_t fb_seq_gap; /**< Пропущено `seq_applied` (delta-1 при 1<delta<=0x7FFF), [шт]. */
+  uint32_t fb_seq_repeat; /**< Повторов `seq_applied`, [шт]. */
+  uint32_t fb_seq_backward; /**< Скачков `seq_applied` назад, [шт]. */
+  tk_fb_status_t fb; /**< Последний `FbStatus`. */
+} pccom4gen_rx_t;
+
+static volatile sig_atomic_t s_stop; /**< SIGINT/SIGTERM. */
+static uint64_t s_t_send[PCCOM4GEN_SEQ_N]; /**< Время отправки по `seq` (0 — ответ уже учтён), [нс]. */
+static uint32_t s_rtt_ns[PCCOM4GEN_SAMPLES_MAX]; /**< RTT, [нс]. */
+static uint32_t s_late_ns[PCCOM4GEN_SAMPLES_MAX]; /**< Опоздание отправки относительно дедлайна, [нс]. */
+static pccom4gen_step_t s_steps[PCCOM4GEN_STEPS_MAX]; /**< Профиль. */
+
+/**
+ * @brief Обработчик сигнала остановки.
+ * @param sig Номер сигнала.
+ * @return None.
+ */
+static void pccom4gen_on_signal(int sig)
+{
+  (void)sig;
+  s_stop = 1;
+}
+
+/**
+ * @brief Загрузить профиль.
+ * @param path Файл.
+ * @param n_steps Выход: шагов, [шт].
+ * @return false при ошибке чтения/формата/валидации (сообщение в stderr).
+ */
+static bool pccom4gen_load_profile(const char *path, uint32_t *n_steps)
+{
+  FILE *f = fopen(path, "r");
+  if (f == NULL)
+  {
+    (void)fprintf(stderr, "pccom4gen: cannot open profile %s\n", path);
+    return false;
+  }
+  char line[256];
+  uint32_t lineno = 0u;
+  uint64_t t_end = 0u;
+  bool ok = true;
+  *n_steps = 0u;
+  while (ok && (fgets(line, sizeof(line), f) != NULL))
+  {
+    lineno++;
+    char *hash = strchr(line, '#');
+    if (hash != NULL)
+    {
+      *hash = '\0';
+    }
+    double dur_ms = 0.0;
+    unsigned mode = 0u;
+    unsigned enable = 0u;
+    long i_ref = 0;
+    unsigned slew = 0u;
+    unsigned target = 0u;
+    unsigned fault_reset = 0u;
+    const int n = sscanf(line, "%lf %u %u %ld %u %u %u", &dur_ms, &mode, &enable, &i_ref, &slew, &target,
+                         &fault_reset);
+    if (n <= 0)
+    {
+      continue;
+    }
+    const tk_cmd_weld_t zero = {0};
+    tk_cmd_weld_t cmd = zero;
+    cmd.mode = (uint8_t)mode;
+    cmd.enable = (uint8_t)enable;
+    cmd.i_ref_cmd_ma = (int32_t)i_ref;
+    cmd.max_slew_rate_a_ms = (uint16_t)slew;
+    cmd.target = (uint16_t)target;
+    cmd.fault_reset = (uint8_t)fault_reset;
+    const uint32_t reject = tk_pdo_cmd_weld_validate(&cmd, fault_reset != 0u);
+    if ((n < 4) || (dur_ms <= 0.0) || (mode > 0xFFu) || (enable > 0xFFu) || (slew > 0xFFFFu) ||
+        (target > 0xFFFFu) || (fault_reset > 0xFFu) || (reject != 0u) || (*n_steps >= PCCOM4GEN_STEPS_MAX))
+    {
+      (void)fprintf(stderr, "pccom4gen: %s:%" PRIu32 ": invalid step (reject=0x%03" PRIX32 ")\n", path, lineno,
+                    reject);
+      ok = false;
+      break;
+    }
+    t_end += (uint64_t)(dur_ms * 1e6);
+    s_steps[*n_steps].end_ns = t_end;
+    s_steps[*n_steps].cmd = cmd;
+    (*n_steps)++;
+  }
+  (void)fclose(f);
+  if (ok && (*n_steps == 0u))
+  {
+    (void)fprintf(stderr, "pccom4gen: %s: no steps\n", path);
+    ok = false;
+  }
+  return ok;
+}
+
+/**
+ * @brief Команда для момента t от старта.
+ * @param n_steps Шагов профиля, [шт] (0 — keepalive).
+ * @param loop Повторять профиль.
+ * @param t_ns Время от старта, [нс].
+ * @param cmd Результат.
+ * @return false — профиль закончился.
+ */
+static bool pccom4gen_profile_at(uint32_t n_steps, bool loop, uint64_t t_ns, tk_cmd_weld_t *cmd)
+{
+  const tk_cmd_weld_t zero = {0};
+  if (n_steps == 0u)
+  {
+    *cmd = zero;
+    return true;
+  }
+  const uint64_t total = s_steps[n_steps - 1u].end_ns;
+  if (t_ns >= total)
+  {
+    if (!loop)
+    {
+      return false;
+    }
+    t_ns %= total;
+  }
+  uint32_t i = 0u;
+  while (s_steps[i].end_ns <= t_ns)
+  {
+    i++;
+  }
+  *cmd = s_steps[i].cmd;
+  return true;
+}
+
+/**
+ * @brief Дождаться дедлайна: timerfd до `deadline - spin`, затем busy-poll.
+ * @param tfd timerfd (-1 — clock_nanosleep()).
+ * @param deadline_ns Дедлайн (CLOCK_MONOTONIC), [нс].
+ * @param spin_ns Busy-poll, [нс].
+ * @return None.
+ */
+static void pccom4gen_wait_until(int tfd, uint64_t deadline_ns, uint64_t spin_ns)
+{
+  const uint64_t now = pccom4_now_ns();
+  if ((deadline_ns > now) && ((deadline_ns - now) > spin_ns))
+  {
+    const uint64_t wake = deadline_ns - spin_ns;
+    const struct timespec ts = {(time_t)(wake / 1000000000ull), (long)(wake % 1000000000ull)};
+    bool slept = false;
+#ifdef __linux__
+    if (tfd >= 0)
+    {
+      const struct itimerspec its = {{0, 0}, ts};
+      uint64_t expirations = 0u;
+      slept = (timerfd_settime(tfd, TFD_TIMER_ABSTIME, &its, NULL) == 0) &&
+              (read(tfd, &expirations, sizeof(expirations)) == (ssize_t)sizeof(expirations));
+    }
+#else
+    (void)tfd;
+#endif
+    if (!slept)
+    {
+      (void)clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+    }
+  }
+  while (pccom4_now_ns() < deadline_ns)
+  {
+    // busy-poll: точность дедлайна важнее загрузки ядра на стенде.
+  }
+}
+
+/**
+ * @brief Обработчик кадров: `FbStatus` → RTT, анализ `seq_applied`.
+ * @param user Учёт ответов.
+ * @param frame Кадр.
+ * @return None.
+ */
+static void pccom4gen_on_frame(void *user, const pccom4_frame_t *frame)
+{
+  pccom4gen_rx_t *rx = (pccom4gen_rx_t *)user;
+  if ((frame->node != PCCOM4_NODE_TKPDO_EMU) || (frame->op != PCCOM4_OP_FB_STATUS) ||
+      (frame->data_len != TK_PDO_FB_STATUS_SIZE_BYTES))
+  {
+    return;
+  }
+  uint32_t window[TK_PDO_FB_STATUS_SIZE_WORDS];
+  memcpy(window, frame->data, TK_PDO_FB_STATUS_SIZE_BYTES);
+  (void)tk_pdo_fb_status_unpack(window, &rx->fb);
+  rx->fb_rx++;
+
+  const uint16_t s = rx->fb.seq_applied;
+  if (rx->has_last)
+  {
+    const uint16_t delta = (uint16_t)(s - rx->last_seq);
+    if (delta == 0u)
+    {
+      rx->fb_seq_repeat++;
+    }
+    else if (delta > 0x7FFFu)
+    {
+      rx->fb_seq_backward++;
+    }
+    else
+    {
+      rx->fb_seq_gap += (uint32_t)delta - 1u;
+    }
+  }
+  rx->has_last = true;
+  rx->last_seq = s;
+
+  // RTT — по первому ответу на `seq` (устройство может повторять `FbStatus` без новой команды).
+  const uint64_t t_rx = rx->cl->t0_ns + rx->cl->chunk_t_ns;
+  if ((s_t_send[s] != 0u) && (t_rx >= s_t_send[s]) && (rx->n_rtt < PCCOM4GEN_SAMPLES_MAX))
+  {
+    const uint64_t rtt = t_rx - s_t_send[s];
+    s_rtt_ns[rx->n_rtt] = (uint32_t)((rtt > UINT32_MAX) ? UINT32_MAX : rtt);
+    rx->n_rtt++;
+    s_t_send[s] = 0u;
+  }
+}
+
+/**
+ * @brief Сравнение для qsort().
+ * @param a Элемент.
+ * @param b Элемент.
+ * @return <0, 0, >0.
+ */
+static int pccom4gen_cmp_u32(const void *a, const void *b)
+{
+  const uint32_t x = *(const uint32_t *)a;
+  const uint32_t y = *(const uint32_t *)b;
+  return (x > y) - (x < y);
+}
+
+/**
+ * @brief Перцентиль отсортированного массива.
+ * @param v Отсчёты, [нс].
+ * @param n Количество, [шт].
+ * @param q Квантиль 0..1.
+ * @return Значение, [мкс] (0 — нет отсчётов).
+ */
+static double pccom4gen_pct_us(const uint32_t *v, uint32_t n, double q)
+{
+  if (n == 0u)
+  {
+    return 0.0;
+  }
+  return (double)v[(uint32_t)(q * (double)(n - 1u) + 0.5)] * 1e-3;
+}
+
+/**
+ * @brief Напечатать распределение (перцентили).
+ * @param name Префикс ключа.
+ * @param v Отсчёты (сортируются на месте), [нс].
+ * @param n Количество, [шт].
+ * @return p99, [мкс].
+ */
+static double pccom4gen_print_dist(const char *name, uint32_t *v, uint32_t n)
+{
+  static const double q[] = {0.5, 0.9, 0.99, 0.999, 1.0};
+  static const char *const tag[] = {"p50", "p90", "p99", "p999", "max"};
+  qsort(v, n, sizeof(v[0]), pccom4gen_cmp_u32);
+  for (uint32_t i = 0u; i < (sizeof(q) / sizeof(q[0])); ++i)
+  {
+    (void)printf("%s_us_%s=%.1f\n", name, tag[i], pccom4gen_pct_us(v, n, q[i]));
+  }
+  return pccom4gen_pct_us(v, n, 0.99);
+}
+
+/**
+ * @brief Разбор аргументов.
+ * @param argc Количество аргументов.
+ * @param argv Аргументы.
+ * @param cfg Результат.
+ * @return false при ошибке.
+ */
+static bool pccom4gen_parse_args(int argc, char **argv, pccom4gen_cfg_t *cfg)
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    const bool has = (i + 1) < argc;
+    if ((strcmp(argv[i], "--dev") == 0) && has)
+    {
+      cfg->dev = argv[++i];
+    }
+    else if ((strcmp(argv[i], "--baud") == 0) && has)
+    {
+      cfg->baud = (uint32_t)strtoul(argv[++i], NULL, 0);
+    }
+    else if ((strcmp(argv[i], "--out") == 0) && has)
+    {
+      cfg->out = argv[++i];
+    }
+    else if ((strcmp(argv[i], "--profile") == 0) && has)
+    {
+      cfg->profile = argv[++i];
+    }
+    else if ((strcmp(argv[i], "--hz") == 0) && has)
+    {
+      cfg->hz = strtod(argv[++i], NULL);
+    }
+    else if ((strcmp(argv[i], "--seconds") == 0) && has)
+    {
+      cfg->seconds = strtod(argv[++i], NULL);
+    }
+    else if ((strcmp(argv[i], "--spin-us") == 0) && has)
+    {
+      cfg->spin_us = (uint32_t)strtoul(argv[++i], NULL, 0);
+    }
+    else if ((strcmp(argv[i], "--max-rtt-p99-us") == 0) && has)
+    {
+      cfg->max_rtt_p99_us = strtod(argv[++i], NULL);
+    }
+    else if ((strcmp(argv[i], "--min-reply-ratio") == 0) && has)
+    {
+      cfg->min_reply_ratio = strtod(argv[++i], NULL);
+    }
+    else if (strcmp(argv[i], "--loop") == 0)
+    {
+      cfg->loop = true;
+    }
+    else if (strcmp(argv[i], "--rt") == 0)
+    {
+      cfg->rt = true;
+    }
+    else
+    {
+      (void)fprintf(stderr, "pccom4gen: unknown argument %s\n", argv[i]);
+      return false;
+    }
+  }
+  return (cfg->dev != NULL) && (cfg->hz > 0.0) && (cfg->hz <= 100000.0) &&
+         ((cfg->profile != NULL) || (cfg->seconds > 0.0));
+}
+
+/**
+ * @brief Точка входа.
+ * @param argc Количество аргументов командной строки, [шт].
+ * @param argv Массив аргументов командной строки.
+ * @return Код завершения (0 = OK, 1 = проверка не пройдена/ошибка, 2 = ошибка использования).
+ */
+int main(int argc, char **argv)
+{
+  pccom4gen_cfg_t cfg = {NULL, 0u, NULL, NULL, 4000.0, 0.0, 100u, false, false, 0.0, 0.0};
+  if (!pccom4gen_parse_args(argc, argv, &cfg))
+  {
+    (void)fprintf(stderr,
+                  "usage: pccom4gen --dev <path> [--baud <N>] [--hz 4000] (--seconds <S> | --profile <file> [--loop])\n"
+                  "                 [--out <file.mftr>] [--spin-us 100] [--rt] [--max-rtt-p99-us <X>]"
+                  " [--min-reply-ratio <R>]\n");
+    return 2;
+  }
+  uint32_t n_steps = 0u;
+  if ((cfg.profile != NULL) && !pccom4gen_load_profile(cfg.profile, &n_steps))
+  {
+    return 2;
+  }
+  (void)signal(SIGINT, pccom4gen_on_signal);
+  (void)signal(SIGTERM, pccom4gen_on_signal);
+
+  // Шаг 1: Реальное время (по возможности) — иначе остаётся только точность timerfd + busy-poll.
+  if (cfg.rt)
+  {
+    const struct sched_param sp = {sched_get_priority_max(SCHED_FIFO) / 2};
+    if ((sched_setscheduler(0, SCHED_FIFO, &sp) != 0) || (mlockall(MCL_CURRENT | MCL_FUTURE) != 0))
+    {
+      (void)fprintf(stderr, "pccom4gen: --rt unavailable (%s), continuing without\n", strerror(errno));
+    }
+  }
+
+  // Шаг 2: Клиент и таймер.
+  pccom4_client_t *cl = calloc(1u, sizeof(*cl));
+  const pccom4_client_cfg_t ccfg = {cfg.dev, cfg.baud, cfg.out, 0u, PCCOM4_ADDR_PC, PCCOM4_ADDR_USPF};
+  if ((cl == NULL) || !pccom4_client_open(cl, &ccfg))
+  {
+    (void)fprintf(stderr, "pccom4gen: cannot open %s\n", cfg.dev);
+    free(cl);
+    return 1;
+  }
+  int tfd = -1;
+#ifdef __linux__
+  tfd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+#endif
+
+  // Шаг 3: Цикл слотов.
+  pccom4gen_rx_t rx;
+  const pccom4gen_rx_t rx_zero = {0};
+  rx = rx_zero;
+  rx.cl = cl;
+  const uint64_t period_ns = (uint64_t)(1e9 / cfg.hz);
+  const uint64_t spin_ns = (uint64_t)cfg.spin_us * 1000u;
+  const uint64_t limit_ns = (cfg.seconds > 0.0) ? (uint64_t)(cfg.seconds * 1e9) : UINT64_MAX;
+  const uint64_t t0 = pccom4_now_ns() + period_ns;
+  uint64_t slot = 0u;
+  uint16_t seq = 1u;
+  uint32_t tx_sent = 0u;
+  uint32_t tx_err = 0u;
+  uint64_t tx_slots_skipped = 0u;
+  uint32_t n_late = 0u;
+  tk_cmd_weld_t cmd;
+  while ((s_stop == 0) && ((slot * period_ns) < limit_ns) &&
+         pccom4gen_profile_at(n_steps, cfg.loop, slot * period_ns, &cmd))
+  {
+    const uint64_t deadline = t0 + (slot * period_ns);
+    pccom4gen_wait_until(tfd, deadline, spin_ns);
+
+    cmd.seq = seq;
+    uint32_t window[TK_PDO_CMD_WELD_SIZE_WORDS];
+    tk_pdo_cmd_weld_pack(&cmd, window);
+    const uint64_t t_tx = pccom4_now_ns();
+    if (pccom4_client_send(cl, PCCOM4_TYPE_MESSAGE, PCCOM4_NODE_TKPDO_EMU, PCCOM4_OP_CMD_WELD,
+                           (const uint8_t *)window, TK_PDO_CMD_WELD_SIZE_BYTES))
+    {
+      s_t_send[seq] = t_tx;
+      tx_sent++;
+      seq = (uint16_t)(seq + 1u);
+    }
+    else
+    {
+      tx_err++;
+    }
+    if (n_late < PCCOM4GEN_SAMPLES_MAX)
+    {
+      s_late_ns[n_late++] = (uint32_t)(((t_tx - deadline) > UINT32_MAX) ? UINT32_MAX : (t_tx - deadline));
+    }
+
+    // Между слотами — разбор ответов; опоздание больше периода пропускает слоты без пачки.
+    (void)pccom4_client_poll(cl, pccom4gen_on_frame, &rx, NULL);
+    const uint64_t now = pccom4_now_ns();
+    uint64_t next = slot + 1u;
+    if (now > (t0 + (next * period_ns) + period_ns))
+    {
+      const uint64_t late_slot = (now - t0) / period_ns;
+      tx_slots_skipped += late_slot - next;
+      next = late_slot;
+    }
+    slot = next;
+    if (atomic_load(&cl->rx_closed))
+    {
+      break;
+    }
+  }
+  const double elapsed = (double)(pccom4_now_ns() - t0) * 1e-9;
+
+  // Шаг 4: Хвост ответов и итог.
+  const uint64_t t_drain = pccom4_now_ns() + PCCOM4GEN_DRAIN_NS;
+  while (pccom4_now_ns() < t_drain)
+  {
+    (void)pccom4_client_poll(cl, pccom4gen_on_frame, &rx, NULL);
+    const struct timespec idle = {0, 1000000L};
+    (void)nanosleep(&idle, NULL);
+  }
+  const bool trace_ok = pccom4_client_close(cl, pccom4gen_on_frame, &rx);
+  pccom4_client_stats_t st;
+  pccom4_client_stats(cl, &st);
+  free(cl);
+#ifdef __linux__
+  if (tfd >= 0)
+  {
+    (void)close(tfd);
+  }
+#endif
+
+  const double ratio = (tx_sent != 0u) ? ((double)rx.n_rtt / (double)tx_sent) : 0.0;
+  (void)printf("seconds=%.3f\nhz=%.1f\ntx_rate_hz=%.1f\n", elapsed, cfg.hz,
+               (elapsed > 0.0) ? ((double)tx_sent / elapsed) : 0.0);
+  (void)printf("tx_sent=%" PRIu32 "\ntx_err=%" PRIu32 "\ntx_slots_skipped=%" PRIu64 "\n", tx_sent, tx_err,
+               tx_slots_skipped);
+  (void)pccom4gen_print_dist("tx_late", s_late_ns, n_late);
+  (void)printf("fb_rx=%" PRIu32 "\nreplied=%" PRIu32 "\nno_reply=%" PRIu32 "\nreply_ratio=%.4f\n", rx.fb_rx,
+               rx.n_rtt, tx_sent - rx.n_rtt, ratio);
+  const double rtt_p99 = pccom4gen_print_dist("rtt", s_rtt_ns, rx.n_rtt);
+  static const uint32_t edges_us[PCCOM4GEN_HIST_N - 1u] = {50u, 100u, 200u, 500u, 1000u, 2000u, 5000u, 10000u};
+  uint32_t hist[PCCOM4GEN_HIST_N] = {0};
+  for (uint32_t i = 0u; i < rx.n_rtt; ++i)
+  {
+    uint32_t b = 0u;
+    while ((b < (PCCOM4GEN_HIST_N - 1u)) && (s_rtt_ns[i] >= (edges_us[b] * 1000u)))
+    {
+      b++;
+    }
+    hist[b]++;
+  }
+  for (uint32_t b = 0u; b < PCCOM4GEN_HIST_N; ++b)
+  {
+    if (b < (PCCOM4GEN_HIST_N - 1u))
+    {
+      (void)printf("rtt_hist_lt_%" PRIu32 "us=%" PRIu32 "\n", edges_us[b], hist[b]);
+    }
+    else
+    {
+      (void)printf("rtt_hist_ge_%" PRIu32 "us=%" PRIu32 "\n", edges_us[b - 1u], hist[b]);
+    }
+  }
+  (void)printf("fb_seq_gap=%" PRIu32 "\nfb_seq_repeat=%" PRIu32 "\nfb_seq_backward=%" PRIu32 "\n", rx.fb_seq_gap,
+               rx.fb_seq_repeat, rx.fb_seq_backward);
+  (void)printf("dev_cnt_seq_gap=%u\ndev_cnt_cmd_reject=%u\ndev_cnt_comms_fault=%u\n", rx.fb.cnt_seq_gap,
+               rx.fb.cnt_cmd_reject, rx.fb.cnt_comms_fault);
+  (void)printf("rx_crc_err=%" PRIu32 "\nparser_resync_count=%" PRIu32 "\ntrace_ok=%d\n", st.parser.rx_crc_err,
+               st.parser.parser_resync_count, trace_ok ? 1 : 0);
+
+  bool pass = trace_ok && (tx_err == 0u);
+  if ((cfg.max_rtt_p99_us > 0.0) && ((rx.n_rtt == 0u) || (rtt_p99 > cfg.max_rtt_p99_us)))
+  {
+    (void)fprintf(stderr, "pccom4gen: rtt_us_p99 %.1f > %.1f\n", rtt_p99, cfg.max_rtt_p99_us);
+    pass = false;
+  }
+  if ((cfg.min_reply_ratio > 0.0) && (ratio < cfg.min_reply_ratio))
+  {
+    (void)fprintf(stderr, "pccom4gen: reply_ratio %.4f < %.4f\n", ratio, cfg.min_reply_ratio);
+    pass = false;
+  }
+  (void)printf("pass=%d\n", pass ? 1 : 0);
+  return pass ? 0 : 1;
+}
@@ -0,0 +1,626 @@
+/**
+ * @file pccom4rig.c
+ * @brief Стенд PCcom4 end-to-end без FT232H: прошивочная сторона (pccom4_frame + pccom4_txsched, собраны для host)
+ * и host-клиент (pccom4_client) через пару pty.
+ * @details
+ * Сторона устройства (поток `dev`, master pty):
+ * - приём `TkPdo.Emu.CmdWeld` прошивочным парсером, ответ `TkPdo.Emu.FbStatus` (`seq_applied` = `seq` команды) в Q0;
+ * - нагрузка P1 (`Scope.Data` набор 1) и P2 (`Scope.Data` набор 2) с заданной предлагаемой скоростью в Q1/Q2;
+ * - линия: бюджет байт по `--baud` (8N1, 10 бит на байт) на тик, pccom4_txsched_pull(), write() в master;
+ * - инжекция ошибок в направлении устройство → ПК: инверсия байта (`--flip-ppm`), всплески `0xFF` (`--ff-ppm`).
+ *
+ * Сторона ПК (главный поток, slave pty): `CmdWeld` с частотой `--p0-hz`, разбор и учёт принятых кадров.
+ * Задержки P0: `p0_lat` — от постановки `FbStatus` в Q0 до read() на ПК (очередь + линия + транспорт ПК),
+ * `p0_rtt` — от write() `CmdWeld` до read() `FbStatus`. Направление ПК → устройство не ограничивается по скорости.
+ *
+ * `--serve` — только сторона устройства: путь slave pty печатается в stdout (`dev=<path>`) для внешнего клиента.
+ * Итог — строки `key=value`; `--max-p99-us`/`--min-p0-ratio` превращают прогон в проверку (код 1 при нарушении).
+ */
+#define _GNU_SOURCE /* posix_openpt(), ptsname_r() */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "pccom4_client.h"
+#include "pccom4_decode.h"
+#include "pccom4_serial.h"
+#include "pccom4_txsched.h"
+#include "scope_vars.h"
+#include "tk_pdo_codec.h"
+
+#define PCCOM4RIG_SEQ_N (65536u) /**< Меток времени по `seq`, [шт]. */
+#define PCCOM4RIG_LAT_MAX (1u << 20) /**< Отсчётов задержки, [шт]. */
+#define PCCOM4RIG_LOAD_DATA (200u) /**< `Data` кадра нагрузки P1/P2, [байт]. */
+#define PCCOM4RIG_FF_BURST_MAX (8u) /**< Максимальный всплеск `0xFF`, [байт]. */
+#define PCCOM4RIG_LINE_WINDOW_NS (1000000.0) /**< Предел накопления бюджета линии (пересып тика), [нс]. */
+#define PCCOM4RIG_OP_P2 (0x12u) /**< `Scope.Data` набор 2 (нагрузка P2). */
+#define PCCOM4RIG_SET_P2 (2u) /**< Номер набора нагрузки P2. */
+
+/**
+ * @brief Параметры прогона.
+ */
+typedef struct {
+  uint32_t baud; /**< Скорость линии устройство → ПК, [бод]. */
+  double seconds; /**< Длительность, [с]. */
+  double p0_hz; /**< Частота `CmdWeld`, [Гц]. */
+  double p1_kbps; /**< Предлагаемая нагрузка P1, [кБ/с]. */
+  double p2_kbps; /**< Предлагаемая нагрузка P2, [кБ/с]. */
+  uint32_t flip_ppm; /**< Вероятность инверсии байта, [ppm]. */
+  uint32_t ff_ppm; /**< Вероятность всплеска `0xFF` перед байтом, [ppm]. */
+  uint32_t tick_us; /**< Тик стороны устройства, [мкс]. */
+  double max_p99_us; /**< Порог p99 `p0_lat` (0 — без проверки), [мкс]. */
+  double min_p0_ratio; /**< Порог доли принятых `FbStatus` (0 — без проверки), [-]. */
+  bool serve; /**< Только сторона устройства. */
+} pccom4rig_cfg_t;
+
+/**
+ * @brief Сторона устройства.
+ */
+typedef struct {
+  const pccom4rig_cfg_t *cfg; /**< Параметры. */
+  int fd; /**< master pty. */
+  atomic_bool stop; /**< Запрос остановки. */
+  pccom4_parser_t parser; /**< Прошивочный парсер RX. */
+  pccom4_txsched_t sched; /**< Прошивочный планировщик TX. */
+  uint32_t seed; /**< Генератор нагрузки/ошибок. */
+  uint32_t cmd_rx; /**< Принято `CmdWeld`, [шт]. */
+  uint32_t p0_pushed; /**< Поставлено `FbStatus`, [шт]. */
+  uint64_t injected_flips; /**< Инвертировано байт, [шт]. */
+  uint64_t injected_ff; /**< Вставлено `0xFF`, [байт]. */
+  uint64_t write_stall; /**< write() вернул EAGAIN, [шт]. */
+} pccom4rig_dev_t;
+
+/**
+ * @brief Сторона ПК.
+ */
+typedef struct {
+  pccom4_client_t *cl; /**< Клиент. */
+  uint32_t p0_recv; /**< Принято `FbStatus`, [шт]. */
+  uint32_t p1_recv; /**< Принято кадров P1, [шт]. */
+  uint32_t p2_recv; /**< Принято кадров P2, [шт]. */
+  uint32_t n_lat; /**< Отсчётов задержки, [шт]. */
+} pccom4rig_pc_t;
+
+static volatile sig_atomic_t s_stop; /**< SIGINT/SIGTERM. */
+static _Atomic uint64_t s_t_enq[PCCOM4RIG_SEQ_N]; /**< Время постановки `FbStatus` в Q0 по `seq`, [нс]. */
+static uint64_t s_t_send[PCCOM4RIG_SEQ_N]; /**< Время отправки `CmdWeld` по `seq`, [нс]. */
+static uint32_t s_lat_ns[PCCOM4RIG_LAT_MAX]; /**< `p0_lat`, [нс]. */
+static uint32_t s_rtt_ns[PCCOM4RIG_LAT_MAX]; /**< `p0_rtt`, [нс]. */
+
+/**
+ * @brief Обработчик сигнала остановки.
+ * @param sig Номер сигнала.
+ * @return None.
+ */
+static void pccom4rig_on_signal(int sig)
+{
+  (void)sig;
+  s_stop = 1;
+}
+
+/**
+ * @brief xorshift32.
+ * @param state Состояние (не 0).
+ * @return Следующее значение.
+ */
+static uint32_t pccom4rig_rand(uint32_t *state)
+{
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *state = x;
+  return x;
+}
+
+/**
+ * @brief Устройство: `CmdWeld` → `FbStatus` в Q0.
+ * @param user Сторона устройства.
+ * @param frame Кадр.
+ * @return None.
+ */
+static void pccom4rig_dev_on_frame(void *user, const pccom4_frame_t *frame)
+{
+  pccom4rig_dev_t *dev = (pccom4rig_dev_t *)user;
+  if ((frame->node != PCCOM4_NODE_TKPDO_EMU) || (frame->op != PCCOM4_OP_CMD_WELD) ||
+      (frame->data_len != TK_PDO_CMD_WELD_SIZE_BYTES))
+  {
+    return;
+  }
+  uint32_t window[TK_PDO_FB_STATUS_SIZE_WORDS];
+  tk_cmd_weld_t cmd;
+  memcpy(window, frame->data, TK_PDO_CMD_WELD_SIZE_BYTES);
+  tk_pdo_cmd_weld_unpack(window, &cmd);
+  dev->cmd_rx++;
+
+  tk_fb_status_t fb;
+  const tk_fb_status_t zero = {0};
+  fb = zero;
+  fb.seq_applied = cmd.seq;
+  fb.i_ref_used_ma = (cmd.enable != 0u) ? cmd.i_ref_cmd_ma : 0;
+  tk_pdo_fb_status_pack(&fb, window);
+  uint8_t data[TK_PDO_FB_STATUS_SIZE_BYTES];
+  memcpy(data, window, sizeof(data));
+  const pccom4_frame_t reply = {frame->src, frame->dst, PCCOM4_TYPE_MESSAGE, PCCOM4_NODE_TKPDO_EMU,
+                                PCCOM4_OP_FB_STATUS, (uint8_t)sizeof(data), data, NULL};
+  atomic_store_explicit(&s_t_enq[cmd.seq], pccom4_now_ns(), memory_order_relaxed);
+  if (pccom4_txsched_push(&dev->sched, PCCOM4_PRIO_P0, &reply))
+  {
+    dev->p0_pushed++;
+  }
+}
+
+/**
+ * @brief Устройство: нагрузка P1/P2 по накопленному кредиту.
+ * @param dev Сторона устройства.
+ * @param prio Приоритет.
+ * @param credit Кредит, [байт] (уменьшается на поставленные кадры).
+ * @return None.
+ */
+static void pccom4rig_dev_load(pccom4rig_dev_t *dev, pccom4_prio_t prio, double *credit)
+{
+  uint8_t data[PCCOM4RIG_LOAD_DATA];
+  const double wire = (double)(PCCOM4RIG_LOAD_DATA + PCCOM4_LEN_MIN + 1u);
+  while (*credit >= wire)
+  {
+    for (uint32_t i = 0u; i < sizeof(data); ++i)
+    {
+      data[i] = (uint8_t)pccom4rig_rand(&dev->seed);
+    }
+    data[0] = (prio == PCCOM4_PRIO_P1) ? (uint8_t)SCOPE_VARS_SET_ID : (uint8_t)PCCOM4RIG_SET_P2;
+    const pccom4_frame_t frame = {PCCOM4_ADDR_PC, PCCOM4_ADDR_USPF, PCCOM4_TYPE_MESSAGE, PCCOM4_NODE_SCOPE,
+                                  (prio == PCCOM4_PRIO_P1) ? (uint8_t)PCCOM4_OP_SCOPE_DATA_FIRST
+                                                           : (uint8_t)PCCOM4RIG_OP_P2,
+                                  (uint8_t)sizeof(data), data, NULL};
+    // Полная очередь — дроп в планировщике (`cnt_drop`): нагрузка «предлагаемая», не гарантированная.
+    (void)pccom4_txsched_push(&dev->sched, prio, &frame);
+    *credit -= wire;
+  }
+}
+
+/**
+ * @brief Устройство: записать байты линии в master (EAGAIN — повтор после паузы тика).
+ * @param dev Сторона устройства.
+ * @param buf Байты.
+ * @param len Длина, [байт].
+ * @return false — порт закрыт.
+ */
+static bool pccom4rig_dev_write(pccom4rig_dev_t *dev, const uint8_t *buf, uint32_t len)
+{
+  uint32_t off = 0u;
+  while ((off < len) && !atomic_load_explicit(&dev->stop, memory_order_relaxed))
+  {
+    const ssize_t put = write(dev->fd, &buf[off], len - off);
+    if (put > 0)
+    {
+      off += (uint32_t)put;
+    }
+    else if ((put < 0) && ((errno == EAGAIN) || (errno == EINTR)))
+    {
+      dev->write_stall++;
+      const struct timespec pause = {0, (long)dev->cfg->tick_us * 1000L};
+      (void)nanosleep(&pause, NULL);
+    }
+    else
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Поток стороны устройства.
+ * @param arg Сторона устройства.
+ * @return NULL.
+ */
+static void *pccom4rig_dev_thread(void *arg)
+{
+  pccom4rig_dev_t *dev = (pccom4rig_dev_t *)arg;
+  const pccom4rig_cfg_t *cfg = dev->cfg;
+  const double line_bpns = ((double)cfg->baud / 10.0) * 1e-9;
+  const double line_cap = (line_bpns * PCCOM4RIG_LINE_WINDOW_NS > 64.0) ? (line_bpns * PCCOM4RIG_LINE_WINDOW_NS) : 64.0;
+  double line_credit = 0.0;
+  double p1_credit = 0.0;
+  double p2_credit = 0.0;
+  static uint8_t rx[4096];
+  static uint8_t line[65536];
+  static uint8_t out[2u * 65536u];
+  uint64_t t_last = pccom4_now_ns();
+  while (!atomic_load_explicit(&dev->stop, memory_order_relaxed))
+  {
+    // Шаг 1: RX (прошивочный парсер) — ответы P0 встают в Q0 раньше нагрузки этого тика.
+    const ssize_t got = read(dev->fd, rx, sizeof(rx));
+    if (got > 0)
+    {
+      (void)pccom4_parser_feed(&dev->parser, rx, (uint32_t)got, pccom4rig_dev_on_frame, dev);
+    }
+
+    // Шаг 2: Нагрузка P1/P2 и бюджет линии за прошедшее время.
+    const uint64_t now = pccom4_now_ns();
+    const double dt = (double)(now - t_last);
+    t_last = now;
+    p1_credit += cfg->p1_kbps * 1e3 * dt * 1e-9;
+    p2_credit += cfg->p2_kbps * 1e3 * dt * 1e-9;
+    pccom4rig_dev_load(dev, PCCOM4_PRIO_P1, &p1_credit);
+    pccom4rig_dev_load(dev, PCCOM4_PRIO_P2, &p2_credit);
+    line_credit += line_bpns * dt;
+    line_credit = (line_credit > line_cap) ? line_cap : line_credit;
+
+    // Шаг 3: Линия: планировщик → инжекция ошибок → master.
+    const uint32_t n = pccom4_txsched_pull(&dev->sched, line, (uint32_t)line_credit);
+    uint32_t m = 0u;
+    for (uint32_t i = 0u; i < n; ++i)
+    {
+      if ((cfg->ff_ppm != 0u) && ((pccom4rig_rand(&dev->seed) % 1000000u) < cfg->ff_ppm))
+      {
+        const uint32_t burst = 1u + (pccom4rig_rand(&dev->seed) % PCCOM4RIG_FF_BURST_MAX);
+        memset(&out[m], 0xFF, burst);
+        m += burst;
+        dev->injected_ff += burst;
+      }
+      out[m] = line[i];
+      if ((cfg->flip_ppm != 0u) && ((pccom4rig_rand(&dev->seed) % 1000000u) < cfg->flip_ppm))
+      {
+        out[m] = (uint8_t)~out[m];
+        dev->injected_flips++;
+      }
+      m++;
+    }
+    line_credit -= (double)m;
+    if ((m != 0u) && !pccom4rig_dev_write(dev, out, m))
+    {
+      break;
+    }
+    const struct timespec tick = {0, (long)cfg->tick_us * 1000L};
+    (void)nanosleep(&tick, NULL);
+  }
+  return NULL;
+}
+
+/**
+ * @brief ПК: учёт принятых кадров и задержек.
+ * @param user Сторона ПК.
+ * @param frame Кадр.
+ * @return None.
+ */
+static void pccom4rig_pc_on_frame(void *user, const pccom4_frame_t *frame)
+{
+  pccom4rig_pc_t *pc = (pccom4rig_pc_t *)user;
+  if ((frame->node == PCCOM4_NODE_TKPDO_EMU) && (frame->op == PCCOM4_OP_FB_STATUS) &&
+      (frame->data_len == TK_PDO_FB_STATUS_SIZE_BYTES))
+  {
+    uint32_t window[TK_PDO_FB_STATUS_SIZE_WORDS];
+    tk_fb_status_t fb;
+    memcpy(window, frame->data, TK_PDO_FB_STATUS_SIZE_BYTES);
+    (void)tk_pdo_fb_status_unpack(window, &fb);
+    // Время read() слота с кадром: задержка разбора на ПК не входит.
+    const uint64_t t_rx = pc->cl->t0_ns + pc->cl->chunk_t_ns;
+    const uint64_t t_enq = atomic_load_explicit(&s_t_enq[fb.seq_applied], memory_order_relaxed);
+    if ((pc->n_lat < PCCOM4RIG_LAT_MAX) && (t_enq != 0u) && (t_rx >= t_enq))
+    {
+      s_lat_ns[pc->n_lat] = (uint32_t)(((t_rx - t_enq) > UINT32_MAX) ? UINT32_MAX : (t_rx - t_enq));
+      s_rtt_ns[pc->n_lat] = (uint32_t)(((t_rx - s_t_send[fb.seq_applied]) > UINT32_MAX)
+                                         ? UINT32_MAX
+                                         : (t_rx - s_t_send[fb.seq_applied]));
+      pc->n_lat++;
+    }
+    pc->p0_recv++;
+  }
+  else if (frame->node == PCCOM4_NODE_SCOPE)
+  {
+    if (frame->op == PCCOM4_OP_SCOPE_DATA_FIRST)
+    {
+      pc->p1_recv++;
+    }
+    else if (frame->op == PCCOM4RIG_OP_P2)
+    {
+      pc->p2_recv++;
+    }
+  }
+}
+
+/**
+ * @brief Сравнение для qsort().
+ * @param a Элемент.
+ * @param b Элемент.
+ * @return <0, 0, >0.
+ */
+static int pccom4rig_cmp_u32(const void *a, const void *b)
+{
+  const uint32_t x = *(const uint32_t *)a;
+  const uint32_t y = *(const uint32_t *)b;
+  return (x > y) - (x < y);
+}
+
+/**
+ * @brief Перцентиль (массив сортируется на месте).
+ * @param v Отсчёты, [нс].
+ * @param n Количество, [шт].
+ * @param q Квантиль 0..1.
+ * @return Значение, [мкс] (0 — нет отсчётов).
+ */
+static double pccom4rig_pct_us(uint32_t *v, uint32_t n, double q)
+{
+  if (n == 0u)
+  {
+    return 0.0;
+  }
+  const uint32_t i = (uint32_t)(q * (double)(n - 1u) + 0.5);
+  return (double)v[i] * 1e-3;
+}
+
+/**
+ * @brief Разбор аргументов.
+ * @param argc Количество аргументов.
+ * @param argv Аргументы.
+ * @param cfg Результат.
+ * @return false при ошибке.
+ */
+static bool pccom4rig_parse_args(int argc, char **argv, pccom4rig_cfg_t *cfg)
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    const bool has = (i + 1) < argc;
+    if ((strcmp(argv[i], "--baud") == 0) && has)
+    {
+      cfg->baud = (uint32_t)strtoul(argv[++i], NULL, 0);
+    }
+    else if ((strcmp(argv[i], "--seconds") == 0) && has)
+    {
+      cfg->seconds = strtod(argv[++i], NULL);
+    }
+    else if ((strcmp(argv[i], "--p0-hz") == 0) && has)
+    {
+      cfg->p0_hz = strtod(argv[++i], NULL);
+    }
+    else if ((strcmp(argv[i], "--p1-kbps") == 0) && has)
+    {
+      cfg->p1_kbps = strtod(argv[++i], NULL);
+    }
+    else if ((strcmp(argv[i], "--p2-kbps") == 0) && has)
+    {
+      cfg->p2_kbps = strtod(argv[++i], NULL);
+    }
+    else if ((strcmp(argv[i], "--flip-ppm") == 0) && has)
+    {
+      cfg->flip_ppm = (uint32_t)strtoul(argv[++i], NULL, 0);
+    }
+    else if ((strcmp(argv[i], "--ff-ppm") == 0) && has)
+    {
+      cfg->ff_ppm = (uint32_t)strtoul(argv[++i], NULL, 0);
+    }
+    else if ((strcmp(argv[i], "--tick-us") == 0) && has)
+    {
+      cfg->tick_us = (uint32_t)strtoul(argv[++i], NULL, 0);
+    }
+    else if ((strcmp(argv[i], "--max-p99-us") == 0) && has)
+    {
+      cfg->max_p99_us = strtod(argv[++i], NULL);
+    }
+    else if ((strcmp(argv[i], "--min-p0-ratio") == 0) && has)
+    {
+      cfg->min_p0_ratio = strtod(argv[++i], NULL);
+    }
+    else if (strcmp(argv[i], "--serve") == 0)
+    {
+      cfg->serve = true;
+    }
+    else
+    {
+      (void)fprintf(stderr, "pccom4rig: unknown argument %s\n", argv[i]);
+      return false;
+    }
+  }
+  return (cfg->baud >= 9600u) && (cfg->tick_us >= 10u) && (cfg->tick_us < 1000000u) && (cfg->p0_hz >= 0.0);
+}
+
+/**
+ * @brief Открыть пару pty: master (устройство, неблокирующий) + slave в raw (держится открытым всё время прогона).
+ * @param slave_fd Выход: дескриптор slave.
+ * @param path Выход: путь slave.
+ * @param cap Размер path, [байт].
+ * @return Дескриптор master (-1 при ошибке).
+ */
+static int pccom4rig_open_pty(int *slave_fd, char *path, size_t cap)
+{
+  const int fd = posix_openpt(O_RDWR | O_NOCTTY);
+  if ((fd < 0) || (grantpt(fd) != 0) || (unlockpt(fd) != 0) || (ptsname_r(fd, path, cap) != 0))
+  {
+    (void)close(fd);
+    return -1;
+  }
+  // Raw до первого байта: иначе line discipline успеет обработать поток (ICRNL/ECHO).
+  *slave_fd = pccom4_serial_open(path, 0u);
+  if ((*slave_fd < 0) || (fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) != 0))
+  {
+    (void)close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+/**
+ * @brief Сторона ПК: `CmdWeld` с частотой `p0_hz`, приём до конца прогона.
+ * @param cfg Параметры.
+ * @param path Путь slave pty.
+ * @param pc Сторона ПК.
+ * @param seq_sent Выход: отправлено `CmdWeld`, [шт].
+ * @return false при ошибке клиента.
+ */
+static bool pccom4rig_pc_run(const pccom4rig_cfg_t *cfg, const char *path, pccom4rig_pc_t *pc, uint32_t *seq_sent)
+{
+  const pccom4_client_cfg_t ccfg = {path, 0u, NULL, 0u, PCCOM4_ADDR_PC, PCCOM4_ADDR_USPF};
+  if (!pccom4_client_open(pc->cl, &ccfg))
+  {
+    return false;
+  }
+  const uint64_t period_ns = (cfg->p0_hz > 0.0) ? (uint64_t)(1e9 / cfg->p0_hz) : 0u;
+  const uint64_t t_start = pccom4_now_ns();
+  const uint64_t t_end = t_start + (uint64_t)(cfg->seconds * 1e9);
+  uint64_t t_next = t_start;
+  uint16_t seq = 1u;
+  while ((s_stop == 0) && (pccom4_now_ns() < t_end))
+  {
+    if ((period_ns != 0u) && (pccom4_now_ns() >= t_next))
+    {
+      tk_cmd_weld_t cmd;
+      const tk_cmd_weld_t zero = {0};
+      cmd = zero;
+      cmd.seq = seq;
+      uint32_t window[TK_PDO_CMD_WELD_SIZE_WORDS];
+      tk_pdo_cmd_weld_pack(&cmd, window);
+      s_t_send[seq] = pccom4_now_ns();
+      (void)pccom4_client_send(pc->cl, PCCOM4_TYPE_MESSAGE, PCCOM4_NODE_TKPDO_EMU, PCCOM4_OP_CMD_WELD,
+                               (const uint8_t *)window, TK_PDO_CMD_WELD_SIZE_BYTES);
+      (*seq_sent)++;
+      seq = (uint16_t)(seq + 1u);
+      t_next += period_ns;
+    }
+    (void)pccom4_client_poll(pc->cl, pccom4rig_pc_on_frame, pc, NULL);
+    const struct timespec idle = {0, 20000L};
+    (void)nanosleep(&idle, NULL);
+  }
+  // Хвост: ответы на последние команды ещё в очереди/линии.
+  const uint64_t t_drain = pccom4_now_ns() + 200000000ull;
+  while (pccom4_now_ns() < t_drain)
+  {
+    (void)pccom4_client_poll(pc->cl, pccom4rig_pc_on_frame, pc, NULL);
+    const struct timespec idle = {0, 1000000L};
+    (void)nanosleep(&idle, NULL);
+  }
+  return true;
+}
+
+/**
+ * @brief Точка входа.
+ * @param argc Количество аргументов командной строки, [шт].
+ * @param argv Массив аргументов командной строки.
+ * @return Код завершения (0 = OK, 1 = проверка не пройдена/ошибка, 2 = ошибка использования).
+ */
+int main(int argc, char **argv)
+{
+  pccom4rig_cfg_t cfg = {1000000u, 2.0, 1000.0, 40.0, 200.0, 0u, 0u, 100u, 0.0, 0.0, false};
+  if (!pccom4rig_parse_args(argc, argv, &cfg))
+  {
+    (void)fprintf(stderr,
+                  "usage: pccom4rig [--baud <N>] [--seconds <S>] [--p0-hz <F>] [--p1-kbps <K>] [--p2-kbps <K>]\n"
+                  "                 [--flip-ppm <N>] [--ff-ppm <N>] [--tick-us <T>] [--max-p99-us <X>]"
+                  " [--min-p0-ratio <R>] [--serve]\n");
+    return 2;
+  }
+  (void)signal(SIGINT, pccom4rig_on_signal);
+  (void)signal(SIGTERM, pccom4rig_on_signal);
+
+  char path[128];
+  int slave_fd = -1;
+  static pccom4rig_dev_t dev;
+  dev.cfg = &cfg;
+  dev.seed = 0x2545F491u;
+  atomic_init(&dev.stop, false);
+  pccom4_parser_init(&dev.parser);
+  pccom4_txsched_init(&dev.sched);
+  dev.fd = pccom4rig_open_pty(&slave_fd, path, sizeof(path));
+  if (dev.fd < 0)
+  {
+    (void)fprintf(stderr, "pccom4rig: cannot open pty\n");
+    return 1;
+  }
+  pthread_t dev_thread;
+  if (pthread_create(&dev_thread, NULL, pccom4rig_dev_thread, &dev) != 0)
+  {
+    return 1;
+  }
+
+  pccom4rig_pc_t pc = {NULL, 0u, 0u, 0u, 0u};
+  uint32_t p0_sent = 0u;
+  bool ok = true;
+  const uint64_t t_start = pccom4_now_ns();
+  if (cfg.serve)
+  {
+    (void)printf("dev=%s\n", path);
+    (void)fflush(stdout);
+    while ((s_stop == 0) && ((cfg.seconds <= 0.0) || ((double)(pccom4_now_ns() - t_start) * 1e-9 < cfg.seconds)))
+    {
+      const struct timespec idle = {0, 10000000L};
+      (void)nanosleep(&idle, NULL);
+    }
+  }
+  else
+  {
+    pc.cl = calloc(1u, sizeof(*pc.cl));
+    ok = (pc.cl != NULL) && pccom4rig_pc_run(&cfg, path, &pc, &p0_sent);
+  }
+  const double elapsed = (double)(pccom4_now_ns() - t_start) * 1e-9;
+  atomic_store(&dev.stop, true);
+  (void)pthread_join(dev_thread, NULL);
+
+  pccom4_client_stats_t st;
+  const pccom4_client_stats_t zero = {0};
+  st = zero;
+  if (pc.cl != NULL)
+  {
+    (void)pccom4_client_close(pc.cl, pccom4rig_pc_on_frame, &pc);
+    pccom4_client_stats(pc.cl, &st);
+    free(pc.cl);
+  }
+  (void)close(slave_fd);
+  (void)close(dev.fd);
+
+  // Итог.
+  const pccom4_txsched_stats_t *ss = &dev.sched.stats;
+  qsort(s_lat_ns, pc.n_lat, sizeof(s_lat_ns[0]), pccom4rig_cmp_u32);
+  qsort(s_rtt_ns, pc.n_lat, sizeof(s_rtt_ns[0]), pccom4rig_cmp_u32);
+  const double p99 = pccom4rig_pct_us(s_lat_ns, pc.n_lat, 0.99);
+  const double ratio = (p0_sent != 0u) ? ((double)pc.p0_recv / (double)p0_sent) : 0.0;
+  (void)printf("seconds=%.3f\nbaud=%" PRIu32 "\n", elapsed, cfg.baud);
+  (void)printf("line_util=%.3f\n", (double)ss->bytes_sent / (((double)cfg.baud / 10.0) * elapsed));
+  (void)printf("p0_sent=%" PRIu32 "\ndev_cmd_rx=%" PRIu32 "\np0_recv=%" PRIu32 "\np0_ratio=%.4f\n", p0_sent,
+               dev.cmd_rx, pc.p0_recv, ratio);
+  (void)printf("p0_lat_us_p50=%.1f\np0_lat_us_p99=%.1f\np0_lat_us_max=%.1f\n",
+               pccom4rig_pct_us(s_lat_ns, pc.n_lat, 0.5), p99, pccom4rig_pct_us(s_lat_ns, pc.n_lat, 1.0));
+  (void)printf("p0_rtt_us_p50=%.1f\np0_rtt_us_p99=%.1f\np0_rtt_us_max=%.1f\n",
+               pccom4rig_pct_us(s_rtt_ns, pc.n_lat, 0.5), pccom4rig_pct_us(s_rtt_ns, pc.n_lat, 0.99),
+               pccom4rig_pct_us(s_rtt_ns, pc.n_lat, 1.0));
+  (void)printf("p1_sent=%" PRIu32 "\np1_recv=%" PRIu32 "\np2_sent=%" PRIu32 "\np2_recv=%" PRIu32 "\n",
+               ss->frames_sent[PCCOM4_PRIO_P1], pc.p1_recv, ss->frames_sent[PCCOM4_PRIO_P2], pc.p2_recv);
+  for (uint32_t q = 0u; q < PCCOM4_PRIO_COUNT; ++q)
+  {
+    (void)printf("q%" PRIu32 "_highwater=%" PRIu32 "\ncnt_p%" PRIu32 "_drop=%" PRIu32 "\n", q, ss->q_highwater[q], q,
+                 ss->cnt_drop[q]);
+  }
+  (void)printf("injected_flips=%" PRIu64 "\ninjected_ff=%" PRIu64 "\ndev_write_stall=%" PRIu64 "\n",
+               dev.injected_flips, dev.injected_ff, dev.write_stall);
+  (void)printf("rx_ok=%" PRIu32 "\nrx_crc_err=%" PRIu32 "\nrx_len_err=%" PRIu32 "\nparser_resync_count=%" PRIu32
+               "\nrxq_stall=%" PRIu32 "\n",
+               st.parser.rx_ok, st.parser.rx_crc_err, st.parser.rx_len_err, st.parser.parser_resync_count,
+               st.rxq_stall);
+
+  if (!ok)
+  {
+    (void)fprintf(stderr, "pccom4rig: client failed on %s\n", path);
+    return 1;
+  }
+  bool pass = true;
+  if ((cfg.max_p99_us > 0.0) && ((pc.n_lat == 0u) || (p99 > cfg.max_p99_us)))
+  {
+    (void)fprintf(stderr, "pccom4rig: p0_lat_us_p99 %.1f > %.1f\n", p99, cfg.max_p99_us);
+    pass = false;
+  }
+  if ((cfg.min_p0_ratio > 0.0) && (ratio < cfg.min_p0_ratio))
+  {
+    (void)fprintf(stderr, "pccom4rig: p0_ratio %.4f < %.4f\n", ratio, cfg.min_p0_ratio);
+    pass = false;
+  }
+  (void)printf("pass=%d\n", pass ? 1 : 0);
+  return pass ? 0 : 1;
+}